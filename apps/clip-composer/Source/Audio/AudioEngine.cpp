@@ -812,6 +812,17 @@ void AudioEngine::processAudio(const float** input_buffers, float** output_buffe
   m_transportController->processCallbacks();
 }
 
+uint32_t AudioEngine::getProcessingLatencySamples() const {
+  // Master limiter look-ahead, added to the driver's reported latency
+  return m_transportController ? m_transportController->getProcessingLatencySamples() : 0;
+}
+
+void AudioEngine::onUnderrun(orpheus::UnderrunCause /*cause*/) {
+  // Driver detected a missed deadline: surfaces as onBufferUnderrun() on the next callback
+  if (m_transportController)
+    m_transportController->reportBufferUnderrun();
+}
+
 //==============================================================================
 orpheus::ClipHandle AudioEngine::getClipHandle(int buttonIndex) const {
   if (buttonIndex >= 0 && buttonIndex < AudioEngine::MAX_CLIP_BUTTONS)
@@ -284,6 +284,8 @@ public:
   // IAudioCallback override (Audio Thread, Real-Time Safe)
   void processAudio(const float** input_buffers, float** output_buffers, size_t num_channels,
                     size_t num_frames) override;
+  uint32_t getProcessingLatencySamples() const override;
+  void onUnderrun(orpheus::UnderrunCause cause) override;
 
 private:
   //==============================================================================
@@ -63,6 +63,25 @@ void ClipButton::clearClip() {
   m_fadeOutEnabled = false;
   m_effectsEnabled = false;
   m_stopOthersEnabled = false;
+  m_thumbnailFile.clear();
+  m_thumbnailIndex.reset();
+  repaint();
+}
+
+void ClipButton::setThumbnailAtlas(std::shared_ptr<const orpheus::IThumbnailAtlas> atlas) {
+  m_thumbnailAtlas = std::move(atlas);
+  setThumbnailFile(m_thumbnailFile);
+}
+
+void ClipButton::setThumbnailFile(const juce::String& filePath) {
+  m_thumbnailFile = filePath;
+  m_thumbnailIndex.reset();
+  if (m_thumbnailAtlas && filePath.isNotEmpty()) {
+    auto index = m_thumbnailAtlas->find(filePath.toStdString());
+    if (index && m_thumbnailAtlas->info(*index).valid) {
+      m_thumbnailIndex = index;
+    }
+  }
   repaint();
 }
 
@@ -206,11 +225,51 @@ void ClipButton::paint(juce::Graphics& g) {
 
     // No "Empty" text - just the button number on grey background is sufficient
   } else {
+    // Waveform thumbnail behind the HUD (between the top row and the group badge)
+    juce::Colour thumbnailColor = bgColor.getBrightness() > 0.8f
+                                      ? juce::Colours::black.withAlpha(0.2f)
+                                      : juce::Colours::white.withAlpha(0.2f);
+    drawThumbnail(g, bounds.reduced(PADDING).withTrimmedTop(18.0f).withTrimmedBottom(24.0f),
+                  thumbnailColor);
+
     // Modern HUD layout for loaded clips
     drawClipHUD(g, bounds);
   }
 }
 
+void ClipButton::drawThumbnail(juce::Graphics& g, juce::Rectangle<float> bounds,
+                               juce::Colour colour) {
+  if (!m_thumbnailAtlas || !m_thumbnailIndex || bounds.isEmpty())
+    return;
+
+  const auto info = m_thumbnailAtlas->info(*m_thumbnailIndex);
+  const uint32_t thumbnailWidth = m_thumbnailAtlas->thumbnailWidth();
+  if (info.numChannels == 0 || thumbnailWidth == 0)
+    return;
+
+  // One column per screen pixel; channels are drawn as their combined envelope
+  const int columns = static_cast<int>(bounds.getWidth());
+  const float midY = bounds.getCentreY();
+  const float halfHeight = bounds.getHeight() * 0.5f;
+  g.setColour(colour);
+
+  for (int x = 0; x < columns; ++x) {
+    const auto pixel = static_cast<size_t>(static_cast<int64_t>(x) * thumbnailWidth / columns);
+    int16_t minValue = 0;
+    int16_t maxValue = 0;
+    for (uint32_t ch = 0; ch < info.numChannels; ++ch) {
+      if (const int16_t* pairs = m_thumbnailAtlas->minMaxPairs(*m_thumbnailIndex, ch)) {
+        minValue = std::min(minValue, pairs[pixel * 2]);
+        maxValue = std::max(maxValue, pairs[pixel * 2 + 1]);
+      }
+    }
+
+    const float top = midY - (maxValue / orpheus::THUMBNAIL_FULL_SCALE) * halfHeight;
+    const float bottom = midY - (minValue / orpheus::THUMBNAIL_FULL_SCALE) * halfHeight;
+    g.fillRect(bounds.getX() + static_cast<float>(x), top, 1.0f, std::max(1.0f, bottom - top));
+  }
+}
+
 void ClipButton::drawClipHUD(juce::Graphics& g, juce::Rectangle<float> bounds) {
   auto contentArea = bounds.reduced(PADDING);
   float currentY = contentArea.getY();
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <juce_gui_extra/juce_gui_extra.h>
+#include <memory>
+#include <optional>
+#include <orpheus/thumbnail_atlas.h>
 
 // Forward declaration
 class ClipGrid;
@@ -15,7 +18,7 @@ class ClipGrid;
  *
  * Visual States:
  * - Empty: Dark grey, no label
- * - Loaded: Colored based on clip type, shows clip name
+ * - Loaded: Colored based on clip type, shows clip name over a waveform thumbnail
  * - Playing: Bright border, animated
  * - Stopping: Fade-out animation
  *
@@ -57,6 +60,11 @@ public:
   void setBeatOffset(const juce::String& beatOffset); // Optional: "1", "1+", "1++", "3+", etc.
   void clearClip();
 
+  // Waveform thumbnail: drawn straight from the grid's memory-mapped SDK atlas on every
+  // paint (no file access); files not in the atlas yet draw no thumbnail
+  void setThumbnailAtlas(std::shared_ptr<const orpheus::IThumbnailAtlas> atlas);
+  void setThumbnailFile(const juce::String& filePath);
+
   // Playback progress (0.0 = start, 1.0 = end)
   void setPlaybackProgress(float progress);
   float getPlaybackProgress() const {
@@ -120,6 +128,7 @@ private:
   juce::String formatDuration(double seconds) const;
   void drawClipHUD(juce::Graphics& g, juce::Rectangle<float> bounds);
   void drawStatusIcons(juce::Graphics& g, juce::Rectangle<float> bounds);
+  void drawThumbnail(juce::Graphics& g, juce::Rectangle<float> bounds, juce::Colour colour);
 
   //==============================================================================
   int m_buttonIndex;
@@ -132,6 +141,11 @@ private:
   juce::String m_keyboardShortcut;
   juce::String m_beatOffset; // Optional: "3+", "2", "4-", etc.
 
+  // Waveform thumbnail (index into the atlas, resolved when the atlas or file changes)
+  std::shared_ptr<const orpheus::IThumbnailAtlas> m_thumbnailAtlas;
+  juce::String m_thumbnailFile;
+  std::optional<size_t> m_thumbnailIndex;
+
   // Playback state
   float m_playbackProgress = 0.0f; // 0.0 to 1.0
 
@@ -50,6 +50,7 @@ void ClipGrid::createButtons() {
     };
 
     // All buttons start empty - clips will be loaded by SessionManager
+    button->setThumbnailAtlas(m_thumbnailAtlas);
     addAndMakeVisible(button.get());
     m_buttons.push_back(std::move(button));
   }
@@ -61,6 +62,13 @@ ClipButton* ClipGrid::getButton(int index) {
   return nullptr;
 }
 
+void ClipGrid::setThumbnailAtlas(std::shared_ptr<const orpheus::IThumbnailAtlas> atlas) {
+  m_thumbnailAtlas = std::move(atlas);
+  for (auto& button : m_buttons) {
+    button->setThumbnailAtlas(m_thumbnailAtlas);
+  }
+}
+
 //==============================================================================
 void ClipGrid::setGridSize(int columns, int rows) {
   // Validate grid size constraints (Item 22: 5×4 to 12×8)
@@ -44,6 +44,9 @@ public:
     return static_cast<int>(m_buttons.size());
   }
 
+  // Waveform thumbnails for every button, shared from one memory-mapped atlas
+  void setThumbnailAtlas(std::shared_ptr<const orpheus::IThumbnailAtlas> atlas);
+
   //==============================================================================
   // Callbacks for button events
   std::function<void(int buttonIndex)> onButtonClicked;             // Left-click (trigger)
@@ -114,6 +117,7 @@ private:
   static constexpr int MAX_ROWS = 8;
 
   std::vector<std::unique_ptr<ClipButton>> m_buttons;
+  std::shared_ptr<const orpheus::IThumbnailAtlas> m_thumbnailAtlas; // Shared by all buttons
 
   bool m_hasActiveClips = false; // Track if any clips are playing
   int m_playboxIndex = 0;        // Current playbox position (Item 60: arrow key navigation)
@@ -150,6 +150,12 @@ MainComponent::MainComponent() {
     }
   }
 
+  // Show the last session's thumbnails at once; the timer rebuilds them when clips change
+  if (auto atlas = orpheus::openThumbnailAtlas(
+          getThumbnailAtlasFile().getFullPathName().toStdString())) {
+    m_clipGrid->setThumbnailAtlas(std::move(atlas));
+  }
+
   // Start timer for latency display updates (once per second)
   startTimer(1000);
 
@@ -201,6 +207,11 @@ void MainComponent::resized() {
 
 //==============================================================================
 void MainComponent::timerCallback() {
+  // Coalesce clip changes into one thumbnail atlas build at a time
+  if (m_thumbnailAtlasDirty && !m_thumbnailBuildRunning) {
+    rebuildThumbnailAtlas();
+  }
+
   // OCC130 Sprint B: Update latency/performance info in merged TabSwitcher
   if (m_tabSwitcher && m_audioEngine) {
     uint32_t latencySamples = m_audioEngine->getLatencySamples();
@@ -1192,6 +1203,7 @@ void MainComponent::loadClipToButton(int buttonIndex, const juce::String& filePa
 
     // Update button visual state with real metadata
     updateButtonFromClip(buttonIndex);
+    m_thumbnailAtlasDirty = true;
 
     DBG("MainComponent: Successfully loaded clip to button " << buttonIndex);
   } else {
@@ -1313,6 +1325,7 @@ void MainComponent::updateButtonFromClip(int buttonIndex) {
 
     button->setClipName(juce::String(clipData.displayName));
     button->setClipColor(clipData.color);
+    button->setThumbnailFile(juce::String(clipData.filePath));
 
     // Calculate TRIMMED duration in seconds (playable time)
     if (clipData.sampleRate > 0) {
@@ -1350,6 +1363,47 @@ void MainComponent::updateButtonFromClip(int buttonIndex) {
   }
 }
 
+juce::File MainComponent::getThumbnailAtlasFile() const {
+  return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+      .getChildFile("Orpheus Clip Composer/Thumbnails.orpthumbs");
+}
+
+void MainComponent::rebuildThumbnailAtlas() {
+  m_thumbnailAtlasDirty = false;
+
+  // Clips of every tab, so switching tabs needs no rebuild
+  std::vector<std::string> filePaths;
+  for (const auto& [key, clipData] : m_sessionManager.getAllClips()) {
+    filePaths.push_back(clipData.filePath);
+  }
+  if (filePaths.empty())
+    return;
+
+  auto atlasFile = getThumbnailAtlasFile();
+  atlasFile.getParentDirectory().createDirectory();
+  auto atlasPath = atlasFile.getFullPathName().toStdString();
+  m_thumbnailBuildRunning = true;
+
+  // The SDK decodes the files in parallel with strided reads and replaces the atlas
+  // atomically, so buttons keep drawing from the previous mapping meanwhile
+  juce::Component::SafePointer<MainComponent> safeThis(this);
+  juce::Thread::launch([safeThis, filePaths, atlasPath]() {
+    std::shared_ptr<const orpheus::IThumbnailAtlas> atlas;
+    if (orpheus::buildThumbnailAtlas(filePaths, atlasPath) == orpheus::SessionGraphError::OK) {
+      atlas = orpheus::openThumbnailAtlas(atlasPath);
+    }
+
+    juce::MessageManager::callAsync([safeThis, atlas]() {
+      if (auto* self = safeThis.getComponent()) {
+        self->m_thumbnailBuildRunning = false;
+        if (atlas) {
+          self->m_clipGrid->setThumbnailAtlas(atlas);
+        }
+      }
+    });
+  });
+}
+
 void MainComponent::onStopAll() {
   DBG("MainComponent: Stop All pressed");
 
@@ -1483,6 +1537,7 @@ void MainComponent::menuItemSelected(int menuItemID, int /*topLevelMenuIndex*/)
         for (int i = 0; i < m_clipGrid->getButtonCount(); ++i) {
           updateButtonFromClip(i);
         }
+        m_thumbnailAtlasDirty = true;
         DBG("MainComponent: Successfully loaded session: " + file.getFileName());
       } else {
         juce::AlertWindow::showMessageBoxAsync(
@@ -62,6 +62,10 @@ private:
   void onStopAll();
   void onPanic();
 
+  // Clip button thumbnails (one SDK atlas for the whole session, built in the background)
+  juce::File getThumbnailAtlasFile() const;
+  void rebuildThumbnailAtlas();
+
   // Tab management
   void onTabSelected(int tabIndex);
 
@@ -101,6 +105,10 @@ private:
   // Single Edit Dialog tracking (ensures only one dialog open at a time)
   ClipEditDialog* m_currentEditDialog = nullptr;
 
+  // Thumbnail atlas: rebuilt by the timer when clips change (message thread only)
+  bool m_thumbnailAtlasDirty = false;
+  bool m_thumbnailBuildRunning = false;
+
   // Item 24: Clip Copy/Paste clipboard
   bool m_hasClipInClipboard = false;
   SessionManager::ClipData m_clipboardData;
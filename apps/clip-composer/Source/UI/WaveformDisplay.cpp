@@ -10,6 +10,9 @@ WaveformDisplay::WaveformDisplay() {
 WaveformDisplay::~WaveformDisplay() {
   // Stop any background thread from accessing this component after destruction
   m_isLoading.store(false);
+  ++m_loadGeneration;
+  // Cancels the reader's analysis jobs and waits for a running callback to return
+  m_reader.reset();
 }
 
 //==============================================================================
@@ -39,44 +42,51 @@ void WaveformDisplay::setAudioFile(const juce::File& audioFile) {
     return;
   }
 
-  // Not in cache - generate waveform data on background thread
+  // Not in cache - open with the SDK reader (header and peak file only, no decode)
+  auto reader = orpheus::createAudioFileReaderExtended();
+  auto opened = reader->open(filePath.toStdString());
+  if (!opened.isOk()) {
+    DBG("WaveformDisplay: Failed to open: " << filePath << " (" << opened.errorMessage << ")");
+    return;
+  }
+
+  // Callbacks of the previous file are stale from here on; replacing the reader
+  // cancels its jobs
+  const int generation = ++m_loadGeneration;
   m_isLoading.store(true);
+  m_reader = std::move(reader);
+  const orpheus::AudioFileMetadata metadata = opened.value;
+
+  // Target width (pixels) - use current component width or default to 800
+  // Quadruple resolution for fine visual edits (4 data points per pixel for 16x zoom)
+  int targetWidth = getWidth() * 4;
+  if (targetWidth <= 0)
+    targetWidth = 3200;
 
   // CRITICAL: Use SafePointer to prevent use-after-free if component is destroyed
-  // while background thread is running
+  // before the repaint is delivered
   juce::Component::SafePointer<WaveformDisplay> safeThis(this);
 
-  juce::Thread::launch([safeThis, audioFile, filePath]() {
-    // Check if component still exists before accessing it
-    if (auto* self = safeThis.getComponent()) {
-      self->generateWaveformData(audioFile);
-      self->m_isLoading.store(false);
-
-      // Store in cache (limit to 5 most recent waveforms to prevent memory bloat)
-      {
-        juce::ScopedLock lock(self->m_dataLock);
-        self->m_waveformCache[filePath] = self->m_waveformData;
-        self->m_cachedFilePath = filePath;
-
-        // Limit cache size to 5 files
-        if (self->m_waveformCache.size() > 5) {
-          // Remove oldest entry (first in map)
-          self->m_waveformCache.erase(self->m_waveformCache.begin());
-          DBG("WaveformDisplay: Cache full, evicted oldest waveform");
-        }
-      }
-
-      // Trigger repaint on message thread (check again if component still exists)
-      juce::MessageManager::callAsync([safeThis]() {
-        if (auto* self = safeThis.getComponent()) {
-          self->repaint();
-        }
+  // The SDK sends a coarse overview first, then refined tiles as it builds the LOD
+  // pyramid on its analysis workers (one exact tile if a peak file exists). Tiles
+  // arrive there; this component outlives them because destroying the reader waits
+  m_reader->getWaveformDataProgressive(
+      0, metadata.duration_samples, static_cast<uint32_t>(targetWidth),
+      [this, safeThis, metadata, filePath, generation,
+       targetWidth](const orpheus::WaveformTile& tile) {
+        if (generation != m_loadGeneration.load())
+          return; // Superseded by a newer file or cancelled by destruction
+
+        applyWaveformTile(tile, metadata, filePath, targetWidth);
+        m_isLoading.store(false); // Paint whatever has arrived
+
+        // Trigger repaint on message thread (check again if component still exists)
+        juce::MessageManager::callAsync([safeThis]() {
+          if (auto* self = safeThis.getComponent()) {
+            self->repaint();
+          }
+        });
       });
-
-      DBG("WaveformDisplay: Cached waveform for "
-          << audioFile.getFileName() << " (cache size: " << self->m_waveformCache.size() << ")");
-    }
-  });
 }
 
 void WaveformDisplay::setTrimPoints(int64_t trimInSamples, int64_t trimOutSamples) {
@@ -383,85 +393,66 @@ void WaveformDisplay::mouseUp(const juce::MouseEvent&) {
 }
 
 //==============================================================================
-void WaveformDisplay::generateWaveformData(const juce::File& audioFile) {
-  juce::AudioFormatManager formatManager;
-  formatManager.registerBasicFormats(); // WAV, AIFF
+void WaveformDisplay::applyWaveformTile(const orpheus::WaveformTile& tile,
+                                        const orpheus::AudioFileMetadata& metadata,
+                                        const juce::String& filePath, int targetWidth) {
+  juce::ScopedLock lock(m_dataLock);
 
-  std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(audioFile));
+  if (!tile.channels.empty()) {
+    // The first tile of a file replaces the previous waveform
+    if (m_cachedFilePath != filePath || !m_waveformData.isValid) {
+      WaveformData newData;
+      newData.sampleRate = static_cast<int>(metadata.sample_rate);
+      newData.numChannels = static_cast<int>(metadata.num_channels);
+      newData.totalSamples = metadata.duration_samples;
+      newData.minValues.assign(static_cast<size_t>(targetWidth), 0.0f);
+      newData.maxValues.assign(static_cast<size_t>(targetWidth), 0.0f);
+      newData.isValid = true;
+      m_waveformData = std::move(newData);
+      m_cachedFilePath = filePath;
+    }
 
-  if (!reader) {
-    DBG("WaveformDisplay: Failed to create reader for: " << audioFile.getFullPathName());
-    return;
+    // Coarse overview or refined tile: either way it overwrites its columns
+    mixToMono(tile.channels, tile.firstPixel, m_waveformData);
   }
 
-  WaveformData newData;
-  newData.sampleRate = static_cast<int>(reader->sampleRate);
-  newData.numChannels = static_cast<int>(reader->numChannels);
-  newData.totalSamples = reader->lengthInSamples;
-
-  // Target width (pixels) - use current component width or default to 800
-  // Quadruple resolution for fine visual edits (4 data points per pixel for 16x zoom)
-  int targetWidth = getWidth() * 4;
-  if (targetWidth <= 0)
-    targetWidth = 3200;
-
-  // Downsample: samples per pixel column (now 2x resolution)
-  int64_t samplesPerPixel = std::max<int64_t>(1, newData.totalSamples / targetWidth);
-
-  newData.minValues.resize(targetWidth, 0.0f);
-  newData.maxValues.resize(targetWidth, 0.0f);
-
-  // Read audio in chunks
-  const int bufferSize = 8192;
-  juce::AudioBuffer<float> buffer(newData.numChannels, bufferSize);
-
-  int64_t samplesRead = 0;
-  int pixelIndex = 0;
-
-  while (samplesRead < newData.totalSamples && pixelIndex < targetWidth) {
-    int64_t samplesToRead = std::min<int64_t>(bufferSize, newData.totalSamples - samplesRead);
-
-    reader->read(&buffer, 0, static_cast<int>(samplesToRead), samplesRead, true, true);
+  if (!tile.complete || !m_waveformData.isValid || m_cachedFilePath != filePath) {
+    return;
+  }
 
-    // Process buffer to find min/max for current pixel columns
-    for (int i = 0; i < samplesToRead; ++i) {
-      int64_t globalSampleIndex = samplesRead + i;
-      int currentPixel = static_cast<int>(globalSampleIndex / samplesPerPixel);
+  // Only finished waveforms are cached (limit to 5 to prevent memory bloat)
+  m_waveformCache[filePath] = m_waveformData;
+  if (m_waveformCache.size() > 5) {
+    // Remove oldest entry (first in map)
+    m_waveformCache.erase(m_waveformCache.begin());
+    DBG("WaveformDisplay: Cache full, evicted oldest waveform");
+  }
 
-      if (currentPixel >= targetWidth)
-        break;
+  DBG("WaveformDisplay: Generated waveform with " << targetWidth << " pixels, "
+                                                  << metadata.duration_samples << " samples");
+}
 
-      // Mix all channels to mono for waveform display
-      float sampleValue = 0.0f;
-      for (int ch = 0; ch < newData.numChannels; ++ch) {
-        sampleValue += buffer.getSample(ch, i);
-      }
-      sampleValue /= static_cast<float>(newData.numChannels);
-
-      // Track min/max for this pixel column
-      if (globalSampleIndex % samplesPerPixel == 0) {
-        // Start new pixel column
-        newData.minValues[currentPixel] = sampleValue;
-        newData.maxValues[currentPixel] = sampleValue;
-      } else {
-        newData.minValues[currentPixel] = std::min(newData.minValues[currentPixel], sampleValue);
-        newData.maxValues[currentPixel] = std::max(newData.maxValues[currentPixel], sampleValue);
+void WaveformDisplay::mixToMono(const std::vector<orpheus::WaveformData>& channels,
+                                uint32_t firstPixel, WaveformData& data) {
+  if (channels.empty() || firstPixel >= data.minValues.size())
+    return;
+  const size_t count =
+      std::min(channels.front().minPeaks.size(), data.minValues.size() - firstPixel);
+
+  // Mix all channels to mono for waveform display (mean of the per-channel extremes)
+  const float scale = 1.0f / static_cast<float>(channels.size());
+  for (size_t i = 0; i < count; ++i) {
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    for (const auto& channel : channels) {
+      if (i < channel.minPeaks.size() && i < channel.maxPeaks.size()) {
+        minValue += channel.minPeaks[i];
+        maxValue += channel.maxPeaks[i];
       }
     }
-
-    samplesRead += samplesToRead;
-  }
-
-  newData.isValid = true;
-
-  // Update member data (thread-safe)
-  {
-    juce::ScopedLock lock(m_dataLock);
-    m_waveformData = std::move(newData);
+    data.minValues[firstPixel + i] = minValue * scale;
+    data.maxValues[firstPixel + i] = maxValue * scale;
   }
-
-  DBG("WaveformDisplay: Generated waveform with " << targetWidth << " pixels, "
-                                                  << newData.totalSamples << " samples");
 }
 
 void WaveformDisplay::drawWaveform(juce::Graphics& g, const juce::Rectangle<float>& bounds) {
@@ -5,6 +5,8 @@
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_gui_extra/juce_gui_extra.h>
 #include <map>
+#include <memory>
+#include <orpheus/audio_file_reader_extended.h>
 #include <vector>
 
 //==============================================================================
@@ -18,7 +20,12 @@
  * - Support for stereo/mono files
  *
  * Threading:
- * - Waveform data generation happens on background thread
+ * - Waveform data comes from the SDK's extended reader: its LOD pyramid is built (or
+ *   loaded from the peak file) on the SDK's analysis workers, never by decoding here
+ * - Progressive: a coarse overview paints at once, refined tiles replace it as the
+ *   pyramid fills
+ * - The columns are fetched once per file at 4x the width; zooming only selects a
+ *   range of them, so it never touches the audio file
  * - Rendering happens on message thread (paint())
  * - Thread-safe via atomic flag and mutex
  */
@@ -84,7 +91,12 @@ private:
     bool isValid = false;
   };
 
-  void generateWaveformData(const juce::File& audioFile);
+  void applyWaveformTile(const orpheus::WaveformTile& tile,
+                         const orpheus::AudioFileMetadata& metadata, const juce::String& filePath,
+                         int targetWidth);
+  // Average SDK per-channel columns into data's mono columns from firstPixel on
+  static void mixToMono(const std::vector<orpheus::WaveformData>& channels, uint32_t firstPixel,
+                        WaveformData& data);
   void drawWaveform(juce::Graphics& g, const juce::Rectangle<float>& bounds);
   void drawTrimMarkers(juce::Graphics& g, const juce::Rectangle<float>& bounds);
   void drawAuditionHighlight(juce::Graphics& g, const juce::Rectangle<float>& bounds);
@@ -97,6 +109,10 @@ private:
   int64_t m_playheadPosition = 0;
   std::atomic<bool> m_isLoading{false};
 
+  // SDK reader of the current file (owns the LOD pyramid; destroying it cancels its jobs)
+  std::unique_ptr<orpheus::IAudioFileReaderExtended> m_reader;
+  std::atomic<int> m_loadGeneration{0}; // Bumped per load; stale callbacks are ignored
+
   // Audition region (for 2s end audition visual feedback)
   bool m_auditionActive = false;
   int64_t m_auditionStart = 0;
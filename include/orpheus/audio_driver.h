@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <orpheus/realtime_thread.h>
 #include <orpheus/transport_controller.h> // For SessionGraphError
 
 #include <cstddef>
@@ -8,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace orpheus {
 
@@ -33,6 +35,53 @@ public:
   /// @param num_frames Number of frames to process
   virtual void processAudio(const float** input_buffers, float** output_buffers,
                             size_t num_channels, size_t num_frames) = 0;
+
+  /// Processing latency added by the callback (e.g. limiter look-ahead)
+  ///
+  /// Named apart from IAudioDriver::getLatencySamples() so hosts that implement
+  /// this interface and also report driver latency do not override it by accident.
+  /// @return Latency in samples, included in IAudioDriver::getLatencySamples()
+  virtual uint32_t getProcessingLatencySamples() const {
+    return 0;
+  }
+
+  /// Called after a processAudio() call that finished past its deadline (audio thread)
+  ///
+  /// Drivers time every callback against the period it renders and report
+  /// misses here and to their performance monitor. Forward to
+  /// TransportController::reportBufferUnderrun() to reach
+  /// ITransportCallback::onBufferUnderrun().
+  /// @param cause Whether processing was too slow or the thread was off the CPU
+  virtual void onUnderrun(UnderrunCause /*cause*/) {}
+};
+
+/// Sample clock of a running audio driver
+///
+/// Counts frames delivered since start(). For hardware drivers it follows the
+/// device; a freewheeling driver runs a virtual clock that only moves when
+/// advance() is called, with callbacks back-to-back, so an hour of audio can be
+/// rendered in seconds and every command lands on a reproducible block.
+class IAudioClock {
+public:
+  virtual ~IAudioClock() = default;
+
+  /// Frames delivered since start() (any thread)
+  virtual uint64_t getSampleTime() const = 0;
+
+  /// Clock rate in Hz
+  virtual uint32_t getSampleRate() const = 0;
+
+  /// True when callbacks run on a virtual clock rather than in real time
+  virtual bool isFreewheeling() const = 0;
+
+  /// Move the clock forward and wait for it (not from the audio thread)
+  ///
+  /// Freewheeling clocks render the frames back-to-back; real-time clocks wait
+  /// for them to play. Callbacks deliver whole buffers, so the clock may end
+  /// past the target by less than one buffer.
+  /// @param frames Frames to advance by
+  /// @return Sample time reached (less than the target if the driver stopped)
+  virtual uint64_t advance(uint64_t frames) = 0;
 };
 
 /// Audio driver interface
@@ -65,14 +114,97 @@ public:
   virtual std::string getDriverName() const = 0;
 
   /// Get current device latency in samples
-  /// @return Total round-trip latency (input + output)
+  /// @return Total round-trip latency (input + output + callback processing latency)
   virtual uint32_t getLatencySamples() const = 0;
+
+  /// Get the driver's sample clock
+  /// @return Clock, or nullptr if the driver does not expose one
+  virtual IAudioClock* getClock() {
+    return nullptr;
+  }
+};
+
+/// Scheduling noise injected by the dummy driver (simulates a loaded OS on CI machines)
+struct DummyDriverJitter {
+  uint32_t maxWakeupDelayUs = 0; ///< Each wake-up is delayed by a uniform 0..max µs
+  double stallProbability = 0.0; ///< Chance per callback of an additional stall
+  uint32_t stallUs = 0;          ///< Length of an injected stall (e.g. a preempted thread)
+  uint32_t seed = 1;             ///< Random seed (runs are reproducible)
+};
+
+/// Dummy audio driver options
+struct DummyDriverOptions {
+  DummyDriverJitter jitter; ///< Disabled by default
+
+  /// Run callbacks back-to-back on a virtual sample clock, driven by
+  /// IAudioClock::advance() (jitter does not apply)
+  bool freewheel = false;
+
+  /// Simulated crystal error: the device plays sample_rate * (1 + clockPpm / 1e6)
+  /// frames per second of the monotonic clock (real-time pacing only)
+  double clockPpm = 0.0;
+
+  /// Audio thread setup: denormals flushed and stack pre-faulted, but no
+  /// real-time policy or memory locking by default (the dummy driver mostly runs
+  /// in tests); set a policy to pace a headless render with SCHED_FIFO
+  RealtimeThreadConfig realtime{.name = "dummy-audio",
+                                .policy = RealtimePolicy::None,
+                                .lockMemory = false};
 };
 
 /// Factory function for dummy audio driver (for testing)
+///
+/// Callbacks are paced against absolute deadlines derived from the sample
+/// clock (buffer_size / sample_rate apart), so the callback rate does not drift
+/// with processing time. With DummyDriverOptions::freewheel, callbacks run as
+/// fast as they complete whenever getClock()->advance() asks for frames.
+///
 /// @return New dummy audio driver instance
 std::unique_ptr<IAudioDriver> createDummyAudioDriver();
 
+/// Factory function for a dummy audio driver with jitter injection
+std::unique_ptr<IAudioDriver> createDummyAudioDriver(const DummyDriverOptions& options);
+
+/// Aggregate audio driver options
+struct AggregateDriverOptions {
+  /// Output channels on each sub-device: aggregate channel c plays on device
+  /// c / outputsPerDevice (the aggregate has devices * outputsPerDevice outputs)
+  uint16_t outputsPerDevice = 2;
+
+  /// Device name per sub-device (missing entries = default device; the master
+  /// falls back to AudioDriverConfig::device_name)
+  std::vector<std::string> deviceNames;
+
+  /// Bandwidth of the PI loop that steers each resampler (Hz): lower rejects
+  /// more timing noise, higher locks faster
+  double loopBandwidthHz = 0.5;
+
+  /// Ring fill the loop holds, i.e. latency added to the other sub-devices
+  /// (0 = 3 * buffer_size)
+  uint32_t targetFillFrames = 0;
+
+  /// Time source in nanoseconds for timestamping ring writes and reads (empty =
+  /// std::chrono::steady_clock). Called from the devices' audio threads; lets
+  /// freewheeling devices be stepped on a simulated timeline
+  std::function<int64_t()> clockNs;
+};
+
+/// Factory function for an aggregate driver presenting several devices as one
+///
+/// The first device is the clock master: its callback runs the aggregate's
+/// callback and plays the first outputsPerDevice channels directly. The
+/// remaining channels go through a ring buffer per sub-device, read by an
+/// adaptive resampler running on that device's own clock. A PI loop on each
+/// ring's fill level steers the resampling ratio, so sub-devices whose
+/// crystals drift from the master neither underrun nor accumulate latency.
+///
+/// @param devices Sub-devices, master first (not initialized; the aggregate owns them)
+/// @param options Channel layout and loop tuning
+/// @return New aggregate driver instance
+std::unique_ptr<IAudioDriver>
+createAggregateAudioDriver(std::vector<std::unique_ptr<IAudioDriver>> devices,
+                           const AggregateDriverOptions& options = {});
+
 /// Factory function for CoreAudio driver (macOS only)
 /// @return New CoreAudio driver instance
 #ifdef __APPLE__
@@ -27,7 +27,7 @@ struct AudioFileMetadata {
   int64_t duration_samples;     ///< Total duration in sample frames
   uint16_t bit_depth;           ///< Bit depth (16, 24, 32)
   std::string codec;            ///< Codec name (e.g., "PCM", "FLAC")
-  std::string file_hash_sha256; ///< SHA-256 hash of file (for integrity verification)
+  std::string file_hash_sha256; ///< SHA-256 of the file if already fingerprinted, else empty
 
   /// Derived: Duration in seconds
   double durationSeconds() const {
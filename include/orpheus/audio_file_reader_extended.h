@@ -3,9 +3,11 @@
 
 #include <orpheus/audio_file_reader.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace orpheus {
@@ -20,6 +22,7 @@ namespace orpheus {
 struct WaveformData {
   std::vector<float> minPeaks; ///< Minimum sample values per pixel (range: -1.0 to 1.0)
   std::vector<float> maxPeaks; ///< Maximum sample values per pixel (range: -1.0 to 1.0)
+  std::vector<float> rms;      ///< RMS level per pixel (same size as minPeaks)
   uint32_t pixelWidth;         ///< Number of pixels (samples per pixel varies)
   uint32_t channelIndex;       ///< Channel this data represents (0 = left, 1 = right, etc.)
   int64_t startSample;         ///< First sample in range (0-based, inclusive)
@@ -41,6 +44,50 @@ struct WaveformData {
   }
 };
 
+/// One delivery of a progressive waveform request (see getWaveformDataProgressive())
+///
+/// A tile covers pixels [firstPixel, firstPixel + channels[0].pixelWidth) of the
+/// requested width; its startSample/endSample span just those pixels.
+struct WaveformTile {
+  uint32_t firstPixel = 0;            ///< First pixel of the request this tile covers
+  bool refined = false;               ///< false = coarse overview from sparse reads
+  bool complete = false;              ///< Last tile of the request
+  std::vector<WaveformData> channels; ///< One per channel (index = channel)
+};
+
+/// Receives the tiles of a progressive waveform request
+using WaveformTileCallback = std::function<void(const WaveformTile& tile)>;
+
+/// Receives the outcome of a precompute request
+/// @param built True if the LOD pyramid is ready; false if the file was not open, the
+///        build failed or it was cancelled
+using WaveformPrecomputeCallback = std::function<void(bool built)>;
+
+/// Scheduling priority of background analysis work (waveforms, peaks, loudness)
+enum class AnalysisPriority : uint8_t {
+  Visible = 0,   ///< Clip is on screen: run before anything else
+  Normal = 1,    ///< Default
+  Background = 2 ///< Speculative work (e.g. off-screen clips of a large import)
+};
+
+/// Snapshot of the shared background analysis scheduler
+struct AnalysisStats {
+  size_t queued = 0;           ///< Jobs waiting to run (queue depth)
+  size_t peakQueued = 0;       ///< Highest queue depth seen
+  size_t running = 0;          ///< Jobs running now
+  size_t runningDiskBound = 0; ///< Running jobs that read files (bounded)
+  uint64_t completed = 0;      ///< Jobs run to completion
+  uint64_t cancelled = 0;      ///< Jobs dropped from the queue or stopped while running
+  double jobsPerSecond = 0.0;  ///< Completed jobs per second since the scheduler started
+  double averageJobMs = 0.0;   ///< Mean run time of completed jobs
+};
+
+/// Statistics of the scheduler that runs precomputeWaveformAsync() work
+///
+/// All extended readers share one bounded pool of analysis workers, with a
+/// limit on how many jobs read from disk at once.
+AnalysisStats getAnalysisStats();
+
 /// Extended audio file reader with waveform pre-processing
 ///
 /// Extends IAudioFileReader with methods for efficient waveform extraction
@@ -51,7 +98,7 @@ struct WaveformData {
 /// - open(), close(): Must be called from background/UI thread (NOT audio thread)
 /// - getWaveformData(): Can be called from background thread (may block 10-100ms)
 /// - getPeakLevel(): Thread-safe, can be called from any thread
-/// - precomputeWaveformAsync(): Thread-safe, spawns background thread
+/// - precomputeWaveformAsync(): Thread-safe, queues work on the shared analysis scheduler
 ///
 /// Performance:
 /// - getWaveformData() for 10-minute WAV → 800px should complete in <100ms
@@ -94,6 +141,48 @@ public:
   virtual WaveformData getWaveformData(int64_t startSample, int64_t endSample, uint32_t pixelWidth,
                                        uint32_t channelIndex) = 0;
 
+  /// Generate waveform data for every channel in one pass
+  ///
+  /// Equivalent to calling getWaveformData() for each channel, but the range is
+  /// read once and all channels are reduced together, so a stereo waveform costs
+  /// one read instead of two. A request covering the whole file also caches
+  /// every channel's peak level.
+  ///
+  /// @param startSample Start of range (0-based, inclusive)
+  /// @param endSample End of range (0-based, exclusive)
+  /// @param pixelWidth Target width in pixels
+  /// @return One WaveformData per channel (index = channel), or empty if the file is
+  ///         not open or parameters are invalid
+  ///
+  /// @note This may block like getWaveformData(), call on background thread
+  virtual std::vector<WaveformData> getWaveformDataMulti(int64_t startSample, int64_t endSample,
+                                                         uint32_t pixelWidth) = 0;
+
+  /// Generate waveform data progressively, coarse to fine
+  ///
+  /// Returns immediately. For a long file whose pyramid is not built yet, the
+  /// callback first receives a coarse overview of the whole request (refined =
+  /// false) from a few hundred short reads spread across the range, then refined
+  /// tiles left to right as the LOD pyramid is built, the last with complete =
+  /// true. When the pyramid or a peak file is already available, or the range is
+  /// zoomed in beyond the pyramid, a single refined, complete tile is delivered.
+  /// Refined tiles hold exactly what getWaveformDataMulti() would return for
+  /// those pixels.
+  ///
+  /// @param startSample Start of range (0-based, inclusive)
+  /// @param endSample End of range (0-based, exclusive)
+  /// @param pixelWidth Target width in pixels
+  /// @param callback Receives each tile, on an analysis worker thread and without the
+  ///        reader's lock held, so it may query this reader (but not close or reopen it)
+  ///
+  /// @note Runs at Visible priority on the shared analysis scheduler
+  /// @note close(), open() and destruction cancel a pending request; no further
+  ///       tiles are then delivered
+  /// @note If the file is not open or parameters are invalid, the callback is called
+  ///       at once with a complete tile holding no channels
+  virtual void getWaveformDataProgressive(int64_t startSample, int64_t endSample,
+                                          uint32_t pixelWidth, WaveformTileCallback callback) = 0;
+
   /// Get peak level for entire file (for normalization)
   ///
   /// Returns the maximum absolute sample value in the file for the specified
@@ -102,7 +191,7 @@ public:
   /// @param channelIndex Channel to analyze (0 = left, 1 = right, etc.)
   /// @return Peak absolute value (0.0 to 1.0+, typically 0.0-1.0 for normalized audio)
   ///
-  /// @note Result is cached after first computation
+  /// @note Result is cached after first computation (all channels are computed together)
   /// @note Returns 0.0 if file not open or channel index invalid
   /// @note Thread-safe (uses internal caching)
   ///
@@ -115,24 +204,55 @@ public:
 
   /// Pre-compute waveform data on background thread
   ///
-  /// Spawns a background thread to pre-process the entire file and cache
-  /// waveform data at multiple resolutions (LOD pyramid). This enables
-  /// instant subsequent getWaveformData() calls at any zoom level.
+  /// Queues a job on the shared analysis scheduler to pre-process the entire
+  /// file and cache waveform data at multiple resolutions (LOD pyramid). This
+  /// enables instant subsequent getWaveformData() calls at any zoom level.
   ///
-  /// @param callback Called when pre-processing complete (optional)
+  /// @param callback Called exactly once with the outcome (optional)
   ///
-  /// @note This spawns background thread, returns immediately
-  /// @note Safe to call multiple times (subsequent calls are no-op)
+  /// @note This queues the work and returns immediately; see setAnalysisPriority()
+  /// @note close(), open() and destruction cancel a pending job; its callbacks are then
+  ///       called with false before they return
+  /// @note Safe to call multiple times: a call while a build runs joins it and is
+  ///       called back when it ends
   /// @note getWaveformData() works without this, but will be slower
   ///
   /// Example:
   /// @code
-  /// reader->precomputeWaveformAsync([this]() {
-  ///     // Update UI to indicate waveform is ready
-  ///     updateWaveformDisplay();
+  /// reader->precomputeWaveformAsync([this](bool built) {
+  ///     // Update UI to indicate waveform is ready (or fall back to streaming)
+  ///     updateWaveformDisplay(built);
   /// });
   /// @endcode
-  virtual void precomputeWaveformAsync(std::function<void()> callback) = 0;
+  virtual void precomputeWaveformAsync(WaveformPrecomputeCallback callback) = 0;
+
+  /// Pre-compute with a completion callback that takes no outcome (the original signature)
+  ///
+  /// @param callback Called once the pyramid is ready; not called if the file is not
+  ///        open, the build fails or it is cancelled
+  /// @deprecated Pass a WaveformPrecomputeCallback to learn about failures too
+  [[deprecated("Use precomputeWaveformAsync(WaveformPrecomputeCallback)")]]
+  void precomputeWaveformAsync(std::function<void()> callback) {
+    if (!callback) {
+      precomputeWaveformAsync(WaveformPrecomputeCallback{});
+      return;
+    }
+    precomputeWaveformAsync(WaveformPrecomputeCallback(
+        [callback = std::move(callback)](bool built) {
+          if (built) {
+            callback();
+          }
+        }));
+  }
+
+  /// Set the priority of this reader's background analysis
+  ///
+  /// Applies to jobs already queued by precomputeWaveformAsync() or
+  /// getWaveformDataProgressive() and to later precompute jobs. UI code raises
+  /// clips to Visible as they scroll into view.
+  ///
+  /// @param priority New priority (default Normal)
+  virtual void setAnalysisPriority(AnalysisPriority priority) = 0;
 };
 
 /// Create extended audio file reader
@@ -140,6 +260,13 @@ public:
 /// Creates an audio file reader with waveform pre-processing capabilities.
 /// Uses libsndfile for decoding (supports WAV, AIFF, FLAC).
 ///
+/// The LOD pyramid built by precomputeWaveformAsync() is saved as a `.orppeaks`
+/// peak file named after the audio content's SHA-256. A later open() of the same,
+/// unchanged file maps it, so waveforms display without decoding; peak files built
+/// from different content are ignored. open() never hashes: the content is hashed
+/// by the pre-computation job and found again through the fingerprint index.
+///
+/// @param peakDirectory Directory for peak files (empty = `<user cache>/orpheus/peaks`)
 /// @return Unique pointer to extended audio file reader
 ///
 /// Example:
@@ -151,6 +278,7 @@ public:
 ///     // Render waveform in UI
 /// }
 /// @endcode
-std::unique_ptr<IAudioFileReaderExtended> createAudioFileReaderExtended();
+std::unique_ptr<IAudioFileReaderExtended>
+createAudioFileReaderExtended(const std::string& peakDirectory = "");
 
 } // namespace orpheus
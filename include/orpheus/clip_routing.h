@@ -30,8 +30,11 @@ class SessionGraph;
 /// - Sample-accurate mute/solo (no mid-buffer discontinuities)
 ///
 /// Thread Safety:
-/// - assignClipToGroup(), setGroup*(): UI thread only
-/// - getClipGroup(), getGroupGain(), isGroup*(): Any thread (atomic reads)
+/// - assignClipToGroup(), setGroup*(), setClipOutputBus(), mapChannels(): UI thread only
+/// - getClipGroup(), getClipOutputBus(): Any thread (mutex protected, not audio thread)
+/// - getGroupGain(), isGroup*(): Any thread (atomic reads)
+/// - Clip assignments, buses and channel maps reach the audio thread as one
+///   slot-indexed table swapped in atomically (O(1) per-voice lookup)
 ///
 /// Typical Usage:
 /// @code
@@ -57,7 +60,8 @@ public:
   /// @param handle Clip handle from transport controller
   /// @param groupIndex Clip Group index (0-3, or 255 for "no group")
   /// @return SessionGraphError::OK on success
-  /// @note Lock-free update, takes effect immediately in audio thread
+  /// @note Published to the audio thread as a dense routing table, picked up
+  ///       atomically at the start of the next buffer (also for playing voices)
   virtual SessionGraphError assignClipToGroup(ClipHandle handle, uint8_t groupIndex) = 0;
 
   // ========================================================================
@@ -143,7 +147,7 @@ public:
   /// This overrides bus-based routing for individual channels.
   ///
   /// @param handle Clip handle
-  /// @param clipChannel Clip channel (0 = L, 1 = R for stereo clip)
+  /// @param clipChannel Clip channel (0-7, 0 = L, 1 = R for stereo clip)
   /// @param outputChannel Output channel (0-31, 0 = left channel 1, 1 = right channel 2)
   /// @return SessionGraphError::OK on success
   /// @note This is advanced routing - most users will use setClipOutputBus()
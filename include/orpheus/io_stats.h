@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace orpheus {
+
+/// Kind of disk read, as ordered by the shared I/O scheduler
+enum class IoClass : uint8_t {
+  Playback = 0,    ///< Streaming voice refills: deadline is the time until the voice underruns
+  Interactive = 1, ///< Someone is waiting (clip registration, on-screen waveform queries)
+  Background = 2,  ///< Best effort (waveform pyramids, thumbnails, file hashing)
+};
+
+constexpr size_t IO_CLASS_COUNT = 3;
+
+/// Latency distribution in power-of-two microsecond buckets
+struct IoLatencyHistogram {
+  static constexpr size_t BUCKETS = 24;
+
+  /// counts[i]: latencies in [2^i, 2^(i+1)) µs (bucket 0 includes < 1 µs, the last is open-ended)
+  std::array<uint64_t, BUCKETS> counts{};
+
+  uint64_t total() const {
+    uint64_t sum = 0;
+    for (auto count : counts) {
+      sum += count;
+    }
+    return sum;
+  }
+
+  /// Upper bound in milliseconds of the bucket holding a percentile (0 if empty)
+  /// @param fraction Percentile as a fraction (e.g. 0.99)
+  double percentileMs(double fraction) const {
+    const uint64_t all = total();
+    if (all == 0) {
+      return 0.0;
+    }
+    const auto rank = static_cast<uint64_t>(fraction * static_cast<double>(all - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      seen += counts[i];
+      if (seen >= rank) {
+        return static_cast<double>(uint64_t{2} << i) / 1000.0;
+      }
+    }
+    return static_cast<double>(uint64_t{2} << (BUCKETS - 1)) / 1000.0;
+  }
+};
+
+/// Per-class statistics of the shared I/O scheduler
+struct IoClassStats {
+  uint64_t completed = 0;       ///< Reads issued and finished
+  uint64_t missedDeadlines = 0; ///< Completed after their deadline (never for Background)
+  size_t queued = 0;            ///< Waiting to be issued
+  size_t peakQueued = 0;        ///< Highest queue depth seen
+  size_t inFlight = 0;          ///< Issued and not yet finished
+  IoLatencyHistogram wait;      ///< Time queued before being issued
+  IoLatencyHistogram latency;   ///< Queued plus service time
+};
+
+/// Snapshot of the shared I/O scheduler
+struct IoStats {
+  std::array<IoClassStats, IO_CLASS_COUNT> classes;
+
+  const IoClassStats& operator[](IoClass io_class) const {
+    return classes[static_cast<size_t>(io_class)];
+  }
+};
+
+/// Statistics of the process-wide scheduler that orders disk reads
+///
+/// Playback streaming, clip loading, waveform analysis and file hashing of
+/// every transport in the process share one scheduler, which issues reads
+/// earliest deadline first with a concurrency cap per class.
+IoStats getIoStats();
+
+} // namespace orpheus
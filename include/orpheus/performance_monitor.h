@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include <orpheus/realtime_thread.h>
+
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -9,6 +11,7 @@
 namespace orpheus {
 
 // Forward declarations
+class IAudioClock;
 namespace core {
 class SessionGraph;
 } // namespace core
@@ -22,9 +25,12 @@ struct PerformanceMetrics {
   float cpuUsagePercent;          ///< CPU usage (0-100%)
   float latencyMs;                ///< Round-trip latency in milliseconds
   uint32_t bufferUnderrunCount;   ///< Total dropout count since start
+  uint32_t slowUnderrunCount;     ///< Dropouts from callbacks too slow for the period
+  uint32_t preemptUnderrunCount;  ///< Dropouts from the audio thread being off the CPU
   uint32_t activeClipCount;       ///< Currently playing clips
   uint64_t totalSamplesProcessed; ///< Lifetime sample count
-  double uptimeSeconds;           ///< Time since audio thread started
+  double uptimeSeconds;           ///< Time since audio thread started (sample clock if attached)
+  bool freewheeling;              ///< Attached clock runs callbacks back-to-back (not real time)
 };
 
 /// Performance monitor for diagnostics and metering
@@ -56,10 +62,10 @@ public:
   /// @note Typical use: Poll at 30 Hz from UI thread for real-time display
   virtual PerformanceMetrics getMetrics() const = 0;
 
-  /// Reset buffer underrun counter
+  /// Reset buffer underrun counters
   ///
-  /// This resets the dropout counter to zero. Useful after resolving
-  /// performance issues to verify the fix.
+  /// This resets the dropout counters (total and per cause) to zero. Useful
+  /// after resolving performance issues to verify the fix.
   ///
   /// @note Thread-safe: Can be called from any thread
   virtual void resetUnderrunCount() = 0;
@@ -133,6 +139,50 @@ public:
   /// @note Thread-safe: Should be called from audio thread
   /// @note Performance: <10 CPU cycles (single atomic increment)
   virtual void reportUnderrun() = 0;
+
+  /// Report a buffer underrun whose cause the driver measured
+  ///
+  /// Drivers call this automatically when a callback finishes after its
+  /// deadline (see classifyDeadlineMiss()). Counts towards bufferUnderrunCount
+  /// and the per-cause count.
+  ///
+  /// @param cause Too little CPU for the period, or the thread was off the CPU
+  ///
+  /// @note Thread-safe: Should be called from audio thread
+  /// @note Performance: Two atomic increments
+  virtual void reportUnderrun(UnderrunCause cause) = 0;
+
+  /// Record how a real-time thread was set up (called by drivers and worker pools)
+  ///
+  /// Threads report once, after configureRealtimeThread() and before their
+  /// processing loop. A report replaces an earlier one with the same name
+  /// (e.g. when a driver is restarted).
+  ///
+  /// @param report Settings actually granted to the thread
+  ///
+  /// @note Thread-safe: Takes a lock, so call it once per thread, outside the steady-state
+  ///       processing loop
+  virtual void reportRealtimeThread(const RealtimeThreadReport& report) = 0;
+
+  /// Get the setup of every real-time thread reported so far
+  ///
+  /// @return Reports in the order the threads first reported
+  ///
+  /// @note Thread-safe: Can be called from any thread
+  /// @note Typical use: diagnostics page ("audio thread: SCHED_FIFO 80, CPU 3, memory locked")
+  virtual std::vector<RealtimeThreadReport> getRealtimeThreads() const = 0;
+
+  /// Attach the driver's sample clock
+  ///
+  /// With a clock attached, uptimeSeconds is the clock's sample time (so a
+  /// freewheeling soak test reports the hours it rendered, not the seconds it
+  /// took) and freewheeling reflects the clock's mode.
+  ///
+  /// @param clock Driver clock (nullptr = wall-clock uptime); must outlive the monitor
+  ///              or be detached first
+  ///
+  /// @note Thread-safe: Can be called from any thread
+  virtual void setAudioClock(const IAudioClock* clock) = 0;
 };
 
 /// Create performance monitor instance
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace orpheus {
+
+/// Scheduling policy requested for an audio thread
+enum class RealtimePolicy : uint8_t {
+  None = 0,       ///< Leave the thread's scheduling unchanged
+  Fifo = 1,       ///< SCHED_FIFO (time-critical priority on Windows)
+  RoundRobin = 2, ///< SCHED_RR (time-critical priority on Windows)
+};
+
+/// Process memory locking actually in effect
+enum class MemoryLock : uint8_t {
+  None = 0,             ///< Pages may be swapped or reclaimed
+  Current = 1,          ///< Pages mapped so far are locked (`MCL_CURRENT`)
+  CurrentAndFuture = 2, ///< New mappings are locked too (`MCL_FUTURE`)
+};
+
+/// Why an audio callback missed its deadline
+enum class UnderrunCause : uint8_t {
+  SlowProcessing = 0, ///< The callback used more CPU time than a whole period
+  Preempted = 1,      ///< The thread was off the CPU (preempted, blocked or woken late)
+};
+
+/// How to set up a thread that runs audio callbacks or audio worker tasks
+struct RealtimeThreadConfig {
+  const char* name = "audio";                   ///< Shown in reports (static storage)
+  RealtimePolicy policy = RealtimePolicy::Fifo; ///< Requested scheduling policy
+  int priority = 80;                            ///< 1-99, clamped to what the system allows
+  int cpu = -1;                                 ///< CPU to pin to (-1 = no pinning)
+  bool lockMemory = true;                       ///< mlockall() the process (once per process)
+  bool flushDenormals = true;                   ///< Set FTZ/DAZ in the FP control register
+  size_t prefaultStackBytes = 64 * 1024;        ///< Stack touched up front (0 = none)
+};
+
+/// What configureRealtimeThread() was actually granted
+///
+/// Unprivileged processes typically get no real-time policy (or a priority
+/// clamped to RLIMIT_RTPRIO) and at most `MemoryLock::Current`; the thread
+/// runs anyway, so check the report rather than assuming the request held.
+struct RealtimeThreadReport {
+  std::string name;                             ///< RealtimeThreadConfig::name
+  RealtimePolicy requestedPolicy = RealtimePolicy::None;
+  RealtimePolicy policy = RealtimePolicy::None; ///< Granted policy
+  int priority = 0;                             ///< Granted priority (0 without a policy)
+  int cpu = -1;                                 ///< CPU pinned to (-1 = not pinned)
+  MemoryLock memoryLock = MemoryLock::None;     ///< Process-wide state after the call
+  bool denormalsFlushed = false;                ///< FTZ/DAZ set on this thread
+  size_t prefaultedStackBytes = 0;              ///< Stack touched up front
+};
+
+/// Set up the calling thread for real-time audio
+///
+/// Each step falls back rather than failing: a refused policy is retried at
+/// the RLIMIT_RTPRIO ceiling and then left unchanged, a refused pin leaves the
+/// thread unpinned, and memory is locked with `MCL_FUTURE` only when the
+/// memlock limit cannot make later allocations fail. Call once at the start of
+/// the thread, before its first callback (not from inside the processing loop).
+///
+/// @return The settings actually in effect
+RealtimeThreadReport configureRealtimeThread(const RealtimeThreadConfig& config);
+
+/// Lock the process's memory (idempotent, any thread)
+/// @return Locking in effect after the call
+MemoryLock lockProcessMemory();
+
+/// Set flush-to-zero and denormals-are-zero on the calling thread
+/// @return false on architectures without such flags
+bool flushDenormalsOnThisThread();
+
+/// Touch every page of a buffer so the audio thread never page-faults on it
+///
+/// Each page is read and written back unchanged, which also breaks
+/// copy-on-write and zero-page sharing of freshly allocated memory.
+void prefaultMemory(void* data, size_t bytes);
+
+/// CPU time consumed so far by the calling thread
+///
+/// `CLOCK_THREAD_CPUTIME_ID` (a system call on Linux, so read it twice per
+/// callback rather than in inner loops); GetThreadTimes() on Windows, which
+/// only advances at the scheduler tick.
+/// @return Nanoseconds, or 0 where unavailable
+int64_t threadCpuTimeNs();
+
+/// Attribute a missed deadline to processing or to scheduling
+///
+/// A callback that needed more CPU time than the period it renders could not
+/// keep up even on an idle machine. One that needed less was late because its
+/// thread spent wall time off the CPU: preempted, blocked, or woken late.
+/// @param callbackCpuNs Thread CPU time spent in the callback (threadCpuTimeNs() delta)
+/// @param periodNs Duration of the audio the callback rendered
+UnderrunCause classifyDeadlineMiss(int64_t callbackCpuNs, int64_t periodNs);
+
+} // namespace orpheus
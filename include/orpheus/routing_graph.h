@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <orpheus/realtime_thread.h>
+#include <orpheus/transport_controller.h> // For SessionGraphError
+#include <string>
+
+namespace orpheus {
+
+class IPerformanceMonitor;
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+/// Routing graph node identifier (0 = invalid)
+using RoutingNodeId = uint32_t;
+
+/// Invalid node identifier (returned when a node cannot be created)
+constexpr RoutingNodeId INVALID_ROUTING_NODE = 0;
+
+/// Maximum channels carried by a single node (input, bus or master)
+constexpr uint8_t MAX_ROUTING_NODE_CHANNELS = 8;
+
+// ============================================================================
+// Routing Graph Types
+// ============================================================================
+
+/// Where a send taps its source bus
+enum class SendTap : uint8_t {
+  PostInsert = 0, ///< After the source's insert chain (normal routing, post-fader sends)
+  PreInsert = 1   ///< Before the source's insert chain (pre-insert aux sends)
+};
+
+/// Routing graph configuration
+struct RoutingGraphConfig {
+  uint32_t sample_rate; ///< Sample rate in Hz (passed to inserts)
+  uint32_t max_frames;  ///< Largest block passed to process() [1-8192]
+  uint8_t num_inputs;   ///< Number of input channels passed to process() [1-64]
+  uint8_t num_outputs;  ///< Number of master output channels [1-8]
+
+  /// Default constructor (matches the transport: 32 mono clip channels, stereo out)
+  RoutingGraphConfig() : sample_rate(48000), max_frames(2048), num_inputs(32), num_outputs(2) {}
+};
+
+/// Summary of the currently committed execution schedule
+struct RoutingGraphInfo {
+  uint32_t num_nodes;           ///< Scheduled nodes (buses + master, unreachable nodes pruned)
+  uint32_t num_sends;           ///< Scheduled connections
+  uint32_t num_levels;          ///< Dependency levels (nodes within a level run in parallel)
+  uint32_t max_level_width;     ///< Largest number of nodes in a single level
+  uint32_t num_channel_buffers; ///< Mono scratch buffers after lifetime-based reuse
+
+  RoutingGraphInfo()
+      : num_nodes(0), num_sends(0), num_levels(0), max_level_width(0), num_channel_buffers(0) {}
+};
+
+// ============================================================================
+// Extension Points
+// ============================================================================
+
+/// Insert processor placed on a bus or the master (EQ, dynamics, ...)
+///
+/// Inserts run in place on the node's channel buffers, possibly on a worker
+/// thread. They must be real-time safe: no locks, no allocation, no I/O.
+class IRoutingInsert {
+public:
+  virtual ~IRoutingInsert() = default;
+
+  /// Prepare for processing (UI thread, called once when added to a node)
+  /// @param sample_rate Sample rate in Hz
+  /// @param max_frames Largest block passed to process()
+  /// @param num_channels Channels of the node the insert is placed on
+  virtual void prepare(uint32_t sample_rate, uint32_t max_frames, uint8_t num_channels) = 0;
+
+  /// Process audio in place (audio or worker thread)
+  /// @param channels Channel buffers [num_channels][num_frames]
+  /// @param num_channels Number of channels
+  /// @param num_frames Number of frames
+  virtual void process(float* const* channels, uint8_t num_channels, uint32_t num_frames) = 0;
+};
+
+/// Worker pool used to run independent graph branches in parallel
+///
+/// run() is called from the audio thread. Implementations must keep their
+/// threads pre-spawned and must not allocate or lock while dispatching.
+class IRoutingWorkerPool {
+public:
+  virtual ~IRoutingWorkerPool() = default;
+
+  /// Task entry point
+  using TaskFunction = void (*)(void* context, size_t task_index);
+
+  /// Number of worker threads (excluding the calling thread)
+  virtual size_t getWorkerCount() const = 0;
+
+  /// Execute tasks [0, num_tasks) and return once all have completed
+  /// @param function Task entry point
+  /// @param context Opaque pointer passed to every task
+  /// @param num_tasks Number of tasks
+  /// @note The calling thread participates in the work
+  virtual void run(TaskFunction function, void* context, size_t num_tasks) = 0;
+};
+
+// ============================================================================
+// Routing Graph Interface
+// ============================================================================
+
+/// Compiled DSP routing graph (aux sends, nested submixes, inserts)
+///
+/// Extends the fixed channels → groups → master topology of IRoutingMatrix
+/// with arbitrary acyclic routing between buses:
+/// - Inputs (mono or multichannel clip outputs) feed buses or the master
+/// - Buses feed other buses (nested submixes) and the master
+/// - Any connection can carry a gain (aux send), tapped pre- or post-insert
+/// - Buses and the master host an insert chain
+///
+/// Edits are made on the UI thread against an editable model. commit()
+/// compiles the model into a flat, topologically ordered schedule with
+/// preassigned scratch buffers and publishes it atomically; the audio
+/// thread picks it up at the start of the next process() call. Nodes in the
+/// same dependency level are independent and run on the worker pool when
+/// one is set.
+///
+/// Thread Safety:
+/// - add*(), connect(), disconnect(), setSendGain(), commit(): UI thread only (mutex protected)
+/// - getInfo(): Any thread
+/// - process(): Audio thread only (lock-free, allocation-free)
+///
+/// Typical Usage:
+/// @code
+///   auto graph = createRoutingGraph();
+///   graph->initialize(RoutingGraphConfig{});
+///
+///   RoutingNodeId kick = graph->addInput(0);
+///   RoutingNodeId drums = graph->addBus("Drums", 2);
+///   RoutingNodeId reverb = graph->addBus("Reverb", 2);
+///
+///   graph->connect(kick, drums);
+///   graph->connect(drums, reverb, -12.0f, SendTap::PreInsert); // Aux send
+///   graph->connect(drums, graph->getMasterNode());
+///   graph->connect(reverb, graph->getMasterNode());
+///   graph->commit();
+///
+///   // In audio thread:
+///   graph->process(clip_outputs, master_output, num_frames);
+/// @endcode
+class IRoutingGraph {
+public:
+  virtual ~IRoutingGraph() = default;
+
+  // ========================================================================
+  // Initialization (UI Thread)
+  // ========================================================================
+
+  /// Initialize the graph (clears all nodes except the master)
+  /// @param config Graph configuration
+  /// @return SessionGraphError::OK on success, InvalidParameter on bad config
+  virtual SessionGraphError initialize(const RoutingGraphConfig& config) = 0;
+
+  /// Set the worker pool used for parallel branches (takes effect on commit)
+  /// @param pool Worker pool (nullptr = single-threaded), must outlive the graph
+  virtual void setWorkerPool(IRoutingWorkerPool* pool) = 0;
+
+  // ========================================================================
+  // Graph Editing (UI Thread, applied by commit())
+  // ========================================================================
+
+  /// Get the master output node
+  virtual RoutingNodeId getMasterNode() const = 0;
+
+  /// Add an input node reading process() input channels
+  /// @param first_input First input channel index
+  /// @param num_channels Number of consecutive input channels [1-8]
+  /// @return Node id, or INVALID_ROUTING_NODE if the range is out of bounds
+  virtual RoutingNodeId addInput(uint8_t first_input, uint8_t num_channels = 1) = 0;
+
+  /// Add a bus (submix) node
+  /// @param name Display name
+  /// @param num_channels Channel count [1-8]
+  /// @return Node id, or INVALID_ROUTING_NODE if the channel count is invalid
+  virtual RoutingNodeId addBus(const std::string& name, uint8_t num_channels) = 0;
+
+  /// Remove an input or bus node and all its connections
+  /// @param node Node id (the master cannot be removed)
+  /// @return SessionGraphError::OK on success
+  virtual SessionGraphError removeNode(RoutingNodeId node) = 0;
+
+  /// Connect two nodes (main route or aux send)
+  /// @param source Source node (input or bus)
+  /// @param destination Destination node (bus or master)
+  /// @param gain_db Send gain in dB (-100 = silent, max +12)
+  /// @param tap Tap point on the source's insert chain
+  /// @return SessionGraphError::OK, InvalidHandle for unknown nodes,
+  ///         InvalidParameter for duplicates, self-loops or invalid directions
+  /// @note Cycles are detected by commit()
+  virtual SessionGraphError connect(RoutingNodeId source, RoutingNodeId destination,
+                                    float gain_db = 0.0f,
+                                    SendTap tap = SendTap::PostInsert) = 0;
+
+  /// Remove a connection
+  /// @return SessionGraphError::OK, or InvalidParameter if not connected
+  virtual SessionGraphError disconnect(RoutingNodeId source, RoutingNodeId destination) = 0;
+
+  /// Change a connection's gain without recompiling
+  /// @param gain_db Send gain in dB (-100 = silent, max +12)
+  /// @return SessionGraphError::OK, or InvalidParameter if not connected
+  /// @note The audio thread reads the new gain lock-free and ramps to it across the next block
+  virtual SessionGraphError setSendGain(RoutingNodeId source, RoutingNodeId destination,
+                                        float gain_db) = 0;
+
+  /// Append an insert to a bus or the master
+  /// @param node Bus or master node
+  /// @param insert Insert processor (prepare() is called immediately)
+  /// @return SessionGraphError::OK on success
+  virtual SessionGraphError addInsert(RoutingNodeId node,
+                                      std::shared_ptr<IRoutingInsert> insert) = 0;
+
+  /// Remove all inserts from a bus or the master
+  virtual SessionGraphError clearInserts(RoutingNodeId node) = 0;
+
+  /// Compile the model and publish the new schedule to the audio thread
+  /// @return SessionGraphError::OK, or InvalidParameter if the graph has a cycle
+  /// @note The previous schedule is released on a later commit (never on the audio thread)
+  virtual SessionGraphError commit() = 0;
+
+  /// Get a summary of the last committed schedule
+  virtual RoutingGraphInfo getInfo() const = 0;
+
+  // ========================================================================
+  // Audio Processing (Audio Thread, Lock-Free)
+  // ========================================================================
+
+  /// Execute the current schedule
+  /// @param inputs Input buffers [num_inputs][num_frames] (planar float32)
+  /// @param outputs Output buffers [num_outputs][num_frames] (planar float32)
+  /// @param num_frames Number of frames (<= max_frames)
+  /// @return SessionGraphError::OK, NotInitialized before the first commit(),
+  ///         InvalidParameter if num_frames exceeds max_frames
+  virtual SessionGraphError process(const float* const* inputs, float** outputs,
+                                    uint32_t num_frames) = 0;
+};
+
+// ============================================================================
+// Factory Functions
+// ============================================================================
+
+/// Create routing graph instance
+/// @return Unique pointer to routing graph
+std::unique_ptr<IRoutingGraph> createRoutingGraph();
+
+/// Create a worker pool for parallel graph execution
+/// @param num_workers Number of worker threads (0 = hardware concurrency - 1)
+/// @return Unique pointer to worker pool
+std::unique_ptr<IRoutingWorkerPool> createRoutingWorkerPool(size_t num_workers = 0);
+
+/// Create a worker pool whose threads are set up for real-time work
+///
+/// Workers run parts of the audio callback, so they need the same scheduling,
+/// denormal flags and memory locking as the audio thread. Worker i is pinned to
+/// `realtime.cpu + i` when a CPU is given (pin the audio thread elsewhere).
+/// @param num_workers Number of worker threads (0 = hardware concurrency - 1)
+/// @param realtime Worker setup; reports are named "<realtime.name>-<i>"
+/// @param monitor Receives what each worker was granted (may be nullptr)
+/// @return Unique pointer to worker pool, returned once every worker is set up
+std::unique_ptr<IRoutingWorkerPool> createRoutingWorkerPool(size_t num_workers,
+                                                            const RealtimeThreadConfig& realtime,
+                                                            IPerformanceMonitor* monitor = nullptr);
+
+} // namespace orpheus
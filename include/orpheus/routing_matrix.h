@@ -25,6 +25,9 @@ class IRoutingCallback;
 /// Special value indicating channel is not assigned to any group
 constexpr uint8_t UNASSIGNED_GROUP = 255;
 
+/// Number of cascaded EQ bands on each group and on the master
+constexpr uint8_t MAX_EQ_BANDS = 4;
+
 // ============================================================================
 // Routing Configuration Types
 // ============================================================================
@@ -52,6 +55,27 @@ enum class MeteringMode : uint8_t {
   LUFS = 3      ///< Loudness Units Full Scale (broadcast standard)
 };
 
+/// EQ band filter shape (RBJ cookbook biquads)
+enum class EqFilterType : uint8_t {
+  Bypass = 0,    ///< Band disabled (no processing cost when all bands are bypassed)
+  HighPass = 1,  ///< 12 dB/oct high-pass (gain ignored)
+  LowPass = 2,   ///< 12 dB/oct low-pass (gain ignored)
+  Peak = 3,      ///< Peaking bell
+  LowShelf = 4,  ///< Low shelf
+  HighShelf = 5  ///< High shelf
+};
+
+/// One EQ band (group or master insert)
+struct EqBand {
+  EqFilterType type;  ///< Filter shape
+  float frequency_hz; ///< Corner/centre frequency (10 Hz to 0.45 * sample rate)
+  float gain_db;      ///< Gain for Peak/Shelf bands (-24 to +24 dB)
+  float q;            ///< Quality factor (0.1-20, 0.707 = Butterworth)
+
+  /// Default constructor (bypassed)
+  EqBand() : type(EqFilterType::Bypass), frequency_hz(1000.0f), gain_db(0.0f), q(0.707f) {}
+};
+
 /// Channel strip configuration (like a console channel)
 struct ChannelConfig {
   std::string name;    ///< Channel name (e.g., "Kick", "Snare", "Music Bed 1")
@@ -95,13 +119,28 @@ struct RoutingConfig {
   float dim_amount_db;     ///< Dim amount when solo active (-6 to -24 dB, default -12 dB)
 
   bool enable_metering;            ///< Enable real-time metering (small CPU cost)
-  bool enable_clipping_protection; ///< Soft-clip at 0 dBFS to prevent hard clipping
+  bool enable_clipping_protection; ///< Look-ahead limit the master bus below 0 dBFS
+
+  uint32_t sample_rate; ///< Processing sample rate in Hz [8000-384000, default 48000]
+
+  // Master limiter (used when enable_clipping_protection is set)
+  float limiter_threshold_db; ///< Output ceiling (-24 to 0 dBFS/dBTP, default -1 dB)
+  float limiter_lookahead_ms; ///< Look-ahead time (0-20 ms, default 1.5 ms), adds latency
+  float limiter_release_ms;   ///< Release time constant (1-1000 ms, default 50 ms)
+  bool limiter_true_peak;     ///< Detect inter-sample peaks (4x oversampled, +4 samples latency)
+
+  /// Snapshots assign channels to groups. Clear when another component owns the
+  /// assignment (the transport sets each voice's group from clip routing): snapshots
+  /// then keep the live groups and only recall levels, mutes and solos.
+  bool snapshot_channel_groups;
 
   /// Default constructor (sensible defaults for OCC)
   RoutingConfig()
       : num_channels(16), num_groups(4), num_outputs(2), solo_mode(SoloMode::SIP),
         metering_mode(MeteringMode::Peak), gain_smoothing_ms(10.0f), dim_amount_db(-12.0f),
-        enable_metering(true), enable_clipping_protection(true) {}
+        enable_metering(true), enable_clipping_protection(true), sample_rate(48000),
+        limiter_threshold_db(-1.0f), limiter_lookahead_ms(1.5f), limiter_release_ms(50.0f),
+        limiter_true_peak(true), snapshot_channel_groups(true) {}
 };
 
 /// Audio level meters (per-channel or per-group)
@@ -132,6 +171,39 @@ struct RoutingSnapshot {
   RoutingSnapshot() : name("Default"), timestamp_ms(0), master_gain_db(0.0f), master_mute(false) {}
 };
 
+/// Precompiled routing snapshot for allocation-free scene recall
+///
+/// Built on the UI thread by IRoutingMatrix::compileSnapshot(). Holds only
+/// dense numeric arrays (no names), so recallSnapshot() can hand a complete
+/// mix state to the audio thread without strings, smoothers or allocation.
+struct CompiledRoutingSnapshot {
+  uint8_t num_channels; ///< Channel count the snapshot was compiled for
+  uint8_t num_groups;   ///< Group count the snapshot was compiled for
+
+  // Final parameter state (applied when the crossfade completes)
+  std::vector<float> channel_gains;    ///< [channel] Linear fader gain
+  std::vector<float> channel_pans;     ///< [channel] Pan (-1.0 to +1.0)
+  std::vector<uint8_t> channel_groups; ///< [channel] Group index (UNASSIGNED_GROUP = none)
+  std::vector<uint8_t> channel_mutes;  ///< [channel] 1 = muted
+  std::vector<uint8_t> channel_solos;  ///< [channel] 1 = solo'd
+  std::vector<float> group_gains;      ///< [group] Linear fader gain
+  std::vector<uint8_t> group_mutes;    ///< [group] 1 = muted
+  std::vector<uint8_t> group_solos;    ///< [group] 1 = solo'd
+  float master_gain;                   ///< Linear master gain
+  bool master_mute;                    ///< Master mute
+  bool solo_active;                    ///< Any channel or group solo'd
+
+  // Effective levels (mute/solo folded in, interpolated during the crossfade)
+  std::vector<float> channel_levels; ///< [channel] Send to its group, wherever that is
+  std::vector<float> send_levels;  ///< [channel * num_groups + group] channel → group gain
+  std::vector<float> group_levels; ///< [group] Group → master gain
+  float master_level;              ///< Master gain (0 when muted)
+
+  CompiledRoutingSnapshot()
+      : num_channels(0), num_groups(0), master_gain(1.0f), master_mute(false), solo_active(false),
+        master_level(1.0f) {}
+};
+
 // ============================================================================
 // Routing Matrix Interface
 // ============================================================================
@@ -151,9 +223,9 @@ struct RoutingSnapshot {
 /// - Multiple solo modes (SIP, AFL, PFL, Destructive)
 /// - Per-channel and per-group gain with smoothing (click-free)
 /// - Real-time metering (Peak/RMS/TruePeak/LUFS)
-/// - Snapshot/preset system for instant recall
+/// - Snapshot/preset system for instant recall and crossfaded scene changes
 /// - Lock-free audio thread (UI updates never block audio)
-/// - Clipping protection (soft-clip before 0 dBFS)
+/// - Clipping protection (look-ahead true-peak limiter before 0 dBFS)
 /// - Broadcast-safe (zero allocations in audio thread)
 ///
 /// Thread Safety:
@@ -275,6 +347,15 @@ public:
   /// @return Error code
   virtual SessionGraphError configureGroup(uint8_t group_index, const GroupConfig& config) = 0;
 
+  /// Set one band of a group's EQ insert (applied before group gain)
+  /// @param group_index Group index [0, num_groups)
+  /// @param band_index Band index [0, MAX_EQ_BANDS)
+  /// @param band Band settings
+  /// @return Error code
+  /// @note Lock-free handoff, coefficients interpolate across the next buffer
+  virtual SessionGraphError setGroupEqBand(uint8_t group_index, uint8_t band_index,
+                                           const EqBand& band) = 0;
+
   // ========================================================================
   // Master Output Configuration (UI Thread, Lock-Free)
   // ========================================================================
@@ -289,6 +370,13 @@ public:
   /// @return Error code
   virtual SessionGraphError setMasterMute(bool mute) = 0;
 
+  /// Set one band of the master EQ insert (applied after master gain, before the limiter)
+  /// @param band_index Band index [0, MAX_EQ_BANDS)
+  /// @param band Band settings (same filter on every output channel)
+  /// @return Error code
+  /// @note Lock-free handoff, coefficients interpolate across the next buffer
+  virtual SessionGraphError setMasterEqBand(uint8_t band_index, const EqBand& band) = 0;
+
   // ========================================================================
   // State Queries (Any Thread, Lock-Free Reads)
   // ========================================================================
@@ -321,6 +409,15 @@ public:
   /// @return Audio meter
   virtual AudioMeter getMasterMeter() const = 0;
 
+  /// Get gain reduction applied by the master limiter during the last buffer
+  /// @return Gain reduction in dB (0.0 = not limiting)
+  virtual float getLimiterGainReductionDb() const = 0;
+
+  /// Get processing latency introduced by the routing matrix
+  /// @return Latency in samples (limiter look-ahead, 0 when clipping protection is disabled)
+  /// @note Report this to the audio driver so output timing can be compensated
+  virtual uint32_t getLatencySamples() const = 0;
+
   // ========================================================================
   // Snapshot/Preset Management (UI Thread)
   // ========================================================================
@@ -333,9 +430,41 @@ public:
   /// Load routing state from snapshot
   /// @param snapshot Snapshot to load
   /// @return Error code
-  /// @note All parameters smoothly transition to new values
+  /// @note All parameters smoothly transition to new values. Channel groups are
+  ///       left alone unless RoutingConfig::snapshot_channel_groups is set.
   virtual SessionGraphError loadSnapshot(const RoutingSnapshot& snapshot) = 0;
 
+  /// Precompile a snapshot into dense arrays for recallSnapshot() (UI thread)
+  /// @param snapshot Snapshot to compile (must match the channel/group count)
+  /// @param compiled Receives the compiled snapshot
+  /// @return Error code
+  /// @note Allocates; compile scenes ahead of time and keep them for recall
+  virtual SessionGraphError compileSnapshot(const RoutingSnapshot& snapshot,
+                                            CompiledRoutingSnapshot& compiled) const = 0;
+
+  /// Crossfade the whole mix to a compiled snapshot (UI thread)
+  ///
+  /// The audio thread picks the scene up atomically at the start of the next
+  /// buffer and interpolates every channel→group send, group gain and master
+  /// gain linearly (once per buffer, ramped per sample). Group reassignments
+  /// crossfade out of the old group and into the new one. When the crossfade
+  /// completes, faders, mutes, solos and (with
+  /// RoutingConfig::snapshot_channel_groups) group assignments take the
+  /// snapshot values. Without snapshot_channel_groups, the crossfade routes by
+  /// the assignments at its start; channels moved meanwhile switch groups when
+  /// it completes. Recalling during a crossfade starts from the current mix.
+  ///
+  /// @param compiled Snapshot from compileSnapshot()
+  /// @param crossfade_ms Crossfade time (0 = one buffer)
+  /// @return Error code
+  /// @note No allocation or locking on the audio thread. Individual setters
+  ///       called during a crossfade are overridden when it completes.
+  virtual SessionGraphError recallSnapshot(const CompiledRoutingSnapshot& compiled,
+                                           float crossfade_ms) = 0;
+
+  /// Check whether a snapshot crossfade is in progress (any thread)
+  virtual bool isSnapshotMorphing() const = 0;
+
   /// Reset all channels/groups to default state
   /// @return Error code
   virtual SessionGraphError reset() = 0;
@@ -350,10 +479,11 @@ public:
   ///   1. Read channel inputs (from clip outputs)
   ///   2. Apply channel gain/pan/mute/solo
   ///   3. Sum channels into groups
-  ///   4. Apply group gain/mute/solo
+  ///   4. Apply group EQ, then group gain/mute/solo
   ///   5. Sum groups into master output
-  ///   6. Apply master gain/mute
+  ///   6. Apply master gain/mute, then master EQ
   ///   7. Update meters (if enabled)
+  ///   8. Look-ahead limit the master (if clipping protection enabled)
   ///
   /// @param channel_inputs Input buffers [num_channels][num_frames] (planar float32)
   /// @param master_output Output buffer [num_outputs][num_frames] (planar float32)
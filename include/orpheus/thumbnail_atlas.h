@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/transport_controller.h> // For SessionGraphError
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+/// Thumbnails are int16 min/max pairs; divide by this for -1.0..1.0 sample values
+constexpr float THUMBNAIL_FULL_SCALE = 32767.0f;
+
+/// Options for buildThumbnailAtlas()
+struct ThumbnailAtlasOptions {
+  uint32_t width = 128;          ///< Min/max pairs per channel of every thumbnail
+  int64_t framesPerProbe = 2048; ///< Frames read per pixel (pixels spanning fewer are exact)
+  size_t maxThreads = 0;         ///< Files decoded in parallel (0 = hardware concurrency)
+};
+
+/// Description of one file in a thumbnail atlas
+struct ThumbnailInfo {
+  std::string filePath;        ///< Path as passed to buildThumbnailAtlas()
+  bool valid = false;          ///< false if the file could not be read
+  uint16_t numChannels = 0;    ///< Channels in the file (thumbnails stored per channel)
+  uint32_t sampleRate = 0;     ///< Sample rate in Hz
+  int64_t durationSamples = 0; ///< Length in sample frames
+};
+
+/// Memory-mapped thumbnail atlas (`.orpthumbs`)
+///
+/// Fixed-width waveform thumbnails of many files in one contiguous, read-only
+/// mapping, for grids of clip buttons: repainting every thumbnail reads the
+/// mapping instead of opening hundreds of files.
+///
+/// Thread Safety: immutable; query from any thread (including the UI thread).
+class IThumbnailAtlas {
+public:
+  virtual ~IThumbnailAtlas() = default;
+
+  /// Min/max pairs per channel of every thumbnail
+  virtual uint32_t thumbnailWidth() const = 0;
+
+  /// Number of files in the atlas (indices follow the list passed to buildThumbnailAtlas())
+  virtual size_t size() const = 0;
+
+  /// Description of a file (index < size())
+  virtual ThumbnailInfo info(size_t index) const = 0;
+
+  /// Index of a file by the path it was built from
+  virtual std::optional<size_t> find(const std::string& filePath) const = 0;
+
+  /// Quantised thumbnail of one channel, pointing into the mapping
+  /// @return thumbnailWidth() pairs ([pixel * 2] = min, [pixel * 2 + 1] = max, in units of
+  ///         1 / THUMBNAIL_FULL_SCALE), or nullptr if the index or channel is out of range
+  virtual const int16_t* minMaxPairs(size_t index, uint32_t channel) const = 0;
+};
+
+/// Build a thumbnail atlas for a list of files
+///
+/// Files are decoded in parallel with strided reads: each pixel reads at most
+/// options.framesPerProbe frames from the start of its span, so a long file
+/// costs `width` short reads rather than a full decode. Peaks between probes
+/// may be missed; files short enough for every pixel to fit in a probe are
+/// summarised exactly. Min values are rounded down and max values up when
+/// quantised. Unreadable files get an entry marked invalid, with no channels.
+///
+/// The atlas is written atomically (temporary file and rename).
+///
+/// @param filePaths Files to include (may repeat; each entry gets its own thumbnail)
+/// @param atlasPath Output file (conventionally `*.orpthumbs`)
+/// @return OK, InvalidParameter (no files, zero width or probe size), NotReady (no audio
+///         decoder available) or InternalError (atlas could not be written)
+SessionGraphError buildThumbnailAtlas(const std::vector<std::string>& filePaths,
+                                      const std::string& atlasPath,
+                                      const ThumbnailAtlasOptions& options = {});
+
+/// Map a thumbnail atlas
+/// @return Atlas, or nullptr if missing, from another format version, or corrupt
+std::unique_ptr<IThumbnailAtlas> openThumbnailAtlas(const std::string& atlasPath);
+
+} // namespace orpheus
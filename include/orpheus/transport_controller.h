@@ -53,6 +53,15 @@ struct TransportPosition {
   double beats;    ///< Derived: seconds * tempo / 60.0
 };
 
+/// Loudness of a clip's audio file (ITU-R BS.1770-4 / EBU R128)
+/// Measured once, in the background, when the file is registered
+struct ClipLoudness {
+  double integratedLufs = 0.0;  ///< Gated integrated loudness (-inf if nothing passes the gates)
+  double loudnessRangeLu = 0.0; ///< Loudness range, LRA (EBU Tech 3342)
+  double samplePeakDbfs = 0.0;  ///< Highest absolute sample value (-inf for digital silence)
+  double truePeakDbtp = 0.0;    ///< Highest 4x-oversampled value (never below samplePeakDbfs)
+};
+
 /// Clip metadata for batch updates
 /// Contains all configurable playback parameters for a clip
 struct ClipMetadata {
@@ -65,10 +74,16 @@ struct ClipMetadata {
   bool loopEnabled = false;                   ///< true = loop indefinitely
   bool stopOthersOnPlay = false;              ///< true = stop other clips on play
   float gainDb = 0.0f;                        ///< Gain in decibels (0 = unity)
+
+  /// Normalise integrated loudness to this level (nullopt = off); added to gainDb once measured
+  std::optional<float> loudnessTargetLufs;
+
+  /// Measured loudness (read-only: ignored by updateClipMetadata(); nullopt until analysed)
+  std::optional<ClipLoudness> loudness;
 };
 
 /// Session-level default metadata for new clips.
-/// These defaults are applied when registerClipAudio() is called.
+/// These defaults are applied when registerClipAudio() or registerClipsAudio() is called.
 struct SessionDefaults {
   double fadeInSeconds = 0.0;                 ///< Default fade-in time (0.0 = no fade)
   double fadeOutSeconds = 0.0;                ///< Default fade-out time (0.0 = no fade)
@@ -77,6 +92,7 @@ struct SessionDefaults {
   bool loopEnabled = false;                   ///< Default loop mode
   bool stopOthersOnPlay = false;              ///< Default "stop others" mode
   float gainDb = 0.0f;                        ///< Default gain in dB (0.0 = unity)
+  std::optional<float> loudnessTargetLufs;    ///< Default normalisation target (nullopt = off)
 
   // Note: Default color is OCC-specific and stored in SessionManager
 };
@@ -126,6 +142,11 @@ public:
   /// @see onClipRestarted() for restart to IN point
   virtual void onClipSeeked(ClipHandle /*handle*/, TransportPosition /*position*/) {}
 
+  /// Called when the loudness of a registered clip's file has been measured
+  /// @param handle The clip (called once per clip sharing the file)
+  /// @param loudness Measurement, also available from getClipMetadata()
+  virtual void onClipLoudnessAnalysed(ClipHandle /*handle*/, const ClipLoudness& /*loudness*/) {}
+
   /// Called when a buffer underrun occurs (audio dropout)
   /// @param position Position where underrun occurred
   virtual void onBufferUnderrun(TransportPosition position) = 0;
@@ -294,6 +315,8 @@ public:
   /// Gain conversion:
   /// - Linear gain = 10^(gainDb / 20)
   /// - Examples: -6 dB = 0.5, 0 dB = 1.0, +6 dB = 2.0
+  /// - With a loudness target (ClipMetadata::loudnessTargetLufs) and a measurement,
+  ///   target - integratedLufs is added to gainDb before conversion
   ///
   /// Validation:
   /// - gainDb must be finite (not NaN or Inf)
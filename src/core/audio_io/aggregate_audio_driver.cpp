@@ -0,0 +1,476 @@
+// SPDX-License-Identifier: MIT
+#include "aggregate_audio_driver.h"
+
+#include <orpheus/realtime_thread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <utility>
+
+namespace orpheus {
+
+namespace {
+
+/// Largest resampling correction (1%: far beyond any crystal, still inaudible as a glitch)
+constexpr double MAX_CORRECTION = 0.01;
+
+/// Frames of resampler history (4-point Hermite: x[-1], x[0], x[1], x[2])
+constexpr size_t HISTORY_FRAMES = 4;
+
+/// Largest change in measured fill the loop takes from one callback (250 µs of
+/// audio): wake-up jitter passes, a late wake-up is treated as an outlier
+constexpr double MAX_INNOVATION_SECONDS = 250e-6;
+
+/// Times the reader retries a snapshot torn by a concurrent write before using its last one
+constexpr int SNAPSHOT_ATTEMPTS = 4;
+
+int64_t steadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// 4-point, 3rd-order Hermite interpolation between x0 and x1
+float hermite(float xm1, float x0, float x1, float x2, float t) {
+  const float c1 = 0.5f * (x1 - xm1);
+  const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+  const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+  return ((c3 * t + c2) * t + c1) * t + x0;
+}
+
+} // anonymous namespace
+
+struct AggregateAudioDriver::Feed {
+  size_t channels = 0;
+  uint64_t capacity = 0; ///< Ring size in frames
+  uint32_t target = 0;   ///< Fill the loop holds
+  std::vector<float> ring; ///< Interleaved frames
+
+  // Ring indices (frames since start): written by the master, read by the sub-device
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> read{0};
+
+  // Time of the last write, published with `written` under a sequence count
+  std::atomic<uint32_t> write_seq{0};
+  std::atomic<int64_t> written_at_ns{0};
+
+  // Sub-device thread only
+  std::vector<float> history; ///< HISTORY_FRAMES interleaved frames
+  double phase = 0.0;         ///< Position between history frames 1 and 2
+  double error = 0.0;         ///< Smoothed fill error (frames)
+  double integral = 0.0;      ///< Integrator: converges on master rate / sub-device rate - 1
+  bool primed = false;
+  uint64_t last_written = 0;
+  int64_t last_written_at_ns = 0;
+
+  // Published for getStats()
+  std::atomic<double> drift_ppm{0.0};
+  std::atomic<double> ratio{1.0};
+  std::atomic<double> fill{0.0};
+  std::atomic<bool> locked{false};
+  std::atomic<uint64_t> underruns{0};
+  std::atomic<uint64_t> overruns{0};
+  std::atomic<int64_t> resampler_cpu_ns{0};
+  std::atomic<uint64_t> resampled_frames{0};
+
+  void reset() {
+    written.store(0, std::memory_order_relaxed);
+    read.store(0, std::memory_order_relaxed);
+    write_seq.store(0, std::memory_order_relaxed);
+    written_at_ns.store(0, std::memory_order_relaxed);
+    std::fill(history.begin(), history.end(), 0.0f);
+    phase = 0.0;
+    error = 0.0;
+    integral = 0.0;
+    primed = false;
+    last_written = 0;
+    last_written_at_ns = 0;
+    drift_ppm.store(0.0, std::memory_order_relaxed);
+    ratio.store(1.0, std::memory_order_relaxed);
+    fill.store(0.0, std::memory_order_relaxed);
+    locked.store(false, std::memory_order_relaxed);
+    underruns.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    resampler_cpu_ns.store(0, std::memory_order_relaxed);
+    resampled_frames.store(0, std::memory_order_relaxed);
+  }
+
+  /// Append a block (master thread); drops it if the ring is full
+  void push(float* const* source, size_t frames, int64_t now_ns) {
+    const uint64_t head = written.load(std::memory_order_relaxed);
+    if (head - read.load(std::memory_order_acquire) + frames > capacity) {
+      overruns.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    for (size_t i = 0; i < frames; ++i) {
+      float* frame = &ring[((head + i) % capacity) * channels];
+      for (size_t ch = 0; ch < channels; ++ch) {
+        frame[ch] = source[ch][i];
+      }
+    }
+
+    const uint32_t seq = write_seq.load(std::memory_order_relaxed);
+    write_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    written_at_ns.store(now_ns, std::memory_order_relaxed);
+    written.store(head + frames, std::memory_order_release);
+    write_seq.store(seq + 2, std::memory_order_release);
+  }
+
+  /// Latest write count and its time (sub-device thread; never waits on the master)
+  void snapshot() {
+    for (int attempt = 0; attempt < SNAPSHOT_ATTEMPTS; ++attempt) {
+      const uint32_t before = write_seq.load(std::memory_order_acquire);
+      const int64_t at = written_at_ns.load(std::memory_order_relaxed);
+      const uint64_t count = written.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if ((before & 1) == 0 && before == write_seq.load(std::memory_order_relaxed)) {
+        last_written = count;
+        last_written_at_ns = at;
+        return;
+      }
+    }
+  }
+
+  /// Move the history on by one frame from the ring
+  void popFrame(uint64_t& position) {
+    std::memmove(history.data(), history.data() + channels,
+                 (HISTORY_FRAMES - 1) * channels * sizeof(float));
+    std::memcpy(history.data() + (HISTORY_FRAMES - 1) * channels,
+                &ring[(position % capacity) * channels], channels * sizeof(float));
+    ++position;
+  }
+};
+
+AggregateAudioDriver::AggregateAudioDriver(std::vector<std::unique_ptr<IAudioDriver>> devices,
+                                           const AggregateDriverOptions& options)
+    : m_devices(std::move(devices)), m_options(options) {
+  for (size_t i = 0; i < m_devices.size(); ++i) {
+    m_device_callbacks.push_back(std::make_unique<DeviceCallback>(*this, i));
+  }
+}
+
+AggregateAudioDriver::~AggregateAudioDriver() {
+  stop();
+}
+
+SessionGraphError AggregateAudioDriver::initialize(const AudioDriverConfig& config) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_running.load(std::memory_order_acquire)) {
+    return SessionGraphError::InternalError; // Cannot initialize while running
+  }
+
+  // Validate configuration
+  const size_t per_device = m_options.outputsPerDevice;
+  if (m_devices.empty() || per_device == 0 || config.sample_rate == 0 ||
+      config.buffer_size == 0 || !(m_options.loopBandwidthHz > 0.0)) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (std::any_of(m_devices.begin(), m_devices.end(), [](const auto& d) { return !d; })) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (config.num_outputs != per_device * m_devices.size()) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  // Inputs come from the master only
+  for (size_t i = 0; i < m_devices.size(); ++i) {
+    AudioDriverConfig device_config = config;
+    device_config.num_inputs = i == 0 ? config.num_inputs : 0;
+    device_config.num_outputs = m_options.outputsPerDevice;
+    device_config.device_name = i == 0 ? config.device_name : std::string{};
+    if (i < m_options.deviceNames.size() && !m_options.deviceNames[i].empty()) {
+      device_config.device_name = m_options.deviceNames[i];
+    }
+    auto result = m_devices[i]->initialize(device_config);
+    if (result != SessionGraphError::OK) {
+      return result;
+    }
+  }
+
+  m_config = config;
+
+  // Pre-allocate buffers
+  m_scratch_storage.assign(config.num_outputs, std::vector<float>(config.buffer_size, 0.0f));
+  m_scratch_ptrs.clear();
+  for (auto& buffer : m_scratch_storage) {
+    m_scratch_ptrs.push_back(buffer.data());
+  }
+
+  const uint32_t target =
+      m_options.targetFillFrames > 0 ? m_options.targetFillFrames : 3u * config.buffer_size;
+  m_feeds.clear();
+  for (size_t i = 1; i < m_devices.size(); ++i) {
+    auto feed = std::make_unique<Feed>();
+    feed->channels = per_device;
+    feed->target = target;
+    feed->capacity = std::max<uint64_t>(8ull * config.buffer_size, 2ull * target);
+    feed->ring.assign(feed->capacity * per_device, 0.0f);
+    feed->history.assign(HISTORY_FRAMES * per_device, 0.0f);
+    m_feeds.push_back(std::move(feed));
+  }
+
+  return SessionGraphError::OK;
+}
+
+SessionGraphError AggregateAudioDriver::start(IAudioCallback* callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!callback) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  if (m_running.load(std::memory_order_acquire)) {
+    return SessionGraphError::InternalError; // Already running
+  }
+
+  if (m_scratch_ptrs.empty()) {
+    return SessionGraphError::NotReady; // Must call initialize first
+  }
+
+  m_callback = callback;
+  for (auto& feed : m_feeds) {
+    feed->reset();
+  }
+  m_running.store(true, std::memory_order_release);
+
+  // Sub-devices first (silent until primed), then the master that feeds them
+  for (size_t n = 0; n < m_devices.size(); ++n) {
+    const size_t i = (n + 1) % m_devices.size();
+    auto result = m_devices[i]->start(m_device_callbacks[i].get());
+    if (result != SessionGraphError::OK) {
+      for (auto& device : m_devices) {
+        device->stop();
+      }
+      m_running.store(false, std::memory_order_release);
+      m_callback = nullptr;
+      return result;
+    }
+  }
+
+  return SessionGraphError::OK;
+}
+
+SessionGraphError AggregateAudioDriver::stop() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_running.load(std::memory_order_acquire)) {
+    return SessionGraphError::OK; // Already stopped
+  }
+
+  // Master first, so nothing is written to rings whose readers have stopped
+  for (auto& device : m_devices) {
+    device->stop();
+  }
+
+  m_running.store(false, std::memory_order_release);
+  m_callback = nullptr;
+
+  return SessionGraphError::OK;
+}
+
+bool AggregateAudioDriver::isRunning() const {
+  return m_running.load(std::memory_order_acquire);
+}
+
+const AudioDriverConfig& AggregateAudioDriver::getConfig() const {
+  return m_config;
+}
+
+std::string AggregateAudioDriver::getDriverName() const {
+  return "Aggregate";
+}
+
+uint32_t AggregateAudioDriver::getLatencySamples() const {
+  // The slowest path: a sub-device plays the held ring fill on top of its own latency
+  uint32_t latency = m_devices.empty() ? 0 : m_devices[0]->getLatencySamples();
+  for (size_t i = 1; i < m_devices.size(); ++i) {
+    const uint32_t fill = m_feeds.size() >= i ? m_feeds[i - 1]->target : 0;
+    latency = std::max(latency, m_devices[i]->getLatencySamples() + fill);
+  }
+  return latency;
+}
+
+IAudioClock* AggregateAudioDriver::getClock() {
+  return m_devices.empty() ? nullptr : m_devices[0]->getClock();
+}
+
+std::vector<AggregateDeviceStats> AggregateAudioDriver::getStats() const {
+  std::vector<AggregateDeviceStats> stats;
+  stats.reserve(m_feeds.size());
+  for (const auto& feed : m_feeds) {
+    AggregateDeviceStats device;
+    device.driftPpm = feed->drift_ppm.load(std::memory_order_relaxed);
+    device.ratio = feed->ratio.load(std::memory_order_relaxed);
+    device.fillFrames = feed->fill.load(std::memory_order_relaxed);
+    device.targetFillFrames = feed->target;
+    device.underruns = feed->underruns.load(std::memory_order_relaxed);
+    device.overruns = feed->overruns.load(std::memory_order_relaxed);
+    device.locked = feed->locked.load(std::memory_order_relaxed);
+
+    const uint64_t frames = feed->resampled_frames.load(std::memory_order_relaxed);
+    if (frames > 0) {
+      const double audio_ns =
+          static_cast<double>(frames) * 1e9 / static_cast<double>(m_config.sample_rate);
+      device.resamplerCpuPercent =
+          static_cast<double>(feed->resampler_cpu_ns.load(std::memory_order_relaxed)) /
+          audio_ns * 100.0;
+    }
+    stats.push_back(device);
+  }
+  return stats;
+}
+
+IAudioDriver* AggregateAudioDriver::getDevice(size_t index) const {
+  return index < m_devices.size() ? m_devices[index].get() : nullptr;
+}
+
+void AggregateAudioDriver::DeviceCallback::processAudio(const float** input_buffers,
+                                                        float** output_buffers,
+                                                        size_t num_channels, size_t num_frames) {
+  if (m_index == 0) {
+    m_owner.processMaster(input_buffers, output_buffers, num_channels, num_frames);
+  } else {
+    m_owner.processFeed(*m_owner.m_feeds[m_index - 1], output_buffers, num_channels, num_frames);
+  }
+}
+
+uint32_t AggregateAudioDriver::DeviceCallback::getProcessingLatencySamples() const {
+  IAudioCallback* callback = m_owner.m_callback;
+  return callback ? callback->getProcessingLatencySamples() : 0;
+}
+
+void AggregateAudioDriver::DeviceCallback::onUnderrun(UnderrunCause cause) {
+  // A dropout on any sub-device is a dropout of the aggregate
+  IAudioCallback* callback = m_owner.m_callback;
+  if (callback && m_owner.m_running.load(std::memory_order_acquire)) {
+    callback->onUnderrun(cause);
+  }
+}
+
+void AggregateAudioDriver::processMaster(const float** input_buffers, float** output_buffers,
+                                         size_t num_channels, size_t num_frames) {
+  const int64_t now_ns = nowNs();
+  const size_t frames = std::min<size_t>(num_frames, m_config.buffer_size);
+
+  for (auto& buffer : m_scratch_storage) {
+    std::memset(buffer.data(), 0, frames * sizeof(float));
+  }
+  if (m_callback && m_running.load(std::memory_order_acquire)) {
+    m_callback->processAudio(input_buffers, m_scratch_ptrs.data(), m_scratch_ptrs.size(),
+                             frames);
+  }
+
+  // The master's channels play directly
+  const size_t per_device = m_options.outputsPerDevice;
+  for (size_t ch = 0; ch < std::min(num_channels, per_device); ++ch) {
+    std::memcpy(output_buffers[ch], m_scratch_ptrs[ch], frames * sizeof(float));
+  }
+
+  // The others go to their sub-device's ring
+  for (size_t i = 0; i < m_feeds.size(); ++i) {
+    m_feeds[i]->push(&m_scratch_ptrs[(i + 1) * per_device], frames, now_ns);
+  }
+}
+
+void AggregateAudioDriver::processFeed(Feed& feed, float** output_buffers, size_t num_channels,
+                                       size_t num_frames) {
+  const int64_t now_ns = nowNs();
+  const int64_t cpu_start_ns = threadCpuTimeNs();
+  const double rate = m_config.sample_rate;
+  const size_t channels = std::min(num_channels, feed.channels);
+  uint64_t position = feed.read.load(std::memory_order_relaxed);
+
+  feed.snapshot();
+  const uint64_t available = feed.last_written - position;
+
+  // Fill extrapolated to now: the master writes whole blocks, but its audio
+  // arrives continuously on its clock (capped at a block if it has stalled)
+  const double since_write = std::clamp(
+      static_cast<double>(now_ns - feed.last_written_at_ns) * rate / 1e9, 0.0,
+      static_cast<double>(m_config.buffer_size));
+
+  // Wait for the target fill before playing (again, after running dry), then
+  // skip whatever arrived beyond it so the loop starts without an error to wind up on
+  if (!feed.primed) {
+    if (available < feed.target + HISTORY_FRAMES) {
+      return; // The driver cleared the outputs
+    }
+    const double excess = static_cast<double>(available) + since_write - feed.target;
+    position += std::min(static_cast<uint64_t>(excess), available - feed.target - HISTORY_FRAMES);
+    for (size_t i = 1; i < HISTORY_FRAMES; ++i) {
+      feed.popFrame(position);
+    }
+    std::memcpy(feed.history.data(), feed.history.data() + feed.channels,
+                feed.channels * sizeof(float));
+    feed.phase = 0.0;
+    feed.error = 0.0;
+    feed.primed = true;
+    feed.locked.store(true, std::memory_order_relaxed);
+  }
+
+  const double fill = static_cast<double>(feed.last_written - position) + since_write - feed.phase;
+
+  // PI loop, critically damped at the configured bandwidth:
+  // d(fill)/dt = master rate - sub-device rate * ratio
+  const double omega = 2.0 * std::numbers::pi * m_options.loopBandwidthHz;
+  const double dt = static_cast<double>(num_frames) / rate;
+  const double smoothing = 1.0 - std::exp(-dt * 4.0 * omega); // Pre-filter 4x the loop's speed
+  const double max_step = MAX_INNOVATION_SECONDS * rate;
+  feed.error += smoothing * std::clamp((fill - feed.target) - feed.error, -max_step, max_step);
+  feed.integral = std::clamp(feed.integral + omega * omega / rate * feed.error * dt,
+                             -MAX_CORRECTION, MAX_CORRECTION);
+  const double correction =
+      std::clamp(2.0 * omega / rate * feed.error + feed.integral, -MAX_CORRECTION, MAX_CORRECTION);
+  const double ratio = 1.0 + correction;
+
+  feed.fill.store(fill, std::memory_order_relaxed);
+  feed.ratio.store(ratio, std::memory_order_relaxed);
+  feed.drift_ppm.store((1.0 / (1.0 + feed.integral) - 1.0) * 1e6, std::memory_order_relaxed);
+
+  // Ran dry: play silence and prime again, keeping the drift estimate
+  const double needed = feed.phase + ratio * static_cast<double>(num_frames);
+  if (static_cast<double>(feed.last_written - position) < std::ceil(needed)) {
+    feed.primed = false;
+    feed.locked.store(false, std::memory_order_relaxed);
+    feed.underruns.fetch_add(1, std::memory_order_relaxed);
+    feed.read.store(position, std::memory_order_release);
+    return;
+  }
+
+  const float* history = feed.history.data();
+  const size_t stride = feed.channels;
+  for (size_t i = 0; i < num_frames; ++i) {
+    const auto t = static_cast<float>(feed.phase);
+    for (size_t ch = 0; ch < channels; ++ch) {
+      output_buffers[ch][i] = hermite(history[ch], history[stride + ch],
+                                      history[2 * stride + ch], history[3 * stride + ch], t);
+    }
+    feed.phase += ratio;
+    while (feed.phase >= 1.0) {
+      feed.phase -= 1.0;
+      feed.popFrame(position);
+    }
+  }
+  feed.read.store(position, std::memory_order_release);
+
+  feed.resampler_cpu_ns.fetch_add(threadCpuTimeNs() - cpu_start_ns, std::memory_order_relaxed);
+  feed.resampled_frames.fetch_add(num_frames, std::memory_order_relaxed);
+}
+
+int64_t AggregateAudioDriver::nowNs() const {
+  return m_options.clockNs ? m_options.clockNs() : steadyNowNs();
+}
+
+// Factory function
+std::unique_ptr<IAudioDriver>
+createAggregateAudioDriver(std::vector<std::unique_ptr<IAudioDriver>> devices,
+                           const AggregateDriverOptions& options) {
+  return std::make_unique<AggregateAudioDriver>(std::move(devices), options);
+}
+
+} // namespace orpheus
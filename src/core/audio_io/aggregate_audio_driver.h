@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/audio_driver.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace orpheus {
+
+/// Clock tracking of one sub-device fed through a resampler
+struct AggregateDeviceStats {
+  double driftPpm = 0.0;            ///< Sub-device clock against the master (> 0: runs fast)
+  double ratio = 1.0;               ///< Master frames consumed per sub-device frame
+  double fillFrames = 0.0;          ///< Ring fill at the last callback (time-interpolated)
+  uint32_t targetFillFrames = 0;    ///< Fill the PI loop holds
+  double resamplerCpuPercent = 0.0; ///< Resampler CPU time as % of the audio it produced
+  uint64_t underruns = 0;           ///< Callbacks the ring could not feed (silence, re-primed)
+  uint64_t overruns = 0;            ///< Master blocks dropped on a full ring
+  bool locked = false;              ///< Primed and playing from the ring
+};
+
+/// Several audio devices presented as one output device
+///
+/// The master device's callback renders every channel into scratch buffers,
+/// plays its own and pushes the rest into one single-producer/single-consumer
+/// ring per sub-device. Each sub-device's callback reads its ring through a
+/// 4-point Hermite resampler whose ratio is steered by a PI loop on the fill
+/// level, so the loop's integrator converges on the clock ratio between the
+/// two crystals (reported as drift in ppm).
+///
+/// The fill level is sampled at the sub-device's callback, and the master's
+/// writes come in whole blocks, so the raw level is a sawtooth whose phase
+/// slips at the drift rate. The master therefore timestamps each write, and
+/// the fill is extrapolated to the moment of the read at the nominal rate;
+/// what remains is wake-up jitter, smoothed before the loop sees it.
+///
+/// A sub-device starts playing once its ring reaches the target fill; if the
+/// ring runs dry it outputs silence and primes again, keeping its drift
+/// estimate. The clock is the master's.
+class AggregateAudioDriver : public IAudioDriver {
+public:
+  AggregateAudioDriver(std::vector<std::unique_ptr<IAudioDriver>> devices,
+                       const AggregateDriverOptions& options = {});
+  ~AggregateAudioDriver() override;
+
+  // IAudioDriver interface
+  SessionGraphError initialize(const AudioDriverConfig& config) override;
+  SessionGraphError start(IAudioCallback* callback) override;
+  SessionGraphError stop() override;
+  bool isRunning() const override;
+  const AudioDriverConfig& getConfig() const override;
+  std::string getDriverName() const override;
+  uint32_t getLatencySamples() const override;
+  IAudioClock* getClock() override;
+
+  /// Clock tracking for each sub-device after the master (any thread)
+  std::vector<AggregateDeviceStats> getStats() const;
+
+  /// Sub-device by index (0 = master)
+  IAudioDriver* getDevice(size_t index) const;
+
+private:
+  /// Ring, resampler and PI loop feeding one sub-device
+  struct Feed;
+
+  /// Callback registered with one sub-device
+  class DeviceCallback : public IAudioCallback {
+  public:
+    DeviceCallback(AggregateAudioDriver& owner, size_t index) : m_owner(owner), m_index(index) {}
+
+    void processAudio(const float** input_buffers, float** output_buffers, size_t num_channels,
+                      size_t num_frames) override;
+    uint32_t getProcessingLatencySamples() const override;
+    void onUnderrun(UnderrunCause cause) override;
+
+  private:
+    AggregateAudioDriver& m_owner;
+    size_t m_index;
+  };
+
+  /// Master callback: render all channels, play the master's, feed the rings
+  void processMaster(const float** input_buffers, float** output_buffers, size_t num_channels,
+                     size_t num_frames);
+
+  /// Sub-device callback: steer the ratio and resample from the ring
+  void processFeed(Feed& feed, float** output_buffers, size_t num_channels, size_t num_frames);
+
+  /// Current time from AggregateDriverOptions::clockNs or the steady clock
+  int64_t nowNs() const;
+
+  std::vector<std::unique_ptr<IAudioDriver>> m_devices;
+  std::vector<std::unique_ptr<DeviceCallback>> m_device_callbacks;
+  std::vector<std::unique_ptr<Feed>> m_feeds; // One per device after the master
+  AggregateDriverOptions m_options;
+
+  AudioDriverConfig m_config;
+  IAudioCallback* m_callback{nullptr};
+  std::atomic<bool> m_running{false};
+
+  // Aggregate render buffers (master thread only)
+  std::vector<std::vector<float>> m_scratch_storage;
+  std::vector<float*> m_scratch_ptrs;
+
+  mutable std::mutex m_mutex;
+};
+
+} // namespace orpheus
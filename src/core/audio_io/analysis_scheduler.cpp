@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: MIT
+#include "analysis_scheduler.h"
+
+#include <algorithm>
+
+namespace orpheus {
+
+AnalysisScheduler::AnalysisScheduler(size_t num_workers, size_t max_disk_jobs)
+    : m_max_disk_jobs(std::max<size_t>(max_disk_jobs, 1)) {
+  if (num_workers == 0) {
+    size_t hardware = std::thread::hardware_concurrency();
+    num_workers = std::clamp<size_t>(hardware, 1, DEFAULT_MAX_WORKERS);
+  }
+
+  m_workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    m_workers.emplace_back(&AnalysisScheduler::workerMain, this);
+  }
+}
+
+AnalysisScheduler::~AnalysisScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+    for (auto& [key, entry] : m_queue) {
+      m_jobs.erase(entry->id);
+      ++m_cancelled;
+    }
+    m_queue.clear();
+    for (auto& [id, entry] : m_jobs) {
+      entry->cancelled.store(true, std::memory_order_release); // Running
+    }
+  }
+  m_work_cv.notify_all();
+  m_done_cv.notify_all();
+
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+AnalysisScheduler::JobId AnalysisScheduler::submit(Job job, AnalysisPriority priority,
+                                                   bool disk_bound) {
+  auto entry = std::make_shared<Entry>();
+  entry->job = std::move(job);
+  entry->priority = priority;
+  entry->disk_bound = disk_bound;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entry->id = m_next_id++;
+    entry->sequence = m_next_sequence++;
+    m_queue.emplace(QueueKey{static_cast<uint8_t>(priority), entry->sequence}, entry);
+    m_jobs.emplace(entry->id, entry);
+    m_peak_queue_depth = std::max(m_peak_queue_depth, m_queue.size());
+  }
+  m_work_cv.notify_one();
+  return entry->id;
+}
+
+bool AnalysisScheduler::setPriority(JobId id, AnalysisPriority priority) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto job = m_jobs.find(id);
+  if (job == m_jobs.end()) {
+    return false;
+  }
+  auto& entry = job->second;
+  auto queued = m_queue.find(QueueKey{static_cast<uint8_t>(entry->priority), entry->sequence});
+  if (queued == m_queue.end()) {
+    return false; // Already running
+  }
+  m_queue.erase(queued);
+  entry->priority = priority;
+  m_queue.emplace(QueueKey{static_cast<uint8_t>(priority), entry->sequence}, entry);
+  return true;
+}
+
+bool AnalysisScheduler::cancel(JobId id) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto job = m_jobs.find(id);
+    if (job == m_jobs.end()) {
+      return false;
+    }
+    auto entry = job->second;
+    entry->cancelled.store(true, std::memory_order_release);
+    if (m_queue.erase(QueueKey{static_cast<uint8_t>(entry->priority), entry->sequence}) == 0) {
+      return true; // Running: it returns at its next check
+    }
+    m_jobs.erase(job);
+    ++m_cancelled;
+  }
+  m_done_cv.notify_all();
+  return true;
+}
+
+bool AnalysisScheduler::isPending(JobId id) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_jobs.find(id) != m_jobs.end();
+}
+
+void AnalysisScheduler::wait(JobId id) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cv.wait(lock, [&] { return m_jobs.find(id) == m_jobs.end(); });
+}
+
+void AnalysisScheduler::waitIdle() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cv.wait(lock, [&] { return m_jobs.empty(); });
+}
+
+AnalysisStats AnalysisScheduler::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  AnalysisStats stats;
+  stats.queued = m_queue.size();
+  stats.peakQueued = m_peak_queue_depth;
+  stats.running = m_running;
+  stats.runningDiskBound = m_running_disk;
+  stats.completed = m_completed;
+  stats.cancelled = m_cancelled;
+
+  double uptime =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - m_created).count();
+  if (uptime > 0.0) {
+    stats.jobsPerSecond = static_cast<double>(m_completed) / uptime;
+  }
+  if (m_completed > 0) {
+    stats.averageJobMs = std::chrono::duration<double, std::milli>(m_busy_time).count() /
+                         static_cast<double>(m_completed);
+  }
+  return stats;
+}
+
+std::map<AnalysisScheduler::QueueKey, std::shared_ptr<AnalysisScheduler::Entry>>::iterator
+AnalysisScheduler::nextRunnable() {
+  bool disk_available = m_running_disk < m_max_disk_jobs;
+  return std::find_if(m_queue.begin(), m_queue.end(), [disk_available](const auto& queued) {
+    return disk_available || !queued.second->disk_bound;
+  });
+}
+
+void AnalysisScheduler::workerMain() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_work_cv.wait(lock, [this] { return m_stop || nextRunnable() != m_queue.end(); });
+    if (m_stop) {
+      return;
+    }
+
+    auto next = nextRunnable();
+    auto entry = next->second;
+    m_queue.erase(next);
+    ++m_running;
+    if (entry->disk_bound) {
+      ++m_running_disk;
+    }
+
+    lock.unlock();
+    auto started = std::chrono::steady_clock::now();
+    try {
+      entry->job(entry->cancelled);
+    } catch (...) {
+      // A failing analysis must not take the worker down; the job's owner sees no result
+    }
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    lock.lock();
+
+    --m_running;
+    if (entry->disk_bound) {
+      --m_running_disk;
+      m_work_cv.notify_one(); // A waiting disk-bound job may start now
+    }
+    if (entry->cancelled.load(std::memory_order_acquire)) {
+      ++m_cancelled;
+    } else {
+      ++m_completed;
+      m_busy_time += elapsed;
+    }
+    entry->job = nullptr; // Release captures before waking waiters
+    m_jobs.erase(entry->id);
+    m_done_cv.notify_all();
+  }
+}
+
+AnalysisScheduler& sharedAnalysisScheduler() {
+  static AnalysisScheduler scheduler;
+  return scheduler;
+}
+
+AnalysisStats getAnalysisStats() {
+  return sharedAnalysisScheduler().stats();
+}
+
+} // namespace orpheus
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/audio_file_reader_extended.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace orpheus {
+
+/// Bounded background pool for file analysis (waveform pyramids, peaks, loudness)
+///
+/// Jobs run on a fixed set of workers in priority order (Visible first, FIFO
+/// within a priority). Disk-bound jobs are additionally limited to
+/// maxDiskJobs() at a time, so importing hundreds of files reads a few of
+/// them at once instead of seeking between all of them; CPU-only jobs may
+/// use the remaining workers meanwhile.
+///
+/// Cancelling a queued job removes it without running it. A running job is
+/// told through the flag passed to it and should return at its next check.
+///
+/// Thread Safety: all methods may be called from any non-audio thread. Jobs
+/// must not wait() on themselves.
+class AnalysisScheduler {
+public:
+  using JobId = uint64_t;
+  using Job = std::function<void(const std::atomic<bool>& cancelled)>;
+
+  static constexpr JobId INVALID_JOB = 0;
+  static constexpr size_t DEFAULT_MAX_WORKERS = 4;
+  static constexpr size_t DEFAULT_MAX_DISK_JOBS = 2;
+
+  /// @param num_workers Worker threads (0 = hardware concurrency, at most DEFAULT_MAX_WORKERS)
+  /// @param max_disk_jobs Disk-bound jobs allowed to run at once (at least 1)
+  explicit AnalysisScheduler(size_t num_workers = 0,
+                             size_t max_disk_jobs = DEFAULT_MAX_DISK_JOBS);
+
+  /// Cancels queued jobs, signals running ones and joins the workers
+  ~AnalysisScheduler();
+
+  AnalysisScheduler(const AnalysisScheduler&) = delete;
+  AnalysisScheduler& operator=(const AnalysisScheduler&) = delete;
+
+  /// Queue a job
+  /// @param disk_bound Whether the job reads files (subject to maxDiskJobs())
+  /// @return Job id (never INVALID_JOB)
+  JobId submit(Job job, AnalysisPriority priority = AnalysisPriority::Normal,
+               bool disk_bound = true);
+
+  /// Move a queued job to another priority (e.g. its clip scrolled into view)
+  /// @return false if the job is not queued (unknown, running or finished)
+  bool setPriority(JobId id, AnalysisPriority priority);
+
+  /// Cancel a job: a queued job is dropped, a running job sees its flag set
+  /// @return false if the job is unknown or already finished
+  bool cancel(JobId id);
+
+  /// Whether a job is queued or running
+  bool isPending(JobId id) const;
+
+  /// Block until a job has finished or been dropped (returns at once for unknown ids)
+  void wait(JobId id);
+
+  /// Block until no job is queued or running
+  void waitIdle();
+
+  AnalysisStats stats() const;
+
+  size_t workerCount() const {
+    return m_workers.size();
+  }
+  size_t maxDiskJobs() const {
+    return m_max_disk_jobs;
+  }
+
+private:
+  struct Entry {
+    JobId id;
+    Job job;
+    AnalysisPriority priority;
+    bool disk_bound;
+    uint64_t sequence;
+    std::atomic<bool> cancelled{false};
+  };
+
+  /// Queue order: priority, then submission order
+  using QueueKey = std::pair<uint8_t, uint64_t>;
+
+  void workerMain();
+  /// First queued job allowed to start now (caller holds m_mutex)
+  std::map<QueueKey, std::shared_ptr<Entry>>::iterator nextRunnable();
+
+  const size_t m_max_disk_jobs;
+  const std::chrono::steady_clock::time_point m_created = std::chrono::steady_clock::now();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_work_cv; ///< Job queued, disk slot freed, or stopping
+  std::condition_variable m_done_cv; ///< A job finished or was dropped
+  std::map<QueueKey, std::shared_ptr<Entry>> m_queue;
+  std::unordered_map<JobId, std::shared_ptr<Entry>> m_jobs; ///< Queued and running
+  JobId m_next_id = 1;
+  uint64_t m_next_sequence = 0;
+  bool m_stop = false;
+
+  // Statistics (under m_mutex)
+  size_t m_running = 0;
+  size_t m_running_disk = 0;
+  size_t m_peak_queue_depth = 0;
+  uint64_t m_completed = 0;
+  uint64_t m_cancelled = 0;
+  std::chrono::steady_clock::duration m_busy_time{};
+
+  std::vector<std::thread> m_workers;
+};
+
+/// Process-wide scheduler used by the extended audio file readers
+AnalysisScheduler& sharedAnalysisScheduler();
+
+} // namespace orpheus
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: MIT
 #include "audio_file_reader_libsndfile.h"
 
+#include "file_fingerprint.h"
+
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -23,6 +26,8 @@ Result<AudioFileMetadata> AudioFileReaderLibsndfile::open(const std::string& fil
     sf_close(m_file);
     m_file = nullptr;
   }
+  m_native.reset();
+  m_raw.close();
 
   // Open file
   std::memset(&m_info, 0, sizeof(m_info));
@@ -54,7 +59,7 @@ Result<AudioFileMetadata> AudioFileReaderLibsndfile::open(const std::string& fil
   m_metadata.num_channels = static_cast<uint16_t>(m_info.channels);
   m_metadata.duration_samples = m_info.frames;
   m_metadata.codec = codecFromSndfile(m_info.format);
-  m_metadata.file_hash_sha256 = calculateFileHash(file_path);
+  m_metadata.file_hash_sha256 = cachedFileHash(file_path);
 
   // Determine bit depth (approximate from format)
   int subformat = m_info.format & SF_FORMAT_SUBMASK;
@@ -68,6 +73,18 @@ Result<AudioFileMetadata> AudioFileReaderLibsndfile::open(const std::string& fil
     m_metadata.bit_depth = 16; // Default
   }
 
+  // Use the native PCM path when our header parse agrees with libsndfile
+  auto layout = probePcmFileLayout(file_path);
+  if (layout && layout->num_channels == m_info.channels && layout->num_frames == m_info.frames) {
+    m_raw.open(file_path, std::ios::binary);
+    if (m_raw.seekg(static_cast<std::streamoff>(layout->data_offset))) {
+      m_native = layout;
+      m_raw_buffer.resize(NATIVE_CHUNK_FRAMES * layout->bytesPerFrame());
+    } else {
+      m_raw.close();
+    }
+  }
+
   m_file_path = file_path;
   m_current_position.store(0, std::memory_order_release);
   m_is_open.store(true, std::memory_order_release);
@@ -93,6 +110,17 @@ Result<size_t> AudioFileReaderLibsndfile::readSamples(float* buffer, size_t num_
     return result;
   }
 
+  // Native PCM: raw read + SIMD conversion, no per-sample libsndfile path
+  if (m_native) {
+    size_t frames = readNative(buffer, num_samples);
+    m_current_position.store(m_current_position.load(std::memory_order_relaxed) +
+                                 static_cast<int64_t>(frames),
+                             std::memory_order_release);
+    result.error = SessionGraphError::OK;
+    result.value = frames;
+    return result;
+  }
+
   // Read interleaved samples (libsndfile maintains internal state)
   sf_count_t read = sf_readf_float(m_file, buffer, static_cast<sf_count_t>(num_samples));
 
@@ -127,6 +155,18 @@ SessionGraphError AudioFileReaderLibsndfile::seek(int64_t sample_position) {
     sample_position = m_info.frames;
   }
 
+  if (m_native) {
+    m_raw.clear(); // Clear EOF from a previous read
+    m_raw.seekg(static_cast<std::streamoff>(m_native->data_offset +
+                                            static_cast<uint64_t>(sample_position) *
+                                                m_native->bytesPerFrame()));
+    if (!m_raw) {
+      return SessionGraphError::InternalError;
+    }
+    m_current_position.store(sample_position, std::memory_order_release);
+    return SessionGraphError::OK;
+  }
+
   // Seek
   sf_count_t result = sf_seek(m_file, sample_position, SEEK_SET);
   if (result < 0) {
@@ -144,6 +184,8 @@ void AudioFileReaderLibsndfile::close() {
     sf_close(m_file);
     m_file = nullptr;
   }
+  m_native.reset();
+  m_raw.close();
 
   m_is_open.store(false, std::memory_order_release);
   m_current_position.store(0, std::memory_order_release);
@@ -157,6 +199,29 @@ bool AudioFileReaderLibsndfile::isOpen() const {
   return m_is_open.load(std::memory_order_acquire);
 }
 
+size_t AudioFileReaderLibsndfile::readNative(float* buffer, size_t num_frames) {
+  const size_t frame_bytes = m_native->bytesPerFrame();
+  const size_t channels = m_native->num_channels;
+
+  int64_t remaining = m_native->num_frames - m_current_position.load(std::memory_order_relaxed);
+  size_t total = std::min(num_frames, static_cast<size_t>(std::max<int64_t>(remaining, 0)));
+
+  // Chunked so the raw buffer never grows (no allocation while reading)
+  size_t done = 0;
+  while (done < total) {
+    size_t frames = std::min(total - done, NATIVE_CHUNK_FRAMES);
+    m_raw.read(reinterpret_cast<char*>(m_raw_buffer.data()),
+               static_cast<std::streamsize>(frames * frame_bytes));
+    size_t got = static_cast<size_t>(m_raw.gcount()) / frame_bytes;
+    decodePcm(m_native->format, m_raw_buffer.data(), buffer + done * channels, got * channels);
+    done += got;
+    if (got < frames) {
+      break; // Truncated file
+    }
+  }
+  return done;
+}
+
 AudioFileFormat AudioFileReaderLibsndfile::formatFromSndfile(int format) const {
   int major = format & SF_FORMAT_TYPEMASK;
 
@@ -191,11 +256,10 @@ std::string AudioFileReaderLibsndfile::codecFromSndfile(int format) const {
   }
 }
 
-std::string AudioFileReaderLibsndfile::calculateFileHash(const std::string& file_path) const {
-  // TODO: Implement SHA-256 hashing
-  // For now, return placeholder
-  (void)file_path;
-  return "SHA256_NOT_IMPLEMENTED";
+std::string AudioFileReaderLibsndfile::cachedFileHash(const std::string& file_path) const {
+  // Only an already-indexed digest: open() never hashes the whole file (fingerprint on demand)
+  auto fingerprint = sharedFingerprintIndex().lookup(file_path);
+  return fingerprint ? fingerprint->sha256 : std::string();
 }
 
 // Factory function
@@ -1,18 +1,25 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "pcm_decode.h"
 #include <orpheus/audio_file_reader.h>
 
 #include <atomic>
+#include <fstream>
 #include <mutex>
+#include <optional>
 #include <sndfile.h>
 #include <string>
+#include <vector>
 
 namespace orpheus {
 
 /// Audio file reader implementation using libsndfile
 ///
 /// Supports WAV, AIFF, FLAC, and other formats via libsndfile.
+/// Uncompressed 16/24/32-bit integer and 32-bit float WAV/AIFF data is read
+/// directly and converted with the SIMD kernels from pcm_decode.h; other
+/// encodings fall back to sf_readf_float().
 class AudioFileReaderLibsndfile : public IAudioFileReader {
 public:
   AudioFileReaderLibsndfile();
@@ -33,8 +40,11 @@ private:
   /// Convert libsndfile format to codec string
   std::string codecFromSndfile(int format) const;
 
-  /// Calculate SHA-256 hash of file (stub for now)
-  std::string calculateFileHash(const std::string& file_path) const;
+  /// SHA-256 of file if the shared fingerprint index already has it (empty otherwise)
+  std::string cachedFileHash(const std::string& file_path) const;
+
+  /// Read and convert frames on the native PCM path
+  size_t readNative(float* buffer, size_t num_frames);
 
   // File state
   SNDFILE* m_file;
@@ -42,6 +52,12 @@ private:
   AudioFileMetadata m_metadata;
   std::string m_file_path;
 
+  // Native PCM path (set when the data chunk is natively decodable)
+  static constexpr size_t NATIVE_CHUNK_FRAMES = 4096;
+  std::optional<PcmFileLayout> m_native;
+  std::ifstream m_raw;
+  std::vector<uint8_t> m_raw_buffer; // Raw bytes for one chunk (allocated in open())
+
   // Thread safety
   mutable std::mutex m_mutex;
   std::atomic<int64_t> m_current_position{0};
@@ -0,0 +1,541 @@
+// SPDX-License-Identifier: MIT
+#include "block_reader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) &&                              \
+    defined(__NR_io_uring_register)
+#define ORPHEUS_HAS_IO_URING 1
+#endif
+#endif
+
+namespace orpheus {
+
+namespace {
+
+constexpr size_t roundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ============================================================================
+// BlockReader
+// ============================================================================
+
+BlockReader::BlockReader(const BlockReaderOptions& options)
+    : m_max_batch(std::max<size_t>(options.maxBatch, 1)),
+      m_max_read_bytes(std::max<size_t>(options.maxReadBytes, 1)), m_direct_io(options.directIo),
+      // A widened direct read can start up to one block early
+      m_slot_bytes(roundUp(m_max_read_bytes, DIRECT_IO_ALIGNMENT) + DIRECT_IO_ALIGNMENT),
+      m_extents(m_max_batch), m_results(m_max_batch) {
+  m_pool = static_cast<uint8_t*>(::operator new(m_slot_bytes * m_max_batch,
+                                                std::align_val_t{DIRECT_IO_ALIGNMENT}));
+}
+
+BlockReader::~BlockReader() {
+  for (uint32_t file = 0; file < m_files.size(); ++file) {
+    closeFile(file);
+  }
+  ::operator delete(m_pool, std::align_val_t{DIRECT_IO_ALIGNMENT});
+}
+
+std::optional<uint32_t> BlockReader::openFile(const std::string& path) {
+  OpenFile opened{};
+#if defined(_WIN32)
+  auto open = [&](DWORD flags) {
+    return CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ,
+                       FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, flags,
+                       nullptr);
+  };
+  opened.handle = INVALID_HANDLE_VALUE;
+  if (m_direct_io) {
+    opened.handle = open(FILE_FLAG_NO_BUFFERING);
+    opened.direct = opened.handle != INVALID_HANDLE_VALUE;
+  }
+  if (opened.handle == INVALID_HANDLE_VALUE) {
+    opened.handle = open(FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN);
+  }
+  if (opened.handle == INVALID_HANDLE_VALUE) {
+    return std::nullopt;
+  }
+#else
+  opened.handle = -1;
+  if (m_direct_io) {
+#if defined(O_DIRECT)
+    opened.handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    // Some filesystems accept O_DIRECT at open() and reject the reads: probe one block
+    if (opened.handle >= 0 && ::pread(opened.handle, slot(0), DIRECT_IO_ALIGNMENT, 0) < 0) {
+      ::close(opened.handle);
+      opened.handle = -1;
+    }
+#elif defined(F_NOCACHE)
+    opened.handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (opened.handle >= 0 && ::fcntl(opened.handle, F_NOCACHE, 1) != 0) {
+      ::close(opened.handle);
+      opened.handle = -1;
+    }
+#endif
+    opened.direct = opened.handle >= 0;
+  }
+  if (opened.handle < 0) {
+    opened.handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (opened.handle < 0) {
+      return std::nullopt;
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(opened.handle, 0, 0, POSIX_FADV_SEQUENTIAL); // Larger kernel read-ahead
+#endif
+  }
+#endif
+  opened.open = true;
+
+  auto closed = std::find_if(m_files.begin(), m_files.end(),
+                             [](const OpenFile& file) { return !file.open; });
+  if (closed != m_files.end()) {
+    *closed = opened;
+    return static_cast<uint32_t>(closed - m_files.begin());
+  }
+  m_files.push_back(opened);
+  return static_cast<uint32_t>(m_files.size() - 1);
+}
+
+bool BlockReader::isDirect(uint32_t file) const {
+  return file < m_files.size() && m_files[file].open && m_files[file].direct;
+}
+
+void BlockReader::closeFile(uint32_t file) {
+  if (file >= m_files.size() || !m_files[file].open) {
+    return;
+  }
+#if defined(_WIN32)
+  CloseHandle(m_files[file].handle);
+#else
+  ::close(m_files[file].handle);
+#endif
+  m_files[file].open = false;
+}
+
+bool BlockReader::readBatch(std::span<BlockRead> reads) {
+  if (reads.size() > m_max_batch) {
+    return false;
+  }
+  for (const auto& read : reads) {
+    if (read.file >= m_files.size() || !m_files[read.file].open || read.length == 0 ||
+        read.length > m_max_read_bytes) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < reads.size(); ++i) {
+    const auto& read = reads[i];
+    const auto& file = m_files[read.file];
+    auto& extent = m_extents[i];
+    extent.file = file.handle;
+    extent.direct = file.direct;
+    if (file.direct) {
+      extent.offset = read.offset / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+      extent.head = static_cast<size_t>(read.offset - extent.offset);
+      extent.length = roundUp(extent.head + read.length, DIRECT_IO_ALIGNMENT);
+    } else {
+      extent.offset = read.offset;
+      extent.head = 0;
+      extent.length = read.length;
+    }
+  }
+
+  readExtents(std::span<const Extent>(m_extents.data(), reads.size()),
+              std::span<int64_t>(m_results.data(), reads.size()));
+
+  for (size_t i = 0; i < reads.size(); ++i) {
+    auto& read = reads[i];
+    const int64_t result = m_results[i];
+    const auto head = static_cast<int64_t>(m_extents[i].head);
+    if (result < 0) {
+      read.data = nullptr;
+      read.result = result;
+    } else {
+      read.data = slot(i) + m_extents[i].head;
+      read.result = std::clamp<int64_t>(result - head, 0, static_cast<int64_t>(read.length));
+    }
+  }
+  return true;
+}
+
+int64_t BlockReader::readExtent(const Extent& extent, uint8_t* buffer) {
+  size_t done = 0;
+  while (done < extent.length) {
+#if defined(_WIN32)
+    OVERLAPPED overlapped{};
+    const uint64_t offset = extent.offset + done;
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD got = 0;
+    if (!ReadFile(extent.file, buffer + done, static_cast<DWORD>(extent.length - done), &got,
+                  &overlapped)) {
+      if (GetLastError() == ERROR_HANDLE_EOF) {
+        break;
+      }
+      return -EIO;
+    }
+#else
+    ssize_t got = ::pread(extent.file, buffer + done, extent.length - done,
+                          static_cast<off_t>(extent.offset + done));
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -errno;
+    }
+#endif
+    if (got == 0) {
+      break; // End of file
+    }
+    done += static_cast<size_t>(got);
+    if (extent.direct) {
+      break; // A short direct read ends at end of file
+    }
+  }
+#if defined(POSIX_FADV_WILLNEED)
+  // Streams read forwards: start fetching the next block while this one is decoded
+  if (!extent.direct && done == extent.length) {
+    ::posix_fadvise(extent.file, static_cast<off_t>(extent.offset + extent.length),
+                    static_cast<off_t>(extent.length), POSIX_FADV_WILLNEED);
+  }
+#endif
+  return static_cast<int64_t>(done);
+}
+
+namespace {
+
+// ============================================================================
+// Positional reads
+// ============================================================================
+
+/// One blocking positional read per request
+class PreadBlockReader final : public BlockReader {
+public:
+  explicit PreadBlockReader(const BlockReaderOptions& options) : BlockReader(options) {}
+
+  BlockReaderBackend backend() const override {
+    return BlockReaderBackend::Pread;
+  }
+
+protected:
+  void readExtents(std::span<const Extent> extents, std::span<int64_t> results) override {
+    for (size_t i = 0; i < extents.size(); ++i) {
+      results[i] = readExtent(extents[i], slot(i));
+    }
+  }
+};
+
+// ============================================================================
+// io_uring
+// ============================================================================
+
+#if defined(ORPHEUS_HAS_IO_URING)
+
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ring, unsigned opcode, const void* arg, unsigned count) {
+  return static_cast<int>(::syscall(__NR_io_uring_register, ring, opcode, arg, count));
+}
+
+/// Whole batch submitted (and reaped) with one io_uring_enter() call
+///
+/// The kernel interface is used directly (no liburing). Pool buffers are
+/// registered once and read with IORING_OP_READ_FIXED; if registration fails
+/// (e.g. RLIMIT_MEMLOCK), IORING_OP_READV is used instead. Both need Linux 5.1.
+class IoUringBlockReader final : public BlockReader {
+public:
+  explicit IoUringBlockReader(const BlockReaderOptions& options) : BlockReader(options) {
+    unsigned entries = 1;
+    while (entries < maxBatch()) {
+      entries <<= 1;
+    }
+    io_uring_params params{};
+    m_ring = ioUringSetup(entries, &params);
+    if (m_ring < 0) {
+      return;
+    }
+
+    m_sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_bytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      m_sq_bytes = m_cq_bytes = std::max(m_sq_bytes, m_cq_bytes);
+    }
+    m_sq_ring = map(m_sq_bytes, IORING_OFF_SQ_RING);
+    m_cq_ring = single_mmap ? m_sq_ring : map(m_cq_bytes, IORING_OFF_CQ_RING);
+    m_sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+    m_sqes = static_cast<io_uring_sqe*>(map(m_sqes_bytes, IORING_OFF_SQES));
+    if (!m_sq_ring || !m_cq_ring || !m_sqes) {
+      release();
+      return;
+    }
+
+    auto* sq = static_cast<uint8_t*>(m_sq_ring);
+    m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<uint8_t*>(m_cq_ring);
+    m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    m_iovecs.resize(maxBatch());
+    m_progress.resize(maxBatch());
+    for (size_t i = 0; i < maxBatch(); ++i) {
+      m_iovecs[i].iov_base = slot(i);
+      m_iovecs[i].iov_len = slotBytes();
+    }
+    m_fixed_buffers = ioUringRegister(m_ring, IORING_REGISTER_BUFFERS, m_iovecs.data(),
+                                      static_cast<unsigned>(m_iovecs.size())) == 0;
+  }
+
+  ~IoUringBlockReader() override {
+    release();
+  }
+
+  bool valid() const {
+    return m_ring >= 0;
+  }
+
+  BlockReaderBackend backend() const override {
+    return BlockReaderBackend::IoUring;
+  }
+
+protected:
+  void readExtents(std::span<const Extent> extents, std::span<int64_t> results) override {
+    if (m_failed) {
+      for (size_t i = 0; i < extents.size(); ++i) {
+        results[i] = readExtent(extents[i], slot(i));
+      }
+      return;
+    }
+
+    for (size_t i = 0; i < extents.size(); ++i) {
+      m_progress[i] = 0;
+      queueRead(extents[i], i);
+    }
+
+    size_t completed = 0;
+    while (completed < extents.size()) {
+      int submitted = ioUringEnter(m_ring, m_unsubmitted, m_in_flight + m_unsubmitted,
+                                   IORING_ENTER_GETEVENTS);
+      if (submitted < 0) {
+        if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+          continue;
+        }
+        // The ring is unusable: fail this batch and read later ones with pread(),
+        // once no submitted read can still land in the slot buffers
+        const int error = errno;
+        drain();
+        release();
+        for (size_t i = 0; i < extents.size(); ++i) {
+          results[i] = -error;
+        }
+        m_failed = true;
+        return;
+      }
+      const auto count = std::min(m_unsubmitted, static_cast<unsigned>(submitted));
+      m_unsubmitted -= count;
+      m_in_flight += count;
+      completed += reap(extents, results);
+    }
+  }
+
+private:
+  void* map(size_t bytes, uint64_t offset) const {
+    void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_ring, static_cast<off_t>(offset));
+    return mapped == MAP_FAILED ? nullptr : mapped;
+  }
+
+  /// Queue a read of the part of an extent not read yet
+  /// @param i Batch slot (and user_data) of the extent
+  void queueRead(const Extent& extent, size_t i) {
+    std::atomic_ref<unsigned> sq_tail(*m_sq_tail);
+    const unsigned tail = sq_tail.load(std::memory_order_relaxed);
+    const unsigned index = tail & m_sq_mask;
+    const size_t done = m_progress[i];
+    io_uring_sqe& sqe = m_sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.fd = extent.file;
+    sqe.off = extent.offset + done;
+    if (m_fixed_buffers) {
+      sqe.opcode = IORING_OP_READ_FIXED;
+      sqe.addr = reinterpret_cast<uint64_t>(slot(i) + done);
+      sqe.len = static_cast<uint32_t>(extent.length - done);
+      sqe.buf_index = static_cast<uint16_t>(i);
+    } else {
+      m_iovecs[i].iov_base = slot(i) + done;
+      m_iovecs[i].iov_len = extent.length - done;
+      sqe.opcode = IORING_OP_READV;
+      sqe.addr = reinterpret_cast<uint64_t>(&m_iovecs[i]);
+      sqe.len = 1;
+    }
+    sqe.user_data = i;
+    m_sq_array[index] = index;
+    sq_tail.store(tail + 1, std::memory_order_release);
+    ++m_unsubmitted;
+  }
+
+  /// Consume available completions, requeueing the rest of short reads
+  /// (as readExtent() does; a short direct read ends at end of file)
+  /// @return Extents finished
+  size_t reap(std::span<const Extent> extents, std::span<int64_t> results) {
+    std::atomic_ref<unsigned> cq_head(*m_cq_head);
+    std::atomic_ref<unsigned> cq_tail(*m_cq_tail);
+    unsigned head = cq_head.load(std::memory_order_relaxed);
+    const unsigned tail = cq_tail.load(std::memory_order_acquire);
+    size_t finished = 0;
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+      const auto i = static_cast<size_t>(cqe.user_data);
+      --m_in_flight;
+      if (cqe.res > 0) {
+        m_progress[i] += static_cast<size_t>(cqe.res);
+        if (m_progress[i] < extents[i].length && !extents[i].direct) {
+          queueRead(extents[i], i);
+          continue;
+        }
+      }
+      results[i] = cqe.res < 0 ? cqe.res : static_cast<int64_t>(m_progress[i]);
+      ++finished;
+    }
+    cq_head.store(head, std::memory_order_release);
+    return finished;
+  }
+
+  /// Wait until every submitted read has completed (its buffer is ours again)
+  void drain() {
+    std::atomic_ref<unsigned> cq_head(*m_cq_head);
+    std::atomic_ref<unsigned> cq_tail(*m_cq_tail);
+    while (m_in_flight > 0) {
+      if (ioUringEnter(m_ring, 0, m_in_flight, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Poll the completion ring
+      }
+      unsigned head = cq_head.load(std::memory_order_relaxed);
+      const unsigned tail = cq_tail.load(std::memory_order_acquire);
+      m_in_flight -= std::min(m_in_flight, tail - head);
+      cq_head.store(tail, std::memory_order_release);
+    }
+    m_unsubmitted = 0; // Never submitted: discarded with the ring
+  }
+
+  void release() {
+    if (m_sqes) {
+      ::munmap(m_sqes, m_sqes_bytes);
+    }
+    if (m_cq_ring && m_cq_ring != m_sq_ring) {
+      ::munmap(m_cq_ring, m_cq_bytes);
+    }
+    if (m_sq_ring) {
+      ::munmap(m_sq_ring, m_sq_bytes);
+    }
+    if (m_ring >= 0) {
+      ::close(m_ring); // Also unregisters the buffers
+    }
+    m_sqes = nullptr;
+    m_sq_ring = m_cq_ring = nullptr;
+    m_ring = -1;
+  }
+
+  int m_ring = -1;
+  bool m_fixed_buffers = false;
+  bool m_failed = false;          ///< io_uring_enter() failed: the ring is released
+  std::vector<iovec> m_iovecs;    ///< Per batch slot
+  std::vector<size_t> m_progress; ///< Bytes read so far, per batch slot
+  unsigned m_unsubmitted = 0;     ///< Queued entries not yet passed to the kernel
+  unsigned m_in_flight = 0;       ///< Submitted entries not yet completed
+
+  void* m_sq_ring = nullptr;
+  void* m_cq_ring = nullptr;
+  size_t m_sq_bytes = 0;
+  size_t m_cq_bytes = 0;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sqes_bytes = 0;
+
+  unsigned* m_sq_tail = nullptr;
+  unsigned* m_sq_array = nullptr;
+  unsigned m_sq_mask = 0;
+  unsigned* m_cq_head = nullptr;
+  unsigned* m_cq_tail = nullptr;
+  unsigned m_cq_mask = 0;
+  io_uring_cqe* m_cqes = nullptr;
+};
+
+#endif // ORPHEUS_HAS_IO_URING
+
+} // namespace
+
+// ============================================================================
+// Factory
+// ============================================================================
+
+std::unique_ptr<BlockReader> createBlockReader(const BlockReaderOptions& options) {
+#if defined(ORPHEUS_HAS_IO_URING)
+  if (options.backend != BlockReaderBackend::Pread) {
+    auto reader = std::make_unique<IoUringBlockReader>(options);
+    if (reader->valid()) {
+      return reader;
+    }
+  }
+#endif
+  if (options.backend == BlockReaderBackend::IoUring) {
+    return nullptr;
+  }
+  return std::make_unique<PreadBlockReader>(options);
+}
+
+bool isIoUringAvailable() {
+#if defined(ORPHEUS_HAS_IO_URING)
+  // Containers commonly block io_uring_setup() with seccomp (EPERM)
+  static const bool available = [] {
+    io_uring_params params{};
+    int ring = ioUringSetup(1, &params);
+    if (ring < 0) {
+      return false;
+    }
+    ::close(ring);
+    return true;
+  }();
+  return available;
+#else
+  return false;
+#endif
+}
+
+} // namespace orpheus
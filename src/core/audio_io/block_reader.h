@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+/// I/O mechanism behind a BlockReader
+enum class BlockReaderBackend : uint8_t {
+  Auto,    ///< io_uring where the kernel allows it, otherwise Pread
+  IoUring, ///< Linux io_uring: one system call per batch, registered buffers
+  Pread,   ///< One positional read per request, with posix_fadvise() read-ahead hints
+};
+
+/// Options for createBlockReader()
+struct BlockReaderOptions {
+  BlockReaderBackend backend = BlockReaderBackend::Auto;
+  size_t maxBatch = 64;             ///< Requests per batch (one pool buffer each)
+  size_t maxReadBytes = 256 * 1024; ///< Largest request
+  bool directIo = false;            ///< Open files O_DIRECT (bypass the page cache) where supported
+};
+
+/// One request of a batch
+struct BlockRead {
+  uint32_t file = 0;   ///< Handle from BlockReader::openFile()
+  uint64_t offset = 0; ///< First byte
+  size_t length = 0;   ///< Bytes wanted (1 to maxReadBytes())
+
+  // Results (set by readBatch())
+  const uint8_t* data = nullptr; ///< Bytes read, in the reader's pool (valid until the next batch)
+  int64_t result = 0;            ///< Bytes read (short at end of file), or -errno
+};
+
+/// Batched positional reads from many files (disk streaming of uncompressed audio)
+///
+/// Reads land in a pool owned by the reader: one page-aligned buffer per batch
+/// slot, registered with the kernel once under io_uring so individual reads do
+/// not pin pages. io_uring submits a whole batch with one system call and the
+/// device serves it in any order; the pread backend issues the same requests
+/// one at a time and hints the range following each with POSIX_FADV_WILLNEED.
+///
+/// With directIo, files whose filesystem supports O_DIRECT bypass the page cache
+/// (others are read through it). Requests to them are widened to
+/// DIRECT_IO_ALIGNMENT internally, so callers need not align offsets or lengths.
+///
+/// Thread Safety: use each reader from one thread (e.g. a prefetch thread), never
+/// the audio thread.
+class BlockReader {
+public:
+  static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+  virtual ~BlockReader();
+
+  BlockReader(const BlockReader&) = delete;
+  BlockReader& operator=(const BlockReader&) = delete;
+
+  virtual BlockReaderBackend backend() const = 0;
+
+  size_t maxBatch() const {
+    return m_max_batch;
+  }
+  size_t maxReadBytes() const {
+    return m_max_read_bytes;
+  }
+
+  /// Open a file for reading
+  /// @return Handle, or nullopt if the file cannot be opened
+  std::optional<uint32_t> openFile(const std::string& path);
+
+  /// Whether an open file bypasses the page cache
+  bool isDirect(uint32_t file) const;
+
+  void closeFile(uint32_t file);
+
+  /// Read every request, returning once all have completed
+  /// @return false (nothing read) if the batch exceeds maxBatch() or a request is invalid
+  bool readBatch(std::span<BlockRead> reads);
+
+protected:
+#if defined(_WIN32)
+  using NativeFile = void*;
+#else
+  using NativeFile = int;
+#endif
+
+  /// Byte range actually read for a request (widened for direct I/O)
+  struct Extent {
+    NativeFile file;
+    uint64_t offset;
+    size_t length;
+    size_t head; ///< Requested bytes start this far into the extent
+    bool direct;
+  };
+
+  explicit BlockReader(const BlockReaderOptions& options);
+
+  /// Read extents[i] into slot(i); store each byte count (or -errno) in results[i]
+  virtual void readExtents(std::span<const Extent> extents, std::span<int64_t> results) = 0;
+
+  /// Blocking positional read of one extent, retried until complete or end of file
+  /// @return Bytes read, or -errno
+  static int64_t readExtent(const Extent& extent, uint8_t* buffer);
+
+  /// Pool buffer of a batch slot (page aligned, slotBytes() long)
+  uint8_t* slot(size_t index) const {
+    return m_pool + index * m_slot_bytes;
+  }
+  size_t slotBytes() const {
+    return m_slot_bytes;
+  }
+
+private:
+  struct OpenFile {
+    NativeFile handle;
+    bool direct;
+    bool open;
+  };
+
+  size_t m_max_batch;
+  size_t m_max_read_bytes;
+  bool m_direct_io;
+  size_t m_slot_bytes;
+  uint8_t* m_pool = nullptr;
+  std::vector<OpenFile> m_files;  ///< Indexed by handle
+  std::vector<Extent> m_extents;  ///< Per batch slot (reused)
+  std::vector<int64_t> m_results; ///< Per batch slot (reused)
+};
+
+/// Create a reader with its buffer pool
+/// @return Reader, or nullptr if the requested backend is unavailable (never for Auto or Pread)
+std::unique_ptr<BlockReader> createBlockReader(const BlockReaderOptions& options = {});
+
+/// Whether io_uring can be used by this process (kernel support and permissions)
+bool isIoUringAvailable();
+
+} // namespace orpheus
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: MIT
+#include "decoded_audio_cache.h"
+
+#include "file_fingerprint.h"
+#include "mapped_file.h"
+#include "sample_source.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace orpheus {
+
+namespace {
+
+constexpr const char* SIDECAR_EXTENSION = ".orpdec";
+constexpr std::array<char, 8> SIDECAR_MAGIC = {'O', 'R', 'P', 'D', 'E', 'C', '\0', '\1'};
+constexpr uint32_t SIDECAR_BYTE_ORDER = 0x01020304; // Written in native order
+
+/// Fixed sidecar header; frames follow immediately (64-byte aligned)
+struct SidecarHeader {
+  std::array<char, 8> magic;
+  uint32_t byte_order;
+  uint32_t sample_rate;
+  uint16_t num_channels;
+  uint16_t bit_depth;
+  uint8_t format;
+  uint8_t reserved0[3];
+  int64_t num_frames;
+  char codec[16];
+  uint8_t reserved1[16];
+};
+
+static_assert(sizeof(SidecarHeader) == 64, "Sidecar header layout must stay 64 bytes");
+
+bool isValidKey(const std::string& content_key) {
+  auto is_hex = [](char c) {
+    return std::isdigit(static_cast<unsigned char>(c)) || (c >= 'a' && c <= 'f');
+  };
+  return content_key.size() == 64 && std::all_of(content_key.begin(), content_key.end(), is_hex);
+}
+
+/// Header check shared by load() and contains(); returns the sample count on success
+std::optional<size_t> validateHeader(const SidecarHeader& header, uint64_t file_size) {
+  if (header.magic != SIDECAR_MAGIC || header.byte_order != SIDECAR_BYTE_ORDER ||
+      header.num_channels == 0 || header.num_frames < 0) {
+    return std::nullopt;
+  }
+  uint64_t samples = static_cast<uint64_t>(header.num_frames) * header.num_channels;
+  if (file_size != sizeof(SidecarHeader) + samples * sizeof(float)) {
+    return std::nullopt; // Truncated or foreign file
+  }
+  return static_cast<size_t>(samples);
+}
+
+} // namespace
+
+DecodedAudioCache::DecodedAudioCache(std::filesystem::path directory, uint64_t max_bytes,
+                                     FingerprintIndex* index)
+    : m_directory(std::move(directory)), m_max_bytes(max_bytes),
+      m_index(index ? index : &sharedFingerprintIndex()) {}
+
+bool DecodedAudioCache::isCacheable(const std::string& file_path) {
+  std::string extension = std::filesystem::path(file_path).extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return extension == ".flac" || extension == ".ogg" || extension == ".oga" ||
+         extension == ".opus" || extension == ".mp3";
+}
+
+std::string DecodedAudioCache::contentKey(const std::string& file_path) const {
+  auto fingerprint = m_index->fingerprint(file_path);
+  return fingerprint ? fingerprint->sha256 : std::string();
+}
+
+std::filesystem::path DecodedAudioCache::sidecarPath(const std::string& content_key) const {
+  return m_directory / (content_key + SIDECAR_EXTENSION);
+}
+
+std::shared_ptr<const SampleSource>
+DecodedAudioCache::load(const std::string& content_key,
+                        const std::function<bool(const AudioFileMetadata&)>& reserve) const {
+  if (!isValidKey(content_key)) {
+    return nullptr;
+  }
+  auto path = sidecarPath(content_key);
+  auto mapped = MappedFile::open(path);
+  if (!mapped || mapped->size() < sizeof(SidecarHeader)) {
+    return nullptr;
+  }
+
+  SidecarHeader header;
+  std::memcpy(&header, mapped->data(), sizeof(header));
+  auto num_samples = validateHeader(header, mapped->size());
+  if (!num_samples) {
+    return nullptr;
+  }
+
+  AudioFileMetadata metadata;
+  metadata.format = static_cast<AudioFileFormat>(header.format);
+  metadata.sample_rate = header.sample_rate;
+  metadata.num_channels = header.num_channels;
+  metadata.duration_samples = header.num_frames;
+  metadata.bit_depth = header.bit_depth;
+  metadata.codec.assign(header.codec,
+                        std::find(header.codec, header.codec + sizeof(header.codec), '\0'));
+  metadata.file_hash_sha256 = content_key;
+  if (reserve && !reserve(metadata)) {
+    return nullptr;
+  }
+
+  // Voices read the frames on the audio thread: fault them in now, not there
+  mapped->lockInMemory();
+
+  // Refresh the LRU position (failure only makes the sidecar an earlier eviction candidate)
+  std::error_code ec;
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+  // The header is 64 bytes and mappings are page aligned, so the frames are float aligned
+  const auto* samples = reinterpret_cast<const float*>(mapped->data() + sizeof(SidecarHeader));
+  return std::make_shared<const SampleSource>(std::move(metadata), samples, *num_samples,
+                                              std::move(mapped));
+}
+
+bool DecodedAudioCache::contains(const std::string& content_key) const {
+  if (!isValidKey(content_key)) {
+    return false;
+  }
+  auto path = sidecarPath(content_key);
+  std::ifstream file(path, std::ios::binary);
+  SidecarHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  return !ec && validateHeader(header, size).has_value();
+}
+
+bool DecodedAudioCache::store(const std::string& content_key, const SampleSource& source) {
+  if (!isValidKey(content_key) || source.numChannels() == 0 || !source.isResident()) {
+    return false;
+  }
+
+  size_t num_samples = static_cast<size_t>(source.numFrames()) * source.numChannels();
+  uint64_t file_size = sizeof(SidecarHeader) + num_samples * sizeof(float);
+  if (file_size > m_max_bytes) {
+    return false;
+  }
+
+  SidecarHeader header{};
+  header.magic = SIDECAR_MAGIC;
+  header.byte_order = SIDECAR_BYTE_ORDER;
+  header.sample_rate = source.metadata().sample_rate;
+  header.num_channels = source.numChannels();
+  header.bit_depth = source.metadata().bit_depth;
+  header.format = static_cast<uint8_t>(source.metadata().format);
+  header.num_frames = source.numFrames();
+  std::strncpy(header.codec, source.metadata().codec.c_str(), sizeof(header.codec) - 1);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  if (ec) {
+    return false;
+  }
+
+  // Write under a unique temporary name, then rename so readers never see a partial sidecar
+  auto final_path = sidecarPath(content_key);
+  auto temp_path = uniqueTempPath(final_path);
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(source.data()),
+               static_cast<std::streamsize>(num_samples * sizeof(float)));
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, final_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+
+  lock.unlock(); // evict() takes the lock itself
+  evict();
+  return true;
+}
+
+void DecodedAudioCache::evict() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  struct Sidecar {
+    std::filesystem::path path;
+    uint64_t size;
+    std::filesystem::file_time_type last_used;
+  };
+  std::vector<Sidecar> sidecars;
+  uint64_t total = 0;
+
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+    if (entry.path().extension() != SIDECAR_EXTENSION) {
+      continue;
+    }
+    std::error_code size_ec;
+    std::error_code time_ec;
+    auto size = entry.file_size(size_ec);
+    auto last_used = entry.last_write_time(time_ec);
+    if (size_ec || time_ec) {
+      continue; // Removed by another process meanwhile
+    }
+    sidecars.push_back({entry.path(), static_cast<uint64_t>(size), last_used});
+    total += size;
+  }
+  if (total <= m_max_bytes) {
+    return;
+  }
+
+  std::sort(sidecars.begin(), sidecars.end(),
+            [](const Sidecar& a, const Sidecar& b) { return a.last_used < b.last_used; });
+
+  // Existing mappings stay valid after removal (POSIX); a sidecar still mapped
+  // on Windows cannot be removed and is retried on the next eviction
+  for (const auto& sidecar : sidecars) {
+    if (total <= m_max_bytes) {
+      break;
+    }
+    std::error_code remove_ec;
+    if (std::filesystem::remove(sidecar.path, remove_ec)) {
+      total -= sidecar.size;
+    }
+  }
+}
+
+uint64_t DecodedAudioCache::totalBytes() const {
+  uint64_t total = 0;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(m_directory, ec)) {
+    std::error_code entry_ec;
+    if (entry.path().extension() == SIDECAR_EXTENSION) {
+      auto size = entry.file_size(entry_ec);
+      total += entry_ec ? 0 : static_cast<uint64_t>(size);
+    }
+  }
+  return total;
+}
+
+} // namespace orpheus
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/audio_file_reader.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace orpheus {
+
+class FingerprintIndex;
+class SampleSource;
+
+/// Content-addressed on-disk cache of decoded audio for compressed formats
+///
+/// After a FLAC/OGG/MP3 file is decoded once, its float32 frames are written to
+/// `<directory>/<sha256>.orpdec` (a 64-byte header followed by interleaved
+/// frames in SampleSource layout). Later loads memory-map the sidecar and
+/// hand the mapping to a SampleSource without copying or decoding.
+///
+/// Real-time guarantee: load() pages the whole mapping in and locks it in RAM
+/// before returning, so the audio thread reads mapped frames without page
+/// faults. If the OS refuses the lock (RLIMIT_MEMLOCK), the frames are still
+/// read ahead, but the kernel may reclaim them under memory pressure and a
+/// later read can then fault to disk. Mapped frames count against a
+/// SampleSourceCache's resident budget like decoded ones.
+///
+/// The directory is bounded: after each store, least recently used sidecars
+/// (by modification time, refreshed on load) are removed until the total
+/// size is within the limit.
+///
+/// Thread Safety: all methods may be called concurrently from background/UI
+/// threads (NOT the audio thread). Several processes may share a directory.
+class DecodedAudioCache {
+public:
+  static constexpr uint64_t DEFAULT_MAX_BYTES = 4ULL * 1024 * 1024 * 1024;
+
+  /// @param directory Cache directory (created on first store)
+  /// @param max_bytes Size limit enforced after each store
+  /// @param index Fingerprint index used by contentKey() (nullptr = sharedFingerprintIndex())
+  explicit DecodedAudioCache(std::filesystem::path directory,
+                             uint64_t max_bytes = DEFAULT_MAX_BYTES,
+                             FingerprintIndex* index = nullptr);
+
+  /// Whether a file's format is worth caching (compressed formats, by extension)
+  static bool isCacheable(const std::string& file_path);
+
+  /// Content hash (SHA-256) of a file, empty if it cannot be read
+  std::string contentKey(const std::string& file_path) const;
+
+  /// Map a cached sidecar and lock its frames in memory
+  /// @param content_key SHA-256 from contentKey()
+  /// @param reserve Called with the sidecar's metadata before its frames are paged in;
+  ///        returning false skips the sidecar (e.g. over a memory budget)
+  /// @return Source backed by the mapping, or nullptr if absent, invalid or not reserved
+  std::shared_ptr<const SampleSource>
+  load(const std::string& content_key,
+       const std::function<bool(const AudioFileMetadata&)>& reserve = {}) const;
+
+  /// Whether a valid sidecar exists (does not refresh its LRU position)
+  bool contains(const std::string& content_key) const;
+
+  /// Write a sidecar for decoded audio, then enforce the size limit
+  /// @return false if the key is invalid, the source is streamed or larger than the limit, or
+  ///         writing failed
+  bool store(const std::string& content_key, const SampleSource& source);
+
+  /// Remove least recently used sidecars until the directory fits max_bytes
+  void evict();
+
+  /// Total bytes of sidecars currently on disk
+  uint64_t totalBytes() const;
+
+  /// Sidecar location for a content key
+  std::filesystem::path sidecarPath(const std::string& content_key) const;
+
+  const std::filesystem::path& directory() const {
+    return m_directory;
+  }
+  uint64_t maxBytes() const {
+    return m_max_bytes;
+  }
+
+private:
+  std::filesystem::path m_directory;
+  uint64_t m_max_bytes;
+  FingerprintIndex* m_index;
+  mutable std::mutex m_mutex; ///< Serialises stores/evictions within this process
+};
+
+} // namespace orpheus
@@ -1,12 +1,33 @@
 // SPDX-License-Identifier: MIT
 #include "dummy_audio_driver.h"
 
-#include <chrono>
+#include <orpheus/performance_monitor.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
+#include <limits>
+#include <random>
+#include <utility>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
 
 namespace orpheus {
 
-DummyAudioDriver::DummyAudioDriver() = default;
+namespace {
+
+/// Raise a maximum written only by the audio thread
+void updateMax(std::atomic<int64_t>& max, int64_t value) {
+  if (value > max.load(std::memory_order_relaxed)) {
+    max.store(value, std::memory_order_relaxed);
+  }
+}
+
+} // namespace
+
+DummyAudioDriver::DummyAudioDriver(const DummyDriverOptions& options) : m_options(options) {}
 
 DummyAudioDriver::~DummyAudioDriver() {
   stop();
@@ -66,11 +87,27 @@ SessionGraphError DummyAudioDriver::start(IAudioCallback* callback) {
   }
 
   m_callback = callback;
+  m_callbacks.store(0, std::memory_order_relaxed);
+  m_late_callbacks.store(0, std::memory_order_relaxed);
+  m_slow_callbacks.store(0, std::memory_order_relaxed);
+  m_preempted_callbacks.store(0, std::memory_order_relaxed);
+  m_skipped_periods.store(0, std::memory_order_relaxed);
+  m_lateness_sum_ns.store(0, std::memory_order_relaxed);
+  m_max_lateness_ns.store(0, std::memory_order_relaxed);
+  m_max_callback_ns.store(0, std::memory_order_relaxed);
+  m_min_headroom_ns.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+  m_sample_time.store(0, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> clock_lock(m_freewheel_mutex);
+    m_target_frames = 0;
+  }
   m_should_stop.store(false, std::memory_order_release);
   m_running.store(true, std::memory_order_release);
+  m_thread_ready.store(false, std::memory_order_release);
 
-  // Start audio thread
+  // Start audio thread and wait for its real-time setup
   m_audio_thread = std::thread(&DummyAudioDriver::audioThreadMain, this);
+  m_thread_ready.wait(false, std::memory_order_acquire);
 
   return SessionGraphError::OK;
 }
@@ -86,6 +123,12 @@ SessionGraphError DummyAudioDriver::stop() {
     m_should_stop.store(true, std::memory_order_release);
   }
 
+  // Wake a freewheeling thread (and advance() callers) waiting for a target
+  {
+    std::lock_guard<std::mutex> lock(m_freewheel_mutex);
+  }
+  m_freewheel_cv.notify_all();
+
   // Wait for audio thread to finish (outside of lock to avoid deadlock)
   if (m_audio_thread.joinable()) {
     m_audio_thread.join();
@@ -110,40 +153,269 @@ std::string DummyAudioDriver::getDriverName() const {
 }
 
 uint32_t DummyAudioDriver::getLatencySamples() const {
-  // Dummy driver reports buffer size as latency
-  return m_config.buffer_size;
+  // Dummy driver reports buffer size as latency, plus any processing latency
+  uint32_t processing_latency = m_callback ? m_callback->getProcessingLatencySamples() : 0;
+  return m_config.buffer_size + processing_latency;
 }
 
-void DummyAudioDriver::audioThreadMain() {
-  // Calculate sleep time to simulate real-time audio processing
-  // Sleep for slightly less than buffer duration to avoid drift
-  const double buffer_duration_sec =
-      static_cast<double>(m_config.buffer_size) / static_cast<double>(m_config.sample_rate);
-  const auto sleep_duration = std::chrono::microseconds(
-      static_cast<int64_t>(buffer_duration_sec * 1e6 * 0.95) // 95% to account for jitter
-  );
+IAudioClock* DummyAudioDriver::getClock() {
+  return this;
+}
 
-  while (!m_should_stop.load(std::memory_order_acquire)) {
-    // Clear input buffers (simulate silence from input device)
-    for (auto& buffer : m_input_buffer_storage) {
-      std::memset(buffer.data(), 0, buffer.size() * sizeof(float));
+uint64_t DummyAudioDriver::getSampleTime() const {
+  return m_sample_time.load(std::memory_order_acquire);
+}
+
+uint32_t DummyAudioDriver::getSampleRate() const {
+  return m_config.sample_rate;
+}
+
+bool DummyAudioDriver::isFreewheeling() const {
+  return m_options.freewheel;
+}
+
+uint64_t DummyAudioDriver::advance(uint64_t frames) {
+  if (!m_options.freewheel) {
+    // Real time: wait for the frames to play
+    const uint64_t target = getSampleTime() + frames;
+    while (getSampleTime() < target && m_running.load(std::memory_order_acquire) &&
+           !m_should_stop.load(std::memory_order_acquire)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    return getSampleTime();
+  }
+
+  std::unique_lock<std::mutex> lock(m_freewheel_mutex);
+  if (!m_running.load(std::memory_order_acquire)) {
+    return getSampleTime();
+  }
+  const uint64_t target = std::max(m_target_frames, getSampleTime()) + frames;
+  m_target_frames = target;
+  m_freewheel_cv.notify_all();
+  m_freewheel_cv.wait(lock, [&] {
+    return getSampleTime() >= target || m_should_stop.load(std::memory_order_acquire);
+  });
+  return getSampleTime();
+}
+
+DummyDriverTiming DummyAudioDriver::getTiming() const {
+  auto microseconds = [](const std::atomic<int64_t>& ns) {
+    return static_cast<double>(ns.load(std::memory_order_relaxed)) / 1000.0;
+  };
+  DummyDriverTiming timing;
+  timing.callbacks = m_callbacks.load(std::memory_order_relaxed);
+  timing.lateCallbacks = m_late_callbacks.load(std::memory_order_relaxed);
+  timing.slowCallbacks = m_slow_callbacks.load(std::memory_order_relaxed);
+  timing.preemptedCallbacks = m_preempted_callbacks.load(std::memory_order_relaxed);
+  timing.skippedPeriods = m_skipped_periods.load(std::memory_order_relaxed);
+  if (timing.callbacks > 0 && !m_options.freewheel) {
+    timing.meanLatenessUs = microseconds(m_lateness_sum_ns) / static_cast<double>(timing.callbacks);
+    timing.minHeadroomUs = microseconds(m_min_headroom_ns);
+  }
+  timing.maxLatenessUs = microseconds(m_max_lateness_ns);
+  timing.maxCallbackUs = microseconds(m_max_callback_ns);
+  return timing;
+}
+
+void DummyAudioDriver::setPerformanceMonitor(IPerformanceMonitor* monitor) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_monitor = monitor;
+}
+
+RealtimeThreadReport DummyAudioDriver::getRealtimeReport() const {
+  std::lock_guard<std::mutex> lock(m_report_mutex);
+  return m_realtime_report;
+}
+
+void DummyAudioDriver::sleepUntil(Clock::time_point deadline) {
+#if defined(__linux__)
+  // steady_clock is CLOCK_MONOTONIC with libstdc++ and libc++ on Linux
+  const auto since_epoch = deadline.time_since_epoch();
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  timespec target{};
+  target.tv_sec = static_cast<time_t>(seconds.count());
+  target.tv_nsec = static_cast<long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+  }
+#else
+  std::this_thread::sleep_until(deadline);
+#endif
+}
+
+DummyAudioDriver::Clock::time_point DummyAudioDriver::periodStart(Clock::time_point start,
+                                                                  uint64_t frames) const {
+  // Whole seconds and remainder separately: exact, and no overflow for centuries of frames
+  const uint64_t rate = m_config.sample_rate;
+  const auto ns = (frames / rate) * 1'000'000'000ull + (frames % rate) * 1'000'000'000ull / rate;
+  auto offset = static_cast<int64_t>(ns);
+  if (m_options.clockPpm != 0.0) {
+    offset = static_cast<int64_t>(static_cast<double>(ns) / (1.0 + m_options.clockPpm * 1e-6));
+  }
+  return start + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(offset));
+}
 
-    // Clear output buffers
-    for (auto& buffer : m_output_buffer_storage) {
-      std::memset(buffer.data(), 0, buffer.size() * sizeof(float));
+void DummyAudioDriver::audioThreadMain() {
+  auto report = configureRealtimeThread(m_options.realtime);
+  for (auto& buffer : m_input_buffer_storage) {
+    prefaultMemory(buffer.data(), buffer.size() * sizeof(float));
+  }
+  for (auto& buffer : m_output_buffer_storage) {
+    prefaultMemory(buffer.data(), buffer.size() * sizeof(float));
+  }
+  if (m_monitor) {
+    m_monitor->reportRealtimeThread(report);
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_report_mutex);
+    m_realtime_report = std::move(report);
+  }
+  m_thread_ready.store(true, std::memory_order_release);
+  m_thread_ready.notify_all();
+
+  if (m_options.freewheel) {
+    freewheelLoop();
+  } else {
+    realtimeLoop();
+  }
+}
+
+void DummyAudioDriver::processPeriod() {
+  // Clear input buffers (simulate silence from input device)
+  for (auto& buffer : m_input_buffer_storage) {
+    std::memset(buffer.data(), 0, buffer.size() * sizeof(float));
+  }
+
+  // Clear output buffers
+  for (auto& buffer : m_output_buffer_storage) {
+    std::memset(buffer.data(), 0, buffer.size() * sizeof(float));
+  }
+
+  // Call audio callback (with safety check for shutdown race)
+  if (m_callback && m_running.load(std::memory_order_acquire)) {
+    const float** input_ptrs = m_config.num_inputs > 0 ? m_input_ptrs.data() : nullptr;
+
+    m_callback->processAudio(input_ptrs, m_output_ptrs.data(), m_config.num_outputs,
+                             m_config.buffer_size);
+  }
+}
+
+int64_t DummyAudioDriver::periodNs() const {
+  return static_cast<int64_t>(uint64_t{m_config.buffer_size} * 1'000'000'000ull /
+                              m_config.sample_rate);
+}
+
+void DummyAudioDriver::recordCallback(int64_t callback_ns) {
+  if (m_monitor) {
+    m_monitor->recordAudioCallback(static_cast<uint64_t>(callback_ns) / 1000,
+                                   static_cast<uint64_t>(periodNs()) / 1000, 0,
+                                   m_config.sample_rate, m_config.buffer_size);
+  }
+}
+
+void DummyAudioDriver::reportUnderrun(UnderrunCause cause) {
+  auto& count =
+      cause == UnderrunCause::SlowProcessing ? m_slow_callbacks : m_preempted_callbacks;
+  count.fetch_add(1, std::memory_order_relaxed);
+  if (m_monitor) {
+    m_monitor->reportUnderrun(cause);
+  }
+  if (m_callback && m_running.load(std::memory_order_acquire)) {
+    m_callback->onUnderrun(cause);
+  }
+}
+
+void DummyAudioDriver::freewheelLoop() {
+  const uint64_t period_frames = m_config.buffer_size;
+  uint64_t frames = 0; // Virtual sample clock
+
+  std::unique_lock<std::mutex> lock(m_freewheel_mutex);
+  while (true) {
+    m_freewheel_cv.wait(lock, [&] {
+      return m_should_stop.load(std::memory_order_acquire) || frames < m_target_frames;
+    });
+    if (m_should_stop.load(std::memory_order_acquire)) {
+      break;
+    }
+    lock.unlock();
+
+    const auto began = Clock::now();
+    processPeriod();
+    const int64_t callback_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - began).count();
+    m_callbacks.fetch_add(1, std::memory_order_relaxed);
+    updateMax(m_max_callback_ns, callback_ns);
+    recordCallback(callback_ns); // No deadlines, so never an underrun
+    frames += period_frames;
+
+    lock.lock();
+    m_sample_time.store(frames, std::memory_order_release);
+    if (frames >= m_target_frames) {
+      m_freewheel_cv.notify_all();
     }
+  }
+}
 
-    // Call audio callback (with safety check for shutdown race)
-    if (m_callback && m_running.load(std::memory_order_acquire)) {
-      const float** input_ptrs = m_config.num_inputs > 0 ? m_input_ptrs.data() : nullptr;
+void DummyAudioDriver::realtimeLoop() {
+  const DummyDriverJitter& jitter = m_options.jitter;
+  std::minstd_rand rng(jitter.seed);
+  std::uniform_int_distribution<uint32_t> wakeup_delay_us(0, jitter.maxWakeupDelayUs);
+  std::bernoulli_distribution stall(std::clamp(jitter.stallProbability, 0.0, 1.0));
+  const uint64_t period_frames = m_config.buffer_size;
 
-      m_callback->processAudio(input_ptrs, m_output_ptrs.data(), m_config.num_outputs,
-                               m_config.buffer_size);
+  const auto start = Clock::now();
+  uint64_t frames = 0; // Sample clock: frames delivered so far
+  while (!m_should_stop.load(std::memory_order_acquire)) {
+    const auto woke = Clock::now();
+    const int64_t lateness_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(woke - periodStart(start, frames))
+            .count();
+
+    const int64_t cpu_before_ns = threadCpuTimeNs();
+    processPeriod();
+    const int64_t callback_cpu_ns = threadCpuTimeNs() - cpu_before_ns;
+
+    // The period's buffer is due when the next period starts
+    const auto finished = Clock::now();
+    frames += period_frames;
+    const int64_t callback_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finished - woke).count();
+    const int64_t headroom_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(periodStart(start, frames) - finished)
+            .count();
+
+    m_callbacks.fetch_add(1, std::memory_order_relaxed);
+    m_lateness_sum_ns.fetch_add(std::max<int64_t>(lateness_ns, 0), std::memory_order_relaxed);
+    updateMax(m_max_lateness_ns, lateness_ns);
+    updateMax(m_max_callback_ns, callback_ns);
+    if (headroom_ns < m_min_headroom_ns.load(std::memory_order_relaxed)) {
+      m_min_headroom_ns.store(headroom_ns, std::memory_order_relaxed);
+    }
+    recordCallback(callback_ns);
+    if (headroom_ns < 0) {
+      m_late_callbacks.fetch_add(1, std::memory_order_relaxed);
+      reportUnderrun(classifyDeadlineMiss(callback_cpu_ns, periodNs()));
+    }
+
+    // More than a period behind: drop the missed periods instead of bursting through them
+    uint64_t skipped = 0;
+    while (periodStart(start, frames + period_frames) <= finished) {
+      frames += period_frames;
+      ++skipped;
+    }
+    if (skipped > 0) {
+      m_skipped_periods.fetch_add(skipped, std::memory_order_relaxed);
     }
+    m_sample_time.store(frames, std::memory_order_release);
 
-    // Sleep to simulate real-time constraints
-    std::this_thread::sleep_for(sleep_duration);
+    auto wake_at = periodStart(start, frames);
+    if (jitter.maxWakeupDelayUs > 0) {
+      wake_at += std::chrono::microseconds(wakeup_delay_us(rng));
+    }
+    if (jitter.stallUs > 0 && stall(rng)) {
+      wake_at += std::chrono::microseconds(jitter.stallUs);
+    }
+    sleepUntil(wake_at);
   }
 }
 
@@ -152,4 +424,8 @@ std::unique_ptr<IAudioDriver> createDummyAudioDriver() {
   return std::make_unique<DummyAudioDriver>();
 }
 
+std::unique_ptr<IAudioDriver> createDummyAudioDriver(const DummyDriverOptions& options) {
+  return std::make_unique<DummyAudioDriver>(options);
+}
+
 } // namespace orpheus
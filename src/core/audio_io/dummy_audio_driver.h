@@ -4,17 +4,58 @@
 #include <orpheus/audio_driver.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 namespace orpheus {
 
+class IPerformanceMonitor;
+
+/// Callback timing of a DummyAudioDriver since start()
+struct DummyDriverTiming {
+  uint64_t callbacks = 0;          ///< Callbacks made
+  uint64_t lateCallbacks = 0;      ///< Callbacks that finished after their period had ended
+  uint64_t slowCallbacks = 0;      ///< Late callbacks that used more CPU time than a period
+  uint64_t preemptedCallbacks = 0; ///< Late callbacks whose thread was off the CPU
+  uint64_t skippedPeriods = 0;     ///< Periods dropped to catch up after falling a period behind
+  double meanLatenessUs = 0.0;     ///< Mean wake-up time after the period's deadline
+  double maxLatenessUs = 0.0;      ///< Worst wake-up time after the period's deadline
+  double maxCallbackUs = 0.0;      ///< Longest callback
+  double minHeadroomUs = 0.0;      ///< Least time left in a period after its callback (< 0: late)
+};
+
 /// Dummy audio driver for testing
 /// Simulates real audio hardware by calling the callback on a separate thread
-class DummyAudioDriver : public IAudioDriver {
+///
+/// Period k starts at start + k * buffer_size / sample_rate (absolute deadlines
+/// on the monotonic clock, `clock_nanosleep(TIMER_ABSTIME)` on Linux), so the
+/// callback rate matches the sample rate however long callbacks take. A
+/// thread that falls more than a period behind drops the missed periods, as a
+/// device would underrun, rather than bursting to catch up.
+/// DummyDriverOptions::clockPpm scales the period to simulate a device whose
+/// crystal runs fast or slow, as two real interfaces drift apart.
+///
+/// Jitter injection delays wake-ups and adds stalls to reproduce OS
+/// scheduling noise; lateness and headroom are tracked either way.
+///
+/// Each callback's wall and thread CPU time are measured: every callback is
+/// recorded with the performance monitor, and one that finishes after its
+/// period has ended is reported as an underrun, classified by
+/// classifyDeadlineMiss(), to the monitor and to IAudioCallback::onUnderrun().
+///
+/// The audio thread applies DummyDriverOptions::realtime and pre-faults the
+/// driver's buffers before its first callback; start() returns once it has.
+///
+/// In freewheel mode the audio thread sleeps until advance() raises the target
+/// sample time, then runs callbacks back-to-back until the virtual clock
+/// reaches it. Timing then records callbacks and callback time only.
+class DummyAudioDriver : public IAudioDriver, public IAudioClock {
 public:
-  DummyAudioDriver();
+  explicit DummyAudioDriver(const DummyDriverOptions& options = {});
   ~DummyAudioDriver() override;
 
   // IAudioDriver interface
@@ -25,10 +66,57 @@ public:
   const AudioDriverConfig& getConfig() const override;
   std::string getDriverName() const override;
   uint32_t getLatencySamples() const override;
+  IAudioClock* getClock() override;
+
+  // IAudioClock interface
+  uint64_t getSampleTime() const override;
+  uint32_t getSampleRate() const override;
+  bool isFreewheeling() const override;
+  uint64_t advance(uint64_t frames) override;
+
+  /// Timing since the last start() (any thread)
+  DummyDriverTiming getTiming() const;
+
+  /// Set performance monitor that receives the audio thread's setup report,
+  /// callback timing and underruns
+  /// @param monitor Performance monitor instance (can be nullptr to disable)
+  /// @note Takes effect at the next start()
+  void setPerformanceMonitor(IPerformanceMonitor* monitor);
+
+  /// What the audio thread was granted at the last start() (any thread)
+  RealtimeThreadReport getRealtimeReport() const;
 
 private:
+  using Clock = std::chrono::steady_clock;
+
   void audioThreadMain();
 
+  /// Periods paced on the monotonic clock
+  void realtimeLoop();
+
+  /// Periods run back-to-back up to the advance() target
+  void freewheelLoop();
+
+  /// Clear the buffers and make one callback
+  void processPeriod();
+
+  /// Duration of one buffer in nanoseconds
+  int64_t periodNs() const;
+
+  /// Feed one callback's wall time to the performance monitor
+  void recordCallback(int64_t callback_ns);
+
+  /// Count a missed deadline and pass it to the monitor and the callback
+  void reportUnderrun(UnderrunCause cause);
+
+  /// Sleep until an absolute time on the monotonic clock
+  static void sleepUntil(Clock::time_point deadline);
+
+  /// Start of the period beginning at a frame count
+  Clock::time_point periodStart(Clock::time_point start, uint64_t frames) const;
+
+  DummyDriverOptions m_options;
+
   AudioDriverConfig m_config;
   IAudioCallback* m_callback{nullptr};
 
@@ -42,6 +130,31 @@ private:
   std::vector<const float*> m_input_ptrs;
   std::vector<float*> m_output_ptrs;
 
+  // Timing (written by the audio thread, read by getTiming())
+  std::atomic<uint64_t> m_callbacks{0};
+  std::atomic<uint64_t> m_late_callbacks{0};
+  std::atomic<uint64_t> m_slow_callbacks{0};
+  std::atomic<uint64_t> m_preempted_callbacks{0};
+  std::atomic<uint64_t> m_skipped_periods{0};
+  std::atomic<int64_t> m_lateness_sum_ns{0};
+  std::atomic<int64_t> m_max_lateness_ns{0};
+  std::atomic<int64_t> m_max_callback_ns{0};
+  std::atomic<int64_t> m_min_headroom_ns{0};
+
+  // Sample clock (frames delivered since start)
+  std::atomic<uint64_t> m_sample_time{0};
+
+  // Freewheel target (m_freewheel_mutex); the audio thread and advance() wait on the cv
+  std::mutex m_freewheel_mutex;
+  std::condition_variable m_freewheel_cv;
+  uint64_t m_target_frames{0};
+
+  // Audio thread setup (written before m_thread_ready is set)
+  IPerformanceMonitor* m_monitor{nullptr};
+  RealtimeThreadReport m_realtime_report;
+  mutable std::mutex m_report_mutex;
+  std::atomic<bool> m_thread_ready{false};
+
   mutable std::mutex m_mutex;
 };
 
@@ -0,0 +1,675 @@
+// SPDX-License-Identifier: MIT
+#include "file_fingerprint.h"
+
+#include "io_scheduler.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace orpheus {
+
+namespace {
+
+constexpr size_t HASH_READ_CHUNK = 1024 * 1024;
+constexpr const char* INDEX_HEADER = "orpheus-fingerprints 1";
+
+inline uint32_t rotr32(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint64_t rotl64(uint64_t x, int n) {
+  return (x << n) | (x >> (64 - n));
+}
+
+inline uint64_t readLE64(const uint8_t* p) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; --i) {
+    value = (value << 8) | p[i];
+  }
+  return value;
+}
+
+inline uint32_t readLE32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+constexpr std::array<uint32_t, 64> SHA256_K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+  acc += input * XXH_PRIME64_2;
+  acc = rotl64(acc, 31);
+  return acc * XXH_PRIME64_1;
+}
+
+inline uint64_t xxhMergeRound(uint64_t acc, uint64_t value) {
+  acc ^= xxhRound(0, value);
+  return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/// Size and modification time of a file, or std::nullopt if it cannot be stat'ed
+struct FileStamp {
+  std::filesystem::path canonical;
+  uint64_t size;
+  int64_t mtime;
+};
+
+std::optional<FileStamp> stampFile(const std::string& file_path) {
+  std::error_code ec;
+  auto canonical = std::filesystem::canonical(file_path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto size = std::filesystem::file_size(canonical, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto modified = std::filesystem::last_write_time(canonical, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return FileStamp{std::move(canonical), static_cast<uint64_t>(size),
+                   static_cast<int64_t>(modified.time_since_epoch().count())};
+}
+
+/// Read up to `size` bytes; returns bytes read, or std::nullopt on I/O error
+std::optional<size_t> readChunk(std::ifstream& file, uint8_t* buffer, size_t size) {
+  auto ticket = sharedIoScheduler().acquire(IoClass::Background);
+  file.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size));
+  if (file.bad()) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(file.gcount());
+}
+
+/// Hash sequentially on the calling thread
+bool hashSequential(std::ifstream& file, Sha256& hasher) {
+  std::vector<uint8_t> buffer(HASH_READ_CHUNK);
+  for (;;) {
+    auto read = readChunk(file, buffer.data(), buffer.size());
+    if (!read) {
+      return false;
+    }
+    if (*read == 0) {
+      return true;
+    }
+    hasher.update(buffer.data(), *read);
+  }
+}
+
+/// Hash with a helper thread filling one buffer while the caller hashes the other
+///
+/// SHA-256 is a serial chain over the message, so the digest itself cannot be split across
+/// cores without changing its value; overlapping disk reads with compression is the
+/// parallelism available.
+bool hashPipelined(std::ifstream& file, Sha256& hasher) {
+  struct Buffer {
+    std::vector<uint8_t> data = std::vector<uint8_t>(HASH_READ_CHUNK);
+    size_t size = 0;
+    bool full = false;
+  };
+  std::array<Buffer, 2> buffers;
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool failed = false;
+  bool cancelled = false;
+
+  std::thread reader([&] {
+    for (size_t i = 0;; ++i) {
+      Buffer& buffer = buffers[i % 2];
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return !buffer.full || cancelled; });
+        if (cancelled) {
+          return;
+        }
+      }
+      auto read = readChunk(file, buffer.data.data(), buffer.data.size());
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer.size = read.value_or(0);
+        buffer.full = true;
+        failed = !read;
+      }
+      changed.notify_all();
+      if (!read || *read == 0) {
+        return;
+      }
+    }
+  });
+
+  for (size_t i = 0;; ++i) {
+    Buffer& buffer = buffers[i % 2];
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return buffer.full; });
+      if (buffer.size == 0) {
+        break; // End of file or read error
+      }
+    }
+    hasher.update(buffer.data.data(), buffer.size);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffer.full = false;
+    }
+    changed.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+  }
+  changed.notify_all();
+  reader.join();
+  return !failed;
+}
+
+std::string toHex64(uint64_t value) {
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+  return text;
+}
+
+} // namespace
+
+// ============================================================================
+// Sha256
+// ============================================================================
+
+Sha256::Sha256() {
+  reset();
+}
+
+void Sha256::reset() {
+  m_state = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  m_block_size = 0;
+  m_total_bytes = 0;
+}
+
+void Sha256::compress(const uint8_t* block) {
+  std::array<uint32_t, 64> w;
+  for (size_t i = 0; i < 16; ++i) {
+    w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+           (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+           (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+  }
+  for (size_t i = 16; i < 64; ++i) {
+    uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+  uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+
+  for (size_t i = 0; i < 64; ++i) {
+    uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+    uint32_t ch = (e & f) ^ (~e & g);
+    uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+    uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  m_state[0] += a;
+  m_state[1] += b;
+  m_state[2] += c;
+  m_state[3] += d;
+  m_state[4] += e;
+  m_state[5] += f;
+  m_state[6] += g;
+  m_state[7] += h;
+}
+
+void Sha256::update(const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  m_total_bytes += size;
+
+  if (m_block_size > 0) {
+    size_t take = std::min(size, m_block.size() - m_block_size);
+    std::copy_n(bytes, take, m_block.data() + m_block_size);
+    m_block_size += take;
+    bytes += take;
+    size -= take;
+    if (m_block_size < m_block.size()) {
+      return;
+    }
+    compress(m_block.data());
+    m_block_size = 0;
+  }
+
+  // Whole blocks straight from the caller's buffer
+  for (; size >= m_block.size(); bytes += m_block.size(), size -= m_block.size()) {
+    compress(bytes);
+  }
+
+  std::copy_n(bytes, size, m_block.data());
+  m_block_size = size;
+}
+
+Sha256::Digest Sha256::finalize() {
+  uint64_t bit_length = m_total_bytes * 8;
+
+  // Padding: 0x80, zeros to 56 mod 64, then the 64-bit big-endian bit length
+  m_block[m_block_size++] = 0x80;
+  if (m_block_size > 56) {
+    std::fill(m_block.begin() + static_cast<std::ptrdiff_t>(m_block_size), m_block.end(), 0);
+    compress(m_block.data());
+    m_block_size = 0;
+  }
+  std::fill(m_block.begin() + static_cast<std::ptrdiff_t>(m_block_size), m_block.begin() + 56,
+            0);
+  for (size_t i = 0; i < 8; ++i) {
+    m_block[56 + i] = static_cast<uint8_t>(bit_length >> (56 - i * 8));
+  }
+  compress(m_block.data());
+
+  Digest digest;
+  for (size_t i = 0; i < 8; ++i) {
+    digest[i * 4] = static_cast<uint8_t>(m_state[i] >> 24);
+    digest[i * 4 + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+    digest[i * 4 + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+    digest[i * 4 + 3] = static_cast<uint8_t>(m_state[i]);
+  }
+  reset();
+  return digest;
+}
+
+std::string Sha256::toHex(const Digest& digest) {
+  static constexpr char DIGITS[] = "0123456789abcdef";
+  std::string text(digest.size() * 2, '0');
+  for (size_t i = 0; i < digest.size(); ++i) {
+    text[i * 2] = DIGITS[digest[i] >> 4];
+    text[i * 2 + 1] = DIGITS[digest[i] & 0x0f];
+  }
+  return text;
+}
+
+// ============================================================================
+// xxHash64
+// ============================================================================
+
+uint64_t xxHash64(const void* data, size_t size, uint64_t seed) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  const uint8_t* end = p + size;
+  uint64_t h;
+
+  if (size >= 32) {
+    uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    uint64_t v2 = seed + XXH_PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - XXH_PRIME64_1;
+    for (; end - p >= 32; p += 32) {
+      v1 = xxhRound(v1, readLE64(p));
+      v2 = xxhRound(v2, readLE64(p + 8));
+      v3 = xxhRound(v3, readLE64(p + 16));
+      v4 = xxhRound(v4, readLE64(p + 24));
+    }
+    h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    h = xxhMergeRound(h, v1);
+    h = xxhMergeRound(h, v2);
+    h = xxhMergeRound(h, v3);
+    h = xxhMergeRound(h, v4);
+  } else {
+    h = seed + XXH_PRIME64_5;
+  }
+
+  h += static_cast<uint64_t>(size);
+
+  for (; end - p >= 8; p += 8) {
+    h ^= xxhRound(0, readLE64(p));
+    h = rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+  }
+  if (end - p >= 4) {
+    h ^= static_cast<uint64_t>(readLE32(p)) * XXH_PRIME64_1;
+    h = rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    h ^= *p * XXH_PRIME64_5;
+    h = rotl64(h, 11) * XXH_PRIME64_1;
+  }
+
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+// ============================================================================
+// File fingerprints
+// ============================================================================
+
+std::optional<std::string> sha256File(const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+
+  std::error_code ec;
+  auto size = std::filesystem::file_size(file_path, ec);
+
+  Sha256 hasher;
+  bool ok = (!ec && size >= PARALLEL_HASH_THRESHOLD) ? hashPipelined(file, hasher)
+                                                      : hashSequential(file, hasher);
+  if (!ok) {
+    return std::nullopt;
+  }
+  return Sha256::toHex(hasher.finalize());
+}
+
+std::optional<uint64_t> quickFingerprint(const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  file.seekg(0, std::ios::end);
+  auto end = file.tellg();
+  if (end < 0) {
+    return std::nullopt;
+  }
+  auto size = static_cast<uint64_t>(end);
+
+  // Size prefix, then the whole file if small, else head + middle + tail windows
+  std::vector<uint8_t> sample(8);
+  for (size_t i = 0; i < 8; ++i) {
+    sample[i] = static_cast<uint8_t>(size >> (i * 8));
+  }
+
+  constexpr uint64_t WINDOW = QUICK_FINGERPRINT_WINDOW;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  if (size <= 3 * WINDOW) {
+    ranges.emplace_back(0, size);
+  } else {
+    ranges.emplace_back(0, WINDOW);
+    ranges.emplace_back(size / 2 - WINDOW / 2, WINDOW);
+    ranges.emplace_back(size - WINDOW, WINDOW);
+  }
+
+  for (const auto& [offset, length] : ranges) {
+    size_t start = sample.size();
+    sample.resize(start + static_cast<size_t>(length));
+    file.seekg(static_cast<std::streamoff>(offset));
+    auto read = readChunk(file, sample.data() + start, static_cast<size_t>(length));
+    if (!read || *read != length) {
+      return std::nullopt;
+    }
+  }
+
+  return xxHash64(sample.data(), sample.size());
+}
+
+std::optional<FileFingerprint> computeFileFingerprint(const std::string& file_path) {
+  auto stamp = stampFile(file_path);
+  if (!stamp) {
+    return std::nullopt;
+  }
+  auto sha256 = sha256File(file_path);
+  auto quick = quickFingerprint(file_path);
+  if (!sha256 || !quick) {
+    return std::nullopt;
+  }
+
+  FileFingerprint fingerprint;
+  fingerprint.sha256 = std::move(*sha256);
+  fingerprint.quick = *quick;
+  fingerprint.size = stamp->size;
+  fingerprint.mtime = stamp->mtime;
+  return fingerprint;
+}
+
+// ============================================================================
+// FingerprintIndex
+// ============================================================================
+
+FingerprintIndex::FingerprintIndex(std::filesystem::path index_path)
+    : m_index_path(std::move(index_path)) {}
+
+std::optional<FileFingerprint> FingerprintIndex::fingerprint(const std::string& file_path) {
+  auto stamp = stampFile(file_path);
+  if (!stamp) {
+    return std::nullopt;
+  }
+  std::string key = stamp->canonical.string();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    loadLocked();
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && it->second.size == stamp->size &&
+        it->second.mtime == stamp->mtime) {
+      ++m_hits;
+      return it->second;
+    }
+  }
+
+  // Hash without holding the lock so other files can be looked up meanwhile
+  auto computed = computeFileFingerprint(key);
+  if (!computed) {
+    return std::nullopt;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_misses;
+  m_entries[key] = *computed;
+  appendLocked(key, *computed);
+  return computed;
+}
+
+std::optional<FileFingerprint> FingerprintIndex::lookup(const std::string& file_path) {
+  auto stamp = stampFile(file_path);
+  if (!stamp) {
+    return std::nullopt;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  loadLocked();
+  auto it = m_entries.find(stamp->canonical.string());
+  if (it == m_entries.end() || it->second.size != stamp->size ||
+      it->second.mtime != stamp->mtime) {
+    return std::nullopt;
+  }
+  ++m_hits;
+  return it->second;
+}
+
+void FingerprintIndex::setIndexPath(std::filesystem::path index_path) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_index_path = std::move(index_path);
+  m_entries.clear();
+  m_log_lines = 0;
+  m_loaded = false;
+}
+
+std::filesystem::path FingerprintIndex::indexPath() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_index_path;
+}
+
+size_t FingerprintIndex::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+size_t FingerprintIndex::hits() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_hits;
+}
+
+size_t FingerprintIndex::misses() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_misses;
+}
+
+void FingerprintIndex::loadLocked() {
+  if (m_loaded) {
+    return;
+  }
+  m_loaded = true;
+  if (m_index_path.empty()) {
+    return;
+  }
+
+  std::ifstream file(m_index_path);
+  std::string line;
+  if (!file || !std::getline(file, line) || line != INDEX_HEADER) {
+    return; // Missing or unrecognised index: start empty, rewritten on first append
+  }
+
+  // Line format: sha256 \t quick \t size \t mtime \t path (later lines supersede earlier)
+  while (std::getline(file, line)) {
+    ++m_log_lines;
+    std::istringstream fields(line);
+    FileFingerprint entry;
+    std::string quick;
+    std::string path;
+    if (!std::getline(fields, entry.sha256, '\t') || !std::getline(fields, quick, '\t') ||
+        !(fields >> entry.size) || fields.get() != '\t' || !(fields >> entry.mtime) ||
+        fields.get() != '\t' || !std::getline(fields, path) || path.empty() ||
+        entry.sha256.size() != 64) {
+      continue;
+    }
+    try {
+      entry.quick = std::stoull(quick, nullptr, 16);
+    } catch (...) {
+      continue;
+    }
+    m_entries[path] = std::move(entry);
+  }
+
+  // Forget files that were deleted, moved or edited since they were indexed
+  size_t pruned = std::erase_if(m_entries, [](const auto& entry) {
+    auto stamp = stampFile(entry.first);
+    return !stamp || stamp->size != entry.second.size || stamp->mtime != entry.second.mtime;
+  });
+
+  // Compact once anything was pruned or superseded lines outnumber live entries
+  if (pruned > 0 || m_log_lines > 2 * m_entries.size() + 64) {
+    rewriteLocked();
+  }
+}
+
+void FingerprintIndex::appendLocked(const std::string& key, const FileFingerprint& fingerprint) {
+  if (m_index_path.empty() || key.find('\n') != std::string::npos) {
+    return; // Memory-only, or a path the line format cannot represent
+  }
+
+  std::error_code ec;
+  bool exists = std::filesystem::exists(m_index_path, ec);
+  if (!exists || m_log_lines == 0) {
+    rewriteLocked();
+    return;
+  }
+
+  std::ofstream file(m_index_path, std::ios::app);
+  file << fingerprint.sha256 << '\t' << toHex64(fingerprint.quick) << '\t' << fingerprint.size
+       << '\t' << fingerprint.mtime << '\t' << key << '\n';
+  if (file) {
+    ++m_log_lines;
+  }
+}
+
+void FingerprintIndex::rewriteLocked() {
+  // The index is an optimisation: failures to persist are ignored
+  std::error_code ec;
+  if (m_index_path.has_parent_path()) {
+    std::filesystem::create_directories(m_index_path.parent_path(), ec);
+  }
+
+  // Other processes may rewrite the same index: never share a temporary file
+  auto temp_path = uniqueTempPath(m_index_path);
+  size_t lines = 0;
+  {
+    std::ofstream file(temp_path, std::ios::trunc);
+    file << INDEX_HEADER << '\n';
+    for (const auto& [path, entry] : m_entries) {
+      if (path.find('\n') != std::string::npos) {
+        continue;
+      }
+      file << entry.sha256 << '\t' << toHex64(entry.quick) << '\t' << entry.size << '\t'
+           << entry.mtime << '\t' << path << '\n';
+      ++lines;
+    }
+    if (!file) {
+      std::filesystem::remove(temp_path, ec);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temp_path, m_index_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return;
+  }
+  m_log_lines = lines;
+}
+
+std::filesystem::path defaultCacheDirectory() {
+  if (const char* override_dir = std::getenv("ORPHEUS_CACHE_DIR"); override_dir && *override_dir) {
+    return override_dir;
+  }
+#if defined(_WIN32)
+  if (const char* local = std::getenv("LOCALAPPDATA"); local && *local) {
+    return std::filesystem::path(local) / "orpheus";
+  }
+#elif defined(__APPLE__)
+  if (const char* home = std::getenv("HOME"); home && *home) {
+    return std::filesystem::path(home) / "Library" / "Caches" / "orpheus";
+  }
+#else
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+    return std::filesystem::path(xdg) / "orpheus";
+  }
+  if (const char* home = std::getenv("HOME"); home && *home) {
+    return std::filesystem::path(home) / ".cache" / "orpheus";
+  }
+#endif
+  std::error_code ec;
+  auto temp = std::filesystem::temp_directory_path(ec);
+  return ec ? std::filesystem::path() : temp / "orpheus";
+}
+
+FingerprintIndex& sharedFingerprintIndex() {
+  static FingerprintIndex index = [] {
+    auto directory = defaultCacheDirectory();
+    return directory.empty() ? FingerprintIndex()
+                             : FingerprintIndex(directory / "fingerprints.tsv");
+  }();
+  return index;
+}
+
+} // namespace orpheus
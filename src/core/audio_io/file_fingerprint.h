@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace orpheus {
+
+// ============================================================================
+// Hash primitives
+// ============================================================================
+
+/// Streaming SHA-256 (FIPS 180-4)
+class Sha256 {
+public:
+  using Digest = std::array<uint8_t, 32>;
+
+  Sha256();
+
+  /// Append bytes to the message
+  void update(const void* data, size_t size);
+
+  /// Finish the message and return its digest (the hasher is reset afterwards)
+  Digest finalize();
+
+  /// Lowercase hex encoding of a digest
+  static std::string toHex(const Digest& digest);
+
+private:
+  void reset();
+  void compress(const uint8_t* block);
+
+  std::array<uint32_t, 8> m_state;
+  std::array<uint8_t, 64> m_block;
+  size_t m_block_size;
+  uint64_t m_total_bytes;
+};
+
+/// XXH64 non-cryptographic hash of a byte range
+uint64_t xxHash64(const void* data, size_t size, uint64_t seed = 0);
+
+// ============================================================================
+// File fingerprints
+// ============================================================================
+
+/// Content identity of a file on disk
+struct FileFingerprint {
+  std::string sha256; ///< Lowercase hex SHA-256 of the whole file
+  uint64_t quick = 0; ///< XXH64 of size + head/middle/tail windows (see quickFingerprint)
+  uint64_t size = 0;  ///< File size in bytes
+  int64_t mtime = 0;  ///< Last write time (filesystem clock ticks)
+};
+
+/// Bytes sampled from each of the head, middle and tail of a file by quickFingerprint()
+constexpr size_t QUICK_FINGERPRINT_WINDOW = 64 * 1024;
+
+/// Files at least this large are hashed with reads overlapped on a second thread
+constexpr uint64_t PARALLEL_HASH_THRESHOLD = 8 * 1024 * 1024;
+
+/// Hash a whole file with SHA-256
+/// @param file_path Path to file
+/// @return Lowercase hex digest, or std::nullopt if the file cannot be read
+/// @note Large files are read on a helper thread while the caller hashes; do not call from the
+///       audio thread
+std::optional<std::string> sha256File(const std::string& file_path);
+
+/// Cheap fingerprint reading at most 3 * QUICK_FINGERPRINT_WINDOW bytes
+///
+/// Suitable as a first-pass dedup key: equal SHA-256 implies equal quick fingerprints, but
+/// files differing only outside the sampled windows collide. Confirm with sha256.
+/// @return Fingerprint, or std::nullopt if the file cannot be read
+std::optional<uint64_t> quickFingerprint(const std::string& file_path);
+
+/// Compute SHA-256 and quick fingerprint without consulting any cache
+std::optional<FileFingerprint> computeFileFingerprint(const std::string& file_path);
+
+// ============================================================================
+// FingerprintIndex
+// ============================================================================
+
+/// Persistent cache of file fingerprints keyed by (canonical path, size, mtime)
+///
+/// A file whose size and modification time are unchanged is assumed unchanged, so
+/// reopening a session re-hashes only files that were edited or are new. The on-disk
+/// index is an append-only text log. Loading drops entries for files that are gone or
+/// have changed, and compacts the log when it pruned any or stale lines dominate.
+/// Thread-safe.
+class FingerprintIndex {
+public:
+  /// @param index_path On-disk index file; empty keeps the index in memory only
+  explicit FingerprintIndex(std::filesystem::path index_path = {});
+
+  /// Fingerprint for a file, computed only on cache miss
+  /// @return Fingerprint, or std::nullopt if the file cannot be read
+  std::optional<FileFingerprint> fingerprint(const std::string& file_path);
+
+  /// Cached fingerprint for an unchanged file, never hashing
+  /// @return Fingerprint, or std::nullopt if the file is not indexed (or has changed)
+  std::optional<FileFingerprint> lookup(const std::string& file_path);
+
+  /// Move the index to another file (empty = memory only), reloading from it on next use
+  void setIndexPath(std::filesystem::path index_path);
+
+  /// Number of cached fingerprints
+  size_t size() const;
+
+  /// Lookups served from the index since construction
+  size_t hits() const;
+
+  /// Lookups that had to hash the file since construction
+  size_t misses() const;
+
+  /// Index path (empty for memory-only)
+  std::filesystem::path indexPath() const;
+
+private:
+  void loadLocked();
+  void appendLocked(const std::string& key, const FileFingerprint& fingerprint);
+  void rewriteLocked();
+
+  std::filesystem::path m_index_path;
+  mutable std::mutex m_mutex;
+  bool m_loaded = false;
+  size_t m_log_lines = 0;
+  size_t m_hits = 0;
+  size_t m_misses = 0;
+  std::unordered_map<std::string, FileFingerprint> m_entries; ///< Keyed by canonical path
+};
+
+/// Directory for persistent Orpheus caches
+///
+/// `$ORPHEUS_CACHE_DIR` if set, otherwise the platform user cache directory
+/// (`$XDG_CACHE_HOME` or `~/.cache` on Linux, `~/Library/Caches` on macOS,
+/// `%LOCALAPPDATA%` on Windows) with an `orpheus` subdirectory. Not created here.
+std::filesystem::path defaultCacheDirectory();
+
+/// Process-wide fingerprint index stored in defaultCacheDirectory()
+/// @note Relocate it with setIndexPath() (or `$ORPHEUS_CACHE_DIR`) to keep test runs
+///       out of the user's cache
+FingerprintIndex& sharedFingerprintIndex();
+
+} // namespace orpheus
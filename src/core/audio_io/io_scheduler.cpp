@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+#include "io_scheduler.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace orpheus {
+
+namespace {
+
+void record(IoLatencyHistogram& histogram, IoScheduler::Clock::duration elapsed) {
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  size_t bucket = 0;
+  if (micros > 0) {
+    bucket = static_cast<size_t>(std::bit_width(static_cast<uint64_t>(micros))) - 1;
+  }
+  ++histogram.counts[std::min(bucket, IoLatencyHistogram::BUCKETS - 1)];
+}
+
+/// Caps of zero would block a class forever
+IoSchedulerLimits atLeastOne(IoSchedulerLimits limits) {
+  limits.maxInFlight = std::max<size_t>(limits.maxInFlight, 1);
+  for (auto& cap : limits.maxPerClass) {
+    cap = std::max<size_t>(cap, 1);
+  }
+  return limits;
+}
+
+} // namespace
+
+// ============================================================================
+// Ticket
+// ============================================================================
+
+IoScheduler::Ticket::Ticket(Ticket&& other) noexcept
+    : m_scheduler(std::exchange(other.m_scheduler, nullptr)), m_class(other.m_class),
+      m_deadline(other.m_deadline), m_requested(other.m_requested) {}
+
+IoScheduler::Ticket& IoScheduler::Ticket::operator=(Ticket&& other) noexcept {
+  if (this != &other) {
+    release();
+    m_scheduler = std::exchange(other.m_scheduler, nullptr);
+    m_class = other.m_class;
+    m_deadline = other.m_deadline;
+    m_requested = other.m_requested;
+  }
+  return *this;
+}
+
+void IoScheduler::Ticket::release() {
+  if (m_scheduler) {
+    m_scheduler->finish(*this);
+    m_scheduler = nullptr;
+  }
+}
+
+// ============================================================================
+// IoScheduler
+// ============================================================================
+
+IoScheduler::IoScheduler(const IoSchedulerLimits& limits) : m_limits(atLeastOne(limits)) {}
+
+IoScheduler::Ticket IoScheduler::acquire(IoClass io_class, Clock::time_point deadline) {
+  Ticket ticket;
+  ticket.m_class = io_class;
+  ticket.m_deadline = deadline;
+  ticket.m_requested = Clock::now();
+
+  auto& stats = m_stats.classes[static_cast<size_t>(io_class)];
+  Waiter waiter{io_class};
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queue.emplace(QueueKey{deadline, m_next_sequence++}, &waiter);
+    ++stats.queued;
+    stats.peakQueued = std::max(stats.peakQueued, stats.queued);
+    dispatchLocked();
+    m_granted_cv.wait(lock, [&] { return waiter.granted; });
+    record(stats.wait, Clock::now() - ticket.m_requested);
+  }
+  ticket.m_scheduler = this;
+  return ticket;
+}
+
+IoScheduler::Ticket IoScheduler::acquire(IoClass io_class) {
+  if (io_class == IoClass::Interactive) {
+    return acquire(io_class, Clock::now() + INTERACTIVE_DEADLINE);
+  }
+  return acquire(io_class, BEST_EFFORT);
+}
+
+IoScheduler::Clock::time_point IoScheduler::playbackDeadline(int64_t buffered_frames,
+                                                             uint32_t sample_rate) {
+  const auto now = Clock::now();
+  if (buffered_frames <= 0 || sample_rate == 0) {
+    return now;
+  }
+  const double seconds = static_cast<double>(buffered_frames) / sample_rate;
+  return now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+IoStats IoScheduler::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void IoScheduler::resetStats() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& stats : m_stats.classes) {
+    stats.completed = 0;
+    stats.missedDeadlines = 0;
+    stats.peakQueued = stats.queued;
+    stats.wait = {};
+    stats.latency = {};
+  }
+}
+
+void IoScheduler::dispatchLocked() {
+  bool granted = false;
+  for (auto it = m_queue.begin(); it != m_queue.end() && m_in_flight < m_limits.maxInFlight;) {
+    const auto index = static_cast<size_t>(it->second->io_class);
+    auto& stats = m_stats.classes[index];
+    if (stats.inFlight >= m_limits.maxPerClass[index]) {
+      ++it; // Class at its cap: a later deadline of another class may go first
+      continue;
+    }
+    it->second->granted = true;
+    --stats.queued;
+    ++stats.inFlight;
+    ++m_in_flight;
+    it = m_queue.erase(it);
+    granted = true;
+  }
+  if (granted) {
+    m_granted_cv.notify_all();
+  }
+}
+
+void IoScheduler::finish(const Ticket& ticket) {
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& stats = m_stats.classes[static_cast<size_t>(ticket.m_class)];
+  --stats.inFlight;
+  --m_in_flight;
+  ++stats.completed;
+  if (ticket.m_deadline != BEST_EFFORT && now > ticket.m_deadline) {
+    ++stats.missedDeadlines;
+  }
+  record(stats.latency, now - ticket.m_requested);
+  dispatchLocked();
+}
+
+IoScheduler& sharedIoScheduler() {
+  static IoScheduler scheduler;
+  return scheduler;
+}
+
+IoStats getIoStats() {
+  return sharedIoScheduler().stats();
+}
+
+} // namespace orpheus
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/io_stats.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace orpheus {
+
+/// Concurrency caps of an IoScheduler
+struct IoSchedulerLimits {
+  size_t maxInFlight = 4; ///< Reads issued at once, all classes
+  /// Reads issued at once per IoClass (Playback, Interactive, Background)
+  std::array<size_t, IO_CLASS_COUNT> maxPerClass = {4, 2, 1};
+};
+
+/// Earliest-deadline-first admission of disk reads
+///
+/// Callers acquire a Ticket before a read and release it (by destroying the
+/// ticket) when the read returns; the read itself runs on the caller's thread.
+/// While reads are waiting, each freed slot goes to the waiting request with
+/// the earliest deadline whose class is below its cap. Background requests
+/// carry no deadline and are issued in arrival order after every deadline-bearing
+/// one. With the default caps, Interactive and Background reads can never
+/// occupy every slot, so a playback refill waits for at most one read.
+///
+/// Hold a ticket for one read (one chunk), not a whole file, so that urgent
+/// requests overtake long background scans between their chunks.
+///
+/// Thread Safety: all methods may be called from any non-audio thread.
+class IoScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Deadline of requests that have none
+  static constexpr Clock::time_point BEST_EFFORT = Clock::time_point::max();
+
+  /// Default deadline of Interactive requests (a user is waiting)
+  static constexpr std::chrono::milliseconds INTERACTIVE_DEADLINE{250};
+
+  /// Permission to issue one read; released on destruction
+  class Ticket {
+  public:
+    Ticket() = default;
+    ~Ticket() {
+      release();
+    }
+
+    Ticket(Ticket&& other) noexcept;
+    Ticket& operator=(Ticket&& other) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+
+    /// Finish the read early (no-op if already released)
+    void release();
+
+    explicit operator bool() const {
+      return m_scheduler != nullptr;
+    }
+
+  private:
+    friend class IoScheduler;
+
+    IoScheduler* m_scheduler = nullptr;
+    IoClass m_class = IoClass::Background;
+    Clock::time_point m_deadline{};
+    Clock::time_point m_requested{};
+  };
+
+  explicit IoScheduler(const IoSchedulerLimits& limits = {});
+
+  IoScheduler(const IoScheduler&) = delete;
+  IoScheduler& operator=(const IoScheduler&) = delete;
+
+  /// Block until a read of the given class may be issued
+  /// @param deadline Time by which the read must have completed (BEST_EFFORT for none)
+  Ticket acquire(IoClass io_class, Clock::time_point deadline);
+
+  /// Block with the class's default deadline (none for Playback and Background)
+  Ticket acquire(IoClass io_class);
+
+  /// Deadline of a playback refill: when the frames still buffered run out
+  static Clock::time_point playbackDeadline(int64_t buffered_frames, uint32_t sample_rate);
+
+  IoStats stats() const;
+
+  /// Clear histograms and counters (queued and in-flight counts are kept)
+  void resetStats();
+
+  const IoSchedulerLimits& limits() const {
+    return m_limits;
+  }
+
+private:
+  struct Waiter {
+    IoClass io_class;
+    bool granted = false;
+  };
+
+  /// Queue order: deadline, then arrival
+  using QueueKey = std::pair<Clock::time_point, uint64_t>;
+
+  /// Grant slots to waiters in deadline order (caller holds m_mutex)
+  void dispatchLocked();
+
+  void finish(const Ticket& ticket);
+
+  const IoSchedulerLimits m_limits;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_granted_cv; ///< A waiter was granted a slot
+  std::map<QueueKey, Waiter*> m_queue;
+  uint64_t m_next_sequence = 0;
+  size_t m_in_flight = 0;
+  IoStats m_stats; ///< Live queued/in-flight counts, histograms and counters
+};
+
+/// Process-wide scheduler shared by every transport, reader and analysis job
+IoScheduler& sharedIoScheduler();
+
+} // namespace orpheus
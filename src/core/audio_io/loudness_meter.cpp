@@ -0,0 +1,450 @@
+// SPDX-License-Identifier: MIT
+#include "loudness_meter.h"
+
+#include "io_scheduler.h"
+#include "sample_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORPHEUS_LOUDNESS_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ORPHEUS_LOUDNESS_NEON 1
+#endif
+
+namespace orpheus {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// BS.1770-4 Annex 2 interpolator, phase by phase (tap k weights the frame k back)
+constexpr std::array<std::array<float, LoudnessMeter::TAPS_PER_PHASE>,
+                     LoudnessMeter::OVERSAMPLING>
+    TRUE_PEAK_PHASES = {{
+        {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+         -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+         0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f},
+        {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+         -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+         0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+        {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f,
+         -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f,
+         0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+        {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f,
+         -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f,
+         0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+    }};
+
+/// Largest gain of any interpolator phase (sum of its absolute taps)
+constexpr float TRUE_PEAK_MAX_GAIN = 2.0228271484375f;
+
+/// Frames whose sample peak decides whether they are oversampled (at least TAPS_PER_PHASE - 1)
+constexpr size_t PEAK_BLOCK_FRAMES = 64;
+
+/// Squares summed in float before folding into the double step totals
+constexpr size_t SUM_FLUSH_FRAMES = 256;
+
+/// Filter states smaller than this are zeroed after each step (no denormals in long silences)
+constexpr float DENORMAL_FLUSH = 1e-20f;
+
+/// Loudness of a weighted mean square (-inf for silence)
+double toLufs(double mean_square) {
+  return -0.691 + 10.0 * std::log10(mean_square);
+}
+
+/// Mean square whose loudness is `lufs`
+double fromLufs(double lufs) {
+  return std::pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+/// Mean of the values above both gates, or nullopt if none passes
+/// @param relative_gate_lu Second gate, relative to the mean of the values above the first
+std::optional<double> gatedMean(const std::vector<double>& values, double relative_gate_lu,
+                                std::vector<double>* passed = nullptr) {
+  const double absolute = fromLufs(LoudnessMeter::ABSOLUTE_GATE_LUFS);
+  double sum = 0.0;
+  size_t count = 0;
+  for (double value : values) {
+    if (value > absolute) {
+      sum += value;
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return std::nullopt;
+  }
+
+  const double relative =
+      sum / static_cast<double>(count) * std::pow(10.0, relative_gate_lu / 10.0);
+  sum = 0.0;
+  count = 0;
+  for (double value : values) {
+    if (value > absolute && value > relative) {
+      sum += value;
+      ++count;
+      if (passed != nullptr) {
+        passed->push_back(value);
+      }
+    }
+  }
+  if (count == 0) {
+    return std::nullopt;
+  }
+  return sum / static_cast<double>(count);
+}
+
+// ============================================================================
+// Four-lane arithmetic (one lane per channel of a group)
+// ============================================================================
+
+#if defined(ORPHEUS_LOUDNESS_SSE2)
+using Lanes = __m128;
+inline Lanes lanesLoad(const float* p) {
+  return _mm_loadu_ps(p);
+}
+inline void lanesStore(float* p, Lanes v) {
+  _mm_storeu_ps(p, v);
+}
+inline Lanes lanesSet(float value) {
+  return _mm_set1_ps(value);
+}
+inline Lanes lanesAdd(Lanes a, Lanes b) {
+  return _mm_add_ps(a, b);
+}
+inline Lanes lanesSub(Lanes a, Lanes b) {
+  return _mm_sub_ps(a, b);
+}
+inline Lanes lanesMul(Lanes a, Lanes b) {
+  return _mm_mul_ps(a, b);
+}
+#elif defined(ORPHEUS_LOUDNESS_NEON)
+using Lanes = float32x4_t;
+inline Lanes lanesLoad(const float* p) {
+  return vld1q_f32(p);
+}
+inline void lanesStore(float* p, Lanes v) {
+  vst1q_f32(p, v);
+}
+inline Lanes lanesSet(float value) {
+  return vdupq_n_f32(value);
+}
+inline Lanes lanesAdd(Lanes a, Lanes b) {
+  return vaddq_f32(a, b);
+}
+inline Lanes lanesSub(Lanes a, Lanes b) {
+  return vsubq_f32(a, b);
+}
+inline Lanes lanesMul(Lanes a, Lanes b) {
+  return vmulq_f32(a, b);
+}
+#else
+struct Lanes {
+  float v[4];
+};
+inline Lanes lanesLoad(const float* p) {
+  return {{p[0], p[1], p[2], p[3]}};
+}
+inline void lanesStore(float* p, Lanes a) {
+  std::copy(a.v, a.v + 4, p);
+}
+inline Lanes lanesSet(float value) {
+  return {{value, value, value, value}};
+}
+template <typename Op> inline Lanes lanesMap(Lanes a, Lanes b, Op op) {
+  return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+}
+inline Lanes lanesAdd(Lanes a, Lanes b) {
+  return lanesMap(a, b, [](float x, float y) { return x + y; });
+}
+inline Lanes lanesSub(Lanes a, Lanes b) {
+  return lanesMap(a, b, [](float x, float y) { return x - y; });
+}
+inline Lanes lanesMul(Lanes a, Lanes b) {
+  return lanesMap(a, b, [](float x, float y) { return x * y; });
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// LoudnessMeter
+// ============================================================================
+
+LoudnessMeter::LoudnessMeter(uint32_t sample_rate, uint16_t num_channels)
+    : m_num_channels(num_channels), m_num_groups((num_channels + 3u) / 4u),
+      m_step_frames(std::max<size_t>(1, (sample_rate + 5u) / 10u)) {
+  const double rate = static_cast<double>(std::max<uint32_t>(sample_rate, 1));
+
+  // Stage 1: high-shelf pre-filter (head acoustics), +4 dB above ~1.7 kHz
+  {
+    const double f0 = 1681.974450955533;
+    const double gain_db = 3.999843853973347;
+    const double q = 0.7071752369554196;
+    const double k = std::tan(PI * f0 / rate);
+    const double vh = std::pow(10.0, gain_db / 20.0);
+    const double vb = std::pow(vh, 0.4996667741545416);
+    const double a0 = 1.0 + k / q + k * k;
+    m_pre = {static_cast<float>((vh + vb * k / q + k * k) / a0),
+             static_cast<float>(2.0 * (k * k - vh) / a0),
+             static_cast<float>((vh - vb * k / q + k * k) / a0),
+             static_cast<float>(2.0 * (k * k - 1.0) / a0),
+             static_cast<float>((1.0 - k / q + k * k) / a0)};
+  }
+
+  // Stage 2: RLB high-pass at ~38 Hz
+  {
+    const double f0 = 38.13547087602444;
+    const double q = 0.5003270373238773;
+    const double k = std::tan(PI * f0 / rate);
+    const double a0 = 1.0 + k / q + k * k;
+    m_rlb = {1.0f, -2.0f, 1.0f, static_cast<float>(2.0 * (k * k - 1.0) / a0),
+             static_cast<float>((1.0 - k / q + k * k) / a0)};
+  }
+
+  m_state.assign(m_num_groups * 16, 0.0f);
+  m_step_sum.assign(m_num_groups * 4, 0.0);
+  m_weights.assign(m_num_groups * 4, 0.0);
+  for (uint16_t ch = 0; ch < num_channels; ++ch) {
+    m_weights[ch] = 1.0;
+  }
+  if (num_channels == 6) {
+    m_weights[3] = 0.0;  // LFE
+    m_weights[4] = 1.41; // Ls
+    m_weights[5] = 1.41; // Rs
+  }
+
+  m_sample_peak.assign(num_channels, 0.0f);
+  m_true_peak.assign(num_channels, 0.0f);
+  m_history.assign(size_t{num_channels} * (TAPS_PER_PHASE - 1), 0.0f);
+  m_scratch.resize(TAPS_PER_PHASE - 1 + m_step_frames);
+}
+
+void LoudnessMeter::process(const float* interleaved, size_t num_frames) {
+  if (interleaved == nullptr || m_num_channels == 0) {
+    return;
+  }
+  while (num_frames > 0) {
+    size_t run = std::min(num_frames, m_step_frames - m_step_fill);
+    processRun(interleaved, run);
+    interleaved += run * m_num_channels;
+    num_frames -= run;
+  }
+}
+
+void LoudnessMeter::processRun(const float* interleaved, size_t num_frames) {
+  for (size_t group = 0; group < m_num_groups; ++group) {
+    filterGroup(interleaved, num_frames, group);
+  }
+  for (uint16_t ch = 0; ch < m_num_channels; ++ch) {
+    measurePeaks(interleaved, num_frames, ch);
+  }
+
+  m_step_fill += num_frames;
+  if (m_step_fill < m_step_frames) {
+    return;
+  }
+
+  double weighted = 0.0;
+  for (size_t lane = 0; lane < m_step_sum.size(); ++lane) {
+    weighted += m_weights[lane] * m_step_sum[lane];
+  }
+  m_steps.push_back(weighted / static_cast<double>(m_step_frames));
+  std::fill(m_step_sum.begin(), m_step_sum.end(), 0.0);
+  m_step_fill = 0;
+
+  for (float& z : m_state) {
+    z = std::abs(z) < DENORMAL_FLUSH ? 0.0f : z;
+  }
+}
+
+void LoudnessMeter::filterGroup(const float* interleaved, size_t num_frames, size_t group) {
+  const size_t first = group * 4;
+  const size_t lanes = std::min<size_t>(4, m_num_channels - first);
+  const float* samples = interleaved + first;
+  float* state = m_state.data() + group * 16;
+
+  const Lanes pb0 = lanesSet(m_pre.b0), pb1 = lanesSet(m_pre.b1), pb2 = lanesSet(m_pre.b2);
+  const Lanes pa1 = lanesSet(m_pre.a1), pa2 = lanesSet(m_pre.a2);
+  const Lanes rb0 = lanesSet(m_rlb.b0), rb1 = lanesSet(m_rlb.b1), rb2 = lanesSet(m_rlb.b2);
+  const Lanes ra1 = lanesSet(m_rlb.a1), ra2 = lanesSet(m_rlb.a2);
+  Lanes z1a = lanesLoad(state);
+  Lanes z2a = lanesLoad(state + 4);
+  Lanes z1b = lanesLoad(state + 8);
+  Lanes z2b = lanesLoad(state + 12);
+
+  float padded[4] = {0.0f, 0.0f, 0.0f, 0.0f}; // Partial groups: unused lanes stay silent
+  for (size_t done = 0; done < num_frames;) {
+    size_t block = std::min(num_frames - done, SUM_FLUSH_FRAMES);
+    Lanes sum = lanesSet(0.0f);
+    for (size_t f = done; f < done + block; ++f) {
+      const float* frame = samples + f * m_num_channels;
+      Lanes x;
+      if (lanes == 4) {
+        x = lanesLoad(frame);
+      } else {
+        std::memcpy(padded, frame, lanes * sizeof(float));
+        x = lanesLoad(padded);
+      }
+
+      // Transposed direct form II, both stages
+      Lanes y1 = lanesAdd(lanesMul(pb0, x), z1a);
+      z1a = lanesAdd(lanesSub(lanesMul(pb1, x), lanesMul(pa1, y1)), z2a);
+      z2a = lanesSub(lanesMul(pb2, x), lanesMul(pa2, y1));
+      Lanes y2 = lanesAdd(lanesMul(rb0, y1), z1b);
+      z1b = lanesAdd(lanesSub(lanesMul(rb1, y1), lanesMul(ra1, y2)), z2b);
+      z2b = lanesSub(lanesMul(rb2, y1), lanesMul(ra2, y2));
+      sum = lanesAdd(sum, lanesMul(y2, y2));
+    }
+    float partial[4];
+    lanesStore(partial, sum);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      m_step_sum[first + lane] += partial[lane];
+    }
+    done += block;
+  }
+
+  lanesStore(state, z1a);
+  lanesStore(state + 4, z2a);
+  lanesStore(state + 8, z1b);
+  lanesStore(state + 12, z2b);
+}
+
+void LoudnessMeter::measurePeaks(const float* interleaved, size_t num_frames, uint16_t channel) {
+  constexpr size_t HISTORY = TAPS_PER_PHASE - 1;
+  float* history = m_history.data() + size_t{channel} * HISTORY;
+  float* x = m_scratch.data();
+  std::copy(history, history + HISTORY, x);
+  for (size_t f = 0; f < num_frames; ++f) {
+    x[HISTORY + f] = interleaved[f * m_num_channels + channel];
+  }
+
+  float& sample_peak = m_sample_peak[channel];
+  float& true_peak = m_true_peak[channel];
+  float previous_peak = 0.0f; // Peak of the frames the first block's taps reach back to
+  for (size_t f = 0; f < HISTORY; ++f) {
+    previous_peak = std::max(previous_peak, std::abs(x[f]));
+  }
+
+  for (size_t start = 0; start < num_frames; start += PEAK_BLOCK_FRAMES) {
+    const size_t end = std::min(num_frames, start + PEAK_BLOCK_FRAMES);
+    float peak = 0.0f;
+    for (size_t f = start; f < end; ++f) {
+      peak = std::max(peak, std::abs(x[HISTORY + f]));
+    }
+    sample_peak = std::max(sample_peak, peak);
+    true_peak = std::max(true_peak, peak);
+
+    // No interpolated value can exceed the taps' peak times the phase gain
+    if (std::max(peak, previous_peak) * TRUE_PEAK_MAX_GAIN > true_peak) {
+      for (size_t f = start; f < end; ++f) {
+        const float* newest = x + HISTORY + f;
+        for (const auto& phase : TRUE_PEAK_PHASES) {
+          float y = 0.0f;
+          for (size_t k = 0; k < TAPS_PER_PHASE; ++k) {
+            y += phase[k] * newest[-static_cast<ptrdiff_t>(k)];
+          }
+          true_peak = std::max(true_peak, std::abs(y));
+        }
+      }
+    }
+    previous_peak = peak;
+  }
+
+  std::copy(x + num_frames, x + num_frames + HISTORY, history);
+}
+
+ClipLoudness LoudnessMeter::result() const {
+  ClipLoudness result;
+  constexpr double NEG_INF = -std::numeric_limits<double>::infinity();
+
+  // Mean square of every window of `steps` consecutive steps (hop: one step)
+  auto windows = [this](size_t steps) {
+    std::vector<double> means;
+    for (size_t last = steps; last <= m_steps.size(); ++last) {
+      double sum = 0.0;
+      for (size_t s = last - steps; s < last; ++s) {
+        sum += m_steps[s];
+      }
+      means.push_back(sum / static_cast<double>(steps));
+    }
+    return means;
+  };
+
+  auto integrated = gatedMean(windows(BLOCK_STEPS), INTEGRATED_RELATIVE_GATE_LU);
+  result.integratedLufs = integrated ? toLufs(*integrated) : NEG_INF;
+
+  std::vector<double> short_term;
+  if (gatedMean(windows(SHORT_TERM_STEPS), RANGE_RELATIVE_GATE_LU, &short_term)) {
+    std::sort(short_term.begin(), short_term.end());
+    auto percentile = [&](double p) {
+      auto index = static_cast<size_t>(std::lround(p * static_cast<double>(short_term.size() - 1)));
+      return toLufs(short_term[index]);
+    };
+    result.loudnessRangeLu = percentile(0.95) - percentile(0.10);
+  }
+
+  float sample_peak = 0.0f;
+  float true_peak = 0.0f;
+  for (uint16_t ch = 0; ch < m_num_channels; ++ch) {
+    sample_peak = std::max(sample_peak, m_sample_peak[ch]);
+    true_peak = std::max(true_peak, m_true_peak[ch]);
+  }
+  result.samplePeakDbfs = 20.0 * std::log10(static_cast<double>(sample_peak));
+  result.truePeakDbtp = 20.0 * std::log10(static_cast<double>(true_peak));
+  return result;
+}
+
+// ============================================================================
+// Whole sources
+// ============================================================================
+
+std::optional<ClipLoudness> measureLoudness(const SampleSource& source,
+                                            const std::atomic<bool>& cancelled) {
+  const uint32_t sample_rate = source.metadata().sample_rate;
+  const uint16_t num_channels = source.numChannels();
+  if (source.numFrames() <= 0 || num_channels == 0 || sample_rate == 0) {
+    return std::nullopt;
+  }
+
+  LoudnessMeter meter(sample_rate, num_channels);
+  if (!source.isResident()) {
+    auto reader = source.openReader();
+    if (!reader) {
+      return std::nullopt;
+    }
+    std::vector<float> second(static_cast<size_t>(sample_rate) * num_channels);
+    for (;;) {
+      if (cancelled.load(std::memory_order_relaxed)) {
+        return std::nullopt;
+      }
+      auto ticket = sharedIoScheduler().acquire(IoClass::Background);
+      auto read = reader->readSamples(second.data(), sample_rate);
+      ticket.release();
+      if (!read.isOk()) {
+        return std::nullopt;
+      }
+      meter.process(second.data(), read.value);
+      if (read.value < sample_rate) {
+        return meter.result();
+      }
+    }
+  }
+
+  const auto total = static_cast<size_t>(source.numFrames());
+  for (size_t frame = 0; frame < total; frame += sample_rate) {
+    if (cancelled.load(std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    size_t frames = std::min<size_t>(sample_rate, total - frame);
+    meter.process(source.data() + frame * num_channels, frames);
+  }
+  return meter.result();
+}
+
+} // namespace orpheus
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/transport_controller.h> // ClipLoudness
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace orpheus {
+
+class SampleSource;
+
+/// Streaming EBU R128 / ITU-R BS.1770-4 loudness measurement
+///
+/// Frames are K-weighted (high-shelf pre-filter and RLB high-pass, with
+/// coefficients derived for the sample rate) and their mean square is kept per
+/// 100 ms step. Integrated loudness gates 400 ms blocks (75% overlap) at
+/// -70 LUFS and then -10 LU below the absolute-gated mean. Loudness range gates
+/// 3 s short-term windows at -70 LUFS and -20 LU and spans their 10th to 95th
+/// percentile (EBU Tech 3342).
+///
+/// True peak is the highest value of the 4x-oversampled signal (BS.1770-4 Annex 2
+/// interpolator). Stretches whose sample peak is too low for any interpolated
+/// value to exceed the true peak found so far are not oversampled.
+///
+/// Channels are filtered four at a time with SSE2/NEON. Six-channel audio is
+/// weighted as 5.1 (L R C LFE Ls Rs: LFE excluded, surrounds +1.5 dB); other
+/// layouts weight every channel equally.
+///
+/// Memory: 8 bytes per 100 ms of audio.
+class LoudnessMeter {
+public:
+  static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+  static constexpr double INTEGRATED_RELATIVE_GATE_LU = -10.0;
+  static constexpr double RANGE_RELATIVE_GATE_LU = -20.0;
+
+  /// Steps (100 ms) per gating block and per short-term window
+  static constexpr size_t BLOCK_STEPS = 4;
+  static constexpr size_t SHORT_TERM_STEPS = 30;
+
+  static constexpr size_t OVERSAMPLING = 4;
+  static constexpr size_t TAPS_PER_PHASE = 12;
+
+  /// @param sample_rate Sample rate in Hz (> 0)
+  /// @param num_channels Channels in the interleaved frames passed to process() (> 0)
+  LoudnessMeter(uint32_t sample_rate, uint16_t num_channels);
+
+  /// Add interleaved frames
+  void process(const float* interleaved, size_t num_frames);
+
+  /// Measurement of every frame processed so far (a trailing partial step is ignored)
+  ClipLoudness result() const;
+
+  /// Complete 100 ms steps processed
+  size_t numSteps() const {
+    return m_steps.size();
+  }
+
+private:
+  /// Second-order section (a0 normalised to 1)
+  struct Biquad {
+    float b0, b1, b2, a1, a2;
+  };
+
+  /// Filter a run of frames that ends at or before the current step boundary
+  void processRun(const float* interleaved, size_t num_frames);
+
+  /// K-weight and accumulate the squares of one group of up to four channels
+  void filterGroup(const float* interleaved, size_t num_frames, size_t group);
+
+  /// Sample and true peaks of one channel over a run
+  void measurePeaks(const float* interleaved, size_t num_frames, uint16_t channel);
+
+  uint16_t m_num_channels;
+  size_t m_num_groups; ///< Channel groups of four (last may be partial)
+  size_t m_step_frames;
+
+  Biquad m_pre;
+  Biquad m_rlb;
+  std::vector<float> m_state;   ///< [group][z1 pre, z2 pre, z1 rlb, z2 rlb][lane]
+  std::vector<double> m_weights; ///< [group * 4 + lane] (0 for padding lanes)
+
+  size_t m_step_fill = 0;         ///< Frames in the open step
+  std::vector<double> m_step_sum; ///< Sum of squares in the open step, [group * 4 + lane]
+  std::vector<double> m_steps;    ///< Weighted mean square of each complete step
+
+  std::vector<float> m_sample_peak; ///< Per channel
+  std::vector<float> m_true_peak;   ///< Per channel
+  std::vector<float> m_history;     ///< Last TAPS_PER_PHASE - 1 frames, [channel][frame]
+  std::vector<float> m_scratch;     ///< One channel of a run, preceded by its history
+};
+
+/// Measure a whole source (background thread)
+///
+/// Streamed sources are decoded from their file a second at a time, each read
+/// admitted as IoClass::Background by the shared IoScheduler.
+/// @param cancelled Checked between seconds of audio
+/// @return Measurement, or nullopt if cancelled or the source has no audio
+std::optional<ClipLoudness> measureLoudness(const SampleSource& source,
+                                            const std::atomic<bool>& cancelled);
+
+} // namespace orpheus
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace orpheus {
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+  auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) {
+    return nullptr;
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view) {
+    return nullptr;
+  }
+  mapped->m_data = static_cast<const uint8_t*>(view);
+  mapped->m_size = static_cast<size_t>(size.QuadPart);
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(info.st_size);
+  void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping keeps the file referenced
+  if (view == MAP_FAILED) {
+    return nullptr;
+  }
+  mapped->m_data = static_cast<const uint8_t*>(view);
+  mapped->m_size = size;
+#endif
+  return mapped;
+}
+
+bool MappedFile::lockInMemory() const {
+  if (!m_data) {
+    return false;
+  }
+#if defined(_WIN32)
+  return VirtualLock(const_cast<uint8_t*>(m_data), m_size) != 0;
+#else
+  auto* address = const_cast<uint8_t*>(m_data);
+  ::madvise(address, m_size, MADV_WILLNEED); // Read ahead even if locking is refused
+  return ::mlock(address, m_size) == 0;
+#endif
+}
+
+MappedFile::~MappedFile() {
+  if (!m_data) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(m_data);
+#else
+  ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+} // namespace orpheus
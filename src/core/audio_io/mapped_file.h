@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace orpheus {
+
+/// Read-only mapping of a whole file, unmapped on destruction
+///
+/// Backs DecodedAudioCache sidecars and PeakFile. The mapping stays valid after
+/// the file is removed or replaced on disk (POSIX); on Windows a mapped file
+/// cannot be removed until every mapping is released.
+class MappedFile {
+public:
+  /// Map a file
+  /// @return Mapping, or nullptr if the file is missing, empty or cannot be mapped
+  static std::shared_ptr<MappedFile> open(const std::filesystem::path& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// First byte of the file (page aligned)
+  const uint8_t* data() const {
+    return m_data;
+  }
+  size_t size() const {
+    return m_size;
+  }
+
+  /// Page the whole file in and pin it in RAM, so reads never fault to disk
+  /// @return true if pinned; false if the OS refused (e.g. over RLIMIT_MEMLOCK), in which
+  ///         case the pages were still read ahead but may be reclaimed under memory pressure
+  bool lockInMemory() const;
+
+private:
+  MappedFile() = default;
+
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+} // namespace orpheus
@@ -0,0 +1,678 @@
+// SPDX-License-Identifier: MIT
+#include "pcm_decode.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORPHEUS_PCM_SSE2 1
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ORPHEUS_PCM_AVX2 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define ORPHEUS_TARGET_AVX2
+#else
+#define ORPHEUS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ORPHEUS_PCM_NEON 1
+#endif
+
+namespace orpheus {
+
+namespace {
+
+constexpr float SCALE_16 = 1.0f / 32768.0f;
+constexpr float SCALE_24 = 1.0f / 8388608.0f;
+constexpr float SCALE_32 = 1.0f / 2147483648.0f;
+
+using KernelTable = std::array<PcmDecodeKernel, PCM_SAMPLE_FORMAT_COUNT>;
+
+constexpr size_t formatIndex(PcmSampleFormat format) {
+  return static_cast<size_t>(format);
+}
+
+// ============================================================================
+// Scalar kernels (reference implementation and tail handling)
+// ============================================================================
+
+inline uint32_t load32(const uint8_t* p, bool big_endian) {
+  if (big_endian) {
+    return (uint32_t{p[0]} << 24) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 8) | p[3];
+  }
+  return (uint32_t{p[3]} << 24) | (uint32_t{p[2]} << 16) | (uint32_t{p[1]} << 8) | p[0];
+}
+
+template <PcmSampleFormat F> inline float decodeOne(const uint8_t* p) {
+  if constexpr (F == PcmSampleFormat::Int16LE || F == PcmSampleFormat::Int16BE) {
+    constexpr bool be = F == PcmSampleFormat::Int16BE;
+    auto bits = static_cast<uint16_t>(be ? (p[0] << 8) | p[1] : (p[1] << 8) | p[0]);
+    return static_cast<float>(static_cast<int16_t>(bits)) * SCALE_16;
+  } else if constexpr (F == PcmSampleFormat::Int24LE || F == PcmSampleFormat::Int24BE) {
+    constexpr bool be = F == PcmSampleFormat::Int24BE;
+    uint32_t lo = be ? p[2] : p[0];
+    uint32_t mid = p[1];
+    uint32_t hi = be ? p[0] : p[2];
+    // Place in the top 24 bits, then arithmetic shift to sign-extend
+    auto value = static_cast<int32_t>((hi << 24) | (mid << 16) | (lo << 8)) >> 8;
+    return static_cast<float>(value) * SCALE_24;
+  } else if constexpr (F == PcmSampleFormat::Int32LE || F == PcmSampleFormat::Int32BE) {
+    auto value = static_cast<int32_t>(load32(p, F == PcmSampleFormat::Int32BE));
+    return static_cast<float>(value) * SCALE_32;
+  } else {
+    uint32_t bits = load32(p, F == PcmSampleFormat::Float32BE);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+}
+
+template <PcmSampleFormat F> constexpr size_t bytesOf() {
+  if constexpr (F == PcmSampleFormat::Int16LE || F == PcmSampleFormat::Int16BE) {
+    return 2;
+  } else if constexpr (F == PcmSampleFormat::Int24LE || F == PcmSampleFormat::Int24BE) {
+    return 3;
+  } else {
+    return 4;
+  }
+}
+
+template <PcmSampleFormat F> void decodeScalar(const uint8_t* src, float* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = decodeOne<F>(src + i * bytesOf<F>());
+  }
+}
+
+constexpr KernelTable SCALAR_KERNELS = {
+    decodeScalar<PcmSampleFormat::Int16LE>,   decodeScalar<PcmSampleFormat::Int16BE>,
+    decodeScalar<PcmSampleFormat::Int24LE>,   decodeScalar<PcmSampleFormat::Int24BE>,
+    decodeScalar<PcmSampleFormat::Int32LE>,   decodeScalar<PcmSampleFormat::Int32BE>,
+    decodeScalar<PcmSampleFormat::Float32LE>, decodeScalar<PcmSampleFormat::Float32BE>,
+};
+
+// ============================================================================
+// SSE2 kernels (x86 baseline)
+// ============================================================================
+
+#if defined(ORPHEUS_PCM_SSE2)
+
+inline __m128i byteSwap16Sse2(__m128i v) {
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+inline __m128i byteSwap32Sse2(__m128i v) {
+  v = byteSwap16Sse2(v);
+  return _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+}
+
+template <PcmSampleFormat F> void decodeInt16Sse2(const uint8_t* src, float* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(SCALE_16);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    if constexpr (F == PcmSampleFormat::Int16BE) {
+      v = byteSwap16Sse2(v);
+    }
+    // Duplicate each 16-bit sample into a 32-bit lane, arithmetic shift sign-extends
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  decodeScalar<F>(src + i * 2, dst + i, count - i);
+}
+
+template <PcmSampleFormat F> void decodeInt32Sse2(const uint8_t* src, float* dst, size_t count) {
+  const __m128 scale = _mm_set1_ps(SCALE_32);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    if constexpr (F == PcmSampleFormat::Int32BE) {
+      v = byteSwap32Sse2(v);
+    }
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+template <PcmSampleFormat F> void decodeFloat32Sse2(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    if constexpr (F == PcmSampleFormat::Float32BE) {
+      v = byteSwap32Sse2(v);
+    }
+    _mm_storeu_ps(dst + i, _mm_castsi128_ps(v));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+// Packed 24-bit needs a byte shuffle (SSSE3); SSE2 uses the scalar kernel
+constexpr KernelTable SSE2_KERNELS = {
+    decodeInt16Sse2<PcmSampleFormat::Int16LE>,     decodeInt16Sse2<PcmSampleFormat::Int16BE>,
+    decodeScalar<PcmSampleFormat::Int24LE>,        decodeScalar<PcmSampleFormat::Int24BE>,
+    decodeInt32Sse2<PcmSampleFormat::Int32LE>,     decodeInt32Sse2<PcmSampleFormat::Int32BE>,
+    decodeFloat32Sse2<PcmSampleFormat::Float32LE>, decodeFloat32Sse2<PcmSampleFormat::Float32BE>,
+};
+
+#endif
+
+// ============================================================================
+// AVX2 kernels (x86-64, selected at runtime)
+// ============================================================================
+
+#if defined(ORPHEUS_PCM_AVX2)
+
+ORPHEUS_TARGET_AVX2 inline __m256i byteSwap16Avx2(__m256i v) {
+  const __m256i mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0,
+                                        3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  return _mm256_shuffle_epi8(v, mask);
+}
+
+ORPHEUS_TARGET_AVX2 inline __m256i byteSwap32Avx2(__m256i v) {
+  const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2,
+                                        1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  return _mm256_shuffle_epi8(v, mask);
+}
+
+template <PcmSampleFormat F>
+ORPHEUS_TARGET_AVX2 void decodeInt16Avx2(const uint8_t* src, float* dst, size_t count) {
+  const __m256 scale = _mm256_set1_ps(SCALE_16);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+    if constexpr (F == PcmSampleFormat::Int16BE) {
+      v = byteSwap16Avx2(v);
+    }
+    __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+    __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+    _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+  }
+  decodeScalar<F>(src + i * 2, dst + i, count - i);
+}
+
+template <PcmSampleFormat F>
+ORPHEUS_TARGET_AVX2 void decodeInt24Avx2(const uint8_t* src, float* dst, size_t count) {
+  // Each 128-bit lane holds 4 packed samples (12 bytes); shuffle them into the
+  // top 24 bits of 32-bit lanes, then arithmetic shift to sign-extend
+  const __m256i mask =
+      F == PcmSampleFormat::Int24LE
+          ? _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1,
+                             3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11)
+          : _mm256_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, 2, 1, 0, -1,
+                             5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9);
+  const __m256 scale = _mm256_set1_ps(SCALE_24);
+  size_t i = 0;
+  // Second lane loads 16 bytes from sample 4, so keep 10 samples (30 bytes) in range
+  for (; i + 10 <= count; i += 8) {
+    const uint8_t* p = src + i * 3;
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(a), b, 1);
+    v = _mm256_srai_epi32(_mm256_shuffle_epi8(v, mask), 8);
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  decodeScalar<F>(src + i * 3, dst + i, count - i);
+}
+
+template <PcmSampleFormat F>
+ORPHEUS_TARGET_AVX2 void decodeInt32Avx2(const uint8_t* src, float* dst, size_t count) {
+  const __m256 scale = _mm256_set1_ps(SCALE_32);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+    if constexpr (F == PcmSampleFormat::Int32BE) {
+      v = byteSwap32Avx2(v);
+    }
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+template <PcmSampleFormat F>
+ORPHEUS_TARGET_AVX2 void decodeFloat32Avx2(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+    if constexpr (F == PcmSampleFormat::Float32BE) {
+      v = byteSwap32Avx2(v);
+    }
+    _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(v));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+constexpr KernelTable AVX2_KERNELS = {
+    decodeInt16Avx2<PcmSampleFormat::Int16LE>,     decodeInt16Avx2<PcmSampleFormat::Int16BE>,
+    decodeInt24Avx2<PcmSampleFormat::Int24LE>,     decodeInt24Avx2<PcmSampleFormat::Int24BE>,
+    decodeInt32Avx2<PcmSampleFormat::Int32LE>,     decodeInt32Avx2<PcmSampleFormat::Int32BE>,
+    decodeFloat32Avx2<PcmSampleFormat::Float32LE>, decodeFloat32Avx2<PcmSampleFormat::Float32BE>,
+};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+  __cpuid(info, 1);
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+    return false; // OS does not save YMM state
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+// ============================================================================
+// NEON kernels (ARM)
+// ============================================================================
+
+#if defined(ORPHEUS_PCM_NEON)
+
+template <PcmSampleFormat F> void decodeInt16Neon(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    uint8x16_t bytes = vld1q_u8(src + i * 2);
+    if constexpr (F == PcmSampleFormat::Int16BE) {
+      bytes = vrev16q_u8(bytes);
+    }
+    int16x8_t v = vreinterpretq_s16_u8(bytes);
+    int32x4_t lo = vmovl_s16(vget_low_s16(v));
+    int32x4_t hi = vmovl_s16(vget_high_s16(v));
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(lo), SCALE_16));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(hi), SCALE_16));
+  }
+  decodeScalar<F>(src + i * 2, dst + i, count - i);
+}
+
+inline void storeInt24Neon(uint8x8_t low, uint8x8_t mid, uint8x8_t high, float* dst) {
+  // Unsigned low 16 bits, sign-extended high byte shifted into bits 16-23
+  uint16x8_t lo16 = vorrq_u16(vmovl_u8(low), vshll_n_u8(mid, 8));
+  int16x8_t hi16 = vmovl_s8(vreinterpret_s8_u8(high));
+  int32x4_t a = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_low_s16(hi16)), 16),
+                          vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lo16))));
+  int32x4_t b = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_high_s16(hi16)), 16),
+                          vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lo16))));
+  vst1q_f32(dst, vmulq_n_f32(vcvtq_f32_s32(a), SCALE_24));
+  vst1q_f32(dst + 4, vmulq_n_f32(vcvtq_f32_s32(b), SCALE_24));
+}
+
+template <PcmSampleFormat F> void decodeInt24Neon(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    // De-interleave 16 packed samples into low/mid/high byte planes
+    uint8x16x3_t planes = vld3q_u8(src + i * 3);
+    uint8x16_t low = F == PcmSampleFormat::Int24LE ? planes.val[0] : planes.val[2];
+    uint8x16_t high = F == PcmSampleFormat::Int24LE ? planes.val[2] : planes.val[0];
+    storeInt24Neon(vget_low_u8(low), vget_low_u8(planes.val[1]), vget_low_u8(high), dst + i);
+    storeInt24Neon(vget_high_u8(low), vget_high_u8(planes.val[1]), vget_high_u8(high),
+                   dst + i + 8);
+  }
+  decodeScalar<F>(src + i * 3, dst + i, count - i);
+}
+
+template <PcmSampleFormat F> void decodeInt32Neon(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    uint8x16_t bytes = vld1q_u8(src + i * 4);
+    if constexpr (F == PcmSampleFormat::Int32BE) {
+      bytes = vrev32q_u8(bytes);
+    }
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(bytes)), SCALE_32));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+template <PcmSampleFormat F> void decodeFloat32Neon(const uint8_t* src, float* dst, size_t count) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    uint8x16_t bytes = vld1q_u8(src + i * 4);
+    if constexpr (F == PcmSampleFormat::Float32BE) {
+      bytes = vrev32q_u8(bytes);
+    }
+    vst1q_f32(dst + i, vreinterpretq_f32_u8(bytes));
+  }
+  decodeScalar<F>(src + i * 4, dst + i, count - i);
+}
+
+constexpr KernelTable NEON_KERNELS = {
+    decodeInt16Neon<PcmSampleFormat::Int16LE>,     decodeInt16Neon<PcmSampleFormat::Int16BE>,
+    decodeInt24Neon<PcmSampleFormat::Int24LE>,     decodeInt24Neon<PcmSampleFormat::Int24BE>,
+    decodeInt32Neon<PcmSampleFormat::Int32LE>,     decodeInt32Neon<PcmSampleFormat::Int32BE>,
+    decodeFloat32Neon<PcmSampleFormat::Float32LE>, decodeFloat32Neon<PcmSampleFormat::Float32BE>,
+};
+
+#endif
+
+const KernelTable* kernelsFor(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::Scalar:
+    return &SCALAR_KERNELS;
+#if defined(ORPHEUS_PCM_SSE2)
+  case SimdLevel::SSE2:
+    return &SSE2_KERNELS;
+#endif
+#if defined(ORPHEUS_PCM_AVX2)
+  case SimdLevel::AVX2:
+    return cpuHasAvx2() ? &AVX2_KERNELS : nullptr;
+#endif
+#if defined(ORPHEUS_PCM_NEON)
+  case SimdLevel::NEON:
+    return &NEON_KERNELS;
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+const KernelTable& activeKernels() {
+  // Resolved once on first use (thread-safe static initialization)
+  static const KernelTable* table = kernelsFor(detectSimdLevel());
+  return *table;
+}
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+size_t pcmBytesPerSample(PcmSampleFormat format) {
+  switch (format) {
+  case PcmSampleFormat::Int16LE:
+  case PcmSampleFormat::Int16BE:
+    return 2;
+  case PcmSampleFormat::Int24LE:
+  case PcmSampleFormat::Int24BE:
+    return 3;
+  default:
+    return 4;
+  }
+}
+
+const char* pcmFormatName(PcmSampleFormat format) {
+  switch (format) {
+  case PcmSampleFormat::Int16LE:
+    return "int16_le";
+  case PcmSampleFormat::Int16BE:
+    return "int16_be";
+  case PcmSampleFormat::Int24LE:
+    return "int24_le";
+  case PcmSampleFormat::Int24BE:
+    return "int24_be";
+  case PcmSampleFormat::Int32LE:
+    return "int32_le";
+  case PcmSampleFormat::Int32BE:
+    return "int32_be";
+  case PcmSampleFormat::Float32LE:
+    return "float32_le";
+  case PcmSampleFormat::Float32BE:
+    return "float32_be";
+  }
+  return "unknown";
+}
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::Scalar:
+    return "scalar";
+  case SimdLevel::SSE2:
+    return "sse2";
+  case SimdLevel::AVX2:
+    return "avx2";
+  case SimdLevel::NEON:
+    return "neon";
+  }
+  return "unknown";
+}
+
+SimdLevel detectSimdLevel() {
+#if defined(ORPHEUS_PCM_AVX2)
+  static const bool has_avx2 = cpuHasAvx2();
+  return has_avx2 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#elif defined(ORPHEUS_PCM_SSE2)
+  return SimdLevel::SSE2;
+#elif defined(ORPHEUS_PCM_NEON)
+  return SimdLevel::NEON;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+PcmDecodeKernel pcmDecodeKernel(PcmSampleFormat format) {
+  return activeKernels()[formatIndex(format)];
+}
+
+PcmDecodeKernel pcmDecodeKernel(PcmSampleFormat format, SimdLevel level) {
+  const KernelTable* table = kernelsFor(level);
+  return table ? (*table)[formatIndex(format)] : nullptr;
+}
+
+// ============================================================================
+// WAV / AIFF layout probing
+// ============================================================================
+
+namespace {
+
+uint32_t readU32(const uint8_t* p, bool big_endian) {
+  return load32(p, big_endian);
+}
+
+uint16_t readU16(const uint8_t* p, bool big_endian) {
+  return static_cast<uint16_t>(big_endian ? (p[0] << 8) | p[1] : (p[1] << 8) | p[0]);
+}
+
+bool readAt(std::ifstream& file, uint64_t offset, uint8_t* dst, size_t size) {
+  file.clear();
+  file.seekg(static_cast<std::streamoff>(offset));
+  file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(size));
+  return static_cast<size_t>(file.gcount()) == size;
+}
+
+std::optional<PcmSampleFormat> intFormat(uint16_t bits, bool big_endian) {
+  switch (bits) {
+  case 16:
+    return big_endian ? PcmSampleFormat::Int16BE : PcmSampleFormat::Int16LE;
+  case 24:
+    return big_endian ? PcmSampleFormat::Int24BE : PcmSampleFormat::Int24LE;
+  case 32:
+    return big_endian ? PcmSampleFormat::Int32BE : PcmSampleFormat::Int32LE;
+  default:
+    return std::nullopt; // 8-bit and odd sizes go through the generic decoder
+  }
+}
+
+/// 80-bit IEEE 754 extended (AIFF sample rate) to integer Hz
+uint32_t readExtendedRate(const uint8_t* p) {
+  int exponent = ((p[0] & 0x7F) << 8) | p[1];
+  uint64_t mantissa = 0;
+  for (int i = 0; i < 8; ++i) {
+    mantissa = (mantissa << 8) | p[2 + i];
+  }
+  double rate = std::ldexp(static_cast<double>(mantissa), exponent - 16383 - 63);
+  return rate > 0.0 && rate < 4294967295.0 ? static_cast<uint32_t>(std::lround(rate)) : 0;
+}
+
+std::optional<PcmFileLayout> probeWave(std::ifstream& file, uint64_t file_size, bool big_endian) {
+  std::optional<PcmSampleFormat> format;
+  uint16_t channels = 0;
+  uint32_t sample_rate = 0;
+  uint64_t data_offset = 0;
+  uint64_t data_size = 0;
+  bool have_data = false;
+
+  uint64_t pos = 12;
+  uint8_t header[8];
+  while (pos + 8 <= file_size && readAt(file, pos, header, 8)) {
+    uint64_t chunk_size = readU32(header + 4, big_endian);
+    uint64_t body = pos + 8;
+
+    if (std::memcmp(header, "fmt ", 4) == 0) {
+      uint8_t fmt[40] = {};
+      size_t fmt_size = static_cast<size_t>(std::min<uint64_t>(chunk_size, sizeof(fmt)));
+      if (fmt_size < 16 || !readAt(file, body, fmt, fmt_size)) {
+        return std::nullopt;
+      }
+      uint16_t tag = readU16(fmt, big_endian);
+      channels = readU16(fmt + 2, big_endian);
+      sample_rate = readU32(fmt + 4, big_endian);
+      uint16_t block_align = readU16(fmt + 12, big_endian);
+      uint16_t bits = readU16(fmt + 14, big_endian);
+
+      // WAVE_FORMAT_EXTENSIBLE: real tag in the first bytes of the sub-format GUID
+      if (tag == 0xFFFE && fmt_size >= 26) {
+        tag = readU16(fmt + 24, big_endian);
+      }
+
+      if (tag == 1) {
+        format = intFormat(bits, big_endian);
+      } else if (tag == 3 && bits == 32) {
+        format = big_endian ? PcmSampleFormat::Float32BE : PcmSampleFormat::Float32LE;
+      }
+      // Container size must match the packed sample size we decode
+      if (format && static_cast<size_t>(block_align) != pcmBytesPerSample(*format) * channels) {
+        return std::nullopt;
+      }
+    } else if (std::memcmp(header, "data", 4) == 0) {
+      data_offset = body;
+      data_size = std::min(chunk_size, file_size - body);
+      have_data = true;
+    }
+
+    if (format && have_data) {
+      break;
+    }
+    pos = body + chunk_size + (chunk_size & 1); // Chunks are word aligned
+  }
+
+  if (!format || !have_data || channels == 0) {
+    return std::nullopt;
+  }
+
+  PcmFileLayout layout{*format, channels, sample_rate, data_offset, 0};
+  layout.num_frames = static_cast<int64_t>(data_size / layout.bytesPerFrame());
+  return layout;
+}
+
+std::optional<PcmFileLayout> probeAiff(std::ifstream& file, uint64_t file_size, bool aifc) {
+  std::optional<PcmSampleFormat> format;
+  uint16_t channels = 0;
+  uint32_t sample_rate = 0;
+  uint64_t comm_frames = 0;
+  uint64_t data_offset = 0;
+  uint64_t data_size = 0;
+  bool have_comm = false;
+  bool have_data = false;
+
+  uint64_t pos = 12;
+  uint8_t header[8];
+  while (pos + 8 <= file_size && readAt(file, pos, header, 8)) {
+    uint64_t chunk_size = readU32(header + 4, true);
+    uint64_t body = pos + 8;
+
+    if (std::memcmp(header, "COMM", 4) == 0) {
+      uint8_t comm[22] = {};
+      size_t need = aifc ? 22 : 18;
+      if (chunk_size < need || !readAt(file, body, comm, need)) {
+        return std::nullopt;
+      }
+      channels = readU16(comm, true);
+      comm_frames = readU32(comm + 2, true);
+      uint16_t bits = readU16(comm + 6, true);
+      sample_rate = readExtendedRate(comm + 8);
+
+      const uint8_t* compression = comm + 18;
+      if (!aifc || std::memcmp(compression, "NONE", 4) == 0 ||
+          std::memcmp(compression, "twos", 4) == 0) {
+        format = intFormat(bits, true);
+      } else if (std::memcmp(compression, "sowt", 4) == 0) {
+        format = intFormat(bits, false);
+      } else if ((std::memcmp(compression, "fl32", 4) == 0 ||
+                  std::memcmp(compression, "FL32", 4) == 0) &&
+                 bits == 32) {
+        format = PcmSampleFormat::Float32BE;
+      }
+      have_comm = true;
+    } else if (std::memcmp(header, "SSND", 4) == 0) {
+      uint8_t ssnd[8];
+      if (chunk_size < 8 || !readAt(file, body, ssnd, 8)) {
+        return std::nullopt;
+      }
+      uint64_t offset = readU32(ssnd, true);
+      data_offset = body + 8 + offset;
+      if (data_offset > file_size || chunk_size < 8 + offset) {
+        return std::nullopt;
+      }
+      data_size = std::min(chunk_size - 8 - offset, file_size - data_offset);
+      have_data = true;
+    }
+
+    if (have_comm && have_data) {
+      break;
+    }
+    pos = body + chunk_size + (chunk_size & 1);
+  }
+
+  if (!format || !have_data || channels == 0) {
+    return std::nullopt;
+  }
+
+  PcmFileLayout layout{*format, channels, sample_rate, data_offset, 0};
+  layout.num_frames = static_cast<int64_t>(std::min(comm_frames, data_size / layout.bytesPerFrame()));
+  return layout;
+}
+
+} // namespace
+
+std::optional<PcmFileLayout> probePcmFileLayout(const std::string& file_path) {
+  std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::nullopt;
+  }
+  auto end = file.tellg();
+  if (end < 12) {
+    return std::nullopt;
+  }
+  auto file_size = static_cast<uint64_t>(end);
+
+  uint8_t header[12];
+  if (!readAt(file, 0, header, sizeof(header))) {
+    return std::nullopt;
+  }
+
+  bool riff = std::memcmp(header, "RIFF", 4) == 0;
+  bool rifx = std::memcmp(header, "RIFX", 4) == 0;
+  if ((riff || rifx) && std::memcmp(header + 8, "WAVE", 4) == 0) {
+    return probeWave(file, file_size, rifx);
+  }
+
+  if (std::memcmp(header, "FORM", 4) == 0) {
+    if (std::memcmp(header + 8, "AIFF", 4) == 0) {
+      return probeAiff(file, file_size, false);
+    }
+    if (std::memcmp(header + 8, "AIFC", 4) == 0) {
+      return probeAiff(file, file_size, true);
+    }
+  }
+
+  return std::nullopt; // RF64, W64, FLAC, ... use the generic decoder
+}
+
+} // namespace orpheus
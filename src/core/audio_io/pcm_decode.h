@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace orpheus {
+
+/// Uncompressed PCM sample encodings decoded natively (no libsndfile per-sample path)
+enum class PcmSampleFormat : uint8_t {
+  Int16LE,
+  Int16BE,
+  Int24LE, ///< Packed, 3 bytes per sample
+  Int24BE, ///< Packed, 3 bytes per sample
+  Int32LE,
+  Int32BE,
+  Float32LE,
+  Float32BE,
+};
+
+constexpr size_t PCM_SAMPLE_FORMAT_COUNT = 8;
+
+/// Instruction set a decode kernel was built for
+enum class SimdLevel : uint8_t { Scalar, SSE2, AVX2, NEON };
+
+/// Convert `count` samples of raw PCM to float in [-1, 1)
+///
+/// Integer scaling matches libsndfile's sf_readf_float() (1 / 2^(bits-1)).
+/// `src` needs no particular alignment.
+using PcmDecodeKernel = void (*)(const uint8_t* src, float* dst, size_t count);
+
+/// Bytes per sample for a format (2, 3 or 4)
+size_t pcmBytesPerSample(PcmSampleFormat format);
+
+/// Human-readable format name (e.g. "int24_le")
+const char* pcmFormatName(PcmSampleFormat format);
+
+/// Human-readable instruction set name (e.g. "avx2")
+const char* simdLevelName(SimdLevel level);
+
+/// Best instruction set supported by this CPU (detected once)
+SimdLevel detectSimdLevel();
+
+/// Decode kernel for the running CPU (resolved once, then a table lookup)
+PcmDecodeKernel pcmDecodeKernel(PcmSampleFormat format);
+
+/// Decode kernel built for a specific instruction set
+/// @return Kernel, or nullptr if not built for this target or unsupported by the CPU
+/// @note Used by tests and benchmarks to compare implementations
+PcmDecodeKernel pcmDecodeKernel(PcmSampleFormat format, SimdLevel level);
+
+/// Convert raw PCM to float with the kernel for the running CPU
+inline void decodePcm(PcmSampleFormat format, const void* src, float* dst, size_t count) {
+  pcmDecodeKernel(format)(static_cast<const uint8_t*>(src), dst, count);
+}
+
+/// Location and encoding of the sample data in an uncompressed WAV/AIFF file
+struct PcmFileLayout {
+  PcmSampleFormat format;
+  uint16_t num_channels;
+  uint32_t sample_rate;
+  uint64_t data_offset; ///< Byte offset of frame 0
+  int64_t num_frames;   ///< Complete frames present in the data chunk
+
+  size_t bytesPerFrame() const {
+    return pcmBytesPerSample(format) * num_channels;
+  }
+};
+
+/// Parse RIFF/RIFX WAVE and AIFF/AIFC headers for natively decodable PCM
+/// @param file_path Path to audio file
+/// @return Layout, or std::nullopt for other formats/encodings (use the generic decoder)
+/// @note Reads headers only; call from a background/UI thread
+std::optional<PcmFileLayout> probePcmFileLayout(const std::string& file_path);
+
+} // namespace orpheus
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MIT
+#include "pcm_stream_set.h"
+
+#include <algorithm>
+
+namespace orpheus {
+
+PcmStreamSet::PcmStreamSet(std::unique_ptr<BlockReader> reader, IoScheduler* scheduler)
+    : m_reader(std::move(reader)), m_scheduler(scheduler) {
+  m_reads.reserve(m_reader->maxBatch());
+  m_read_streams.reserve(m_reader->maxBatch());
+}
+
+PcmStreamSet::~PcmStreamSet() = default;
+
+std::optional<size_t> PcmStreamSet::open(const std::string& path) {
+  auto closed = std::find_if(m_streams.begin(), m_streams.end(),
+                             [](const Stream& stream) { return !stream.open; });
+  if (closed == m_streams.end() && m_streams.size() >= m_reader->maxBatch()) {
+    return std::nullopt;
+  }
+  auto layout = probePcmFileLayout(path);
+  if (!layout || layout->bytesPerFrame() > m_reader->maxReadBytes()) {
+    return std::nullopt;
+  }
+  auto file = m_reader->openFile(path);
+  if (!file) {
+    return std::nullopt;
+  }
+
+  Stream stream{*file, *layout, 0, true};
+  if (closed != m_streams.end()) {
+    *closed = stream;
+    return static_cast<size_t>(closed - m_streams.begin());
+  }
+  m_streams.push_back(stream);
+  return m_streams.size() - 1;
+}
+
+void PcmStreamSet::close(size_t stream) {
+  if (stream < m_streams.size() && m_streams[stream].open) {
+    m_reader->closeFile(m_streams[stream].file);
+    m_streams[stream].open = false;
+  }
+}
+
+const PcmFileLayout* PcmStreamSet::layout(size_t stream) const {
+  return stream < m_streams.size() && m_streams[stream].open ? &m_streams[stream].layout
+                                                             : nullptr;
+}
+
+bool PcmStreamSet::seek(size_t stream, int64_t frame) {
+  if (stream >= m_streams.size() || !m_streams[stream].open) {
+    return false;
+  }
+  m_streams[stream].position = std::clamp<int64_t>(frame, 0, m_streams[stream].layout.num_frames);
+  return true;
+}
+
+int64_t PcmStreamSet::position(size_t stream) const {
+  return stream < m_streams.size() && m_streams[stream].open ? m_streams[stream].position : -1;
+}
+
+size_t PcmStreamSet::maxFramesPerRead(size_t stream) const {
+  const auto* found = layout(stream);
+  return found ? m_reader->maxReadBytes() / found->bytesPerFrame() : 0;
+}
+
+bool PcmStreamSet::readNext(size_t frames, std::span<float* const> outputs,
+                            std::span<int64_t> frames_read,
+                            IoScheduler::Clock::time_point deadline) {
+  m_frames.assign(m_streams.size(), frames);
+  return readNext(m_frames, outputs, frames_read, deadline);
+}
+
+bool PcmStreamSet::readNext(std::span<const size_t> frames, std::span<float* const> outputs,
+                            std::span<int64_t> frames_read,
+                            IoScheduler::Clock::time_point deadline) {
+  if (frames.size() < m_streams.size() || outputs.size() < m_streams.size() ||
+      frames_read.size() < m_streams.size()) {
+    return false;
+  }
+
+  m_reads.clear();
+  m_read_streams.clear();
+  for (size_t i = 0; i < m_streams.size(); ++i) {
+    frames_read[i] = 0;
+    const auto& stream = m_streams[i];
+    if (!stream.open) {
+      continue;
+    }
+    const auto remaining = static_cast<size_t>(stream.layout.num_frames - stream.position);
+    const size_t count = std::min({frames[i], maxFramesPerRead(i), remaining});
+    if (count == 0) {
+      continue;
+    }
+    const size_t bytes_per_frame = stream.layout.bytesPerFrame();
+    BlockRead read;
+    read.file = stream.file;
+    read.offset = stream.layout.data_offset + static_cast<uint64_t>(stream.position) *
+                                                  bytes_per_frame;
+    read.length = count * bytes_per_frame;
+    m_reads.push_back(read);
+    m_read_streams.push_back(i);
+  }
+  if (m_reads.empty()) {
+    return true;
+  }
+
+  IoScheduler::Ticket ticket;
+  if (m_scheduler) {
+    ticket = m_scheduler->acquire(IoClass::Playback, deadline);
+  }
+  m_reader->readBatch(m_reads); // Requests are valid by construction
+  ticket.release();
+
+  for (size_t r = 0; r < m_reads.size(); ++r) {
+    const auto& read = m_reads[r];
+    const size_t index = m_read_streams[r];
+    auto& stream = m_streams[index];
+    if (read.result < 0) {
+      frames_read[index] = read.result;
+      continue;
+    }
+    // A file truncated since it was probed yields fewer frames
+    const size_t count = static_cast<size_t>(read.result) / stream.layout.bytesPerFrame();
+    decodePcm(stream.layout.format, read.data, outputs[index], count * stream.layout.num_channels);
+    stream.position += static_cast<int64_t>(count);
+    frames_read[index] = static_cast<int64_t>(count);
+  }
+  return true;
+}
+
+} // namespace orpheus
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "block_reader.h"
+#include "io_scheduler.h"
+#include "pcm_decode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+/// Lockstep disk streaming of many uncompressed PCM files
+///
+/// readNext() fetches the next block of every open stream with one BlockReader
+/// batch (a single io_uring submission where available) and decodes it to
+/// interleaved float with the native PCM kernels, so a prefetch thread refills
+/// all streaming voices at once instead of blocking on each file in turn.
+///
+/// With an IoScheduler, each batch is issued as a Playback read with the
+/// deadline passed to readNext() (usually IoScheduler::playbackDeadline() of
+/// the least-buffered voice), ahead of analysis reads sharing the disk.
+///
+/// Thread Safety: use from one thread, like the BlockReader it owns.
+class PcmStreamSet {
+public:
+  /// @param reader Reader for the streams; at most reader->maxBatch() can be open at once
+  /// @param scheduler Scheduler to admit batches through (e.g. &sharedIoScheduler()), or nullptr
+  explicit PcmStreamSet(std::unique_ptr<BlockReader> reader, IoScheduler* scheduler = nullptr);
+  ~PcmStreamSet();
+
+  PcmStreamSet(const PcmStreamSet&) = delete;
+  PcmStreamSet& operator=(const PcmStreamSet&) = delete;
+
+  /// Open a WAV/AIFF file at frame 0
+  /// @return Stream index, or nullopt if the file is not natively decodable PCM, cannot be
+  ///         opened, or every stream is in use
+  std::optional<size_t> open(const std::string& path);
+
+  void close(size_t stream);
+
+  /// Layout of an open stream, or nullptr
+  const PcmFileLayout* layout(size_t stream) const;
+
+  /// Move the next read to a frame (clamped to the file's length)
+  /// @return false if the stream is not open
+  bool seek(size_t stream, int64_t frame);
+
+  /// Next frame to be read, or -1 if the stream is not open
+  int64_t position(size_t stream) const;
+
+  /// Most frames one read of a stream can return (bounded by the reader's maxReadBytes())
+  size_t maxFramesPerRead(size_t stream) const;
+
+  /// Stream indices in use are below this
+  size_t streamSlots() const {
+    return m_streams.size();
+  }
+
+  /// Read and decode up to `frames` frames from every open stream in one batch
+  /// @param outputs Per stream index: interleaved floats for frames * channels (closed ignored)
+  /// @param frames_read Per stream index: frames decoded (0 at end of file or if closed), or
+  ///        -errno if the read failed (position unchanged)
+  /// @param deadline When the first voice underruns without this batch
+  /// @return false if either span is shorter than streamSlots()
+  bool readNext(size_t frames, std::span<float* const> outputs, std::span<int64_t> frames_read,
+                IoScheduler::Clock::time_point deadline = IoScheduler::BEST_EFFORT);
+
+  /// readNext() with a frame count per stream index (0 skips the stream this batch)
+  /// @return false if any span is shorter than streamSlots()
+  bool readNext(std::span<const size_t> frames, std::span<float* const> outputs,
+                std::span<int64_t> frames_read,
+                IoScheduler::Clock::time_point deadline = IoScheduler::BEST_EFFORT);
+
+  BlockReader& reader() {
+    return *m_reader;
+  }
+
+private:
+  struct Stream {
+    uint32_t file;
+    PcmFileLayout layout;
+    int64_t position;
+    bool open;
+  };
+
+  std::unique_ptr<BlockReader> m_reader;
+  IoScheduler* m_scheduler;
+  std::vector<Stream> m_streams;
+  std::vector<BlockRead> m_reads;     ///< Batch (reused)
+  std::vector<size_t> m_read_streams; ///< Stream of each batch entry (reused)
+  std::vector<size_t> m_frames;       ///< Uniform frame counts of readNext(size_t) (reused)
+};
+
+} // namespace orpheus
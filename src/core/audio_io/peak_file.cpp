@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+#include "peak_file.h"
+
+#include "file_fingerprint.h"
+#include "mapped_file.h"
+#include "temp_path.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace orpheus {
+
+namespace {
+
+constexpr std::array<char, 8> PEAK_MAGIC = {'O', 'R', 'P', 'P', 'E', 'A', 'K', 'S'};
+constexpr uint32_t PEAK_BYTE_ORDER = 0x01020304; // Written in native order
+constexpr float QUANTISE_SCALE = 32767.0f;
+
+/// Fixed peak file header; the level table follows immediately
+struct PeakHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t byte_order;
+  uint16_t num_channels;
+  uint16_t num_levels;
+  uint32_t sample_rate;
+  int64_t num_frames;
+  uint64_t source_size;
+  char source_sha256[64];
+  uint8_t reserved[24];
+};
+
+static_assert(sizeof(PeakHeader) == 128, "Peak file header layout must stay 128 bytes");
+
+/// Level table entry, one per channel per level
+struct LevelEntry {
+  uint32_t bucket_frames;
+  uint32_t reserved;
+  uint64_t num_buckets;
+  uint64_t pairs_offset; ///< Byte offset of num_buckets int16 min/max pairs
+  uint64_t rms_offset;   ///< Byte offset of num_buckets int16 RMS values
+};
+
+static_assert(sizeof(LevelEntry) == 32, "Peak file level entry layout must stay 32 bytes");
+
+uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+uint64_t expectedBuckets(int64_t num_frames, uint32_t bucket_frames) {
+  return (static_cast<uint64_t>(num_frames) + bucket_frames - 1) / bucket_frames;
+}
+
+/// Offset of the first data block (after header, level table and channel peaks)
+uint64_t dataOffset(uint16_t num_channels) {
+  uint64_t table = sizeof(PeakHeader) +
+                   static_cast<uint64_t>(num_channels) * WaveformPyramid::NUM_LEVELS *
+                       sizeof(LevelEntry);
+  return alignUp(table + num_channels * sizeof(float), 8);
+}
+
+} // namespace
+
+int16_t PeakFile::quantiseDown(float value) {
+  return static_cast<int16_t>(std::clamp(std::floor(value * QUANTISE_SCALE), -QUANTISE_SCALE,
+                                         QUANTISE_SCALE));
+}
+
+int16_t PeakFile::quantiseUp(float value) {
+  return static_cast<int16_t>(std::clamp(std::ceil(value * QUANTISE_SCALE), -QUANTISE_SCALE,
+                                         QUANTISE_SCALE));
+}
+
+std::filesystem::path PeakFile::pathFor(const std::string& audio_path,
+                                        const FileFingerprint& source,
+                                        const std::filesystem::path& directory) {
+  if (directory.empty()) {
+    return std::filesystem::path(audio_path + EXTENSION);
+  }
+  return directory / (source.sha256 + EXTENSION);
+}
+
+bool PeakFile::write(const std::filesystem::path& path, const WaveformPyramid& pyramid,
+                     const FileFingerprint& source, uint32_t sample_rate) {
+  if (!pyramid.isFinished() || source.sha256.size() != sizeof(PeakHeader::source_sha256)) {
+    return false;
+  }
+  const uint16_t num_channels = pyramid.numChannels();
+
+  PeakHeader header{};
+  header.magic = PEAK_MAGIC;
+  header.version = FORMAT_VERSION;
+  header.byte_order = PEAK_BYTE_ORDER;
+  header.num_channels = num_channels;
+  header.num_levels = static_cast<uint16_t>(WaveformPyramid::NUM_LEVELS);
+  header.sample_rate = sample_rate;
+  header.num_frames = pyramid.numFrames();
+  header.source_size = source.size;
+  std::memcpy(header.source_sha256, source.sha256.data(), sizeof(header.source_sha256));
+
+  // Lay out [channel][level] blocks: min/max pairs, then RMS, each 8-byte aligned
+  std::vector<LevelEntry> table;
+  uint64_t offset = dataOffset(num_channels);
+  for (uint16_t ch = 0; ch < num_channels; ++ch) {
+    for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+      LevelEntry entry{};
+      entry.bucket_frames = WaveformPyramid::LEVEL_BUCKET_FRAMES[level];
+      entry.num_buckets = pyramid.numBuckets(level);
+      entry.pairs_offset = offset;
+      entry.rms_offset = alignUp(offset + entry.num_buckets * 2 * sizeof(int16_t), 8);
+      offset = alignUp(entry.rms_offset + entry.num_buckets * sizeof(int16_t), 8);
+      table.push_back(entry);
+    }
+  }
+
+  std::error_code ec;
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+
+  // Write under a unique temporary name, then rename so readers never map a partial file
+  auto temp_path = uniqueTempPath(path);
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    auto pad_to = [&file](uint64_t target) {
+      static const char zeros[8] = {};
+      auto position = static_cast<uint64_t>(file.tellp());
+      if (target > position) {
+        file.write(zeros, static_cast<std::streamsize>(target - position));
+      }
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()),
+               static_cast<std::streamsize>(table.size() * sizeof(LevelEntry)));
+    for (uint16_t ch = 0; ch < num_channels; ++ch) {
+      float peak = pyramid.peakLevel(ch);
+      file.write(reinterpret_cast<const char*>(&peak), sizeof(peak));
+    }
+
+    std::vector<int16_t> pairs;
+    std::vector<int16_t> rms;
+    for (uint16_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+        const auto& entry = table[ch * WaveformPyramid::NUM_LEVELS + level];
+        pairs.resize(entry.num_buckets * 2);
+        rms.resize(entry.num_buckets);
+        for (size_t b = 0; b < entry.num_buckets; ++b) {
+          const auto& summary = pyramid.bucket(level, b, ch);
+          pairs[b * 2] = quantiseDown(summary.min);
+          pairs[b * 2 + 1] = quantiseUp(summary.max);
+          rms[b] = quantiseUp(summary.rms);
+        }
+        pad_to(entry.pairs_offset);
+        file.write(reinterpret_cast<const char*>(pairs.data()),
+                   static_cast<std::streamsize>(pairs.size() * sizeof(int16_t)));
+        pad_to(entry.rms_offset);
+        file.write(reinterpret_cast<const char*>(rms.data()),
+                   static_cast<std::streamsize>(rms.size() * sizeof(int16_t)));
+      }
+    }
+    pad_to(offset);
+
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<const PeakFile> PeakFile::open(const std::filesystem::path& path,
+                                               const FileFingerprint& source) {
+  auto mapped = MappedFile::open(path);
+  if (!mapped || mapped->size() < sizeof(PeakHeader)) {
+    return nullptr;
+  }
+  const uint64_t file_size = mapped->size();
+
+  PeakHeader header;
+  std::memcpy(&header, mapped->data(), sizeof(header));
+  if (header.magic != PEAK_MAGIC || header.version != FORMAT_VERSION ||
+      header.byte_order != PEAK_BYTE_ORDER || header.num_channels == 0 ||
+      header.num_levels != WaveformPyramid::NUM_LEVELS || header.num_frames < 0) {
+    return nullptr;
+  }
+
+  // Stale: built from different content than the audio file now holds
+  if (header.source_size != source.size ||
+      source.sha256.compare(0, std::string::npos, header.source_sha256,
+                            sizeof(header.source_sha256)) != 0) {
+    return nullptr;
+  }
+
+  if (dataOffset(header.num_channels) > file_size) {
+    return nullptr;
+  }
+
+  auto peak_file = std::shared_ptr<PeakFile>(new PeakFile());
+  peak_file->m_num_channels = header.num_channels;
+  peak_file->m_num_frames = header.num_frames;
+  peak_file->m_sample_rate = header.sample_rate;
+  peak_file->m_levels.resize(static_cast<size_t>(header.num_channels) *
+                             WaveformPyramid::NUM_LEVELS);
+
+  const uint8_t* base = mapped->data();
+  for (uint16_t ch = 0; ch < header.num_channels; ++ch) {
+    for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+      size_t index = ch * WaveformPyramid::NUM_LEVELS + level;
+      LevelEntry entry;
+      std::memcpy(&entry, base + sizeof(PeakHeader) + index * sizeof(LevelEntry), sizeof(entry));
+
+      uint32_t bucket_frames = WaveformPyramid::LEVEL_BUCKET_FRAMES[level];
+      if (entry.bucket_frames != bucket_frames ||
+          entry.num_buckets != expectedBuckets(header.num_frames, bucket_frames) ||
+          entry.num_buckets > file_size || entry.pairs_offset % 2 != 0 ||
+          entry.rms_offset % 2 != 0 ||
+          entry.pairs_offset > file_size ||
+          entry.num_buckets * 2 * sizeof(int16_t) > file_size - entry.pairs_offset ||
+          entry.rms_offset > file_size ||
+          entry.num_buckets * sizeof(int16_t) > file_size - entry.rms_offset) {
+        return nullptr; // Truncated or foreign file
+      }
+
+      peak_file->m_num_buckets[level] = static_cast<size_t>(entry.num_buckets);
+      // Mappings are page aligned and offsets even, so the int16 data is aligned
+      peak_file->m_levels[index] = {
+          reinterpret_cast<const int16_t*>(base + entry.pairs_offset),
+          reinterpret_cast<const int16_t*>(base + entry.rms_offset)};
+    }
+  }
+
+  peak_file->m_peaks.resize(header.num_channels);
+  std::memcpy(peak_file->m_peaks.data(),
+              base + sizeof(PeakHeader) + peak_file->m_levels.size() * sizeof(LevelEntry),
+              header.num_channels * sizeof(float));
+
+  peak_file->m_file = std::move(mapped);
+  return peak_file;
+}
+
+WaveformBucket PeakFile::bucket(size_t level, size_t index, uint32_t channel) const {
+  const auto& data = m_levels[channel * WaveformPyramid::NUM_LEVELS + level];
+  return {static_cast<float>(data.pairs[index * 2]) / QUANTISE_SCALE,
+          static_cast<float>(data.pairs[index * 2 + 1]) / QUANTISE_SCALE,
+          static_cast<float>(data.rms[index]) / QUANTISE_SCALE};
+}
+
+WaveformData PeakFile::query(int64_t start_sample, int64_t end_sample, uint32_t pixel_width,
+                             uint32_t channel) const {
+  return WaveformPyramid::queryLevels(
+      m_num_frames, m_num_channels, m_num_buckets, start_sample, end_sample, pixel_width, channel,
+      0, pixel_width, [&](size_t level, size_t index) { return bucket(level, index, channel); });
+}
+
+float PeakFile::peakLevel(uint32_t channel) const {
+  return channel < m_num_channels ? m_peaks[channel] : 0.0f;
+}
+
+size_t PeakFile::mappedBytes() const {
+  return m_file ? m_file->size() : 0;
+}
+
+} // namespace orpheus
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "waveform_pyramid.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+struct FileFingerprint;
+class MappedFile;
+
+/// Memory-mapped `.orppeaks` file: a WaveformPyramid persisted next to its audio
+///
+/// Layout (native byte order, recorded in the header):
+/// - 128-byte header: magic, format version, channel/level counts, sample rate,
+///   frame count, and the size and SHA-256 of the audio file it was built from
+/// - Level table: one entry per channel per level (bucket size, bucket count,
+///   data offsets), followed by the absolute peak of each channel
+/// - Per channel and level: interleaved int16 min/max pairs, then int16 RMS
+///
+/// Samples are quantised to int16 with min rounded down and max/RMS rounded up,
+/// so a pixel's envelope never shrinks (values beyond +/-1.0 are clipped).
+/// Opening maps the file read-only; queries dequantise only the buckets they
+/// touch, so a reopened show displays every waveform without decoding.
+///
+/// Thread Safety: immutable once opened; query from any thread.
+class PeakFile {
+public:
+  static constexpr uint32_t FORMAT_VERSION = 1;
+  static constexpr const char* EXTENSION = ".orppeaks";
+
+  /// Peak file location for an audio file
+  /// @param directory Cache directory (`<sha256>.orppeaks` inside it); empty stores
+  ///                  `<audio file>.orppeaks` next to the audio
+  static std::filesystem::path pathFor(const std::string& audio_path,
+                                       const FileFingerprint& source,
+                                       const std::filesystem::path& directory = {});
+
+  /// Write a finished pyramid (atomically, via a temporary file and rename)
+  /// @param source Fingerprint of the audio the pyramid was built from
+  /// @return false if the pyramid is unfinished or writing failed
+  static bool write(const std::filesystem::path& path, const WaveformPyramid& pyramid,
+                    const FileFingerprint& source, uint32_t sample_rate);
+
+  /// Quantise a sample value to int16 units of 1/32767, rounding down (clipped to +/-1.0)
+  static int16_t quantiseDown(float value);
+
+  /// Quantise a sample value to int16 units of 1/32767, rounding up (clipped to +/-1.0)
+  static int16_t quantiseUp(float value);
+
+  /// Map a peak file
+  /// @param source Current fingerprint of the audio; a file built from other content is stale
+  /// @return Peak file, or nullptr if missing, stale, from another format version, or corrupt
+  static std::shared_ptr<const PeakFile> open(const std::filesystem::path& path,
+                                              const FileFingerprint& source);
+
+  uint16_t numChannels() const {
+    return m_num_channels;
+  }
+  int64_t numFrames() const {
+    return m_num_frames;
+  }
+  uint32_t sampleRate() const {
+    return m_sample_rate;
+  }
+
+  /// Buckets at a level (the same for every channel)
+  size_t numBuckets(size_t level) const {
+    return m_num_buckets[level];
+  }
+
+  /// Dequantised bucket summary (level < NUM_LEVELS, index < numBuckets(level))
+  WaveformBucket bucket(size_t level, size_t index, uint32_t channel) const;
+
+  /// Min/max/RMS per pixel; same semantics as WaveformPyramid::query()
+  WaveformData query(int64_t start_sample, int64_t end_sample, uint32_t pixel_width,
+                     uint32_t channel) const;
+
+  /// Absolute peak of a channel (exact, not quantised)
+  float peakLevel(uint32_t channel) const;
+
+  /// Size of the mapping
+  size_t mappedBytes() const;
+
+private:
+  /// Start of one channel's data at one level inside the mapping
+  struct LevelData {
+    const int16_t* pairs; ///< [bucket * 2] = min, [bucket * 2 + 1] = max
+    const int16_t* rms;   ///< [bucket]
+  };
+
+  PeakFile() = default;
+
+  std::shared_ptr<MappedFile> m_file;
+  uint16_t m_num_channels = 0;
+  int64_t m_num_frames = 0;
+  uint32_t m_sample_rate = 0;
+  std::array<size_t, WaveformPyramid::NUM_LEVELS> m_num_buckets{};
+  std::vector<LevelData> m_levels; ///< [channel * NUM_LEVELS + level]
+  std::vector<float> m_peaks;
+};
+
+} // namespace orpheus
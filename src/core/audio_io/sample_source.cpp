@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: MIT
+#include "sample_source.h"
+
+#include "decoded_audio_cache.h"
+#include "io_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <utility>
+
+namespace orpheus {
+
+// ============================================================================
+// SampleSource
+// ============================================================================
+
+SampleSource::SampleSource(AudioFileMetadata metadata, std::vector<float> samples)
+    : m_metadata(std::move(metadata)), m_samples(std::move(samples)), m_data(m_samples.data()),
+      m_num_frames(0) {
+  if (m_metadata.num_channels > 0) {
+    m_num_frames = static_cast<int64_t>(m_samples.size() / m_metadata.num_channels);
+  }
+  m_metadata.duration_samples = m_num_frames;
+  m_resident_frames = m_num_frames;
+  m_silence = SilenceMap(m_data, m_num_frames, m_metadata.num_channels);
+}
+
+SampleSource::SampleSource(AudioFileMetadata metadata, const float* samples, size_t num_samples,
+                           std::shared_ptr<const void> storage)
+    : m_metadata(std::move(metadata)), m_storage(std::move(storage)),
+      m_external_bytes(num_samples * sizeof(float)), m_data(samples), m_num_frames(0) {
+  if (m_metadata.num_channels > 0) {
+    m_num_frames = static_cast<int64_t>(num_samples / m_metadata.num_channels);
+  }
+  m_metadata.duration_samples = m_num_frames;
+  m_resident_frames = m_num_frames;
+  m_silence = SilenceMap(m_data, m_num_frames, m_metadata.num_channels);
+}
+
+SampleSource::SampleSource(AudioFileMetadata metadata, std::vector<float> head,
+                           std::string file_path, AudioFileReaderFactory factory)
+    : m_metadata(std::move(metadata)), m_samples(std::move(head)), m_data(m_samples.data()),
+      m_num_frames(std::max<int64_t>(m_metadata.duration_samples, 0)), m_resident_frames(0),
+      m_file_path(std::move(file_path)), m_factory(std::move(factory)),
+      m_streamer(&sharedSampleStreamer()) {
+  if (m_metadata.num_channels > 0) {
+    m_resident_frames = std::min(
+        m_num_frames, static_cast<int64_t>(m_samples.size() / m_metadata.num_channels));
+  }
+  m_silence = SilenceMap(m_data, m_resident_frames, m_metadata.num_channels);
+}
+
+size_t SampleSource::read(int64_t position, float* buffer, size_t num_frames) const {
+  if (position < 0 || position >= m_resident_frames) {
+    return 0;
+  }
+
+  size_t frames = std::min(num_frames, static_cast<size_t>(m_resident_frames - position));
+  size_t channels = m_metadata.num_channels;
+  std::memcpy(buffer, m_data + static_cast<size_t>(position) * channels,
+              frames * channels * sizeof(float));
+  return frames;
+}
+
+std::unique_ptr<IAudioFileReader> SampleSource::openReader() const {
+  auto reader = !isResident() && m_factory ? m_factory() : nullptr;
+  if (!reader || !reader->open(m_file_path).isOk()) {
+    return nullptr;
+  }
+  return reader;
+}
+
+// ============================================================================
+// SampleCursor
+// ============================================================================
+
+SampleCursor::SampleCursor(std::shared_ptr<const SampleSource> source)
+    : m_source(std::move(source)) {}
+
+SampleCursor::~SampleCursor() {
+  close();
+}
+
+SampleCursor::SampleCursor(SampleCursor&& other) noexcept
+    : m_source(std::move(other.m_source)), m_position(other.m_position),
+      m_stream(std::exchange(other.m_stream, nullptr)),
+      m_stream_generation(other.m_stream_generation), m_stream_start(other.m_stream_start) {
+  other.m_position = 0;
+}
+
+SampleCursor& SampleCursor::operator=(SampleCursor&& other) noexcept {
+  if (this != &other) {
+    close();
+    m_source = std::move(other.m_source);
+    m_position = std::exchange(other.m_position, 0);
+    m_stream = std::exchange(other.m_stream, nullptr);
+    m_stream_generation = other.m_stream_generation;
+    m_stream_start = other.m_stream_start;
+  }
+  return *this;
+}
+
+size_t SampleCursor::read(float* buffer, size_t num_frames) {
+  if (!m_source) {
+    return 0;
+  }
+  if (!m_source->isResident() && m_stream_start < 0) {
+    seek(m_position); // Start the read-ahead
+  }
+
+  // Resident frames (all of them, or a streamed source's head) are copied directly
+  size_t frames = m_source->read(m_position, buffer, num_frames);
+  m_position += static_cast<int64_t>(frames);
+
+  // The rest comes from this cursor's read-ahead, which starts where the head ends
+  if (frames < num_frames && m_stream && m_position >= m_stream_start) {
+    float* tail = buffer + frames * m_source->numChannels();
+    size_t streamed = m_stream->read(m_stream_generation, m_position, tail, num_frames - frames);
+    m_position += static_cast<int64_t>(streamed);
+    frames += streamed;
+  }
+  return frames;
+}
+
+void SampleCursor::seek(int64_t position) {
+  int64_t end = m_source ? m_source->numFrames() : 0;
+  position = std::clamp(position, int64_t{0}, end);
+  if (!m_source || m_source->isResident()) {
+    m_position = position;
+    return;
+  }
+
+  // Read-ahead starts at the target, or where the head ends if the target is in it
+  const int64_t start = std::max(position, m_source->residentFrames());
+  if (!m_stream && m_source->streamer()) {
+    m_stream = m_source->streamer()->claim(m_source);
+  }
+  if (m_stream) {
+    // Seeks that land where the stream is already positioned keep its buffered frames
+    // (e.g. silence skipping inside the head, which re-seeks every block)
+    const bool untouched = m_stream_start == start && m_position <= start;
+    const bool contiguous =
+        m_stream_start >= 0 && position == m_position && m_position >= m_stream_start;
+    if (!untouched && !contiguous) {
+      m_stream_generation = m_stream->request(start);
+      m_stream_start = start;
+    }
+  }
+  m_position = position;
+}
+
+void SampleCursor::close() {
+  if (m_stream) {
+    m_stream->release();
+    m_stream = nullptr;
+  }
+  m_stream_start = -1;
+  m_source.reset();
+  m_position = 0;
+}
+
+// ============================================================================
+// SampleSourceCache
+// ============================================================================
+
+namespace {
+
+constexpr size_t DECODE_CHUNK_FRAMES = 16384;
+
+/// Decode a file whole, or only its head (for streaming) when `reserve` cannot
+/// set its decoded size aside from the resident budget
+/// @param reserve Called once with the decoded size in bytes and whether the file
+///        must be resident anyway (too short to stream); returns whether it fits
+Result<std::shared_ptr<const SampleSource>>
+decodeFile(IAudioFileReader& reader, const std::string& file_path,
+           const std::function<bool(size_t, bool)>& reserve,
+           const AudioFileReaderFactory& factory) {
+  Result<std::shared_ptr<const SampleSource>> result;
+
+  auto opened = reader.open(file_path);
+  if (!opened.isOk()) {
+    result.error = opened.error;
+    result.errorMessage = opened.errorMessage;
+    return result;
+  }
+
+  AudioFileMetadata metadata = opened.value;
+  size_t channels = metadata.num_channels;
+  const auto frames = static_cast<size_t>(std::max<int64_t>(metadata.duration_samples, 0));
+  const bool streamable = metadata.duration_samples > SampleSource::STREAM_HEAD_FRAMES;
+  const bool stream = !reserve(frames * channels * sizeof(float), !streamable);
+  const size_t decode_frames = stream ? static_cast<size_t>(SampleSource::STREAM_HEAD_FRAMES)
+                                      : std::numeric_limits<size_t>::max();
+  if (stream) {
+    reserve(decode_frames * channels * sizeof(float), true); // The head is held regardless
+  }
+
+  std::vector<float> samples;
+  samples.reserve(std::min(frames, decode_frames) * channels);
+
+  // Decode in chunks straight into the shared buffer
+  while (samples.size() < decode_frames * channels) {
+    size_t offset = samples.size();
+    size_t decoded = channels > 0 ? offset / channels : 0;
+    size_t chunk = std::min(DECODE_CHUNK_FRAMES, decode_frames - decoded);
+    samples.resize(offset + chunk * channels);
+    auto ticket = sharedIoScheduler().acquire(IoClass::Interactive);
+    auto read = reader.readSamples(samples.data() + offset, chunk);
+    ticket.release();
+    if (!read.isOk()) {
+      reader.close();
+      result.error = read.error;
+      result.errorMessage = read.errorMessage;
+      return result;
+    }
+    samples.resize(offset + read.value * channels);
+    if (read.value < chunk) {
+      break;
+    }
+  }
+  reader.close();
+
+  samples.shrink_to_fit();
+  if (stream) {
+    result.value = std::make_shared<const SampleSource>(std::move(metadata), std::move(samples),
+                                                        file_path, factory);
+  } else {
+    result.value = std::make_shared<const SampleSource>(std::move(metadata), std::move(samples));
+  }
+  result.error = SessionGraphError::OK;
+  return result;
+}
+
+} // namespace
+
+SampleSourceCache::SampleSourceCache(AudioFileReaderFactory factory)
+    : m_factory(std::move(factory)) {}
+
+void SampleSourceCache::setDecodedCache(std::shared_ptr<DecodedAudioCache> cache) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_decoded_cache = std::move(cache);
+}
+
+void SampleSourceCache::setResidentLimitBytes(size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_resident_limit = bytes;
+}
+
+std::string SampleSourceCache::identityKey(const std::string& file_path) {
+  std::error_code ec;
+  auto canonical = std::filesystem::canonical(file_path, ec);
+  if (ec) {
+    return {};
+  }
+  auto size = std::filesystem::file_size(canonical, ec);
+  if (ec) {
+    return {};
+  }
+  auto modified = std::filesystem::last_write_time(canonical, ec);
+  if (ec) {
+    return {};
+  }
+
+  return canonical.string() + '\n' + std::to_string(size) + '\n' +
+         std::to_string(modified.time_since_epoch().count());
+}
+
+Result<std::shared_ptr<const SampleSource>>
+SampleSourceCache::acquire(const std::string& file_path) {
+  Result<std::shared_ptr<const SampleSource>> result;
+
+  // Unreadable paths are not deduplicated; the decoder reports the error
+  std::string key = identityKey(file_path);
+
+  std::shared_ptr<DecodedAudioCache> decoded_cache;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    decoded_cache = m_decoded_cache;
+    if (!key.empty()) {
+      auto it = m_sources.find(key);
+      if (it != m_sources.end()) {
+        result.value = it->second;
+        result.error = SessionGraphError::OK;
+        return result;
+      }
+    }
+  }
+
+  // Bytes set aside for this decode until its source is held, so concurrent
+  // acquires see each other's decodes and together stay within the budget
+  size_t reserved = 0;
+  auto reserve = [this, &reserved](size_t bytes, bool required) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t committed = residentBytesLocked() + m_reserved_bytes;
+    if (!required && (committed > m_resident_limit || bytes > m_resident_limit - committed)) {
+      return false; // Streamed instead
+    }
+    m_reserved_bytes += bytes;
+    reserved += bytes;
+    return true;
+  };
+
+  // Decode (or map a previously decoded sidecar) without holding the lock so
+  // other files can be acquired meanwhile
+  std::string content_key;
+  if (decoded_cache && !key.empty() && DecodedAudioCache::isCacheable(file_path)) {
+    content_key = decoded_cache->contentKey(file_path);
+  }
+  if (!content_key.empty()) {
+    // Mapped frames are held like decoded ones; a sidecar beyond the budget is
+    // skipped and the file decoded (and streamed if it can be) instead
+    result.value = decoded_cache->load(content_key, [&reserve](const AudioFileMetadata& metadata) {
+      const auto frames = static_cast<size_t>(std::max<int64_t>(metadata.duration_samples, 0));
+      const bool streamable = metadata.duration_samples > SampleSource::STREAM_HEAD_FRAMES;
+      return reserve(frames * metadata.num_channels * sizeof(float), !streamable);
+    });
+  }
+
+  if (result.value) {
+    result.error = SessionGraphError::OK;
+  } else {
+    auto reader = m_factory ? m_factory() : nullptr;
+    if (!reader) {
+      result.error = SessionGraphError::NotReady; // Audio file reading not available
+      result.errorMessage = "No audio file decoder available";
+      return result;
+    }
+
+    result = decodeFile(*reader, file_path, reserve, m_factory);
+    if (!result.isOk()) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_reserved_bytes -= reserved;
+      return result;
+    }
+    if (!content_key.empty()) {
+      decoded_cache->store(content_key, *result.value); // Best effort
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_reserved_bytes -= reserved; // Counted by residentBytesLocked() from here on
+  if (key.empty()) {
+    // Held under a key no path produces, so the cache still retires it
+    m_sources.emplace("\n" + std::to_string(m_next_unkeyed++), result.value);
+    return result;
+  }
+
+  // Another thread may have decoded the same file concurrently: keep the first
+  auto [it, inserted] = m_sources.emplace(key, result.value);
+  if (!inserted) {
+    result.value = it->second;
+  }
+  return result;
+}
+
+size_t SampleSourceCache::collect() {
+  std::vector<std::shared_ptr<const SampleSource>> unused;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_sources.begin(); it != m_sources.end();) {
+      // Only the cache holds it: no registry entry, voice or stream can reach it again
+      if (it->second.use_count() == 1) {
+        unused.push_back(std::move(it->second));
+        it = m_sources.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return unused.size(); // Freed here, outside the lock
+}
+
+size_t SampleSourceCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_sources.size();
+}
+
+size_t SampleSourceCache::residentBytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return residentBytesLocked();
+}
+
+size_t SampleSourceCache::residentBytesLocked() const {
+  size_t bytes = 0;
+  for (const auto& [key, source] : m_sources) {
+    bytes += source->memoryBytes();
+  }
+  return bytes;
+}
+
+} // namespace orpheus
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "sample_streamer.h"
+#include "silence_map.h"
+
+#include <orpheus/audio_file_reader.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace orpheus {
+
+class DecodedAudioCache;
+
+/// Creates the decoder used to fill a SampleSource
+using AudioFileReaderFactory = std::function<std::unique_ptr<IAudioFileReader>()>;
+
+/// Immutable decoded audio shared by every clip and voice that plays a file
+///
+/// Resident sources hold every frame: decoded once on a background/UI thread
+/// into interleaved float frames, or mapped from a DecodedAudioCache sidecar.
+/// Files too large for the cache's resident budget are streamed instead: the
+/// source holds only the first STREAM_HEAD_FRAMES (so voices start without
+/// waiting for the disk) and each SampleCursor reads the rest through its own
+/// SampleStreamer read-ahead. Never modified afterwards, so any number of
+/// cursors may read it concurrently without locking.
+///
+/// Construction also scans the resident frames once for the block SilenceMap,
+/// and a streamed source starts the shared SampleStreamer, so the audio thread
+/// never has to.
+class SampleSource {
+public:
+  /// Frames a streamed source keeps resident (about 1.4 s at 48 kHz)
+  static constexpr int64_t STREAM_HEAD_FRAMES = 65536;
+
+  SampleSource(AudioFileMetadata metadata, std::vector<float> samples);
+
+  /// Wrap interleaved frames owned elsewhere (e.g. a memory-mapped file)
+  /// @param storage Keeps `samples` valid for the lifetime of the source
+  SampleSource(AudioFileMetadata metadata, const float* samples, size_t num_samples,
+               std::shared_ptr<const void> storage);
+
+  /// Streamed source: `head` holds the first frames, the rest is read from the file
+  /// @param metadata File metadata (duration_samples is the whole file)
+  /// @param head First frames, interleaved (usually STREAM_HEAD_FRAMES)
+  /// @param file_path File to stream from
+  /// @param factory Decoder factory for the streams
+  SampleSource(AudioFileMetadata metadata, std::vector<float> head, std::string file_path,
+               AudioFileReaderFactory factory);
+
+  const AudioFileMetadata& metadata() const {
+    return m_metadata;
+  }
+  uint16_t numChannels() const {
+    return m_metadata.num_channels;
+  }
+  int64_t numFrames() const {
+    return m_num_frames;
+  }
+
+  /// Whether every frame is in memory (otherwise cursors stream past residentFrames())
+  bool isResident() const {
+    return m_resident_frames == m_num_frames;
+  }
+
+  /// Frames held in memory, from the start
+  int64_t residentFrames() const {
+    return m_resident_frames;
+  }
+
+  /// Memory held by the frames (heap, or mapped and locked by DecodedAudioCache)
+  size_t memoryBytes() const {
+    return m_samples.capacity() * sizeof(float) + m_external_bytes;
+  }
+
+  /// Interleaved resident samples (residentFrames() * numChannels())
+  const float* data() const {
+    return m_data;
+  }
+
+  /// Silent blocks of the resident audio (see SilenceMap)
+  const SilenceMap& silence() const {
+    return m_silence;
+  }
+
+  /// Copy interleaved resident frames starting at a position (audio thread safe)
+  /// @param position First frame to copy
+  /// @param buffer Output buffer (at least num_frames * numChannels())
+  /// @param num_frames Frames requested
+  /// @return Frames copied (fewer at the end of the resident frames, 0 past them)
+  size_t read(int64_t position, float* buffer, size_t num_frames) const;
+
+  /// File a streamed source reads past its head (empty when resident)
+  const std::string& filePath() const {
+    return m_file_path;
+  }
+
+  /// Read-ahead that streams this source past its head (nullptr when resident)
+  SampleStreamer* streamer() const {
+    return m_streamer;
+  }
+
+  /// Open a decoder on the file of a streamed source (not from the audio thread)
+  /// @return Open decoder at frame 0, or nullptr if resident or the file cannot be opened
+  std::unique_ptr<IAudioFileReader> openReader() const;
+
+private:
+  AudioFileMetadata m_metadata;
+  std::vector<float> m_samples;          // Owned storage, interleaved [frame * channels + ch]
+  std::shared_ptr<const void> m_storage; // External storage keep-alive
+  size_t m_external_bytes = 0;           // Size of the external frames
+  const float* m_data;                   // m_samples.data() or external frames
+  int64_t m_num_frames;
+  int64_t m_resident_frames;
+  SilenceMap m_silence;
+
+  // Streamed sources only
+  std::string m_file_path;
+  AudioFileReaderFactory m_factory;
+  SampleStreamer* m_streamer = nullptr;
+};
+
+/// Independent read position into a shared SampleSource (one per voice)
+///
+/// Reading and seeking are allocation-free and never touch the file. On a
+/// streamed source the cursor claims a SampleStreamer stream when first
+/// seeked; past the resident head it reads that stream's ring, returning
+/// fewer frames than asked if the disk has fallen behind (after a seek beyond
+/// the head, until the first refill lands). Move-only, since a stream has one
+/// reader; close() or destruction hands the stream back.
+class SampleCursor {
+public:
+  SampleCursor() = default;
+  explicit SampleCursor(std::shared_ptr<const SampleSource> source);
+  ~SampleCursor();
+
+  SampleCursor(SampleCursor&& other) noexcept;
+  SampleCursor& operator=(SampleCursor&& other) noexcept;
+  SampleCursor(const SampleCursor&) = delete;
+  SampleCursor& operator=(const SampleCursor&) = delete;
+
+  /// Read frames and advance (audio thread safe)
+  /// @return Frames read (0 at end or when no source is attached)
+  size_t read(float* buffer, size_t num_frames);
+
+  /// Move the read position (clamped to [0, numFrames()])
+  void seek(int64_t position);
+
+  /// Release the source and any stream (audio thread safe)
+  void close();
+
+  int64_t position() const {
+    return m_position;
+  }
+  bool isOpen() const {
+    return m_source != nullptr;
+  }
+  const SampleSource* source() const {
+    return m_source.get();
+  }
+
+private:
+  std::shared_ptr<const SampleSource> m_source;
+  int64_t m_position = 0;
+
+  // Streamed sources: read-ahead from m_stream_start on (nullptr until first seek)
+  SampleStreamer::Stream* m_stream = nullptr;
+  uint64_t m_stream_generation = 0;
+  int64_t m_stream_start = -1;
+};
+
+/// Deduplicating SampleSource cache
+///
+/// Sources are keyed by canonical path plus file identity (size and
+/// modification time), so registering the same file again returns the
+/// already decoded source, while a file changed on disk is decoded afresh.
+///
+/// Decoded frames are held in memory up to a total resident budget; a file
+/// whose decoded size does not fit in what is left is streamed from disk
+/// instead (see SampleSource), so memory no longer grows with the length of
+/// the show. The budget is reserved before decoding starts, so files acquired
+/// in parallel share it rather than each seeing all of it. Sources mapped from
+/// a DecodedAudioCache sidecar count too (their pages are locked in RAM); a
+/// sidecar that does not fit is skipped and the file streamed instead.
+///
+/// The cache keeps a reference to every source until collect() finds that no
+/// clip or voice uses it, so the last reference is never dropped by a voice on
+/// the audio thread; owners call collect() periodically from a non-audio thread.
+///
+/// With a DecodedAudioCache attached, compressed files are decoded once per
+/// content hash across runs and later mapped from their sidecar instead.
+///
+/// Thread Safety: acquire() may block on decoding; call acquire() and
+/// collect() from a background or UI thread (NOT the audio thread).
+class SampleSourceCache {
+public:
+  /// Default decoded-audio budget (about 46 minutes of 48 kHz stereo)
+  static constexpr size_t DEFAULT_RESIDENT_LIMIT_BYTES = size_t{512} << 20;
+
+  /// @param factory Decoder factory (defaults to createAudioFileReader)
+  explicit SampleSourceCache(AudioFileReaderFactory factory = createAudioFileReader);
+
+  /// Attach (or detach with nullptr) a persistent decoded-audio cache
+  void setDecodedCache(std::shared_ptr<DecodedAudioCache> cache);
+
+  /// Set the decoded-audio budget (applies to files acquired afterwards)
+  void setResidentLimitBytes(size_t bytes);
+
+  /// Get the decoded source for a file, decoding it (or its head) on first use
+  /// @param file_path Path to audio file
+  /// @return Shared source, or NotReady (no decoder available) / decoder error
+  Result<std::shared_ptr<const SampleSource>> acquire(const std::string& file_path);
+
+  /// Free sources that nothing outside the cache references any more
+  /// @return Sources freed
+  size_t collect();
+
+  /// Number of sources currently held
+  size_t size() const;
+
+  /// Memory held by decoded or mapped frames of the held sources
+  size_t residentBytes() const;
+
+private:
+  /// Identity key (canonical path, size, modification time), empty if unreadable
+  static std::string identityKey(const std::string& file_path);
+
+  /// Sum of memoryBytes() (caller holds m_mutex)
+  size_t residentBytesLocked() const;
+
+  AudioFileReaderFactory m_factory;
+  std::shared_ptr<DecodedAudioCache> m_decoded_cache; ///< Guarded by m_mutex
+  size_t m_resident_limit = DEFAULT_RESIDENT_LIMIT_BYTES; ///< Guarded by m_mutex
+  size_t m_reserved_bytes = 0; ///< Budget held by decodes in flight, guarded by m_mutex
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<const SampleSource>> m_sources;
+  uint64_t m_next_unkeyed = 0; ///< Keys for sources of unidentifiable paths
+};
+
+} // namespace orpheus
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: MIT
+#include "sample_streamer.h"
+
+#include "block_reader.h"
+#include "pcm_stream_set.h"
+#include "sample_source.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace orpheus {
+
+namespace {
+
+/// Streamer wake-up interval while no stream needs decoding
+constexpr std::chrono::milliseconds POLL_INTERVAL{2};
+
+} // namespace
+
+// ============================================================================
+// Stream (consumer side)
+// ============================================================================
+
+uint64_t SampleStreamer::Stream::request(int64_t frame) {
+  consumed_frame.store(frame, std::memory_order_relaxed);
+  request_frame.store(frame, std::memory_order_relaxed);
+  const uint64_t generation = request_generation.load(std::memory_order_relaxed) + 1;
+  request_generation.store(generation, std::memory_order_release);
+  return generation;
+}
+
+size_t SampleStreamer::Stream::read(uint64_t generation, int64_t position, float* buffer,
+                                    size_t num_frames) {
+  size_t frames = 0;
+  if (fill_generation.load(std::memory_order_acquire) == generation) {
+    const int64_t buffered = write_frame.load(std::memory_order_acquire) - position;
+    frames = static_cast<size_t>(
+        std::clamp<int64_t>(buffered, 0, static_cast<int64_t>(num_frames)));
+
+    // Copy up to the end of the ring, then wrap
+    const size_t offset = static_cast<size_t>(position % RING_FRAMES);
+    const size_t first = std::min(frames, static_cast<size_t>(RING_FRAMES) - offset);
+    std::memcpy(buffer, ring.data() + offset * channels, first * channels * sizeof(float));
+    std::memcpy(buffer + first * channels, ring.data(),
+                (frames - first) * channels * sizeof(float));
+    consumed_frame.store(position + static_cast<int64_t>(frames), std::memory_order_release);
+  }
+
+  if (frames < num_frames && position + static_cast<int64_t>(frames) < source->numFrames()) {
+    owner->m_underruns.fetch_add(1, std::memory_order_relaxed);
+  }
+  return frames;
+}
+
+void SampleStreamer::Stream::release() {
+  state.store(Releasing, std::memory_order_release);
+}
+
+// ============================================================================
+// SampleStreamer
+// ============================================================================
+
+SampleStreamer::SampleStreamer() {
+  for (auto& stream : m_streams) {
+    stream.owner = this;
+  }
+  m_thread = std::thread([this] { threadMain(); });
+}
+
+SampleStreamer::~SampleStreamer() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_stop_cv.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+SampleStreamer::Stream* SampleStreamer::claim(std::shared_ptr<const SampleSource> source) {
+  for (auto& stream : m_streams) {
+    uint8_t expected = Stream::Free;
+    if (stream.state.compare_exchange_strong(expected, Stream::Claimed,
+                                             std::memory_order_acquire)) {
+      stream.source = std::move(source);
+      stream.state.store(Stream::Active, std::memory_order_release);
+      return &stream;
+    }
+  }
+  return nullptr;
+}
+
+size_t SampleStreamer::activeStreams() const {
+  return static_cast<size_t>(std::count_if(m_streams.begin(), m_streams.end(), [](const auto& s) {
+    return s.state.load(std::memory_order_relaxed) != Stream::Free;
+  }));
+}
+
+void SampleStreamer::threadMain() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    lock.unlock();
+    bool decoded = false;
+    for (auto& stream : m_streams) {
+      decoded |= service(stream);
+    }
+    decoded |= refillPcm();
+    lock.lock();
+
+    // Keep going while any ring took frames; otherwise poll for new requests
+    if (!decoded) {
+      m_stop_cv.wait_for(lock, POLL_INTERVAL, [this] { return m_stop; });
+    }
+  }
+}
+
+bool SampleStreamer::service(Stream& stream) {
+  const uint8_t state = stream.state.load(std::memory_order_acquire);
+  if (state == Stream::Releasing) {
+    // Close here, never on the consumer's (audio) thread
+    if (stream.pcm != NO_PCM) {
+      m_pcm->close(stream.pcm);
+      stream.pcm = NO_PCM;
+    }
+    stream.reader.reset();
+    stream.source.reset();
+    stream.at_end = false;
+    stream.state.store(Stream::Free, std::memory_order_release);
+    return false;
+  }
+  if (state != Stream::Active) {
+    return false;
+  }
+
+  const SampleSource& source = *stream.source;
+  const uint64_t generation = stream.request_generation.load(std::memory_order_acquire);
+  if (generation == 0) {
+    return false; // Claimed, nothing requested yet
+  }
+
+  if (generation != stream.serviced_generation) {
+    const int64_t frame = stream.request_frame.load(std::memory_order_relaxed);
+    if (!stream.reader && stream.pcm == NO_PCM) {
+      openPcm(stream);
+      if (stream.pcm == NO_PCM) {
+        stream.reader = source.openReader();
+      }
+      stream.channels = source.numChannels();
+      if (stream.ring.size() < static_cast<size_t>(RING_FRAMES) * stream.channels) {
+        stream.ring.resize(static_cast<size_t>(RING_FRAMES) * stream.channels);
+      }
+    }
+    if (stream.pcm != NO_PCM) {
+      stream.at_end = frame >= source.numFrames() || !m_pcm->seek(stream.pcm, frame);
+    } else {
+      stream.at_end = !stream.reader || frame >= source.numFrames() ||
+                      stream.reader->seek(frame) != SessionGraphError::OK;
+    }
+    stream.write_frame.store(frame, std::memory_order_relaxed);
+    stream.fill_generation.store(generation, std::memory_order_release);
+    stream.serviced_generation = generation;
+  }
+  if (stream.at_end) {
+    return false;
+  }
+
+  const int64_t write = stream.write_frame.load(std::memory_order_relaxed);
+  const int64_t buffered = write - stream.consumed_frame.load(std::memory_order_acquire);
+  const int64_t frames = std::min(CHUNK_FRAMES, source.numFrames() - write);
+  if (RING_FRAMES - buffered < frames) {
+    return false; // Ring full
+  }
+
+  // Decode straight into the ring, in two reads where it wraps
+  const size_t offset = static_cast<size_t>(write % RING_FRAMES);
+  const size_t first =
+      std::min(static_cast<size_t>(frames), static_cast<size_t>(RING_FRAMES) - offset);
+  const auto deadline = IoScheduler::playbackDeadline(buffered, source.metadata().sample_rate);
+  if (stream.pcm != NO_PCM) {
+    // Up to the end of the ring; the next pass continues from its start
+    m_pcm_streams[stream.pcm] = &stream;
+    m_pcm_frames[stream.pcm] = first;
+    m_pcm_outputs[stream.pcm] = stream.ring.data() + offset * stream.channels;
+    m_pcm_deadline = std::min(m_pcm_deadline, deadline);
+    stream.pcm_generation = generation;
+    stream.pcm_write = write;
+    stream.pcm_frames = first;
+    return false;
+  }
+
+  auto ticket = sharedIoScheduler().acquire(IoClass::Playback, deadline);
+  auto read = stream.reader->readSamples(stream.ring.data() + offset * stream.channels, first);
+  size_t decoded = read.isOk() ? read.value : 0;
+  if (decoded == first && first < static_cast<size_t>(frames)) {
+    read = stream.reader->readSamples(stream.ring.data(), static_cast<size_t>(frames) - first);
+    decoded += read.isOk() ? read.value : 0;
+  }
+  ticket.release();
+
+  if (stream.request_generation.load(std::memory_order_acquire) != generation) {
+    return true; // Seeked meanwhile: these frames are discarded on the next pass
+  }
+  const int64_t end = write + static_cast<int64_t>(decoded);
+  stream.write_frame.store(end, std::memory_order_release);
+  stream.at_end = decoded < static_cast<size_t>(frames) || end >= source.numFrames();
+  return decoded > 0;
+}
+
+void SampleStreamer::openPcm(Stream& stream) {
+  const SampleSource& source = *stream.source;
+  if (!m_pcm) {
+    m_pcm = std::make_unique<PcmStreamSet>(createBlockReader(), &sharedIoScheduler());
+  }
+  auto index = m_pcm->open(source.filePath());
+  if (!index) {
+    return; // Compressed, unreadable or every batch slot in use
+  }
+
+  // The head was decoded by the source's own decoder; stream on only if both agree
+  const auto* layout = m_pcm->layout(*index);
+  if (layout->num_channels != source.numChannels() || layout->num_frames != source.numFrames()) {
+    m_pcm->close(*index);
+    return;
+  }
+  stream.pcm = *index;
+  if (m_pcm_streams.size() < m_pcm->streamSlots()) {
+    m_pcm_streams.resize(m_pcm->streamSlots(), nullptr);
+    m_pcm_frames.resize(m_pcm->streamSlots(), 0);
+    m_pcm_outputs.resize(m_pcm->streamSlots(), nullptr);
+    m_pcm_read.resize(m_pcm->streamSlots(), 0);
+  }
+}
+
+bool SampleStreamer::refillPcm() {
+  if (!m_pcm || std::none_of(m_pcm_streams.begin(), m_pcm_streams.end(),
+                             [](const Stream* stream) { return stream != nullptr; })) {
+    return false;
+  }
+
+  m_pcm->readNext(m_pcm_frames, m_pcm_outputs, m_pcm_read, m_pcm_deadline);
+  m_pcm_deadline = IoScheduler::BEST_EFFORT;
+
+  bool decoded = false;
+  for (size_t i = 0; i < m_pcm_streams.size(); ++i) {
+    Stream* stream = std::exchange(m_pcm_streams[i], nullptr);
+    m_pcm_frames[i] = 0;
+    if (!stream) {
+      continue;
+    }
+    if (stream->request_generation.load(std::memory_order_acquire) != stream->pcm_generation) {
+      decoded = true; // Seeked meanwhile: these frames are discarded on the next pass
+      continue;
+    }
+    // A failed read (-errno) ends the stream, as a decoder error does
+    const size_t count = static_cast<size_t>(std::max<int64_t>(m_pcm_read[i], 0));
+    const int64_t end = stream->pcm_write + static_cast<int64_t>(count);
+    stream->write_frame.store(end, std::memory_order_release);
+    stream->at_end = count < stream->pcm_frames || end >= stream->source->numFrames();
+    decoded |= count > 0;
+  }
+  return decoded;
+}
+
+SampleStreamer& sharedSampleStreamer() {
+  static SampleStreamer streamer;
+  return streamer;
+}
+
+} // namespace orpheus
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/audio_file_reader.h>
+
+#include "io_scheduler.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace orpheus {
+
+class PcmStreamSet;
+class SampleSource;
+
+/// Disk read-ahead for SampleSources too large to hold decoded
+///
+/// A fixed table of streams, each an interleaved ring buffer filled by one
+/// background thread. Uncompressed WAV/AIFF streams are refilled together, one
+/// PcmStreamSet batch per pass decoded by the native PCM kernels; other files
+/// (and PCM streams beyond the batch size) read through the source's own
+/// decoder. A SampleCursor claims a
+/// stream lock-free when it starts reading a streamed source, requests a start
+/// frame on every seek and consumes the ring from the audio thread; the
+/// streamer opens a decoder per stream, so layered voices of one file stream
+/// independently. Refills are admitted as IoClass::Playback reads with the
+/// deadline at which the stream's buffered frames run out.
+///
+/// Released streams are closed by the streamer thread, which also drops their
+/// source reference, so decoders and sources are never destroyed on the audio
+/// thread.
+///
+/// Thread Safety: claim(), Stream::request(), Stream::read() and
+/// Stream::release() are lock-free and allocation-free (audio thread safe);
+/// each claimed stream has one consumer.
+class SampleStreamer {
+public:
+  /// Streams open at once (beyond this, claim() fails)
+  static constexpr size_t MAX_STREAMS = 128;
+
+  /// Ring capacity per stream in frames (about 1.4 s at 48 kHz)
+  static constexpr int64_t RING_FRAMES = 65536;
+
+  /// Frames decoded per refill read
+  static constexpr int64_t CHUNK_FRAMES = 8192;
+
+  /// One read-ahead ring (owned by the streamer, claimed by one cursor)
+  class Stream {
+  public:
+    /// Restart read-ahead at a frame; frames before it are discarded (consumer only)
+    /// @return Generation to pass to read()
+    uint64_t request(int64_t frame);
+
+    /// Copy buffered frames of the current request and consume them (consumer only)
+    /// @param generation Value returned by the last request()
+    /// @param position Next frame to read (the request's frame, then advancing)
+    /// @param buffer Output, at least num_frames * channels
+    /// @return Frames copied (0 until the first refill of the request lands)
+    size_t read(uint64_t generation, int64_t position, float* buffer, size_t num_frames);
+
+    /// Hand the stream back; the streamer closes it (consumer only)
+    void release();
+
+  private:
+    friend class SampleStreamer;
+
+    enum State : uint8_t { Free, Claimed, Active, Releasing };
+
+    std::atomic<uint8_t> state{Free};
+
+    // Consumer → streamer
+    std::atomic<uint64_t> request_generation{0};
+    std::atomic<int64_t> request_frame{0};
+    std::atomic<int64_t> consumed_frame{0}; ///< Ring space before this frame may be reused
+
+    // Streamer → consumer
+    std::atomic<uint64_t> fill_generation{0}; ///< Request whose frames the ring holds
+    std::atomic<int64_t> write_frame{0};      ///< Frames before this are buffered
+
+    // Set on claim (consumer) and read by the streamer once Active
+    std::shared_ptr<const SampleSource> source;
+    SampleStreamer* owner = nullptr;
+
+    // Streamer thread only (the ring is sized before fill_generation is published)
+    std::vector<float> ring;
+    size_t channels = 0;
+    std::unique_ptr<IAudioFileReader> reader;
+    size_t pcm = NO_PCM; ///< PcmStreamSet stream index, or NO_PCM when read by `reader`
+    uint64_t serviced_generation = 0;
+    bool at_end = false;
+
+    // Refill queued for the next PcmStreamSet batch
+    uint64_t pcm_generation = 0;
+    int64_t pcm_write = 0;
+    size_t pcm_frames = 0;
+  };
+
+  SampleStreamer();
+
+  /// Stops the streamer thread and closes every stream
+  ~SampleStreamer();
+
+  SampleStreamer(const SampleStreamer&) = delete;
+  SampleStreamer& operator=(const SampleStreamer&) = delete;
+
+  /// Claim a stream for a source (audio thread safe)
+  /// @return Stream, or nullptr if all MAX_STREAMS are in use
+  Stream* claim(std::shared_ptr<const SampleSource> source);
+
+  /// Streams currently claimed
+  size_t activeStreams() const;
+
+  /// Reads that found fewer frames buffered than requested before the end of the file
+  uint64_t underruns() const {
+    return m_underruns.load(std::memory_order_relaxed);
+  }
+
+private:
+  void threadMain();
+
+  static constexpr size_t NO_PCM = SIZE_MAX;
+
+  /// Open, refill or close one stream (PCM refills are queued for refillPcm())
+  /// @return Whether frames were decoded (more may be wanted at once)
+  bool service(Stream& stream);
+
+  /// Open a stream's source in m_pcm if it is uncompressed PCM matching the source
+  void openPcm(Stream& stream);
+
+  /// Read every queued PCM refill in one batch
+  /// @return Whether frames were decoded
+  bool refillPcm();
+
+  std::array<Stream, MAX_STREAMS> m_streams;
+
+  // Streamer thread only (m_pcm is created with the first stream)
+  std::unique_ptr<PcmStreamSet> m_pcm;
+  std::vector<Stream*> m_pcm_streams; ///< Queued stream per PcmStreamSet index, or nullptr
+  std::vector<size_t> m_pcm_frames;
+  std::vector<float*> m_pcm_outputs;
+  std::vector<int64_t> m_pcm_read;
+  IoScheduler::Clock::time_point m_pcm_deadline = IoScheduler::BEST_EFFORT;
+  std::atomic<uint64_t> m_underruns{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_stop_cv;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+
+/// Process-wide streamer used by streamed SampleSources (started on first use,
+/// which is the construction of the first streamed source; not the audio thread)
+SampleStreamer& sharedSampleStreamer();
+
+} // namespace orpheus
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MIT
+#include "silence_map.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace orpheus {
+
+SilenceMap::SilenceMap(const float* interleaved, int64_t num_frames, uint16_t num_channels,
+                       float threshold) {
+  if (interleaved == nullptr || num_frames <= 0 || num_channels == 0) {
+    return;
+  }
+  m_num_blocks = static_cast<size_t>((num_frames + BLOCK_FRAMES - 1) / BLOCK_FRAMES);
+  m_bits.assign((m_num_blocks + 63) / 64, 0);
+
+  const size_t total_samples = static_cast<size_t>(num_frames) * num_channels;
+  const size_t block_samples = size_t{BLOCK_FRAMES} * num_channels;
+  for (size_t block = 0; block < m_num_blocks; ++block) {
+    const float* first = interleaved + block * block_samples;
+    const float* last = interleaved + std::min(total_samples, (block + 1) * block_samples);
+    // Branch-free peak so the compiler can vectorise the scan
+    float peak = 0.0f;
+    for (const float* sample = first; sample != last; ++sample) {
+      peak = std::max(peak, std::abs(*sample));
+    }
+    if (peak <= threshold) {
+      m_bits[block / 64] |= uint64_t{1} << (block % 64);
+      ++m_num_silent;
+    }
+  }
+}
+
+bool SilenceMap::isSilent(int64_t first_frame, int64_t num_frames) const {
+  if (num_frames <= 0 || first_frame < 0 || m_num_silent == 0) {
+    return false;
+  }
+  auto first = static_cast<size_t>(first_frame / BLOCK_FRAMES);
+  auto last = static_cast<size_t>((first_frame + num_frames - 1) / BLOCK_FRAMES);
+  if (last >= m_num_blocks) {
+    return false;
+  }
+
+  // Whole words at a time: a voice buffer spans at most a few blocks
+  for (size_t word = first / 64; word <= last / 64; ++word) {
+    size_t low = word == first / 64 ? first % 64 : 0;
+    size_t high = word == last / 64 ? last % 64 : 63;
+    uint64_t mask = (~uint64_t{0} >> (63 - high)) & (~uint64_t{0} << low);
+    if ((m_bits[word] & mask) != mask) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace orpheus
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace orpheus {
+
+/// Block silence bitmap of a decoded file
+///
+/// One bit per BLOCK_FRAMES frames, set when every sample of every channel in
+/// the block is at or below the threshold. Computed once when a SampleSource is
+/// created; the transport render kernel consults it to skip copying, gain and
+/// routing for voices whose whole buffer lies in silent blocks.
+///
+/// Thread Safety: immutable after construction; query from any thread
+/// (including the audio thread).
+class SilenceMap {
+public:
+  /// Frames summarised by one bit
+  static constexpr uint32_t BLOCK_FRAMES = 256;
+
+  /// Default threshold: -120 dBFS
+  static constexpr float DEFAULT_THRESHOLD = 1e-6f;
+
+  /// Empty map (no block is silent)
+  SilenceMap() = default;
+
+  /// Scan interleaved frames (the last block may be partial)
+  SilenceMap(const float* interleaved, int64_t num_frames, uint16_t num_channels,
+             float threshold = DEFAULT_THRESHOLD);
+
+  size_t numBlocks() const {
+    return m_num_blocks;
+  }
+  size_t numSilentBlocks() const {
+    return m_num_silent;
+  }
+
+  bool isBlockSilent(size_t block) const {
+    return block < m_num_blocks && (m_bits[block / 64] >> (block % 64)) & 1u;
+  }
+
+  /// Whether frames [first_frame, first_frame + num_frames) all lie in silent blocks
+  /// (false if any of them is past the end)
+  bool isSilent(int64_t first_frame, int64_t num_frames) const;
+
+private:
+  std::vector<uint64_t> m_bits; ///< Bit b of word w = block w * 64 + b
+  size_t m_num_blocks = 0;
+  size_t m_num_silent = 0;
+};
+
+} // namespace orpheus
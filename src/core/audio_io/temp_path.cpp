@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+#include "temp_path.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace orpheus {
+
+std::filesystem::path uniqueTempPath(const std::filesystem::path& target) {
+  static std::atomic<uint64_t> next_id{0};
+#if defined(_WIN32)
+  const auto pid = static_cast<uint64_t>(::_getpid());
+#else
+  const auto pid = static_cast<uint64_t>(::getpid());
+#endif
+  auto path = target;
+  path += ".tmp" + std::to_string(pid) + "-" +
+          std::to_string(next_id.fetch_add(1, std::memory_order_relaxed));
+  return path;
+}
+
+} // namespace orpheus
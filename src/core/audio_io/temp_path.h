@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <filesystem>
+
+namespace orpheus {
+
+/// Temporary name beside a file, for writing it and then renaming it into place
+///
+/// Unique across the threads and processes that may share a directory
+/// (process id plus a per-process counter), so concurrent writers of the same
+/// file never truncate each other's partial copy.
+std::filesystem::path uniqueTempPath(const std::filesystem::path& target);
+
+} // namespace orpheus
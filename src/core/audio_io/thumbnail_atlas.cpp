@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: MIT
+#include "thumbnail_atlas.h"
+
+#include "io_scheduler.h"
+#include "mapped_file.h"
+#include "peak_file.h"
+#include "temp_path.h"
+#include "waveform_reduce.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace orpheus {
+
+namespace {
+
+constexpr std::array<char, 8> ATLAS_MAGIC = {'O', 'R', 'P', 'T', 'H', 'U', 'M', 'B'};
+constexpr uint32_t ATLAS_BYTE_ORDER = 0x01020304; // Written in native order
+constexpr uint16_t ENTRY_VALID = 0x1;
+
+/// Fixed atlas header; the entry table follows immediately
+struct AtlasHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t width;
+  uint32_t num_entries;
+  uint64_t strings_offset;
+  uint64_t strings_size;
+  uint8_t reserved[24];
+};
+
+static_assert(sizeof(AtlasHeader) == 64, "Thumbnail atlas header layout must stay 64 bytes");
+
+/// Entry table record, one per file
+struct AtlasEntry {
+  uint64_t path_offset; ///< Offset of the path inside the string table
+  uint64_t data_offset; ///< Byte offset of num_channels * width int16 min/max pairs
+  int64_t num_frames;
+  uint32_t sample_rate;
+  uint32_t path_size;
+  uint16_t num_channels;
+  uint16_t flags; ///< ENTRY_VALID
+  uint32_t reserved;
+};
+
+static_assert(sizeof(AtlasEntry) == 40, "Thumbnail atlas entry layout must stay 40 bytes");
+
+uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+uint64_t pairBytes(uint16_t num_channels, uint32_t width) {
+  return static_cast<uint64_t>(num_channels) * width * 2 * sizeof(int16_t);
+}
+
+} // namespace
+
+Thumbnail ThumbnailAtlas::generate(IAudioFileReader& reader, const std::string& path,
+                                   uint32_t width, int64_t frames_per_probe) {
+  Thumbnail thumbnail;
+  thumbnail.info.filePath = path;
+
+  auto opened = reader.open(path);
+  if (!opened.isOk() || opened.value.num_channels == 0 || width == 0 || frames_per_probe <= 0) {
+    return thumbnail;
+  }
+  const uint16_t num_channels = opened.value.num_channels;
+  const int64_t num_frames = opened.value.duration_samples;
+  thumbnail.info.numChannels = num_channels;
+  thumbnail.info.sampleRate = opened.value.sample_rate;
+  thumbnail.info.durationSamples = num_frames;
+  thumbnail.pairs.assign(static_cast<size_t>(pairBytes(num_channels, width) / sizeof(int16_t)),
+                         0);
+
+  std::vector<float> buffer(static_cast<size_t>(frames_per_probe) * num_channels);
+  std::vector<float> mins(num_channels);
+  std::vector<float> maxs(num_channels);
+  std::vector<double> sum_squares(num_channels);
+
+  // One probe per pixel, read from the start of its span (consecutive when spans are short)
+  bool ok = true;
+  int64_t position = 0;
+  for (uint32_t pixel = 0; pixel < width && ok; ++pixel) {
+    int64_t first = num_frames * pixel / width;
+    int64_t last = num_frames * (pixel + 1) / width;
+    if (last <= first) {
+      continue; // More pixels than frames: left flat
+    }
+    if (first != position) {
+      if (reader.seek(first) != SessionGraphError::OK) {
+        ok = false;
+        break;
+      }
+      position = first;
+    }
+
+    std::fill(mins.begin(), mins.end(), std::numeric_limits<float>::max());
+    std::fill(maxs.begin(), maxs.end(), std::numeric_limits<float>::lowest());
+    std::fill(sum_squares.begin(), sum_squares.end(), 0.0); // Unused: thumbnails hold no RMS
+    int64_t wanted = std::min(last - first, frames_per_probe);
+    int64_t got = 0;
+    while (got < wanted) {
+      auto ticket = sharedIoScheduler().acquire(IoClass::Background);
+      auto read = reader.readSamples(buffer.data(), static_cast<size_t>(wanted - got));
+      ticket.release();
+      if (!read.isOk() || read.value == 0) {
+        ok = read.isOk(); // Short file: keep what was read
+        break;
+      }
+      reduceInterleaved(buffer.data(), read.value, num_channels, mins.data(), maxs.data(),
+                        sum_squares.data());
+      got += static_cast<int64_t>(read.value);
+    }
+    position += got;
+    if (got == 0) {
+      continue;
+    }
+
+    for (uint16_t ch = 0; ch < num_channels; ++ch) {
+      size_t index = (static_cast<size_t>(ch) * width + pixel) * 2;
+      thumbnail.pairs[index] = PeakFile::quantiseDown(mins[ch]);
+      thumbnail.pairs[index + 1] = PeakFile::quantiseUp(maxs[ch]);
+    }
+  }
+  reader.close();
+
+  thumbnail.info.valid = ok;
+  return thumbnail;
+}
+
+std::vector<Thumbnail> ThumbnailAtlas::generateAll(const std::vector<std::string>& paths,
+                                                   const ThumbnailAtlasOptions& options,
+                                                   const AudioFileReaderFactory& factory) {
+  // Decode on worker threads, one decoder each; the caller works too
+  std::vector<Thumbnail> thumbnails(paths.size());
+  std::atomic<size_t> next{0};
+  auto worker = [&] {
+    auto reader = factory();
+    for (size_t i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1)) {
+      thumbnails[i] = generate(*reader, paths[i], options.width, options.framesPerProbe);
+    }
+  };
+
+  size_t threads =
+      options.maxThreads > 0 ? options.maxThreads : std::thread::hardware_concurrency();
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(paths.size(), 1));
+  std::vector<std::thread> helpers;
+  helpers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t) {
+    helpers.emplace_back(worker);
+  }
+  worker();
+  for (auto& helper : helpers) {
+    helper.join();
+  }
+  return thumbnails;
+}
+
+bool ThumbnailAtlas::write(const std::filesystem::path& path,
+                           const std::vector<Thumbnail>& thumbnails, uint32_t width) {
+  if (width == 0 || thumbnails.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  // Lay out the data blocks after the entry table, then the path strings
+  std::vector<AtlasEntry> table;
+  table.reserve(thumbnails.size());
+  uint64_t offset = alignUp(sizeof(AtlasHeader) + thumbnails.size() * sizeof(AtlasEntry), 8);
+  uint64_t strings_size = 0;
+  for (const auto& thumbnail : thumbnails) {
+    const auto& info = thumbnail.info;
+    if (thumbnail.pairs.size() * sizeof(int16_t) != pairBytes(info.numChannels, width) ||
+        info.filePath.size() > std::numeric_limits<uint32_t>::max()) {
+      return false;
+    }
+    AtlasEntry entry{};
+    entry.path_offset = strings_size;
+    entry.path_size = static_cast<uint32_t>(info.filePath.size());
+    entry.data_offset = offset;
+    entry.num_frames = info.durationSamples;
+    entry.sample_rate = info.sampleRate;
+    entry.num_channels = info.numChannels;
+    entry.flags = info.valid ? ENTRY_VALID : 0;
+    table.push_back(entry);
+    offset = alignUp(offset + pairBytes(info.numChannels, width), 8);
+    strings_size += info.filePath.size();
+  }
+
+  AtlasHeader header{};
+  header.magic = ATLAS_MAGIC;
+  header.version = FORMAT_VERSION;
+  header.byte_order = ATLAS_BYTE_ORDER;
+  header.width = width;
+  header.num_entries = static_cast<uint32_t>(thumbnails.size());
+  header.strings_offset = offset;
+  header.strings_size = strings_size;
+
+  std::error_code ec;
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), ec);
+  }
+
+  // Write under a unique temporary name, then rename so readers never map a partial file
+  auto temp_path = uniqueTempPath(path);
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    auto pad_to = [&file](uint64_t target) {
+      static const char zeros[8] = {};
+      auto position = static_cast<uint64_t>(file.tellp());
+      if (target > position) {
+        file.write(zeros, static_cast<std::streamsize>(target - position));
+      }
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()),
+               static_cast<std::streamsize>(table.size() * sizeof(AtlasEntry)));
+    for (size_t i = 0; i < thumbnails.size(); ++i) {
+      const auto& pairs = thumbnails[i].pairs;
+      pad_to(table[i].data_offset);
+      file.write(reinterpret_cast<const char*>(pairs.data()),
+                 static_cast<std::streamsize>(pairs.size() * sizeof(int16_t)));
+    }
+    pad_to(header.strings_offset);
+    for (const auto& thumbnail : thumbnails) {
+      file.write(thumbnail.info.filePath.data(),
+                 static_cast<std::streamsize>(thumbnail.info.filePath.size()));
+    }
+
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<ThumbnailAtlas> ThumbnailAtlas::open(const std::filesystem::path& path) {
+  auto mapped = MappedFile::open(path);
+  if (!mapped || mapped->size() < sizeof(AtlasHeader)) {
+    return nullptr;
+  }
+  const uint64_t file_size = mapped->size();
+  const uint8_t* base = mapped->data();
+
+  AtlasHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (header.magic != ATLAS_MAGIC || header.version != FORMAT_VERSION ||
+      header.byte_order != ATLAS_BYTE_ORDER || header.width == 0 ||
+      header.num_entries > (file_size - sizeof(AtlasHeader)) / sizeof(AtlasEntry) ||
+      header.strings_offset > file_size ||
+      header.strings_size > file_size - header.strings_offset) {
+    return nullptr;
+  }
+  const auto* strings = reinterpret_cast<const char*>(base + header.strings_offset);
+
+  auto atlas = std::unique_ptr<ThumbnailAtlas>(new ThumbnailAtlas());
+  atlas->m_width = header.width;
+  atlas->m_entries.reserve(header.num_entries);
+  for (uint32_t i = 0; i < header.num_entries; ++i) {
+    AtlasEntry entry;
+    std::memcpy(&entry, base + sizeof(AtlasHeader) + i * sizeof(AtlasEntry), sizeof(entry));
+    uint64_t bytes = pairBytes(entry.num_channels, header.width);
+    if (entry.data_offset % 2 != 0 || entry.data_offset > file_size ||
+        bytes > file_size - entry.data_offset || entry.path_offset > header.strings_size ||
+        entry.path_size > header.strings_size - entry.path_offset) {
+      return nullptr; // Truncated or foreign file
+    }
+
+    EntryView view;
+    view.info.filePath.assign(strings + entry.path_offset, entry.path_size);
+    view.info.valid = (entry.flags & ENTRY_VALID) != 0;
+    view.info.numChannels = entry.num_channels;
+    view.info.sampleRate = entry.sample_rate;
+    view.info.durationSamples = entry.num_frames;
+    // Mappings are page aligned and offsets even, so the int16 data is aligned
+    view.pairs = reinterpret_cast<const int16_t*>(base + entry.data_offset);
+    atlas->m_index.emplace(view.info.filePath, atlas->m_entries.size());
+    atlas->m_entries.push_back(std::move(view));
+  }
+
+  atlas->m_file = std::move(mapped);
+  return atlas;
+}
+
+ThumbnailInfo ThumbnailAtlas::info(size_t index) const {
+  return index < m_entries.size() ? m_entries[index].info : ThumbnailInfo{};
+}
+
+std::optional<size_t> ThumbnailAtlas::find(const std::string& filePath) const {
+  auto it = m_index.find(filePath);
+  if (it == m_index.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+const int16_t* ThumbnailAtlas::minMaxPairs(size_t index, uint32_t channel) const {
+  if (index >= m_entries.size() || channel >= m_entries[index].info.numChannels) {
+    return nullptr;
+  }
+  return m_entries[index].pairs + static_cast<size_t>(channel) * m_width * 2;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+SessionGraphError buildThumbnailAtlas(const std::vector<std::string>& filePaths,
+                                      const std::string& atlasPath,
+                                      const ThumbnailAtlasOptions& options) {
+  if (filePaths.empty() || atlasPath.empty() || options.width == 0 ||
+      options.framesPerProbe <= 0) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (!createAudioFileReader()) {
+    return SessionGraphError::NotReady; // Built without a decoder
+  }
+
+  auto thumbnails = ThumbnailAtlas::generateAll(filePaths, options, createAudioFileReader);
+  return ThumbnailAtlas::write(atlasPath, thumbnails, options.width)
+             ? SessionGraphError::OK
+             : SessionGraphError::InternalError;
+}
+
+std::unique_ptr<IThumbnailAtlas> openThumbnailAtlas(const std::string& atlasPath) {
+  return ThumbnailAtlas::open(atlasPath);
+}
+
+} // namespace orpheus
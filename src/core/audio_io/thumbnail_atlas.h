@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "sample_source.h" // AudioFileReaderFactory
+
+#include <orpheus/thumbnail_atlas.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace orpheus {
+
+class MappedFile;
+
+/// Fixed-width min/max thumbnail of one file, before it is written to an atlas
+struct Thumbnail {
+  ThumbnailInfo info;
+  std::vector<int16_t> pairs; ///< [channel * width * 2 + pixel * 2] = min, + 1 = max
+};
+
+/// Memory-mapped `.orpthumbs` thumbnail atlas
+///
+/// Layout (native byte order, recorded in the header):
+/// - 64-byte header: magic, format version, thumbnail width and count, and the
+///   location of the path string table
+/// - Entry table: 40 bytes per file (channel count, sample rate, length, validity,
+///   data offset, path offset)
+/// - Data: every file's int16 min/max pairs, channel by channel, contiguous
+/// - Path string table (UTF-8, not terminated)
+class ThumbnailAtlas : public IThumbnailAtlas {
+public:
+  static constexpr uint32_t FORMAT_VERSION = 1;
+  static constexpr const char* EXTENSION = ".orpthumbs";
+
+  /// Summarise one file with strided reads (see buildThumbnailAtlas())
+  /// @return Thumbnail; info.valid is false (and the pairs flat) if the file is unreadable
+  static Thumbnail generate(IAudioFileReader& reader, const std::string& path, uint32_t width,
+                            int64_t frames_per_probe);
+
+  /// Generate thumbnails for many files in parallel
+  /// @param factory Creates one decoder per worker thread (must not return nullptr)
+  static std::vector<Thumbnail> generateAll(const std::vector<std::string>& paths,
+                                            const ThumbnailAtlasOptions& options,
+                                            const AudioFileReaderFactory& factory);
+
+  /// Write thumbnails of one width (atomically, via a temporary file and rename)
+  /// @return false if the thumbnails are inconsistent or writing failed
+  static bool write(const std::filesystem::path& path, const std::vector<Thumbnail>& thumbnails,
+                    uint32_t width);
+
+  /// Map an atlas
+  /// @return Atlas, or nullptr if missing, from another format version, or corrupt
+  static std::unique_ptr<ThumbnailAtlas> open(const std::filesystem::path& path);
+
+  // IThumbnailAtlas
+  uint32_t thumbnailWidth() const override {
+    return m_width;
+  }
+  size_t size() const override {
+    return m_entries.size();
+  }
+  ThumbnailInfo info(size_t index) const override;
+  std::optional<size_t> find(const std::string& filePath) const override;
+  const int16_t* minMaxPairs(size_t index, uint32_t channel) const override;
+
+private:
+  /// One file inside the mapping
+  struct EntryView {
+    ThumbnailInfo info;
+    const int16_t* pairs; ///< First channel's pairs; channels follow contiguously
+  };
+
+  ThumbnailAtlas() = default;
+
+  std::shared_ptr<MappedFile> m_file;
+  uint32_t m_width = 0;
+  std::vector<EntryView> m_entries;
+  std::unordered_map<std::string, size_t> m_index; ///< Path -> first entry with that path
+};
+
+} // namespace orpheus
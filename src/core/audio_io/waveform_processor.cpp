@@ -1,14 +1,24 @@
 // SPDX-License-Identifier: MIT
 #include <orpheus/audio_file_reader_extended.h>
 
+#include "analysis_scheduler.h"
 #include "audio_file_reader_libsndfile.h"
+#include "file_fingerprint.h"
+#include "io_scheduler.h"
+#include "peak_file.h"
+#include "waveform_pyramid.h"
+#include "waveform_reduce.h"
 
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <filesystem>
+#include <functional>
 #include <limits>
 #include <mutex>
-#include <thread>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace orpheus {
@@ -16,23 +26,36 @@ namespace orpheus {
 /// Extended audio file reader with waveform pre-processing
 ///
 /// Implementation strategy:
-/// - Downsampling: For each pixel, read samplesPerPixel samples and find min/max
-/// - Caching: Store peak levels per channel (computed once)
-/// - Multi-threading: precomputeWaveformAsync() spawns background thread
+/// - LOD pyramid: precomputeWaveformAsync() decodes the file once into a min/max/RMS
+///   WaveformPyramid; queries at >= 64 samples per pixel are then answered from it in
+///   O(pixelWidth) without touching the file
+/// - Peak files: the pyramid is saved as a `.orppeaks` file and mapped on the next open()
+///   of the unchanged file, so reopened files answer zoomed-out queries without decoding
+/// - Downsampling: Without a pyramid, or when zoomed in beyond its finest level, read the
+///   requested range and find min/max/RMS per pixel (at most 64 frames per pixel once built)
+/// - Caching: Store peak levels per channel (computed once, for all channels in one pass)
+/// - Multi-threading: precomputeWaveformAsync() queues a job on the shared, bounded
+///   AnalysisScheduler (no thread per reader); close()/open() cancel it
+/// - Progressive delivery: getWaveformDataProgressive() sends a coarse overview from sparse
+///   reads, then refined tiles as the pyramid fills; the build decodes through its own
+///   decoder, so foreground queries never wait for it
 /// - Memory optimization: For large files, use streaming reads (no full buffer load)
 class AudioFileReaderExtended : public IAudioFileReaderExtended {
 public:
-  AudioFileReaderExtended() : m_base_reader(std::make_unique<AudioFileReaderLibsndfile>()) {}
+  explicit AudioFileReaderExtended(std::filesystem::path peak_directory)
+      : m_base_reader(std::make_unique<AudioFileReaderLibsndfile>()),
+        m_peak_directory(std::move(peak_directory)) {}
 
   ~AudioFileReaderExtended() override {
-    // Wait for background thread to finish
-    if (m_precompute_thread.joinable()) {
-      m_precompute_thread.join();
-    }
+    // Jobs capture this reader
+    cancelAnalysis();
   }
 
   // Forward IAudioFileReader interface to base implementation
   Result<AudioFileMetadata> open(const std::string& file_path) override {
+    // A pending job would analyse the previous file
+    cancelAnalysis();
+
     std::lock_guard<std::mutex> lock(m_mutex);
 
     auto result = m_base_reader->open(file_path);
@@ -41,6 +64,9 @@ public:
       // Reset cached data
       m_peak_levels.clear();
       m_peak_levels.resize(m_metadata.num_channels, -1.0f); // -1.0 = not computed
+      m_pyramid.reset();
+      m_file_path = file_path;
+      loadPeakFile();
     }
     return result;
   }
@@ -54,15 +80,15 @@ public:
   }
 
   void close() override {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // Stop pending jobs (before locking: they take m_mutex)
+    cancelAnalysis();
 
-    // Wait for background thread if running
-    if (m_precompute_thread.joinable()) {
-      m_precompute_thread.join();
-    }
+    std::lock_guard<std::mutex> lock(m_mutex);
 
     m_base_reader->close();
     m_peak_levels.clear();
+    m_pyramid.reset();
+    m_peak_file.reset();
   }
 
   int64_t getCurrentPosition() const override {
@@ -103,8 +129,44 @@ public:
       endSample = m_metadata.duration_samples;
     }
 
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Answer from the LOD pyramid when a level is at least as fine as a pixel
+    if (auto summary = querySummary(startSample, endSample, pixelWidth, channelIndex)) {
+      return std::move(*summary);
+    }
+
     // Use optimized streaming approach: read entire range once and compute pixels
-    return computeWaveformStreaming(startSample, endSample, pixelWidth, channelIndex);
+    auto channels = computeWaveformStreaming(startSample, endSample, pixelWidth);
+    return std::move(channels[channelIndex]);
+  }
+
+  std::vector<WaveformData> getWaveformDataMulti(int64_t startSample, int64_t endSample,
+                                                 uint32_t pixelWidth) override {
+    if (!m_base_reader->isOpen() || pixelWidth == 0 || startSample < 0 ||
+        endSample <= startSample) {
+      return {};
+    }
+
+    // Clamp to file bounds
+    endSample = std::min(endSample, m_metadata.duration_samples);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<WaveformData> channels;
+    for (uint32_t ch = 0; ch < m_metadata.num_channels; ++ch) {
+      auto summary = querySummary(startSample, endSample, pixelWidth, ch);
+      if (!summary) {
+        break; // Zoomed in beyond the finest level
+      }
+      channels.push_back(std::move(*summary));
+    }
+    if (channels.size() == m_metadata.num_channels) {
+      return channels;
+    }
+
+    // One read of the range serves every channel
+    return computeWaveformStreaming(startSample, endSample, pixelWidth);
   }
 
   float getPeakLevel(uint32_t channelIndex) override {
@@ -122,168 +184,582 @@ public:
     if (m_peak_levels[channelIndex] >= 0.0f) {
       return m_peak_levels[channelIndex];
     }
+    if (m_pyramid) {
+      m_peak_levels[channelIndex] = m_pyramid->peakLevel(channelIndex);
+      return m_peak_levels[channelIndex];
+    }
 
-    // Compute peak level for entire file
-    float peak = computePeakLevelForChannel(channelIndex);
-    m_peak_levels[channelIndex] = peak;
-
-    return peak;
+    // One pass over the file caches the peak of every channel
+    computePeakLevels();
+    return m_peak_levels[channelIndex];
   }
 
-  void precomputeWaveformAsync(std::function<void()> callback) override {
+  using IAudioFileReaderExtended::precomputeWaveformAsync; // Keep the deprecated overload
+
+  void precomputeWaveformAsync(WaveformPrecomputeCallback callback) override {
     if (!m_base_reader->isOpen()) {
       if (callback) {
-        callback(); // Call immediately if not open
+        callback(false); // Nothing to build
       }
       return;
     }
 
-    // Check if already running
-    if (m_precompute_running.load(std::memory_order_acquire)) {
+    // A build already queued or running reports to this caller too
+    {
+      std::lock_guard<std::mutex> precomputeLock(m_precompute_mutex);
       if (callback) {
-        callback(); // Already running, call callback immediately
+        m_precompute_callbacks.push_back(std::move(callback));
+      }
+      if (m_precompute_running) {
+        return;
+      }
+      m_precompute_running = true;
+    }
+
+    // Queue on the shared scheduler (bounded workers and disk concurrency)
+    submitJob(
+        [this](const std::atomic<bool>& cancelled) {
+          // One decode pass builds the LOD pyramid and the peak levels
+          bool built = buildPyramid(cancelled);
+          finishPrecompute(built && !cancelled.load(std::memory_order_acquire));
+        },
+        std::nullopt);
+  }
+
+  void getWaveformDataProgressive(int64_t startSample, int64_t endSample, uint32_t pixelWidth,
+                                  WaveformTileCallback callback) override {
+    if (!callback) {
+      return;
+    }
+    if (!m_base_reader->isOpen() || pixelWidth == 0 || startSample < 0 ||
+        endSample <= startSample) {
+      WaveformTile empty;
+      empty.refined = true;
+      empty.complete = true;
+      callback(empty);
+      return;
+    }
+
+    // Clamp to file bounds
+    endSample = std::min(endSample, m_metadata.duration_samples);
+
+    submitJob(
+        [this, startSample, endSample, pixelWidth,
+         callback = std::move(callback)](const std::atomic<bool>& cancelled) {
+          deliverProgressive(startSample, endSample, pixelWidth, callback, cancelled);
+        },
+        AnalysisPriority::Visible);
+  }
+
+  void setAnalysisPriority(AnalysisPriority priority) override {
+    std::lock_guard<std::mutex> jobLock(m_job_mutex);
+    m_priority = priority;
+    for (auto job : m_jobs) {
+      sharedAnalysisScheduler().setPriority(job, priority);
+    }
+  }
+
+private:
+  /// Overview probes spread across a progressive request, and frames read per probe
+  static constexpr uint32_t OVERVIEW_PROBES = 256;
+  static constexpr int64_t OVERVIEW_PROBE_FRAMES = 1024;
+
+  /// Refined tiles per progressive request (at most; fewer if the pyramid fills quickly)
+  static constexpr uint32_t PROGRESSIVE_TILES = 32;
+
+  /// Queue a job on the shared scheduler and track it for cancellation
+  /// @param priority Job priority (nullopt = the reader's, see setAnalysisPriority())
+  void submitJob(AnalysisScheduler::Job job, std::optional<AnalysisPriority> priority) {
+    auto& scheduler = sharedAnalysisScheduler();
+    std::lock_guard<std::mutex> jobLock(m_job_mutex);
+    // Forget jobs that have finished
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+                                [&](AnalysisScheduler::JobId id) {
+                                  return !scheduler.isPending(id);
+                                }),
+                 m_jobs.end());
+    m_jobs.push_back(scheduler.submit(std::move(job), priority.value_or(m_priority)));
+  }
+
+  /// Cancel queued and running jobs and wait until they have stopped
+  void cancelAnalysis() {
+    std::vector<AnalysisScheduler::JobId> jobs;
+    {
+      std::lock_guard<std::mutex> jobLock(m_job_mutex);
+      jobs.swap(m_jobs);
+    }
+    for (auto job : jobs) {
+      sharedAnalysisScheduler().cancel(job);
+    }
+    for (auto job : jobs) {
+      sharedAnalysisScheduler().wait(job);
+    }
+    // A precompute job dropped from the queue never reported
+    finishPrecompute(false);
+  }
+
+  /// End the current precompute request and call back everyone waiting on it
+  void finishPrecompute(bool built) {
+    std::vector<WaveformPrecomputeCallback> callbacks;
+    {
+      std::lock_guard<std::mutex> precomputeLock(m_precompute_mutex);
+      callbacks.swap(m_precompute_callbacks);
+      m_precompute_running = false;
+    }
+    for (auto& callback : callbacks) {
+      callback(built);
+    }
+  }
+
+  /// Body of a getWaveformDataProgressive() job
+  void deliverProgressive(int64_t startSample, int64_t endSample, uint32_t pixelWidth,
+                          const WaveformTileCallback& callback,
+                          const std::atomic<bool>& cancelled) {
+    auto deliver = [&](uint32_t firstPixel, bool refined, bool complete,
+                       std::vector<WaveformData> channels) {
+      if (cancelled.load(std::memory_order_acquire)) {
+        return;
       }
+      WaveformTile tile;
+      tile.firstPixel = firstPixel;
+      tile.refined = refined;
+      tile.complete = complete;
+      tile.channels = std::move(channels);
+      callback(tile);
+    };
+
+    // Already summarised, or zoomed in beyond the pyramid: one exact tile
+    double samplesPerPixel =
+        static_cast<double>(endSample - startSample) / static_cast<double>(pixelWidth);
+    bool zoomedIn = endSample <= startSample ||
+                    WaveformPyramid::levelForSamplesPerPixel(samplesPerPixel) ==
+                        WaveformPyramid::NUM_LEVELS;
+    // Tiles are built under the reader lock and delivered after releasing it, so the
+    // callback may query this reader (e.g. to repaint) and a slow one stalls nothing
+    std::optional<std::vector<WaveformData>> exact;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (zoomedIn || m_pyramid || m_peak_file) {
+        exact = zoomedIn ? computeWaveformStreaming(startSample, endSample, pixelWidth)
+                         : summaryChannels(startSample, endSample, pixelWidth);
+      }
+    }
+    if (exact) {
+      deliver(0, true, true, std::move(*exact));
       return;
     }
 
-    // Wait for previous thread if exists
-    if (m_precompute_thread.joinable()) {
-      m_precompute_thread.join();
+    // Coarse overview first, then refined tiles left to right as the pyramid fills
+    if (auto overview = readOverview(startSample, endSample, pixelWidth, cancelled)) {
+      deliver(0, false, false, std::move(*overview));
     }
 
-    // Spawn background thread
-    m_precompute_running.store(true, std::memory_order_release);
+    const int64_t totalFrames = m_metadata.duration_samples;
+    const uint32_t tileStep = std::max<uint32_t>(1, pixelWidth / PROGRESSIVE_TILES);
+    uint32_t delivered = 0;
+    auto progress = [&](const WaveformPyramid& pyramid) {
+      uint32_t ready = pyramid.completePixels(startSample, endSample, pixelWidth);
+      if (ready <= delivered || (ready < pixelWidth && ready - delivered < tileStep)) {
+        return;
+      }
+      std::vector<WaveformData> channels;
+      for (uint32_t ch = 0; ch < pyramid.numChannels(); ++ch) {
+        channels.push_back(pyramid.queryPixels(startSample, endSample, pixelWidth, ch, delivered,
+                                               ready, totalFrames));
+      }
+      deliver(delivered, true, ready == pixelWidth, std::move(channels));
+      delivered = ready;
+    };
+    if (!buildPyramid(cancelled, progress) || delivered == pixelWidth) {
+      return;
+    }
+
+    // Another job built the pyramid meanwhile
+    std::vector<WaveformData> channels;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      channels = summaryChannels(startSample, endSample, pixelWidth);
+    }
+    deliver(0, true, true, std::move(channels));
+  }
+
+  /// Coarse waveform from short reads spread across the range, one per group of pixels
+  ///
+  /// Uses a second decoder on the same file, so foreground queries are not blocked.
+  /// Each pixel reports the probe of its group: an estimate that can miss transients.
+  /// @return Full-width waveform per channel, or nullopt if cancelled or unreadable
+  std::optional<std::vector<WaveformData>> readOverview(int64_t startSample, int64_t endSample,
+                                                        uint32_t pixelWidth,
+                                                        const std::atomic<bool>& cancelled) {
+    std::string path;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      path = m_file_path;
+    }
+    AudioFileReaderLibsndfile probeReader;
+    auto opened = probeReader.open(path);
+    if (!opened.isOk() || opened.value.num_channels != m_metadata.num_channels) {
+      return std::nullopt;
+    }
+
+    const uint16_t numChannels = m_metadata.num_channels;
+    std::vector<WaveformData> results(numChannels);
+    for (uint32_t ch = 0; ch < numChannels; ++ch) {
+      auto& result = results[ch];
+      result.startSample = startSample;
+      result.endSample = endSample;
+      result.pixelWidth = pixelWidth;
+      result.channelIndex = ch;
+      result.minPeaks.assign(pixelWidth, 0.0f);
+      result.maxPeaks.assign(pixelWidth, 0.0f);
+      result.rms.assign(pixelWidth, 0.0f);
+    }
 
-    m_precompute_thread = std::thread([this, callback]() {
-      // Pre-compute peak levels for all channels
+    const int64_t totalSamples = endSample - startSample;
+    const uint32_t probes = std::min(pixelWidth, OVERVIEW_PROBES);
+    const int64_t probeFrames =
+        std::clamp<int64_t>(totalSamples / probes, 1, OVERVIEW_PROBE_FRAMES);
+    std::vector<float> buffer(static_cast<size_t>(probeFrames) * numChannels);
+    std::vector<float> mins(numChannels);
+    std::vector<float> maxs(numChannels);
+    std::vector<double> sumSquares(numChannels);
+
+    for (uint32_t probe = 0; probe < probes; ++probe) {
+      if (cancelled.load(std::memory_order_acquire)) {
+        return std::nullopt;
+      }
+      // Pixels [firstPixel, lastPixel) share this probe, read from the start of the group
+      uint32_t firstPixel = static_cast<uint32_t>(uint64_t{probe} * pixelWidth / probes);
+      uint32_t lastPixel = static_cast<uint32_t>(uint64_t{probe + 1} * pixelWidth / probes);
+      int64_t position = startSample + totalSamples * firstPixel / pixelWidth;
+      if (probeReader.seek(position) != SessionGraphError::OK) {
+        continue;
+      }
+      auto ticket = sharedIoScheduler().acquire(IoClass::Interactive);
+      auto readResult = probeReader.readSamples(
+          buffer.data(),
+          static_cast<size_t>(std::min(probeFrames, endSample - position)));
+      ticket.release();
+      if (!readResult.isOk() || readResult.value == 0) {
+        continue;
+      }
+
+      std::fill(mins.begin(), mins.end(), std::numeric_limits<float>::max());
+      std::fill(maxs.begin(), maxs.end(), std::numeric_limits<float>::lowest());
+      std::fill(sumSquares.begin(), sumSquares.end(), 0.0);
+      reduceInterleaved(buffer.data(), readResult.value, numChannels, mins.data(), maxs.data(),
+                        sumSquares.data());
+      for (uint32_t ch = 0; ch < numChannels; ++ch) {
+        auto rms = static_cast<float>(
+            std::sqrt(sumSquares[ch] / static_cast<double>(readResult.value)));
+        auto& result = results[ch];
+        std::fill(result.minPeaks.begin() + firstPixel, result.minPeaks.begin() + lastPixel,
+                  mins[ch]);
+        std::fill(result.maxPeaks.begin() + firstPixel, result.maxPeaks.begin() + lastPixel,
+                  maxs[ch]);
+        std::fill(result.rms.begin() + firstPixel, result.rms.begin() + lastPixel, rms);
+      }
+    }
+    return results;
+  }
+
+  /// Map a current peak file for the open file, if one was saved earlier (caller holds m_mutex)
+  ///
+  /// Only consults the fingerprint index, keyed by path, size and modification time: a file
+  /// not indexed yet is hashed by the build job that writes its peak file, never here.
+  void loadPeakFile() {
+    m_peak_file.reset();
+    m_fingerprint = sharedFingerprintIndex().lookup(m_file_path);
+    if (!m_fingerprint) {
+      return;
+    }
+
+    auto peakFile =
+        PeakFile::open(PeakFile::pathFor(m_file_path, *m_fingerprint, m_peak_directory),
+                       *m_fingerprint);
+    if (!peakFile || peakFile->numChannels() != m_metadata.num_channels ||
+        peakFile->numFrames() != m_metadata.duration_samples) {
+      return;
+    }
+    for (uint32_t ch = 0; ch < m_metadata.num_channels; ++ch) {
+      m_peak_levels[ch] = peakFile->peakLevel(ch);
+    }
+    m_peak_file = std::move(peakFile);
+  }
+
+  /// Decode the whole file once into the LOD pyramid and save it as a peak file
+  /// (no-op if already built or mapped from a peak file)
+  ///
+  /// Decodes through a second decoder on the same file and takes the reader lock only
+  /// to start and to publish, so foreground queries never wait behind the build's
+  /// Background I/O tickets; one build runs at a time per reader.
+  /// @param progress Called after each chunk and once finished (no reader lock held)
+  /// @return true if a pyramid or peak file is available afterwards
+  bool buildPyramid(const std::atomic<bool>& cancelled,
+                    const std::function<void(const WaveformPyramid&)>& progress = nullptr) {
+    std::lock_guard<std::mutex> buildLock(m_build_mutex);
+    uint16_t numChannels;
+    std::string buildPath;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_pyramid || m_peak_file) {
+        return true; // Possibly built by the job we waited for
+      }
+      if (!m_base_reader->isOpen()) {
+        return false;
+      }
+      numChannels = m_metadata.num_channels;
+      buildPath = m_file_path;
+    }
+
+    AudioFileReaderLibsndfile buildReader;
+    auto opened = buildReader.open(buildPath);
+    if (!opened.isOk() || opened.value.num_channels != numChannels) {
+      return false;
+    }
+
+    auto pyramid = std::make_shared<WaveformPyramid>(numChannels);
+    const size_t CHUNK_SIZE = 32768; // 32K frames at a time
+    std::vector<float> buffer(CHUNK_SIZE * numChannels);
+    for (;;) {
+      if (cancelled.load(std::memory_order_acquire)) {
+        return false;
+      }
+      auto ticket = sharedIoScheduler().acquire(IoClass::Background);
+      auto readResult = buildReader.readSamples(buffer.data(), CHUNK_SIZE);
+      ticket.release();
+      if (!readResult.isOk() || readResult.value == 0) {
+        break; // EOF or error
+      }
+      pyramid->append(buffer.data(), readResult.value);
+      if (progress) {
+        progress(*pyramid);
+      }
+    }
+    pyramid->finish();
+
+    // Publish before the last progress call, so queries made once it reports the
+    // whole range are answered from the pyramid
+    std::optional<FileFingerprint> fingerprint;
+    std::string path;
+    uint32_t sampleRate = 0;
+    bool whole = false;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
       for (uint32_t ch = 0; ch < m_metadata.num_channels; ++ch) {
-        getPeakLevel(ch); // This will cache the result
+        m_peak_levels[ch] = pyramid->peakLevel(ch);
       }
+      m_pyramid = pyramid;
+      fingerprint = m_fingerprint;
+      path = m_file_path;
+      sampleRate = m_metadata.sample_rate;
+      whole = pyramid->numFrames() == m_metadata.duration_samples;
+    }
+    if (progress) {
+      progress(*pyramid);
+    }
 
-      // TODO: Pre-compute LOD pyramid at multiple resolutions
-      // For now, we just compute peak levels
-      // Future enhancement: Store waveform data at 100px, 400px, 1600px, etc.
+    // Save the peak file without the reader lock. A file open() found no fingerprint
+    // for is hashed here (the whole file is read); the index then serves later opens.
+    // Best effort: without a saved peak file the next open simply rebuilds the pyramid
+    if (!whole) {
+      return true;
+    }
+    if (!fingerprint && !cancelled.load(std::memory_order_acquire)) {
+      fingerprint = sharedFingerprintIndex().fingerprint(path);
+    }
+    if (fingerprint) {
+      PeakFile::write(PeakFile::pathFor(path, *fingerprint, m_peak_directory), *pyramid,
+                      *fingerprint, sampleRate);
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_fingerprint = std::move(fingerprint);
+    }
+    return true;
+  }
 
-      m_precompute_running.store(false, std::memory_order_release);
+  /// Answer from the peak file or pyramid if a level is at least as fine as a pixel
+  /// (caller holds m_mutex)
+  std::optional<WaveformData> querySummary(int64_t startSample, int64_t endSample,
+                                           uint32_t pixelWidth, uint32_t channelIndex) const {
+    double samplesPerPixel =
+        static_cast<double>(endSample - startSample) / static_cast<double>(pixelWidth);
+    if (WaveformPyramid::levelForSamplesPerPixel(samplesPerPixel) == WaveformPyramid::NUM_LEVELS) {
+      return std::nullopt;
+    }
+    if (m_peak_file) {
+      return m_peak_file->query(startSample, endSample, pixelWidth, channelIndex);
+    }
+    if (m_pyramid) {
+      return m_pyramid->query(startSample, endSample, pixelWidth, channelIndex);
+    }
+    return std::nullopt;
+  }
 
-      // Call callback on completion
-      if (callback) {
-        callback();
+  /// Every channel answered by querySummary() (caller holds m_mutex and has checked the
+  /// zoom level)
+  std::vector<WaveformData> summaryChannels(int64_t startSample, int64_t endSample,
+                                            uint32_t pixelWidth) const {
+    std::vector<WaveformData> channels;
+    for (uint32_t ch = 0; ch < m_metadata.num_channels; ++ch) {
+      if (auto summary = querySummary(startSample, endSample, pixelWidth, ch)) {
+        channels.push_back(std::move(*summary));
       }
-    });
+    }
+    return channels;
   }
 
-private:
   /// Optimized streaming waveform computation
-  /// Reads entire range once and computes all pixels in a single pass
-  WaveformData computeWaveformStreaming(int64_t startSample, int64_t endSample, uint32_t pixelWidth,
-                                        uint32_t channelIndex) {
-    WaveformData result;
-    result.startSample = startSample;
-    result.endSample = endSample;
-    result.pixelWidth = pixelWidth;
-    result.channelIndex = channelIndex;
-    result.minPeaks.resize(pixelWidth, std::numeric_limits<float>::max());
-    result.maxPeaks.resize(pixelWidth, std::numeric_limits<float>::lowest());
+  /// Reads the range once and reduces every channel per pixel in a single pass. Pixel p
+  /// covers range frames [ceil(p * total / width), ceil((p + 1) * total / width)), found by
+  /// integer stepping once per pixel; each pixel's frames are reduced with SIMD.
+  std::vector<WaveformData> computeWaveformStreaming(int64_t startSample, int64_t endSample,
+                                                     uint32_t pixelWidth) {
+    const uint16_t numChannels = m_metadata.num_channels;
+    std::vector<WaveformData> results(numChannels);
+    for (uint32_t ch = 0; ch < numChannels; ++ch) {
+      auto& result = results[ch];
+      result.startSample = startSample;
+      result.endSample = endSample;
+      result.pixelWidth = pixelWidth;
+      result.channelIndex = ch;
+      result.minPeaks.assign(pixelWidth, 0.0f);
+      result.maxPeaks.assign(pixelWidth, 0.0f);
+      result.rms.assign(pixelWidth, 0.0f);
+    }
 
-    // Seek to start position
-    SessionGraphError seekErr = m_base_reader->seek(startSample);
-    if (seekErr != SessionGraphError::OK) {
-      // Fill with zeros on error
-      std::fill(result.minPeaks.begin(), result.minPeaks.end(), 0.0f);
-      std::fill(result.maxPeaks.begin(), result.maxPeaks.end(), 0.0f);
-      return result;
+    // Seek to start position (zeros on error)
+    if (endSample <= startSample || m_base_reader->seek(startSample) != SessionGraphError::OK) {
+      return results;
     }
 
-    int64_t totalSamples = endSample - startSample;
-    double samplesPerPixel = static_cast<double>(totalSamples) / static_cast<double>(pixelWidth);
+    const int64_t totalSamples = endSample - startSample;
+    auto pixelEnd = [&](uint32_t pixel) {
+      return (static_cast<int64_t>(pixel + 1) * totalSamples + pixelWidth - 1) / pixelWidth;
+    };
+
+    // Running summary of the current pixel, per channel
+    std::vector<float> mins(numChannels);
+    std::vector<float> maxs(numChannels);
+    std::vector<double> sumSquares(numChannels);
+    std::vector<float> peaks(numChannels, 0.0f);
+    int64_t pixelFrames = 0;
+    auto resetPixel = [&]() {
+      std::fill(mins.begin(), mins.end(), std::numeric_limits<float>::max());
+      std::fill(maxs.begin(), maxs.end(), std::numeric_limits<float>::lowest());
+      std::fill(sumSquares.begin(), sumSquares.end(), 0.0);
+      pixelFrames = 0;
+    };
+    auto emitPixel = [&](uint32_t pixel) {
+      if (pixelFrames == 0) {
+        return; // More pixels than frames: left at zero
+      }
+      for (uint32_t ch = 0; ch < numChannels; ++ch) {
+        results[ch].minPeaks[pixel] = mins[ch];
+        results[ch].maxPeaks[pixel] = maxs[ch];
+        results[ch].rms[pixel] = static_cast<float>(
+            std::sqrt(sumSquares[ch] / static_cast<double>(pixelFrames)));
+        peaks[ch] = std::max({peaks[ch], std::abs(mins[ch]), std::abs(maxs[ch])});
+      }
+    };
+    resetPixel();
 
     // Read in large chunks for better I/O performance
     const size_t CHUNK_SIZE = 32768; // 32K frames at a time
-    std::vector<float> buffer(CHUNK_SIZE * m_metadata.num_channels);
+    std::vector<float> buffer(CHUNK_SIZE * numChannels);
 
+    uint32_t pixel = 0;
+    int64_t pixelStop = pixelEnd(0);
     int64_t samplesProcessed = 0;
     while (samplesProcessed < totalSamples) {
       size_t samplesToRead = static_cast<size_t>(
           std::min(static_cast<int64_t>(CHUNK_SIZE), totalSamples - samplesProcessed));
 
+      auto ticket = sharedIoScheduler().acquire(IoClass::Interactive);
       auto readResult = m_base_reader->readSamples(buffer.data(), samplesToRead);
+      ticket.release();
       if (!readResult.isOk() || readResult.value == 0) {
         break; // EOF or error
       }
-
-      size_t framesRead = readResult.value;
-
-      // Process each sample and update corresponding pixel
-      for (size_t i = 0; i < framesRead; ++i) {
-        int64_t globalSampleIndex = samplesProcessed + static_cast<int64_t>(i);
-        uint32_t pixelIndex = static_cast<uint32_t>(globalSampleIndex / samplesPerPixel);
-
-        if (pixelIndex >= pixelWidth) {
-          pixelIndex = pixelWidth - 1; // Clamp to last pixel
+      const auto framesRead = static_cast<int64_t>(readResult.value);
+
+      // Split the chunk at pixel boundaries and reduce each run for all channels
+      int64_t offset = 0;
+      while (offset < framesRead && pixel < pixelWidth) {
+        int64_t run = std::min(framesRead - offset, pixelStop - (samplesProcessed + offset));
+        reduceInterleaved(buffer.data() + static_cast<size_t>(offset) * numChannels,
+                          static_cast<size_t>(run), numChannels, mins.data(), maxs.data(),
+                          sumSquares.data());
+        pixelFrames += run;
+        offset += run;
+        if (samplesProcessed + offset == pixelStop) {
+          emitPixel(pixel);
+          resetPixel();
+          if (++pixel < pixelWidth) {
+            pixelStop = pixelEnd(pixel);
+          }
         }
-
-        float sample = buffer[i * m_metadata.num_channels + channelIndex];
-        result.minPeaks[pixelIndex] = std::min(result.minPeaks[pixelIndex], sample);
-        result.maxPeaks[pixelIndex] = std::max(result.maxPeaks[pixelIndex], sample);
       }
 
       samplesProcessed += framesRead;
     }
+    if (pixel < pixelWidth) {
+      emitPixel(pixel); // Short read: keep what the last pixel saw
+    }
 
-    // Handle pixels that had no samples (edge case)
-    for (uint32_t i = 0; i < pixelWidth; ++i) {
-      if (result.minPeaks[i] == std::numeric_limits<float>::max()) {
-        result.minPeaks[i] = 0.0f;
-        result.maxPeaks[i] = 0.0f;
+    // A whole-file pass also yields every channel's peak level
+    if (startSample == 0 && samplesProcessed == m_metadata.duration_samples) {
+      for (uint32_t ch = 0; ch < numChannels; ++ch) {
+        m_peak_levels[ch] = peaks[ch];
       }
     }
 
-    return result;
+    return results;
   }
 
-  /// Compute peak level for entire file (single channel)
-  float computePeakLevelForChannel(uint32_t channelIndex) {
+  /// Compute peak levels for every channel in one pass over the file
+  void computePeakLevels() {
     // Save current position
     int64_t originalPosition = m_base_reader->getCurrentPosition();
 
     // Seek to start
     SessionGraphError seekErr = m_base_reader->seek(0);
     if (seekErr != SessionGraphError::OK) {
-      return 0.0f;
+      std::fill(m_peak_levels.begin(), m_peak_levels.end(), 0.0f);
+      return;
     }
 
-    // Read entire file in chunks and find peak
-    const size_t CHUNK_SIZE = 8192; // Read 8K frames at a time
-    std::vector<float> buffer(CHUNK_SIZE * m_metadata.num_channels);
+    // Read entire file in chunks and fold every channel's min/max
+    const uint16_t numChannels = m_metadata.num_channels;
+    const size_t CHUNK_SIZE = 32768; // 32K frames at a time
+    std::vector<float> buffer(CHUNK_SIZE * numChannels);
+    std::vector<float> mins(numChannels, std::numeric_limits<float>::max());
+    std::vector<float> maxs(numChannels, std::numeric_limits<float>::lowest());
+    std::vector<double> sumSquares(numChannels, 0.0);
 
-    float peak = 0.0f;
     int64_t totalSamplesProcessed = 0;
-
     while (totalSamplesProcessed < m_metadata.duration_samples) {
       size_t samplesToRead = static_cast<size_t>(std::min(
           static_cast<int64_t>(CHUNK_SIZE), m_metadata.duration_samples - totalSamplesProcessed));
 
+      auto ticket = sharedIoScheduler().acquire(IoClass::Interactive);
       auto result = m_base_reader->readSamples(buffer.data(), samplesToRead);
+      ticket.release();
       if (!result.isOk() || result.value == 0) {
         break; // EOF or error
       }
 
-      size_t framesRead = result.value;
-
-      // Extract channel data and find peak
-      for (size_t i = 0; i < framesRead; ++i) {
-        float sample = buffer[i * m_metadata.num_channels + channelIndex];
-        peak = std::max(peak, std::abs(sample));
-      }
+      reduceInterleaved(buffer.data(), result.value, numChannels, mins.data(), maxs.data(),
+                        sumSquares.data());
+      totalSamplesProcessed += static_cast<int64_t>(result.value);
+    }
 
-      totalSamplesProcessed += framesRead;
+    for (uint32_t ch = 0; ch < numChannels; ++ch) {
+      m_peak_levels[ch] =
+          totalSamplesProcessed > 0 ? std::max(std::abs(mins[ch]), std::abs(maxs[ch])) : 0.0f;
     }
 
     // Restore original position
     m_base_reader->seek(originalPosition);
-
-    return peak;
   }
 
   std::unique_ptr<AudioFileReaderLibsndfile> m_base_reader;
@@ -291,16 +767,29 @@ private:
 
   // Caching
   std::vector<float> m_peak_levels; ///< Cached peak levels per channel (-1.0 = not computed)
-  std::mutex m_mutex;               ///< Protects peak_levels and precompute state
-
-  // Background precomputation
-  std::thread m_precompute_thread;
-  std::atomic<bool> m_precompute_running{false};
+  std::shared_ptr<const WaveformPyramid> m_pyramid; ///< LOD pyramid (null until precomputed)
+  std::shared_ptr<const PeakFile> m_peak_file;      ///< Mapped peak file (null if none was current)
+  std::filesystem::path m_peak_directory;           ///< Where .orppeaks files are kept
+  std::string m_file_path;
+  std::optional<FileFingerprint> m_fingerprint; ///< Content identity of the open file
+  std::mutex m_mutex; ///< Protects base reader position, caches and pyramid
+
+  // Background analysis (runs on sharedAnalysisScheduler())
+  std::mutex m_build_mutex; ///< Serialises buildPyramid()
+  std::mutex m_job_mutex;   ///< Protects m_jobs and m_priority
+  std::vector<AnalysisScheduler::JobId> m_jobs; ///< Queued or running jobs of this reader
+  AnalysisPriority m_priority = AnalysisPriority::Normal;
+  std::mutex m_precompute_mutex; ///< Protects the precompute request below
+  bool m_precompute_running = false;
+  std::vector<WaveformPrecomputeCallback> m_precompute_callbacks; ///< Waiting on the request
 };
 
 // Factory function
-std::unique_ptr<IAudioFileReaderExtended> createAudioFileReaderExtended() {
-  return std::make_unique<AudioFileReaderExtended>();
+std::unique_ptr<IAudioFileReaderExtended>
+createAudioFileReaderExtended(const std::string& peakDirectory) {
+  return std::make_unique<AudioFileReaderExtended>(
+      peakDirectory.empty() ? defaultCacheDirectory() / "peaks"
+                            : std::filesystem::path(peakDirectory));
 }
 
 } // namespace orpheus
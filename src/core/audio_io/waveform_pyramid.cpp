@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: MIT
+#include "waveform_pyramid.h"
+
+#include "waveform_reduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace orpheus {
+
+WaveformPyramid::WaveformPyramid(uint16_t num_channels)
+    : m_num_channels(std::max<uint16_t>(num_channels, 1)), m_peaks(m_num_channels, 0.0f) {
+  for (size_t level = 0; level < NUM_LEVELS; ++level) {
+    m_accumulators[level].min.resize(m_num_channels);
+    m_accumulators[level].max.resize(m_num_channels);
+    m_accumulators[level].sum_squares.resize(m_num_channels);
+    resetAccumulators(level);
+  }
+}
+
+void WaveformPyramid::resetAccumulators(size_t level) {
+  auto& acc = m_accumulators[level];
+  std::fill(acc.min.begin(), acc.min.end(), std::numeric_limits<float>::max());
+  std::fill(acc.max.begin(), acc.max.end(), std::numeric_limits<float>::lowest());
+  std::fill(acc.sum_squares.begin(), acc.sum_squares.end(), 0.0);
+  m_accumulated_frames[level] = 0;
+}
+
+void WaveformPyramid::append(const float* interleaved, size_t num_frames) {
+  if (m_finished) {
+    return;
+  }
+
+  // Reduce whole runs up to each finest-bucket boundary, all channels at once
+  auto& acc = m_accumulators[0];
+  for (size_t frame = 0; frame < num_frames;) {
+    size_t run = std::min<size_t>(num_frames - frame,
+                                  LEVEL_BUCKET_FRAMES[0] - m_accumulated_frames[0]);
+    reduceInterleaved(interleaved + frame * m_num_channels, run, m_num_channels, acc.min.data(),
+                      acc.max.data(), acc.sum_squares.data());
+    m_accumulated_frames[0] += static_cast<uint32_t>(run);
+    frame += run;
+    if (m_accumulated_frames[0] == LEVEL_BUCKET_FRAMES[0]) {
+      emitBucket(0);
+    }
+  }
+  m_num_frames += static_cast<int64_t>(num_frames);
+}
+
+void WaveformPyramid::emitBucket(size_t level) {
+  uint32_t frames = m_accumulated_frames[level];
+  bool has_parent = level + 1 < NUM_LEVELS;
+
+  const auto& acc = m_accumulators[level];
+  for (uint16_t ch = 0; ch < m_num_channels; ++ch) {
+    float rms = static_cast<float>(std::sqrt(acc.sum_squares[ch] / frames));
+    m_levels[level].push_back({acc.min[ch], acc.max[ch], rms});
+    if (level == 0) {
+      m_peaks[ch] = std::max({m_peaks[ch], std::abs(acc.min[ch]), std::abs(acc.max[ch])});
+    }
+
+    // Fold into the open bucket one level up
+    if (has_parent) {
+      auto& parent = m_accumulators[level + 1];
+      parent.min[ch] = std::min(parent.min[ch], acc.min[ch]);
+      parent.max[ch] = std::max(parent.max[ch], acc.max[ch]);
+      parent.sum_squares[ch] += acc.sum_squares[ch];
+    }
+  }
+  resetAccumulators(level);
+
+  if (has_parent) {
+    m_accumulated_frames[level + 1] += frames;
+    if (m_accumulated_frames[level + 1] == LEVEL_BUCKET_FRAMES[level + 1]) {
+      emitBucket(level + 1);
+    }
+  }
+}
+
+void WaveformPyramid::finish() {
+  if (m_finished) {
+    return;
+  }
+  // Finest first: each partial bucket folds into the next level before it is flushed
+  for (size_t level = 0; level < NUM_LEVELS; ++level) {
+    if (m_accumulated_frames[level] > 0) {
+      emitBucket(level);
+    }
+  }
+  m_finished = true;
+}
+
+size_t WaveformPyramid::levelForSamplesPerPixel(double samples_per_pixel) {
+  for (size_t level = NUM_LEVELS; level-- > 0;) {
+    if (static_cast<double>(LEVEL_BUCKET_FRAMES[level]) <= samples_per_pixel) {
+      return level;
+    }
+  }
+  return NUM_LEVELS;
+}
+
+WaveformData WaveformPyramid::query(int64_t start_sample, int64_t end_sample,
+                                    uint32_t pixel_width, uint32_t channel) const {
+  std::array<size_t, NUM_LEVELS> num_buckets{};
+  for (size_t level = 0; level < NUM_LEVELS; ++level) {
+    num_buckets[level] = numBuckets(level);
+  }
+  return queryLevels(m_num_frames, m_num_channels, num_buckets, start_sample, end_sample,
+                     pixel_width, channel, 0, pixel_width,
+                     [&](size_t level, size_t index) -> WaveformBucket {
+                       return bucket(level, index, channel);
+                     });
+}
+
+WaveformData WaveformPyramid::queryPixels(int64_t start_sample, int64_t end_sample,
+                                          uint32_t pixel_width, uint32_t channel,
+                                          uint32_t first_pixel, uint32_t last_pixel,
+                                          int64_t total_frames) const {
+  std::array<size_t, NUM_LEVELS> num_buckets{};
+  for (size_t level = 0; level < NUM_LEVELS; ++level) {
+    num_buckets[level] = numBuckets(level);
+  }
+  return queryLevels(total_frames, m_num_channels, num_buckets, start_sample, end_sample,
+                     pixel_width, channel, first_pixel, last_pixel,
+                     [&](size_t level, size_t index) -> WaveformBucket {
+                       return bucket(level, index, channel);
+                     });
+}
+
+uint32_t WaveformPyramid::completePixels(int64_t start_sample, int64_t end_sample,
+                                         uint32_t pixel_width) const {
+  if (pixel_width == 0 || end_sample <= start_sample) {
+    return 0;
+  }
+  if (m_finished) {
+    return pixel_width;
+  }
+
+  double samples_per_pixel =
+      static_cast<double>(end_sample - start_sample) / static_cast<double>(pixel_width);
+  size_t level = levelForSamplesPerPixel(samples_per_pixel);
+  if (level == NUM_LEVELS) {
+    level = 0;
+  }
+  // Built frames end on a bucket boundary, so a pixel is complete once its edge is reached
+  const int64_t built = static_cast<int64_t>(numBuckets(level)) * LEVEL_BUCKET_FRAMES[level];
+  auto pixel_end = [&](uint32_t pixel) {
+    return pixel + 1 == pixel_width
+               ? end_sample
+               : start_sample + static_cast<int64_t>((pixel + 1) * samples_per_pixel);
+  };
+
+  // Pixel ends increase monotonically: binary search for the first incomplete pixel
+  uint32_t low = 0;
+  uint32_t high = pixel_width;
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    if (pixel_end(mid) <= built) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+float WaveformPyramid::peakLevel(uint32_t channel) const {
+  return channel < m_num_channels ? m_peaks[channel] : 0.0f;
+}
+
+size_t WaveformPyramid::memoryBytes() const {
+  size_t bytes = 0;
+  for (const auto& level : m_levels) {
+    bytes += level.capacity() * sizeof(WaveformBucket);
+  }
+  return bytes;
+}
+
+} // namespace orpheus
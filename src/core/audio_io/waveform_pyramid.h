@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/audio_file_reader_extended.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace orpheus {
+
+/// Summary of one bucket of consecutive frames on one channel
+struct WaveformBucket {
+  float min; ///< Minimum sample value
+  float max; ///< Maximum sample value
+  float rms; ///< Root mean square of the samples
+};
+
+/// Multi-resolution min/max/RMS summary of an audio file (LOD pyramid)
+///
+/// Built in a single pass over the decoded audio: frames are streamed in with
+/// append() and every level is filled as its buckets complete (each level
+/// folds four buckets of the level below). Once built, a waveform query at any
+/// zoom reads the coarsest level whose buckets are no larger than a pixel, so
+/// it costs O(pixelWidth) regardless of the range length and never decodes
+/// audio.
+///
+/// Memory: 12 bytes per bucket per channel, dominated by the finest level
+/// (~19 MB per channel-hour at 48 kHz).
+///
+/// Thread Safety: build on one thread; after finish() the pyramid is
+/// immutable and may be queried from any number of threads.
+class WaveformPyramid {
+public:
+  static constexpr size_t NUM_LEVELS = 4;
+
+  /// Frames per bucket at each level (finest first); each is 4x the previous
+  static constexpr std::array<uint32_t, NUM_LEVELS> LEVEL_BUCKET_FRAMES = {64, 256, 1024, 4096};
+
+  /// @param num_channels Channels in the interleaved frames passed to append()
+  explicit WaveformPyramid(uint16_t num_channels);
+
+  /// Add interleaved frames (builder thread)
+  void append(const float* interleaved, size_t num_frames);
+
+  /// Flush partial trailing buckets; no frames may be appended afterwards
+  void finish();
+
+  bool isFinished() const {
+    return m_finished;
+  }
+  uint16_t numChannels() const {
+    return m_num_channels;
+  }
+  int64_t numFrames() const {
+    return m_num_frames;
+  }
+
+  /// Completed buckets at a level
+  size_t numBuckets(size_t level) const {
+    return m_levels[level].size() / m_num_channels;
+  }
+
+  /// Bucket summary (level < NUM_LEVELS, index < numBuckets(level))
+  const WaveformBucket& bucket(size_t level, size_t index, uint32_t channel) const {
+    return m_levels[level][index * m_num_channels + channel];
+  }
+
+  /// Level used for a query: the coarsest whose buckets fit within one pixel
+  /// @param samples_per_pixel Frames each output pixel covers
+  /// @return Level index, or NUM_LEVELS if pixels are finer than the finest level
+  static size_t levelForSamplesPerPixel(double samples_per_pixel);
+
+  /// Min/max/RMS per pixel for a frame range, answered from the pyramid
+  ///
+  /// Pixel edges are snapped outward to bucket boundaries, so each pixel may
+  /// include up to one bucket of neighbouring audio. Ranges with fewer frames
+  /// per pixel than the finest level use the finest level (each pixel reports
+  /// the bucket it falls in); callers needing sample accuracy at that zoom
+  /// should read the audio instead (see levelForSamplesPerPixel()).
+  /// @return Waveform data, or pixelWidth == 0 if the parameters are invalid
+  WaveformData query(int64_t start_sample, int64_t end_sample, uint32_t pixel_width,
+                     uint32_t channel) const;
+
+  /// Pixels [first_pixel, last_pixel) of a query, usable while the pyramid is still building
+  ///
+  /// Pixel edges are those of the full query(start, end, width), so tiles computed
+  /// separately line up exactly. The result's startSample/endSample span just those
+  /// pixels. Pixels past the built buckets are zero (see completePixels()).
+  /// @param total_frames Length of the audio (end_sample is clamped to it)
+  WaveformData queryPixels(int64_t start_sample, int64_t end_sample, uint32_t pixel_width,
+                           uint32_t channel, uint32_t first_pixel, uint32_t last_pixel,
+                           int64_t total_frames) const;
+
+  /// Leading pixels of a query whose buckets are all built (pixel_width once finished)
+  uint32_t completePixels(int64_t start_sample, int64_t end_sample, uint32_t pixel_width) const;
+
+  /// Query over any storage laid out in this pyramid's levels (shared with PeakFile)
+  /// @param num_frames Length of the audio
+  /// @param num_buckets Completed buckets per level
+  /// @param first_pixel,last_pixel Pixels to compute (see queryPixels())
+  /// @param bucket_at Callable (level, index) -> WaveformBucket for the queried channel
+  template <typename BucketAt>
+  static WaveformData queryLevels(int64_t num_frames, uint16_t num_channels,
+                                  const std::array<size_t, NUM_LEVELS>& num_buckets,
+                                  int64_t start_sample, int64_t end_sample, uint32_t pixel_width,
+                                  uint32_t channel, uint32_t first_pixel, uint32_t last_pixel,
+                                  BucketAt&& bucket_at);
+
+  /// Absolute peak of a channel over all appended frames
+  float peakLevel(uint32_t channel) const;
+
+  /// Heap memory held by bucket storage
+  size_t memoryBytes() const;
+
+private:
+  /// Running summary of the bucket being filled at one level ([channel], as reduceInterleaved())
+  struct Accumulators {
+    std::vector<float> min;
+    std::vector<float> max;
+    std::vector<double> sum_squares;
+  };
+
+  void resetAccumulators(size_t level);
+  void emitBucket(size_t level);
+
+  uint16_t m_num_channels;
+  int64_t m_num_frames = 0;
+  bool m_finished = false;
+
+  std::array<std::vector<WaveformBucket>, NUM_LEVELS> m_levels; ///< [bucket * channels + ch]
+  std::array<Accumulators, NUM_LEVELS> m_accumulators;
+  std::array<uint32_t, NUM_LEVELS> m_accumulated_frames{}; ///< Frames in the open bucket
+  std::vector<float> m_peaks;                              ///< Absolute peak per channel
+};
+
+template <typename BucketAt>
+WaveformData WaveformPyramid::queryLevels(int64_t num_frames, uint16_t num_channels,
+                                          const std::array<size_t, NUM_LEVELS>& num_buckets,
+                                          int64_t start_sample, int64_t end_sample,
+                                          uint32_t pixel_width, uint32_t channel,
+                                          uint32_t first_pixel, uint32_t last_pixel,
+                                          BucketAt&& bucket_at) {
+  WaveformData result;
+  result.startSample = start_sample;
+  result.endSample = end_sample;
+  result.pixelWidth = 0; // Invalid until parameters are checked
+  result.channelIndex = channel;
+
+  last_pixel = std::min(last_pixel, pixel_width);
+  if (channel >= num_channels || pixel_width == 0 || start_sample < 0 ||
+      end_sample <= start_sample || first_pixel >= last_pixel) {
+    return result;
+  }
+
+  end_sample = std::min(end_sample, num_frames);
+  double samples_per_pixel =
+      static_cast<double>(end_sample - start_sample) / static_cast<double>(pixel_width);
+  auto pixel_edge = [&](uint32_t pixel) {
+    return pixel == pixel_width ? end_sample
+                                : start_sample + static_cast<int64_t>(pixel * samples_per_pixel);
+  };
+
+  const uint32_t tile_width = last_pixel - first_pixel;
+  result.startSample = pixel_edge(first_pixel);
+  result.endSample = pixel_edge(last_pixel);
+  result.pixelWidth = tile_width;
+  result.minPeaks.assign(tile_width, 0.0f);
+  result.maxPeaks.assign(tile_width, 0.0f);
+  result.rms.assign(tile_width, 0.0f);
+  if (end_sample <= start_sample) {
+    return result; // Range starts past the end of the audio
+  }
+
+  size_t level = levelForSamplesPerPixel(samples_per_pixel);
+  if (level == NUM_LEVELS) {
+    level = 0; // Finer than the finest level: each pixel reports the bucket it falls in
+  }
+
+  const int64_t bucket_frames = LEVEL_BUCKET_FRAMES[level];
+  const auto level_buckets = static_cast<int64_t>(num_buckets[level]);
+
+  for (uint32_t pixel = first_pixel; pixel < last_pixel; ++pixel) {
+    int64_t first = pixel_edge(pixel);
+    int64_t last = pixel_edge(pixel + 1);
+    int64_t b0 = first / bucket_frames;
+    int64_t b1 = std::max(b0 + 1, (last + bucket_frames - 1) / bucket_frames);
+    b1 = std::min(b1, level_buckets);
+    if (b0 >= b1) {
+      continue; // Not yet built (or past the end)
+    }
+
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    double sum_squares = 0.0;
+    int64_t frames = 0;
+    for (int64_t b = b0; b < b1; ++b) {
+      WaveformBucket summary = bucket_at(level, static_cast<size_t>(b));
+      int64_t bucket_length = std::min(bucket_frames, num_frames - b * bucket_frames);
+      min = std::min(min, summary.min);
+      max = std::max(max, summary.max);
+      double mean_square = static_cast<double>(summary.rms) * summary.rms;
+      sum_squares += mean_square * static_cast<double>(bucket_length);
+      frames += bucket_length;
+    }
+
+    result.minPeaks[pixel - first_pixel] = min;
+    result.maxPeaks[pixel - first_pixel] = max;
+    result.rms[pixel - first_pixel] =
+        static_cast<float>(std::sqrt(sum_squares / static_cast<double>(frames)));
+  }
+
+  return result;
+}
+
+} // namespace orpheus
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: MIT
+#include "waveform_reduce.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORPHEUS_REDUCE_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ORPHEUS_REDUCE_NEON 1
+#endif
+
+namespace orpheus {
+
+namespace {
+
+/// Vectors summed in float before folding into the double lane totals
+constexpr size_t SUM_FLUSH_VECTORS = 256;
+
+/// Per-lane results of a four-wide reduction
+struct LaneSummary {
+  float min[4];
+  float max[4];
+  double sum_squares[4];
+};
+
+/// Reduce `count` four-float vectors found at `data + k * stride`
+LaneSummary reduceLanes(const float* data, size_t count, size_t stride) {
+  LaneSummary lanes;
+  std::fill(std::begin(lanes.min), std::end(lanes.min), std::numeric_limits<float>::max());
+  std::fill(std::begin(lanes.max), std::end(lanes.max), std::numeric_limits<float>::lowest());
+  std::fill(std::begin(lanes.sum_squares), std::end(lanes.sum_squares), 0.0);
+
+#if defined(ORPHEUS_REDUCE_SSE2)
+  __m128 vmin = _mm_set1_ps(std::numeric_limits<float>::max());
+  __m128 vmax = _mm_set1_ps(std::numeric_limits<float>::lowest());
+  for (size_t done = 0; done < count;) {
+    size_t block = std::min(count - done, SUM_FLUSH_VECTORS);
+    __m128 vsum = _mm_setzero_ps();
+    for (size_t k = 0; k < block; ++k) {
+      __m128 v = _mm_loadu_ps(data + (done + k) * stride);
+      vmin = _mm_min_ps(vmin, v);
+      vmax = _mm_max_ps(vmax, v);
+      vsum = _mm_add_ps(vsum, _mm_mul_ps(v, v));
+    }
+    float partial[4];
+    _mm_storeu_ps(partial, vsum);
+    for (size_t lane = 0; lane < 4; ++lane) {
+      lanes.sum_squares[lane] += partial[lane];
+    }
+    done += block;
+  }
+  _mm_storeu_ps(lanes.min, vmin);
+  _mm_storeu_ps(lanes.max, vmax);
+#elif defined(ORPHEUS_REDUCE_NEON)
+  float32x4_t vmin = vdupq_n_f32(std::numeric_limits<float>::max());
+  float32x4_t vmax = vdupq_n_f32(std::numeric_limits<float>::lowest());
+  for (size_t done = 0; done < count;) {
+    size_t block = std::min(count - done, SUM_FLUSH_VECTORS);
+    float32x4_t vsum = vdupq_n_f32(0.0f);
+    for (size_t k = 0; k < block; ++k) {
+      float32x4_t v = vld1q_f32(data + (done + k) * stride);
+      vmin = vminq_f32(vmin, v);
+      vmax = vmaxq_f32(vmax, v);
+      vsum = vmlaq_f32(vsum, v, v);
+    }
+    float partial[4];
+    vst1q_f32(partial, vsum);
+    for (size_t lane = 0; lane < 4; ++lane) {
+      lanes.sum_squares[lane] += partial[lane];
+    }
+    done += block;
+  }
+  vst1q_f32(lanes.min, vmin);
+  vst1q_f32(lanes.max, vmax);
+#else
+  for (size_t k = 0; k < count; ++k) {
+    const float* v = data + k * stride;
+    for (size_t lane = 0; lane < 4; ++lane) {
+      lanes.min[lane] = std::min(lanes.min[lane], v[lane]);
+      lanes.max[lane] = std::max(lanes.max[lane], v[lane]);
+      lanes.sum_squares[lane] += static_cast<double>(v[lane]) * v[lane];
+    }
+  }
+#endif
+  return lanes;
+}
+
+/// Fold lane results into channel results (lane i belongs to channel first_channel + i % span)
+void foldLanes(const LaneSummary& lanes, size_t first_channel, size_t span, float* mins,
+               float* maxs, double* sum_squares) {
+  for (size_t lane = 0; lane < 4; ++lane) {
+    size_t ch = first_channel + lane % span;
+    mins[ch] = std::min(mins[ch], lanes.min[lane]);
+    maxs[ch] = std::max(maxs[ch], lanes.max[lane]);
+    sum_squares[ch] += lanes.sum_squares[lane];
+  }
+}
+
+} // namespace
+
+void reduceInterleavedScalar(const float* interleaved, size_t num_frames, uint16_t num_channels,
+                             float* mins, float* maxs, double* sum_squares) {
+  for (size_t frame = 0; frame < num_frames; ++frame) {
+    const float* samples = interleaved + frame * num_channels;
+    for (uint16_t ch = 0; ch < num_channels; ++ch) {
+      float sample = samples[ch];
+      mins[ch] = std::min(mins[ch], sample);
+      maxs[ch] = std::max(maxs[ch], sample);
+      sum_squares[ch] += static_cast<double>(sample) * sample;
+    }
+  }
+}
+
+void reduceInterleaved(const float* interleaved, size_t num_frames, uint16_t num_channels,
+                       float* mins, float* maxs, double* sum_squares) {
+  if (num_channels == 1 || num_channels == 2 || num_channels == 4) {
+    // Contiguous vectors; lane i always carries channel i % num_channels
+    size_t num_samples = num_frames * num_channels;
+    size_t vectors = num_samples / 4;
+    foldLanes(reduceLanes(interleaved, vectors, 4), 0, num_channels, mins, maxs, sum_squares);
+    size_t tail_frames = (num_samples - vectors * 4) / num_channels;
+    reduceInterleavedScalar(interleaved + vectors * 4, tail_frames, num_channels, mins, maxs,
+                            sum_squares);
+  } else if (num_channels % 4 == 0) {
+    // One strided pass per group of four channels
+    for (size_t group = 0; group < num_channels; group += 4) {
+      foldLanes(reduceLanes(interleaved + group, num_frames, num_channels), group, 4, mins, maxs,
+                sum_squares);
+    }
+  } else {
+    reduceInterleavedScalar(interleaved, num_frames, num_channels, mins, maxs, sum_squares);
+  }
+}
+
+} // namespace orpheus
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace orpheus {
+
+/// Fold interleaved frames into per-channel min, max and sum of squares
+///
+/// `mins`, `maxs` and `sum_squares` hold num_channels entries each and are
+/// updated in place, so one run may be reduced across several calls (seed
+/// them with +max, lowest and 0). Mono, stereo and multiples of four channels
+/// are reduced four lanes at a time with SSE2/NEON; other layouts use the
+/// scalar loop. Squares are summed in float for at most 256 vectors before
+/// being folded into the double totals.
+void reduceInterleaved(const float* interleaved, size_t num_frames, uint16_t num_channels,
+                       float* mins, float* maxs, double* sum_squares);
+
+/// Scalar reference for reduceInterleaved() (tests and benchmarks)
+void reduceInterleavedScalar(const float* interleaved, size_t num_frames, uint16_t num_channels,
+                             float* mins, float* maxs, double* sum_squares);
+
+} // namespace orpheus
@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: MIT
 #include "orpheus/performance_monitor.h"
 
+#include "orpheus/audio_driver.h"
+
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <mutex>
 
 #include "session/session_graph.h"
 
@@ -47,19 +50,30 @@ public:
     metrics.cpuUsagePercent = m_cpuUsagePercent.load(std::memory_order_relaxed);
     metrics.latencyMs = m_latencyMs.load(std::memory_order_relaxed);
     metrics.bufferUnderrunCount = m_underrunCount.load(std::memory_order_relaxed);
+    metrics.slowUnderrunCount = m_slowUnderrunCount.load(std::memory_order_relaxed);
+    metrics.preemptUnderrunCount = m_preemptUnderrunCount.load(std::memory_order_relaxed);
     metrics.activeClipCount = m_activeClipCount.load(std::memory_order_relaxed);
     metrics.totalSamplesProcessed = m_totalSamplesProcessed.load(std::memory_order_relaxed);
 
-    // Calculate uptime
-    auto now = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - m_startTime);
-    metrics.uptimeSeconds = static_cast<double>(duration.count()) / 1'000'000.0;
+    // Calculate uptime (on the driver's sample clock when one is attached)
+    const IAudioClock* clock = m_clock.load(std::memory_order_acquire);
+    if (clock && clock->getSampleRate() > 0) {
+      metrics.uptimeSeconds = static_cast<double>(clock->getSampleTime()) /
+                              static_cast<double>(clock->getSampleRate());
+      metrics.freewheeling = clock->isFreewheeling();
+    } else {
+      auto now = std::chrono::steady_clock::now();
+      auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - m_startTime);
+      metrics.uptimeSeconds = static_cast<double>(duration.count()) / 1'000'000.0;
+    }
 
     return metrics;
   }
 
   void resetUnderrunCount() override {
     m_underrunCount.store(0, std::memory_order_relaxed);
+    m_slowUnderrunCount.store(0, std::memory_order_relaxed);
+    m_preemptUnderrunCount.store(0, std::memory_order_relaxed);
   }
 
   float getPeakCpuUsage() const override {
@@ -136,14 +150,44 @@ public:
     m_underrunCount.fetch_add(1, std::memory_order_relaxed);
   }
 
+  void reportUnderrun(UnderrunCause cause) override {
+    m_underrunCount.fetch_add(1, std::memory_order_relaxed);
+    auto& count = cause == UnderrunCause::SlowProcessing ? m_slowUnderrunCount
+                                                          : m_preemptUnderrunCount;
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void reportRealtimeThread(const RealtimeThreadReport& report) override {
+    std::lock_guard<std::mutex> lock(m_realtimeMutex);
+    auto existing = std::find_if(m_realtimeThreads.begin(), m_realtimeThreads.end(),
+                                 [&](const auto& thread) { return thread.name == report.name; });
+    if (existing != m_realtimeThreads.end()) {
+      *existing = report;
+    } else {
+      m_realtimeThreads.push_back(report);
+    }
+  }
+
+  std::vector<RealtimeThreadReport> getRealtimeThreads() const override {
+    std::lock_guard<std::mutex> lock(m_realtimeMutex);
+    return m_realtimeThreads;
+  }
+
+  void setAudioClock(const IAudioClock* clock) override {
+    m_clock.store(clock, std::memory_order_release);
+  }
+
 private:
   [[maybe_unused]] core::SessionGraph* m_sessionGraph;
   std::chrono::steady_clock::time_point m_startTime;
+  std::atomic<const IAudioClock*> m_clock{nullptr}; // Sample clock for uptime (optional)
 
   // Atomic metrics (updated by audio thread, read by UI thread)
   std::atomic<float> m_cpuUsagePercent{0.0f};
   std::atomic<float> m_latencyMs{0.0f};
   std::atomic<uint32_t> m_underrunCount{0};
+  std::atomic<uint32_t> m_slowUnderrunCount{0};
+  std::atomic<uint32_t> m_preemptUnderrunCount{0};
   std::atomic<uint32_t> m_activeClipCount{0};
   std::atomic<uint64_t> m_totalSamplesProcessed{0};
 
@@ -152,6 +196,10 @@ private:
 
   // Histogram (7 buckets: 0.5ms, 1ms, 2ms, 5ms, 10ms, 20ms, 50ms+)
   std::array<std::atomic<uint32_t>, 7> m_histogramCounts;
+
+  // Real-time thread setup (reported once per thread, never from the callback)
+  mutable std::mutex m_realtimeMutex;
+  std::vector<RealtimeThreadReport> m_realtimeThreads;
 };
 
 // Factory function implementation
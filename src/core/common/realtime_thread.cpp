@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: MIT
+#include "orpheus/realtime_thread.h"
+
+#include <algorithm>
+#include <ctime>
+#include <mutex>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define ORPHEUS_HAS_MXCSR 1
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#define ORPHEUS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ORPHEUS_ASAN 1
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#define ORPHEUS_NOINLINE __declspec(noinline)
+#else
+#define ORPHEUS_NOINLINE __attribute__((noinline))
+#endif
+
+namespace orpheus {
+
+namespace {
+
+/// Stack touched per frame of touchStack()
+constexpr size_t STACK_CHUNK_BYTES = 16 * 1024;
+
+/// Largest stack pre-fault honoured (default thread stacks are 1 MiB on Windows)
+constexpr size_t MAX_STACK_PREFAULT_BYTES = 512 * 1024;
+
+size_t pageSize() {
+#if defined(_WIN32)
+  static const size_t size = [] {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+  }();
+#else
+  static const size_t size = [] {
+    long value = sysconf(_SC_PAGESIZE);
+    return value > 0 ? static_cast<size_t>(value) : size_t{4096};
+  }();
+#endif
+  return size;
+}
+
+/// Write to `bytes` of stack below the caller, one chunk per frame
+ORPHEUS_NOINLINE size_t touchStack(size_t bytes) {
+  uint8_t chunk[STACK_CHUNK_BYTES];
+  prefaultMemory(chunk, sizeof(chunk));
+  const size_t deeper = bytes > STACK_CHUNK_BYTES ? touchStack(bytes - STACK_CHUNK_BYTES) : 0;
+  prefaultMemory(chunk, 1); // Keeps this frame live across the call
+  return deeper + STACK_CHUNK_BYTES;
+}
+
+#if !defined(_WIN32)
+int nativePolicy(RealtimePolicy policy) {
+  return policy == RealtimePolicy::RoundRobin ? SCHED_RR : SCHED_FIFO;
+}
+
+bool trySchedule(int policy, int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+}
+#endif
+
+/// Apply a real-time policy, falling back to the rlimit ceiling, then to none
+void applyPolicy(const RealtimeThreadConfig& config, RealtimeThreadReport& report) {
+  if (config.policy == RealtimePolicy::None) {
+    return;
+  }
+#if defined(_WIN32)
+  if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+    report.policy = config.policy;
+    report.priority = THREAD_PRIORITY_TIME_CRITICAL;
+  }
+#else
+  const int policy = nativePolicy(config.policy);
+  int priority = std::clamp(config.priority, sched_get_priority_min(policy),
+                            sched_get_priority_max(policy));
+  bool granted = trySchedule(policy, priority);
+#if defined(RLIMIT_RTPRIO)
+  rlimit limit{};
+  if (!granted && getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+      limit.rlim_cur > 0 && static_cast<rlim_t>(priority) > limit.rlim_cur) {
+    priority = static_cast<int>(limit.rlim_cur);
+    granted = trySchedule(policy, priority);
+  }
+#endif
+  if (!granted) {
+    return;
+  }
+
+  // Report what the kernel holds, not what was asked for
+  int current = 0;
+  sched_param param{};
+  if (pthread_getschedparam(pthread_self(), &current, &param) == 0) {
+    report.policy = current == SCHED_FIFO ? RealtimePolicy::Fifo
+                    : current == SCHED_RR ? RealtimePolicy::RoundRobin
+                                          : RealtimePolicy::None;
+    report.priority = report.policy == RealtimePolicy::None ? 0 : param.sched_priority;
+  }
+#endif
+}
+
+/// Pin the calling thread to one CPU (no-op where pinning is unavailable)
+int applyAffinity(int cpu) {
+  if (cpu < 0) {
+    return -1;
+  }
+#if defined(_WIN32)
+  if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8) &&
+      SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0) {
+    return cpu;
+  }
+#elif defined(__linux__)
+  if (cpu < CPU_SETSIZE) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+      return cpu;
+    }
+  }
+#endif
+  return -1; // macOS only takes affinity hints
+}
+
+} // anonymous namespace
+
+RealtimeThreadReport configureRealtimeThread(const RealtimeThreadConfig& config) {
+  RealtimeThreadReport report;
+  report.name = config.name ? config.name : "";
+  report.requestedPolicy = config.policy;
+
+  applyPolicy(config, report);
+  report.cpu = applyAffinity(config.cpu);
+  report.memoryLock = config.lockMemory ? lockProcessMemory() : MemoryLock::None;
+  report.denormalsFlushed = config.flushDenormals && flushDenormalsOnThisThread();
+
+  if (config.prefaultStackBytes > 0) {
+    report.prefaultedStackBytes =
+        touchStack(std::min(config.prefaultStackBytes, MAX_STACK_PREFAULT_BYTES));
+  }
+  return report;
+}
+
+MemoryLock lockProcessMemory() {
+  static std::mutex mutex;
+  static MemoryLock state = MemoryLock::None;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (state != MemoryLock::None) {
+    return state;
+  }
+#if !defined(_WIN32) && !defined(ORPHEUS_ASAN)
+  // MCL_FUTURE under a finite memlock limit would make later allocations fail
+  // once the limit is reached, so it is only requested when nothing caps it.
+  // (Sanitizer shadow memory is far too large to lock.)
+  rlimit limit{};
+  const bool unlimited = getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+  if (unlimited && mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+    state = MemoryLock::CurrentAndFuture;
+  } else if (mlockall(MCL_CURRENT) == 0) {
+    state = MemoryLock::Current;
+  }
+#endif
+  return state;
+}
+
+bool flushDenormalsOnThisThread() {
+#if defined(ORPHEUS_HAS_MXCSR)
+  _mm_setcsr(_mm_getcsr() | 0x8040); // FTZ (bit 15) | DAZ (bit 6)
+  return true;
+#elif defined(__aarch64__)
+  uint64_t fpcr = 0;
+  __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+  fpcr |= uint64_t{1} << 24; // FZ: flushes denormal inputs and outputs
+  __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void prefaultMemory(void* data, size_t bytes) {
+  if (data == nullptr || bytes == 0) {
+    return;
+  }
+  auto* memory = static_cast<volatile uint8_t*>(data);
+  const size_t page = pageSize();
+  for (size_t offset = 0; offset < bytes; offset += page) {
+    memory[offset] = memory[offset];
+  }
+  memory[bytes - 1] = memory[bytes - 1]; // The last page when `data` is unaligned
+}
+
+int64_t threadCpuTimeNs() {
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+    return 0;
+  }
+  auto ticks = [](const FILETIME& time) {
+    return static_cast<int64_t>((static_cast<uint64_t>(time.dwHighDateTime) << 32) |
+                                time.dwLowDateTime);
+  };
+  return (ticks(kernel) + ticks(user)) * 100; // 100 ns units
+#else
+  timespec now{};
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + static_cast<int64_t>(now.tv_nsec);
+#endif
+}
+
+UnderrunCause classifyDeadlineMiss(int64_t callbackCpuNs, int64_t periodNs) {
+  return callbackCpuNs >= periodNs ? UnderrunCause::SlowProcessing : UnderrunCause::Preempted;
+}
+
+} // namespace orpheus
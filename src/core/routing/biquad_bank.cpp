@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: MIT
+#include "biquad_bank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ORPHEUS_BIQUAD_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ORPHEUS_BIQUAD_NEON 1
+#endif
+
+namespace orpheus {
+
+namespace {
+
+// ============================================================================
+// 4-lane vector helpers (SSE2 / NEON / scalar)
+// ============================================================================
+
+#if defined(ORPHEUS_BIQUAD_SSE2)
+using Vec4 = __m128;
+inline Vec4 load4(const float* p) {
+  return _mm_loadu_ps(p);
+}
+inline void store4(float* p, Vec4 v) {
+  _mm_storeu_ps(p, v);
+}
+inline Vec4 add4(Vec4 a, Vec4 b) {
+  return _mm_add_ps(a, b);
+}
+inline Vec4 sub4(Vec4 a, Vec4 b) {
+  return _mm_sub_ps(a, b);
+}
+inline Vec4 mul4(Vec4 a, Vec4 b) {
+  return _mm_mul_ps(a, b);
+}
+#elif defined(ORPHEUS_BIQUAD_NEON)
+using Vec4 = float32x4_t;
+inline Vec4 load4(const float* p) {
+  return vld1q_f32(p);
+}
+inline void store4(float* p, Vec4 v) {
+  vst1q_f32(p, v);
+}
+inline Vec4 add4(Vec4 a, Vec4 b) {
+  return vaddq_f32(a, b);
+}
+inline Vec4 sub4(Vec4 a, Vec4 b) {
+  return vsubq_f32(a, b);
+}
+inline Vec4 mul4(Vec4 a, Vec4 b) {
+  return vmulq_f32(a, b);
+}
+#else
+struct Vec4 {
+  float v[4];
+};
+inline Vec4 load4(const float* p) {
+  return {{p[0], p[1], p[2], p[3]}};
+}
+inline void store4(float* p, Vec4 a) {
+  std::memcpy(p, a.v, sizeof(a.v));
+}
+inline Vec4 add4(Vec4 a, Vec4 b) {
+  return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+}
+inline Vec4 sub4(Vec4 a, Vec4 b) {
+  return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+}
+inline Vec4 mul4(Vec4 a, Vec4 b) {
+  return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+}
+#endif
+
+constexpr float IDENTITY[5] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+/// Below this magnitude filter state is flushed to zero (avoids denormal stalls)
+constexpr float DENORMAL_THRESHOLD = 1e-20f;
+
+} // namespace
+
+// ============================================================================
+// BiquadBank Implementation
+// ============================================================================
+
+BiquadBank::BiquadBank(uint32_t sample_rate, size_t num_lanes, size_t max_block_frames)
+    : m_sample_rate(sample_rate), m_num_lanes(num_lanes),
+      m_num_packs((num_lanes + LANE_WIDTH - 1) / LANE_WIDTH),
+      m_max_block(std::max<size_t>(max_block_frames, 1)), m_middle(1), m_back(2), m_front(0) {
+  m_bands.resize(m_num_lanes);
+
+  size_t coeff_count = NUM_STAGES * m_num_packs * NUM_COEFFS * LANE_WIDTH;
+  size_t flag_count = NUM_STAGES * m_num_packs;
+
+  for (auto& set : m_sets) {
+    set.coeffs.resize(coeff_count);
+    set.active.assign(flag_count, 0);
+  }
+  m_current.resize(coeff_count);
+  m_step.assign(coeff_count, 0.0f);
+  m_stage_active.assign(flag_count, 0);
+  m_lane_active.assign(flag_count, 0);
+  m_state.assign(NUM_STAGES * m_num_packs * 2 * LANE_WIDTH, 0.0f);
+  m_scratch.assign(m_max_block * LANE_WIDTH, 0.0f);
+
+  // Identity everywhere
+  for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+    for (size_t pack = 0; pack < m_num_packs; ++pack) {
+      for (size_t c = 0; c < NUM_COEFFS; ++c) {
+        size_t index = coeffIndex(stage, pack, c);
+        std::fill_n(m_current.begin() + static_cast<std::ptrdiff_t>(index), LANE_WIDTH,
+                    IDENTITY[c]);
+      }
+    }
+  }
+  for (auto& set : m_sets) {
+    set.coeffs = m_current;
+  }
+}
+
+bool BiquadBank::isValidBand(const EqBand& band) const {
+  if (band.type == EqFilterType::Bypass) {
+    return true;
+  }
+  float nyquist_limit = 0.45f * static_cast<float>(m_sample_rate);
+  return band.frequency_hz >= 10.0f && band.frequency_hz <= nyquist_limit && band.q >= 0.1f &&
+         band.q <= 20.0f && band.gain_db >= -24.0f && band.gain_db <= 24.0f;
+}
+
+bool BiquadBank::setBand(size_t lane, size_t stage, const EqBand& band) {
+  if (lane >= m_num_lanes || stage >= NUM_STAGES || !isValidBand(band)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_bands[lane][stage] = band;
+  publish();
+  return true;
+}
+
+bool BiquadBank::setBandAllLanes(size_t stage, const EqBand& band) {
+  if (stage >= NUM_STAGES || !isValidBand(band)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& lane : m_bands) {
+    lane[stage] = band;
+  }
+  publish();
+  return true;
+}
+
+EqBand BiquadBank::getBand(size_t lane, size_t stage) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (lane >= m_num_lanes || stage >= NUM_STAGES) {
+    return EqBand();
+  }
+  return m_bands[lane][stage];
+}
+
+void BiquadBank::publish() {
+  CoefficientSet& set = m_sets[m_back];
+  std::fill(set.active.begin(), set.active.end(), 0);
+
+  for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+    for (size_t pack = 0; pack < m_num_packs; ++pack) {
+      for (size_t l = 0; l < LANE_WIDTH; ++l) {
+        size_t lane = pack * LANE_WIDTH + l;
+        float coeffs[NUM_COEFFS] = {IDENTITY[0], IDENTITY[1], IDENTITY[2], IDENTITY[3],
+                                    IDENTITY[4]};
+        if (lane < m_num_lanes && m_bands[lane][stage].type != EqFilterType::Bypass) {
+          computeCoefficients(m_bands[lane][stage], coeffs);
+          set.active[stage * m_num_packs + pack] |= static_cast<uint8_t>(1u << l);
+        }
+        for (size_t c = 0; c < NUM_COEFFS; ++c) {
+          set.coeffs[coeffIndex(stage, pack, c) + l] = coeffs[c];
+        }
+      }
+    }
+  }
+
+  // Swap back buffer with the shared slot, marking it dirty
+  uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_back | DIRTY_FLAG),
+                                       std::memory_order_acq_rel);
+  m_back = static_cast<uint8_t>(previous & ~DIRTY_FLAG);
+}
+
+bool BiquadBank::acquire() {
+  if ((m_middle.load(std::memory_order_acquire) & DIRTY_FLAG) == 0) {
+    return false;
+  }
+  uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+  m_front = static_cast<uint8_t>(previous & ~DIRTY_FLAG);
+  return true;
+}
+
+void BiquadBank::computeCoefficients(const EqBand& band, float* out) const {
+  // RBJ Audio EQ Cookbook
+  const double pi = 3.14159265358979323846;
+  double w0 = 2.0 * pi * static_cast<double>(band.frequency_hz) / m_sample_rate;
+  double cos_w0 = std::cos(w0);
+  double alpha = std::sin(w0) / (2.0 * static_cast<double>(band.q));
+  double a = std::pow(10.0, static_cast<double>(band.gain_db) / 40.0);
+  double sqrt_a_alpha = 2.0 * std::sqrt(a) * alpha;
+
+  double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+
+  switch (band.type) {
+  case EqFilterType::HighPass:
+    b0 = (1.0 + cos_w0) / 2.0;
+    b1 = -(1.0 + cos_w0);
+    b2 = b0;
+    a0 = 1.0 + alpha;
+    a1 = -2.0 * cos_w0;
+    a2 = 1.0 - alpha;
+    break;
+  case EqFilterType::LowPass:
+    b0 = (1.0 - cos_w0) / 2.0;
+    b1 = 1.0 - cos_w0;
+    b2 = b0;
+    a0 = 1.0 + alpha;
+    a1 = -2.0 * cos_w0;
+    a2 = 1.0 - alpha;
+    break;
+  case EqFilterType::Peak:
+    b0 = 1.0 + alpha * a;
+    b1 = -2.0 * cos_w0;
+    b2 = 1.0 - alpha * a;
+    a0 = 1.0 + alpha / a;
+    a1 = -2.0 * cos_w0;
+    a2 = 1.0 - alpha / a;
+    break;
+  case EqFilterType::LowShelf:
+    b0 = a * ((a + 1.0) - (a - 1.0) * cos_w0 + sqrt_a_alpha);
+    b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cos_w0);
+    b2 = a * ((a + 1.0) - (a - 1.0) * cos_w0 - sqrt_a_alpha);
+    a0 = (a + 1.0) + (a - 1.0) * cos_w0 + sqrt_a_alpha;
+    a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cos_w0);
+    a2 = (a + 1.0) + (a - 1.0) * cos_w0 - sqrt_a_alpha;
+    break;
+  case EqFilterType::HighShelf:
+    b0 = a * ((a + 1.0) + (a - 1.0) * cos_w0 + sqrt_a_alpha);
+    b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cos_w0);
+    b2 = a * ((a + 1.0) + (a - 1.0) * cos_w0 - sqrt_a_alpha);
+    a0 = (a + 1.0) - (a - 1.0) * cos_w0 + sqrt_a_alpha;
+    a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cos_w0);
+    a2 = (a + 1.0) - (a - 1.0) * cos_w0 - sqrt_a_alpha;
+    break;
+  case EqFilterType::Bypass:
+    break;
+  }
+
+  out[0] = static_cast<float>(b0 / a0);
+  out[1] = static_cast<float>(b1 / a0);
+  out[2] = static_cast<float>(b2 / a0);
+  out[3] = static_cast<float>(a1 / a0);
+  out[4] = static_cast<float>(a2 / a0);
+}
+
+void BiquadBank::reset() {
+  std::fill(m_state.begin(), m_state.end(), 0.0f);
+}
+
+void BiquadBank::clearState(size_t flag, uint8_t lane_mask) {
+  float* state = m_state.data() + flag * 2 * LANE_WIDTH;
+  for (size_t l = 0; l < LANE_WIDTH; ++l) {
+    if (lane_mask & (1u << l)) {
+      state[l] = 0.0f;
+      state[LANE_WIDTH + l] = 0.0f;
+    }
+  }
+}
+
+void BiquadBank::process(float* const* lanes, size_t num_frames) {
+  if (num_frames == 0 || num_frames > m_max_block) {
+    return;
+  }
+
+  // Pick up new coefficients and set up the per-block ramp
+  bool ramping = acquire();
+  const CoefficientSet& target = m_sets[m_front];
+  if (ramping) {
+    float inv_frames = 1.0f / static_cast<float>(num_frames);
+    for (size_t i = 0; i < m_current.size(); ++i) {
+      m_step[i] = (target.coeffs[i] - m_current[i]) * inv_frames;
+    }
+    for (size_t i = 0; i < m_stage_active.size(); ++i) {
+      // Lanes leaving bypass start from rest, not from what an earlier band left behind
+      clearState(i, static_cast<uint8_t>(target.active[i] & ~m_lane_active[i]));
+      m_stage_active[i] = static_cast<uint8_t>(m_stage_active[i] | target.active[i]);
+    }
+  }
+
+  float* scratch = m_scratch.data();
+
+  for (size_t pack = 0; pack < m_num_packs; ++pack) {
+    bool pack_active = false;
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+      pack_active = pack_active || m_stage_active[stage * m_num_packs + pack] != 0;
+    }
+    if (!pack_active) {
+      continue;
+    }
+
+    // Gather: [frame][lane] so one register holds one frame of four lanes
+    size_t first_lane = pack * LANE_WIDTH;
+    for (size_t l = 0; l < LANE_WIDTH; ++l) {
+      size_t lane = first_lane + l;
+      const float* input = lane < m_num_lanes ? lanes[lane] : nullptr;
+      for (size_t i = 0; i < num_frames; ++i) {
+        scratch[i * LANE_WIDTH + l] = input ? input[i] : 0.0f;
+      }
+    }
+
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+      if (!m_stage_active[stage * m_num_packs + pack]) {
+        continue;
+      }
+
+      float* coeffs = m_current.data() + coeffIndex(stage, pack, 0);
+      float* state = m_state.data() + (stage * m_num_packs + pack) * 2 * LANE_WIDTH;
+
+      Vec4 b0 = load4(coeffs + 0 * LANE_WIDTH);
+      Vec4 b1 = load4(coeffs + 1 * LANE_WIDTH);
+      Vec4 b2 = load4(coeffs + 2 * LANE_WIDTH);
+      Vec4 a1 = load4(coeffs + 3 * LANE_WIDTH);
+      Vec4 a2 = load4(coeffs + 4 * LANE_WIDTH);
+      Vec4 s1 = load4(state);
+      Vec4 s2 = load4(state + LANE_WIDTH);
+
+      if (ramping) {
+        const float* steps = m_step.data() + coeffIndex(stage, pack, 0);
+        Vec4 db0 = load4(steps + 0 * LANE_WIDTH);
+        Vec4 db1 = load4(steps + 1 * LANE_WIDTH);
+        Vec4 db2 = load4(steps + 2 * LANE_WIDTH);
+        Vec4 da1 = load4(steps + 3 * LANE_WIDTH);
+        Vec4 da2 = load4(steps + 4 * LANE_WIDTH);
+
+        for (size_t i = 0; i < num_frames; ++i) {
+          b0 = add4(b0, db0);
+          b1 = add4(b1, db1);
+          b2 = add4(b2, db2);
+          a1 = add4(a1, da1);
+          a2 = add4(a2, da2);
+
+          Vec4 x = load4(scratch + i * LANE_WIDTH);
+          Vec4 y = add4(mul4(b0, x), s1);
+          s1 = add4(sub4(mul4(b1, x), mul4(a1, y)), s2);
+          s2 = sub4(mul4(b2, x), mul4(a2, y));
+          store4(scratch + i * LANE_WIDTH, y);
+        }
+      } else {
+        for (size_t i = 0; i < num_frames; ++i) {
+          Vec4 x = load4(scratch + i * LANE_WIDTH);
+          Vec4 y = add4(mul4(b0, x), s1);
+          s1 = add4(sub4(mul4(b1, x), mul4(a1, y)), s2);
+          s2 = sub4(mul4(b2, x), mul4(a2, y));
+          store4(scratch + i * LANE_WIDTH, y);
+        }
+      }
+
+      store4(state, s1);
+      store4(state + LANE_WIDTH, s2);
+      for (size_t k = 0; k < 2 * LANE_WIDTH; ++k) {
+        if (std::abs(state[k]) < DENORMAL_THRESHOLD) {
+          state[k] = 0.0f;
+        }
+      }
+    }
+
+    // Scatter back to the lanes
+    for (size_t l = 0; l < LANE_WIDTH; ++l) {
+      size_t lane = first_lane + l;
+      if (lane >= m_num_lanes || !lanes[lane]) {
+        continue;
+      }
+      float* output = lanes[lane];
+      for (size_t i = 0; i < num_frames; ++i) {
+        output[i] = scratch[i * LANE_WIDTH + l];
+      }
+    }
+  }
+
+  // Land exactly on the target and drop stages and lanes that are now bypassed
+  if (ramping) {
+    std::copy(target.coeffs.begin(), target.coeffs.end(), m_current.begin());
+    for (size_t stage = 0; stage < NUM_STAGES; ++stage) {
+      for (size_t pack = 0; pack < m_num_packs; ++pack) {
+        size_t flag = stage * m_num_packs + pack;
+        // Lanes now bypassed pass their input untouched from the next block on
+        clearState(flag, static_cast<uint8_t>(m_lane_active[flag] & ~target.active[flag]));
+        m_stage_active[flag] = target.active[flag];
+        m_lane_active[flag] = target.active[flag];
+      }
+    }
+  }
+}
+
+} // namespace orpheus
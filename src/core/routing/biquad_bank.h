@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/routing_matrix.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace orpheus {
+
+/// Cascaded biquad bank processing many mono lanes side by side
+///
+/// Architecture:
+/// - UI thread: setBand() recomputes coefficients and publishes a complete
+///   coefficient set through a lock-free triple buffer
+/// - Audio thread: process() picks up the newest set at the start of a block
+///   and interpolates every coefficient linearly across that block
+///
+/// Design:
+/// - Transposed direct form II (two state variables per stage)
+/// - Structure-of-arrays coefficients and state, lanes packed 4 wide so one
+///   SSE2/NEON register filters four groups at once
+/// - Stages that are bypassed on every lane of a pack are skipped, so an
+///   all-bypassed bank costs nothing
+/// - A lane's stage state is cleared when the stage is bypassed and again
+///   when it comes back, so a re-enabled band starts from rest
+///
+/// Usage:
+/// @code
+///   BiquadBank eq(48000, 4, 2048); // Four groups
+///   EqBand hpf;
+///   hpf.type = EqFilterType::HighPass;
+///   hpf.frequency_hz = 80.0f;
+///   eq.setBand(0, 0, hpf); // UI thread
+///
+///   // Audio thread:
+///   eq.process(group_buffers, num_frames);
+/// @endcode
+class BiquadBank {
+public:
+  /// SIMD width (lanes processed per register)
+  static constexpr size_t LANE_WIDTH = 4;
+
+  /// Cascaded stages per lane
+  static constexpr size_t NUM_STAGES = MAX_EQ_BANDS;
+
+  /// Construct biquad bank (all bands bypassed)
+  /// @param sample_rate Sample rate in Hz
+  /// @param num_lanes Number of independent mono lanes
+  /// @param max_block_frames Largest block passed to process()
+  BiquadBank(uint32_t sample_rate, size_t num_lanes, size_t max_block_frames);
+
+  /// Set one band on one lane (UI thread)
+  /// @param lane Lane index [0, num_lanes)
+  /// @param stage Band index [0, NUM_STAGES)
+  /// @param band Band settings
+  /// @return false if the lane/stage is out of range or the band is invalid
+  bool setBand(size_t lane, size_t stage, const EqBand& band);
+
+  /// Set one band on every lane (UI thread, single publish)
+  bool setBandAllLanes(size_t stage, const EqBand& band);
+
+  /// Get band settings (UI thread)
+  EqBand getBand(size_t lane, size_t stage) const;
+
+  /// Validate band settings against the sample rate
+  bool isValidBand(const EqBand& band) const;
+
+  /// Filter lanes in place (audio thread only)
+  /// @param lanes Lane buffers (num_lanes entries)
+  /// @param num_frames Number of frames (<= max_block_frames)
+  /// @note Lock-free, allocation-free
+  void process(float* const* lanes, size_t num_frames);
+
+  /// Clear filter state (audio thread or while stopped)
+  void reset();
+
+  /// Number of lanes
+  size_t getNumLanes() const {
+    return m_num_lanes;
+  }
+
+private:
+  static constexpr size_t NUM_COEFFS = 5; ///< b0, b1, b2, a1, a2
+
+  /// Published coefficient set (UI → audio thread)
+  struct CoefficientSet {
+    std::vector<float> coeffs;   ///< [stage][pack][coeff][lane]
+    std::vector<uint8_t> active; ///< [stage][pack] mask of lanes not bypassed
+  };
+
+  static_assert(LANE_WIDTH <= 8, "lane masks are 8 bits");
+
+  size_t coeffIndex(size_t stage, size_t pack, size_t coeff) const {
+    return ((stage * m_num_packs + pack) * NUM_COEFFS + coeff) * LANE_WIDTH;
+  }
+
+  void publish();
+  bool acquire();
+  void computeCoefficients(const EqBand& band, float* out) const;
+  void clearState(size_t flag, uint8_t lane_mask);
+
+  // Configuration (set once in constructor)
+  uint32_t m_sample_rate;
+  size_t m_num_lanes;
+  size_t m_num_packs;
+  size_t m_max_block;
+
+  // UI model
+  mutable std::mutex m_mutex;
+  std::vector<std::array<EqBand, NUM_STAGES>> m_bands; ///< [lane][stage]
+
+  // Lock-free triple buffer
+  std::array<CoefficientSet, 3> m_sets;
+  std::atomic<uint8_t> m_middle; ///< Index of the shared set | DIRTY_FLAG
+  uint8_t m_back;                ///< UI-owned set
+  uint8_t m_front;               ///< Audio-owned set
+  static constexpr uint8_t DIRTY_FLAG = 0x4;
+
+  // Audio thread state
+  std::vector<float> m_current;        ///< Coefficients in use [stage][pack][coeff][lane]
+  std::vector<float> m_step;           ///< Per-sample increment while ramping
+  std::vector<uint8_t> m_stage_active; ///< [stage][pack] (current or target active)
+  std::vector<uint8_t> m_lane_active;  ///< [stage][pack] lane mask of the acquired set
+  std::vector<float> m_state;          ///< [stage][pack][2][lane]
+  std::vector<float> m_scratch;        ///< [frame][lane] for one pack
+};
+
+} // namespace orpheus
@@ -3,118 +3,60 @@
 #include "gain_smoother.h"
 
 #include <algorithm>
-#include <array>
-#include <atomic>
 #include <cmath>
-#include <unordered_map>
+#include <memory>
 
 namespace orpheus {
 
-// ============================================================================
-// ClipRoutingMatrix Implementation
-// ============================================================================
-
-class ClipRoutingMatrix : public IClipRoutingMatrix {
-public:
-  ClipRoutingMatrix(core::SessionGraph* sessionGraph, uint32_t sampleRate);
-  ~ClipRoutingMatrix() override;
-
-  // IClipRoutingMatrix interface
-  SessionGraphError assignClipToGroup(ClipHandle handle, uint8_t groupIndex) override;
-  SessionGraphError setGroupGain(uint8_t groupIndex, float gainDb) override;
-  SessionGraphError setGroupMute(uint8_t groupIndex, bool muted) override;
-  SessionGraphError setGroupSolo(uint8_t groupIndex, bool soloed) override;
-  SessionGraphError routeGroupToMaster(uint8_t groupIndex, bool enabled) override;
-
-  uint8_t getClipGroup(ClipHandle handle) const override;
-  float getGroupGain(uint8_t groupIndex) const override;
-  bool isGroupMuted(uint8_t groupIndex) const override;
-  bool isGroupSoloed(uint8_t groupIndex) const override;
-  bool isGroupRoutedToMaster(uint8_t groupIndex) const override;
-
-  // Multi-Channel Routing (Feature 7)
-  SessionGraphError setClipOutputBus(ClipHandle handle, uint8_t outputBus) override;
-  SessionGraphError mapChannels(ClipHandle handle, uint8_t clipChannel,
-                                uint8_t outputChannel) override;
-  uint8_t getClipOutputBus(ClipHandle handle) const override;
-
-private:
-  static constexpr uint8_t NUM_GROUPS = 4;
-  static constexpr uint8_t UNASSIGNED_GROUP = 255;
-  static constexpr float MIN_GAIN_DB = -60.0f;
-  static constexpr float MAX_GAIN_DB = 12.0f;
-  static constexpr float SMOOTHING_TIME_MS = 10.0f;
-
-  // Multi-channel routing constants (Feature 7)
-  static constexpr uint8_t MAX_OUTPUT_CHANNELS = 32; // Professional interface limit
-  static constexpr uint8_t MAX_OUTPUT_BUS = 15;      // Bus 15 = channels 31-32
-  static constexpr uint8_t DEFAULT_OUTPUT_BUS = 0;   // Bus 0 = channels 1-2 (stereo)
-
-  // Group state (audio thread)
-  struct GroupState {
-    GainSmoother* gain_smoother;
-    std::atomic<bool> muted;
-    std::atomic<bool> soloed;
-    std::atomic<bool> routed_to_master;
-    float gain_db; // UI thread only (for queries)
-
-    GroupState()
-        : gain_smoother(nullptr), muted(false), soloed(false), routed_to_master(true),
-          gain_db(0.0f) {}
-
-    ~GroupState() {
-      if (gain_smoother) {
-        delete gain_smoother;
-        gain_smoother = nullptr;
-      }
-    }
+namespace {
 
-    // Move constructor (needed for std::array with atomics)
-    GroupState(GroupState&& other) noexcept
-        : gain_smoother(other.gain_smoother), muted(other.muted.load()),
-          soloed(other.soloed.load()), routed_to_master(other.routed_to_master.load()),
-          gain_db(other.gain_db) {
-      other.gain_smoother = nullptr;
-    }
-
-    // Delete copy constructor/assignment (atomics are not copyable)
-    GroupState(const GroupState&) = delete;
-    GroupState& operator=(const GroupState&) = delete;
-    GroupState& operator=(GroupState&&) = delete;
-  };
-
-  // Helper methods
-  void updateSoloState();
-  float dbToLinear(float db) const;
-
-  // Session graph (for clip lookup - reserved for future use)
-  [[maybe_unused]] core::SessionGraph* m_session_graph;
-  [[maybe_unused]] uint32_t m_sample_rate;
-
-  // Clip-to-group mapping (lock-free reads/writes via atomic pointer swap)
-  std::unordered_map<ClipHandle, uint8_t> m_clip_groups;
+/// Spread sequential handles across the hash table (splitmix64 finalizer)
+inline uint64_t mixHandle(ClipHandle handle) {
+  uint64_t x = handle;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
 
-  // Group states
-  std::array<GroupState, NUM_GROUPS> m_groups;
+} // namespace
 
-  // Global solo state (true if any group is soloed)
-  std::atomic<bool> m_solo_active;
+// ============================================================================
+// ClipRoutingTable
+// ============================================================================
 
-  // Multi-channel routing storage (Feature 7)
-  // Output bus per clip (0 = channels 1-2, 1 = channels 3-4, etc.)
-  std::unordered_map<ClipHandle, uint8_t> m_clip_output_bus;
+uint32_t ClipRoutingTable::findSlot(ClipHandle handle) const {
+  if (handle == 0 || !index) {
+    return INVALID_SLOT;
+  }
 
-  // Channel mappings per clip (clipChannel → outputChannel)
-  // Key: ClipHandle, Value: map of clip channel → output channel
-  std::unordered_map<ClipHandle, std::unordered_map<uint8_t, uint8_t>> m_channel_mappings;
-};
+  // Linear probing; load factor <= 0.5 keeps probes short
+  size_t probe = static_cast<size_t>(mixHandle(handle) & index->mask);
+  while (index->keys[probe] != 0) {
+    if (index->keys[probe] == handle) {
+      return index->slots[probe];
+    }
+    probe = (probe + 1) & index->mask;
+  }
+  return INVALID_SLOT;
+}
 
 // ============================================================================
 // ClipRoutingMatrix Implementation
 // ============================================================================
 
+ClipRoutingMatrix::GroupState::GroupState()
+    : gain_smoother(nullptr), muted(false), soloed(false), routed_to_master(true), gain_db(0.0f) {}
+
+ClipRoutingMatrix::GroupState::~GroupState() {
+  if (gain_smoother) {
+    delete gain_smoother;
+    gain_smoother = nullptr;
+  }
+}
+
 ClipRoutingMatrix::ClipRoutingMatrix(core::SessionGraph* sessionGraph, uint32_t sampleRate)
-    : m_session_graph(sessionGraph), m_sample_rate(sampleRate), m_solo_active(false) {
+    : m_session_graph(sessionGraph), m_sample_rate(sampleRate),
+      m_tables(new ClipRoutingTable()), m_solo_active(false) {
   // Initialize group gain smoothers
   for (uint8_t i = 0; i < NUM_GROUPS; ++i) {
     m_groups[i].gain_smoother = new GainSmoother(sampleRate, SMOOTHING_TIME_MS);
@@ -127,7 +69,7 @@ ClipRoutingMatrix::ClipRoutingMatrix(core::SessionGraph* sessionGraph, uint32_t
 }
 
 ClipRoutingMatrix::~ClipRoutingMatrix() {
-  // GainSmooth cleaners are deleted automatically by GroupState destructors
+  // GainSmoothers are deleted by GroupState destructors; tables by m_tables
 }
 
 // ============================================================================
@@ -145,8 +87,12 @@ SessionGraphError ClipRoutingMatrix::assignClipToGroup(ClipHandle handle, uint8_
     return SessionGraphError::InvalidHandle;
   }
 
-  // Update clip-to-group mapping (lock-free: reads are safe, writes are from UI thread)
-  m_clip_groups[handle] = groupIndex;
+  // Update model, then publish a new table for the audio thread
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint32_t slot = slotFor(handle);
+  m_routes[slot].group = groupIndex;
+  routeChanged(slot);
+  publish();
 
   return SessionGraphError::OK;
 }
@@ -212,9 +158,10 @@ SessionGraphError ClipRoutingMatrix::routeGroupToMaster(uint8_t groupIndex, bool
 // ============================================================================
 
 uint8_t ClipRoutingMatrix::getClipGroup(ClipHandle handle) const {
-  auto it = m_clip_groups.find(handle);
-  if (it != m_clip_groups.end()) {
-    return it->second;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_slots.find(handle);
+  if (it != m_slots.end()) {
+    return m_routes[it->second].group;
   }
   return UNASSIGNED_GROUP; // Not assigned
 }
@@ -281,6 +228,94 @@ float ClipRoutingMatrix::dbToLinear(float db) const {
   return std::pow(10.0f, db / 20.0f);
 }
 
+uint32_t ClipRoutingMatrix::slotFor(ClipHandle handle) {
+  auto it = m_slots.find(handle);
+  if (it != m_slots.end()) {
+    return it->second;
+  }
+
+  // Freed slots are reused first; voices resolve their slots again from each new table
+  uint32_t slot;
+  if (!m_free_slots.empty()) {
+    slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_slot_handles[slot] = handle;
+  } else {
+    slot = static_cast<uint32_t>(m_routes.size());
+    m_slot_handles.push_back(handle);
+    m_routes.emplace_back();
+  }
+  m_slots.emplace(handle, slot);
+  m_index_dirty = true;
+  return slot;
+}
+
+void ClipRoutingMatrix::routeChanged(uint32_t slot) {
+  uint32_t page = slot >> ClipRoutingTable::PAGE_SHIFT;
+  if (std::find(m_dirty_pages.begin(), m_dirty_pages.end(), page) == m_dirty_pages.end()) {
+    m_dirty_pages.push_back(page);
+  }
+
+  // Back to the default route: the clip no longer needs a slot
+  if (m_routes[slot] == ClipRoute()) {
+    m_slots.erase(m_slot_handles[slot]);
+    m_slot_handles[slot] = 0;
+    m_free_slots.push_back(slot);
+    m_index_dirty = true;
+  }
+}
+
+void ClipRoutingMatrix::publish() {
+  auto table = std::make_unique<ClipRoutingTable>();
+
+  // Copy only the pages that changed; the rest are shared with earlier tables
+  constexpr size_t PAGE_SLOTS = ClipRoutingTable::PAGE_SLOTS;
+  m_pages.resize((m_routes.size() + PAGE_SLOTS - 1) / PAGE_SLOTS);
+  for (uint32_t page : m_dirty_pages) {
+    auto copy = std::make_shared<ClipRoutingTable::RoutePage>();
+    size_t first = static_cast<size_t>(page) * PAGE_SLOTS;
+    std::copy_n(m_routes.begin() + static_cast<std::ptrdiff_t>(first),
+                std::min(PAGE_SLOTS, m_routes.size() - first), copy->begin());
+    m_pages[page] = std::move(copy);
+  }
+  m_dirty_pages.clear();
+  table->pages = m_pages;
+  table->num_slots = static_cast<uint32_t>(m_routes.size());
+
+  // Rebuild the index only when slots were allocated or freed
+  if (m_index_dirty) {
+    auto index = std::make_shared<ClipRoutingTable::SlotIndex>();
+
+    // Sized to a power of two at <= 50% load
+    size_t capacity = 8;
+    while (capacity < m_slots.size() * 2) {
+      capacity *= 2;
+    }
+    index->keys.assign(capacity, 0);
+    index->slots.assign(capacity, ClipRoutingTable::INVALID_SLOT);
+    index->mask = static_cast<uint32_t>(capacity - 1);
+
+    for (const auto& [handle, slot] : m_slots) {
+      size_t probe = static_cast<size_t>(mixHandle(handle) & index->mask);
+      while (index->keys[probe] != 0) {
+        probe = (probe + 1) & index->mask;
+      }
+      index->keys[probe] = handle;
+      index->slots[probe] = slot;
+    }
+    m_index = std::move(index);
+    m_index_dirty = false;
+  }
+  table->index = m_index;
+
+  // Replaces any table the audio thread has not picked up yet
+  m_tables.publish(std::move(table));
+}
+
+const ClipRoutingTable* ClipRoutingMatrix::acquireTable() {
+  return m_tables.acquire();
+}
+
 // ============================================================================
 // Multi-Channel Routing (Feature 7)
 // ============================================================================
@@ -296,8 +331,12 @@ SessionGraphError ClipRoutingMatrix::setClipOutputBus(ClipHandle handle, uint8_t
     return SessionGraphError::InvalidParameter;
   }
 
-  // Store output bus assignment (lock-free: UI thread only)
-  m_clip_output_bus[handle] = outputBus;
+  // Store output bus assignment and publish
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint32_t slot = slotFor(handle);
+  m_routes[slot].output_bus = outputBus;
+  routeChanged(slot);
+  publish();
 
   return SessionGraphError::OK;
 }
@@ -309,23 +348,26 @@ SessionGraphError ClipRoutingMatrix::mapChannels(ClipHandle handle, uint8_t clip
     return SessionGraphError::InvalidHandle;
   }
 
-  // Validate output channel (0-31)
-  if (outputChannel >= MAX_OUTPUT_CHANNELS) {
+  // Validate output channel (0-31) and clip channel (dense per-clip map)
+  if (outputChannel >= MAX_OUTPUT_CHANNELS || clipChannel >= ClipRoute::MAX_CHANNELS) {
     return SessionGraphError::InvalidParameter;
   }
 
-  // Store channel mapping (lock-free: UI thread only)
-  // Note: We don't validate clipChannel since different clips have different channel counts
-  // The audio thread will clamp to actual clip channel count during rendering
-  m_channel_mappings[handle][clipChannel] = outputChannel;
+  // Store channel mapping and publish
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint32_t slot = slotFor(handle);
+  m_routes[slot].channel_map[clipChannel] = outputChannel;
+  routeChanged(slot);
+  publish();
 
   return SessionGraphError::OK;
 }
 
 uint8_t ClipRoutingMatrix::getClipOutputBus(ClipHandle handle) const {
-  auto it = m_clip_output_bus.find(handle);
-  if (it != m_clip_output_bus.end()) {
-    return it->second;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_slots.find(handle);
+  if (it != m_slots.end()) {
+    return m_routes[it->second].output_bus;
   }
   return DEFAULT_OUTPUT_BUS; // Default to bus 0 (stereo)
 }
@@ -3,5 +3,180 @@
 
 #include <orpheus/clip_routing.h>
 
-// This file intentionally left minimal - implementation details are in clip_routing.cpp
-// The public API is in include/orpheus/clip_routing.h
+#include "table_handoff.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace orpheus {
+
+class GainSmoother;
+
+/// Routing of one clip (slot entry of ClipRoutingTable)
+struct ClipRoute {
+  static constexpr uint8_t MAX_CHANNELS = 8; ///< Clip channels with explicit mappings
+  static constexpr uint8_t FOLLOW_BUS = 255; ///< Channel map entry: use output_bus
+  static constexpr uint8_t NO_GROUP = 255;   ///< Clip not assigned to a Clip Group
+
+  uint8_t group;                                 ///< Clip Group (0-3) or NO_GROUP
+  uint8_t output_bus;                            ///< Output bus (0 = channels 1-2)
+  std::array<uint8_t, MAX_CHANNELS> channel_map; ///< Clip channel → output channel
+
+  ClipRoute() : group(NO_GROUP), output_bus(0) {
+    channel_map.fill(FOLLOW_BUS);
+  }
+
+  bool operator==(const ClipRoute&) const = default;
+};
+
+/// Dense clip routing table (built on UI thread, read by audio thread)
+///
+/// Every clip with a non-default route owns a slot, kept while its route
+/// changes. A clip whose route returns to the default frees its slot for the
+/// next clip routed; voices resolve their slots again whenever a new table is
+/// published. An open-addressing hash resolves a ClipHandle to its slot once,
+/// when a voice starts. After that, per-voice routing is a single page read.
+///
+/// Routes live in fixed-size pages shared between successive tables, so a
+/// publish copies only the pages that changed, and the slot index is shared
+/// until a slot is allocated or freed.
+struct ClipRoutingTable {
+  static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+  static constexpr uint32_t PAGE_SHIFT = 6;
+  static constexpr uint32_t PAGE_SLOTS = 1u << PAGE_SHIFT;
+
+  using RoutePage = std::array<ClipRoute, PAGE_SLOTS>;
+
+  /// Open-addressing handle → slot map
+  struct SlotIndex {
+    std::vector<ClipHandle> keys; ///< 0 = empty
+    std::vector<uint32_t> slots;  ///< Slot for each key
+    uint32_t mask = 0;            ///< keys.size() - 1 (power of two)
+  };
+
+  std::vector<std::shared_ptr<const RoutePage>> pages; ///< [slot / PAGE_SLOTS]
+  uint32_t num_slots = 0;                              ///< Slots in `pages` (free ones hold the default)
+  std::shared_ptr<const SlotIndex> index;              ///< nullptr until a clip is routed
+  ClipRoute default_route;                             ///< Returned for clips without routing
+
+  /// Resolve a handle to its slot (audio thread safe, no allocation)
+  /// @return Slot index, or INVALID_SLOT if the clip has no routing
+  uint32_t findSlot(ClipHandle handle) const;
+
+  /// Route for a slot (default route for INVALID_SLOT or stale slots)
+  const ClipRoute& route(uint32_t slot) const {
+    return slot < num_slots ? (*pages[slot >> PAGE_SHIFT])[slot & (PAGE_SLOTS - 1)]
+                            : default_route;
+  }
+};
+
+/// Clip routing matrix implementation
+///
+/// UI calls mutate a slot-indexed model under a mutex, then publish a fresh
+/// ClipRoutingTable. The audio thread picks the newest table up with
+/// acquireTable() at the start of each buffer (the TableHandoff RoutingGraph
+/// uses for its schedules), so it never sees a partially updated table.
+class ClipRoutingMatrix : public IClipRoutingMatrix {
+public:
+  static constexpr uint8_t NUM_GROUPS = 4;
+
+  ClipRoutingMatrix(core::SessionGraph* sessionGraph, uint32_t sampleRate);
+  ~ClipRoutingMatrix() override;
+
+  // IClipRoutingMatrix interface
+  SessionGraphError assignClipToGroup(ClipHandle handle, uint8_t groupIndex) override;
+  SessionGraphError setGroupGain(uint8_t groupIndex, float gainDb) override;
+  SessionGraphError setGroupMute(uint8_t groupIndex, bool muted) override;
+  SessionGraphError setGroupSolo(uint8_t groupIndex, bool soloed) override;
+  SessionGraphError routeGroupToMaster(uint8_t groupIndex, bool enabled) override;
+
+  uint8_t getClipGroup(ClipHandle handle) const override;
+  float getGroupGain(uint8_t groupIndex) const override;
+  bool isGroupMuted(uint8_t groupIndex) const override;
+  bool isGroupSoloed(uint8_t groupIndex) const override;
+  bool isGroupRoutedToMaster(uint8_t groupIndex) const override;
+
+  // Multi-Channel Routing (Feature 7)
+  SessionGraphError setClipOutputBus(ClipHandle handle, uint8_t outputBus) override;
+  SessionGraphError mapChannels(ClipHandle handle, uint8_t clipChannel,
+                                uint8_t outputChannel) override;
+  uint8_t getClipOutputBus(ClipHandle handle) const override;
+
+  /// Get the newest published routing table (audio thread only)
+  /// @return Current table (never nullptr), stable until the next call
+  /// @note Lock-free, allocation-free
+  const ClipRoutingTable* acquireTable();
+
+private:
+  static constexpr uint8_t UNASSIGNED_GROUP = ClipRoute::NO_GROUP;
+  static constexpr float MIN_GAIN_DB = -60.0f;
+  static constexpr float MAX_GAIN_DB = 12.0f;
+  static constexpr float SMOOTHING_TIME_MS = 10.0f;
+
+  // Multi-channel routing constants (Feature 7)
+  static constexpr uint8_t MAX_OUTPUT_CHANNELS = 32; // Professional interface limit
+  static constexpr uint8_t MAX_OUTPUT_BUS = 15;      // Bus 15 = channels 31-32
+  static constexpr uint8_t DEFAULT_OUTPUT_BUS = 0;   // Bus 0 = channels 1-2 (stereo)
+
+  // Group state (audio thread)
+  struct GroupState {
+    GainSmoother* gain_smoother;
+    std::atomic<bool> muted;
+    std::atomic<bool> soloed;
+    std::atomic<bool> routed_to_master;
+    float gain_db; // UI thread only (for queries)
+
+    GroupState();
+    ~GroupState();
+
+    // Delete copy/move (atomics are not copyable, std::array never moves)
+    GroupState(const GroupState&) = delete;
+    GroupState& operator=(const GroupState&) = delete;
+  };
+
+  // Helper methods
+  void updateSoloState();
+  float dbToLinear(float db) const;
+
+  /// Find or allocate the slot for a clip (UI thread, m_mutex held)
+  uint32_t slotFor(ClipHandle handle);
+
+  /// Mark a slot's route changed, freeing the slot if the route is back to the default
+  void routeChanged(uint32_t slot);
+
+  /// Build a table from the model and hand it to the audio thread (m_mutex held)
+  void publish();
+
+  // Session graph (for clip lookup - reserved for future use)
+  [[maybe_unused]] core::SessionGraph* m_session_graph;
+  [[maybe_unused]] uint32_t m_sample_rate;
+
+  // Clip routing model (UI thread, mutex protected)
+  mutable std::mutex m_mutex;
+  std::unordered_map<ClipHandle, uint32_t> m_slots; // Handle → slot
+  std::vector<ClipHandle> m_slot_handles;           // [slot] (0 = free)
+  std::vector<ClipRoute> m_routes;                  // [slot]
+  std::vector<uint32_t> m_free_slots;               // Reused before the table grows
+
+  // Last published pages and index (publish() replaces only what changed)
+  std::vector<std::shared_ptr<const ClipRoutingTable::RoutePage>> m_pages;
+  std::vector<uint32_t> m_dirty_pages;
+  std::shared_ptr<const ClipRoutingTable::SlotIndex> m_index;
+  bool m_index_dirty = false;
+
+  // Table handoff (UI publishes, audio thread adopts and retires the old one)
+  TableHandoff<ClipRoutingTable> m_tables;
+
+  // Group states
+  std::array<GroupState, NUM_GROUPS> m_groups;
+
+  // Global solo state (true if any group is soloed)
+  std::atomic<bool> m_solo_active;
+};
+
+} // namespace orpheus
@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: MIT
+#include "lookahead_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace orpheus {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/// Windowed-sinc tap (Hann window spanning the full FIR length)
+float windowedSinc(float x, float half_width) {
+  float sinc = (std::abs(x) < 1e-6f) ? 1.0f : std::sin(kPi * x) / (kPi * x);
+  float window = 0.5f * (1.0f + std::cos(kPi * x / half_width));
+  return sinc * window;
+}
+
+} // namespace
+
+LookaheadLimiter::LookaheadLimiter(uint32_t sample_rate, size_t num_channels,
+                                   size_t max_block_frames, float threshold_db,
+                                   float lookahead_ms, float release_ms, bool true_peak)
+    : m_num_channels(num_channels), m_max_block(std::max<size_t>(max_block_frames, 1)),
+      m_true_peak(true_peak), m_true_peak_bound(1.0f), m_prev_inter_sample(0.0f),
+      m_deque_head(0), m_deque_size(0), m_sample_index(0), m_release_state(1.0f), m_box_pos(0),
+      m_box_reducing(0), m_box_sum(0.0), m_min_gain(1.0f) {
+  float sr = static_cast<float>(sample_rate);
+
+  threshold_db = std::clamp(threshold_db, -60.0f, 0.0f);
+  m_threshold = std::pow(10.0f, threshold_db / 20.0f);
+
+  // Look-ahead window: gain reduction fully ramps in over m_lookahead samples
+  lookahead_ms = std::clamp(lookahead_ms, 0.0f, 20.0f);
+  m_lookahead = static_cast<uint32_t>(std::lround(lookahead_ms / 1000.0f * sr));
+  m_delay = m_lookahead + (m_true_peak ? TRUE_PEAK_DELAY : 0);
+
+  // One-pole release (time constant = release_ms)
+  release_ms = std::clamp(release_ms, 1.0f, 1000.0f);
+  m_release_coeff = 1.0f - std::exp(-1.0f / (release_ms / 1000.0f * sr));
+
+  // 4x polyphase interpolator: phase p estimates x[a + p/4] from x[a-3..a+4]
+  for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+    float frac = static_cast<float>(p + 1) / static_cast<float>(TRUE_PEAK_PHASES + 1);
+    float sum = 0.0f;
+    for (size_t t = 0; t < TRUE_PEAK_TAPS; ++t) {
+      float offset = static_cast<float>(t) - static_cast<float>(TRUE_PEAK_DELAY - 1);
+      m_phase_coeffs[p][t] = windowedSinc(frac - offset, static_cast<float>(TRUE_PEAK_DELAY));
+      sum += m_phase_coeffs[p][t];
+    }
+    // Normalise to unity DC gain, track worst-case overshoot for the fast path
+    float abs_sum = 0.0f;
+    for (size_t t = 0; t < TRUE_PEAK_TAPS; ++t) {
+      m_phase_coeffs[p][t] /= sum;
+      abs_sum += std::abs(m_phase_coeffs[p][t]);
+    }
+    m_true_peak_bound = std::max(m_true_peak_bound, abs_sum);
+  }
+
+  // Pre-allocate everything the audio thread touches
+  m_audio_lines.resize(m_num_channels);
+  for (auto& line : m_audio_lines) {
+    line.resize(m_delay + m_max_block, 0.0f);
+  }
+  if (m_true_peak) {
+    m_detection_lines.resize(m_num_channels);
+    for (auto& line : m_detection_lines) {
+      line.resize(TRUE_PEAK_TAPS - 1 + m_max_block, 0.0f);
+    }
+  }
+
+  m_detect.resize(m_max_block, 0.0f);
+  m_gain.resize(m_max_block, 1.0f);
+  m_chunk_ptrs.resize(m_num_channels, nullptr);
+
+  size_t window = m_lookahead + 1;
+  m_deque_values.resize(window, 1.0f);
+  m_deque_index.resize(window, 0);
+  m_box_ring.resize(window, 1.0f);
+
+  reset();
+}
+
+void LookaheadLimiter::reset() {
+  for (auto& line : m_audio_lines) {
+    std::fill(line.begin(), line.end(), 0.0f);
+  }
+  for (auto& line : m_detection_lines) {
+    std::fill(line.begin(), line.end(), 0.0f);
+  }
+
+  m_prev_inter_sample = 0.0f;
+  m_deque_head = 0;
+  m_deque_size = 0;
+  m_sample_index = 0;
+
+  m_release_state = 1.0f;
+  std::fill(m_box_ring.begin(), m_box_ring.end(), 1.0f);
+  m_box_pos = 0;
+  m_box_reducing = 0;
+  m_box_sum = static_cast<double>(m_box_ring.size());
+
+  m_min_gain.store(1.0f, std::memory_order_relaxed);
+}
+
+float LookaheadLimiter::getGainReductionDb() const {
+  float gain = m_min_gain.load(std::memory_order_relaxed);
+  if (gain <= 0.0f) {
+    return -100.0f;
+  }
+  return 20.0f * std::log10(gain);
+}
+
+void LookaheadLimiter::process(float** channels, size_t num_frames) {
+  size_t offset = 0;
+  while (offset < num_frames) {
+    size_t chunk = std::min(m_max_block, num_frames - offset);
+    for (size_t ch = 0; ch < m_num_channels; ++ch) {
+      m_chunk_ptrs[ch] = channels[ch] + offset;
+    }
+    processBlock(m_chunk_ptrs.data(), chunk);
+    offset += chunk;
+  }
+}
+
+void LookaheadLimiter::processBlock(float** channels, size_t num_frames) {
+  // Fast path: nothing in flight and this block cannot reach the ceiling
+  bool idle = m_deque_size == 0 && m_box_reducing == 0 && m_release_state >= 1.0f;
+  if (idle) {
+    float peak = computeBlockPeak(channels, num_frames);
+    if (m_true_peak) {
+      peak *= m_true_peak_bound;
+    }
+
+    if (peak <= m_threshold) {
+      if (m_true_peak) {
+        updateDetectionHistory(channels, num_frames);
+        m_prev_inter_sample = peak; // Upper bound, below threshold
+      }
+      m_sample_index += num_frames;
+      applyDelayAndGain(channels, num_frames, true);
+      m_min_gain.store(1.0f, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  computeDetection(channels, num_frames);
+  computeGain(num_frames);
+  applyDelayAndGain(channels, num_frames, false);
+}
+
+float LookaheadLimiter::computeBlockPeak(float** channels, size_t num_frames) const {
+  float peak = 0.0f;
+  for (size_t ch = 0; ch < m_num_channels; ++ch) {
+    const float* input = channels[ch];
+    for (size_t i = 0; i < num_frames; ++i) {
+      peak = std::max(peak, std::abs(input[i]));
+    }
+    // Interpolator still reads the tail of the previous block
+    if (m_true_peak) {
+      const float* history = m_detection_lines[ch].data();
+      for (size_t i = 0; i < TRUE_PEAK_TAPS - 1; ++i) {
+        peak = std::max(peak, std::abs(history[i]));
+      }
+    }
+  }
+  return peak;
+}
+
+void LookaheadLimiter::computeDetection(float** channels, size_t num_frames) {
+  float* detect = m_detect.data();
+  std::fill(detect, detect + num_frames, 0.0f);
+
+  if (!m_true_peak) {
+    // Linked sample peak
+    for (size_t ch = 0; ch < m_num_channels; ++ch) {
+      const float* input = channels[ch];
+      for (size_t i = 0; i < num_frames; ++i) {
+        detect[i] = std::max(detect[i], std::abs(input[i]));
+      }
+    }
+    return;
+  }
+
+  // Frame i detects sample (i - TRUE_PEAK_DELAY): its own magnitude plus the
+  // inter-sample peaks on both sides. m_gain holds the inter-sample peak of
+  // the interval following that sample until computeGain() overwrites it.
+  constexpr size_t history = TRUE_PEAK_TAPS - 1;
+  float* inter = m_gain.data();
+  std::fill(inter, inter + num_frames, 0.0f);
+
+  for (size_t ch = 0; ch < m_num_channels; ++ch) {
+    float* line = m_detection_lines[ch].data();
+    std::memcpy(line + history, channels[ch], num_frames * sizeof(float));
+
+    for (size_t i = 0; i < num_frames; ++i) {
+      detect[i] = std::max(detect[i], std::abs(line[i + TRUE_PEAK_DELAY - 1]));
+    }
+
+    for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+      const float* coeffs = m_phase_coeffs[p];
+      for (size_t i = 0; i < num_frames; ++i) {
+        float acc = 0.0f;
+        for (size_t t = 0; t < TRUE_PEAK_TAPS; ++t) {
+          acc += coeffs[t] * line[i + t];
+        }
+        inter[i] = std::max(inter[i], std::abs(acc));
+      }
+    }
+
+    std::memmove(line, line + num_frames, history * sizeof(float));
+  }
+
+  float carry = m_prev_inter_sample;
+  for (size_t i = 0; i < num_frames; ++i) {
+    detect[i] = std::max(detect[i], std::max(carry, inter[i]));
+    carry = inter[i];
+  }
+  m_prev_inter_sample = carry;
+}
+
+void LookaheadLimiter::updateDetectionHistory(float** channels, size_t num_frames) {
+  constexpr size_t history = TRUE_PEAK_TAPS - 1;
+  for (size_t ch = 0; ch < m_num_channels; ++ch) {
+    float* line = m_detection_lines[ch].data();
+    std::memcpy(line + history, channels[ch], num_frames * sizeof(float));
+    std::memmove(line, line + num_frames, history * sizeof(float));
+  }
+}
+
+void LookaheadLimiter::computeGain(size_t num_frames) {
+  const float* detect = m_detect.data();
+  float* gain = m_gain.data();
+
+  // Required gain per frame (branch-free, vectorisable)
+  for (size_t i = 0; i < num_frames; ++i) {
+    gain[i] = std::min(1.0f, m_threshold / std::max(detect[i], 1e-9f));
+  }
+
+  // Hold → release → moving average (serial recurrences)
+  float min_gain = 1.0f;
+  for (size_t i = 0; i < num_frames; ++i) {
+    float held = holdMinimum(gain[i]);
+
+    if (held < m_release_state) {
+      m_release_state = held; // Instant attack
+    } else {
+      float next = m_release_state + (held - m_release_state) * m_release_coeff;
+      // Snap once float resolution stalls the approach, so the idle fast path re-engages
+      if (next == m_release_state || held - next < 1e-6f) {
+        next = held;
+      }
+      m_release_state = next;
+    }
+
+    gain[i] = boxFilter(m_release_state);
+    min_gain = std::min(min_gain, gain[i]);
+  }
+
+  m_min_gain.store(min_gain, std::memory_order_relaxed);
+}
+
+float LookaheadLimiter::holdMinimum(float required_gain) {
+  const size_t capacity = m_deque_values.size();
+  const uint64_t index = m_sample_index++;
+
+  // Expire entries that have left the window
+  while (m_deque_size > 0 && index - m_deque_index[m_deque_head] >= capacity) {
+    m_deque_head = (m_deque_head + 1) % capacity;
+    --m_deque_size;
+  }
+
+  // Unity entries never define the minimum, so they are not stored
+  if (required_gain < 1.0f) {
+    while (m_deque_size > 0) {
+      size_t back = (m_deque_head + m_deque_size - 1) % capacity;
+      if (m_deque_values[back] < required_gain) {
+        break;
+      }
+      --m_deque_size;
+    }
+    size_t slot = (m_deque_head + m_deque_size) % capacity;
+    m_deque_values[slot] = required_gain;
+    m_deque_index[slot] = index;
+    ++m_deque_size;
+  }
+
+  return m_deque_size > 0 ? m_deque_values[m_deque_head] : 1.0f;
+}
+
+float LookaheadLimiter::boxFilter(float value) {
+  float old = m_box_ring[m_box_pos];
+  m_box_ring[m_box_pos] = value;
+  m_box_pos = (m_box_pos + 1) % m_box_ring.size();
+
+  if (old < 1.0f) {
+    --m_box_reducing;
+  }
+  if (value < 1.0f) {
+    ++m_box_reducing;
+  }
+
+  if (m_box_reducing == 0) {
+    m_box_sum = static_cast<double>(m_box_ring.size()); // Drop accumulated rounding
+    return 1.0f;
+  }
+
+  m_box_sum += static_cast<double>(value) - static_cast<double>(old);
+  return static_cast<float>(m_box_sum / static_cast<double>(m_box_ring.size()));
+}
+
+void LookaheadLimiter::applyDelayAndGain(float** channels, size_t num_frames, bool unity) {
+  const float* gain = m_gain.data();
+
+  for (size_t ch = 0; ch < m_num_channels; ++ch) {
+    float* line = m_audio_lines[ch].data();
+    float* output = channels[ch];
+
+    std::memcpy(line + m_delay, output, num_frames * sizeof(float));
+
+    if (unity) {
+      std::memcpy(output, line, num_frames * sizeof(float));
+    } else {
+      for (size_t i = 0; i < num_frames; ++i) {
+        output[i] = line[i] * gain[i];
+      }
+    }
+
+    std::memmove(line, line + num_frames, m_delay * sizeof(float));
+  }
+}
+
+} // namespace orpheus
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace orpheus {
+
+/// Look-ahead true-peak limiter for the master bus
+///
+/// Architecture:
+/// - Constructed on the UI thread (all buffers allocated up front)
+/// - Audio thread: Calls process() in place on the master output channels
+///
+/// Design:
+/// - Linked detection (one gain curve for all channels, preserves stereo image)
+/// - Optional 4x polyphase true-peak estimation in the detection path
+/// - Sliding-window minimum of the required gain (monotonic deque, O(1) amortised)
+/// - Instant attack, exponential release, then a moving-average over the
+///   look-ahead window so gain reduction ramps in before the peak arrives
+/// - The audio path is delayed by the look-ahead so the ceiling is guaranteed
+/// - Block-peak fast path: when the limiter is idle and the block cannot reach
+///   the threshold, only the delay line runs
+///
+/// Usage:
+/// @code
+///   LookaheadLimiter limiter(48000, 2, 2048, -1.0f, 1.5f, 50.0f, true);
+///   uint32_t latency = limiter.getLatencySamples(); // Report to the host/driver
+///
+///   // Audio thread:
+///   limiter.process(master_output, num_frames);
+/// @endcode
+class LookaheadLimiter {
+public:
+  /// Construct limiter
+  /// @param sample_rate Sample rate in Hz
+  /// @param num_channels Number of linked channels
+  /// @param max_block_frames Largest block passed to process()
+  /// @param threshold_db Output ceiling in dBFS (dBTP when true_peak is enabled)
+  /// @param lookahead_ms Look-ahead time in milliseconds [0.0, 20.0]
+  /// @param release_ms Release time constant in milliseconds [1.0, 1000.0]
+  /// @param true_peak Estimate inter-sample peaks (adds TRUE_PEAK_DELAY samples of latency)
+  LookaheadLimiter(uint32_t sample_rate, size_t num_channels, size_t max_block_frames,
+                   float threshold_db, float lookahead_ms, float release_ms, bool true_peak);
+
+  /// Process audio in place (audio thread only)
+  /// @param channels Channel buffers (num_channels entries)
+  /// @param num_frames Number of frames (any size, split internally into max_block_frames)
+  /// @note Lock-free, allocation-free. Output is delayed by getLatencySamples().
+  void process(float** channels, size_t num_frames);
+
+  /// Clear delay lines and gain state (audio thread or while stopped)
+  void reset();
+
+  /// Total delay introduced by the limiter in samples
+  uint32_t getLatencySamples() const {
+    return m_delay;
+  }
+
+  /// Lowest gain applied during the last processed block (thread-safe read)
+  /// @return Gain reduction in dB (0.0 = no limiting, negative = limiting)
+  float getGainReductionDb() const;
+
+  /// Detection delay of the true-peak interpolator (half the FIR length)
+  static constexpr uint32_t TRUE_PEAK_DELAY = 4;
+
+private:
+  static constexpr size_t TRUE_PEAK_TAPS = 2 * TRUE_PEAK_DELAY;
+  static constexpr size_t TRUE_PEAK_PHASES = 3; ///< Interpolated points between samples (4x)
+
+  void processBlock(float** channels, size_t num_frames);
+  float computeBlockPeak(float** channels, size_t num_frames) const;
+  void computeDetection(float** channels, size_t num_frames);
+  void updateDetectionHistory(float** channels, size_t num_frames);
+  void computeGain(size_t num_frames);
+  void applyDelayAndGain(float** channels, size_t num_frames, bool unity);
+
+  float holdMinimum(float required_gain);
+  float boxFilter(float value);
+
+  // Configuration (set once in constructor)
+  size_t m_num_channels;
+  size_t m_max_block;
+  float m_threshold;       ///< Linear ceiling
+  float m_release_coeff;   ///< One-pole release coefficient per sample
+  bool m_true_peak;        ///< Inter-sample peak detection enabled
+  uint32_t m_lookahead;    ///< Look-ahead window in samples
+  uint32_t m_delay;        ///< Audio delay (look-ahead + true-peak detection delay)
+  float m_true_peak_bound; ///< Worst-case inter-sample overshoot of the interpolator
+  float m_phase_coeffs[TRUE_PEAK_PHASES][TRUE_PEAK_TAPS];
+
+  // Per-channel scratch (history followed by the current block)
+  std::vector<std::vector<float>> m_audio_lines;     ///< [ch][delay + max_block]
+  std::vector<std::vector<float>> m_detection_lines; ///< [ch][taps - 1 + max_block]
+
+  // Per-block scratch (structure-of-arrays for vectorisation)
+  std::vector<float> m_detect; ///< Linked detection level per frame
+  std::vector<float> m_gain;   ///< Gain per frame
+  std::vector<float*> m_chunk_ptrs;
+  float m_prev_inter_sample;   ///< Inter-sample peak carried across blocks
+
+  // Sliding-window minimum (monotonic deque in a fixed ring)
+  std::vector<float> m_deque_values;
+  std::vector<uint64_t> m_deque_index;
+  size_t m_deque_head;
+  size_t m_deque_size;
+  uint64_t m_sample_index;
+
+  // Release + moving-average state
+  float m_release_state;
+  std::vector<float> m_box_ring;
+  size_t m_box_pos;
+  size_t m_box_reducing; ///< Entries in m_box_ring below unity
+  double m_box_sum;
+
+  std::atomic<float> m_min_gain;
+};
+
+} // namespace orpheus
@@ -0,0 +1,674 @@
+// SPDX-License-Identifier: MIT
+#include "routing_graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <set>
+
+namespace orpheus {
+
+namespace {
+
+/// Channel buffers are padded to a multiple of 16 floats (64 bytes)
+constexpr uint32_t BUFFER_ALIGNMENT_FLOATS = 16;
+
+/// Sum a source into a destination with a linear gain ramp
+/// Mismatched channel counts wrap (mono → stereo duplicates) or fold down
+/// with 1/N scaling (stereo → mono averages).
+void mixInto(const float* const* source, uint8_t source_channels, float* const* destination,
+             uint8_t destination_channels, float start_gain, float end_gain,
+             uint32_t num_frames) {
+  float scale = 1.0f;
+  if (source_channels > destination_channels) {
+    scale = static_cast<float>(destination_channels) / static_cast<float>(source_channels);
+  }
+  start_gain *= scale;
+  end_gain *= scale;
+
+  uint8_t count = std::max(source_channels, destination_channels);
+  for (uint8_t k = 0; k < count; ++k) {
+    const float* input = source[k % source_channels];
+    float* output = destination[k % destination_channels];
+    if (!input) {
+      continue; // Silent input channel
+    }
+
+    if (start_gain == end_gain) {
+      for (uint32_t i = 0; i < num_frames; ++i) {
+        output[i] += input[i] * end_gain;
+      }
+    } else {
+      float step = (end_gain - start_gain) / static_cast<float>(num_frames);
+      for (uint32_t i = 0; i < num_frames; ++i) {
+        output[i] += input[i] * (start_gain + step * static_cast<float>(i + 1));
+      }
+    }
+  }
+}
+
+} // namespace
+
+// ============================================================================
+// RoutingGraph Implementation
+// ============================================================================
+
+RoutingGraph::RoutingGraph()
+    : m_master_id(INVALID_ROUTING_NODE), m_next_id(1), m_pool(nullptr),
+      m_send_gains(std::make_unique<std::atomic<float>[]>(MAX_SENDS)) {
+  m_free_slots.reserve(MAX_SENDS);
+  for (uint32_t slot = MAX_SENDS; slot > 0; --slot) {
+    m_free_slots.push_back(slot - 1);
+  }
+}
+
+RoutingGraph::~RoutingGraph() = default;
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+SessionGraphError RoutingGraph::initialize(const RoutingGraphConfig& config) {
+  if (config.sample_rate == 0 || config.max_frames == 0 || config.max_frames > MAX_FRAMES) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (config.num_inputs == 0 || config.num_inputs > 64) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (config.num_outputs == 0 || config.num_outputs > MAX_ROUTING_NODE_CHANNELS) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_config = config;
+
+  // Connections may still be referenced by the published schedule
+  for (const auto& connection : m_connections) {
+    m_released_slots.push_back(connection.gain_slot);
+  }
+  m_connections.clear();
+  m_nodes.clear();
+
+  NodeModel master;
+  master.type = NodeType::Master;
+  master.name = "Master";
+  master.num_channels = config.num_outputs;
+  master.first_input = 0;
+  m_master_id = m_next_id++;
+  m_nodes.emplace(m_master_id, std::move(master));
+
+  return SessionGraphError::OK;
+}
+
+void RoutingGraph::setWorkerPool(IRoutingWorkerPool* pool) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pool = pool;
+}
+
+// ============================================================================
+// Graph Editing
+// ============================================================================
+
+RoutingNodeId RoutingGraph::getMasterNode() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_master_id;
+}
+
+RoutingNodeId RoutingGraph::addInput(uint8_t first_input, uint8_t num_channels) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_master_id == INVALID_ROUTING_NODE || num_channels == 0 ||
+      num_channels > MAX_ROUTING_NODE_CHANNELS ||
+      static_cast<uint32_t>(first_input) + num_channels > m_config.num_inputs) {
+    return INVALID_ROUTING_NODE;
+  }
+
+  NodeModel node;
+  node.type = NodeType::Input;
+  node.name = "Input " + std::to_string(first_input + 1);
+  node.num_channels = num_channels;
+  node.first_input = first_input;
+
+  RoutingNodeId id = m_next_id++;
+  m_nodes.emplace(id, std::move(node));
+  return id;
+}
+
+RoutingNodeId RoutingGraph::addBus(const std::string& name, uint8_t num_channels) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_master_id == INVALID_ROUTING_NODE || num_channels == 0 ||
+      num_channels > MAX_ROUTING_NODE_CHANNELS) {
+    return INVALID_ROUTING_NODE;
+  }
+
+  NodeModel node;
+  node.type = NodeType::Bus;
+  node.name = name;
+  node.num_channels = num_channels;
+  node.first_input = 0;
+
+  RoutingNodeId id = m_next_id++;
+  m_nodes.emplace(id, std::move(node));
+  return id;
+}
+
+SessionGraphError RoutingGraph::removeNode(RoutingNodeId node) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_nodes.find(node);
+  if (it == m_nodes.end()) {
+    return SessionGraphError::InvalidHandle;
+  }
+  if (it->second.type == NodeType::Master) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  auto removed = std::remove_if(m_connections.begin(), m_connections.end(),
+                                [&](const ConnectionModel& connection) {
+                                  if (connection.source == node || connection.destination == node) {
+                                    releaseSlot(connection.gain_slot);
+                                    return true;
+                                  }
+                                  return false;
+                                });
+  m_connections.erase(removed, m_connections.end());
+  m_nodes.erase(it);
+
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingGraph::connect(RoutingNodeId source, RoutingNodeId destination,
+                                        float gain_db, SendTap tap) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto src = m_nodes.find(source);
+  auto dst = m_nodes.find(destination);
+  if (src == m_nodes.end() || dst == m_nodes.end()) {
+    return SessionGraphError::InvalidHandle;
+  }
+
+  // Signal flows from inputs/buses into buses/master
+  if (source == destination || src->second.type == NodeType::Master ||
+      dst->second.type == NodeType::Input) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (findConnection(source, destination)) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (m_free_slots.empty()) {
+    return SessionGraphError::InternalError; // MAX_SENDS exhausted
+  }
+
+  uint32_t slot = m_free_slots.back();
+  m_free_slots.pop_back();
+  m_send_gains[slot].store(dbToLinear(gain_db), std::memory_order_release);
+
+  m_connections.push_back({source, destination, tap, slot});
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingGraph::disconnect(RoutingNodeId source, RoutingNodeId destination) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = std::find_if(m_connections.begin(), m_connections.end(),
+                         [&](const ConnectionModel& connection) {
+                           return connection.source == source &&
+                                  connection.destination == destination;
+                         });
+  if (it == m_connections.end()) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  releaseSlot(it->gain_slot);
+  m_connections.erase(it);
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingGraph::setSendGain(RoutingNodeId source, RoutingNodeId destination,
+                                            float gain_db) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  ConnectionModel* connection = findConnection(source, destination);
+  if (!connection) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  // Lock-free for the audio thread: it reads the slot at the start of each block
+  m_send_gains[connection->gain_slot].store(dbToLinear(gain_db), std::memory_order_release);
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingGraph::addInsert(RoutingNodeId node,
+                                          std::shared_ptr<IRoutingInsert> insert) {
+  if (!insert) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_nodes.find(node);
+  if (it == m_nodes.end()) {
+    return SessionGraphError::InvalidHandle;
+  }
+  if (it->second.type == NodeType::Input) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  insert->prepare(m_config.sample_rate, m_config.max_frames, it->second.num_channels);
+  it->second.inserts.push_back(std::move(insert));
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingGraph::clearInserts(RoutingNodeId node) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_nodes.find(node);
+  if (it == m_nodes.end()) {
+    return SessionGraphError::InvalidHandle;
+  }
+
+  it->second.inserts.clear();
+  return SessionGraphError::OK;
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+SessionGraphError RoutingGraph::commit() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_master_id == INVALID_ROUTING_NODE) {
+    return SessionGraphError::NotInitialized;
+  }
+
+  SessionGraphError error = SessionGraphError::OK;
+  std::unique_ptr<CompiledSchedule> schedule = compile(error);
+  if (!schedule) {
+    return error;
+  }
+
+  // Gain slots released before the previous commit are free once the audio
+  // thread has picked that commit up (the schedule it runs no longer uses them)
+  if (!m_schedules.hasPending()) {
+    m_free_slots.insert(m_free_slots.end(), m_awaiting_slots.begin(), m_awaiting_slots.end());
+    m_awaiting_slots.clear();
+  }
+  m_awaiting_slots.insert(m_awaiting_slots.end(), m_released_slots.begin(),
+                          m_released_slots.end());
+  m_released_slots.clear();
+
+  m_info = schedule->info;
+
+  // Publish (an unconsumed pending schedule is replaced and freed here)
+  m_schedules.publish(std::move(schedule));
+
+  return SessionGraphError::OK;
+}
+
+std::unique_ptr<CompiledSchedule> RoutingGraph::compile(SessionGraphError& error) const {
+  // Adjacency between processing nodes (buses + master)
+  std::map<RoutingNodeId, std::vector<RoutingNodeId>> outgoing;
+  std::map<RoutingNodeId, std::vector<RoutingNodeId>> incoming;
+  std::map<RoutingNodeId, uint32_t> in_degree;
+  std::map<RoutingNodeId, uint32_t> level;
+
+  for (const auto& [id, node] : m_nodes) {
+    if (node.type != NodeType::Input) {
+      in_degree[id] = 0;
+      level[id] = 0;
+    }
+  }
+  for (const auto& connection : m_connections) {
+    incoming[connection.destination].push_back(connection.source);
+    if (m_nodes.at(connection.source).type != NodeType::Input) {
+      outgoing[connection.source].push_back(connection.destination);
+      ++in_degree[connection.destination];
+    }
+  }
+
+  // Kahn's algorithm: level = longest path from a node fed only by inputs
+  std::deque<RoutingNodeId> ready;
+  for (const auto& [id, degree] : in_degree) {
+    if (degree == 0) {
+      ready.push_back(id);
+    }
+  }
+  size_t visited = 0;
+  while (!ready.empty()) {
+    RoutingNodeId id = ready.front();
+    ready.pop_front();
+    ++visited;
+    for (RoutingNodeId next : outgoing[id]) {
+      level[next] = std::max(level[next], level[id] + 1);
+      if (--in_degree[next] == 0) {
+        ready.push_back(next);
+      }
+    }
+  }
+  if (visited != in_degree.size()) {
+    error = SessionGraphError::InvalidParameter; // Cycle
+    return nullptr;
+  }
+
+  // Prune everything that cannot reach the master
+  std::set<RoutingNodeId> live;
+  std::deque<RoutingNodeId> pending = {m_master_id};
+  live.insert(m_master_id);
+  while (!pending.empty()) {
+    RoutingNodeId id = pending.front();
+    pending.pop_front();
+    for (RoutingNodeId source : incoming[id]) {
+      if (live.insert(source).second) {
+        pending.push_back(source);
+      }
+    }
+  }
+
+  std::vector<RoutingNodeId> order;
+  for (RoutingNodeId id : live) {
+    if (m_nodes.at(id).type != NodeType::Input) {
+      order.push_back(id);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](RoutingNodeId a, RoutingNodeId b) {
+    return level.at(a) < level.at(b);
+  });
+
+  auto schedule = std::make_unique<CompiledSchedule>();
+  schedule->num_inputs = m_config.num_inputs;
+  schedule->num_outputs = m_config.num_outputs;
+  schedule->max_frames = m_config.max_frames;
+  schedule->pool = m_pool;
+  schedule->send_gains = m_send_gains.get();
+
+  // Dense levels
+  std::map<RoutingNodeId, uint32_t> dense_level;
+  for (size_t i = 0; i < order.size(); ++i) {
+    uint32_t raw = level.at(order[i]);
+    if (i == 0 || raw != level.at(order[i - 1])) {
+      schedule->level_offsets.push_back(static_cast<uint32_t>(i));
+    }
+    dense_level[order[i]] = static_cast<uint32_t>(schedule->level_offsets.size() - 1);
+  }
+  schedule->level_offsets.push_back(static_cast<uint32_t>(order.size()));
+
+  // Buffer lifetimes: a node's buffers are live from its level until the
+  // last level that reads them; pre-insert copies only exist when tapped
+  std::map<RoutingNodeId, uint32_t> last_read;
+  std::set<RoutingNodeId> needs_pre;
+  for (const auto& connection : m_connections) {
+    if (!live.count(connection.destination) || !dense_level.count(connection.source)) {
+      continue;
+    }
+    uint32_t reader = dense_level.at(connection.destination);
+    last_read[connection.source] = std::max(last_read[connection.source], reader);
+    if (connection.tap == SendTap::PreInsert && !m_nodes.at(connection.source).inserts.empty()) {
+      needs_pre.insert(connection.source);
+    }
+  }
+
+  // Greedy slot assignment in level order, reusing slots whose readers are done
+  struct Allocation {
+    std::array<uint32_t, MAX_ROUTING_NODE_CHANNELS> post;
+    std::array<uint32_t, MAX_ROUTING_NODE_CHANNELS> pre;
+  };
+  std::map<RoutingNodeId, Allocation> allocations;
+  std::vector<uint32_t> free_slots;
+  std::vector<std::pair<uint32_t, RoutingNodeId>> live_buffers; // (last read level, node)
+  uint32_t num_slots = 0;
+
+  auto takeSlot = [&]() {
+    if (!free_slots.empty()) {
+      uint32_t slot = free_slots.back();
+      free_slots.pop_back();
+      return slot;
+    }
+    return num_slots++;
+  };
+
+  for (uint32_t lvl = 0; lvl + 1 < schedule->level_offsets.size(); ++lvl) {
+    auto expired = std::partition(live_buffers.begin(), live_buffers.end(),
+                                  [&](const auto& entry) { return entry.first >= lvl; });
+    for (auto it = expired; it != live_buffers.end(); ++it) {
+      const NodeModel& model = m_nodes.at(it->second);
+      const Allocation& allocation = allocations.at(it->second);
+      for (uint8_t ch = 0; ch < model.num_channels; ++ch) {
+        free_slots.push_back(allocation.post[ch]);
+        if (needs_pre.count(it->second)) {
+          free_slots.push_back(allocation.pre[ch]);
+        }
+      }
+    }
+    live_buffers.erase(expired, live_buffers.end());
+
+    for (uint32_t i = schedule->level_offsets[lvl]; i < schedule->level_offsets[lvl + 1]; ++i) {
+      RoutingNodeId id = order[i];
+      if (id == m_master_id) {
+        continue; // Renders straight into the output buffers
+      }
+      const NodeModel& model = m_nodes.at(id);
+      Allocation allocation{};
+      for (uint8_t ch = 0; ch < model.num_channels; ++ch) {
+        allocation.post[ch] = takeSlot();
+        if (needs_pre.count(id)) {
+          allocation.pre[ch] = takeSlot();
+        }
+      }
+      allocations[id] = allocation;
+      live_buffers.emplace_back(last_read[id], id);
+    }
+  }
+
+  uint32_t stride = (m_config.max_frames + BUFFER_ALIGNMENT_FLOATS - 1) /
+                    BUFFER_ALIGNMENT_FLOATS * BUFFER_ALIGNMENT_FLOATS;
+  schedule->storage.assign(static_cast<size_t>(num_slots) * stride, 0.0f);
+  auto slotPointer = [&](uint32_t slot) {
+    return schedule->storage.data() + static_cast<size_t>(slot) * stride;
+  };
+
+  // Source table: process() inputs, then each node's post (and pre) channels
+  std::map<RoutingNodeId, uint32_t> post_offset;
+  std::map<RoutingNodeId, uint32_t> pre_offset;
+  schedule->sources.assign(m_config.num_inputs, nullptr);
+
+  for (RoutingNodeId id : order) {
+    const NodeModel& model = m_nodes.at(id);
+
+    CompiledNode node{};
+    node.num_channels = model.num_channels;
+
+    if (id != m_master_id) {
+      const Allocation& allocation = allocations.at(id);
+      post_offset[id] = static_cast<uint32_t>(schedule->sources.size());
+      for (uint8_t ch = 0; ch < model.num_channels; ++ch) {
+        node.channels[ch] = slotPointer(allocation.post[ch]);
+        schedule->sources.push_back(node.channels[ch]);
+      }
+      pre_offset[id] = post_offset[id];
+      if (needs_pre.count(id)) {
+        pre_offset[id] = static_cast<uint32_t>(schedule->sources.size());
+        for (uint8_t ch = 0; ch < model.num_channels; ++ch) {
+          node.pre_insert[ch] = slotPointer(allocation.pre[ch]);
+          schedule->sources.push_back(node.pre_insert[ch]);
+        }
+      }
+    }
+
+    node.first_insert = static_cast<uint32_t>(schedule->inserts.size());
+    node.num_inserts = static_cast<uint32_t>(model.inserts.size());
+    for (const auto& insert : model.inserts) {
+      schedule->inserts.push_back(insert.get());
+      schedule->insert_refs.push_back(insert);
+    }
+
+    schedule->nodes.push_back(node);
+  }
+
+  // Sends (sources always precede their destination in the schedule)
+  for (size_t i = 0; i < order.size(); ++i) {
+    RoutingNodeId id = order[i];
+    CompiledNode& node = schedule->nodes[i];
+    node.first_send = static_cast<uint32_t>(schedule->sends.size());
+
+    for (const auto& connection : m_connections) {
+      if (connection.destination != id || !live.count(connection.source)) {
+        continue;
+      }
+      const NodeModel& source = m_nodes.at(connection.source);
+
+      CompiledSend send{};
+      send.source_channels = source.num_channels;
+      send.gain_slot = connection.gain_slot;
+      send.last_gain = m_send_gains[connection.gain_slot].load(std::memory_order_acquire);
+      if (source.type == NodeType::Input) {
+        send.source_offset = source.first_input;
+      } else if (connection.tap == SendTap::PreInsert) {
+        send.source_offset = pre_offset.at(connection.source);
+      } else {
+        send.source_offset = post_offset.at(connection.source);
+      }
+      schedule->sends.push_back(send);
+    }
+
+    node.num_sends = static_cast<uint32_t>(schedule->sends.size()) - node.first_send;
+  }
+
+  RoutingGraphInfo& info = schedule->info;
+  info.num_nodes = static_cast<uint32_t>(schedule->nodes.size());
+  info.num_sends = static_cast<uint32_t>(schedule->sends.size());
+  info.num_levels = static_cast<uint32_t>(schedule->level_offsets.size() - 1);
+  for (uint32_t lvl = 0; lvl < info.num_levels; ++lvl) {
+    info.max_level_width =
+        std::max(info.max_level_width,
+                 schedule->level_offsets[lvl + 1] - schedule->level_offsets[lvl]);
+  }
+  info.num_channel_buffers = num_slots;
+
+  return schedule;
+}
+
+RoutingGraphInfo RoutingGraph::getInfo() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_info;
+}
+
+// ============================================================================
+// Audio Processing
+// ============================================================================
+
+SessionGraphError RoutingGraph::process(const float* const* inputs, float** outputs,
+                                        uint32_t num_frames) {
+  CompiledSchedule* schedule = m_schedules.acquire();
+  if (!schedule) {
+    return SessionGraphError::NotInitialized;
+  }
+  if (num_frames > schedule->max_frames) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  for (uint8_t i = 0; i < schedule->num_inputs; ++i) {
+    schedule->sources[i] = inputs ? inputs[i] : nullptr;
+  }
+
+  // The master is alone in the last level and renders into the outputs
+  CompiledNode& master = schedule->nodes.back();
+  for (uint8_t ch = 0; ch < schedule->num_outputs; ++ch) {
+    master.channels[ch] = outputs[ch];
+  }
+
+  size_t num_levels = schedule->level_offsets.size() - 1;
+  for (size_t lvl = 0; lvl < num_levels; ++lvl) {
+    uint32_t begin = schedule->level_offsets[lvl];
+    uint32_t end = schedule->level_offsets[lvl + 1];
+
+    if (schedule->pool && end - begin > 1) {
+      schedule->dispatch_begin = begin;
+      schedule->dispatch_frames = num_frames;
+      schedule->pool->run(&RoutingGraph::executeLevelTask, schedule, end - begin);
+    } else {
+      for (uint32_t i = begin; i < end; ++i) {
+        executeNode(*schedule, schedule->nodes[i], num_frames);
+      }
+    }
+  }
+
+  return SessionGraphError::OK;
+}
+
+void RoutingGraph::executeLevelTask(void* context, size_t task_index) {
+  auto* schedule = static_cast<CompiledSchedule*>(context);
+  executeNode(*schedule, schedule->nodes[schedule->dispatch_begin + task_index],
+              schedule->dispatch_frames);
+}
+
+void RoutingGraph::executeNode(CompiledSchedule& schedule, CompiledNode& node,
+                               uint32_t num_frames) {
+  for (uint8_t ch = 0; ch < node.num_channels; ++ch) {
+    std::memset(node.channels[ch], 0, num_frames * sizeof(float));
+  }
+
+  // Gather incoming sends
+  for (uint32_t i = 0; i < node.num_sends; ++i) {
+    CompiledSend& send = schedule.sends[node.first_send + i];
+    float target = schedule.send_gains[send.gain_slot].load(std::memory_order_acquire);
+    float start = send.last_gain;
+    send.last_gain = target;
+
+    if (start == 0.0f && target == 0.0f) {
+      continue;
+    }
+    mixInto(&schedule.sources[send.source_offset], send.source_channels, node.channels.data(),
+            node.num_channels, start, target, num_frames);
+  }
+
+  // Pre-insert tap for aux sends
+  if (node.pre_insert[0]) {
+    for (uint8_t ch = 0; ch < node.num_channels; ++ch) {
+      std::memcpy(node.pre_insert[ch], node.channels[ch], num_frames * sizeof(float));
+    }
+  }
+
+  for (uint32_t i = 0; i < node.num_inserts; ++i) {
+    schedule.inserts[node.first_insert + i]->process(node.channels.data(), node.num_channels,
+                                                      num_frames);
+  }
+}
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+RoutingGraph::ConnectionModel* RoutingGraph::findConnection(RoutingNodeId source,
+                                                            RoutingNodeId destination) {
+  for (auto& connection : m_connections) {
+    if (connection.source == source && connection.destination == destination) {
+      return &connection;
+    }
+  }
+  return nullptr;
+}
+
+void RoutingGraph::releaseSlot(uint32_t slot) {
+  m_released_slots.push_back(slot);
+}
+
+float RoutingGraph::dbToLinear(float db) const {
+  db = std::min(db, 12.0f);
+  if (db <= -100.0f)
+    return 0.0f; // -inf
+  return std::pow(10.0f, db / 20.0f);
+}
+
+// ============================================================================
+// Factory Function
+// ============================================================================
+
+std::unique_ptr<IRoutingGraph> createRoutingGraph() {
+  return std::make_unique<RoutingGraph>();
+}
+
+} // namespace orpheus
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/routing_graph.h>
+
+#include "table_handoff.h"
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+/// Incoming connection of a scheduled node
+struct CompiledSend {
+  uint32_t source_offset;  ///< First channel of the source in CompiledSchedule::sources
+  uint8_t source_channels; ///< Source channel count
+  uint32_t gain_slot;      ///< Index into RoutingGraph::m_send_gains
+  float last_gain;         ///< Gain at the end of the previous block (owning node's thread only)
+};
+
+/// Scheduled bus or master
+struct CompiledNode {
+  std::array<float*, MAX_ROUTING_NODE_CHANNELS> channels;   ///< Post-insert (working) buffers
+  std::array<float*, MAX_ROUTING_NODE_CHANNELS> pre_insert; ///< Pre-insert copy (nullptr if unused)
+  uint8_t num_channels;
+  uint32_t first_send;
+  uint32_t num_sends;
+  uint32_t first_insert;
+  uint32_t num_inserts;
+};
+
+/// Flat execution schedule (built on UI thread, executed on audio thread)
+///
+/// Nodes are stored in topological order grouped by dependency level. Nodes
+/// within a level only read buffers written by earlier levels, so a level
+/// can be dispatched to the worker pool as independent tasks.
+struct CompiledSchedule {
+  std::vector<CompiledNode> nodes;
+  std::vector<uint32_t> level_offsets; ///< Level i = nodes[level_offsets[i], level_offsets[i+1])
+  std::vector<CompiledSend> sends;
+  std::vector<IRoutingInsert*> inserts;
+  std::vector<std::shared_ptr<IRoutingInsert>> insert_refs; ///< Keeps inserts alive
+  std::vector<const float*> sources; ///< [num_inputs] set per block, then node buffers
+  std::vector<float> storage;        ///< Channel buffers (lifetime-based reuse)
+
+  uint8_t num_inputs = 0;
+  uint8_t num_outputs = 0;
+  uint32_t max_frames = 0;
+  IRoutingWorkerPool* pool = nullptr;
+  const std::atomic<float>* send_gains = nullptr;
+
+  // Dispatch state (audio thread)
+  uint32_t dispatch_begin = 0;
+  uint32_t dispatch_frames = 0;
+
+  RoutingGraphInfo info;
+};
+
+/// Routing graph implementation
+class RoutingGraph : public IRoutingGraph {
+public:
+  RoutingGraph();
+  ~RoutingGraph() override;
+
+  // IRoutingGraph interface
+  SessionGraphError initialize(const RoutingGraphConfig& config) override;
+  void setWorkerPool(IRoutingWorkerPool* pool) override;
+
+  RoutingNodeId getMasterNode() const override;
+  RoutingNodeId addInput(uint8_t first_input, uint8_t num_channels) override;
+  RoutingNodeId addBus(const std::string& name, uint8_t num_channels) override;
+  SessionGraphError removeNode(RoutingNodeId node) override;
+
+  SessionGraphError connect(RoutingNodeId source, RoutingNodeId destination, float gain_db,
+                            SendTap tap) override;
+  SessionGraphError disconnect(RoutingNodeId source, RoutingNodeId destination) override;
+  SessionGraphError setSendGain(RoutingNodeId source, RoutingNodeId destination,
+                                float gain_db) override;
+
+  SessionGraphError addInsert(RoutingNodeId node, std::shared_ptr<IRoutingInsert> insert) override;
+  SessionGraphError clearInserts(RoutingNodeId node) override;
+
+  SessionGraphError commit() override;
+  RoutingGraphInfo getInfo() const override;
+
+  SessionGraphError process(const float* const* inputs, float** outputs,
+                            uint32_t num_frames) override;
+
+  static constexpr uint32_t MAX_SENDS = 1024;
+  static constexpr uint32_t MAX_FRAMES = 8192;
+
+private:
+  enum class NodeType : uint8_t { Input, Bus, Master };
+
+  /// Editable node (UI thread)
+  struct NodeModel {
+    NodeType type;
+    std::string name;
+    uint8_t num_channels;
+    uint8_t first_input;
+    std::vector<std::shared_ptr<IRoutingInsert>> inserts;
+  };
+
+  /// Editable connection (UI thread)
+  struct ConnectionModel {
+    RoutingNodeId source;
+    RoutingNodeId destination;
+    SendTap tap;
+    uint32_t gain_slot;
+  };
+
+  std::unique_ptr<CompiledSchedule> compile(SessionGraphError& error) const;
+  ConnectionModel* findConnection(RoutingNodeId source, RoutingNodeId destination);
+  void releaseSlot(uint32_t slot);
+
+  // Audio thread
+  static void executeLevelTask(void* context, size_t task_index);
+  static void executeNode(CompiledSchedule& schedule, CompiledNode& node, uint32_t num_frames);
+
+  float dbToLinear(float db) const;
+
+  // Model (UI thread, mutex protected)
+  mutable std::mutex m_mutex;
+  RoutingGraphConfig m_config;
+  std::map<RoutingNodeId, NodeModel> m_nodes;
+  std::vector<ConnectionModel> m_connections;
+  RoutingNodeId m_master_id;
+  RoutingNodeId m_next_id;
+  IRoutingWorkerPool* m_pool;
+  RoutingGraphInfo m_info;
+
+  // Send gain slots (UI writes, audio thread reads)
+  std::unique_ptr<std::atomic<float>[]> m_send_gains;
+  std::vector<uint32_t> m_free_slots;
+  std::vector<uint32_t> m_released_slots; ///< Disconnected since the last commit
+  std::vector<uint32_t> m_awaiting_slots; ///< Still referenced by the published schedule
+
+  // Schedule handoff (UI publishes, audio thread adopts and retires the old one)
+  TableHandoff<CompiledSchedule> m_schedules;
+};
+
+} // namespace orpheus
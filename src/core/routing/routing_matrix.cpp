@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MIT
 #include "routing_matrix.h"
+#include "biquad_bank.h"
 #include "gain_smoother.h"
+#include "lookahead_limiter.h"
 
 #include <algorithm>
 #include <cmath>
@@ -42,6 +44,14 @@ SessionGraphError RoutingMatrix::initialize(const RoutingConfig& config) {
   if (config.num_outputs < 2 || config.num_outputs > 32) {
     return SessionGraphError::InvalidParameter;
   }
+  if (config.sample_rate < 8000 || config.sample_rate > 384000) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (config.limiter_threshold_db < -24.0f || config.limiter_threshold_db > 0.0f ||
+      config.limiter_lookahead_ms < 0.0f || config.limiter_lookahead_ms > 20.0f ||
+      config.limiter_release_ms < 1.0f || config.limiter_release_ms > 1000.0f) {
+    return SessionGraphError::InvalidParameter;
+  }
 
   // Clean up existing state if reinitializing
   if (m_initialized.load(std::memory_order_acquire)) {
@@ -64,11 +74,17 @@ SessionGraphError RoutingMatrix::initialize(const RoutingConfig& config) {
   if (m_master_gain_smoother) {
     delete m_master_gain_smoother;
   }
-  // TODO: Get sample rate from config (needs to be added)
-  uint32_t sample_rate = 48000; // Default for now
-  m_master_gain_smoother = new GainSmoother(sample_rate, config.gain_smoothing_ms);
+  m_master_gain_smoother = new GainSmoother(config.sample_rate, config.gain_smoothing_ms);
   m_master_gain_smoother->reset(1.0f); // Unity gain
 
+  // Master limiter (allocates its delay lines here, never on the audio thread)
+  m_limiter.reset();
+  if (config.enable_clipping_protection) {
+    m_limiter = std::make_unique<LookaheadLimiter>(
+        config.sample_rate, config.num_outputs, MAX_BUFFER_SIZE, config.limiter_threshold_db,
+        config.limiter_lookahead_ms, config.limiter_release_ms, config.limiter_true_peak);
+  }
+
   // Pre-allocate audio processing buffers
   m_group_buffers.clear();
   m_group_buffers.resize(config.num_groups);
@@ -79,6 +95,31 @@ SessionGraphError RoutingMatrix::initialize(const RoutingConfig& config) {
   m_temp_buffer.clear();
   m_temp_buffer.resize(MAX_BUFFER_SIZE, 0.0f);
 
+  // EQ inserts (all bands bypassed until configured)
+  m_group_eq = std::make_unique<BiquadBank>(config.sample_rate, config.num_groups, MAX_BUFFER_SIZE);
+  m_master_eq =
+      std::make_unique<BiquadBank>(config.sample_rate, config.num_outputs, MAX_BUFFER_SIZE);
+  m_group_eq_lanes.clear();
+  for (auto& buffer : m_group_buffers) {
+    m_group_eq_lanes.push_back(buffer.data());
+  }
+
+  // Snapshot crossfade buffers (recallSnapshot() copies into these without reallocating)
+  size_t num_sends = static_cast<size_t>(config.num_channels) * config.num_groups;
+  for (auto& set : m_morph_sets) {
+    set.scene = CompiledRoutingSnapshot();
+    set.crossfade_frames = 1;
+  }
+  m_morph_from_sends.assign(num_sends, 0.0f);
+  m_morph_from_groups.assign(config.num_groups, 0.0f);
+  m_morph_channel_groups.assign(config.num_channels, UNASSIGNED_GROUP);
+  m_morph_from_master = 1.0f;
+  m_morph_position = 0;
+  m_morph_middle.store(1, std::memory_order_release);
+  m_morph_back = 2;
+  m_morph_front = 0;
+  m_morph_active.store(false, std::memory_order_release);
+
   // Reset metering
   m_master_peak.store(0.0f, std::memory_order_release);
   m_master_rms.store(0.0f, std::memory_order_release);
@@ -311,6 +352,24 @@ SessionGraphError RoutingMatrix::configureGroup(uint8_t group_index, const Group
   return SessionGraphError::OK;
 }
 
+SessionGraphError RoutingMatrix::setGroupEqBand(uint8_t group_index, uint8_t band_index,
+                                                const EqBand& band) {
+  if (!m_initialized.load(std::memory_order_acquire)) {
+    return SessionGraphError::NotInitialized;
+  }
+
+  if (group_index >= m_groups.size() || band_index >= MAX_EQ_BANDS) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  // Coefficients are handed to the audio thread through a lock-free triple buffer
+  if (!m_group_eq->setBand(group_index, band_index, band)) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  return SessionGraphError::OK;
+}
+
 // ============================================================================
 // Master Configuration
 // ============================================================================
@@ -341,6 +400,18 @@ SessionGraphError RoutingMatrix::setMasterMute(bool mute) {
   return SessionGraphError::OK;
 }
 
+SessionGraphError RoutingMatrix::setMasterEqBand(uint8_t band_index, const EqBand& band) {
+  if (!m_initialized.load(std::memory_order_acquire)) {
+    return SessionGraphError::NotInitialized;
+  }
+
+  if (band_index >= MAX_EQ_BANDS || !m_master_eq->setBandAllLanes(band_index, band)) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  return SessionGraphError::OK;
+}
+
 // ============================================================================
 // State Queries
 // ============================================================================
@@ -436,6 +507,14 @@ AudioMeter RoutingMatrix::getMasterMeter() const {
   return meter;
 }
 
+float RoutingMatrix::getLimiterGainReductionDb() const {
+  return m_limiter ? m_limiter->getGainReductionDb() : 0.0f;
+}
+
+uint32_t RoutingMatrix::getLatencySamples() const {
+  return m_limiter ? m_limiter->getLatencySamples() : 0;
+}
+
 // ============================================================================
 // Snapshots
 // ============================================================================
@@ -475,9 +554,14 @@ SessionGraphError RoutingMatrix::loadSnapshot(const RoutingSnapshot& snapshot) {
     return SessionGraphError::InvalidParameter;
   }
 
-  // Load channel states
+  // Load channel states (groups only when snapshots own them)
+  bool load_groups = getConfig().snapshot_channel_groups;
   for (size_t i = 0; i < snapshot.channels.size(); ++i) {
-    configureChannel(static_cast<uint8_t>(i), snapshot.channels[i]);
+    ChannelConfig channel = snapshot.channels[i];
+    if (!load_groups) {
+      channel.group_index = m_channels[i].group_index;
+    }
+    configureChannel(static_cast<uint8_t>(i), channel);
   }
 
   // Load group states
@@ -492,6 +576,154 @@ SessionGraphError RoutingMatrix::loadSnapshot(const RoutingSnapshot& snapshot) {
   return SessionGraphError::OK;
 }
 
+SessionGraphError RoutingMatrix::compileSnapshot(const RoutingSnapshot& snapshot,
+                                                 CompiledRoutingSnapshot& compiled) const {
+  if (!m_initialized.load(std::memory_order_acquire)) {
+    return SessionGraphError::NotInitialized;
+  }
+
+  // Validate snapshot compatibility
+  size_t num_channels = m_channels.size();
+  size_t num_groups = m_groups.size();
+  if (snapshot.channels.size() != num_channels || snapshot.groups.size() != num_groups) {
+    return SessionGraphError::InvalidParameter;
+  }
+  for (const auto& channel : snapshot.channels) {
+    if (channel.group_index != UNASSIGNED_GROUP && channel.group_index >= num_groups) {
+      return SessionGraphError::InvalidParameter;
+    }
+  }
+
+  // Same clamping as the individual setters, so the end of the crossfade
+  // lands exactly on what the gain smoothers will hold
+  auto faderGain = [this](float gain_db) {
+    return std::clamp(dbToLinear(std::clamp(gain_db, -100.0f, 12.0f)), 0.0f, 1.0f);
+  };
+
+  compiled.num_channels = static_cast<uint8_t>(num_channels);
+  compiled.num_groups = static_cast<uint8_t>(num_groups);
+  compiled.channel_gains.resize(num_channels);
+  compiled.channel_pans.resize(num_channels);
+  compiled.channel_groups.resize(num_channels);
+  compiled.channel_mutes.resize(num_channels);
+  compiled.channel_solos.resize(num_channels);
+  compiled.group_gains.resize(num_groups);
+  compiled.group_mutes.resize(num_groups);
+  compiled.group_solos.resize(num_groups);
+
+  compiled.solo_active = false;
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    const ChannelConfig& channel = snapshot.channels[ch];
+    compiled.channel_gains[ch] = faderGain(channel.gain_db);
+    compiled.channel_pans[ch] = std::clamp(channel.pan, -1.0f, 1.0f);
+    compiled.channel_groups[ch] = channel.group_index;
+    compiled.channel_mutes[ch] = channel.mute ? 1 : 0;
+    compiled.channel_solos[ch] = channel.solo ? 1 : 0;
+    compiled.solo_active = compiled.solo_active || channel.solo;
+  }
+  for (size_t grp = 0; grp < num_groups; ++grp) {
+    const GroupConfig& group = snapshot.groups[grp];
+    compiled.group_gains[grp] = faderGain(group.gain_db);
+    compiled.group_mutes[grp] = group.mute ? 1 : 0;
+    compiled.group_solos[grp] = group.solo ? 1 : 0;
+    compiled.solo_active = compiled.solo_active || group.solo;
+  }
+  compiled.master_gain = faderGain(snapshot.master_gain_db);
+  compiled.master_mute = snapshot.master_mute;
+
+  // Effective levels (same mute/solo logic as isChannelMuted()/isGroupMuted())
+  compiled.channel_levels.resize(num_channels);
+  compiled.send_levels.assign(num_channels * num_groups, 0.0f);
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    uint8_t grp = compiled.channel_groups[ch];
+    bool muted = compiled.channel_mutes[ch] ||
+                 (compiled.solo_active && !compiled.channel_solos[ch]);
+    compiled.channel_levels[ch] = muted ? 0.0f : compiled.channel_gains[ch];
+    if (grp != UNASSIGNED_GROUP) {
+      compiled.send_levels[ch * num_groups + grp] = compiled.channel_levels[ch];
+    }
+  }
+  compiled.group_levels.resize(num_groups);
+  for (size_t grp = 0; grp < num_groups; ++grp) {
+    bool muted = compiled.group_mutes[grp] || (compiled.solo_active && !compiled.group_solos[grp]);
+    compiled.group_levels[grp] = muted ? 0.0f : compiled.group_gains[grp];
+  }
+  compiled.master_level = compiled.master_mute ? 0.0f : compiled.master_gain;
+
+  return SessionGraphError::OK;
+}
+
+SessionGraphError RoutingMatrix::recallSnapshot(const CompiledRoutingSnapshot& compiled,
+                                                float crossfade_ms) {
+  if (!m_initialized.load(std::memory_order_acquire)) {
+    return SessionGraphError::NotInitialized;
+  }
+
+  // Validate compiled snapshot against the current layout
+  size_t num_channels = m_channels.size();
+  size_t num_groups = m_groups.size();
+  if (compiled.num_channels != num_channels || compiled.num_groups != num_groups ||
+      compiled.channel_gains.size() != num_channels ||
+      compiled.channel_pans.size() != num_channels ||
+      compiled.channel_groups.size() != num_channels ||
+      compiled.channel_mutes.size() != num_channels ||
+      compiled.channel_solos.size() != num_channels || compiled.group_gains.size() != num_groups ||
+      compiled.group_mutes.size() != num_groups || compiled.group_solos.size() != num_groups ||
+      compiled.group_levels.size() != num_groups ||
+      compiled.channel_levels.size() != num_channels ||
+      compiled.send_levels.size() != num_channels * num_groups) {
+    return SessionGraphError::InvalidParameter;
+  }
+  if (!(crossfade_ms >= 0.0f) || crossfade_ms > 60000.0f) {
+    return SessionGraphError::InvalidParameter;
+  }
+
+  RoutingConfig config = getConfig();
+  double frames = static_cast<double>(crossfade_ms) * config.sample_rate / 1000.0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_morph_mutex);
+
+    // Fill the UI-owned set, then swap it into the shared slot (lock-free for the audio thread)
+    MorphTarget& target = m_morph_sets[m_morph_back];
+    target.scene = compiled;
+    target.crossfade_frames = std::max<uint32_t>(1, static_cast<uint32_t>(frames));
+
+    uint8_t previous = m_morph_middle.exchange(static_cast<uint8_t>(m_morph_back | MORPH_DIRTY),
+                                               std::memory_order_acq_rel);
+    m_morph_back = static_cast<uint8_t>(previous & ~MORPH_DIRTY);
+  }
+
+  // UI-side mirrors (the audio thread applies the live state when the crossfade completes)
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    ChannelConfig& channel = m_channels[ch].config;
+    channel.gain_db = linearToDb(compiled.channel_gains[ch]);
+    channel.pan = compiled.channel_pans[ch];
+    if (config.snapshot_channel_groups) {
+      channel.group_index = compiled.channel_groups[ch];
+    }
+    channel.mute = compiled.channel_mutes[ch] != 0;
+    channel.solo = compiled.channel_solos[ch] != 0;
+    updatePanLaw(static_cast<uint8_t>(ch), channel.pan);
+  }
+  for (size_t grp = 0; grp < num_groups; ++grp) {
+    GroupConfig& group = m_groups[grp].config;
+    group.gain_db = linearToDb(compiled.group_gains[grp]);
+    group.mute = compiled.group_mutes[grp] != 0;
+    group.solo = compiled.group_solos[grp] != 0;
+  }
+
+  return SessionGraphError::OK;
+}
+
+bool RoutingMatrix::isSnapshotMorphing() const {
+  // Audio thread raises m_morph_active before it clears the dirty flag
+  if (m_morph_middle.load(std::memory_order_acquire) & MORPH_DIRTY) {
+    return true;
+  }
+  return m_morph_active.load(std::memory_order_acquire);
+}
+
 SessionGraphError RoutingMatrix::reset() {
   if (!m_initialized.load(std::memory_order_acquire)) {
     return SessionGraphError::NotInitialized;
@@ -509,6 +741,12 @@ SessionGraphError RoutingMatrix::reset() {
     configureGroup(static_cast<uint8_t>(i), default_config);
   }
 
+  // Bypass all EQ bands
+  for (uint8_t band = 0; band < MAX_EQ_BANDS; ++band) {
+    m_group_eq->setBandAllLanes(band, EqBand());
+    m_master_eq->setBandAllLanes(band, EqBand());
+  }
+
   // Reset master
   setMasterGain(0.0f); // Unity gain
   setMasterMute(false);
@@ -534,6 +772,20 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
   int config_idx = m_active_config_idx.load(std::memory_order_acquire);
   const RoutingConfig& config = m_config_buffers[config_idx];
 
+  // Snapshot crossfade: every level ramps linearly from t0 to t1 across this buffer
+  bool morphing = acquireMorph(config);
+  float morph_t0 = 0.0f;
+  float morph_t1 = 0.0f;
+  uint32_t morph_end = 0;
+  const CompiledRoutingSnapshot& scene = m_morph_sets[m_morph_front].scene;
+  if (morphing) {
+    uint32_t total = m_morph_sets[m_morph_front].crossfade_frames;
+    morph_end = std::min(m_morph_position + num_frames, total);
+    morph_t0 = static_cast<float>(m_morph_position) / static_cast<float>(total);
+    morph_t1 = static_cast<float>(morph_end) / static_cast<float>(total);
+  }
+  float inv_frames = num_frames > 0 ? 1.0f / static_cast<float>(num_frames) : 0.0f;
+
   // ========================================================================
   // Step 1: Clear group buffers
   // ========================================================================
@@ -550,6 +802,30 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
     auto& channel = m_channels[ch];
     uint8_t group_idx = channel.group_index;
 
+    // Crossfading: dense channel → group sends (covers group moves and mutes)
+    if (morphing) {
+      const float* input = channel_inputs[ch];
+      if (input == nullptr) {
+        continue; // Silent channel adds nothing
+      }
+      size_t send_base = static_cast<size_t>(ch) * config.num_groups;
+      for (uint8_t grp = 0; grp < config.num_groups; ++grp) {
+        float from = m_morph_from_sends[send_base + grp];
+        float to = sceneSendLevel(scene, config, ch, grp);
+        float start = from + (to - from) * morph_t0;
+        float end = from + (to - from) * morph_t1;
+        if (start == 0.0f && end == 0.0f) {
+          continue;
+        }
+        float step = (end - start) * inv_frames;
+        float* group_buffer = m_group_buffers[grp].data();
+        for (uint32_t frame = 0; frame < num_frames; ++frame) {
+          group_buffer[frame] += input[frame] * (start + step * static_cast<float>(frame));
+        }
+      }
+      continue;
+    }
+
     // Skip if unassigned or group index invalid
     if (group_idx == UNASSIGNED_GROUP || group_idx >= config.num_groups) {
       continue;
@@ -566,28 +842,38 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
     // Get group buffer
     float* group_buffer = m_group_buffers[group_idx].data();
 
-    // Process channel gain + sum into group
-    // For stereo: mono input → pan to L/R → sum into group buffer
-    for (uint32_t frame = 0; frame < num_frames; ++frame) {
-      // Get smoothed gain values for this sample
-      float channel_gain = channel.gain_smoother->process();
+    if (input == nullptr) {
+      // No audio (e.g. a voice in silent blocks): skip the sum, but keep the
+      // smoothers moving so gain ramps stay sample-aligned
+      for (uint32_t frame = 0; frame < num_frames; ++frame) {
+        channel.gain_smoother->process();
+        channel.pan_left->process();
+        channel.pan_right->process();
+      }
+    } else {
+      // Process channel gain + sum into group
+      // For stereo: mono input → pan to L/R → sum into group buffer
+      for (uint32_t frame = 0; frame < num_frames; ++frame) {
+        // Get smoothed gain values for this sample
+        float channel_gain = channel.gain_smoother->process();
 
-      // TODO: Stereo panning requires dual group buffers (L/R per group)
-      // For now, just advance pan smoothers to keep them in sync
-      float pan_left = channel.pan_left->process();
-      float pan_right = channel.pan_right->process();
-      (void)pan_left;  // Unused for now
-      (void)pan_right; // Unused for now
+        // TODO: Stereo panning requires dual group buffers (L/R per group)
+        // For now, just advance pan smoothers to keep them in sync
+        float pan_left = channel.pan_left->process();
+        float pan_right = channel.pan_right->process();
+        (void)pan_left;  // Unused for now
+        (void)pan_right; // Unused for now
 
-      // Read input sample
-      float sample = input[frame];
+        // Read input sample
+        float sample = input[frame];
 
-      // Apply channel gain
-      sample *= channel_gain;
+        // Apply channel gain
+        sample *= channel_gain;
 
-      // For stereo output: sum L/R panned samples
-      // (For now, sum mono signal - full stereo panning requires 2 group buffers per group)
-      group_buffer[frame] += sample; // Mono sum for now
+        // For stereo output: sum L/R panned samples
+        // (For now, sum mono signal - full stereo panning requires 2 group buffers per group)
+        group_buffer[frame] += sample; // Mono sum for now
+      }
     }
 
     // Update channel meters (if enabled)
@@ -600,8 +886,11 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
   }
 
   // ========================================================================
-  // Step 3: Process groups → master
+  // Step 3: Group EQ, then process groups → master
   // ========================================================================
+  // All groups are filtered together, four per SIMD register
+  m_group_eq->process(m_group_eq_lanes.data(), num_frames);
+
   // Clear master output first
   for (uint8_t out = 0; out < config.num_outputs; ++out) {
     std::memset(master_output[out], 0, num_frames * sizeof(float));
@@ -609,15 +898,34 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
 
   for (uint8_t grp = 0; grp < config.num_groups; ++grp) {
     auto& group = m_groups[grp];
+    float* group_buffer = m_group_buffers[grp].data();
+
+    // Crossfading: ramp the effective group level (mute/solo folded in)
+    if (morphing) {
+      float from = m_morph_from_groups[grp];
+      float to = scene.group_levels[grp];
+      float start = from + (to - from) * morph_t0;
+      float end = from + (to - from) * morph_t1;
+      float step = (end - start) * inv_frames;
+      if (start != 0.0f || end != 0.0f) {
+        for (uint32_t frame = 0; frame < num_frames; ++frame) {
+          float sample = group_buffer[frame] * (start + step * static_cast<float>(frame));
+          for (uint8_t out = 0; out < std::min(config.num_outputs, (uint8_t)2); ++out) {
+            master_output[out][frame] += sample;
+          }
+        }
+      }
+      if (config.enable_metering) {
+        processMetering(group_buffer, num_frames, group.peak_level, group.rms_level);
+      }
+      continue;
+    }
 
     // Check if group is effectively muted
     if (isGroupMuted(grp)) {
       continue;
     }
 
-    // Get group buffer
-    float* group_buffer = m_group_buffers[grp].data();
-
     // Process group gain + sum into master
     for (uint32_t frame = 0; frame < num_frames; ++frame) {
       // Get smoothed group gain for this sample
@@ -645,25 +953,47 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
   }
 
   // ========================================================================
-  // Step 4: Apply master gain/mute
+  // Step 4: Apply master gain/mute, then master EQ
   // ========================================================================
   bool master_muted = m_master_mute.load(std::memory_order_acquire);
 
-  for (uint32_t frame = 0; frame < num_frames; ++frame) {
-    // Get smoothed master gain for this sample
-    float master_gain = m_master_gain_smoother->process();
+  if (morphing) {
+    float start = m_morph_from_master + (scene.master_level - m_morph_from_master) * morph_t0;
+    float end = m_morph_from_master + (scene.master_level - m_morph_from_master) * morph_t1;
+    float step = (end - start) * inv_frames;
+    for (uint32_t frame = 0; frame < num_frames; ++frame) {
+      float master_gain = start + step * static_cast<float>(frame);
+      for (uint8_t out = 0; out < config.num_outputs; ++out) {
+        master_output[out][frame] *= master_gain;
+      }
+    }
+
+    m_morph_position = morph_end;
 
-    // Apply mute
-    if (master_muted) {
-      master_gain = 0.0f;
+    // Crossfade complete: hand the final state to the regular controls
+    if (morph_end >= m_morph_sets[m_morph_front].crossfade_frames) {
+      finishMorph(config);
     }
+  } else {
+    for (uint32_t frame = 0; frame < num_frames; ++frame) {
+      // Get smoothed master gain for this sample
+      float master_gain = m_master_gain_smoother->process();
 
-    // Apply master gain to all output channels
-    for (uint8_t out = 0; out < config.num_outputs; ++out) {
-      master_output[out][frame] *= master_gain;
+      // Apply mute
+      if (master_muted) {
+        master_gain = 0.0f;
+      }
+
+      // Apply master gain to all output channels
+      for (uint8_t out = 0; out < config.num_outputs; ++out) {
+        master_output[out][frame] *= master_gain;
+      }
     }
   }
 
+  // Master EQ (ahead of metering so meters show what the limiter sees)
+  m_master_eq->process(master_output, num_frames);
+
   // ========================================================================
   // Step 5: Update master meters (if enabled)
   // ========================================================================
@@ -681,26 +1011,19 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
   }
 
   // ========================================================================
-  // Step 6: Apply clipping protection (soft limiter + hard clip)
+  // Step 6: Apply clipping protection (look-ahead limiter + hard clip)
   // ========================================================================
   // OCC109 v0.2.2: Fix "Stop All" distortion when 32 clips fade out simultaneously
-  // Soft limiter prevents audible distortion when summed gains exceed 0dBFS
-  if (config.enable_clipping_protection) {
+  // The limiter ramps gain down ahead of overs instead of waveshaping them, so
+  // summed peaks stay below the ceiling without adding harmonic distortion
+  if (config.enable_clipping_protection && m_limiter) {
+    m_limiter->process(master_output, num_frames);
+
+    // Hard clip as safety (broadcast-safe, never exceeds ±1.0)
     for (uint8_t out = 0; out < config.num_outputs; ++out) {
+      float* output = master_output[out];
       for (uint32_t frame = 0; frame < num_frames; ++frame) {
-        float sample = master_output[out][frame];
-
-        // Soft-knee limiter using tanh (smooth compression near ±1.0)
-        // tanh(x) naturally compresses values approaching ±infinity to ±1.0
-        // Scale factor 0.9 provides headroom and prevents hard clipping
-        if (std::abs(sample) > 0.9f) {
-          sample = std::tanh(sample * 0.9f) / 0.9f;
-        }
-
-        // Hard clip as safety (broadcast-safe, never exceeds ±1.0)
-        sample = std::max(-1.0f, std::min(1.0f, sample));
-
-        master_output[out][frame] = sample;
+        output[frame] = std::clamp(output[frame], -1.0f, 1.0f);
       }
     }
   }
@@ -713,12 +1036,10 @@ SessionGraphError RoutingMatrix::processRouting(const float* const* channel_inpu
 // ============================================================================
 
 void RoutingMatrix::initializeChannels() {
-  // TODO: Get sample rate from config
-  uint32_t sample_rate = 48000;
-
   // Get active config (lock-free read)
   int config_idx = m_active_config_idx.load(std::memory_order_acquire);
   const RoutingConfig& config = m_config_buffers[config_idx];
+  uint32_t sample_rate = config.sample_rate;
 
   m_channels.clear();
   m_channels.reserve(config.num_channels);
@@ -756,12 +1077,10 @@ void RoutingMatrix::initializeChannels() {
 }
 
 void RoutingMatrix::initializeGroups() {
-  // TODO: Get sample rate from config
-  uint32_t sample_rate = 48000;
-
   // Get active config (lock-free read)
   int config_idx = m_active_config_idx.load(std::memory_order_acquire);
   const RoutingConfig& config = m_config_buffers[config_idx];
+  uint32_t sample_rate = config.sample_rate;
 
   m_groups.clear();
   m_groups.reserve(config.num_groups);
@@ -818,6 +1137,101 @@ void RoutingMatrix::cleanupGroups() {
   m_groups.clear();
 }
 
+bool RoutingMatrix::acquireMorph(const RoutingConfig& config) {
+  if (m_morph_middle.load(std::memory_order_acquire) & MORPH_DIRTY) {
+    if (m_morph_active.load(std::memory_order_relaxed)) {
+      // Interrupted crossfade: freeze the current mix as the new starting point
+      // (the outgoing set is still audio-owned until the exchange below)
+      const MorphTarget& current = m_morph_sets[m_morph_front];
+      float t = static_cast<float>(m_morph_position) / static_cast<float>(current.crossfade_frames);
+      for (uint8_t ch = 0; ch < config.num_channels; ++ch) {
+        for (uint8_t grp = 0; grp < config.num_groups; ++grp) {
+          float& from = m_morph_from_sends[static_cast<size_t>(ch) * config.num_groups + grp];
+          from += (sceneSendLevel(current.scene, config, ch, grp) - from) * t;
+        }
+      }
+      for (size_t i = 0; i < m_morph_from_groups.size(); ++i) {
+        m_morph_from_groups[i] += (current.scene.group_levels[i] - m_morph_from_groups[i]) * t;
+      }
+      m_morph_from_master += (current.scene.master_level - m_morph_from_master) * t;
+    } else {
+      captureMorphSource(config);
+    }
+
+    // Route the crossfade by the assignment at its start; later moves apply when it completes
+    for (uint8_t ch = 0; ch < config.num_channels; ++ch) {
+      m_morph_channel_groups[ch] = m_channels[ch].group_index;
+    }
+
+    // Raise the active flag before clearing dirty so isSnapshotMorphing() never gaps
+    m_morph_active.store(true, std::memory_order_release);
+    uint8_t previous = m_morph_middle.exchange(m_morph_front, std::memory_order_acq_rel);
+    m_morph_front = static_cast<uint8_t>(previous & ~MORPH_DIRTY);
+    m_morph_position = 0;
+  }
+
+  return m_morph_active.load(std::memory_order_relaxed);
+}
+
+void RoutingMatrix::captureMorphSource(const RoutingConfig& config) {
+  // Express the live (smoother/mute/solo) state as dense effective levels
+  std::fill(m_morph_from_sends.begin(), m_morph_from_sends.end(), 0.0f);
+  for (uint8_t ch = 0; ch < config.num_channels; ++ch) {
+    uint8_t grp = m_channels[ch].group_index;
+    if (grp != UNASSIGNED_GROUP && grp < config.num_groups && !isChannelMuted(ch)) {
+      m_morph_from_sends[static_cast<size_t>(ch) * config.num_groups + grp] =
+          m_channels[ch].gain_smoother->getCurrent();
+    }
+  }
+
+  for (uint8_t grp = 0; grp < config.num_groups; ++grp) {
+    m_morph_from_groups[grp] = isGroupMuted(grp) ? 0.0f : m_groups[grp].gain_smoother->getCurrent();
+  }
+
+  bool master_muted = m_master_mute.load(std::memory_order_acquire);
+  m_morph_from_master = master_muted ? 0.0f : m_master_gain_smoother->getCurrent();
+}
+
+void RoutingMatrix::finishMorph(const RoutingConfig& config) {
+  const CompiledRoutingSnapshot& scene = m_morph_sets[m_morph_front].scene;
+
+  // Final levels match the last crossfade sample, so this switch is seamless
+  for (uint8_t ch = 0; ch < config.num_channels; ++ch) {
+    auto& channel = m_channels[ch];
+    channel.gain_smoother->reset(scene.channel_gains[ch]);
+    if (config.snapshot_channel_groups) {
+      channel.group_index = scene.channel_groups[ch];
+    }
+    channel.mute.store(scene.channel_mutes[ch] != 0, std::memory_order_release);
+    channel.solo.store(scene.channel_solos[ch] != 0, std::memory_order_release);
+  }
+
+  for (uint8_t grp = 0; grp < config.num_groups; ++grp) {
+    auto& group = m_groups[grp];
+    group.gain_smoother->reset(scene.group_gains[grp]);
+    group.mute.store(scene.group_mutes[grp] != 0, std::memory_order_release);
+    group.solo.store(scene.group_solos[grp] != 0, std::memory_order_release);
+  }
+
+  m_master_gain_smoother->reset(scene.master_gain);
+  m_master_mute.store(scene.master_mute, std::memory_order_release);
+  m_solo_active.store(scene.solo_active, std::memory_order_release);
+
+  m_morph_active.store(false, std::memory_order_release);
+}
+
+float RoutingMatrix::sceneSendLevel(const CompiledRoutingSnapshot& scene,
+                                   const RoutingConfig& config, uint8_t channel_index,
+                                   uint8_t group_index) const {
+  if (config.snapshot_channel_groups) {
+    return scene.send_levels[static_cast<size_t>(channel_index) * config.num_groups + group_index];
+  }
+  // Groups stay live: the channel's level lands where it was assigned when the crossfade started
+  return m_morph_channel_groups[channel_index] == group_index
+             ? scene.channel_levels[channel_index]
+             : 0.0f;
+}
+
 void RoutingMatrix::updateSoloState() {
   // Check if any channel or group is solo'd
   bool any_solo = false;
@@ -5,13 +5,16 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 namespace orpheus {
 
-// Forward declaration for gain smoother
+// Forward declarations
 class GainSmoother;
+class BiquadBank;
+class LookaheadLimiter;
 
 /// Internal channel state (audio thread)
 struct ChannelState {
@@ -110,10 +113,13 @@ public:
   SessionGraphError setGroupMute(uint8_t group_index, bool mute) override;
   SessionGraphError setGroupSolo(uint8_t group_index, bool solo) override;
   SessionGraphError configureGroup(uint8_t group_index, const GroupConfig& config) override;
+  SessionGraphError setGroupEqBand(uint8_t group_index, uint8_t band_index,
+                                   const EqBand& band) override;
 
   // Master configuration
   SessionGraphError setMasterGain(float gain_db) override;
   SessionGraphError setMasterMute(bool mute) override;
+  SessionGraphError setMasterEqBand(uint8_t band_index, const EqBand& band) override;
 
   // State queries
   bool isSoloActive() const override;
@@ -122,10 +128,17 @@ public:
   AudioMeter getChannelMeter(uint8_t channel_index) const override;
   AudioMeter getGroupMeter(uint8_t group_index) const override;
   AudioMeter getMasterMeter() const override;
+  float getLimiterGainReductionDb() const override;
+  uint32_t getLatencySamples() const override;
 
   // Snapshots
   RoutingSnapshot saveSnapshot(const std::string& name) override;
   SessionGraphError loadSnapshot(const RoutingSnapshot& snapshot) override;
+  SessionGraphError compileSnapshot(const RoutingSnapshot& snapshot,
+                                    CompiledRoutingSnapshot& compiled) const override;
+  SessionGraphError recallSnapshot(const CompiledRoutingSnapshot& compiled,
+                                   float crossfade_ms) override;
+  bool isSnapshotMorphing() const override;
   SessionGraphError reset() override;
 
   // Audio processing
@@ -149,6 +162,13 @@ private:
                        std::atomic<float>& rms);
   bool detectClipping(float* buffer, size_t num_frames);
 
+  // Snapshot crossfade (audio thread)
+  bool acquireMorph(const RoutingConfig& config);
+  void captureMorphSource(const RoutingConfig& config);
+  void finishMorph(const RoutingConfig& config);
+  float sceneSendLevel(const CompiledRoutingSnapshot& scene, const RoutingConfig& config,
+                       uint8_t channel_index, uint8_t group_index) const;
+
   // Configuration (lock-free double-buffer pattern)
   RoutingConfig m_config_buffers[2];
   std::atomic<int> m_active_config_idx{0}; // 0 or 1, for lock-free reads
@@ -165,6 +185,36 @@ private:
   std::atomic<float> m_master_rms;
   std::atomic<uint32_t> m_master_clip_count;
 
+  // Master limiter (clipping protection)
+  std::unique_ptr<LookaheadLimiter> m_limiter;
+
+  // EQ inserts (one lane per group, one lane per master output)
+  std::unique_ptr<BiquadBank> m_group_eq;
+  std::unique_ptr<BiquadBank> m_master_eq;
+  std::vector<float*> m_group_eq_lanes; // Group buffer pointers (pre-allocated)
+
+  /// Scene handed from UI to audio thread
+  struct MorphTarget {
+    CompiledRoutingSnapshot scene;
+    uint32_t crossfade_frames = 1;
+  };
+
+  // Snapshot crossfade (lock-free triple buffer, sized in initialize())
+  std::mutex m_morph_mutex;               // Serializes recallSnapshot() callers
+  std::array<MorphTarget, 3> m_morph_sets;
+  std::atomic<uint8_t> m_morph_middle{1}; // Shared set index | MORPH_DIRTY
+  uint8_t m_morph_back = 2;               // UI-owned set
+  uint8_t m_morph_front = 0;              // Audio-owned set
+  std::atomic<bool> m_morph_active{false};
+  static constexpr uint8_t MORPH_DIRTY = 0x4;
+
+  // Crossfade state (audio thread only)
+  std::vector<float> m_morph_from_sends;  // [channel * num_groups + group]
+  std::vector<float> m_morph_from_groups; // [group]
+  std::vector<uint8_t> m_morph_channel_groups; // [channel] assignment at crossfade start
+  float m_morph_from_master = 1.0f;
+  uint32_t m_morph_position = 0;
+
   // Solo state
   std::atomic<bool> m_solo_active;
 
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+#include "routing_worker_pool.h"
+
+#include <orpheus/performance_monitor.h>
+
+#include <algorithm>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace orpheus {
+
+namespace {
+
+/// Spin-wait hint (no syscall, unlike std::this_thread::yield())
+inline void cpuRelax() {
+#if defined(_MSC_VER)
+  _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+RoutingWorkerPool::RoutingWorkerPool(size_t num_workers,
+                                     std::optional<RealtimeThreadConfig> realtime,
+                                     IPerformanceMonitor* monitor)
+    : m_realtime(realtime), m_monitor(monitor) {
+  if (num_workers == 0) {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    num_workers = hardware > 1 ? hardware - 1 : 0;
+  }
+
+  m_workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    m_workers.emplace_back(&RoutingWorkerPool::workerMain, this, i);
+  }
+
+  // The audio thread must not find a worker still being set up
+  for (size_t ready = m_ready.load(); ready < num_workers; ready = m_ready.load()) {
+    m_ready.wait(ready);
+  }
+}
+
+RoutingWorkerPool::~RoutingWorkerPool() {
+  m_stop.store(true);
+  m_generation.fetch_add(2); // Stay even (closed) so no worker drains
+  m_generation.notify_all();
+
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+size_t RoutingWorkerPool::getWorkerCount() const {
+  return m_workers.size();
+}
+
+void RoutingWorkerPool::run(TaskFunction function, void* context, size_t num_tasks) {
+  if (num_tasks == 0) {
+    return;
+  }
+
+  if (m_workers.empty() || num_tasks == 1) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      function(context, i);
+    }
+    return;
+  }
+
+  m_function = function;
+  m_context = context;
+  for (size_t base = 0; base < num_tasks; base += MAX_BATCH_TASKS) {
+    runBatch(base, std::min(MAX_BATCH_TASKS, num_tasks - base));
+  }
+}
+
+void RoutingWorkerPool::runBatch(size_t base, size_t num_tasks) {
+  // Publish the job and open it (odd generation)
+  m_task_base = base;
+  m_num_tasks = num_tasks;
+  for (size_t task = 0; task < num_tasks; ++task) {
+    m_started[task].store(0);
+  }
+  m_remaining.store(num_tasks);
+  m_next_task.store(0);
+  m_generation.fetch_add(1);
+  m_generation.notify_all();
+
+  // The calling (audio) thread works too, then gives workers a bounded spin
+  drain();
+  for (uint32_t spin = 0; spin < SPIN_LIMIT && m_remaining.load() != 0; ++spin) {
+    cpuRelax();
+  }
+
+  // Run inline whatever a slow or preempted worker claimed but has not started
+  if (m_remaining.load() != 0) {
+    for (size_t task = 0; task < num_tasks; ++task) {
+      runTask(task);
+    }
+  }
+  while (m_remaining.load() != 0) {
+    cpuRelax(); // Only tasks already executing on a worker are left
+  }
+
+  // Close the job (even generation) and wait for late workers to back out
+  m_generation.fetch_add(1);
+  while (m_busy.load() != 0) {
+    cpuRelax();
+  }
+}
+
+void RoutingWorkerPool::workerMain(size_t index) {
+  if (m_realtime) {
+    RealtimeThreadConfig config = *m_realtime;
+    if (config.cpu >= 0) {
+      config.cpu += static_cast<int>(index);
+    }
+    auto report = configureRealtimeThread(config);
+    report.name += "-" + std::to_string(index);
+    if (m_monitor) {
+      m_monitor->reportRealtimeThread(report);
+    }
+  }
+  m_ready.fetch_add(1);
+  m_ready.notify_all();
+
+  uint64_t seen = m_generation.load();
+
+  while (true) {
+    m_generation.wait(seen);
+    if (m_stop.load()) {
+      break;
+    }
+
+    uint64_t generation = m_generation.load();
+    seen = generation;
+    if ((generation & 1) == 0) {
+      continue; // Woke for a closed job
+    }
+
+    m_busy.fetch_add(1);
+    if (m_generation.load() == generation) {
+      drain();
+    }
+    m_busy.fetch_sub(1);
+  }
+}
+
+void RoutingWorkerPool::drain() {
+  while (true) {
+    size_t task = m_next_task.fetch_add(1);
+    if (task >= m_num_tasks) {
+      break;
+    }
+    runTask(task);
+  }
+}
+
+void RoutingWorkerPool::runTask(size_t task) {
+  // Whoever takes the flag first runs the task (a worker, or run() taking it back)
+  if (m_started[task].exchange(1) == 0) {
+    m_function(m_context, m_task_base + task);
+    m_remaining.fetch_sub(1);
+  }
+}
+
+// ============================================================================
+// Factory Function
+// ============================================================================
+
+std::unique_ptr<IRoutingWorkerPool> createRoutingWorkerPool(size_t num_workers) {
+  return std::make_unique<RoutingWorkerPool>(num_workers);
+}
+
+std::unique_ptr<IRoutingWorkerPool> createRoutingWorkerPool(size_t num_workers,
+                                                            const RealtimeThreadConfig& realtime,
+                                                            IPerformanceMonitor* monitor) {
+  return std::make_unique<RoutingWorkerPool>(num_workers, realtime, monitor);
+}
+
+} // namespace orpheus
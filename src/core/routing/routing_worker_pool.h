@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <orpheus/routing_graph.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace orpheus {
+
+/// Pre-spawned worker pool for parallel routing graph levels
+///
+/// Architecture:
+/// - Workers sleep on an atomic generation counter (futex wait, no mutex)
+/// - run() publishes a job, wakes the workers and joins in itself
+/// - Tasks are claimed with an atomic fetch_add, so uneven work balances out
+/// - The audio thread never yields: after a bounded spin it runs every task no
+///   worker has started itself, then spins only on tasks already executing
+///
+/// Generations are odd while a job is open and even once it is closed. A
+/// worker registers as busy before re-checking that the generation it woke
+/// for is still open, and run() waits for busy workers after closing the job,
+/// so the job fields are never rewritten while a late worker reads them.
+///
+/// With a real-time configuration, each worker calls configureRealtimeThread()
+/// before it first waits for work (worker i pinned to `cpu + i` when a CPU is
+/// given) and the constructor returns once every worker is set up.
+class RoutingWorkerPool : public IRoutingWorkerPool {
+public:
+  /// Tasks per published job (larger runs are split into batches)
+  static constexpr size_t MAX_BATCH_TASKS = 256;
+
+  /// Spins run() waits for workers before taking unstarted tasks back
+  static constexpr uint32_t SPIN_LIMIT = 2048;
+
+  /// Construct worker pool
+  /// @param num_workers Number of worker threads (0 = hardware concurrency - 1)
+  /// @param realtime Worker thread setup (nullopt = leave the threads as spawned)
+  /// @param monitor Receives each worker's RealtimeThreadReport (may be nullptr)
+  explicit RoutingWorkerPool(size_t num_workers,
+                             std::optional<RealtimeThreadConfig> realtime = std::nullopt,
+                             IPerformanceMonitor* monitor = nullptr);
+  ~RoutingWorkerPool() override;
+
+  size_t getWorkerCount() const override;
+  void run(TaskFunction function, void* context, size_t num_tasks) override;
+
+private:
+  void workerMain(size_t index);
+  void runBatch(size_t base, size_t num_tasks);
+  void drain();
+  void runTask(size_t task);
+
+  std::vector<std::thread> m_workers;
+
+  // Worker setup (read by workers before they signal m_ready)
+  std::optional<RealtimeThreadConfig> m_realtime;
+  IPerformanceMonitor* m_monitor{nullptr};
+  std::atomic<size_t> m_ready{0};
+
+  // Current job (written by run() while no worker is busy)
+  TaskFunction m_function{nullptr};
+  void* m_context{nullptr};
+  size_t m_task_base{0};
+  size_t m_num_tasks{0};
+
+  std::array<std::atomic<uint8_t>, MAX_BATCH_TASKS> m_started{}; ///< Per task: taken to run
+  std::atomic<size_t> m_next_task{0};
+  std::atomic<size_t> m_remaining{0};
+  std::atomic<uint64_t> m_generation{0};
+  std::atomic<uint32_t> m_busy{0};
+  std::atomic<bool> m_stop{false};
+};
+
+} // namespace orpheus
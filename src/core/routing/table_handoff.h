@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace orpheus {
+
+/// Lock-free handoff of immutable tables from a publishing thread to the audio thread
+///
+/// The publisher builds a table off the audio thread and publish()es it; the
+/// audio thread picks the newest one up with acquire() and runs it until the
+/// next. A table published before the audio thread took the previous one
+/// replaces it. Tables the audio thread replaces are parked in two retire
+/// slots and freed by the publisher, never on the audio thread.
+///
+/// publish() empties both slots before it installs a table, and the audio
+/// thread retires at most one table per pending one, so at most two are parked
+/// between publishes: acquire() always finds a free slot and adopts every
+/// published table on its next call, however the threads interleave.
+///
+/// Thread Safety: publish(), reclaim() and hasPending() from one publisher at a
+/// time (e.g. under the owner's mutex); acquire() and active() from the audio
+/// thread only (lock-free, allocation-free).
+template <typename Table> class TableHandoff {
+public:
+  /// @param initial Table the audio thread starts with (may be nullptr)
+  explicit TableHandoff(Table* initial = nullptr) : m_active(initial) {}
+
+  ~TableHandoff() {
+    reclaim();
+    delete m_pending.exchange(nullptr, std::memory_order_acq_rel);
+    delete m_active;
+  }
+
+  TableHandoff(const TableHandoff&) = delete;
+  TableHandoff& operator=(const TableHandoff&) = delete;
+
+  /// Hand a table to the audio thread (freeing tables it has retired)
+  void publish(std::unique_ptr<Table> table) {
+    reclaim();
+    delete m_pending.exchange(table.release(), std::memory_order_acq_rel);
+  }
+
+  /// Free the tables the audio thread has retired
+  void reclaim() {
+    for (auto& slot : m_retired) {
+      delete slot.exchange(nullptr, std::memory_order_acq_rel);
+    }
+  }
+
+  /// Whether the last published table has not been adopted yet
+  bool hasPending() const {
+    return m_pending.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /// Adopt the newest published table (audio thread)
+  /// @return Current table, stable until the next call
+  Table* acquire() {
+    if (m_pending.load(std::memory_order_acquire) == nullptr) {
+      return m_active;
+    }
+    for (auto& slot : m_retired) {
+      if (slot.load(std::memory_order_acquire) == nullptr) {
+        Table* next = m_pending.exchange(nullptr, std::memory_order_acq_rel);
+        if (next) {
+          slot.store(m_active, std::memory_order_release);
+          m_active = next;
+        }
+        break;
+      }
+    }
+    return m_active;
+  }
+
+  /// Table the audio thread runs (audio thread)
+  Table* active() const {
+    return m_active;
+  }
+
+private:
+  std::atomic<Table*> m_pending{nullptr};
+  std::array<std::atomic<Table*>, 2> m_retired{};
+  Table* m_active; ///< Audio thread only
+};
+
+} // namespace orpheus
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: MIT
 #include "transport_controller.h"
 
+#include "audio_io/loudness_meter.h"
 #include "session/session_graph.h" // For SessionGraph
+#include <orpheus/realtime_thread.h>
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstring>
+#include <thread>
 
 // MSVC and some platforms don't define M_PI_2 by default
 #ifndef M_PI_2
@@ -37,10 +41,17 @@ TransportController::TransportController(core::SessionGraph* sessionGraph, uint3
   routingConfig.enable_metering = true;
   routingConfig.enable_clipping_protection =
       true; // OCC109 v0.2.2: ENABLED to fix "Stop All" distortion with 32 simultaneous fade-outs
-            // Soft-knee tanh limiter prevents audible clipping without quality loss
+            // Look-ahead limiter prevents audible clipping without waveshaping
+  routingConfig.sample_rate = sampleRate;
+  // Voice groups follow clip routing (setVoiceGroup); scenes recall levels only
+  routingConfig.snapshot_channel_groups = false;
 
   m_routingMatrix->initialize(routingConfig);
 
+  // Clip routing: group assignments select the routing matrix group for each voice
+  m_clipRouting = std::make_unique<ClipRoutingMatrix>(sessionGraph, sampleRate);
+  m_routeTable = m_clipRouting->acquireTable();
+
   // Pre-allocate per-clip read buffers (interleaved audio from files)
   m_clipReadBuffers.resize(MAX_ACTIVE_CLIPS);
   for (auto& buffer : m_clipReadBuffers) {
@@ -59,11 +70,28 @@ TransportController::TransportController(core::SessionGraph* sessionGraph, uint3
     m_clipChannelPointers[i] = m_clipChannelBuffers[i].data();
   }
 
+  // Fault the audio buffers in before the first trigger
+  prefaultAudioBuffers();
+
   // TODO: m_sessionGraph will be used for querying clip metadata (trim points, routing, etc.)
   (void)m_sessionGraph; // Suppress unused warning for now
 }
 
-TransportController::~TransportController() = default;
+TransportController::~TransportController() {
+  // Jobs call back into this controller: stop them before members are destroyed
+  std::vector<AnalysisScheduler::JobId> jobs;
+  {
+    std::lock_guard<std::mutex> lock(m_audioFilesMutex);
+    for (const auto& [source, analysis] : m_loudness) {
+      jobs.push_back(analysis.job);
+    }
+  }
+  auto& scheduler = sharedAnalysisScheduler();
+  for (auto job : jobs) {
+    scheduler.cancel(job);
+    scheduler.wait(job);
+  }
+}
 
 SessionGraphError TransportController::startClip(ClipHandle handle) {
   // Validate handle
@@ -128,7 +156,7 @@ SessionGraphError TransportController::stopAllClips() {
 
 SessionGraphError TransportController::stopAllInGroup(uint8_t groupIndex) {
   // Validate group index (0-3 for 4 Clip Groups)
-  if (groupIndex >= 4) {
+  if (groupIndex >= NUM_CLIP_GROUPS) {
     return SessionGraphError::InvalidParameter;
   }
 
@@ -197,6 +225,9 @@ void TransportController::setCallback(ITransportCallback* callback) {
 
 void TransportController::processAudio(float** outputBuffers, size_t numChannels,
                                        size_t numFrames) {
+  // Pick up clip routing changes before new voices resolve their routes
+  refreshVoiceRoutes();
+
   // Process pending commands from UI thread
   processCommands();
 
@@ -206,10 +237,8 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
   // Clamp frames to max buffer size
   numFrames = std::min(numFrames, MAX_BUFFER_FRAMES);
 
-  // Clear all clip channel buffers
-  for (size_t i = 0; i < MAX_ACTIVE_CLIPS; ++i) {
-    std::memset(m_clipChannelBuffers[i].data(), 0, numFrames * sizeof(float));
-  }
+  // Only voices that render pass a buffer to routing; silent voices and free slots pass none
+  std::fill(m_clipChannelPointers.begin(), m_clipChannelPointers.end(), nullptr);
 
   // PRE-RENDER: Calculate fade-out gains for all stopping clips BEFORE rendering
   // CRITICAL FIX: Must calculate BEFORE clip.currentSample advances to prevent timing offset
@@ -240,7 +269,7 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
     ActiveClip& clip = m_activeClips[i];
 
     // Skip if no audio file registered
-    if (!clip.reader || !clip.reader->isOpen()) {
+    if (!clip.cursor.isOpen()) {
       continue;
     }
 
@@ -258,18 +287,14 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
     if (clip.currentSample < trimIn) {
       // Position below IN point - clamp to IN (enforce Edit Law #1)
       clip.currentSample = trimIn;
-      if (clip.reader) {
-        clip.reader->seek(trimIn);
-      }
+      clip.cursor.seek(trimIn);
     } else if (clip.currentSample >= trimOut) {
       // Position at or past OUT point - handle loop or stop
       bool shouldLoop = clip.loopEnabled.load(std::memory_order_acquire);
       if (shouldLoop) {
         // Loop mode: restart from IN point
         clip.currentSample = trimIn;
-        if (clip.reader) {
-          clip.reader->seek(trimIn);
-        }
+        clip.cursor.seek(trimIn);
 
         // ORP097 Bug 7 Fix: Mark that clip has looped
         clip.hasLoopedOnce = true;
@@ -294,9 +319,26 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
     size_t framesToRead =
         static_cast<size_t>(std::min(static_cast<int64_t>(numFrames), framesUntilEnd));
 
-    // Note: We don't seek on every callback - the reader maintains its position
+    // Note: We don't seek on every callback - the cursor maintains its position
     // The initial seek to trimInSamples happens in addActiveClip()
 
+    // Entirely in silent blocks: skip the copy, gain and routing, but advance the
+    // position and restart crossfade exactly as rendering would (fades are positional)
+    int64_t readPosition = clip.cursor.position();
+    if (clip.cursor.source()->silence().isSilent(readPosition,
+                                                 static_cast<int64_t>(framesToRead))) {
+      clip.cursor.seek(readPosition + static_cast<int64_t>(framesToRead));
+      if (clip.isRestarting && clip.restartFadeFramesRemaining > 0) {
+        clip.restartFadeFramesRemaining -=
+            std::min(clip.restartFadeFramesRemaining, static_cast<int64_t>(framesToRead));
+        if (clip.restartFadeFramesRemaining == 0) {
+          clip.isRestarting = false; // Crossfade complete
+        }
+      }
+      clip.currentSample += static_cast<int64_t>(framesToRead);
+      continue;
+    }
+
     // Read audio from file
     size_t numFileChannels = clip.numChannels;
 
@@ -311,18 +353,14 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
       continue;
     }
 
-    // Read samples from audio file into THIS clip's buffer
-    // Use captured shared_ptr reader (thread-safe, no map lookup needed)
-    auto readResult = clip.reader->readSamples(clipReadBuffer, framesToRead);
-
-    if (!readResult.isOk()) {
-      continue;
-    }
-
-    size_t framesRead = readResult.value;
+    // Copy decoded samples into THIS clip's buffer
+    // Each voice owns its cursor, so layered voices of one clip never disturb each other
+    size_t framesRead = clip.cursor.read(clipReadBuffer, framesToRead);
 
     // Output to this clip's channel buffer (mono sum for routing)
     float* clipChannelBuffer = m_clipChannelBuffers[i].data();
+    std::memset(clipChannelBuffer, 0, numFrames * sizeof(float));
+    m_clipChannelPointers[i] = clipChannelBuffer;
 
     // Load precomputed linear gain (atomic read, no pow() call in audio thread!)
     float clipGainLinear = clip.gainLinear.load(std::memory_order_acquire);
@@ -399,7 +437,7 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
   // This ensures fade-outs complete properly even when no audio is being rendered
   for (size_t i = 0; i < m_activeClipCount; ++i) {
     ActiveClip& clip = m_activeClips[i];
-    if (!clip.reader || !clip.reader->isOpen()) {
+    if (!clip.cursor.isOpen()) {
       // Clip has no reader - advance position by buffer size so fades can complete
       clip.currentSample += static_cast<int64_t>(numFrames);
     }
@@ -447,9 +485,7 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
       if (shouldLoop) {
         // Loop: seek back to trim IN point (works even without reader)
         int64_t trimIn = clip.trimInSamples.load(std::memory_order_acquire);
-        if (clip.reader) {
-          clip.reader->seek(trimIn);
-        }
+        clip.cursor.seek(trimIn);
         clip.currentSample = trimIn;
 
         // ORP097 Bug 7 Fix: Mark that clip has looped (prevents fade-in/out on subsequent loops)
@@ -464,7 +500,7 @@ void TransportController::processAudio(float** outputBuffers, size_t numChannels
 
         // Continue playback (don't remove clip, don't increment i)
         ++i;
-      } else if (clip.reader) {
+      } else if (clip.cursor.isOpen()) {
         // Non-loop mode WITH reader: Trigger stop fade-out when reaching OUT point
         // This ensures graceful fade when loop is disabled mid-playback
         if (!clip.isStopping) {
@@ -529,10 +565,19 @@ void TransportController::processCommands() {
       }
       break;
 
-    case TransportCommand::Type::StopGroup:
-      // TODO: Get clip group assignments from SessionGraph
-      // For now, this is a no-op
-      break;
+    case TransportCommand::Type::StopGroup: {
+      // Walk only the voices in this group (one bit per active voice)
+      uint32_t mask = m_groupVoiceMasks[cmd.groupIndex];
+      while (mask != 0) {
+        size_t i = static_cast<size_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+        if (!m_activeClips[i].isStopping) {
+          m_activeClips[i].isStopping = true;
+          m_activeClips[i].fadeOutGain = 1.0f;
+          m_activeClips[i].fadeOutStartPos = m_activeClips[i].currentSample;
+        }
+      }
+    } break;
     }
 
     readIndex = (readIndex + 1) % MAX_COMMANDS;
@@ -606,7 +651,7 @@ void TransportController::addActiveClip(ClipHandle handle) {
   // Look up audio file reader and metadata for this clip
   // NOTE: Brief mutex lock in audio thread - only happens when starting clip, not during playback
   // TODO: Optimize to lock-free structure for production
-  std::shared_ptr<IAudioFileReader> reader; // Capture shared_ptr (thread-safe refcount increment)
+  std::shared_ptr<const SampleSource> source; // Shared decoded audio (refcount increment only)
   uint16_t numChannels = 2;                 // Default stereo
   int64_t totalFrames = 48000 * 10;         // Default 10 seconds
 
@@ -618,6 +663,7 @@ void TransportController::addActiveClip(ClipHandle handle) {
   FadeCurve fadeInCurve = FadeCurve::Linear;
   FadeCurve fadeOutCurve = FadeCurve::Linear;
   float gainDb = 0.0f;
+  float gainLinear = 1.0f;
   bool loopEnabled = false;
   bool stopOthersOnPlay = false;
 
@@ -625,7 +671,7 @@ void TransportController::addActiveClip(ClipHandle handle) {
     std::lock_guard<std::mutex> lock(m_audioFilesMutex);
     auto it = m_audioFiles.find(handle);
     if (it != m_audioFiles.end()) {
-      reader = it->second.reader; // Capture shared_ptr (atomic refcount increment)
+      source = it->second.source; // Capture shared_ptr (atomic refcount increment)
       numChannels = it->second.metadata.num_channels;
       totalFrames = it->second.metadata.duration_samples;
 
@@ -637,6 +683,7 @@ void TransportController::addActiveClip(ClipHandle handle) {
       fadeInCurve = it->second.fadeInCurve;
       fadeOutCurve = it->second.fadeOutCurve;
       gainDb = it->second.gainDb;
+      gainLinear = it->second.gainLinear;
       loopEnabled = it->second.loopEnabled;
       stopOthersOnPlay = it->second.stopOthersOnPlay;
 
@@ -665,7 +712,7 @@ void TransportController::addActiveClip(ClipHandle handle) {
     }
   }
 
-  // If no audio file registered, we'll play silence (reader will be nullptr)
+  // If no audio file registered, we'll play silence (source will be nullptr)
 
   // Initialize clip with persistent metadata from storage
   ActiveClip& clip = m_activeClips[m_activeClipCount++];
@@ -694,16 +741,14 @@ void TransportController::addActiveClip(ClipHandle handle) {
   clip.fadeOutSamples.store(fadeOutSampleCount, std::memory_order_release);
 
   // Initialize gain from persistent storage
+  // Linear gain (including loudness normalisation) was precomputed off the audio thread
   clip.gainDb.store(gainDb, std::memory_order_release);
-
-  // Precompute and cache linear gain (avoid pow() in audio thread)
-  float gainLinear = std::pow(10.0f, gainDb / 20.0f);
   clip.gainLinear.store(gainLinear, std::memory_order_release);
 
   // Initialize loop mode from persistent storage
   clip.loopEnabled.store(loopEnabled, std::memory_order_release);
 
-  clip.reader = reader; // Store shared_ptr (maintains reference count)
+  clip.cursor = SampleCursor(std::move(source)); // New voice gets its own read position
   clip.numChannels = numChannels;
   clip.fadeOutGain = 1.0f;
   clip.isStopping = false;
@@ -716,11 +761,12 @@ void TransportController::addActiveClip(ClipHandle handle) {
   // ORP097 Bug 7 Fix: Initialize loop state (start with false - first playthrough gets fades)
   clip.hasLoopedOnce = false;
 
+  // Resolve routing once; the voice keeps its slot until the table changes
+  clip.routeSlot = m_routeTable->findSlot(handle);
+  setVoiceGroup(m_activeClipCount - 1, m_routeTable->route(clip.routeSlot).group);
+
   // Seek to trim IN point once when starting (ALWAYS seek, even if trim is 0!)
-  if (reader) {
-    int64_t trimIn = clip.trimInSamples.load(std::memory_order_acquire);
-    reader->seek(trimIn);
-  }
+  clip.cursor.seek(clip.trimInSamples.load(std::memory_order_acquire));
 }
 
 void TransportController::removeActiveVoice(uint32_t voiceId) {
@@ -753,6 +799,8 @@ void TransportController::removeActiveVoice(uint32_t voiceId) {
         dest.fadeOutSamples.store(src.fadeOutSamples.load(std::memory_order_relaxed),
                                   std::memory_order_relaxed);
         dest.gainDb.store(src.gainDb.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dest.gainLinear.store(src.gainLinear.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
         dest.loopEnabled.store(src.loopEnabled.load(std::memory_order_relaxed),
                                std::memory_order_relaxed);
         dest.fadeOutGain = src.fadeOutGain;
@@ -761,9 +809,13 @@ void TransportController::removeActiveVoice(uint32_t voiceId) {
         dest.isRestarting = src.isRestarting;
         dest.restartFadeFramesRemaining = src.restartFadeFramesRemaining;
         dest.hasLoopedOnce = src.hasLoopedOnce;
-        dest.reader = src.reader;
+        dest.cursor = std::move(src.cursor);
         dest.numChannels = src.numChannels;
+        dest.routeSlot = src.routeSlot;
+        setVoiceGroup(i, src.routeGroup);
       }
+      m_activeClips[m_activeClipCount - 1].cursor.close(); // Releases its stream, if any
+      setVoiceGroup(m_activeClipCount - 1, ClipRoute::NO_GROUP);
       --m_activeClipCount;
       return;
     }
@@ -801,6 +853,8 @@ void TransportController::removeActiveClip(ClipHandle handle) {
         dest.fadeOutSamples.store(src.fadeOutSamples.load(std::memory_order_relaxed),
                                   std::memory_order_relaxed);
         dest.gainDb.store(src.gainDb.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dest.gainLinear.store(src.gainLinear.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
         dest.loopEnabled.store(src.loopEnabled.load(std::memory_order_relaxed),
                                std::memory_order_relaxed);
         dest.fadeOutGain = src.fadeOutGain;
@@ -809,27 +863,97 @@ void TransportController::removeActiveClip(ClipHandle handle) {
         dest.isRestarting = src.isRestarting;
         dest.restartFadeFramesRemaining = src.restartFadeFramesRemaining;
         dest.hasLoopedOnce = src.hasLoopedOnce; // ORP097 Bug 7 Fix
-        dest.reader = src.reader;               // Copy shared_ptr (atomic refcount increment)
+        dest.cursor = std::move(src.cursor);    // Hands over the source and any stream
         dest.numChannels = src.numChannels;
+        dest.routeSlot = src.routeSlot;
+        setVoiceGroup(i, src.routeGroup);
       }
+      m_activeClips[m_activeClipCount - 1].cursor.close(); // Releases its stream, if any
+      setVoiceGroup(m_activeClipCount - 1, ClipRoute::NO_GROUP);
       --m_activeClipCount;
       return;
     }
   }
 }
 
+void TransportController::refreshVoiceRoutes() {
+  const ClipRoutingTable* table = m_clipRouting->acquireTable();
+  if (table == m_routeTable) {
+    return;
+  }
+
+  // Slots are allocated, freed and reused between tables, so resolve every voice again
+  m_routeTable = table;
+  for (size_t i = 0; i < m_activeClipCount; ++i) {
+    ActiveClip& clip = m_activeClips[i];
+    clip.routeSlot = table->findSlot(clip.handle);
+    setVoiceGroup(i, table->route(clip.routeSlot).group);
+  }
+}
+
+void TransportController::setVoiceGroup(size_t index, uint8_t group) {
+  uint32_t bit = 1u << index;
+  for (auto& mask : m_groupVoiceMasks) {
+    mask &= ~bit;
+  }
+  if (group < NUM_CLIP_GROUPS) {
+    m_groupVoiceMasks[group] |= bit;
+  }
+  m_activeClips[index].routeGroup = group;
+
+  // Unassigned clips mix through group 0 (previous behaviour)
+  uint8_t mixGroup = group < NUM_CLIP_GROUPS ? group : 0;
+  if (m_channelGroups[index] != mixGroup) {
+    m_channelGroups[index] = mixGroup;
+    m_routingMatrix->setChannelGroup(static_cast<uint8_t>(index), mixGroup);
+  }
+}
+
+IClipRoutingMatrix* TransportController::getClipRouting() {
+  return m_clipRouting.get();
+}
+
 void TransportController::postCallback(std::function<void()> callback) {
   std::lock_guard<std::mutex> lock(m_callbackMutex);
   m_callbackQueue.push(std::move(callback));
 }
 
+void TransportController::reportBufferUnderrun() {
+  postCallback([this, pos = getCurrentPosition()]() {
+    if (m_callback) {
+      m_callback->onBufferUnderrun(pos);
+    }
+  });
+}
+
+void TransportController::prefaultAudioBuffers() {
+  for (auto& buffer : m_clipReadBuffers) {
+    prefaultMemory(buffer.data(), buffer.size() * sizeof(float));
+  }
+  for (auto& buffer : m_clipChannelBuffers) {
+    prefaultMemory(buffer.data(), buffer.size() * sizeof(float));
+  }
+  prefaultMemory(m_clipChannelPointers.data(), m_clipChannelPointers.size() * sizeof(float*));
+  prefaultMemory(m_activeClips.data(), sizeof(m_activeClips));
+  prefaultMemory(m_commands.data(), sizeof(m_commands));
+}
+
+uint32_t TransportController::getProcessingLatencySamples() const {
+  return m_routingMatrix ? m_routingMatrix->getLatencySamples() : 0;
+}
+
 void TransportController::processCallbacks() {
-  std::lock_guard<std::mutex> lock(m_callbackMutex);
-  while (!m_callbackQueue.empty()) {
-    auto callback = std::move(m_callbackQueue.front());
-    m_callbackQueue.pop();
-    callback();
+  {
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    while (!m_callbackQueue.empty()) {
+      auto callback = std::move(m_callbackQueue.front());
+      m_callbackQueue.pop();
+      callback();
+    }
   }
+
+  // Free audio no clip or voice plays any more here, not where a voice dropped it
+  m_sampleSources.collect();
 }
 
 SessionGraphError TransportController::registerClipAudio(ClipHandle handle,
@@ -842,26 +966,112 @@ SessionGraphError TransportController::registerClipAudio(ClipHandle handle,
     return SessionGraphError::InvalidParameter;
   }
 
+  // Decode (or reuse) the shared source BEFORE taking the lock the audio thread uses
+  // NotReady if no decoder is available (libsndfile not installed)
+  auto result = m_sampleSources.acquire(file_path);
+
+  if (!result.isOk()) {
+    return result.error;
+  }
+
   std::lock_guard<std::mutex> lock(m_audioFilesMutex);
+  m_audioFiles[handle] = makeAudioFileEntry(std::move(result.value));
+
+  return SessionGraphError::OK;
+}
+
+std::vector<ClipRegistrationResult> TransportController::registerClipsAudio(
+    std::span<const std::pair<ClipHandle, std::string>> clips,
+    const ClipRegistrationProgress& on_progress, const ClipRegistrationComplete& on_complete,
+    size_t max_threads) {
+  std::vector<ClipRegistrationResult> results(clips.size());
+  size_t total = clips.size();
+  size_t completed = 0;
+  std::mutex progressMutex;
+
+  auto finish = [&](size_t clipIndex, SessionGraphError error, const std::string& message) {
+    std::lock_guard<std::mutex> lock(progressMutex);
+    results[clipIndex].error = error;
+    results[clipIndex].errorMessage = message;
+    ++completed;
+    if (on_progress) {
+      on_progress(results[clipIndex], completed, total);
+    }
+  };
+
+  // Group clips by file so a file shared by many clips is opened once
+  std::vector<std::string> paths;
+  std::vector<std::vector<size_t>> pathClips;
+  std::unordered_map<std::string, size_t> pathIndex;
+  for (size_t i = 0; i < clips.size(); ++i) {
+    const auto& [handle, file_path] = clips[i];
+    results[i].handle = handle;
+    if (handle == 0) {
+      finish(i, SessionGraphError::InvalidHandle, "Invalid clip handle");
+    } else if (file_path.empty()) {
+      finish(i, SessionGraphError::InvalidParameter, "Empty file path");
+    } else {
+      auto [it, inserted] = pathIndex.try_emplace(file_path, paths.size());
+      if (inserted) {
+        paths.push_back(file_path);
+        pathClips.emplace_back();
+      }
+      pathClips[it->second].push_back(i);
+    }
+  }
 
-  // Create audio file reader (convert unique_ptr to shared_ptr for thread-safe lifetime)
-  auto uniqueReader = createAudioFileReader();
+  // Decode on loader threads; the caller loads too
+  std::vector<Result<std::shared_ptr<const SampleSource>>> sources(paths.size());
+  std::atomic<size_t> nextPath{0};
+  auto loader = [&] {
+    for (size_t p = nextPath.fetch_add(1); p < paths.size(); p = nextPath.fetch_add(1)) {
+      sources[p] = m_sampleSources.acquire(paths[p]);
+      for (size_t clipIndex : pathClips[p]) {
+        finish(clipIndex, sources[p].error, sources[p].errorMessage);
+      }
+    }
+  };
 
-  // Check if audio file reader is available (may be nullptr if libsndfile not installed)
-  if (!uniqueReader) {
-    return SessionGraphError::NotReady; // Audio file reading not available
+  size_t threads = max_threads > 0 ? max_threads : std::thread::hardware_concurrency();
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(paths.size(), 1));
+  std::vector<std::thread> helpers;
+  helpers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t) {
+    helpers.emplace_back(loader);
+  }
+  loader();
+  for (auto& helper : helpers) {
+    helper.join();
   }
 
-  auto result = uniqueReader->open(file_path);
+  // Publish every successful clip at once
+  {
+    std::lock_guard<std::mutex> lock(m_audioFilesMutex);
+    for (size_t p = 0; p < paths.size(); ++p) {
+      if (!sources[p].isOk()) {
+        continue;
+      }
+      for (size_t clipIndex : pathClips[p]) {
+        m_audioFiles[results[clipIndex].handle] = makeAudioFileEntry(sources[p].value);
+      }
+    }
+  }
 
-  if (!result.isOk()) {
-    return result.error;
+  // Every clip is playable from here on
+  if (on_complete) {
+    on_complete(results);
   }
 
-  // Store reader and metadata for this clip
+  return results;
+}
+
+TransportController::AudioFileEntry
+TransportController::makeAudioFileEntry(std::shared_ptr<const SampleSource> source) {
+  // Store shared source and metadata for this clip
   AudioFileEntry entry;
-  entry.reader = std::shared_ptr<IAudioFileReader>(std::move(uniqueReader));
-  entry.metadata = result.value;
+  entry.source = std::move(source);
+  entry.metadata = entry.source->metadata();
+  entry.loudness = analyseLoudness(entry.source);
 
   // Apply session defaults to new clip
   entry.fadeInSeconds = m_sessionDefaults.fadeInSeconds;
@@ -871,14 +1081,97 @@ SessionGraphError TransportController::registerClipAudio(ClipHandle handle,
   entry.loopEnabled = m_sessionDefaults.loopEnabled;
   entry.stopOthersOnPlay = m_sessionDefaults.stopOthersOnPlay;
   entry.gainDb = m_sessionDefaults.gainDb;
+  entry.loudnessTargetLufs = m_sessionDefaults.loudnessTargetLufs;
+  updateGainLinear(entry);
 
   // Trim points default to full file duration
   entry.trimInSamples = 0;
-  entry.trimOutSamples = result.value.duration_samples;
+  entry.trimOutSamples = entry.metadata.duration_samples;
+
+  return entry;
+}
 
-  m_audioFiles[handle] = std::move(entry);
+void TransportController::updateGainLinear(AudioFileEntry& entry) {
+  float gainDb = entry.gainDb;
+  if (entry.loudnessTargetLufs && entry.loudness && std::isfinite(entry.loudness->integratedLufs)) {
+    gainDb += static_cast<float>(*entry.loudnessTargetLufs - entry.loudness->integratedLufs);
+  }
+  entry.gainLinear = std::pow(10.0f, gainDb / 20.0f);
+}
 
-  return SessionGraphError::OK;
+std::optional<ClipLoudness>
+TransportController::analyseLoudness(const std::shared_ptr<const SampleSource>& source) {
+  // Forget sources no clip uses any more (their jobs have finished or been dropped)
+  auto& scheduler = sharedAnalysisScheduler();
+  std::erase_if(m_loudness, [&](const auto& item) {
+    return item.second.source.expired() && !scheduler.isPending(item.second.job);
+  });
+
+  auto [it, inserted] = m_loudness.try_emplace(source.get());
+  if (!inserted && it->second.source.lock() == source) {
+    return it->second.result; // Shared with an earlier clip
+  }
+  if (!inserted) {
+    // Same address as a freed source whose job is still queued (it would find nothing to do)
+    scheduler.cancel(it->second.job);
+    scheduler.wait(it->second.job);
+  }
+
+  // A resident source is measured in memory (CPU-bound); a streamed one is decoded
+  // from its file again, so its job counts against the disk-bound job limit
+  std::weak_ptr<const SampleSource> weak = source;
+  it->second = LoudnessAnalysis{weak, AnalysisScheduler::INVALID_JOB, std::nullopt};
+  it->second.job = scheduler.submit(
+      [this, weak](const std::atomic<bool>& cancelled) {
+        auto analysed = weak.lock();
+        if (!analysed) {
+          return; // Every clip using it was unregistered
+        }
+        if (auto loudness = measureLoudness(*analysed, cancelled)) {
+          applyLoudness(analysed.get(), *loudness);
+        }
+      },
+      AnalysisPriority::Normal, !source->isResident());
+  return std::nullopt;
+}
+
+void TransportController::applyLoudness(const SampleSource* source, const ClipLoudness& loudness) {
+  std::vector<ClipHandle> handles;
+  {
+    std::lock_guard<std::mutex> lock(m_audioFilesMutex);
+    auto it = m_loudness.find(source);
+    if (it != m_loudness.end()) {
+      it->second.result = loudness;
+    }
+    for (auto& [handle, entry] : m_audioFiles) {
+      if (entry.source.get() == source) {
+        entry.loudness = loudness;
+        updateGainLinear(entry);
+        handles.push_back(handle);
+      }
+    }
+  }
+
+  for (ClipHandle handle : handles) {
+    postCallback([this, handle, loudness]() {
+      if (m_callback) {
+        m_callback->onClipLoudnessAnalysed(handle, loudness);
+      }
+    });
+  }
+}
+
+void TransportController::waitForLoudnessAnalysis() {
+  std::vector<AnalysisScheduler::JobId> jobs;
+  {
+    std::lock_guard<std::mutex> lock(m_audioFilesMutex);
+    for (const auto& [source, analysis] : m_loudness) {
+      jobs.push_back(analysis.job);
+    }
+  }
+  for (auto job : jobs) {
+    sharedAnalysisScheduler().wait(job);
+  }
 }
 
 SessionGraphError TransportController::updateClipTrimPoints(ClipHandle handle,
@@ -1061,10 +1354,8 @@ SessionGraphError TransportController::updateClipGain(ClipHandle handle, float g
     return SessionGraphError::InvalidParameter;
   }
 
-  // Precompute linear gain (once, on UI thread)
-  float gainLinear = std::pow(10.0f, gainDb / 20.0f);
-
-  // Store gain persistently in AudioFileEntry
+  // Store gain persistently in AudioFileEntry, precomputing linear gain (once, on UI thread)
+  float gainLinear = 1.0f;
   {
     std::lock_guard<std::mutex> lock(m_audioFilesMutex);
     auto it = m_audioFiles.find(handle);
@@ -1072,6 +1363,8 @@ SessionGraphError TransportController::updateClipGain(ClipHandle handle, float g
       return SessionGraphError::ClipNotRegistered;
     }
     it->second.gainDb = gainDb;
+    updateGainLinear(it->second);
+    gainLinear = it->second.gainLinear;
   }
 
   // Update gain for any active clips with this handle (takes effect immediately)
@@ -1206,6 +1499,9 @@ SessionGraphError TransportController::updateClipMetadata(ClipHandle handle,
   if (!std::isfinite(metadata.gainDb)) {
     return SessionGraphError::InvalidParameter;
   }
+  if (metadata.loudnessTargetLufs && !std::isfinite(*metadata.loudnessTargetLufs)) {
+    return SessionGraphError::InvalidParameter;
+  }
 
   // All validation passed - apply changes atomically
   // Calculate fade sample counts
@@ -1215,6 +1511,7 @@ SessionGraphError TransportController::updateClipMetadata(ClipHandle handle,
       static_cast<int64_t>(metadata.fadeOutSeconds * static_cast<double>(m_sampleRate));
 
   // Update persistent storage
+  float gainLinear = 1.0f;
   {
     std::lock_guard<std::mutex> lock(m_audioFilesMutex);
     auto it = m_audioFiles.find(handle);
@@ -1228,6 +1525,9 @@ SessionGraphError TransportController::updateClipMetadata(ClipHandle handle,
       it->second.loopEnabled = metadata.loopEnabled;
       it->second.stopOthersOnPlay = metadata.stopOthersOnPlay;
       it->second.gainDb = metadata.gainDb;
+      it->second.loudnessTargetLufs = metadata.loudnessTargetLufs;
+      updateGainLinear(it->second);
+      gainLinear = it->second.gainLinear;
     }
   }
 
@@ -1244,6 +1544,7 @@ SessionGraphError TransportController::updateClipMetadata(ClipHandle handle,
       m_activeClips[i].fadeOutSamples.store(fadeOutSampleCount, std::memory_order_release);
       m_activeClips[i].loopEnabled.store(metadata.loopEnabled, std::memory_order_release);
       m_activeClips[i].gainDb.store(metadata.gainDb, std::memory_order_release);
+      m_activeClips[i].gainLinear.store(gainLinear, std::memory_order_release);
     }
   }
 
@@ -1272,6 +1573,8 @@ std::optional<ClipMetadata> TransportController::getClipMetadata(ClipHandle hand
   metadata.loopEnabled = it->second.loopEnabled;
   metadata.stopOthersOnPlay = it->second.stopOthersOnPlay;
   metadata.gainDb = it->second.gainDb;
+  metadata.loudnessTargetLufs = it->second.loudnessTargetLufs;
+  metadata.loudness = it->second.loudness;
 
   // If trim OUT is not set (0), use file duration
   if (metadata.trimOutSamples == 0) {
@@ -1350,10 +1653,8 @@ SessionGraphError TransportController::restartClip(ClipHandle handle) {
       trimIn = clip.trimInSamples.load(std::memory_order_acquire);
       clip.currentSample = trimIn;
 
-      // Reset reader to trim IN point (seek operation)
-      if (clip.reader) {
-        clip.reader->seek(trimIn);
-      }
+      // Reset cursor to trim IN point (seek operation)
+      clip.cursor.seek(trimIn);
 
       // Cancel any fade-out in progress
       clip.isStopping = false;
@@ -1418,10 +1719,8 @@ SessionGraphError TransportController::seekClip(ClipHandle handle, int64_t posit
       // Atomic position update (sample-accurate)
       clip.currentSample = clampedPosition;
 
-      // Seek reader to new position
-      if (clip.reader) {
-        clip.reader->seek(clampedPosition);
-      }
+      // Seek cursor to new position
+      clip.cursor.seek(clampedPosition);
     }
   }
 
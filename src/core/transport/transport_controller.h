@@ -1,16 +1,24 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "audio_io/analysis_scheduler.h"
+#include "audio_io/sample_source.h"
+#include "routing/clip_routing.h"
 #include <orpheus/audio_file_reader.h>
 #include <orpheus/routing_matrix.h>
 #include <orpheus/transport_controller.h>
 
 #include <array>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <span>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace orpheus {
 
@@ -28,6 +36,24 @@ struct TransportCommand {
   uint8_t groupIndex; // For StopGroup command
 };
 
+/// Outcome of one entry in a TransportController::registerClipsAudio() batch
+struct ClipRegistrationResult {
+  ClipHandle handle = 0;
+  SessionGraphError error = SessionGraphError::NotReady;
+  std::string errorMessage;
+};
+
+/// Batch progress: called once per entry as it finishes, serialised, from a loader thread
+/// @note The final call has completed == total, but the clips are not playable until
+///       ClipRegistrationComplete runs
+using ClipRegistrationProgress =
+    std::function<void(const ClipRegistrationResult& result, size_t completed, size_t total)>;
+
+/// Batch completion: called once, on the calling thread, after every successful clip is
+/// committed to the registry
+using ClipRegistrationComplete =
+    std::function<void(const std::vector<ClipRegistrationResult>& results)>;
+
 /// Active clip state (in audio thread)
 struct ActiveClip {
   ClipHandle handle;
@@ -71,18 +97,24 @@ struct ActiveClip {
 
   uint16_t numChannels; // Number of channels in audio file
 
-  // Thread-safe reader reference (captured from AudioFileEntry when clip starts)
-  // Using shared_ptr provides reference-counted lifetime management:
-  // - Audio thread holds reference until clip stops
-  // - Reader can't be destroyed while audio thread is still using it
-  // - Atomic refcount increment/decrement (lock-free, broadcast-safe)
-  std::shared_ptr<IAudioFileReader> reader;
+  // Clip routing (resolved once at voice start, re-resolved when the table changes)
+  uint32_t routeSlot; // Slot in ClipRoutingTable (INVALID_SLOT = default route)
+  uint8_t routeGroup; // Clip Group from the route (bit in m_groupVoiceMasks)
+
+  // Per-voice cursor into the clip's shared SampleSource (captured when clip starts)
+  // - Layered voices of the same clip read independently (no shared file position)
+  // - shared_ptr keeps the decoded audio alive until the voice stops
+  // - Reads are memcpy from memory or the cursor's read-ahead ring (no file I/O or
+  //   locks on the audio thread); moved, never copied, when voices are compacted
+  SampleCursor cursor;
 };
 
 /// Transport controller implementation
 class TransportController : public ITransportController {
 public:
   TransportController(core::SessionGraph* sessionGraph, uint32_t sampleRate);
+
+  /// Cancels (and waits for) this controller's loudness analysis jobs
   ~TransportController() override;
 
   // ITransportController interface
@@ -128,8 +160,26 @@ public:
   /// @param numFrames Number of frames to process
   void processAudio(float** outputBuffers, size_t numChannels, size_t numFrames);
 
+  /// Touch every page of the buffers processAudio() uses
+  ///
+  /// Done at construction. Call it again (UI thread, while the driver is
+  /// stopped) after a long idle period under memory pressure, so the next
+  /// trigger cannot page-fault; locking memory keeps the pages resident.
+  void prefaultAudioBuffers();
+
+  /// Report an audio dropout (audio thread, e.g. from IAudioCallback::onUnderrun())
+  ///
+  /// Queues ITransportCallback::onBufferUnderrun() with the current position,
+  /// delivered by the next processCallbacks().
+  void reportBufferUnderrun();
+
+  /// Output latency added by processAudio() (master limiter look-ahead)
+  /// @return Latency in samples, forward from IAudioCallback::getProcessingLatencySamples()
+  uint32_t getProcessingLatencySamples() const;
+
   /// Process callbacks on UI thread
   /// Must be called periodically from UI thread to dispatch transport events
+  /// (also frees decoded audio that no clip or voice uses any more)
   void processCallbacks();
 
   /// Register audio file for a clip (UI thread)
@@ -138,6 +188,40 @@ public:
   /// @return Error code
   SessionGraphError registerClipAudio(ClipHandle handle, const std::string& file_path);
 
+  /// Register many clips at once (show open)
+  ///
+  /// Each distinct file is opened and decoded once, on up to `max_threads` loader
+  /// threads, then every successful clip is committed to the registry under a single
+  /// lock. Show-open time therefore scales with cores rather than clip count.
+  /// @param clips (handle, file path) pairs; several handles may share a file
+  /// @param on_progress Optional per-entry progress callback
+  /// @param on_complete Optional callback with every result once the batch is committed
+  /// @param max_threads Loader threads including the caller (0 = hardware concurrency)
+  /// @return Per-entry results, in input order
+  /// @note Blocks until the batch is committed; call from a background/UI thread
+  std::vector<ClipRegistrationResult>
+  registerClipsAudio(std::span<const std::pair<ClipHandle, std::string>> clips,
+                     const ClipRegistrationProgress& on_progress = nullptr,
+                     const ClipRegistrationComplete& on_complete = nullptr,
+                     size_t max_threads = 0);
+
+  /// Clip routing used by the audio path (clip groups, output buses, channel maps)
+  /// @return Clip routing matrix owned by this transport (UI thread configures)
+  /// @note Group assignments drive the routing matrix groups and stopAllInGroup()
+  IClipRoutingMatrix* getClipRouting();
+
+  /// Decoded audio shared by registered clips
+  /// @note Attach a DecodedAudioCache here (before registering clips) to persist
+  ///       decoded compressed files across runs
+  SampleSourceCache& getSampleSources() {
+    return m_sampleSources;
+  }
+
+  /// Block until the loudness of every registered clip has been measured
+  /// @note Registration queues the analysis on the shared AnalysisScheduler; call from a
+  ///       background/UI thread (e.g. after registerClipsAudio() when opening a show)
+  void waitForLoudnessAnalysis();
+
 private:
   /// Process pending commands from UI thread
   void processCommands();
@@ -167,6 +251,12 @@ private:
   /// @note Deprecated: Use removeActiveVoice() for multi-voice
   void removeActiveClip(ClipHandle handle);
 
+  /// Pick up the latest clip routing table and re-route voices (audio thread only)
+  void refreshVoiceRoutes();
+
+  /// Move a voice into a Clip Group (group bitmasks + routing matrix channel)
+  void setVoiceGroup(size_t index, uint8_t group);
+
   /// Post callback to UI thread
   void postCallback(std::function<void()> callback);
 
@@ -215,7 +305,7 @@ private:
 
   // Audio file registry (UI thread access, mutex protected)
   struct AudioFileEntry {
-    std::shared_ptr<orpheus::IAudioFileReader> reader;
+    std::shared_ptr<const SampleSource> source; // Shared with other clips using the file
     AudioFileMetadata metadata;
 
     // Persistent clip metadata (stored with audio file registration)
@@ -229,15 +319,59 @@ private:
     bool loopEnabled = false;      // true = loop indefinitely
     bool stopOthersOnPlay = false; // true = stop all other clips when this one starts
 
+    // Loudness normalisation (folded into gainLinear, so playback costs nothing extra)
+    std::optional<float> loudnessTargetLufs; // nullopt = off
+    std::optional<ClipLoudness> loudness;    // nullopt until analysed
+    float gainLinear = 1.0f;                 // gainDb plus normalisation, as a linear factor
+
     // Cue points (stored sorted by position)
     std::vector<CuePoint> cuePoints;
   };
   std::mutex m_audioFilesMutex;
   std::unordered_map<ClipHandle, AudioFileEntry> m_audioFiles;
 
+  /// Registry entry for a decoded source with the session defaults applied
+  /// (and the loudness of the source, if already measured)
+  /// @note Caller holds m_audioFilesMutex (guards m_sessionDefaults)
+  AudioFileEntry makeAudioFileEntry(std::shared_ptr<const SampleSource> source);
+
+  /// Recompute an entry's gainLinear from its gain, target and loudness
+  static void updateGainLinear(AudioFileEntry& entry);
+
+  // Loudness analysis per distinct source (guarded by m_audioFilesMutex)
+  struct LoudnessAnalysis {
+    std::weak_ptr<const SampleSource> source;
+    AnalysisScheduler::JobId job = AnalysisScheduler::INVALID_JOB;
+    std::optional<ClipLoudness> result; // Set by the job
+  };
+  std::unordered_map<const SampleSource*, LoudnessAnalysis> m_loudness;
+
+  /// Queue a loudness measurement of a source unless one is queued, running or done
+  /// @return Measurement, if already done
+  /// @note Caller holds m_audioFilesMutex
+  std::optional<ClipLoudness> analyseLoudness(const std::shared_ptr<const SampleSource>& source);
+
+  /// Store a measurement in every clip using the source (analysis worker thread)
+  /// @note Voices already playing keep their gain until restarted (no level jump mid-cue)
+  void applyLoudness(const SampleSource* source, const ClipLoudness& loudness);
+
+  // Decoded audio shared by all clips registered with the same file (UI thread)
+  // Unused sources are freed by processCallbacks(), never by a voice on the audio thread
+  SampleSourceCache m_sampleSources;
+
   // Routing matrix for final mix (audio thread processes, UI thread configures)
   std::unique_ptr<IRoutingMatrix> m_routingMatrix;
 
+  // Clip routing (UI thread configures, audio thread reads published tables)
+  std::unique_ptr<ClipRoutingMatrix> m_clipRouting;
+  const ClipRoutingTable* m_routeTable{nullptr}; // Audio thread only
+
+  // Active voices per Clip Group, bit i = m_activeClips[i] (audio thread only)
+  static constexpr uint8_t NUM_CLIP_GROUPS = ClipRoutingMatrix::NUM_GROUPS;
+  std::array<uint32_t, NUM_CLIP_GROUPS> m_groupVoiceMasks{};
+  std::array<uint8_t, MAX_ACTIVE_CLIPS> m_channelGroups{}; // Routing matrix group per voice
+  static_assert(MAX_ACTIVE_CLIPS <= 32, "Group voice masks hold one bit per voice");
+
   // Per-clip buffers (audio thread only, pre-allocated)
   static constexpr size_t MAX_BUFFER_FRAMES = 2048;
   static constexpr size_t MAX_FILE_CHANNELS = 8;
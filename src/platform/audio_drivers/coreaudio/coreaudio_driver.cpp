@@ -100,6 +100,8 @@ SessionGraphError CoreAudioDriver::start(IAudioCallback* callback) {
   }
 
   callback_ = callback;
+  thread_configured_.store(false, std::memory_order_release);
+  lockProcessMemory();
 
   // Start AudioUnit
   OSStatus status = AudioOutputUnitStart(audio_unit_);
@@ -150,7 +152,8 @@ std::string CoreAudioDriver::getDriverName() const {
 }
 
 uint32_t CoreAudioDriver::getLatencySamples() const {
-  return latency_samples_.load(std::memory_order_acquire);
+  uint32_t processing_latency = callback_ ? callback_->getProcessingLatencySamples() : 0;
+  return latency_samples_.load(std::memory_order_acquire) + processing_latency;
 }
 
 void CoreAudioDriver::setPerformanceMonitor(IPerformanceMonitor* monitor) {
@@ -169,6 +172,16 @@ OSStatus CoreAudioDriver::renderCallback(void* inRefCon, AudioUnitRenderActionFl
   auto* driver = static_cast<CoreAudioDriver*>(inRefCon);
   assert(driver != nullptr);
 
+  if (!driver->thread_configured_.exchange(true, std::memory_order_acq_rel)) {
+    RealtimeThreadConfig realtime{
+        .name = "coreaudio", .policy = RealtimePolicy::None, .lockMemory = false};
+    auto report = configureRealtimeThread(realtime);
+    report.memoryLock = lockProcessMemory(); // Already locked (or refused) in start()
+    if (driver->performance_monitor_) {
+      driver->performance_monitor_->reportRealtimeThread(report);
+    }
+  }
+
   // Zero output buffers first
   for (UInt32 i = 0; i < ioData->mNumberBuffers; ++i) {
     std::memset(ioData->mBuffers[i].mData, 0, ioData->mBuffers[i].mDataByteSize);
@@ -200,18 +213,22 @@ OSStatus CoreAudioDriver::renderCallback(void* inRefCon, AudioUnitRenderActionFl
                                  : const_cast<const float**>(driver->input_buffers_.data());
   float** output_ptrs = driver->output_buffers_.data();
 
-  // Measure audio callback execution time
+  // Measure audio callback wall and thread CPU time against the buffer's duration
   auto callback_start = std::chrono::high_resolution_clock::now();
+  const int64_t cpu_before_ns = threadCpuTimeNs();
   driver->callback_->processAudio(input_ptrs, output_ptrs, num_channels, frames_to_process);
+  const int64_t callback_cpu_ns = threadCpuTimeNs() - cpu_before_ns;
   auto callback_end = std::chrono::high_resolution_clock::now();
 
+  auto duration_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(callback_end - callback_start);
+  const int64_t buffer_duration_ns = static_cast<int64_t>(
+      (static_cast<uint64_t>(frames_to_process) * 1'000'000'000) / driver->config_.sample_rate);
+
   // Report performance metrics if monitor is available
   if (driver->performance_monitor_) {
-    auto duration_us =
-        std::chrono::duration_cast<std::chrono::microseconds>(callback_end - callback_start);
-    uint64_t callback_duration_us = static_cast<uint64_t>(duration_us.count());
-    uint64_t buffer_duration_us =
-        (static_cast<uint64_t>(frames_to_process) * 1'000'000) / driver->config_.sample_rate;
+    uint64_t callback_duration_us = static_cast<uint64_t>(duration_ns.count()) / 1000;
+    uint64_t buffer_duration_us = static_cast<uint64_t>(buffer_duration_ns) / 1000;
 
     // TODO: Get active clip count from transport controller (for now, use 0)
     uint32_t active_clips = 0;
@@ -221,6 +238,15 @@ OSStatus CoreAudioDriver::renderCallback(void* inRefCon, AudioUnitRenderActionFl
                                                       frames_to_process);
   }
 
+  // A callback longer than its buffer delays the next I/O cycle past its deadline
+  if (duration_ns.count() > buffer_duration_ns) {
+    const UnderrunCause cause = classifyDeadlineMiss(callback_cpu_ns, buffer_duration_ns);
+    if (driver->performance_monitor_) {
+      driver->performance_monitor_->reportUnderrun(cause);
+    }
+    driver->callback_->onUnderrun(cause);
+  }
+
   // Copy planar output buffers to CoreAudio non-interleaved buffers
   for (uint32_t ch = 0; ch < num_channels && ch < ioData->mNumberBuffers; ++ch) {
     float* src = driver->output_buffers_[ch];
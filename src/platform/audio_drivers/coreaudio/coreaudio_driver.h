@@ -92,6 +92,10 @@ private:
   // Performance monitoring (optional)
   IPerformanceMonitor* performance_monitor_{nullptr};
 
+  // The HAL I/O thread is already time-constrained: only its denormal flags and
+  // stack are set up, on the first callback after start(); memory is locked in start()
+  std::atomic<bool> thread_configured_{false};
+
   // Audio thread buffers (allocated once in initialize)
   std::vector<float*> input_buffers_;
   std::vector<float*> output_buffers_;
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+#include <gtest/gtest.h>
+#include <orpheus/audio_driver.h>
+
+#include "audio_io/aggregate_audio_driver.h"
+#include "audio_io/dummy_audio_driver.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Dummy device whose output can be inspected after each callback
+class TappedDevice : public IAudioDriver {
+public:
+  explicit TappedDevice(const DummyDriverOptions& options = {}) : m_driver(options) {}
+
+  SessionGraphError initialize(const AudioDriverConfig& config) override {
+    return m_driver.initialize(config);
+  }
+  SessionGraphError start(IAudioCallback* callback) override {
+    m_tap.target = callback;
+    return m_driver.start(&m_tap);
+  }
+  SessionGraphError stop() override {
+    return m_driver.stop();
+  }
+  bool isRunning() const override {
+    return m_driver.isRunning();
+  }
+  const AudioDriverConfig& getConfig() const override {
+    return m_driver.getConfig();
+  }
+  std::string getDriverName() const override {
+    return "Tapped";
+  }
+  uint32_t getLatencySamples() const override {
+    return m_driver.getLatencySamples();
+  }
+  IAudioClock* getClock() override {
+    return m_driver.getClock();
+  }
+
+  /// Last sample played on a channel
+  float lastSample(size_t channel) const {
+    return m_tap.last[channel].load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Tap : public IAudioCallback {
+    void processAudio(const float** inputs, float** outputs, size_t num_channels,
+                      size_t num_frames) override {
+      target->processAudio(inputs, outputs, num_channels, num_frames);
+      for (size_t ch = 0; ch < std::min(num_channels, last.size()); ++ch) {
+        last[ch].store(outputs[ch][num_frames - 1], std::memory_order_relaxed);
+      }
+    }
+    uint32_t getProcessingLatencySamples() const override {
+      return target ? target->getProcessingLatencySamples() : 0;
+    }
+
+    IAudioCallback* target = nullptr;
+    std::array<std::atomic<float>, 4> last{};
+  };
+
+  DummyAudioDriver m_driver;
+  Tap m_tap;
+};
+
+/// Writes a constant per channel: 0.1 on channel 0, 0.2 on channel 1, ...
+class ChannelLevels : public IAudioCallback {
+public:
+  void processAudio(const float**, float** outputs, size_t num_channels,
+                    size_t num_frames) override {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t i = 0; i < num_frames; ++i) {
+        outputs[ch][i] = 0.1f * static_cast<float>(ch + 1);
+      }
+    }
+  }
+};
+
+/// ChannelLevels with processing latency (e.g. a limiter's look-ahead)
+class DelayedLevels : public ChannelLevels {
+public:
+  uint32_t getProcessingLatencySamples() const override {
+    return 64;
+  }
+};
+
+/// Devices with the given crystal errors (the first is the master)
+std::vector<std::unique_ptr<IAudioDriver>> devices(std::vector<double> ppm,
+                                                   std::vector<TappedDevice*>* taps = nullptr) {
+  std::vector<std::unique_ptr<IAudioDriver>> result;
+  for (double error : ppm) {
+    DummyDriverOptions options;
+    options.clockPpm = error;
+    auto device = std::make_unique<TappedDevice>(options);
+    if (taps) {
+      taps->push_back(device.get());
+    }
+    result.push_back(std::move(device));
+  }
+  return result;
+}
+
+AudioDriverConfig outputs(uint16_t channels) {
+  AudioDriverConfig config;
+  config.sample_rate = 48000;
+  config.buffer_size = 256;
+  config.num_outputs = channels;
+  return config;
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+TEST(AggregateDriverTest, InitializeValidatesLayout) {
+  AggregateAudioDriver empty({});
+  EXPECT_EQ(empty.initialize(outputs(2)), SessionGraphError::InvalidParameter);
+
+  AggregateAudioDriver aggregate(devices({0.0, 0.0}));
+  EXPECT_EQ(aggregate.getDriverName(), "Aggregate");
+  ChannelLevels callback;
+  EXPECT_EQ(aggregate.start(&callback), SessionGraphError::NotReady);
+  EXPECT_EQ(aggregate.initialize(outputs(2)), SessionGraphError::InvalidParameter); // Needs 4
+
+  auto config = outputs(4);
+  config.num_inputs = 2;
+  ASSERT_EQ(aggregate.initialize(config), SessionGraphError::OK);
+  EXPECT_EQ(aggregate.getConfig().num_outputs, 4u);
+  EXPECT_EQ(aggregate.getDevice(0)->getConfig().num_outputs, 2u);
+  EXPECT_EQ(aggregate.getDevice(0)->getConfig().num_inputs, 2u);
+  EXPECT_EQ(aggregate.getDevice(1)->getConfig().num_outputs, 2u);
+  EXPECT_EQ(aggregate.getDevice(1)->getConfig().num_inputs, 0u); // Inputs from the master only
+  EXPECT_EQ(aggregate.getDevice(2), nullptr);
+  EXPECT_EQ(aggregate.getClock(), aggregate.getDevice(0)->getClock());
+  EXPECT_EQ(aggregate.start(nullptr), SessionGraphError::InvalidParameter);
+}
+
+TEST(AggregateDriverTest, LatencyIncludesTheHeldFill) {
+  AggregateAudioDriver aggregate(devices({0.0, 0.0}));
+  ASSERT_EQ(aggregate.initialize(outputs(4)), SessionGraphError::OK);
+  EXPECT_EQ(aggregate.getLatencySamples(), 256u + 3 * 256u); // Slave buffer + default fill
+
+  AggregateDriverOptions options;
+  options.targetFillFrames = 1000;
+  AggregateAudioDriver custom(devices({0.0, 0.0}), options);
+  ASSERT_EQ(custom.initialize(outputs(4)), SessionGraphError::OK);
+  EXPECT_EQ(custom.getLatencySamples(), 256u + 1000u);
+  EXPECT_EQ(custom.getStats().at(0).targetFillFrames, 1000u);
+
+  DelayedLevels callback;
+  ASSERT_EQ(aggregate.start(&callback), SessionGraphError::OK);
+  EXPECT_EQ(aggregate.getLatencySamples(), 256u + 3 * 256u + 64u); // Plus the callback's
+  aggregate.stop();
+}
+
+// ============================================================================
+// Routing and drift compensation (real time)
+// ============================================================================
+
+TEST(AggregateDriverTest, RoutesChannelsToTheirDevices) {
+  std::vector<TappedDevice*> taps;
+  AggregateAudioDriver aggregate(devices({0.0, 0.0}, &taps));
+  ASSERT_EQ(aggregate.initialize(outputs(4)), SessionGraphError::OK);
+  ChannelLevels callback;
+  ASSERT_EQ(aggregate.start(&callback), SessionGraphError::OK);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  aggregate.stop();
+
+  EXPECT_FLOAT_EQ(taps[0]->lastSample(0), 0.1f); // Master: played directly
+  EXPECT_FLOAT_EQ(taps[0]->lastSample(1), 0.2f);
+  EXPECT_NEAR(taps[1]->lastSample(0), 0.3f, 1e-5); // Sub-device: through the resampler
+  EXPECT_NEAR(taps[1]->lastSample(1), 0.4f, 1e-5);
+  auto stats = aggregate.getStats();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_TRUE(stats[0].locked);
+}
+
+TEST(AggregateDriverTest, TracksDriftBetweenClocks) {
+  // One sub-device 400 ppm fast, one 300 ppm slow: uncompensated, the first
+  // would drain its ring by 19 frames a second and the other overflow. The
+  // devices freewheel and are stepped one buffer at a time in the order their
+  // crystals would call back, on a simulated timeline the aggregate also reads,
+  // so the outcome does not depend on how the host schedules threads
+  constexpr std::array<double, 3> PPM = {0.0, 400.0, -300.0};
+  constexpr uint32_t BUFFER = 256;
+  std::atomic<int64_t> now_ns{0};
+  AggregateDriverOptions options;
+  options.loopBandwidthHz = 1.0;
+  options.clockNs = [&now_ns] { return now_ns.load(std::memory_order_relaxed); };
+  std::vector<std::unique_ptr<IAudioDriver>> list;
+  for (size_t d = 0; d < PPM.size(); ++d) {
+    DummyDriverOptions device;
+    device.freewheel = true;
+    list.push_back(std::make_unique<DummyAudioDriver>(device));
+  }
+  AggregateAudioDriver aggregate(std::move(list), options);
+  ASSERT_EQ(aggregate.initialize(outputs(6)), SessionGraphError::OK);
+  ChannelLevels callback;
+  ASSERT_EQ(aggregate.start(&callback), SessionGraphError::OK);
+
+  // 30 simulated seconds: callback k of device d is due at k buffers of its own clock
+  std::array<double, 3> due_ns{};
+  std::array<double, 3> period_ns{};
+  for (size_t d = 0; d < PPM.size(); ++d) {
+    period_ns[d] = BUFFER * 1e9 / (48000.0 * (1.0 + PPM[d] / 1e6));
+  }
+  for (;;) {
+    const size_t d = static_cast<size_t>(
+        std::min_element(due_ns.begin(), due_ns.end()) - due_ns.begin());
+    if (due_ns[d] > 30e9) {
+      break;
+    }
+    now_ns.store(static_cast<int64_t>(due_ns[d]), std::memory_order_relaxed);
+    ASSERT_GE(aggregate.getDevice(d)->getClock()->advance(BUFFER), BUFFER);
+    due_ns[d] += period_ns[d];
+  }
+  auto stats = aggregate.getStats();
+  aggregate.stop();
+
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_NEAR(stats[0].driftPpm, 400.0, 1.0);
+  EXPECT_NEAR(stats[1].driftPpm, -300.0, 1.0);
+  for (const auto& device : stats) {
+    EXPECT_TRUE(device.locked);
+    EXPECT_LT(device.ratio, 1.01);
+    EXPECT_GT(device.ratio, 0.99);
+    EXPECT_NEAR(device.fillFrames, device.targetFillFrames, 2.0); // Held at the target
+    EXPECT_EQ(device.underruns, 0u);
+    EXPECT_EQ(device.overruns, 0u);
+    EXPECT_GT(device.resamplerCpuPercent, 0.0);
+    EXPECT_LT(device.resamplerCpuPercent, 50.0);
+  }
+}
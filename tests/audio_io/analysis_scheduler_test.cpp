@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/analysis_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Holds jobs inside their body until opened
+class Gate {
+public:
+  void open() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_open = true;
+    }
+    m_cv.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_open; });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_open = false;
+};
+
+/// Spin until a condition holds (bounded, for observing worker progress)
+template <typename Predicate> bool eventually(Predicate predicate) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(AnalysisSchedulerTest, RunsByPriorityThenSubmissionOrder) {
+  AnalysisScheduler scheduler(1);
+  Gate gate;
+  scheduler.submit([&](const std::atomic<bool>&) { gate.wait(); }); // Occupies the worker
+  ASSERT_TRUE(eventually([&] { return scheduler.stats().running == 1; }));
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int tag) {
+    return [&, tag](const std::atomic<bool>&) {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(tag);
+    };
+  };
+  scheduler.submit(record(1), AnalysisPriority::Background);
+  scheduler.submit(record(2), AnalysisPriority::Normal);
+  scheduler.submit(record(3), AnalysisPriority::Visible);
+  scheduler.submit(record(4), AnalysisPriority::Normal);
+  auto promoted = scheduler.submit(record(5), AnalysisPriority::Background);
+  EXPECT_TRUE(scheduler.setPriority(promoted, AnalysisPriority::Visible));
+  EXPECT_EQ(scheduler.stats().queued, 5u);
+
+  gate.open();
+  scheduler.waitIdle();
+  EXPECT_EQ(order, (std::vector<int>{3, 5, 2, 4, 1}));
+  EXPECT_FALSE(scheduler.setPriority(promoted, AnalysisPriority::Normal)); // Finished
+}
+
+TEST(AnalysisSchedulerTest, CancelDropsQueuedAndSignalsRunning) {
+  AnalysisScheduler scheduler(1);
+  std::atomic<bool> sawCancel{false};
+  auto running = scheduler.submit([&](const std::atomic<bool>& cancelled) {
+    while (!cancelled.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sawCancel = true;
+  });
+  ASSERT_TRUE(eventually([&] { return scheduler.stats().running == 1; }));
+
+  std::atomic<bool> ranQueued{false};
+  auto queued = scheduler.submit([&](const std::atomic<bool>&) { ranQueued = true; });
+
+  EXPECT_TRUE(scheduler.isPending(queued));
+  EXPECT_TRUE(scheduler.cancel(queued));
+  EXPECT_FALSE(scheduler.isPending(queued));
+  scheduler.wait(queued); // Returns at once: dropped
+  EXPECT_TRUE(scheduler.cancel(running));
+  scheduler.wait(running);
+  EXPECT_TRUE(sawCancel);
+
+  scheduler.waitIdle();
+  EXPECT_FALSE(ranQueued);
+  EXPECT_FALSE(scheduler.cancel(running)); // Finished
+  auto stats = scheduler.stats();
+  EXPECT_EQ(stats.cancelled, 2u);
+  EXPECT_EQ(stats.completed, 0u);
+}
+
+TEST(AnalysisSchedulerTest, LimitsConcurrentDiskJobs) {
+  AnalysisScheduler scheduler(4, 2);
+  EXPECT_EQ(scheduler.workerCount(), 4u);
+  EXPECT_EQ(scheduler.maxDiskJobs(), 2u);
+
+  std::atomic<int> diskNow{0};
+  std::atomic<int> diskMax{0};
+  for (int i = 0; i < 12; ++i) {
+    scheduler.submit([&](const std::atomic<bool>&) {
+      int now = ++diskNow;
+      int seen = diskMax.load();
+      while (now > seen && !diskMax.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      --diskNow;
+    });
+  }
+
+  // CPU-only work is not held back by the disk limit
+  Gate gate;
+  std::atomic<int> cpuRunning{0};
+  for (int i = 0; i < 2; ++i) {
+    scheduler.submit(
+        [&](const std::atomic<bool>&) {
+          ++cpuRunning;
+          gate.wait();
+        },
+        AnalysisPriority::Background, false);
+  }
+  EXPECT_TRUE(eventually([&] { return cpuRunning.load() == 2; }));
+  gate.open();
+
+  scheduler.waitIdle();
+  EXPECT_EQ(diskMax.load(), 2);
+  auto stats = scheduler.stats();
+  EXPECT_EQ(stats.completed, 14u);
+  EXPECT_EQ(stats.queued, 0u);
+  EXPECT_EQ(stats.running, 0u);
+  EXPECT_GE(stats.peakQueued, 1u);
+  EXPECT_GT(stats.jobsPerSecond, 0.0);
+  EXPECT_GT(stats.averageJobMs, 0.0);
+}
+
+TEST(AnalysisSchedulerTest, FailingJobDoesNotStopWorker) {
+  AnalysisScheduler scheduler(1);
+  scheduler.submit([](const std::atomic<bool>&) { throw std::runtime_error("bad file"); });
+  std::atomic<bool> ran{false};
+  scheduler.submit([&](const std::atomic<bool>&) { ran = true; });
+  scheduler.waitIdle();
+  EXPECT_TRUE(ran);
+}
+
+TEST(AnalysisSchedulerTest, DestructionCancelsPendingWork) {
+  std::atomic<int> ran{0};
+  {
+    AnalysisScheduler scheduler(1);
+    scheduler.submit([&](const std::atomic<bool>& cancelled) {
+      while (!cancelled.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+    for (int i = 0; i < 5; ++i) {
+      scheduler.submit([&](const std::atomic<bool>&) { ++ran; });
+    }
+  } // Must not hang
+  EXPECT_EQ(ran.load(), 0);
+}
+
+TEST(AnalysisSchedulerTest, SharedSchedulerIsBounded) {
+  auto& shared = sharedAnalysisScheduler();
+  EXPECT_GE(shared.workerCount(), 1u);
+  EXPECT_LE(shared.workerCount(), AnalysisScheduler::DEFAULT_MAX_WORKERS);
+  EXPECT_EQ(getAnalysisStats().running, shared.stats().running);
+}
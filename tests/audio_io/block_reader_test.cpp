@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/block_reader.h"
+#include "audio_io/pcm_stream_set.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Byte expected at an offset of test file `file`
+uint8_t patternByte(size_t file, uint64_t offset) {
+  return static_cast<uint8_t>((file * 31 + offset * 7 + (offset >> 8)) & 0xFF);
+}
+
+/// Every backend usable here, buffered and direct
+std::vector<BlockReaderOptions> configurations() {
+  std::vector<BlockReaderOptions> result;
+  for (auto backend : {BlockReaderBackend::Pread, BlockReaderBackend::IoUring}) {
+    if (backend == BlockReaderBackend::IoUring && !isIoUringAvailable()) {
+      continue;
+    }
+    for (bool direct : {false, true}) {
+      BlockReaderOptions options;
+      options.backend = backend;
+      options.maxBatch = 8;
+      options.maxReadBytes = 64 * 1024;
+      options.directIo = direct;
+      result.push_back(options);
+    }
+  }
+  return result;
+}
+
+std::string describe(const BlockReaderOptions& options) {
+  return std::string(options.backend == BlockReaderBackend::IoUring ? "io_uring" : "pread") +
+         (options.directIo ? " direct" : " buffered");
+}
+
+void putLE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+} // namespace
+
+class BlockReaderTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_block_reader_test";
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(m_dir);
+  }
+
+  std::string writeFile(const std::string& name, const std::vector<uint8_t>& bytes) {
+    auto path = m_dir / name;
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    return path.string();
+  }
+
+  std::string writePattern(size_t file, size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = patternByte(file, i);
+    }
+    return writeFile("pattern" + std::to_string(file) + ".bin", bytes);
+  }
+
+  /// 16-bit stereo WAV whose left channel counts frames and right channel is -left
+  std::string writeWave(const std::string& name, uint32_t frames) {
+    std::vector<uint8_t> out;
+    out.insert(out.end(), {'R', 'I', 'F', 'F'});
+    putLE(out, 36 + frames * 4, 4);
+    out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    putLE(out, 16, 4);
+    putLE(out, 1, 2); // PCM
+    putLE(out, 2, 2);
+    putLE(out, 48000, 4);
+    putLE(out, 48000 * 4, 4);
+    putLE(out, 4, 2);
+    putLE(out, 16, 2);
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    putLE(out, frames * 4, 4);
+    for (uint32_t i = 0; i < frames; ++i) {
+      auto value = static_cast<int16_t>(i % 30000);
+      putLE(out, static_cast<uint16_t>(value), 2);
+      putLE(out, static_cast<uint16_t>(-value), 2);
+    }
+    return writeFile(name, out);
+  }
+
+  std::filesystem::path m_dir;
+};
+
+// ============================================================================
+// BlockReader
+// ============================================================================
+
+TEST_F(BlockReaderTest, BatchReadsMatchFileContents) {
+  constexpr size_t FILES = 8;
+  constexpr size_t SIZE = 300 * 1000; // Not a multiple of the direct I/O alignment
+  std::vector<std::string> paths;
+  for (size_t f = 0; f < FILES; ++f) {
+    paths.push_back(writePattern(f, SIZE));
+  }
+
+  for (const auto& options : configurations()) {
+    SCOPED_TRACE(describe(options));
+    auto reader = createBlockReader(options);
+    ASSERT_NE(reader, nullptr);
+    EXPECT_EQ(reader->backend(), options.backend);
+    std::vector<uint32_t> files;
+    for (const auto& path : paths) {
+      auto file = reader->openFile(path);
+      ASSERT_TRUE(file.has_value());
+      files.push_back(*file);
+    }
+
+    // Unaligned offsets and lengths, two passes to reuse the pool
+    for (uint64_t pass = 0; pass < 2; ++pass) {
+      std::vector<BlockRead> reads(FILES);
+      for (size_t f = 0; f < FILES; ++f) {
+        reads[f].file = files[f];
+        reads[f].offset = pass * 65536 + f * 4099 + 13;
+        reads[f].length = 40000 + f * 3001;
+      }
+      ASSERT_TRUE(reader->readBatch(reads));
+      for (size_t f = 0; f < FILES; ++f) {
+        ASSERT_EQ(reads[f].result, static_cast<int64_t>(reads[f].length)) << "file " << f;
+        for (size_t i = 0; i < reads[f].length; ++i) {
+          ASSERT_EQ(reads[f].data[i], patternByte(f, reads[f].offset + i))
+              << "file " << f << " byte " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(BlockReaderTest, ReadsStopAtEndOfFile) {
+  auto path = writePattern(0, 10000);
+  for (const auto& options : configurations()) {
+    SCOPED_TRACE(describe(options));
+    auto reader = createBlockReader(options);
+    auto file = reader->openFile(path);
+    ASSERT_TRUE(file.has_value());
+
+    std::vector<BlockRead> reads(3);
+    reads[0] = {*file, 9000, 4096};  // Crosses the end
+    reads[1] = {*file, 10000, 100};  // At the end
+    reads[2] = {*file, 50000, 4096}; // Beyond it
+    ASSERT_TRUE(reader->readBatch(reads));
+    EXPECT_EQ(reads[0].result, 1000);
+    EXPECT_EQ(reads[0].data[999], patternByte(0, 9999));
+    EXPECT_EQ(reads[1].result, 0);
+    EXPECT_EQ(reads[2].result, 0);
+  }
+}
+
+TEST_F(BlockReaderTest, InvalidBatchesAreRejected) {
+  auto path = writePattern(0, 1000);
+  auto reader = createBlockReader(configurations().front());
+  auto file = reader->openFile(path);
+  ASSERT_TRUE(file.has_value());
+  EXPECT_FALSE(reader->openFile((m_dir / "missing.bin").string()).has_value());
+
+  std::vector<BlockRead> too_many(reader->maxBatch() + 1, BlockRead{*file, 0, 10});
+  EXPECT_FALSE(reader->readBatch(too_many));
+  std::vector<BlockRead> empty_read{{*file, 0, 0}};
+  EXPECT_FALSE(reader->readBatch(empty_read));
+  std::vector<BlockRead> too_long{{*file, 0, reader->maxReadBytes() + 1}};
+  EXPECT_FALSE(reader->readBatch(too_long));
+
+  reader->closeFile(*file);
+  std::vector<BlockRead> closed{{*file, 0, 10}};
+  EXPECT_FALSE(reader->readBatch(closed));
+
+  // Handles are reused once closed
+  auto reopened = reader->openFile(path);
+  ASSERT_TRUE(reopened.has_value());
+  EXPECT_EQ(*reopened, *file);
+  EXPECT_TRUE(reader->readBatch(closed));
+  EXPECT_EQ(closed[0].result, 10);
+}
+
+TEST_F(BlockReaderTest, AutoSelectsIoUringWhenAvailable) {
+  auto reader = createBlockReader();
+  ASSERT_NE(reader, nullptr);
+  BlockReaderOptions uring;
+  uring.backend = BlockReaderBackend::IoUring;
+  if (isIoUringAvailable()) {
+    EXPECT_EQ(reader->backend(), BlockReaderBackend::IoUring);
+    EXPECT_NE(createBlockReader(uring), nullptr);
+  } else {
+    EXPECT_EQ(reader->backend(), BlockReaderBackend::Pread);
+    EXPECT_EQ(createBlockReader(uring), nullptr);
+  }
+}
+
+// ============================================================================
+// PcmStreamSet
+// ============================================================================
+
+TEST_F(BlockReaderTest, StreamSetDecodesFilesInLockstep) {
+  auto long_wave = writeWave("long.wav", 5000);
+  auto short_wave = writeWave("short.wav", 1500);
+
+  for (const auto& options : configurations()) {
+    SCOPED_TRACE(describe(options));
+    PcmStreamSet streams(createBlockReader(options));
+    auto a = streams.open(long_wave);
+    auto b = streams.open(short_wave);
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(streams.layout(*a)->num_frames, 5000);
+    EXPECT_EQ(streams.maxFramesPerRead(*a), options.maxReadBytes / 4);
+
+    std::vector<std::vector<float>> buffers(streams.streamSlots(), std::vector<float>(2048));
+    std::vector<float*> outputs;
+    for (auto& buffer : buffers) {
+      outputs.push_back(buffer.data());
+    }
+    std::vector<int64_t> frames(streams.streamSlots());
+
+    int64_t expected_a = 0;
+    for (int block = 0; block < 6; ++block) {
+      ASSERT_TRUE(streams.readNext(1024, outputs, frames));
+      const int64_t want_a = std::min<int64_t>(1024, 5000 - expected_a);
+      const int64_t want_b = std::min<int64_t>(1024, std::max<int64_t>(0, 1500 - block * 1024));
+      ASSERT_EQ(frames[*a], want_a);
+      ASSERT_EQ(frames[*b], want_b);
+      for (int64_t i = 0; i < want_a; ++i) {
+        const float value = static_cast<float>((expected_a + i) % 30000) / 32768.0f;
+        ASSERT_EQ(buffers[*a][static_cast<size_t>(i * 2)], value);
+        ASSERT_EQ(buffers[*a][static_cast<size_t>(i * 2 + 1)], -value);
+      }
+      expected_a += want_a;
+    }
+    EXPECT_EQ(streams.position(*a), 5000);
+
+    ASSERT_TRUE(streams.seek(*b, 1000));
+    ASSERT_TRUE(streams.readNext(1024, outputs, frames));
+    EXPECT_EQ(frames[*a], 0);
+    EXPECT_EQ(frames[*b], 500);
+    EXPECT_EQ(buffers[*b][0], 1000.0f / 32768.0f);
+  }
+}
+
+TEST_F(BlockReaderTest, StreamSetRejectsOtherFilesAndLimitsStreams) {
+  auto wave = writeWave("tone.wav", 100);
+  auto other = writePattern(0, 1000);
+
+  BlockReaderOptions options;
+  options.maxBatch = 2;
+  PcmStreamSet streams(createBlockReader(options));
+  EXPECT_FALSE(streams.open(other).has_value());
+  auto first = streams.open(wave);
+  auto second = streams.open(wave);
+  ASSERT_TRUE(first && second);
+  EXPECT_FALSE(streams.open(wave).has_value()); // One per batch slot
+
+  streams.close(*first);
+  EXPECT_EQ(streams.layout(*first), nullptr);
+  EXPECT_EQ(streams.position(*first), -1);
+  EXPECT_FALSE(streams.seek(*first, 0));
+  EXPECT_EQ(streams.open(wave), first);
+
+  std::vector<float*> too_few{nullptr};
+  std::vector<int64_t> frames(1);
+  EXPECT_FALSE(streams.readNext(16, too_few, frames));
+}
+
+TEST_F(BlockReaderTest, StreamSetIssuesPlaybackReadsThroughScheduler) {
+  auto wave = writeWave("tone.wav", 2000);
+  IoScheduler scheduler;
+  PcmStreamSet streams(createBlockReader(), &scheduler);
+  auto stream = streams.open(wave);
+  ASSERT_TRUE(stream.has_value());
+
+  std::vector<float> buffer(1024 * 2);
+  std::vector<float*> outputs{buffer.data()};
+  std::vector<int64_t> frames(1);
+  ASSERT_TRUE(streams.readNext(1024, outputs, frames, IoScheduler::playbackDeadline(512, 48000)));
+  EXPECT_EQ(frames[0], 1024);
+  EXPECT_EQ(scheduler.stats()[IoClass::Playback].completed, 1u);
+  EXPECT_EQ(scheduler.stats()[IoClass::Playback].latency.total(), 1u);
+}
@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/decoded_audio_cache.h"
+#include "audio_io/file_fingerprint.h"
+#include "audio_io/sample_source.h"
+#include "audio_io/temp_path.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Decoder producing a stereo ramp (L = frame, R = -frame) and counting opens
+class RampReader : public IAudioFileReader {
+public:
+  RampReader(int64_t frames, int& opens) : m_frames(frames), m_opens(opens) {}
+
+  Result<AudioFileMetadata> open(const std::string&) override {
+    ++m_opens;
+    Result<AudioFileMetadata> result;
+    result.value.format = AudioFileFormat::FLAC;
+    result.value.sample_rate = 44100;
+    result.value.num_channels = 2;
+    result.value.duration_samples = m_frames;
+    result.value.bit_depth = 24;
+    result.value.codec = "FLAC";
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+
+  Result<size_t> readSamples(float* buffer, size_t num_samples) override {
+    Result<size_t> result;
+    size_t frames = std::min(num_samples, static_cast<size_t>(m_frames - m_position));
+    for (size_t i = 0; i < frames; ++i) {
+      buffer[i * 2] = static_cast<float>(m_position);
+      buffer[i * 2 + 1] = -static_cast<float>(m_position);
+      ++m_position;
+    }
+    result.value = frames;
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+
+  SessionGraphError seek(int64_t sample_position) override {
+    m_position = sample_position;
+    return SessionGraphError::OK;
+  }
+  void close() override {}
+  int64_t getCurrentPosition() const override {
+    return m_position;
+  }
+  bool isOpen() const override {
+    return true;
+  }
+
+private:
+  int64_t m_frames;
+  int64_t m_position = 0;
+  int& m_opens;
+};
+
+std::shared_ptr<const SampleSource> makeSource(int64_t frames, float offset) {
+  AudioFileMetadata metadata;
+  metadata.format = AudioFileFormat::FLAC;
+  metadata.sample_rate = 48000;
+  metadata.num_channels = 2;
+  metadata.duration_samples = frames;
+  metadata.bit_depth = 16;
+  metadata.codec = "FLAC";
+  std::vector<float> samples(static_cast<size_t>(frames) * 2);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = offset + static_cast<float>(i);
+  }
+  return std::make_shared<const SampleSource>(std::move(metadata), std::move(samples));
+}
+
+std::string key(char digit) {
+  return std::string(64, digit);
+}
+
+} // namespace
+
+class DecodedAudioCacheTest : public ::testing::Test {
+protected:
+  static constexpr int64_t FRAMES = 30000;
+
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_decoded_audio_cache_test";
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+    m_cache = std::make_shared<DecodedAudioCache>(m_dir / "decoded",
+                                                  DecodedAudioCache::DEFAULT_MAX_BYTES, &m_index);
+  }
+
+  void TearDown() override {
+    m_cache.reset();
+    std::filesystem::remove_all(m_dir);
+  }
+
+  std::string writeFile(const std::string& name, const std::string& contents) {
+    auto path = m_dir / name;
+    std::ofstream(path) << contents;
+    return path.string();
+  }
+
+  std::unique_ptr<SampleSourceCache> makeSourceCache() {
+    auto sources = std::make_unique<SampleSourceCache>(
+        [this] { return std::make_unique<RampReader>(FRAMES, m_opens); });
+    sources->setDecodedCache(m_cache);
+    return sources;
+  }
+
+  std::filesystem::path m_dir;
+  FingerprintIndex m_index; // Memory-only
+  std::shared_ptr<DecodedAudioCache> m_cache;
+  int m_opens = 0;
+};
+
+// ============================================================================
+// Sidecar storage
+// ============================================================================
+
+TEST_F(DecodedAudioCacheTest, StoreThenLoadRoundTrips) {
+  auto source = makeSource(1000, 0.5f);
+  ASSERT_TRUE(m_cache->store(key('a'), *source));
+  EXPECT_TRUE(m_cache->contains(key('a')));
+
+  auto loaded = m_cache->load(key('a'));
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->numFrames(), 1000);
+  EXPECT_EQ(loaded->numChannels(), 2);
+  EXPECT_EQ(loaded->metadata().sample_rate, 48000u);
+  EXPECT_EQ(loaded->metadata().bit_depth, 16);
+  EXPECT_EQ(loaded->metadata().format, AudioFileFormat::FLAC);
+  EXPECT_EQ(loaded->metadata().codec, "FLAC");
+  EXPECT_EQ(loaded->metadata().file_hash_sha256, key('a'));
+
+  std::vector<float> buffer(2 * 4);
+  ASSERT_EQ(loaded->read(998, buffer.data(), 4), 2u);
+  EXPECT_EQ(buffer[0], 0.5f + 1996.0f);
+  EXPECT_EQ(buffer[3], 0.5f + 1999.0f);
+}
+
+TEST_F(DecodedAudioCacheTest, MissingOrCorruptSidecarIsNotLoaded) {
+  EXPECT_EQ(m_cache->load(key('b')), nullptr);
+  EXPECT_FALSE(m_cache->contains(key('b')));
+
+  auto source = makeSource(1000, 0.0f);
+  ASSERT_TRUE(m_cache->store(key('b'), *source));
+  std::filesystem::resize_file(m_cache->sidecarPath(key('b')), 1000);
+  EXPECT_EQ(m_cache->load(key('b')), nullptr);
+  EXPECT_FALSE(m_cache->contains(key('b')));
+}
+
+TEST_F(DecodedAudioCacheTest, RejectsKeysThatAreNotHashes) {
+  auto source = makeSource(10, 0.0f);
+  EXPECT_FALSE(m_cache->store("../escape", *source));
+  EXPECT_FALSE(m_cache->store(std::string(64, 'G'), *source));
+  EXPECT_EQ(m_cache->load("../escape"), nullptr);
+}
+
+TEST_F(DecodedAudioCacheTest, EvictsLeastRecentlyUsed) {
+  auto source = makeSource(1000, 0.0f); // 8064-byte sidecars
+  DecodedAudioCache cache(m_dir / "bounded", 3 * 8064, &m_index);
+
+  ASSERT_TRUE(cache.store(key('1'), *source));
+  ASSERT_TRUE(cache.store(key('2'), *source));
+  ASSERT_TRUE(cache.store(key('3'), *source));
+
+  // Make '1' the oldest, then use it so '2' becomes the eviction candidate
+  auto now = std::filesystem::file_time_type::clock::now();
+  std::filesystem::last_write_time(cache.sidecarPath(key('1')), now - std::chrono::hours(3));
+  std::filesystem::last_write_time(cache.sidecarPath(key('2')), now - std::chrono::hours(2));
+  std::filesystem::last_write_time(cache.sidecarPath(key('3')), now - std::chrono::hours(1));
+  ASSERT_NE(cache.load(key('1')), nullptr);
+
+  ASSERT_TRUE(cache.store(key('4'), *source));
+  EXPECT_TRUE(cache.contains(key('1')));
+  EXPECT_FALSE(cache.contains(key('2')));
+  EXPECT_TRUE(cache.contains(key('3')));
+  EXPECT_TRUE(cache.contains(key('4')));
+  EXPECT_LE(cache.totalBytes(), cache.maxBytes());
+
+  // Larger than the whole cache: not stored
+  EXPECT_FALSE(cache.store(key('5'), *makeSource(4000, 0.0f)));
+}
+
+TEST_F(DecodedAudioCacheTest, TemporaryNamesNeverRepeat) {
+  // Writers in other processes share the directory, so names carry more than a thread id
+  auto target = m_cache->sidecarPath(key('a'));
+  auto first = uniqueTempPath(target);
+  auto second = uniqueTempPath(target);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first.parent_path(), target.parent_path());
+  EXPECT_EQ(first.filename().string().rfind(target.filename().string() + ".tmp", 0), 0u);
+}
+
+TEST_F(DecodedAudioCacheTest, OnlyCompressedFormatsAreCacheable) {
+  EXPECT_TRUE(DecodedAudioCache::isCacheable("/show/intro.flac"));
+  EXPECT_TRUE(DecodedAudioCache::isCacheable("/show/INTRO.FLAC"));
+  EXPECT_TRUE(DecodedAudioCache::isCacheable("/show/bed.ogg"));
+  EXPECT_FALSE(DecodedAudioCache::isCacheable("/show/hit.wav"));
+  EXPECT_FALSE(DecodedAudioCache::isCacheable("/show/hit.aiff"));
+}
+
+// ============================================================================
+// SampleSourceCache integration
+// ============================================================================
+
+TEST_F(DecodedAudioCacheTest, SecondRunMapsInsteadOfDecoding) {
+  auto file = writeFile("intro.flac", "compressed bytes");
+
+  {
+    auto sources = makeSourceCache();
+    auto first = sources->acquire(file);
+    ASSERT_TRUE(first.isOk());
+    EXPECT_EQ(m_opens, 1);
+  }
+  EXPECT_TRUE(m_cache->contains(m_cache->contentKey(file)));
+
+  // A fresh in-memory cache (as after restarting) finds the sidecar
+  auto sources = makeSourceCache();
+  auto second = sources->acquire(file);
+  ASSERT_TRUE(second.isOk());
+  EXPECT_EQ(m_opens, 1);
+  EXPECT_EQ(second.value->numFrames(), FRAMES);
+
+  SampleCursor cursor(second.value);
+  std::vector<float> buffer(2);
+  cursor.seek(1234);
+  ASSERT_EQ(cursor.read(buffer.data(), 1), 1u);
+  EXPECT_EQ(buffer[0], 1234.0f);
+  EXPECT_EQ(buffer[1], -1234.0f);
+}
+
+TEST_F(DecodedAudioCacheTest, MappedSidecarsCountAgainstResidentBudget) {
+  auto file = writeFile("bed.flac", "long bed");
+  constexpr int64_t frames = SampleSource::STREAM_HEAD_FRAMES * 2; // Streamable
+  constexpr size_t bytes = static_cast<size_t>(frames) * 2 * sizeof(float);
+  auto makeSources = [this, frames](size_t limit) {
+    auto sources = std::make_unique<SampleSourceCache>(
+        [this, frames] { return std::make_unique<RampReader>(frames, m_opens); });
+    sources->setDecodedCache(m_cache);
+    sources->setResidentLimitBytes(limit);
+    return sources;
+  };
+
+  {
+    auto sources = makeSources(bytes);
+    auto decoded = sources->acquire(file);
+    ASSERT_TRUE(decoded.isOk());
+    ASSERT_TRUE(decoded.value->isResident());
+  }
+  EXPECT_EQ(m_opens, 1);
+
+  // Within the budget the sidecar is mapped and held like decoded frames
+  {
+    auto sources = makeSources(bytes);
+    auto mapped = sources->acquire(file);
+    ASSERT_TRUE(mapped.isOk());
+    EXPECT_EQ(m_opens, 1);
+    EXPECT_TRUE(mapped.value->isResident());
+    EXPECT_EQ(sources->residentBytes(), bytes);
+  }
+
+  // Beyond it the sidecar is skipped and the file streamed
+  auto sources = makeSources(bytes / 2);
+  auto streamed = sources->acquire(file);
+  ASSERT_TRUE(streamed.isOk());
+  EXPECT_EQ(m_opens, 2);
+  EXPECT_FALSE(streamed.value->isResident());
+  EXPECT_LE(sources->residentBytes(), bytes / 2);
+}
+
+TEST_F(DecodedAudioCacheTest, IdenticalContentSharesOneSidecar) {
+  auto a = writeFile("a.flac", "same content");
+  auto b = writeFile("b.flac", "same content");
+
+  auto sources = makeSourceCache();
+  ASSERT_TRUE(sources->acquire(a).isOk());
+  EXPECT_EQ(m_opens, 1);
+
+  ASSERT_TRUE(sources->acquire(b).isOk()); // Different path, same content hash
+  EXPECT_EQ(m_opens, 1);
+}
+
+TEST_F(DecodedAudioCacheTest, UncompressedFilesBypassSidecars) {
+  auto file = writeFile("hit.wav", "pcm bytes");
+
+  makeSourceCache()->acquire(file);
+  makeSourceCache()->acquire(file);
+  EXPECT_EQ(m_opens, 2);
+  EXPECT_EQ(m_cache->totalBytes(), 0u);
+}
@@ -1,9 +1,13 @@
 // SPDX-License-Identifier: MIT
 #include <gtest/gtest.h>
 #include <orpheus/audio_driver.h>
+#include <orpheus/performance_monitor.h>
+
+#include "audio_io/dummy_audio_driver.h"
 
 #include <atomic>
 #include <chrono>
+#include <limits>
 #include <thread>
 
 using namespace orpheus;
@@ -46,6 +50,25 @@ private:
   size_t m_last_num_frames{0};
 };
 
+// Callback that takes a fixed time (simulated DSP load)
+class SlowCallback : public IAudioCallback {
+public:
+  explicit SlowCallback(std::chrono::microseconds work) : m_work(work) {}
+
+  void processAudio(const float**, float**, size_t, size_t) override {
+    std::this_thread::sleep_for(m_work);
+    m_call_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int getCallCount() const {
+    return m_call_count.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::chrono::microseconds m_work;
+  std::atomic<int> m_call_count{0};
+};
+
 // Test fixture
 class DummyDriverTest : public ::testing::Test {
 protected:
@@ -182,6 +205,40 @@ TEST_F(DummyDriverTest, GetLatency) {
   EXPECT_EQ(m_driver->getLatencySamples(), config.buffer_size);
 }
 
+namespace {
+
+/// Host that reports total latency by asking its driver (like Clip Composer's AudioEngine)
+class LatencyReportingHost : public IAudioCallback {
+public:
+  explicit LatencyReportingHost(IAudioDriver& driver) : m_driver(driver) {}
+
+  void processAudio(const float**, float**, size_t, size_t) override {}
+  uint32_t getProcessingLatencySamples() const override {
+    return 96; // e.g. limiter look-ahead
+  }
+
+  /// Must not be reached back through the callback interface
+  uint32_t getLatencySamples() const {
+    return m_driver.getLatencySamples();
+  }
+
+private:
+  IAudioDriver& m_driver;
+};
+
+} // namespace
+
+TEST_F(DummyDriverTest, LatencyIncludesCallbackProcessingLatency) {
+  AudioDriverConfig config;
+  config.buffer_size = 256;
+  ASSERT_EQ(m_driver->initialize(config), SessionGraphError::OK);
+
+  LatencyReportingHost host(*m_driver);
+  ASSERT_EQ(m_driver->start(&host), SessionGraphError::OK);
+  EXPECT_EQ(host.getLatencySamples(), 256u + 96u);
+  m_driver->stop();
+}
+
 TEST_F(DummyDriverTest, CannotStartTwice) {
   AudioDriverConfig config;
   config.sample_rate = 48000;
@@ -202,3 +259,381 @@ TEST_F(DummyDriverTest, StopWhenNotRunning) {
   auto error = m_driver->stop();
   EXPECT_EQ(error, SessionGraphError::OK);
 }
+
+// ============================================================================
+// Absolute-deadline pacing
+// ============================================================================
+
+namespace {
+
+/// 10 ms periods
+AudioDriverConfig tenMillisecondPeriods() {
+  AudioDriverConfig config;
+  config.sample_rate = 48000;
+  config.buffer_size = 480;
+  return config;
+}
+
+/// Run a driver with a callback for a while; returns the elapsed time
+std::chrono::duration<double> runFor(IAudioDriver& driver, IAudioCallback& callback,
+                                     std::chrono::milliseconds duration) {
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(driver.start(&callback), SessionGraphError::OK);
+  std::this_thread::sleep_for(duration);
+  driver.stop();
+  return std::chrono::steady_clock::now() - start;
+}
+
+} // namespace
+
+TEST(DummyDriverPacingTest, CallbackRateFollowsSampleClockUnderLoad) {
+  // Half of every period spent in the callback: relative sleeps would lose a third of the rate
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(5000));
+  auto elapsed = runFor(driver, callback, std::chrono::milliseconds(600));
+
+  const double expected = elapsed.count() / 0.010;
+  EXPECT_NEAR(callback.getCallCount(), expected, 4.0);
+  auto timing = driver.getTiming();
+  EXPECT_EQ(timing.callbacks, static_cast<uint64_t>(callback.getCallCount()));
+  EXPECT_GE(timing.maxCallbackUs, 5000.0);
+  EXPECT_LT(timing.minHeadroomUs, 5000.0); // Period minus callback
+}
+
+TEST(DummyDriverPacingTest, OverrunningCallbacksDropPeriods) {
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(25000)); // 2.5 periods
+  runFor(driver, callback, std::chrono::milliseconds(300));
+
+  auto timing = driver.getTiming();
+  ASSERT_GT(timing.callbacks, 0u);
+  EXPECT_EQ(timing.lateCallbacks, timing.callbacks);
+  EXPECT_LT(timing.minHeadroomUs, 0.0);
+  EXPECT_GE(timing.skippedPeriods, timing.callbacks); // At least one dropped per callback
+}
+
+TEST(DummyDriverPacingTest, InjectedJitterAppearsAsLateness) {
+  DummyDriverOptions options;
+  options.jitter.maxWakeupDelayUs = 4000;
+  options.jitter.stallProbability = 0.2;
+  options.jitter.stallUs = 15000; // Longer than a period
+  auto driver = createDummyAudioDriver(options);
+  ASSERT_EQ(driver->initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(0));
+  runFor(*driver, callback, std::chrono::milliseconds(600));
+
+  auto timing = static_cast<DummyAudioDriver&>(*driver).getTiming();
+  ASSERT_GT(timing.callbacks, 10u);
+  EXPECT_GT(timing.meanLatenessUs, 1000.0); // Uniform 0-4 ms plus stalls
+  EXPECT_GE(timing.maxLatenessUs, 15000.0); // At least one stall
+  EXPECT_GT(timing.lateCallbacks, 0u);      // Stalled callbacks miss their period
+}
+
+TEST(DummyDriverPacingTest, QuietSystemHasHeadroom) {
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(0));
+  runFor(driver, callback, std::chrono::milliseconds(200));
+
+  auto timing = driver.getTiming();
+  ASSERT_GT(timing.callbacks, 0u);
+  EXPECT_GT(timing.minHeadroomUs, 0.0);
+  EXPECT_EQ(timing.skippedPeriods, 0u);
+}
+
+// ============================================================================
+// Audio thread setup
+// ============================================================================
+
+namespace {
+
+/// Records whether a denormal survives arithmetic on the audio thread
+class DenormalProbe : public IAudioCallback {
+public:
+  void processAudio(const float**, float**, size_t, size_t) override {
+    volatile float denormal = std::numeric_limits<float>::denorm_min() * 1000.0f;
+    volatile float one = 1.0f;
+    m_flushed.store(denormal * one == 0.0f, std::memory_order_relaxed);
+    m_called.store(true, std::memory_order_release);
+  }
+
+  std::atomic<bool> m_flushed{false};
+  std::atomic<bool> m_called{false};
+};
+
+} // namespace
+
+TEST(DummyDriverRealtimeTest, AudioThreadIsSetUpBeforeTheFirstCallback) {
+  DummyDriverOptions options;
+  options.realtime.name = "render";
+  DummyAudioDriver driver(options);
+  auto monitor = createPerformanceMonitor(nullptr);
+  driver.setPerformanceMonitor(monitor.get());
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+
+  DenormalProbe probe;
+  ASSERT_EQ(driver.start(&probe), SessionGraphError::OK);
+
+  // start() returned after setup: the report is already there
+  auto report = driver.getRealtimeReport();
+  EXPECT_EQ(report.name, "render");
+  EXPECT_EQ(report.policy, RealtimePolicy::None); // Off by default for the dummy driver
+  EXPECT_EQ(report.memoryLock, MemoryLock::None);
+  EXPECT_GT(report.prefaultedStackBytes, 0u);
+  auto threads = monitor->getRealtimeThreads();
+  ASSERT_EQ(threads.size(), 1u);
+  EXPECT_EQ(threads[0].name, "render");
+
+  while (!probe.m_called.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  driver.stop();
+  EXPECT_EQ(probe.m_flushed.load(), report.denormalsFlushed);
+#if defined(__SSE__) || defined(_M_X64) || defined(__aarch64__)
+  EXPECT_TRUE(report.denormalsFlushed);
+#endif
+
+  // Restarting reports again under the same name
+  ASSERT_EQ(driver.start(&probe), SessionGraphError::OK);
+  driver.stop();
+  EXPECT_EQ(monitor->getRealtimeThreads().size(), 1u);
+}
+
+// ============================================================================
+// Freewheel mode
+// ============================================================================
+
+namespace {
+
+DummyDriverOptions freewheeling() {
+  DummyDriverOptions options;
+  options.freewheel = true;
+  return options;
+}
+
+AudioDriverConfig blocksOf512() {
+  AudioDriverConfig config;
+  config.sample_rate = 48000;
+  config.buffer_size = 512;
+  return config;
+}
+
+} // namespace
+
+TEST(DummyDriverFreewheelTest, RendersAnHourInSeconds) {
+  DummyAudioDriver driver(freewheeling());
+  ASSERT_EQ(driver.initialize(blocksOf512()), SessionGraphError::OK);
+  TestCallback callback;
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+  EXPECT_TRUE(driver.isFreewheeling());
+  EXPECT_EQ(driver.getClock(), &driver);
+
+  const uint64_t hour = 3600ull * 48000;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(driver.advance(hour), hour); // A whole number of 512-frame blocks
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  driver.stop();
+
+  EXPECT_EQ(callback.getCallCount(), static_cast<int>(hour / 512));
+  EXPECT_LT(elapsed, std::chrono::seconds(30));
+  auto timing = driver.getTiming();
+  EXPECT_EQ(timing.callbacks, hour / 512);
+  EXPECT_EQ(timing.skippedPeriods, 0u);
+  EXPECT_EQ(timing.minHeadroomUs, 0.0); // Not tracked without deadlines
+}
+
+TEST(DummyDriverFreewheelTest, ClockOnlyMovesWhenAdvanced) {
+  DummyAudioDriver driver(freewheeling());
+  ASSERT_EQ(driver.initialize(blocksOf512()), SessionGraphError::OK);
+  TestCallback callback;
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+  EXPECT_EQ(driver.getSampleTime(), 0u);
+
+  EXPECT_EQ(driver.advance(1000), 1024u); // Whole blocks: ends past the target
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(driver.getSampleTime(), 1024u);
+  EXPECT_EQ(callback.getCallCount(), 2);
+
+  EXPECT_EQ(driver.advance(24), 1536u); // From where the clock stands
+  EXPECT_EQ(driver.advance(0), 1536u);
+  driver.stop();
+  EXPECT_EQ(driver.advance(512), 1536u); // Stopped: returns at once
+
+  // Restarting resets the clock
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+  EXPECT_EQ(driver.getSampleTime(), 0u);
+  EXPECT_EQ(driver.advance(512), 512u);
+  driver.stop();
+}
+
+TEST(DummyDriverFreewheelTest, StopReleasesAdvance) {
+  DummyAudioDriver driver(freewheeling());
+  ASSERT_EQ(driver.initialize(blocksOf512()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(100));
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+
+  const uint64_t target = uint64_t{1} << 40;
+  uint64_t reached = 0;
+  std::thread waiter([&] { reached = driver.advance(target); });
+  while (driver.getSampleTime() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  driver.stop();
+  waiter.join();
+  EXPECT_GT(reached, 0u);
+  EXPECT_LT(reached, target);
+}
+
+TEST(DummyDriverFreewheelTest, RealTimeClockAdvancesInRealTime) {
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  SlowCallback callback(std::chrono::microseconds(0));
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+  EXPECT_FALSE(driver.isFreewheeling());
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_GE(driver.advance(4800), 4800u); // 100 ms
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  driver.stop();
+  EXPECT_GE(elapsed, std::chrono::milliseconds(80));
+}
+
+TEST(DummyDriverFreewheelTest, MonitorUptimeFollowsTheVirtualClock) {
+  DummyAudioDriver driver(freewheeling());
+  ASSERT_EQ(driver.initialize(blocksOf512()), SessionGraphError::OK);
+  auto monitor = createPerformanceMonitor(nullptr);
+  monitor->setAudioClock(driver.getClock());
+  TestCallback callback;
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+
+  driver.advance(10 * 48000);
+  auto metrics = monitor->getMetrics();
+  EXPECT_NEAR(metrics.uptimeSeconds, 10.0, 512.0 / 48000.0);
+  EXPECT_TRUE(metrics.freewheeling);
+
+  driver.stop();
+  monitor->setAudioClock(nullptr);
+  EXPECT_FALSE(monitor->getMetrics().freewheeling);
+}
+
+// ============================================================================
+// Deadline-miss detection
+// ============================================================================
+
+namespace {
+
+/// Burns thread CPU time or blocks in every callback, and counts reported underruns
+class OverrunningCallback : public IAudioCallback {
+public:
+  enum class Mode { Spin, Sleep, Nothing };
+
+  OverrunningCallback(Mode mode, std::chrono::microseconds work) : m_mode(mode), m_work(work) {}
+
+  void processAudio(const float**, float**, size_t, size_t) override {
+    if (m_mode == Mode::Spin) {
+      // Spin on the thread's own CPU clock, so preemption cannot shorten the work
+      const int64_t until = threadCpuTimeNs() + m_work.count() * 1000;
+      while (threadCpuTimeNs() < until) {
+      }
+    } else if (m_mode == Mode::Sleep) {
+      std::this_thread::sleep_for(m_work);
+    }
+  }
+
+  void onUnderrun(UnderrunCause cause) override {
+    auto& count = cause == UnderrunCause::SlowProcessing ? m_slow : m_preempted;
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t slow() const {
+    return m_slow.load(std::memory_order_relaxed);
+  }
+  uint64_t preempted() const {
+    return m_preempted.load(std::memory_order_relaxed);
+  }
+
+private:
+  Mode m_mode;
+  std::chrono::microseconds m_work;
+  std::atomic<uint64_t> m_slow{0};
+  std::atomic<uint64_t> m_preempted{0};
+};
+
+} // namespace
+
+TEST(DummyDriverDeadlineTest, CpuBoundOverrunsAreSlowProcessing) {
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  auto monitor = createPerformanceMonitor(nullptr);
+  driver.setPerformanceMonitor(monitor.get());
+  OverrunningCallback callback(OverrunningCallback::Mode::Spin, std::chrono::microseconds(15000));
+  runFor(driver, callback, std::chrono::milliseconds(200));
+
+  auto timing = driver.getTiming();
+  ASSERT_GT(timing.callbacks, 0u);
+  EXPECT_EQ(timing.lateCallbacks, timing.callbacks);
+  EXPECT_EQ(timing.slowCallbacks, timing.lateCallbacks);
+  EXPECT_EQ(timing.preemptedCallbacks, 0u);
+  EXPECT_EQ(callback.slow(), timing.slowCallbacks);
+  EXPECT_EQ(callback.preempted(), 0u);
+
+  // Every callback is recorded, every miss counted, without the host wiring anything up
+  auto metrics = monitor->getMetrics();
+  EXPECT_EQ(metrics.totalSamplesProcessed, timing.callbacks * 480);
+  EXPECT_EQ(metrics.bufferUnderrunCount, timing.lateCallbacks);
+  EXPECT_EQ(metrics.slowUnderrunCount, timing.lateCallbacks);
+  EXPECT_EQ(metrics.preemptUnderrunCount, 0u);
+  EXPECT_GT(monitor->getPeakCpuUsage(), 100.0f);
+}
+
+TEST(DummyDriverDeadlineTest, BlockedCallbacksArePreempted) {
+  DummyAudioDriver driver;
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  auto monitor = createPerformanceMonitor(nullptr);
+  driver.setPerformanceMonitor(monitor.get());
+  OverrunningCallback callback(OverrunningCallback::Mode::Sleep, std::chrono::microseconds(15000));
+  runFor(driver, callback, std::chrono::milliseconds(200));
+
+  // Late on the wall clock, with almost no CPU time: the thread was off the CPU
+  auto timing = driver.getTiming();
+  ASSERT_GT(timing.lateCallbacks, 0u);
+  EXPECT_EQ(timing.preemptedCallbacks, timing.lateCallbacks);
+  EXPECT_EQ(timing.slowCallbacks, 0u);
+  EXPECT_EQ(callback.preempted(), timing.lateCallbacks);
+  auto metrics = monitor->getMetrics();
+  EXPECT_EQ(metrics.preemptUnderrunCount, timing.lateCallbacks);
+  EXPECT_EQ(metrics.slowUnderrunCount, 0u);
+}
+
+TEST(DummyDriverDeadlineTest, LateWakeupsArePreempted) {
+  DummyDriverOptions options;
+  options.jitter.stallProbability = 1.0;
+  options.jitter.stallUs = 15000; // Every wake-up lands after the period's deadline
+  DummyAudioDriver driver(options);
+  ASSERT_EQ(driver.initialize(tenMillisecondPeriods()), SessionGraphError::OK);
+  OverrunningCallback callback(OverrunningCallback::Mode::Nothing, {});
+  runFor(driver, callback, std::chrono::milliseconds(200));
+
+  auto timing = driver.getTiming();
+  ASSERT_GT(timing.lateCallbacks, 0u);
+  EXPECT_EQ(timing.preemptedCallbacks, timing.lateCallbacks);
+  EXPECT_EQ(timing.slowCallbacks, 0u);
+  EXPECT_EQ(callback.preempted(), timing.lateCallbacks);
+}
+
+TEST(DummyDriverDeadlineTest, FreewheelNeverUnderruns) {
+  DummyAudioDriver driver(freewheeling());
+  ASSERT_EQ(driver.initialize(blocksOf512()), SessionGraphError::OK);
+  auto monitor = createPerformanceMonitor(nullptr);
+  driver.setPerformanceMonitor(monitor.get());
+  OverrunningCallback callback(OverrunningCallback::Mode::Sleep, std::chrono::microseconds(1000));
+  ASSERT_EQ(driver.start(&callback), SessionGraphError::OK);
+  driver.advance(20 * 512);
+  driver.stop();
+
+  EXPECT_EQ(monitor->getMetrics().totalSamplesProcessed, 20u * 512);
+  EXPECT_EQ(monitor->getMetrics().bufferUnderrunCount, 0u);
+  EXPECT_EQ(callback.preempted() + callback.slow(), 0u);
+}
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/file_fingerprint.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+std::string sha256Hex(const std::string& message) {
+  Sha256 hasher;
+  hasher.update(message.data(), message.size());
+  return Sha256::toHex(hasher.finalize());
+}
+
+} // namespace
+
+// ============================================================================
+// Hash primitives
+// ============================================================================
+
+TEST(Sha256Test, KnownVectors) {
+  EXPECT_EQ(sha256Hex(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(sha256Hex("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(sha256Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(Sha256Test, MillionAInUnevenPieces) {
+  Sha256 hasher;
+  std::string piece(997, 'a'); // Not a multiple of the block size
+  size_t remaining = 1000000;
+  while (remaining > 0) {
+    size_t take = std::min(remaining, piece.size());
+    hasher.update(piece.data(), take);
+    remaining -= take;
+  }
+  EXPECT_EQ(Sha256::toHex(hasher.finalize()),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(XxHash64Test, KnownVectors) {
+  EXPECT_EQ(xxHash64("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(xxHash64("abc", 3), 0x44BC2CF5AD770999ULL);
+  EXPECT_NE(xxHash64("abc", 3, 1), xxHash64("abc", 3));
+}
+
+// ============================================================================
+// File fingerprints
+// ============================================================================
+
+class FileFingerprintTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_file_fingerprint_test";
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(m_dir);
+  }
+
+  std::string writeFile(const std::string& name, const std::vector<uint8_t>& contents) {
+    auto path = m_dir / name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(contents.data()),
+               static_cast<std::streamsize>(contents.size()));
+    return path.string();
+  }
+
+  static std::vector<uint8_t> pattern(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>((i * 31 + seed) ^ (i >> 9));
+    }
+    return data;
+  }
+
+  std::filesystem::path m_dir;
+};
+
+TEST_F(FileFingerprintTest, FileHashMatchesInMemoryHash) {
+  // One file below and one above the pipelined-read threshold
+  for (size_t size : {size_t{100000}, static_cast<size_t>(PARALLEL_HASH_THRESHOLD) + 12345}) {
+    auto data = pattern(size, 7);
+    auto path = writeFile("data.bin", data);
+
+    Sha256 hasher;
+    hasher.update(data.data(), data.size());
+    auto expected = Sha256::toHex(hasher.finalize());
+
+    auto hashed = sha256File(path);
+    ASSERT_TRUE(hashed.has_value());
+    EXPECT_EQ(*hashed, expected) << "size " << size;
+  }
+}
+
+TEST_F(FileFingerprintTest, MissingFileHasNoFingerprint) {
+  auto missing = (m_dir / "missing.bin").string();
+  EXPECT_FALSE(sha256File(missing).has_value());
+  EXPECT_FALSE(quickFingerprint(missing).has_value());
+  EXPECT_FALSE(computeFileFingerprint(missing).has_value());
+}
+
+TEST_F(FileFingerprintTest, QuickFingerprintTracksSampledContent) {
+  auto data = pattern(1024 * 1024, 3);
+  auto original = quickFingerprint(writeFile("a.bin", data));
+  ASSERT_TRUE(original.has_value());
+  EXPECT_EQ(quickFingerprint(writeFile("copy.bin", data)), original);
+
+  auto head = data;
+  head[10] ^= 0xff;
+  EXPECT_NE(quickFingerprint(writeFile("head.bin", head)), original);
+
+  auto middle = data;
+  middle[data.size() / 2] ^= 0xff;
+  EXPECT_NE(quickFingerprint(writeFile("middle.bin", middle)), original);
+
+  auto tail = data;
+  tail.back() ^= 0xff;
+  EXPECT_NE(quickFingerprint(writeFile("tail.bin", tail)), original);
+
+  auto longer = data;
+  longer.push_back(0);
+  EXPECT_NE(quickFingerprint(writeFile("longer.bin", longer)), original);
+}
+
+// ============================================================================
+// FingerprintIndex
+// ============================================================================
+
+TEST_F(FileFingerprintTest, IndexServesUnchangedFilesFromCache) {
+  auto path = writeFile("clip.wav", pattern(50000, 1));
+  FingerprintIndex index;
+
+  auto first = index.fingerprint(path);
+  auto second = index.fingerprint((m_dir / "." / "clip.wav").string());
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->sha256, second->sha256);
+  EXPECT_EQ(first->quick, second->quick);
+  EXPECT_EQ(first->size, 50000u);
+  EXPECT_EQ(index.misses(), 1u);
+  EXPECT_EQ(index.hits(), 1u);
+  EXPECT_EQ(index.size(), 1u);
+}
+
+TEST_F(FileFingerprintTest, IndexRehashesChangedFiles) {
+  auto path = writeFile("clip.wav", pattern(50000, 1));
+  FingerprintIndex index;
+  auto before = index.fingerprint(path);
+
+  writeFile("clip.wav", pattern(60000, 2));
+  auto after = index.fingerprint(path);
+  ASSERT_TRUE(after.has_value());
+  EXPECT_NE(before->sha256, after->sha256);
+  EXPECT_EQ(after->size, 60000u);
+  EXPECT_EQ(index.misses(), 2u);
+}
+
+TEST_F(FileFingerprintTest, IndexPersistsAcrossInstances) {
+  auto index_path = m_dir / "cache" / "fingerprints.tsv";
+  auto a = writeFile("a.wav", pattern(40000, 1));
+  auto b = writeFile("b.wav", pattern(40000, 2));
+
+  std::optional<FileFingerprint> expected;
+  {
+    FingerprintIndex index(index_path);
+    expected = index.fingerprint(a);
+    index.fingerprint(b);
+    EXPECT_EQ(index.misses(), 2u);
+  }
+  ASSERT_TRUE(std::filesystem::exists(index_path));
+
+  FingerprintIndex reopened(index_path);
+  auto cached = reopened.fingerprint(a);
+  reopened.fingerprint(b);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->sha256, expected->sha256);
+  EXPECT_EQ(cached->quick, expected->quick);
+  EXPECT_EQ(reopened.hits(), 2u);
+  EXPECT_EQ(reopened.misses(), 0u);
+}
+
+TEST_F(FileFingerprintTest, CorruptIndexIsIgnored) {
+  auto index_path = m_dir / "fingerprints.tsv";
+  std::ofstream(index_path) << "not an index\n";
+  auto path = writeFile("clip.wav", pattern(1000, 1));
+
+  FingerprintIndex index(index_path);
+  EXPECT_TRUE(index.fingerprint(path).has_value());
+  EXPECT_EQ(index.misses(), 1u);
+
+  FingerprintIndex reopened(index_path);
+  EXPECT_TRUE(reopened.fingerprint(path).has_value());
+  EXPECT_EQ(reopened.hits(), 1u);
+}
+
+TEST_F(FileFingerprintTest, LoadDropsMissingAndChangedFiles) {
+  auto index_path = m_dir / "fingerprints.tsv";
+  auto kept = writeFile("kept.wav", pattern(1000, 1));
+  auto deleted = writeFile("deleted.wav", pattern(1000, 2));
+  auto edited = writeFile("edited.wav", pattern(1000, 3));
+  {
+    FingerprintIndex index(index_path);
+    index.fingerprint(kept);
+    index.fingerprint(deleted);
+    index.fingerprint(edited);
+    EXPECT_EQ(index.size(), 3u);
+  }
+  std::filesystem::remove(deleted);
+  writeFile("edited.wav", pattern(2000, 4));
+
+  FingerprintIndex reopened(index_path);
+  EXPECT_TRUE(reopened.lookup(kept).has_value());
+  EXPECT_EQ(reopened.size(), 1u);
+
+  // The pruned entries are gone from the file too
+  std::ifstream file(index_path);
+  std::string line;
+  size_t lines = 0;
+  while (std::getline(file, line)) {
+    ++lines;
+  }
+  EXPECT_EQ(lines, 2u); // Header + kept.wav
+}
+
+TEST_F(FileFingerprintTest, LookupNeverHashes) {
+  auto path = writeFile("clip.wav", pattern(1000, 1));
+  FingerprintIndex index;
+  EXPECT_FALSE(index.lookup(path).has_value());
+  EXPECT_EQ(index.misses(), 0u);
+  EXPECT_EQ(index.size(), 0u);
+
+  auto computed = index.fingerprint(path);
+  auto cached = index.lookup(path);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->sha256, computed->sha256);
+
+  writeFile("clip.wav", pattern(1500, 2));
+  EXPECT_FALSE(index.lookup(path).has_value());
+}
+
+TEST_F(FileFingerprintTest, IndexPathCanBeMoved) {
+  auto path = writeFile("clip.wav", pattern(1000, 1));
+  auto first = m_dir / "first" / "fingerprints.tsv";
+  auto second = m_dir / "second" / "fingerprints.tsv";
+
+  FingerprintIndex index(first);
+  index.fingerprint(path);
+  index.setIndexPath(second);
+  EXPECT_EQ(index.indexPath(), second);
+  EXPECT_FALSE(index.lookup(path).has_value()); // Nothing indexed in the new file yet
+  index.fingerprint(path);
+  EXPECT_TRUE(std::filesystem::exists(first));
+  EXPECT_TRUE(std::filesystem::exists(second));
+
+  index.setIndexPath(first);
+  EXPECT_TRUE(index.lookup(path).has_value());
+}
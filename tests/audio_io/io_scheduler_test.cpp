@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/io_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orpheus;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Wait until a class has the given number of queued requests
+void waitForQueued(const IoScheduler& scheduler, IoClass io_class, size_t count) {
+  auto until = std::chrono::steady_clock::now() + 5s;
+  while (scheduler.stats()[io_class].queued != count) {
+    ASSERT_LT(std::chrono::steady_clock::now(), until) << "requests never queued";
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+IoSchedulerLimits singleSlot() {
+  IoSchedulerLimits limits;
+  limits.maxInFlight = 1;
+  limits.maxPerClass = {1, 1, 1};
+  return limits;
+}
+
+} // namespace
+
+// ============================================================================
+// Ordering
+// ============================================================================
+
+TEST(IoSchedulerTest, IssuesEarliestDeadlineFirst) {
+  IoScheduler scheduler(singleSlot());
+  auto blocker = scheduler.acquire(IoClass::Background);
+
+  // Queued in a shuffled order; deadlines far enough ahead to never expire
+  const auto base = IoScheduler::Clock::now() + 1h;
+  const int offsets[] = {3, 0, 4, 1, 2};
+  std::mutex mutex;
+  std::vector<int> order;
+  std::vector<std::thread> threads;
+  size_t queued = 0;
+  for (int offset : offsets) {
+    threads.emplace_back([&, offset] {
+      auto ticket = scheduler.acquire(IoClass::Playback, base + std::chrono::seconds(offset));
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(offset);
+    });
+    waitForQueued(scheduler, IoClass::Playback, ++queued);
+  }
+
+  blocker.release();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(IoSchedulerTest, BestEffortRequestsFollowDeadlinesInArrivalOrder) {
+  IoScheduler scheduler(singleSlot());
+  auto blocker = scheduler.acquire(IoClass::Background);
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  std::vector<std::thread> threads;
+  auto enqueue = [&](const std::string& name, IoClass io_class, size_t queued,
+                     IoScheduler::Clock::time_point deadline) {
+    threads.emplace_back([&, name, io_class, deadline] {
+      auto ticket = scheduler.acquire(io_class, deadline);
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(name);
+    });
+    waitForQueued(scheduler, io_class, queued);
+  };
+  enqueue("hash", IoClass::Background, 1, IoScheduler::BEST_EFFORT);
+  enqueue("pyramid", IoClass::Background, 2, IoScheduler::BEST_EFFORT);
+  enqueue("load", IoClass::Interactive, 1, IoScheduler::Clock::now() + 1h);
+  enqueue("voice", IoClass::Playback, 1, IoScheduler::Clock::now() + 1h - 1s);
+
+  blocker.release();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(order, (std::vector<std::string>{"voice", "load", "hash", "pyramid"}));
+}
+
+// ============================================================================
+// Concurrency caps
+// ============================================================================
+
+TEST(IoSchedulerTest, ClassCapsLeaveRoomForPlayback) {
+  IoScheduler scheduler; // 4 in flight: Playback 4, Interactive 2, Background 1
+  auto background = scheduler.acquire(IoClass::Background);
+  auto first = scheduler.acquire(IoClass::Interactive);
+  auto second = scheduler.acquire(IoClass::Interactive);
+
+  // Background and Interactive are at their caps: more of them wait...
+  std::thread waiting([&] { auto ticket = scheduler.acquire(IoClass::Background); });
+  waitForQueued(scheduler, IoClass::Background, 1);
+
+  // ...while playback is still issued at once
+  auto voice = scheduler.acquire(IoClass::Playback, IoScheduler::Clock::now() + 1s);
+  auto stats = scheduler.stats();
+  EXPECT_EQ(stats[IoClass::Playback].inFlight, 1u);
+  EXPECT_EQ(stats[IoClass::Interactive].inFlight, 2u);
+  EXPECT_EQ(stats[IoClass::Background].inFlight, 1u);
+  EXPECT_EQ(stats[IoClass::Background].queued, 1u);
+
+  background.release();
+  waiting.join();
+  EXPECT_EQ(scheduler.stats()[IoClass::Background].completed, 2u);
+}
+
+TEST(IoSchedulerTest, CappedClassDoesNotBlockLaterDeadlines) {
+  IoSchedulerLimits limits;
+  limits.maxInFlight = 2;
+  limits.maxPerClass = {2, 1, 1};
+  IoScheduler scheduler(limits);
+  auto background = scheduler.acquire(IoClass::Background);
+  auto voice = scheduler.acquire(IoClass::Playback, IoScheduler::Clock::now() + 1h);
+
+  // Both slots taken: an Interactive request with an earlier deadline queues first
+  std::thread interactive([&] {
+    auto ticket = scheduler.acquire(IoClass::Interactive, IoScheduler::Clock::now());
+  });
+  waitForQueued(scheduler, IoClass::Interactive, 1);
+  std::thread playback([&] {
+    auto ticket = scheduler.acquire(IoClass::Playback, IoScheduler::Clock::now() + 2h);
+  });
+  waitForQueued(scheduler, IoClass::Playback, 1);
+
+  // Freeing the playback slot admits the Interactive request (its class is below its cap)
+  voice.release();
+  interactive.join();
+  playback.join();
+  background.release();
+  EXPECT_EQ(scheduler.stats()[IoClass::Interactive].completed, 1u);
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+TEST(IoSchedulerTest, RecordsLatencyAndMissedDeadlines) {
+  IoScheduler scheduler;
+  {
+    auto late = scheduler.acquire(IoClass::Playback, IoScheduler::Clock::now() - 1ms);
+  }
+  {
+    auto on_time = scheduler.acquire(IoClass::Playback, IoScheduler::Clock::now() + 1h);
+    std::this_thread::sleep_for(2ms);
+  }
+  {
+    auto background = scheduler.acquire(IoClass::Background);
+  }
+
+  auto stats = scheduler.stats();
+  EXPECT_EQ(stats[IoClass::Playback].completed, 2u);
+  EXPECT_EQ(stats[IoClass::Playback].missedDeadlines, 1u);
+  EXPECT_EQ(stats[IoClass::Playback].latency.total(), 2u);
+  EXPECT_EQ(stats[IoClass::Playback].wait.total(), 2u);
+  EXPECT_GE(stats[IoClass::Playback].latency.percentileMs(1.0), 2.0);
+  EXPECT_EQ(stats[IoClass::Background].completed, 1u);
+  EXPECT_EQ(stats[IoClass::Background].missedDeadlines, 0u);
+  EXPECT_EQ(stats[IoClass::Interactive].completed, 0u);
+
+  scheduler.resetStats();
+  EXPECT_EQ(scheduler.stats()[IoClass::Playback].completed, 0u);
+  EXPECT_EQ(scheduler.stats()[IoClass::Playback].latency.total(), 0u);
+}
+
+TEST(IoSchedulerTest, HistogramPercentiles) {
+  IoLatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentileMs(0.5), 0.0);
+  histogram.counts[0] = 90; // < 2 µs
+  histogram.counts[10] = 9; // 1.024-2.048 ms
+  histogram.counts[20] = 1; // ~1-2 s
+  EXPECT_EQ(histogram.total(), 100u);
+  EXPECT_DOUBLE_EQ(histogram.percentileMs(0.5), 0.002);
+  EXPECT_DOUBLE_EQ(histogram.percentileMs(0.95), 2.048);
+  EXPECT_DOUBLE_EQ(histogram.percentileMs(1.0), 2097.152);
+}
+
+TEST(IoSchedulerTest, PlaybackDeadlineIsTimeToUnderrun) {
+  auto before = IoScheduler::Clock::now();
+  auto deadline = IoScheduler::playbackDeadline(4800, 48000);
+  EXPECT_GE(deadline - before, 100ms);
+  EXPECT_LT(deadline - before, 200ms);
+  auto underrun = IoScheduler::playbackDeadline(0, 48000); // Already empty: due now
+  EXPECT_LE(underrun, IoScheduler::Clock::now());
+}
+
+TEST(IoSchedulerTest, SharedSchedulerPublishesStats) {
+  auto before = getIoStats()[IoClass::Interactive].completed;
+  { auto ticket = sharedIoScheduler().acquire(IoClass::Interactive); }
+  EXPECT_EQ(getIoStats()[IoClass::Interactive].completed, before + 1);
+}
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/io_scheduler.h"
+#include "audio_io/loudness_meter.h"
+#include "audio_io/sample_source.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Append a sine to the given channels of interleaved frames (other channels silent)
+void appendSine(std::vector<float>& frames, uint16_t num_channels, std::vector<uint16_t> channels,
+                double frequency, double level_dbfs, double seconds, uint32_t sample_rate = 48000,
+                double phase = 0.0) {
+  const auto count = static_cast<size_t>(seconds * sample_rate);
+  const double amplitude = std::pow(10.0, level_dbfs / 20.0);
+  for (size_t i = 0; i < count; ++i) {
+    double t = static_cast<double>(i) / sample_rate;
+    auto value = static_cast<float>(amplitude * std::sin(2.0 * PI * frequency * t + phase));
+    size_t frame = frames.size();
+    frames.resize(frame + num_channels, 0.0f);
+    for (uint16_t ch : channels) {
+      frames[frame + ch] = value;
+    }
+  }
+}
+
+ClipLoudness measure(const std::vector<float>& frames, uint16_t num_channels,
+                     uint32_t sample_rate = 48000) {
+  LoudnessMeter meter(sample_rate, num_channels);
+  meter.process(frames.data(), frames.size() / num_channels);
+  return meter.result();
+}
+
+/// Decoder serving interleaved frames from memory (stands in for a file on disk)
+class MemoryReader : public IAudioFileReader {
+public:
+  MemoryReader(AudioFileMetadata metadata, const std::vector<float>& frames)
+      : m_metadata(metadata), m_frames(frames) {}
+
+  Result<AudioFileMetadata> open(const std::string&) override {
+    Result<AudioFileMetadata> result;
+    result.value = m_metadata;
+    result.error = SessionGraphError::OK;
+    m_open = true;
+    return result;
+  }
+  Result<size_t> readSamples(float* buffer, size_t num_samples) override {
+    const size_t channels = m_metadata.num_channels;
+    const size_t frames = std::min(num_samples, m_frames.size() / channels - m_position);
+    std::copy_n(m_frames.begin() + static_cast<std::ptrdiff_t>(m_position * channels),
+                frames * channels, buffer);
+    m_position += frames;
+    Result<size_t> result;
+    result.value = frames;
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+  SessionGraphError seek(int64_t sample_position) override {
+    m_position = static_cast<size_t>(sample_position);
+    return SessionGraphError::OK;
+  }
+  void close() override {
+    m_open = false;
+  }
+  int64_t getCurrentPosition() const override {
+    return static_cast<int64_t>(m_position);
+  }
+  bool isOpen() const override {
+    return m_open;
+  }
+
+private:
+  AudioFileMetadata m_metadata;
+  const std::vector<float>& m_frames;
+  size_t m_position = 0;
+  bool m_open = false;
+};
+
+} // namespace
+
+// ============================================================================
+// Integrated loudness (ITU-R BS.1770-4, EBU Tech 3341)
+// ============================================================================
+
+TEST(LoudnessMeterTest, StereoToneAtMinus23IsMinus23Lufs) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -23.0, 20.0);
+  auto loudness = measure(frames, 2);
+  EXPECT_NEAR(loudness.integratedLufs, -23.0, 0.1);
+  EXPECT_NEAR(loudness.loudnessRangeLu, 0.0, 0.1);
+  EXPECT_NEAR(loudness.samplePeakDbfs, -23.0, 0.01);
+}
+
+TEST(LoudnessMeterTest, FullScaleMonoToneIsMinus3Lkfs) {
+  std::vector<float> frames;
+  appendSine(frames, 1, {0}, 997.0, 0.0, 5.0);
+  EXPECT_NEAR(measure(frames, 1).integratedLufs, -3.01, 0.1);
+}
+
+TEST(LoudnessMeterTest, CoefficientsFollowTheSampleRate) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -23.0, 20.0, 44100);
+  EXPECT_NEAR(measure(frames, 2, 44100).integratedLufs, -23.0, 0.1);
+}
+
+TEST(LoudnessMeterTest, GatesExcludeSilence) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -20.0, 10.0);
+  appendSine(frames, 2, {}, 1000.0, 0.0, 10.0); // 10 s of silence
+  EXPECT_NEAR(measure(frames, 2).integratedLufs, -20.0, 0.1);
+
+  std::vector<float> silence(48000 * 2 * 3, 0.0f);
+  auto loudness = measure(silence, 2);
+  EXPECT_TRUE(std::isinf(loudness.integratedLufs) && loudness.integratedLufs < 0);
+  EXPECT_EQ(loudness.loudnessRangeLu, 0.0);
+  EXPECT_TRUE(std::isinf(loudness.samplePeakDbfs) && loudness.samplePeakDbfs < 0);
+}
+
+TEST(LoudnessMeterTest, SurroundChannelWeights) {
+  auto singleChannel = [](uint16_t channel) {
+    std::vector<float> frames;
+    appendSine(frames, 6, {channel}, 1000.0, -20.0, 5.0);
+    return measure(frames, 6).integratedLufs;
+  };
+  double left = singleChannel(0);
+  EXPECT_NEAR(singleChannel(2), left, 0.01);                           // C
+  EXPECT_TRUE(std::isinf(singleChannel(3)));                           // LFE
+  EXPECT_NEAR(singleChannel(4), left + 10.0 * std::log10(1.41), 0.01); // Ls
+}
+
+TEST(LoudnessMeterTest, ChunkingDoesNotChangeTheResult) {
+  std::vector<float> frames;
+  appendSine(frames, 3, {0, 1, 2}, 440.0, -12.0, 4.0);
+  appendSine(frames, 3, {1}, 5000.0, -30.0, 4.0);
+  auto whole = measure(frames, 3);
+
+  LoudnessMeter meter(48000, 3);
+  size_t total = frames.size() / 3;
+  for (size_t done = 0, chunk = 1; done < total; done += chunk, chunk = chunk * 3 + 7) {
+    chunk = std::min(chunk, total - done);
+    meter.process(frames.data() + done * 3, chunk);
+  }
+  auto chunked = meter.result();
+  EXPECT_NEAR(chunked.integratedLufs, whole.integratedLufs, 1e-4);
+  EXPECT_NEAR(chunked.loudnessRangeLu, whole.loudnessRangeLu, 1e-4);
+  EXPECT_EQ(chunked.samplePeakDbfs, whole.samplePeakDbfs);
+  EXPECT_EQ(chunked.truePeakDbtp, whole.truePeakDbtp);
+}
+
+// ============================================================================
+// Loudness range (EBU Tech 3342)
+// ============================================================================
+
+TEST(LoudnessMeterTest, RangeOfTwoLevelsIsTheirDifference) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -20.0, 20.0);
+  appendSine(frames, 2, {0, 1}, 1000.0, -30.0, 20.0);
+  EXPECT_NEAR(measure(frames, 2).loudnessRangeLu, 10.0, 1.0);
+}
+
+// ============================================================================
+// True peak
+// ============================================================================
+
+TEST(LoudnessMeterTest, TruePeakFindsPeaksBetweenSamples) {
+  // fs/4 sine at 45 degrees: every sample is at 0.707 of the waveform's peak
+  std::vector<float> frames;
+  appendSine(frames, 1, {0}, 12000.0, -6.0, 1.0, 48000, PI / 4.0);
+  auto loudness = measure(frames, 1);
+  EXPECT_NEAR(loudness.samplePeakDbfs, -9.01, 0.05);
+  EXPECT_NEAR(loudness.truePeakDbtp, -6.0, 0.2);
+}
+
+TEST(LoudnessMeterTest, TruePeakIsNeverBelowSamplePeak) {
+  std::vector<float> frames(48000, 0.0f);
+  frames[24000] = 0.9f; // Lone impulse: interpolated values all lower
+  auto loudness = measure(frames, 1);
+  EXPECT_NEAR(loudness.samplePeakDbfs, 20.0 * std::log10(0.9), 1e-4);
+  EXPECT_GE(loudness.truePeakDbtp, loudness.samplePeakDbfs);
+}
+
+// ============================================================================
+// Sources
+// ============================================================================
+
+TEST(LoudnessMeterTest, MeasuresSampleSources) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -18.0, 5.0);
+  AudioFileMetadata metadata{};
+  metadata.sample_rate = 48000;
+  metadata.num_channels = 2;
+  SampleSource source(metadata, frames);
+
+  std::atomic<bool> running{false};
+  auto loudness = measureLoudness(source, running);
+  ASSERT_TRUE(loudness.has_value());
+  EXPECT_NEAR(loudness->integratedLufs, -18.0, 0.1);
+
+  std::atomic<bool> cancelled{true};
+  EXPECT_FALSE(measureLoudness(source, cancelled).has_value());
+  EXPECT_FALSE(measureLoudness(SampleSource(metadata, std::vector<float>{}), running));
+}
+
+TEST(LoudnessMeterTest, StreamedSourcesAreReadAsBackgroundIo) {
+  std::vector<float> frames;
+  appendSine(frames, 2, {0, 1}, 1000.0, -18.0, 5.0);
+  AudioFileMetadata metadata{};
+  metadata.sample_rate = 48000;
+  metadata.num_channels = 2;
+  metadata.duration_samples = static_cast<int64_t>(frames.size() / 2);
+  std::vector<float> head(frames.begin(), frames.begin() + 4800 * 2);
+  SampleSource source(metadata, std::move(head), "streamed.wav",
+                      [&] { return std::make_unique<MemoryReader>(metadata, frames); });
+  ASSERT_FALSE(source.isResident());
+
+  const auto before = sharedIoScheduler().stats()[IoClass::Background].completed;
+  std::atomic<bool> running{false};
+  auto loudness = measureLoudness(source, running);
+  ASSERT_TRUE(loudness.has_value());
+  EXPECT_NEAR(loudness->integratedLufs, -18.0, 0.1);
+  EXPECT_EQ(sharedIoScheduler().stats()[IoClass::Background].completed - before, 6u); // 5 s + EOF
+}
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/pcm_decode.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+constexpr PcmSampleFormat ALL_FORMATS[] = {
+    PcmSampleFormat::Int16LE,   PcmSampleFormat::Int16BE, PcmSampleFormat::Int24LE,
+    PcmSampleFormat::Int24BE,   PcmSampleFormat::Int32LE, PcmSampleFormat::Int32BE,
+    PcmSampleFormat::Float32LE, PcmSampleFormat::Float32BE,
+};
+
+constexpr SimdLevel ALL_LEVELS[] = {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+
+/// Random bytes that decode to finite values for every format
+std::vector<uint8_t> randomPcm(PcmSampleFormat format, size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> bytes(count * pcmBytesPerSample(format));
+  if (format == PcmSampleFormat::Float32LE || format == PcmSampleFormat::Float32BE) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    bool big_endian = format == PcmSampleFormat::Float32BE;
+    for (size_t i = 0; i < count; ++i) {
+      float value = dist(rng);
+      uint8_t raw[4];
+      std::memcpy(raw, &value, 4); // Assumes little-endian host (x86/ARM)
+      for (size_t b = 0; b < 4; ++b) {
+        bytes[i * 4 + b] = big_endian ? raw[3 - b] : raw[b];
+      }
+    }
+  } else {
+    for (auto& byte : bytes) {
+      byte = static_cast<uint8_t>(rng());
+    }
+  }
+  return bytes;
+}
+
+// Little-endian / big-endian field writers for building test files
+void putLE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void putBE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+  for (size_t i = bytes; i > 0; --i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+  }
+}
+
+void putTag(std::vector<uint8_t>& out, const char* tag) {
+  out.insert(out.end(), tag, tag + 4);
+}
+
+} // namespace
+
+class PcmDecodeTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_pcm_decode_test";
+    std::filesystem::create_directories(m_dir);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(m_dir);
+  }
+
+  std::string writeFile(const std::string& name, const std::vector<uint8_t>& bytes) {
+    auto path = m_dir / name;
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    return path.string();
+  }
+
+  /// Minimal WAV: fmt (optionally extensible) + data with `frames` zeroed frames
+  static std::vector<uint8_t> makeWave(bool rifx, uint16_t tag, uint16_t channels, uint16_t bits,
+                                       uint32_t frames, bool extensible = false) {
+    auto put = rifx ? putBE : putLE;
+    uint32_t block_align = uint32_t{channels} * bits / 8u;
+    uint32_t data_size = frames * block_align;
+    uint32_t fmt_size = extensible ? 40u : 16u;
+
+    std::vector<uint8_t> out;
+    putTag(out, rifx ? "RIFX" : "RIFF");
+    put(out, 4 + 8 + fmt_size + 8 + 8 + data_size, 4);
+    putTag(out, "WAVE");
+    putTag(out, "LIST"); // Unknown chunk before fmt must be skipped
+    put(out, 3, 4);
+    out.insert(out.end(), {'a', 'b', 'c', 0}); // Odd size + pad byte
+    putTag(out, "fmt ");
+    put(out, fmt_size, 4);
+    put(out, extensible ? 0xFFFEu : tag, 2);
+    put(out, channels, 2);
+    put(out, 48000, 4);
+    put(out, 48000 * block_align, 4);
+    put(out, block_align, 2);
+    put(out, bits, 2);
+    if (extensible) {
+      put(out, 22, 2);   // cbSize
+      put(out, bits, 2); // Valid bits
+      put(out, 3, 4);    // Channel mask
+      put(out, tag, 2);  // Sub-format GUID starts with the format tag
+      out.insert(out.end(), 14, 0);
+    }
+    putTag(out, "data");
+    put(out, data_size, 4);
+    out.insert(out.end(), data_size, 0);
+    return out;
+  }
+
+  /// Minimal AIFF/AIFC with `frames` zeroed frames at 44.1 kHz
+  static std::vector<uint8_t> makeAiff(const char* compression, uint16_t channels, uint16_t bits,
+                                       uint32_t frames) {
+    bool aifc = compression != nullptr;
+    uint32_t data_size = frames * uint32_t{channels} * bits / 8u;
+    uint32_t comm_size = aifc ? 22u : 18u;
+
+    std::vector<uint8_t> out;
+    putTag(out, "FORM");
+    putBE(out, 4 + 8 + comm_size + 8 + 8 + data_size, 4);
+    putTag(out, aifc ? "AIFC" : "AIFF");
+    putTag(out, "COMM");
+    putBE(out, comm_size, 4);
+    putBE(out, channels, 2);
+    putBE(out, frames, 4);
+    putBE(out, bits, 2);
+    // 44100 as 80-bit extended: exponent 16383 + 15, mantissa 0xAC44 << 48
+    out.insert(out.end(), {0x40, 0x0E, 0xAC, 0x44, 0, 0, 0, 0, 0, 0});
+    if (aifc) {
+      putTag(out, compression);
+    }
+    putTag(out, "SSND");
+    putBE(out, 8 + data_size, 4);
+    putBE(out, 0, 4); // Offset
+    putBE(out, 0, 4); // Block size
+    out.insert(out.end(), data_size, 0);
+    return out;
+  }
+
+  std::filesystem::path m_dir;
+};
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+TEST_F(PcmDecodeTest, KnownValues) {
+  const uint8_t int16le[] = {0x00, 0x80, 0xFF, 0x7F, 0x00, 0x00};
+  const uint8_t int24be[] = {0x80, 0x00, 0x00, 0x40, 0x00, 0x00, 0xFF, 0xFF, 0xFF};
+  const uint8_t int32be[] = {0xC0, 0x00, 0x00, 0x00};
+  const uint8_t float32be[] = {0x3F, 0x00, 0x00, 0x00};
+  float out[3];
+
+  decodePcm(PcmSampleFormat::Int16LE, int16le, out, 3);
+  EXPECT_EQ(out[0], -1.0f);
+  EXPECT_EQ(out[1], 32767.0f / 32768.0f);
+  EXPECT_EQ(out[2], 0.0f);
+
+  decodePcm(PcmSampleFormat::Int24BE, int24be, out, 3);
+  EXPECT_EQ(out[0], -1.0f);
+  EXPECT_EQ(out[1], 0.5f);
+  EXPECT_EQ(out[2], -1.0f / 8388608.0f);
+
+  decodePcm(PcmSampleFormat::Int32BE, int32be, out, 1);
+  EXPECT_EQ(out[0], -0.5f);
+
+  decodePcm(PcmSampleFormat::Float32BE, float32be, out, 1);
+  EXPECT_EQ(out[0], 0.5f);
+}
+
+TEST_F(PcmDecodeTest, SimdKernelsMatchScalar) {
+  // Odd counts exercise the scalar tails, offsets exercise unaligned loads
+  for (auto format : ALL_FORMATS) {
+    auto reference = pcmDecodeKernel(format, SimdLevel::Scalar);
+    ASSERT_NE(reference, nullptr);
+
+    for (auto level : ALL_LEVELS) {
+      auto kernel = pcmDecodeKernel(format, level);
+      if (!kernel) {
+        continue; // Not built for this target / CPU
+      }
+      for (size_t count : {0u, 1u, 7u, 9u, 15u, 17u, 33u, 257u, 1001u}) {
+        for (size_t offset = 0; offset < 4; ++offset) {
+          auto bytes = randomPcm(format, count + 1, static_cast<uint32_t>(count * 4 + offset));
+          std::vector<float> expected(count + 1, 9.0f);
+          std::vector<float> actual(count + 1, 9.0f);
+          std::vector<uint8_t> shifted(offset + bytes.size());
+          std::memcpy(shifted.data() + offset, bytes.data(), bytes.size());
+          const uint8_t* src = shifted.data() + offset;
+
+          reference(src, expected.data(), count);
+          kernel(src, actual.data(), count);
+          ASSERT_EQ(expected, actual)
+              << pcmFormatName(format) << " " << simdLevelName(level) << " count=" << count;
+          EXPECT_EQ(actual[count], 9.0f) << "wrote past end";
+        }
+      }
+    }
+  }
+}
+
+TEST_F(PcmDecodeTest, DispatchSelectsDetectedLevel) {
+  SimdLevel level = detectSimdLevel();
+  for (auto format : ALL_FORMATS) {
+    EXPECT_EQ(pcmDecodeKernel(format), pcmDecodeKernel(format, level)) << simdLevelName(level);
+  }
+}
+
+// ============================================================================
+// File layout probing
+// ============================================================================
+
+TEST_F(PcmDecodeTest, ProbesWave) {
+  auto layout = probePcmFileLayout(writeFile("a.wav", makeWave(false, 1, 2, 16, 100)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Int16LE);
+  EXPECT_EQ(layout->num_channels, 2);
+  EXPECT_EQ(layout->sample_rate, 48000u);
+  EXPECT_EQ(layout->num_frames, 100);
+  EXPECT_EQ(layout->data_offset, 12u + 12u + 8u + 16u + 8u);
+
+  layout = probePcmFileLayout(writeFile("b.wav", makeWave(false, 3, 1, 32, 10)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Float32LE);
+
+  layout = probePcmFileLayout(writeFile("c.wav", makeWave(false, 1, 2, 24, 10, true)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Int24LE);
+  EXPECT_EQ(layout->num_frames, 10);
+
+  layout = probePcmFileLayout(writeFile("d.wav", makeWave(true, 1, 1, 32, 10)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Int32BE);
+}
+
+TEST_F(PcmDecodeTest, ProbesAiff) {
+  auto layout = probePcmFileLayout(writeFile("a.aif", makeAiff(nullptr, 2, 24, 50)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Int24BE);
+  EXPECT_EQ(layout->num_channels, 2);
+  EXPECT_EQ(layout->sample_rate, 44100u);
+  EXPECT_EQ(layout->num_frames, 50);
+
+  layout = probePcmFileLayout(writeFile("b.aif", makeAiff("sowt", 2, 16, 50)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Int16LE);
+
+  layout = probePcmFileLayout(writeFile("c.aif", makeAiff("fl32", 1, 32, 50)));
+  ASSERT_TRUE(layout.has_value());
+  EXPECT_EQ(layout->format, PcmSampleFormat::Float32BE);
+}
+
+TEST_F(PcmDecodeTest, UnsupportedFilesUseGenericDecoder) {
+  EXPECT_FALSE(probePcmFileLayout(writeFile("u8.wav", makeWave(false, 1, 1, 8, 10))));
+  EXPECT_FALSE(probePcmFileLayout(writeFile("alaw.wav", makeWave(false, 6, 1, 16, 10))));
+  EXPECT_FALSE(probePcmFileLayout(writeFile("ima4.aif", makeAiff("ima4", 1, 16, 10))));
+  EXPECT_FALSE(probePcmFileLayout(writeFile("text.wav", {'h', 'e', 'l', 'l', 'o'})));
+  EXPECT_FALSE(probePcmFileLayout((m_dir / "missing.wav").string()));
+}
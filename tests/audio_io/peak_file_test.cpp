@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/file_fingerprint.h"
+#include "audio_io/peak_file.h"
+#include "audio_io/waveform_pyramid.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace orpheus;
+
+class PeakFileTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_peak_file_test";
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+
+    // Stand-in audio file: only its fingerprint matters to the peak file
+    m_audio = (m_dir / "take.wav").string();
+    std::ofstream(m_audio) << "take one";
+    m_source = *computeFileFingerprint(m_audio);
+
+    // Stereo: L = 0.8 * sine, R = slow ramp
+    m_pyramid = std::make_unique<WaveformPyramid>(2);
+    std::vector<float> samples(FRAMES * 2);
+    for (size_t i = 0; i < FRAMES; ++i) {
+      samples[i * 2] = 0.8f * static_cast<float>(std::sin(static_cast<double>(i) * 0.01));
+      samples[i * 2 + 1] = static_cast<float>(i) / FRAMES - 0.5f;
+    }
+    m_pyramid->append(samples.data(), FRAMES);
+    m_pyramid->finish();
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(m_dir);
+  }
+
+  static constexpr size_t FRAMES = 100000;
+
+  std::filesystem::path m_dir;
+  std::string m_audio;
+  FileFingerprint m_source;
+  std::unique_ptr<WaveformPyramid> m_pyramid;
+};
+
+TEST_F(PeakFileTest, PathBesideAudioOrInCacheDirectory) {
+  EXPECT_EQ(PeakFile::pathFor(m_audio, m_source), std::filesystem::path(m_audio + ".orppeaks"));
+  EXPECT_EQ(PeakFile::pathFor(m_audio, m_source, m_dir / "peaks"),
+            m_dir / "peaks" / (m_source.sha256 + ".orppeaks"));
+}
+
+TEST_F(PeakFileTest, RoundTripMatchesPyramid) {
+  auto path = PeakFile::pathFor(m_audio, m_source, m_dir / "peaks");
+  ASSERT_TRUE(PeakFile::write(path, *m_pyramid, m_source, 48000));
+
+  auto peaks = PeakFile::open(path, m_source);
+  ASSERT_NE(peaks, nullptr);
+  EXPECT_EQ(peaks->numChannels(), 2);
+  EXPECT_EQ(peaks->numFrames(), static_cast<int64_t>(FRAMES));
+  EXPECT_EQ(peaks->sampleRate(), 48000u);
+  EXPECT_EQ(peaks->mappedBytes(), std::filesystem::file_size(path));
+  EXPECT_FLOAT_EQ(peaks->peakLevel(1), m_pyramid->peakLevel(1)); // Stored exactly
+  EXPECT_EQ(peaks->peakLevel(2), 0.0f);
+
+  // int16 quantisation rounds outward: the envelope never shrinks
+  const float step = 1.0f / 32767.0f;
+  for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+    ASSERT_EQ(peaks->numBuckets(level), m_pyramid->numBuckets(level));
+    for (size_t b = 0; b < peaks->numBuckets(level); ++b) {
+      for (uint32_t ch = 0; ch < 2; ++ch) {
+        auto stored = peaks->bucket(level, b, ch);
+        const auto& exact = m_pyramid->bucket(level, b, ch);
+        EXPECT_LE(stored.min, exact.min);
+        EXPECT_GE(stored.max, exact.max);
+        EXPECT_NEAR(stored.min, exact.min, step);
+        EXPECT_NEAR(stored.max, exact.max, step);
+        EXPECT_NEAR(stored.rms, exact.rms, step);
+      }
+    }
+  }
+}
+
+TEST_F(PeakFileTest, QueryMatchesPyramidQuery) {
+  auto path = m_dir / "take.orppeaks";
+  ASSERT_TRUE(PeakFile::write(path, *m_pyramid, m_source, 48000));
+  auto peaks = PeakFile::open(path, m_source);
+  ASSERT_NE(peaks, nullptr);
+
+  auto expected = m_pyramid->query(1234, 98765, 321, 0);
+  auto actual = peaks->query(1234, 98765, 321, 0);
+  ASSERT_TRUE(actual.isValid());
+  ASSERT_EQ(actual.rms.size(), 321u);
+  for (size_t p = 0; p < 321; ++p) {
+    EXPECT_NEAR(actual.minPeaks[p], expected.minPeaks[p], 1e-4f) << "pixel " << p;
+    EXPECT_NEAR(actual.maxPeaks[p], expected.maxPeaks[p], 1e-4f) << "pixel " << p;
+    EXPECT_NEAR(actual.rms[p], expected.rms[p], 1e-4f) << "pixel " << p;
+  }
+  EXPECT_FALSE(peaks->query(0, 100, 10, 2).isValid());
+}
+
+TEST_F(PeakFileTest, StaleFingerprintIsRejected) {
+  auto path = m_dir / "take.orppeaks";
+  ASSERT_TRUE(PeakFile::write(path, *m_pyramid, m_source, 48000));
+
+  std::ofstream(m_audio) << "take two"; // Same size, different content
+  auto edited = *computeFileFingerprint(m_audio);
+  EXPECT_EQ(PeakFile::open(path, edited), nullptr);
+  EXPECT_NE(PeakFile::open(path, m_source), nullptr);
+}
+
+TEST_F(PeakFileTest, CorruptFilesAreRejected) {
+  auto path = m_dir / "take.orppeaks";
+  EXPECT_EQ(PeakFile::open(path, m_source), nullptr); // Missing
+  ASSERT_TRUE(PeakFile::write(path, *m_pyramid, m_source, 48000));
+  auto size = std::filesystem::file_size(path);
+
+  std::filesystem::resize_file(path, size - 100); // Truncated
+  EXPECT_EQ(PeakFile::open(path, m_source), nullptr);
+
+  ASSERT_TRUE(PeakFile::write(path, *m_pyramid, m_source, 48000));
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(8);
+    uint32_t version = PeakFile::FORMAT_VERSION + 1;
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  }
+  EXPECT_EQ(PeakFile::open(path, m_source), nullptr); // Future format version
+}
+
+TEST_F(PeakFileTest, UnfinishedPyramidIsNotWritten) {
+  WaveformPyramid building(1);
+  float samples[100] = {};
+  building.append(samples, 100);
+  EXPECT_FALSE(PeakFile::write(m_dir / "partial.orppeaks", building, m_source, 48000));
+  EXPECT_FALSE(std::filesystem::exists(m_dir / "partial.orppeaks"));
+}
@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/sample_source.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Decoder producing a stereo ramp (L = frame, R = -frame) without touching the file
+class RampReader : public IAudioFileReader {
+public:
+  RampReader(int64_t frames, std::atomic<int>& opens) : m_frames(frames), m_opens(opens) {}
+
+  Result<AudioFileMetadata> open(const std::string&) override {
+    ++m_opens;
+    Result<AudioFileMetadata> result;
+    result.value.format = AudioFileFormat::WAV;
+    result.value.sample_rate = 48000;
+    result.value.num_channels = 2;
+    result.value.duration_samples = m_frames;
+    result.value.bit_depth = 24;
+    result.error = SessionGraphError::OK;
+    m_open = true;
+    return result;
+  }
+
+  Result<size_t> readSamples(float* buffer, size_t num_samples) override {
+    Result<size_t> result;
+    size_t frames = std::min(num_samples, static_cast<size_t>(m_frames - m_position));
+    for (size_t i = 0; i < frames; ++i) {
+      buffer[i * 2] = static_cast<float>(m_position);
+      buffer[i * 2 + 1] = -static_cast<float>(m_position);
+      ++m_position;
+    }
+    result.value = frames;
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+
+  SessionGraphError seek(int64_t sample_position) override {
+    m_position = sample_position;
+    return SessionGraphError::OK;
+  }
+  void close() override {
+    m_open = false;
+  }
+  int64_t getCurrentPosition() const override {
+    return m_position;
+  }
+  bool isOpen() const override {
+    return m_open;
+  }
+
+private:
+  int64_t m_frames;
+  int64_t m_position = 0;
+  bool m_open = false;
+  std::atomic<int>& m_opens; // Streams open readers on the streamer thread
+};
+
+} // namespace
+
+class SampleSourceTest : public ::testing::Test {
+protected:
+  static constexpr int64_t FRAMES = 40000; // Spans several decode chunks
+
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_sample_source_test";
+    std::filesystem::create_directories(m_dir);
+    m_fileA = writeFile("a.wav", "A");
+    m_fileB = writeFile("b.wav", "B");
+    m_cache = std::make_unique<SampleSourceCache>(
+        [this] { return std::make_unique<RampReader>(FRAMES, m_opens); });
+  }
+
+  void TearDown() override {
+    m_cache.reset();
+    std::filesystem::remove_all(m_dir);
+  }
+
+  std::string writeFile(const std::string& name, const std::string& contents) {
+    auto path = m_dir / name;
+    std::ofstream(path) << contents;
+    return path.string();
+  }
+
+  std::filesystem::path m_dir;
+  std::string m_fileA;
+  std::string m_fileB;
+  std::atomic<int> m_opens{0};
+  std::unique_ptr<SampleSourceCache> m_cache;
+};
+
+// ============================================================================
+// Deduplication
+// ============================================================================
+
+TEST_F(SampleSourceTest, DecodesWholeFile) {
+  auto result = m_cache->acquire(m_fileA);
+  ASSERT_TRUE(result.isOk());
+  EXPECT_EQ(result.value->numFrames(), FRAMES);
+  EXPECT_EQ(result.value->numChannels(), 2);
+  EXPECT_EQ(result.value->metadata().duration_samples, FRAMES);
+  EXPECT_EQ(result.value->metadata().sample_rate, 48000u);
+}
+
+TEST_F(SampleSourceTest, SameFileDecodedOnce) {
+  auto first = m_cache->acquire(m_fileA);
+  auto second = m_cache->acquire(m_fileA);
+  ASSERT_TRUE(first.isOk());
+  ASSERT_TRUE(second.isOk());
+  EXPECT_EQ(first.value, second.value);
+  EXPECT_EQ(m_opens.load(), 1);
+
+  // Same file through a different spelling of the path
+  auto third = m_cache->acquire((m_dir / "." / "a.wav").string());
+  EXPECT_EQ(third.value, first.value);
+  EXPECT_EQ(m_opens.load(), 1);
+}
+
+TEST_F(SampleSourceTest, DifferentFilesDecodedSeparately) {
+  auto a = m_cache->acquire(m_fileA);
+  auto b = m_cache->acquire(m_fileB);
+  EXPECT_NE(a.value, b.value);
+  EXPECT_EQ(m_opens.load(), 2);
+  EXPECT_EQ(m_cache->size(), 2u);
+}
+
+TEST_F(SampleSourceTest, ChangedFileIsDecodedAgain) {
+  auto before = m_cache->acquire(m_fileA);
+  writeFile("a.wav", "A longer file");
+  auto after = m_cache->acquire(m_fileA);
+  EXPECT_NE(before.value, after.value);
+  EXPECT_EQ(m_opens.load(), 2);
+}
+
+TEST_F(SampleSourceTest, ReleasedSourceIsFreedByCollect) {
+  auto result = m_cache->acquire(m_fileA);
+  std::weak_ptr<const SampleSource> weak = result.value;
+  EXPECT_EQ(m_cache->size(), 1u);
+  EXPECT_EQ(m_cache->collect(), 0u); // Still in use
+
+  // Dropping the last outside reference (e.g. a voice on the audio thread) frees nothing
+  result.value.reset();
+  EXPECT_FALSE(weak.expired());
+  EXPECT_EQ(m_cache->size(), 1u);
+
+  EXPECT_EQ(m_cache->collect(), 1u);
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(m_cache->size(), 0u);
+}
+
+TEST_F(SampleSourceTest, NoDecoderReportsNotReady) {
+  SampleSourceCache cache([] { return std::unique_ptr<IAudioFileReader>(); });
+  auto result = cache.acquire(m_fileA);
+  EXPECT_EQ(result.error, SessionGraphError::NotReady);
+}
+
+// ============================================================================
+// Cursors
+// ============================================================================
+
+TEST_F(SampleSourceTest, CursorsReadIndependently) {
+  auto source = m_cache->acquire(m_fileA).value;
+  SampleCursor voice1(source);
+  SampleCursor voice2(source);
+  std::vector<float> buffer(64 * 2);
+
+  voice1.seek(1000);
+  ASSERT_EQ(voice1.read(buffer.data(), 64), 64u);
+  EXPECT_EQ(buffer[0], 1000.0f);
+  EXPECT_EQ(buffer[1], -1000.0f);
+
+  // Second voice starts from its own position, unaffected by the first
+  ASSERT_EQ(voice2.read(buffer.data(), 64), 64u);
+  EXPECT_EQ(buffer[0], 0.0f);
+
+  ASSERT_EQ(voice1.read(buffer.data(), 64), 64u);
+  EXPECT_EQ(buffer[0], 1064.0f);
+  EXPECT_EQ(voice1.position(), 1128);
+  EXPECT_EQ(voice2.position(), 64);
+}
+
+TEST_F(SampleSourceTest, CursorStopsAtEndAndClampsSeek) {
+  auto source = m_cache->acquire(m_fileA).value;
+  SampleCursor cursor(source);
+  std::vector<float> buffer(64 * 2);
+
+  cursor.seek(FRAMES - 10);
+  EXPECT_EQ(cursor.read(buffer.data(), 64), 10u);
+  EXPECT_EQ(buffer[9 * 2], static_cast<float>(FRAMES - 1));
+  EXPECT_EQ(cursor.read(buffer.data(), 64), 0u);
+
+  cursor.seek(FRAMES + 100);
+  EXPECT_EQ(cursor.position(), FRAMES);
+  cursor.seek(-5);
+  EXPECT_EQ(cursor.position(), 0);
+}
+
+TEST_F(SampleSourceTest, EmptyCursorReadsNothing) {
+  SampleCursor cursor;
+  std::vector<float> buffer(16);
+  EXPECT_FALSE(cursor.isOpen());
+  EXPECT_EQ(cursor.read(buffer.data(), 8), 0u);
+  cursor.seek(100);
+  EXPECT_EQ(cursor.position(), 0);
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+namespace {
+
+/// Read `frames` frames through a cursor, waiting out read-ahead that has not landed yet
+std::vector<float> readStreamed(SampleCursor& cursor, size_t frames) {
+  std::vector<float> result(frames * 2);
+  size_t done = 0;
+  const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+  while (done < frames && std::chrono::steady_clock::now() < give_up) {
+    size_t block = std::min<size_t>(512, frames - done);
+    size_t got = cursor.read(result.data() + done * 2, block);
+    done += got;
+    if (got < block) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  result.resize(done * 2);
+  return result;
+}
+
+} // namespace
+
+class SampleStreamingTest : public SampleSourceTest {
+protected:
+  static constexpr int64_t LONG_FRAMES = 300000; // 2.4 MB decoded, several ring laps
+
+  void SetUp() override {
+    SampleSourceTest::SetUp();
+    m_cache = std::make_unique<SampleSourceCache>(
+        [this] { return std::make_unique<RampReader>(LONG_FRAMES, m_opens); });
+    m_cache->setResidentLimitBytes(size_t{1} << 20);
+  }
+};
+
+TEST_F(SampleStreamingTest, FileBeyondBudgetKeepsOnlyItsHead) {
+  auto source = m_cache->acquire(m_fileA).value;
+  ASSERT_TRUE(source);
+  EXPECT_FALSE(source->isResident());
+  EXPECT_EQ(source->numFrames(), LONG_FRAMES);
+  EXPECT_EQ(source->residentFrames(), SampleSource::STREAM_HEAD_FRAMES);
+  EXPECT_EQ(source->streamer(), &sharedSampleStreamer()); // Started here, not by a voice
+  EXPECT_EQ(m_cache->residentBytes(),
+            static_cast<size_t>(SampleSource::STREAM_HEAD_FRAMES) * 2 * sizeof(float));
+
+  // A file that fits in what is left is decoded whole
+  SampleSourceCache small([this] { return std::make_unique<RampReader>(FRAMES, m_opens); });
+  small.setResidentLimitBytes(size_t{1} << 20);
+  auto resident = small.acquire(m_fileB).value;
+  EXPECT_TRUE(resident->isResident());
+  EXPECT_EQ(resident->streamer(), nullptr);
+}
+
+TEST_F(SampleStreamingTest, ConcurrentAcquiresShareTheBudget) {
+  // Each file fits the budget on its own but only two fit together; every
+  // decoder waits in open() until all four have opened, so all four decide
+  // whether to stream at the same time
+  constexpr int FILES = 4;
+  class GatedReader : public RampReader {
+  public:
+    GatedReader(std::atomic<int>& opens, std::atomic<int>& gate)
+        : RampReader(100000, opens), m_gate(gate) {}
+    Result<AudioFileMetadata> open(const std::string& path) override {
+      ++m_gate;
+      const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (m_gate.load() < FILES && std::chrono::steady_clock::now() < give_up) {
+        std::this_thread::yield();
+      }
+      return RampReader::open(path);
+    }
+
+  private:
+    std::atomic<int>& m_gate;
+  };
+  std::atomic<int> gate{0};
+  SampleSourceCache cache([&] { return std::make_unique<GatedReader>(m_opens, gate); });
+  cache.setResidentLimitBytes(size_t{2} << 20); // 800 KB per file decoded
+
+  std::vector<std::shared_ptr<const SampleSource>> sources(FILES);
+  std::vector<std::thread> loaders;
+  for (int i = 0; i < FILES; ++i) {
+    auto path = writeFile("shared" + std::to_string(i) + ".wav", std::to_string(i));
+    loaders.emplace_back([&, i, path] { sources[i] = cache.acquire(path).value; });
+  }
+  for (auto& loader : loaders) {
+    loader.join();
+  }
+
+  int resident = 0;
+  for (const auto& source : sources) {
+    ASSERT_TRUE(source);
+    resident += source->isResident() ? 1 : 0;
+  }
+  EXPECT_EQ(resident, 2); // The other two stream, holding only their heads
+  EXPECT_EQ(cache.residentBytes(),
+            (2 * 100000 + 2 * static_cast<size_t>(SampleSource::STREAM_HEAD_FRAMES)) * 2 *
+                sizeof(float));
+}
+
+TEST_F(SampleStreamingTest, CursorsStreamIndependently) {
+  auto source = m_cache->acquire(m_fileA).value;
+  SampleCursor voice1(source);
+  SampleCursor voice2(source);
+  voice2.seek(200000); // Beyond the head: waits for its first refill
+
+  auto first = readStreamed(voice1, LONG_FRAMES);
+  auto second = readStreamed(voice2, LONG_FRAMES - 200000);
+  ASSERT_EQ(first.size(), static_cast<size_t>(LONG_FRAMES) * 2);
+  ASSERT_EQ(second.size(), static_cast<size_t>(LONG_FRAMES - 200000) * 2);
+  for (int64_t frame = 0; frame < LONG_FRAMES; ++frame) {
+    ASSERT_EQ(first[static_cast<size_t>(frame) * 2], static_cast<float>(frame)) << frame;
+  }
+  for (int64_t frame = 200000; frame < LONG_FRAMES; ++frame) {
+    ASSERT_EQ(second[static_cast<size_t>(frame - 200000) * 2], static_cast<float>(frame)) << frame;
+  }
+  EXPECT_EQ(voice1.read(first.data(), 64), 0u); // End of file
+  EXPECT_EQ(m_opens.load(), 3);                 // Head decode + one reader per voice
+}
+
+TEST_F(SampleStreamingTest, PcmFilesStreamThroughBlockReads) {
+  // 16-bit stereo WAV of the decoder's length whose left channel counts frames modulo 30000
+  std::vector<char> wave;
+  auto put = [&wave](uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+      wave.push_back(static_cast<char>(value >> (8 * i)));
+    }
+  };
+  const auto frames = static_cast<uint32_t>(LONG_FRAMES);
+  wave.insert(wave.end(), {'R', 'I', 'F', 'F'});
+  put(36 + frames * 4, 4);
+  wave.insert(wave.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+  put(16, 4);
+  put(1, 2); // PCM
+  put(2, 2);
+  put(48000, 4);
+  put(48000 * 4, 4);
+  put(4, 2);
+  put(16, 2);
+  wave.insert(wave.end(), {'d', 'a', 't', 'a'});
+  put(frames * 4, 4);
+  for (uint32_t i = 0; i < frames; ++i) {
+    const auto value = static_cast<uint16_t>(i % 30000);
+    put(value, 2);
+    put(static_cast<uint16_t>(-value), 2);
+  }
+  const auto path = (m_dir / "pcm.wav").string();
+  std::ofstream(path, std::ios::binary).write(wave.data(), static_cast<std::streamsize>(wave.size()));
+
+  auto source = m_cache->acquire(path).value;
+  ASSERT_FALSE(source->isResident());
+  SampleCursor cursor(source);
+  cursor.seek(SampleSource::STREAM_HEAD_FRAMES);
+  auto streamed = readStreamed(cursor, LONG_FRAMES - SampleSource::STREAM_HEAD_FRAMES);
+  ASSERT_EQ(streamed.size(), static_cast<size_t>(LONG_FRAMES - SampleSource::STREAM_HEAD_FRAMES) * 2);
+  for (int64_t frame = SampleSource::STREAM_HEAD_FRAMES; frame < LONG_FRAMES; ++frame) {
+    const float value = static_cast<float>(frame % 30000) / 32768.0f;
+    ASSERT_EQ(streamed[static_cast<size_t>(frame - SampleSource::STREAM_HEAD_FRAMES) * 2], value)
+        << frame;
+  }
+  EXPECT_EQ(m_opens.load(), 1); // Head decode only: the file itself was streamed
+}
+
+TEST_F(SampleStreamingTest, SeekBackIntoHeadRestartsReadAhead) {
+  auto source = m_cache->acquire(m_fileA).value;
+  SampleCursor cursor(source);
+  auto played = readStreamed(cursor, 100000);
+  ASSERT_EQ(played.size(), 100000u * 2);
+
+  cursor.seek(1000); // e.g. a loop back to the IN point
+  auto looped = readStreamed(cursor, 100000);
+  ASSERT_EQ(looped.size(), 100000u * 2);
+  for (size_t i = 0; i < 100000; ++i) {
+    ASSERT_EQ(looped[i * 2], static_cast<float>(1000 + i)) << i;
+  }
+}
+
+TEST_F(SampleStreamingTest, ClosedStreamsAreReturned) {
+  auto& streamer = sharedSampleStreamer();
+  auto wait_for = [&](size_t active) {
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (streamer.activeStreams() != active && std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return streamer.activeStreams();
+  };
+  const size_t baseline = wait_for(0);
+
+  auto source = m_cache->acquire(m_fileA).value;
+  std::weak_ptr<const SampleSource> weak = source;
+  SampleCursor cursor(source);
+  cursor.seek(0);
+  EXPECT_EQ(streamer.activeStreams(), baseline + 1);
+
+  // Moving hands the stream over; closing gives it back to the streamer thread
+  SampleCursor moved(std::move(cursor));
+  EXPECT_FALSE(cursor.isOpen());
+  moved.close();
+  EXPECT_EQ(wait_for(baseline), baseline);
+
+  source.reset();
+  EXPECT_EQ(m_cache->collect(), 1u);
+  EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/sample_source.h"
+#include "audio_io/silence_map.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Stereo frames: silent except for the listed frames, set to `level` on the right channel
+std::vector<float> makeFrames(size_t frames, const std::vector<size_t>& loud, float level) {
+  std::vector<float> samples(frames * 2, 0.0f);
+  for (size_t frame : loud) {
+    samples[frame * 2 + 1] = level;
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(SilenceMapTest, MarksBlocksWithoutSoundAsSilent) {
+  // Blocks of 256 frames; the last one is partial
+  auto samples = makeFrames(1000, {300, 999}, 0.25f);
+  SilenceMap map(samples.data(), 1000, 2);
+
+  ASSERT_EQ(map.numBlocks(), 4u);
+  EXPECT_TRUE(map.isBlockSilent(0));
+  EXPECT_FALSE(map.isBlockSilent(1)); // Frame 300
+  EXPECT_TRUE(map.isBlockSilent(2));
+  EXPECT_FALSE(map.isBlockSilent(3)); // Frame 999
+  EXPECT_FALSE(map.isBlockSilent(4)); // Past the end
+  EXPECT_EQ(map.numSilentBlocks(), 2u);
+}
+
+TEST(SilenceMapTest, ThresholdIsMinus120dBFS) {
+  auto quiet = makeFrames(256, {10}, 0.9e-6f);
+  auto audible = makeFrames(256, {10}, -2e-6f);
+  EXPECT_TRUE(SilenceMap(quiet.data(), 256, 2).isBlockSilent(0));
+  EXPECT_FALSE(SilenceMap(audible.data(), 256, 2).isBlockSilent(0));
+  EXPECT_TRUE(SilenceMap(audible.data(), 256, 2, 1e-5f).isBlockSilent(0));
+}
+
+TEST(SilenceMapTest, RangeQueriesNeedEveryBlockSilent) {
+  // 200 blocks, all silent except block 130 (crosses a 64-block word boundary)
+  auto samples = makeFrames(200 * 256, {130 * 256 + 7}, 0.5f);
+  SilenceMap map(samples.data(), 200 * 256, 2);
+
+  EXPECT_TRUE(map.isSilent(0, 512));
+  EXPECT_TRUE(map.isSilent(100, 1));
+  EXPECT_TRUE(map.isSilent(0, 130 * 256));       // Blocks 0-129, three words
+  EXPECT_FALSE(map.isSilent(0, 130 * 256 + 1));  // Reaches block 130
+  EXPECT_FALSE(map.isSilent(130 * 256 + 200, 10));
+  EXPECT_TRUE(map.isSilent(131 * 256, 69 * 256)); // To the end
+  EXPECT_FALSE(map.isSilent(131 * 256, 69 * 256 + 1)); // Past the end
+  EXPECT_FALSE(map.isSilent(0, 0));
+  EXPECT_FALSE(map.isSilent(-1, 10));
+}
+
+TEST(SilenceMapTest, EmptyMapIsNeverSilent) {
+  SilenceMap empty;
+  EXPECT_EQ(empty.numBlocks(), 0u);
+  EXPECT_FALSE(empty.isSilent(0, 1));
+}
+
+TEST(SilenceMapTest, SampleSourceBuildsItsMap) {
+  AudioFileMetadata metadata;
+  metadata.format = AudioFileFormat::WAV;
+  metadata.sample_rate = 48000;
+  metadata.num_channels = 2;
+  metadata.bit_depth = 24;
+  SampleSource source(metadata, makeFrames(2048, {1500}, 0.1f));
+  EXPECT_EQ(source.silence().numBlocks(), 8u);
+  EXPECT_TRUE(source.silence().isSilent(0, 1280));
+  EXPECT_FALSE(source.silence().isSilent(1280, 256));
+}
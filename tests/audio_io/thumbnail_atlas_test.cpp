@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/thumbnail_atlas.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Sample value of the synthetic test files (L = sine, R = half-scale inverted sine)
+float toneSample(int64_t frame, uint16_t channel) {
+  float value = static_cast<float>(std::sin(static_cast<double>(frame) * 0.01));
+  return channel == 0 ? value : -0.5f * value;
+}
+
+/// Decoder for synthetic stereo files named by length ("tone<frames>"); other paths fail
+class ToneReader : public IAudioFileReader {
+public:
+  explicit ToneReader(std::atomic<int64_t>& frames_read) : m_frames_read(frames_read) {}
+
+  Result<AudioFileMetadata> open(const std::string& path) override {
+    Result<AudioFileMetadata> result;
+    if (path.rfind("tone", 0) != 0) {
+      result.error = SessionGraphError::InvalidParameter;
+      result.errorMessage = "not found";
+      return result;
+    }
+    m_frames = std::stoll(path.substr(4));
+    m_position = 0;
+    result.value.format = AudioFileFormat::WAV;
+    result.value.sample_rate = 48000;
+    result.value.num_channels = 2;
+    result.value.duration_samples = m_frames;
+    result.value.bit_depth = 24;
+    result.value.codec = "PCM";
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+
+  Result<size_t> readSamples(float* buffer, size_t num_samples) override {
+    Result<size_t> result;
+    size_t frames = std::min(num_samples, static_cast<size_t>(m_frames - m_position));
+    for (size_t i = 0; i < frames; ++i) {
+      buffer[i * 2] = toneSample(m_position, 0);
+      buffer[i * 2 + 1] = toneSample(m_position, 1);
+      ++m_position;
+    }
+    m_frames_read += static_cast<int64_t>(frames);
+    result.value = frames;
+    result.error = SessionGraphError::OK;
+    return result;
+  }
+
+  SessionGraphError seek(int64_t sample_position) override {
+    m_position = sample_position;
+    return SessionGraphError::OK;
+  }
+  void close() override {}
+  int64_t getCurrentPosition() const override {
+    return m_position;
+  }
+  bool isOpen() const override {
+    return true;
+  }
+
+private:
+  std::atomic<int64_t>& m_frames_read;
+  int64_t m_frames = 0;
+  int64_t m_position = 0;
+};
+
+} // namespace
+
+class ThumbnailAtlasTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() / "orpheus_thumbnail_atlas_test";
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(m_dir);
+  }
+
+  AudioFileReaderFactory factory() {
+    return [this] { return std::make_unique<ToneReader>(m_frames_read); };
+  }
+
+  std::filesystem::path m_dir;
+  std::atomic<int64_t> m_frames_read{0};
+};
+
+// ============================================================================
+// Generation
+// ============================================================================
+
+TEST_F(ThumbnailAtlasTest, ShortFilesAreExact) {
+  ToneReader reader(m_frames_read);
+  auto thumbnail = ThumbnailAtlas::generate(reader, "tone6400", 128, 2048);
+  ASSERT_TRUE(thumbnail.info.valid);
+  EXPECT_EQ(thumbnail.info.numChannels, 2);
+  EXPECT_EQ(thumbnail.info.durationSamples, 6400);
+  ASSERT_EQ(thumbnail.pairs.size(), 2u * 128 * 2);
+  EXPECT_EQ(m_frames_read, 6400); // 50 frames per pixel: every frame read once
+
+  for (uint16_t ch = 0; ch < 2; ++ch) {
+    for (uint32_t p = 0; p < 128; ++p) {
+      float min = 1.0f;
+      float max = -1.0f;
+      for (int64_t i = p * 50; i < (p + 1) * 50; ++i) {
+        min = std::min(min, toneSample(i, ch));
+        max = std::max(max, toneSample(i, ch));
+      }
+      size_t index = (ch * 128 + p) * 2;
+      EXPECT_LE(thumbnail.pairs[index] / THUMBNAIL_FULL_SCALE, min) << "pixel " << p;
+      EXPECT_NEAR(thumbnail.pairs[index] / THUMBNAIL_FULL_SCALE, min, 1e-4f) << "pixel " << p;
+      EXPECT_GE(thumbnail.pairs[index + 1] / THUMBNAIL_FULL_SCALE, max) << "pixel " << p;
+      EXPECT_NEAR(thumbnail.pairs[index + 1] / THUMBNAIL_FULL_SCALE, max, 1e-4f) << "pixel " << p;
+    }
+  }
+}
+
+TEST_F(ThumbnailAtlasTest, LongFilesUseStridedReads) {
+  ToneReader reader(m_frames_read);
+  auto thumbnail = ThumbnailAtlas::generate(reader, "tone48000000", 128, 1024);
+  ASSERT_TRUE(thumbnail.info.valid);
+  EXPECT_EQ(m_frames_read, 128 * 1024); // Not the 48M frames of the file
+
+  // Each probe spans a full period of the sine, so every pixel straddles zero
+  for (uint32_t p = 0; p < 128; ++p) {
+    EXPECT_LT(thumbnail.pairs[p * 2], 0) << "pixel " << p;
+    EXPECT_GT(thumbnail.pairs[p * 2 + 1], 0) << "pixel " << p;
+  }
+}
+
+TEST_F(ThumbnailAtlasTest, UnreadableFileIsMarkedInvalid) {
+  ToneReader reader(m_frames_read);
+  auto thumbnail = ThumbnailAtlas::generate(reader, "missing.wav", 128, 2048);
+  EXPECT_FALSE(thumbnail.info.valid);
+  EXPECT_EQ(thumbnail.info.numChannels, 0);
+  EXPECT_TRUE(thumbnail.pairs.empty());
+}
+
+TEST_F(ThumbnailAtlasTest, ThreadCountDoesNotChangeResults) {
+  std::vector<std::string> paths;
+  for (int i = 1; i <= 20; ++i) {
+    paths.push_back("tone" + std::to_string(i * 7919));
+  }
+
+  ThumbnailAtlasOptions serial;
+  serial.maxThreads = 1;
+  ThumbnailAtlasOptions parallel;
+  parallel.maxThreads = 4;
+  auto one = ThumbnailAtlas::generateAll(paths, serial, factory());
+  auto four = ThumbnailAtlas::generateAll(paths, parallel, factory());
+
+  ASSERT_EQ(one.size(), paths.size());
+  ASSERT_EQ(four.size(), paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    EXPECT_EQ(one[i].info.filePath, paths[i]);
+    EXPECT_EQ(four[i].info.filePath, paths[i]);
+    EXPECT_EQ(one[i].pairs, four[i].pairs) << paths[i];
+  }
+}
+
+// ============================================================================
+// Atlas file
+// ============================================================================
+
+TEST_F(ThumbnailAtlasTest, WriteAndMapRoundTrip) {
+  std::vector<std::string> paths = {"tone48000", "missing.wav", "tone100", "tone48000"};
+  ThumbnailAtlasOptions options;
+  options.width = 64;
+  auto thumbnails = ThumbnailAtlas::generateAll(paths, options, factory());
+
+  auto path = m_dir / "grid.orpthumbs";
+  ASSERT_TRUE(ThumbnailAtlas::write(path, thumbnails, 64));
+  auto atlas = ThumbnailAtlas::open(path);
+  ASSERT_NE(atlas, nullptr);
+
+  EXPECT_EQ(atlas->thumbnailWidth(), 64u);
+  ASSERT_EQ(atlas->size(), paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    auto info = atlas->info(i);
+    EXPECT_EQ(info.filePath, paths[i]);
+    EXPECT_EQ(info.valid, thumbnails[i].info.valid);
+    EXPECT_EQ(info.numChannels, thumbnails[i].info.numChannels);
+    EXPECT_EQ(info.sampleRate, thumbnails[i].info.sampleRate);
+    EXPECT_EQ(info.durationSamples, thumbnails[i].info.durationSamples);
+    for (uint32_t ch = 0; ch < info.numChannels; ++ch) {
+      const int16_t* pairs = atlas->minMaxPairs(i, ch);
+      ASSERT_NE(pairs, nullptr);
+      std::vector<int16_t> mapped(pairs, pairs + 128);
+      std::vector<int16_t> expected(thumbnails[i].pairs.begin() + ch * 128,
+                                    thumbnails[i].pairs.begin() + (ch + 1) * 128);
+      EXPECT_EQ(mapped, expected) << paths[i] << " channel " << ch;
+    }
+  }
+
+  EXPECT_EQ(atlas->find("tone100"), 2u);
+  EXPECT_EQ(atlas->find("tone48000"), 0u); // First of the repeated entries
+  EXPECT_FALSE(atlas->find("tone7").has_value());
+  EXPECT_EQ(atlas->minMaxPairs(1, 0), nullptr); // Invalid entry has no channels
+  EXPECT_EQ(atlas->minMaxPairs(0, 2), nullptr);
+  EXPECT_EQ(atlas->minMaxPairs(9, 0), nullptr);
+}
+
+TEST_F(ThumbnailAtlasTest, CorruptOrForeignFilesAreRejected) {
+  ThumbnailAtlasOptions options;
+  auto thumbnails = ThumbnailAtlas::generateAll({"tone4800", "tone9600"}, options, factory());
+  auto path = m_dir / "grid.orpthumbs";
+  ASSERT_TRUE(ThumbnailAtlas::write(path, thumbnails, options.width));
+  auto size = std::filesystem::file_size(path);
+
+  // Truncated
+  auto truncated = m_dir / "truncated.orpthumbs";
+  std::filesystem::copy_file(path, truncated);
+  std::filesystem::resize_file(truncated, size - 100);
+  EXPECT_EQ(ThumbnailAtlas::open(truncated), nullptr);
+
+  // Not an atlas
+  auto foreign = m_dir / "foreign.orpthumbs";
+  std::ofstream(foreign) << std::string(256, 'x');
+  EXPECT_EQ(ThumbnailAtlas::open(foreign), nullptr);
+
+  EXPECT_EQ(ThumbnailAtlas::open(m_dir / "missing.orpthumbs"), nullptr);
+  EXPECT_NE(openThumbnailAtlas(path.string()), nullptr);
+}
+
+TEST_F(ThumbnailAtlasTest, BuildRejectsInvalidParameters) {
+  auto path = (m_dir / "grid.orpthumbs").string();
+  EXPECT_EQ(buildThumbnailAtlas({}, path), SessionGraphError::InvalidParameter);
+
+  ThumbnailAtlasOptions zeroWidth;
+  zeroWidth.width = 0;
+  EXPECT_EQ(buildThumbnailAtlas({"a.wav"}, path, zeroWidth), SessionGraphError::InvalidParameter);
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
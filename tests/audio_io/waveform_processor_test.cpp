@@ -1,14 +1,22 @@
 // SPDX-License-Identifier: MIT
 #include <orpheus/audio_file_reader_extended.h>
 
+#include "audio_io/file_fingerprint.h"
+#include "audio_io/io_scheduler.h"
+
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <sndfile.h>
 #include <thread>
+#include <vector>
 
 using namespace orpheus;
 
@@ -258,7 +266,10 @@ TEST_F(WaveformProcessorTest, AsyncPrecomputation) {
 
   // Pre-compute waveform asynchronously
   bool callbackCalled = false;
-  reader->precomputeWaveformAsync([&callbackCalled]() { callbackCalled = true; });
+  reader->precomputeWaveformAsync([&callbackCalled](bool built) {
+    EXPECT_TRUE(built);
+    callbackCalled = true;
+  });
 
   // Wait for callback (should complete quickly for 1-second file)
   auto start = std::chrono::high_resolution_clock::now();
@@ -284,6 +295,293 @@ TEST_F(WaveformProcessorTest, AsyncPrecomputation) {
   reader->close();
 }
 
+/// Test: After pre-computation, zoomed-out queries come from the LOD pyramid
+TEST_F(WaveformProcessorTest, PrecomputedPyramidMatchesStreaming) {
+  auto filepath = testDir / "pyramid.wav";
+  generateTestWav(filepath.string(), 5.0, 48000, 2, 440.0);
+
+  auto reader = createAudioFileReaderExtended();
+  auto openResult = reader->open(filepath.string());
+  ASSERT_TRUE(openResult.isOk());
+  int64_t totalSamples = openResult.value.duration_samples;
+
+  auto streamed = reader->getWaveformData(0, totalSamples, 750, 1); // 320 samples per pixel
+
+  std::atomic<bool> done{false};
+  reader->precomputeWaveformAsync([&done](bool) { done = true; });
+  while (!done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  auto pyramid = reader->getWaveformData(0, totalSamples, 750, 1);
+  ASSERT_TRUE(pyramid.isValid());
+  ASSERT_EQ(pyramid.rms.size(), 750u);
+
+  // Pyramid pixels snap outward to bucket edges: they envelope the exact peaks
+  for (size_t i = 0; i < 750; ++i) {
+    EXPECT_LE(pyramid.minPeaks[i], streamed.minPeaks[i] + 1e-6f) << "Pixel " << i;
+    EXPECT_GE(pyramid.maxPeaks[i], streamed.maxPeaks[i] - 1e-6f) << "Pixel " << i;
+    EXPECT_NEAR(pyramid.rms[i], std::sqrt(0.5f), 0.05f) << "Pixel " << i; // Full-scale sine
+  }
+
+  reader->close();
+}
+
+/// Test: Reopening a file maps the saved peak file instead of decoding
+TEST_F(WaveformProcessorTest, ReopenUsesSavedPeakFile) {
+  auto filepath = testDir / "peaks.wav";
+  auto peakDir = testDir / "peaks";
+  generateTestWav(filepath.string(), 3.0, 48000, 2, 220.0);
+
+  WaveformData built;
+  {
+    auto reader = createAudioFileReaderExtended(peakDir.string());
+    ASSERT_TRUE(reader->open(filepath.string()).isOk());
+    std::atomic<bool> done{false};
+    reader->precomputeWaveformAsync([&done](bool) { done = true; });
+    while (!done) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    built = reader->getWaveformData(0, 144000, 500, 0);
+  }
+  ASSERT_FALSE(std::filesystem::is_empty(peakDir));
+
+  // No precompute: zoomed-out queries come straight from the mapped peak file, found
+  // through the fingerprint index the build filled (open() itself never hashes)
+  auto reader = createAudioFileReaderExtended(peakDir.string());
+  auto misses = sharedFingerprintIndex().misses();
+  ASSERT_TRUE(reader->open(filepath.string()).isOk());
+  EXPECT_EQ(sharedFingerprintIndex().misses(), misses);
+  auto mapped = reader->getWaveformData(0, 144000, 500, 0);
+  ASSERT_TRUE(mapped.isValid());
+  for (size_t i = 0; i < 500; ++i) {
+    EXPECT_NEAR(mapped.minPeaks[i], built.minPeaks[i], 1e-4f) << "Pixel " << i;
+    EXPECT_NEAR(mapped.maxPeaks[i], built.maxPeaks[i], 1e-4f) << "Pixel " << i;
+  }
+  EXPECT_NEAR(reader->getPeakLevel(0), 1.0f, 0.01f);
+
+  // Rewriting the audio makes the peak file stale
+  reader->close();
+  generateTestWav(filepath.string(), 3.0, 48000, 2, 0.0); // Silence
+  ASSERT_TRUE(reader->open(filepath.string()).isOk());
+  EXPECT_EQ(sharedFingerprintIndex().misses(), misses); // Not indexed yet: no peak file, no hash
+  auto fresh = reader->getWaveformData(0, 144000, 500, 0);
+  ASSERT_TRUE(fresh.isValid());
+  EXPECT_EQ(fresh.maxPeaks[250], 0.0f);
+}
+
+/// Test: All-channel extraction matches per-channel extraction
+TEST_F(WaveformProcessorTest, MultiChannelMatchesPerChannel) {
+  auto filepath = testDir / "multi.wav";
+  generateTestWavWithRamp(filepath.string(), 2.0, 48000, 2);
+
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  auto openResult = reader->open(filepath.string());
+  ASSERT_TRUE(openResult.isOk());
+  int64_t totalSamples = openResult.value.duration_samples;
+
+  // 7 samples per pixel: below the pyramid, always streamed; whole file fills peak levels
+  uint32_t width = static_cast<uint32_t>(totalSamples / 7);
+  auto all = reader->getWaveformDataMulti(0, totalSamples, width);
+  ASSERT_EQ(all.size(), 2u);
+  for (uint32_t ch = 0; ch < 2; ++ch) {
+    ASSERT_TRUE(all[ch].isValid());
+    EXPECT_EQ(all[ch].channelIndex, ch);
+    auto single = reader->getWaveformData(0, totalSamples, width, ch);
+    for (uint32_t p = 0; p < width; p += 97) {
+      EXPECT_FLOAT_EQ(all[ch].minPeaks[p], single.minPeaks[p]) << "Pixel " << p;
+      EXPECT_FLOAT_EQ(all[ch].maxPeaks[p], single.maxPeaks[p]) << "Pixel " << p;
+    }
+    EXPECT_NEAR(reader->getPeakLevel(ch), 1.0f, 0.001f);
+  }
+
+  // More pixels than samples: every pixel is valid, empty ones are zero
+  auto wide = reader->getWaveformDataMulti(0, 10, 40);
+  ASSERT_EQ(wide.size(), 2u);
+  EXPECT_TRUE(wide[1].isValid());
+
+  EXPECT_TRUE(reader->getWaveformDataMulti(100, 50, 10).empty());
+  reader->close();
+  EXPECT_TRUE(reader->getWaveformDataMulti(0, 100, 10).empty());
+}
+
+/// Test: Closing a reader cancels its queued analysis job
+TEST_F(WaveformProcessorTest, CloseCancelsQueuedPrecompute) {
+  auto filepath = testDir / "cancel.wav";
+  generateTestWav(filepath.string(), 30.0, 48000, 2, 440.0);
+
+  auto before = getAnalysisStats();
+  for (int i = 0; i < 8; ++i) {
+    auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+    ASSERT_TRUE(reader->open(filepath.string()).isOk());
+    reader->setAnalysisPriority(AnalysisPriority::Background);
+    int calls = 0;
+    reader->precomputeWaveformAsync([&calls](bool) { ++calls; });
+    reader->precomputeWaveformAsync([&calls](bool) { ++calls; }); // Joins the first
+    reader->close(); // Must return promptly whether the job was queued or running
+    EXPECT_EQ(calls, 2); // Cancelled or not, every caller heard back before close() returned
+  }
+  auto after = getAnalysisStats();
+  EXPECT_EQ(after.completed + after.cancelled - before.completed - before.cancelled, 8u);
+  EXPECT_EQ(after.running, 0u);
+}
+
+/// Test: Precompute on a reader with no file reports failure at once
+TEST_F(WaveformProcessorTest, PrecomputeWithoutFileReportsFailure) {
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  std::optional<bool> outcome;
+  reader->precomputeWaveformAsync([&outcome](bool built) { outcome = built; });
+  ASSERT_TRUE(outcome.has_value());
+  EXPECT_FALSE(*outcome);
+}
+
+/// Test: The deprecated no-argument callback still fires once the pyramid is built
+TEST_F(WaveformProcessorTest, DeprecatedPrecomputeCallbackStillFires) {
+  auto filepath = testDir / "legacy.wav";
+  generateTestWav(filepath.string(), 1.0, 48000, 2, 440.0);
+
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  ASSERT_TRUE(reader->open(filepath.string()).isOk());
+  std::atomic<int> calls{0};
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  reader->precomputeWaveformAsync([&calls]() { ++calls; });
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (calls == 0 && std::chrono::steady_clock::now() < giveUp) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  reader->close();
+  EXPECT_EQ(calls, 1);
+}
+
+/// Test: Progressive delivery sends an overview, then refined tiles matching the pyramid
+TEST_F(WaveformProcessorTest, ProgressiveOverviewThenRefinedTiles) {
+  auto filepath = testDir / "progressive.wav";
+  generateTestWav(filepath.string(), 20.0, 48000, 2, 440.0);
+
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  auto openResult = reader->open(filepath.string());
+  ASSERT_TRUE(openResult.isOk());
+  int64_t totalSamples = openResult.value.duration_samples;
+
+  std::mutex mutex;
+  std::vector<WaveformTile> tiles;
+  std::atomic<bool> done{false};
+  reader->getWaveformDataProgressive(0, totalSamples, 1000, [&](const WaveformTile& tile) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tiles.push_back(tile);
+    done = tile.complete;
+  });
+  while (!done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GE(tiles.size(), 3u);
+  EXPECT_FALSE(tiles[0].refined);
+  ASSERT_EQ(tiles[0].channels.size(), 2u);
+  EXPECT_EQ(tiles[0].channels[0].pixelWidth, 1000u);
+  EXPECT_NEAR(tiles[0].channels[0].maxPeaks[500], 1.0f, 0.05f); // Full-scale sine
+
+  // Refined tiles are contiguous and match the finished pyramid pixel for pixel
+  auto finished = reader->getWaveformDataMulti(0, totalSamples, 1000);
+  ASSERT_EQ(finished.size(), 2u);
+  uint32_t nextPixel = 0;
+  for (size_t t = 1; t < tiles.size(); ++t) {
+    const auto& tile = tiles[t];
+    EXPECT_TRUE(tile.refined);
+    EXPECT_EQ(tile.complete, t + 1 == tiles.size());
+    ASSERT_EQ(tile.firstPixel, nextPixel);
+    ASSERT_EQ(tile.channels.size(), 2u);
+    for (uint32_t ch = 0; ch < 2; ++ch) {
+      for (uint32_t i = 0; i < tile.channels[ch].pixelWidth; ++i) {
+        EXPECT_EQ(tile.channels[ch].minPeaks[i], finished[ch].minPeaks[tile.firstPixel + i]);
+        EXPECT_EQ(tile.channels[ch].maxPeaks[i], finished[ch].maxPeaks[tile.firstPixel + i]);
+      }
+    }
+    nextPixel += tile.channels[0].pixelWidth;
+  }
+  EXPECT_EQ(nextPixel, 1000u);
+
+  reader->close();
+}
+
+/// Test: A tile callback may query the reader it came from
+TEST_F(WaveformProcessorTest, ProgressiveCallbackMayQueryReader) {
+  auto filepath = testDir / "reentrant.wav";
+  generateTestWav(filepath.string(), 2.0, 48000, 2, 440.0);
+
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  auto openResult = reader->open(filepath.string());
+  ASSERT_TRUE(openResult.isOk());
+  int64_t totalSamples = openResult.value.duration_samples;
+
+  // Zoomed in beyond the pyramid (one exact tile), then zoomed out once it is built
+  for (uint32_t pixelWidth : {static_cast<uint32_t>(totalSamples / 8), 500u}) {
+    if (pixelWidth == 500u) {
+      std::atomic<bool> built{false};
+      reader->precomputeWaveformAsync([&built](bool) { built = true; });
+      while (!built) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    }
+    std::atomic<bool> done{false};
+    std::atomic<bool> repainted{false};
+    reader->getWaveformDataProgressive(0, totalSamples, pixelWidth, [&](const WaveformTile& tile) {
+      repainted = reader->getWaveformData(0, totalSamples, 100, 0).isValid(); // Repaint
+      done = tile.complete;
+    });
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done && std::chrono::steady_clock::now() < giveUp) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(done) << "Tile callback blocked on the reader (" << pixelWidth << " px)";
+    EXPECT_TRUE(repainted);
+  }
+  reader->close();
+}
+
+/// Test: A build waiting for a Background I/O slot does not hold up foreground queries
+TEST_F(WaveformProcessorTest, BuildWaitingForIoDoesNotBlockQueries) {
+  auto filepath = testDir / "inversion.wav";
+  generateTestWav(filepath.string(), 2.0, 48000, 2, 440.0);
+
+  auto reader = createAudioFileReaderExtended((testDir / "peaks").string());
+  auto openResult = reader->open(filepath.string());
+  ASSERT_TRUE(openResult.isOk());
+  int64_t totalSamples = openResult.value.duration_samples;
+
+  // Take the only Background slot, so the build queues for its first read
+  auto& io = sharedIoScheduler();
+  auto held = io.acquire(IoClass::Background);
+  std::atomic<bool> built{false};
+  reader->precomputeWaveformAsync([&built](bool) { built = true; });
+  const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (io.stats()[IoClass::Background].queued == 0 &&
+         std::chrono::steady_clock::now() < giveUp) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(io.stats()[IoClass::Background].queued, 1u);
+
+  auto query = std::async(std::launch::async, [&] {
+    return reader->getWaveformData(0, totalSamples / 100, 100, 0); // Zoomed in: reads the file
+  });
+  bool answered = query.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+  held.release();
+  EXPECT_TRUE(answered) << "Query waited behind the build's I/O ticket";
+  EXPECT_TRUE(query.get().isValid());
+
+  while (!built) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  reader->close();
+}
+
 /// Test: Downsampling accuracy (verify min/max detection)
 TEST_F(WaveformProcessorTest, DownsamplingAccuracy) {
   auto filepath = testDir / "accuracy.wav";
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/waveform_pyramid.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Deterministic stereo test signal: L = sine, R = sawtooth
+std::vector<float> makeSignal(size_t frames) {
+  std::vector<float> samples(frames * 2);
+  for (size_t i = 0; i < frames; ++i) {
+    samples[i * 2] = static_cast<float>(std::sin(static_cast<double>(i) * 0.0123));
+    samples[i * 2 + 1] = static_cast<float>(i % 1000) / 1000.0f - 0.5f;
+  }
+  return samples;
+}
+
+WaveformPyramid buildPyramid(const std::vector<float>& samples, size_t chunk) {
+  WaveformPyramid pyramid(2);
+  size_t frames = samples.size() / 2;
+  for (size_t offset = 0; offset < frames; offset += chunk) {
+    pyramid.append(samples.data() + offset * 2, std::min(chunk, frames - offset));
+  }
+  pyramid.finish();
+  return pyramid;
+}
+
+/// Exact min/max/RMS of frames [first, last) on one channel
+struct Exact {
+  float min;
+  float max;
+  float rms;
+};
+
+Exact exactRange(const std::vector<float>& samples, int64_t first, int64_t last, uint32_t ch) {
+  Exact exact{1e9f, -1e9f, 0.0f};
+  double sum = 0.0;
+  for (int64_t i = first; i < last; ++i) {
+    float s = samples[static_cast<size_t>(i) * 2 + ch];
+    exact.min = std::min(exact.min, s);
+    exact.max = std::max(exact.max, s);
+    sum += static_cast<double>(s) * s;
+  }
+  exact.rms = static_cast<float>(std::sqrt(sum / static_cast<double>(last - first)));
+  return exact;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(WaveformPyramidTest, LevelsCoverAllFrames) {
+  auto pyramid = buildPyramid(makeSignal(10000), 4096);
+  EXPECT_TRUE(pyramid.isFinished());
+  EXPECT_EQ(pyramid.numFrames(), 10000);
+  EXPECT_EQ(pyramid.numBuckets(0), 157u); // ceil(10000 / 64)
+  EXPECT_EQ(pyramid.numBuckets(1), 40u);  // ceil(10000 / 256)
+  EXPECT_EQ(pyramid.numBuckets(2), 10u);  // ceil(10000 / 1024)
+  EXPECT_EQ(pyramid.numBuckets(3), 3u);   // ceil(10000 / 4096)
+  EXPECT_GT(pyramid.memoryBytes(), 0u);
+}
+
+TEST(WaveformPyramidTest, BucketsMatchExactSummaries) {
+  auto samples = makeSignal(10000);
+  auto pyramid = buildPyramid(samples, 4096);
+
+  for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+    int64_t size = WaveformPyramid::LEVEL_BUCKET_FRAMES[level];
+    for (size_t b = 0; b < pyramid.numBuckets(level); ++b) {
+      int64_t first = static_cast<int64_t>(b) * size;
+      int64_t last = std::min<int64_t>(first + size, 10000); // Last bucket is partial
+      for (uint32_t ch = 0; ch < 2; ++ch) {
+        auto exact = exactRange(samples, first, last, ch);
+        const auto& bucket = pyramid.bucket(level, b, ch);
+        EXPECT_EQ(bucket.min, exact.min) << "level " << level << " bucket " << b;
+        EXPECT_EQ(bucket.max, exact.max) << "level " << level << " bucket " << b;
+        EXPECT_NEAR(bucket.rms, exact.rms, 1e-5f) << "level " << level << " bucket " << b;
+      }
+    }
+  }
+}
+
+TEST(WaveformPyramidTest, ChunkingDoesNotChangeResult) {
+  auto samples = makeSignal(20000);
+  auto whole = buildPyramid(samples, 20000);
+  auto pieces = buildPyramid(samples, 37); // Chunks straddle bucket boundaries
+
+  for (size_t level = 0; level < WaveformPyramid::NUM_LEVELS; ++level) {
+    ASSERT_EQ(whole.numBuckets(level), pieces.numBuckets(level));
+    for (size_t b = 0; b < whole.numBuckets(level); ++b) {
+      EXPECT_EQ(whole.bucket(level, b, 1).min, pieces.bucket(level, b, 1).min);
+      EXPECT_EQ(whole.bucket(level, b, 1).max, pieces.bucket(level, b, 1).max);
+      EXPECT_FLOAT_EQ(whole.bucket(level, b, 1).rms, pieces.bucket(level, b, 1).rms);
+    }
+  }
+}
+
+TEST(WaveformPyramidTest, PeakLevelPerChannel) {
+  auto pyramid = buildPyramid(makeSignal(5000), 1000);
+  EXPECT_NEAR(pyramid.peakLevel(0), 1.0f, 1e-3f);
+  EXPECT_FLOAT_EQ(pyramid.peakLevel(1), 0.5f);
+  EXPECT_EQ(pyramid.peakLevel(7), 0.0f);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+TEST(WaveformPyramidTest, LevelSelection) {
+  EXPECT_EQ(WaveformPyramid::levelForSamplesPerPixel(10.0), WaveformPyramid::NUM_LEVELS);
+  EXPECT_EQ(WaveformPyramid::levelForSamplesPerPixel(64.0), 0u);
+  EXPECT_EQ(WaveformPyramid::levelForSamplesPerPixel(300.0), 1u);
+  EXPECT_EQ(WaveformPyramid::levelForSamplesPerPixel(1024.0), 2u);
+  EXPECT_EQ(WaveformPyramid::levelForSamplesPerPixel(1e9), 3u);
+}
+
+TEST(WaveformPyramidTest, AlignedQueryIsExact) {
+  auto samples = makeSignal(65536);
+  auto pyramid = buildPyramid(samples, 4096);
+
+  // 256 frames per pixel: pixels coincide with level-1 buckets
+  auto waveform = pyramid.query(0, 65536, 256, 0);
+  ASSERT_TRUE(waveform.isValid());
+  ASSERT_EQ(waveform.rms.size(), 256u);
+  for (uint32_t p = 0; p < 256; ++p) {
+    auto exact = exactRange(samples, p * 256, (p + 1) * 256, 0);
+    EXPECT_EQ(waveform.minPeaks[p], exact.min) << "pixel " << p;
+    EXPECT_EQ(waveform.maxPeaks[p], exact.max) << "pixel " << p;
+    EXPECT_NEAR(waveform.rms[p], exact.rms, 1e-5f) << "pixel " << p;
+  }
+}
+
+TEST(WaveformPyramidTest, UnalignedQueryEnvelopesTheAudio) {
+  auto samples = makeSignal(100000);
+  auto pyramid = buildPyramid(samples, 4096);
+
+  int64_t start = 12345;
+  int64_t end = 98765;
+  uint32_t width = 333;
+  auto waveform = pyramid.query(start, end, width, 1);
+  ASSERT_TRUE(waveform.isValid());
+
+  // Bucket snapping may widen a pixel, never narrow it
+  double spp = static_cast<double>(end - start) / width;
+  for (uint32_t p = 0; p < width; ++p) {
+    auto first = start + static_cast<int64_t>(p * spp);
+    auto last = start + static_cast<int64_t>((p + 1) * spp);
+    auto exact = exactRange(samples, first, last, 1);
+    EXPECT_LE(waveform.minPeaks[p], exact.min) << "pixel " << p;
+    EXPECT_GE(waveform.maxPeaks[p], exact.max) << "pixel " << p;
+  }
+}
+
+TEST(WaveformPyramidTest, ZoomedInBeyondFinestLevelUsesFinestBuckets) {
+  auto samples = makeSignal(4096);
+  auto pyramid = buildPyramid(samples, 4096);
+
+  auto waveform = pyramid.query(640, 704, 64, 0); // 1 frame per pixel, inside bucket 10
+  ASSERT_TRUE(waveform.isValid());
+  const auto& bucket = pyramid.bucket(0, 10, 0);
+  for (uint32_t p = 0; p < 64; ++p) {
+    EXPECT_EQ(waveform.minPeaks[p], bucket.min);
+    EXPECT_EQ(waveform.maxPeaks[p], bucket.max);
+  }
+}
+
+TEST(WaveformPyramidTest, InvalidQueries) {
+  auto pyramid = buildPyramid(makeSignal(5000), 5000);
+  EXPECT_FALSE(pyramid.query(0, 5000, 100, 2).isValid()); // Bad channel
+  EXPECT_FALSE(pyramid.query(0, 5000, 0, 0).isValid());   // Zero width
+  EXPECT_FALSE(pyramid.query(100, 50, 10, 0).isValid());  // Reversed range
+  EXPECT_FALSE(pyramid.query(-1, 50, 10, 0).isValid());   // Negative start
+
+  // Ranges past the end are clamped
+  auto clamped = pyramid.query(0, 50000, 100, 0);
+  ASSERT_TRUE(clamped.isValid());
+  EXPECT_EQ(clamped.endSample, 5000);
+}
+
+// ============================================================================
+// Tiles (progressive delivery)
+// ============================================================================
+
+TEST(WaveformPyramidTest, TilesMatchFullQuery) {
+  auto samples = makeSignal(100000);
+  auto pyramid = buildPyramid(samples, 4096);
+
+  int64_t start = 12345;
+  int64_t end = 98765;
+  uint32_t width = 333;
+  auto full = pyramid.query(start, end, width, 0);
+
+  uint32_t first = 0;
+  for (uint32_t last : {50u, 51u, 200u, 333u}) {
+    auto tile = pyramid.queryPixels(start, end, width, 0, first, last, pyramid.numFrames());
+    ASSERT_TRUE(tile.isValid());
+    ASSERT_EQ(tile.pixelWidth, last - first);
+    for (uint32_t p = first; p < last; ++p) {
+      EXPECT_EQ(tile.minPeaks[p - first], full.minPeaks[p]) << "pixel " << p;
+      EXPECT_EQ(tile.maxPeaks[p - first], full.maxPeaks[p]) << "pixel " << p;
+      EXPECT_EQ(tile.rms[p - first], full.rms[p]) << "pixel " << p;
+    }
+    first = last;
+  }
+  EXPECT_EQ(pyramid.queryPixels(start, end, width, 0, 100, 333, 100000).endSample, end);
+  EXPECT_FALSE(pyramid.queryPixels(start, end, width, 0, 10, 10, 100000).isValid());
+}
+
+TEST(WaveformPyramidTest, PartialBuildReportsCompletePixels) {
+  auto samples = makeSignal(100000);
+  auto finished = buildPyramid(samples, 100000);
+
+  WaveformPyramid building(2);
+  building.append(samples.data(), 30000);
+  EXPECT_FALSE(building.isFinished());
+
+  // 100 frames per pixel (level 0): buckets cover frames [0, 29952)
+  uint32_t ready = building.completePixels(0, 100000, 1000);
+  EXPECT_EQ(ready, 299u);
+
+  // Completed pixels already hold their final values
+  auto tile = building.queryPixels(0, 100000, 1000, 1, 0, ready, 100000);
+  auto full = finished.query(0, 100000, 1000, 1);
+  ASSERT_TRUE(tile.isValid());
+  for (uint32_t p = 0; p < ready; ++p) {
+    EXPECT_EQ(tile.minPeaks[p], full.minPeaks[p]) << "pixel " << p;
+    EXPECT_EQ(tile.maxPeaks[p], full.maxPeaks[p]) << "pixel " << p;
+    EXPECT_FLOAT_EQ(tile.rms[p], full.rms[p]) << "pixel " << p;
+  }
+
+  building.append(samples.data() + 60000, 70000);
+  building.finish();
+  EXPECT_EQ(building.completePixels(0, 100000, 1000), 1000u);
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/waveform_reduce.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+struct Summary {
+  std::vector<float> mins;
+  std::vector<float> maxs;
+  std::vector<double> sums;
+
+  explicit Summary(uint16_t channels)
+      : mins(channels, std::numeric_limits<float>::max()),
+        maxs(channels, std::numeric_limits<float>::lowest()), sums(channels, 0.0) {}
+};
+
+/// Channel c carries a sine of its own frequency and amplitude
+std::vector<float> makeFrames(size_t frames, uint16_t channels) {
+  std::vector<float> samples(frames * channels);
+  for (size_t i = 0; i < frames; ++i) {
+    for (uint16_t ch = 0; ch < channels; ++ch) {
+      double amplitude = 0.3 + 0.08 * ch;
+      samples[i * channels + ch] =
+          static_cast<float>(amplitude * std::sin(static_cast<double>(i) * (0.01 + 0.003 * ch)));
+    }
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(WaveformReduceTest, MatchesScalarForEveryLayout) {
+  // Odd frame counts exercise the scalar tails; 1/2/4/8 channels take the SIMD paths
+  for (uint16_t channels : {1, 2, 3, 4, 6, 8, 12}) {
+    for (size_t frames : {0, 1, 3, 63, 64, 1001, 5000}) {
+      auto samples = makeFrames(frames, channels);
+      Summary fast(channels);
+      Summary scalar(channels);
+      reduceInterleaved(samples.data(), frames, channels, fast.mins.data(), fast.maxs.data(),
+                        fast.sums.data());
+      reduceInterleavedScalar(samples.data(), frames, channels, scalar.mins.data(),
+                              scalar.maxs.data(), scalar.sums.data());
+      for (uint16_t ch = 0; ch < channels; ++ch) {
+        EXPECT_EQ(fast.mins[ch], scalar.mins[ch]) << channels << "ch, " << frames << " frames";
+        EXPECT_EQ(fast.maxs[ch], scalar.maxs[ch]) << channels << "ch, " << frames << " frames";
+        EXPECT_NEAR(fast.sums[ch], scalar.sums[ch], 1e-4 * (1.0 + scalar.sums[ch]))
+            << channels << "ch, " << frames << " frames";
+      }
+    }
+  }
+}
+
+TEST(WaveformReduceTest, AccumulatesAcrossCalls) {
+  auto samples = makeFrames(1000, 2);
+  Summary whole(2);
+  Summary split(2);
+  reduceInterleaved(samples.data(), 1000, 2, whole.mins.data(), whole.maxs.data(),
+                    whole.sums.data());
+  reduceInterleaved(samples.data(), 377, 2, split.mins.data(), split.maxs.data(),
+                    split.sums.data());
+  reduceInterleaved(samples.data() + 377 * 2, 623, 2, split.mins.data(), split.maxs.data(),
+                    split.sums.data());
+  for (uint16_t ch = 0; ch < 2; ++ch) {
+    EXPECT_EQ(whole.mins[ch], split.mins[ch]);
+    EXPECT_EQ(whole.maxs[ch], split.maxs[ch]);
+    EXPECT_NEAR(whole.sums[ch], split.sums[ch], 1e-4);
+  }
+}
+
+TEST(WaveformReduceTest, LongRunsKeepSumPrecision) {
+  // Ten million constant samples: float-only accumulation would drift by percent
+  std::vector<float> samples(10'000'000, 0.5f);
+  Summary summary(1);
+  reduceInterleaved(samples.data(), samples.size(), 1, summary.mins.data(), summary.maxs.data(),
+                    summary.sums.data());
+  EXPECT_NEAR(summary.sums[0], 2'500'000.0, 1.0);
+  EXPECT_EQ(summary.mins[0], 0.5f);
+  EXPECT_EQ(summary.maxs[0], 0.5f);
+}
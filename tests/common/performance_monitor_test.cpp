@@ -4,6 +4,7 @@
 #include <orpheus/performance_monitor.h>
 
 #include <chrono>
+#include <cmath>
 #include <thread>
 
 using namespace orpheus;
@@ -86,6 +87,24 @@ TEST_F(PerformanceMonitorTest, ResetUnderrunCount) {
   // exposing internal methods, so we're limited in testing this
 }
 
+TEST_F(PerformanceMonitorTest, UnderrunsAreCountedByCause) {
+  m_monitor->reportUnderrun(UnderrunCause::SlowProcessing);
+  m_monitor->reportUnderrun(UnderrunCause::Preempted);
+  m_monitor->reportUnderrun(UnderrunCause::Preempted);
+  m_monitor->reportUnderrun(); // Cause unknown: counts towards the total only
+
+  auto metrics = m_monitor->getMetrics();
+  EXPECT_EQ(metrics.bufferUnderrunCount, 4u);
+  EXPECT_EQ(metrics.slowUnderrunCount, 1u);
+  EXPECT_EQ(metrics.preemptUnderrunCount, 2u);
+
+  m_monitor->resetUnderrunCount();
+  metrics = m_monitor->getMetrics();
+  EXPECT_EQ(metrics.bufferUnderrunCount, 0u);
+  EXPECT_EQ(metrics.slowUnderrunCount, 0u);
+  EXPECT_EQ(metrics.preemptUnderrunCount, 0u);
+}
+
 TEST_F(PerformanceMonitorTest, PeakCpuUsageInitiallyZero) {
   float peakCpu = m_monitor->getPeakCpuUsage();
   EXPECT_EQ(peakCpu, 0.0f);
@@ -233,6 +252,30 @@ TEST_F(PerformanceMonitorTest, PerformanceOfGetMetrics) {
   std::cout << "Average getMetrics() time: " << avgNanoseconds << " ns" << std::endl;
 }
 
+TEST_F(PerformanceMonitorTest, RealtimeThreadReportsReplaceByName) {
+  EXPECT_TRUE(m_monitor->getRealtimeThreads().empty());
+
+  RealtimeThreadReport audio;
+  audio.name = "audio";
+  audio.requestedPolicy = RealtimePolicy::Fifo;
+  RealtimeThreadReport worker;
+  worker.name = "worker-0";
+  m_monitor->reportRealtimeThread(audio);
+  m_monitor->reportRealtimeThread(worker);
+
+  // A restarted thread replaces its earlier report and keeps its position
+  audio.policy = RealtimePolicy::Fifo;
+  audio.priority = 80;
+  m_monitor->reportRealtimeThread(audio);
+
+  auto threads = m_monitor->getRealtimeThreads();
+  ASSERT_EQ(threads.size(), 2u);
+  EXPECT_EQ(threads[0].name, "audio");
+  EXPECT_EQ(threads[0].policy, RealtimePolicy::Fifo);
+  EXPECT_EQ(threads[0].priority, 80);
+  EXPECT_EQ(threads[1].name, "worker-0");
+}
+
 // Edge Cases
 
 TEST_F(PerformanceMonitorTest, NullSessionGraph) {
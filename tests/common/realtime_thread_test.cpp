@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: MIT
+#include <orpheus/realtime_thread.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace orpheus;
+
+namespace {
+
+/// Settings with no process-wide side effects (memory locking is never tested here)
+RealtimeThreadConfig threadOnly() {
+  RealtimeThreadConfig config;
+  config.name = "test";
+  config.lockMemory = false;
+  return config;
+}
+
+/// Run setup and a check on a fresh thread, so the test thread keeps its settings
+template <typename Check>
+RealtimeThreadReport onNewThread(const RealtimeThreadConfig& config, Check check) {
+  RealtimeThreadReport report;
+  std::thread thread([&] {
+    report = configureRealtimeThread(config);
+    check(report);
+  });
+  thread.join();
+  return report;
+}
+
+/// A denormal multiplied by one, computed at run time
+float denormalTimesOne() {
+  volatile float denormal = std::numeric_limits<float>::denorm_min() * 1000.0f;
+  volatile float one = 1.0f;
+  return denormal * one;
+}
+
+} // namespace
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+TEST(RealtimeThreadTest, ReportedPolicyMatchesTheKernel) {
+  for (auto policy : {RealtimePolicy::Fifo, RealtimePolicy::RoundRobin}) {
+    auto config = threadOnly();
+    config.policy = policy;
+    config.priority = 99; // Above any RLIMIT_RTPRIO: exercises the fallback when unprivileged
+    auto report = onNewThread(config, [](const RealtimeThreadReport& granted) {
+#if !defined(_WIN32)
+      int current = 0;
+      sched_param param{};
+      ASSERT_EQ(pthread_getschedparam(pthread_self(), &current, &param), 0);
+      if (granted.policy == RealtimePolicy::None) {
+        EXPECT_NE(current, SCHED_FIFO);
+        EXPECT_NE(current, SCHED_RR);
+      } else {
+        EXPECT_EQ(current, granted.policy == RealtimePolicy::Fifo ? SCHED_FIFO : SCHED_RR);
+        EXPECT_EQ(param.sched_priority, granted.priority);
+      }
+#else
+      (void)granted;
+#endif
+    });
+    EXPECT_EQ(report.requestedPolicy, policy);
+    EXPECT_EQ(report.name, "test");
+    if (report.policy == RealtimePolicy::None) {
+      EXPECT_EQ(report.priority, 0); // Refused: the thread still runs, unchanged
+    } else {
+      EXPECT_GE(report.priority, 1);
+      EXPECT_LE(report.priority, 99);
+    }
+  }
+}
+
+TEST(RealtimeThreadTest, NonePolicyLeavesSchedulingUnchanged) {
+  auto config = threadOnly();
+  config.policy = RealtimePolicy::None;
+  auto report = onNewThread(config, [](const RealtimeThreadReport&) {});
+  EXPECT_EQ(report.policy, RealtimePolicy::None);
+  EXPECT_EQ(report.priority, 0);
+  EXPECT_EQ(report.cpu, -1);
+  EXPECT_EQ(report.memoryLock, MemoryLock::None);
+}
+
+#if defined(__linux__)
+TEST(RealtimeThreadTest, PinsToTheRequestedCpu) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  int cpu = 0;
+  while (cpu < CPU_SETSIZE && !CPU_ISSET(static_cast<size_t>(cpu), &allowed)) {
+    ++cpu;
+  }
+  ASSERT_LT(cpu, CPU_SETSIZE);
+
+  auto config = threadOnly();
+  config.policy = RealtimePolicy::None;
+  config.cpu = cpu;
+  auto report = onNewThread(config, [&](const RealtimeThreadReport&) {
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(sched_getcpu(), cpu);
+      std::this_thread::yield();
+    }
+  });
+  EXPECT_EQ(report.cpu, cpu);
+
+  // An unavailable CPU is reported as not pinned rather than failing
+  config.cpu = CPU_SETSIZE + 1;
+  EXPECT_EQ(onNewThread(config, [](const RealtimeThreadReport&) {}).cpu, -1);
+}
+#endif
+
+// ============================================================================
+// Denormals
+// ============================================================================
+
+TEST(RealtimeThreadTest, FlushesDenormalsOnTheConfiguredThreadOnly) {
+  auto config = threadOnly();
+  config.policy = RealtimePolicy::None;
+  auto report = onNewThread(config, [](const RealtimeThreadReport& granted) {
+    if (granted.denormalsFlushed) {
+      EXPECT_EQ(denormalTimesOne(), 0.0f);
+    }
+  });
+#if defined(__SSE__) || defined(_M_X64) || defined(__aarch64__)
+  EXPECT_TRUE(report.denormalsFlushed);
+#endif
+  EXPECT_GT(denormalTimesOne(), 0.0f); // This thread is untouched
+
+  config.flushDenormals = false;
+  report = onNewThread(config, [](const RealtimeThreadReport&) {
+    EXPECT_GT(denormalTimesOne(), 0.0f);
+  });
+  EXPECT_FALSE(report.denormalsFlushed);
+}
+
+// ============================================================================
+// Pre-faulting
+// ============================================================================
+
+TEST(RealtimeThreadTest, PrefaultKeepsContents) {
+  std::vector<uint8_t> buffer(3 * 4096 + 123);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<uint8_t>(i * 13);
+  }
+  auto expected = buffer;
+  prefaultMemory(buffer.data() + 7, buffer.size() - 7); // Unaligned start and length
+  prefaultMemory(buffer.data(), 0);
+  prefaultMemory(nullptr, 100);
+  EXPECT_EQ(std::memcmp(buffer.data(), expected.data(), buffer.size()), 0);
+}
+
+TEST(RealtimeThreadTest, StackPrefaultIsBounded) {
+  auto config = threadOnly();
+  config.policy = RealtimePolicy::None;
+  config.prefaultStackBytes = 0;
+  EXPECT_EQ(onNewThread(config, [](const RealtimeThreadReport&) {}).prefaultedStackBytes, 0u);
+
+  config.prefaultStackBytes = 100 * 1024;
+  auto report = onNewThread(config, [](const RealtimeThreadReport&) {});
+  EXPECT_GE(report.prefaultedStackBytes, 100u * 1024);
+
+  config.prefaultStackBytes = 64 * 1024 * 1024; // Larger than any thread's stack: clamped
+  report = onNewThread(config, [](const RealtimeThreadReport&) {});
+  EXPECT_GT(report.prefaultedStackBytes, 0u);
+  EXPECT_LE(report.prefaultedStackBytes, 512u * 1024);
+}
+
+// ============================================================================
+// Deadline misses
+// ============================================================================
+
+TEST(RealtimeThreadTest, ThreadCpuTimeExcludesSleeping) {
+  const auto wall_start = std::chrono::steady_clock::now();
+  const int64_t start = threadCpuTimeNs();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  const int64_t slept = threadCpuTimeNs() - start;
+  EXPECT_LT(slept, 20'000'000); // Blocked, not running
+
+  const int64_t spin_start = threadCpuTimeNs();
+  while (std::chrono::steady_clock::now() - wall_start < std::chrono::milliseconds(130)) {
+  }
+  const int64_t spun = threadCpuTimeNs() - spin_start;
+#if !defined(_WIN32)
+  EXPECT_GT(spun, 20'000'000); // Busy for ~100 ms of wall time (less if preempted)
+#endif
+  EXPECT_GE(spun, 0);
+}
+
+TEST(RealtimeThreadTest, DeadlineMissesAreClassifiedByCpuTime) {
+  const int64_t period = 10'000'000;
+  EXPECT_EQ(classifyDeadlineMiss(period + 1, period), UnderrunCause::SlowProcessing);
+  EXPECT_EQ(classifyDeadlineMiss(period, period), UnderrunCause::SlowProcessing);
+  EXPECT_EQ(classifyDeadlineMiss(period - 1, period), UnderrunCause::Preempted);
+  EXPECT_EQ(classifyDeadlineMiss(0, period), UnderrunCause::Preempted);
+}
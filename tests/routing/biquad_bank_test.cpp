@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: MIT
+#include "../../include/orpheus/routing_matrix.h"
+#include "../../src/core/routing/biquad_bank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace orpheus;
+
+class BiquadBankTest : public ::testing::Test {
+protected:
+  static constexpr uint32_t SAMPLE_RATE = 48000;
+  static constexpr size_t BLOCK = 64;
+
+  static std::vector<float> makeSine(size_t frames, float freq, float amplitude = 0.5f) {
+    std::vector<float> data(frames);
+    for (size_t i = 0; i < frames; ++i) {
+      double t = static_cast<double>(i) / SAMPLE_RATE;
+      data[i] = amplitude * static_cast<float>(std::sin(2.0 * 3.14159265358979 * freq * t));
+    }
+    return data;
+  }
+
+  // Run the bank over all lanes in fixed-size blocks
+  static void runBlocks(BiquadBank& bank, std::vector<std::vector<float>>& lanes) {
+    size_t frames = lanes[0].size();
+    std::vector<float*> ptrs(lanes.size());
+    for (size_t offset = 0; offset < frames; offset += BLOCK) {
+      size_t n = std::min(BLOCK, frames - offset);
+      for (size_t l = 0; l < lanes.size(); ++l) {
+        ptrs[l] = lanes[l].data() + offset;
+      }
+      bank.process(ptrs.data(), n);
+    }
+  }
+
+  static float peak(const std::vector<float>& buffer, size_t start) {
+    float p = 0.0f;
+    for (size_t i = start; i < buffer.size(); ++i) {
+      p = std::max(p, std::abs(buffer[i]));
+    }
+    return p;
+  }
+
+  static EqBand makeBand(EqFilterType type, float freq, float gain_db = 0.0f, float q = 0.707f) {
+    EqBand band;
+    band.type = type;
+    band.frequency_hz = freq;
+    band.gain_db = gain_db;
+    band.q = q;
+    return band;
+  }
+};
+
+// ============================================================================
+// Bypass
+// ============================================================================
+
+TEST_F(BiquadBankTest, BypassIsBitExact) {
+  BiquadBank bank(SAMPLE_RATE, 6, BLOCK);
+  std::vector<std::vector<float>> lanes(6, makeSine(4096, 440.0f));
+  auto original = lanes;
+
+  runBlocks(bank, lanes);
+
+  EXPECT_EQ(lanes, original);
+}
+
+TEST_F(BiquadBankTest, BypassAfterActiveBandIsBitExact) {
+  BiquadBank bank(SAMPLE_RATE, 2, BLOCK);
+  ASSERT_TRUE(bank.setBand(0, 1, makeBand(EqFilterType::Peak, 1000.0f, 6.0f)));
+
+  std::vector<std::vector<float>> lanes(2, makeSine(4096, 440.0f));
+  runBlocks(bank, lanes);
+
+  // Back to bypass: after the ramp block the stage is skipped entirely
+  ASSERT_TRUE(bank.setBand(0, 1, EqBand()));
+  std::vector<std::vector<float>> ramp(2, makeSine(BLOCK, 440.0f));
+  runBlocks(bank, ramp);
+
+  lanes.assign(2, makeSine(4096, 440.0f));
+  auto original = lanes;
+  runBlocks(bank, lanes);
+  EXPECT_EQ(lanes, original);
+}
+
+TEST_F(BiquadBankTest, LaneBypassedBesideActiveLaneIsBitExact) {
+  BiquadBank bank(SAMPLE_RATE, 2, BLOCK);
+  ASSERT_TRUE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 200.0f, 12.0f, 4.0f)));
+  ASSERT_TRUE(bank.setBand(1, 0, makeBand(EqFilterType::Peak, 200.0f, 12.0f, 4.0f)));
+  std::vector<std::vector<float>> lanes(2, makeSine(4096, 200.0f));
+  runBlocks(bank, lanes);
+
+  // Lane 1 keeps the stage running for the pack; lane 0 must still pass through untouched
+  ASSERT_TRUE(bank.setBand(0, 0, EqBand()));
+  std::vector<std::vector<float>> ramp(2, makeSine(BLOCK, 200.0f));
+  runBlocks(bank, ramp);
+
+  lanes.assign(2, makeSine(4096, 200.0f));
+  auto original = lanes;
+  runBlocks(bank, lanes);
+  EXPECT_EQ(lanes[0], original[0]);
+}
+
+TEST_F(BiquadBankTest, ReenabledBandStartsFromRest) {
+  BiquadBank bank(SAMPLE_RATE, 2, BLOCK);
+  EqBand resonant = makeBand(EqFilterType::Peak, 200.0f, 12.0f, 8.0f);
+  ASSERT_TRUE(bank.setBand(0, 0, resonant));
+  ASSERT_TRUE(bank.setBand(1, 0, resonant));
+  std::vector<std::vector<float>> lanes(2, makeSine(4096, 200.0f));
+  runBlocks(bank, lanes);
+
+  // Bypass lane 0 for one block, then bring the band straight back
+  ASSERT_TRUE(bank.setBand(0, 0, EqBand()));
+  std::vector<std::vector<float>> block(2, std::vector<float>(BLOCK, 0.0f));
+  block[1] = makeSine(BLOCK, 200.0f);
+  runBlocks(bank, block);
+  ASSERT_TRUE(bank.setBand(0, 0, resonant));
+
+  // Silence in gives silence out: nothing rings on from before the bypass
+  lanes.assign(2, std::vector<float>(1024, 0.0f));
+  lanes[1] = makeSine(1024, 200.0f);
+  runBlocks(bank, lanes);
+  EXPECT_EQ(lanes[0], std::vector<float>(1024, 0.0f));
+}
+
+// ============================================================================
+// Frequency response
+// ============================================================================
+
+TEST_F(BiquadBankTest, HighPassAttenuatesLowFrequencies) {
+  BiquadBank bank(SAMPLE_RATE, 1, BLOCK);
+  ASSERT_TRUE(bank.setBand(0, 0, makeBand(EqFilterType::HighPass, 1000.0f)));
+
+  std::vector<std::vector<float>> low(1, makeSine(SAMPLE_RATE / 2, 50.0f));
+  runBlocks(bank, low);
+  bank.reset();
+  std::vector<std::vector<float>> high(1, makeSine(SAMPLE_RATE / 2, 10000.0f));
+  runBlocks(bank, high);
+
+  // 12 dB/oct: ~4.3 octaves below the corner is ~-52 dB
+  EXPECT_LT(peak(low[0], SAMPLE_RATE / 4), 0.5f * 0.01f);
+  EXPECT_NEAR(peak(high[0], SAMPLE_RATE / 4), 0.5f, 0.01f);
+}
+
+TEST_F(BiquadBankTest, PeakGainAtCentreFrequency) {
+  BiquadBank bank(SAMPLE_RATE, 1, BLOCK);
+  ASSERT_TRUE(bank.setBand(0, 2, makeBand(EqFilterType::Peak, 1000.0f, 6.0f, 1.0f)));
+
+  std::vector<std::vector<float>> lanes(1, makeSine(SAMPLE_RATE / 2, 1000.0f, 0.25f));
+  runBlocks(bank, lanes);
+
+  float gain_db = 20.0f * std::log10(peak(lanes[0], SAMPLE_RATE / 4) / 0.25f);
+  EXPECT_NEAR(gain_db, 6.0f, 0.1f);
+}
+
+TEST_F(BiquadBankTest, CascadedStagesAccumulate) {
+  BiquadBank bank(SAMPLE_RATE, 1, BLOCK);
+  for (size_t stage = 0; stage < BiquadBank::NUM_STAGES; ++stage) {
+    ASSERT_TRUE(bank.setBand(0, stage, makeBand(EqFilterType::Peak, 2000.0f, -3.0f, 1.0f)));
+  }
+
+  std::vector<std::vector<float>> lanes(1, makeSine(SAMPLE_RATE / 2, 2000.0f));
+  runBlocks(bank, lanes);
+
+  float gain_db = 20.0f * std::log10(peak(lanes[0], SAMPLE_RATE / 4) / 0.5f);
+  EXPECT_NEAR(gain_db, -12.0f, 0.2f);
+}
+
+// ============================================================================
+// Lanes
+// ============================================================================
+
+TEST_F(BiquadBankTest, LanesAreIndependent) {
+  // Six lanes span two SIMD packs; only lane 4 is filtered
+  BiquadBank bank(SAMPLE_RATE, 6, BLOCK);
+  ASSERT_TRUE(bank.setBand(4, 0, makeBand(EqFilterType::LowPass, 200.0f)));
+
+  std::vector<std::vector<float>> lanes(6, makeSine(SAMPLE_RATE / 2, 5000.0f));
+  auto original = lanes;
+  runBlocks(bank, lanes);
+
+  for (size_t l = 0; l < 6; ++l) {
+    if (l == 4) {
+      EXPECT_LT(peak(lanes[l], SAMPLE_RATE / 4), 0.01f);
+    } else {
+      EXPECT_EQ(lanes[l], original[l]) << "lane " << l;
+    }
+  }
+}
+
+TEST_F(BiquadBankTest, SetBandAllLanes) {
+  BiquadBank bank(SAMPLE_RATE, 3, BLOCK);
+  ASSERT_TRUE(bank.setBandAllLanes(3, makeBand(EqFilterType::HighShelf, 4000.0f, 6.0f)));
+
+  for (size_t l = 0; l < 3; ++l) {
+    EXPECT_EQ(bank.getBand(l, 3).type, EqFilterType::HighShelf);
+  }
+
+  std::vector<std::vector<float>> lanes(3, makeSine(SAMPLE_RATE / 2, 15000.0f, 0.25f));
+  runBlocks(bank, lanes);
+  for (size_t l = 0; l < 3; ++l) {
+    float gain_db = 20.0f * std::log10(peak(lanes[l], SAMPLE_RATE / 4) / 0.25f);
+    EXPECT_NEAR(gain_db, 6.0f, 0.3f);
+  }
+}
+
+// ============================================================================
+// Parameter changes
+// ============================================================================
+
+TEST_F(BiquadBankTest, CoefficientChangeIsSmooth) {
+  BiquadBank bank(SAMPLE_RATE, 1, BLOCK);
+  ASSERT_TRUE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 1000.0f, -24.0f, 2.0f)));
+
+  std::vector<float> input = makeSine(SAMPLE_RATE, 1000.0f);
+  std::vector<float> output(input.size());
+  float* lane = nullptr;
+
+  size_t switch_at = SAMPLE_RATE / 2;
+  for (size_t offset = 0; offset < input.size(); offset += BLOCK) {
+    if (offset == switch_at) {
+      ASSERT_TRUE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 1000.0f, 24.0f, 2.0f)));
+    }
+    std::copy(input.begin() + static_cast<std::ptrdiff_t>(offset),
+              input.begin() + static_cast<std::ptrdiff_t>(offset + BLOCK),
+              output.begin() + static_cast<std::ptrdiff_t>(offset));
+    lane = output.data() + offset;
+    bank.process(&lane, BLOCK);
+  }
+
+  // Largest sample-to-sample step around the switch stays within a few times
+  // the steady-state step of the loudest setting (no click)
+  float steady_peak = peak(output, output.size() - SAMPLE_RATE / 8);
+  float max_step_steady = steady_peak * 2.0f * 3.14159265f * 1000.0f / SAMPLE_RATE;
+  float max_step = 0.0f;
+  for (size_t i = switch_at - BLOCK; i < switch_at + 4 * BLOCK; ++i) {
+    max_step = std::max(max_step, std::abs(output[i + 1] - output[i]));
+  }
+  EXPECT_LT(max_step, max_step_steady * 1.5f);
+  for (float sample : output) {
+    ASSERT_TRUE(std::isfinite(sample));
+  }
+}
+
+TEST_F(BiquadBankTest, RejectsInvalidBands) {
+  BiquadBank bank(SAMPLE_RATE, 2, BLOCK);
+
+  EXPECT_FALSE(bank.setBand(2, 0, makeBand(EqFilterType::Peak, 1000.0f)));
+  EXPECT_FALSE(bank.setBand(0, BiquadBank::NUM_STAGES, makeBand(EqFilterType::Peak, 1000.0f)));
+  EXPECT_FALSE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 5.0f)));
+  EXPECT_FALSE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 22000.0f)));
+  EXPECT_FALSE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 1000.0f, 30.0f)));
+  EXPECT_FALSE(bank.setBand(0, 0, makeBand(EqFilterType::Peak, 1000.0f, 0.0f, 0.01f)));
+
+  // Bypass is always accepted regardless of its (unused) parameters
+  EXPECT_TRUE(bank.setBand(0, 0, makeBand(EqFilterType::Bypass, 1.0f, 99.0f, 0.0f)));
+}
+
+// ============================================================================
+// Routing matrix integration
+// ============================================================================
+
+TEST_F(BiquadBankTest, RoutingMatrixEqApi) {
+  auto routing = createRoutingMatrix();
+  EqBand hpf = makeBand(EqFilterType::HighPass, 80.0f);
+
+  EXPECT_EQ(routing->setGroupEqBand(0, 0, hpf), SessionGraphError::NotInitialized);
+  EXPECT_EQ(routing->setMasterEqBand(0, hpf), SessionGraphError::NotInitialized);
+
+  RoutingConfig config;
+  config.num_channels = 4;
+  config.num_groups = 4;
+  config.num_outputs = 2;
+  config.enable_clipping_protection = false;
+  ASSERT_EQ(routing->initialize(config), SessionGraphError::OK);
+
+  EXPECT_EQ(routing->setGroupEqBand(0, 0, hpf), SessionGraphError::OK);
+  EXPECT_EQ(routing->setGroupEqBand(4, 0, hpf), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(routing->setGroupEqBand(0, MAX_EQ_BANDS, hpf), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(routing->setMasterEqBand(MAX_EQ_BANDS, hpf), SessionGraphError::InvalidParameter);
+  hpf.frequency_hz = 1.0f;
+  EXPECT_EQ(routing->setMasterEqBand(0, hpf), SessionGraphError::InvalidParameter);
+}
+
+TEST_F(BiquadBankTest, RoutingMatrixAppliesGroupAndMasterEq) {
+  auto routing = createRoutingMatrix();
+  RoutingConfig config;
+  config.num_channels = 2;
+  config.num_groups = 2;
+  config.num_outputs = 2;
+  config.gain_smoothing_ms = 0.0f;
+  config.enable_clipping_protection = false;
+  ASSERT_EQ(routing->initialize(config), SessionGraphError::OK);
+  ASSERT_EQ(routing->setChannelGroup(1, 1), SessionGraphError::OK);
+
+  // Group 1 low-pass removes channel 1's 5 kHz tone; group 0 passes channel 0
+  ASSERT_EQ(routing->setGroupEqBand(1, 0, makeBand(EqFilterType::LowPass, 200.0f)),
+            SessionGraphError::OK);
+
+  std::vector<float> tone0 = makeSine(SAMPLE_RATE / 2, 100.0f, 0.25f);
+  std::vector<float> tone1 = makeSine(SAMPLE_RATE / 2, 5000.0f, 0.25f);
+  std::vector<float> left(tone0.size()), right(tone0.size());
+
+  auto run = [&]() {
+    for (size_t offset = 0; offset < tone0.size(); offset += BLOCK) {
+      const float* inputs[2] = {tone0.data() + offset, tone1.data() + offset};
+      float* outputs[2] = {left.data() + offset, right.data() + offset};
+      routing->processRouting(inputs, outputs, BLOCK);
+    }
+  };
+
+  run();
+  EXPECT_NEAR(peak(left, SAMPLE_RATE / 4), 0.25f, 0.01f);
+
+  // Master high-pass then removes the remaining 100 Hz tone
+  ASSERT_EQ(routing->setMasterEqBand(0, makeBand(EqFilterType::HighPass, 2000.0f)),
+            SessionGraphError::OK);
+  run();
+  EXPECT_LT(peak(left, SAMPLE_RATE / 4), 0.01f);
+  EXPECT_LT(peak(right, SAMPLE_RATE / 4), 0.01f);
+}
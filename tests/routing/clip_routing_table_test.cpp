@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: MIT
+#include "routing/clip_routing.h"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+using namespace orpheus;
+
+class ClipRoutingTableTest : public ::testing::Test {
+protected:
+  static constexpr uint32_t SAMPLE_RATE = 48000;
+
+  void SetUp() override {
+    routing = std::make_unique<ClipRoutingMatrix>(nullptr, SAMPLE_RATE);
+  }
+
+  std::unique_ptr<ClipRoutingMatrix> routing;
+};
+
+// ============================================================================
+// Table Publishing
+// ============================================================================
+
+TEST_F(ClipRoutingTableTest, InitialTableIsEmpty) {
+  const ClipRoutingTable* table = routing->acquireTable();
+  ASSERT_NE(table, nullptr);
+  EXPECT_EQ(table->num_slots, 0u);
+  EXPECT_EQ(table->findSlot(1001), ClipRoutingTable::INVALID_SLOT);
+
+  // Unrouted clips get the default route
+  const ClipRoute& route = table->route(ClipRoutingTable::INVALID_SLOT);
+  EXPECT_EQ(route.group, ClipRoute::NO_GROUP);
+  EXPECT_EQ(route.output_bus, 0);
+  EXPECT_EQ(route.channel_map[0], ClipRoute::FOLLOW_BUS);
+}
+
+TEST_F(ClipRoutingTableTest, AcquirePicksUpLatestTable) {
+  const ClipRoutingTable* before = routing->acquireTable();
+
+  ASSERT_EQ(routing->assignClipToGroup(1001, 2), SessionGraphError::OK);
+  ASSERT_EQ(routing->setClipOutputBus(1001, 3), SessionGraphError::OK);
+  ASSERT_EQ(routing->mapChannels(1001, 1, 7), SessionGraphError::OK);
+
+  const ClipRoutingTable* table = routing->acquireTable();
+  EXPECT_NE(table, before);
+
+  uint32_t slot = table->findSlot(1001);
+  ASSERT_NE(slot, ClipRoutingTable::INVALID_SLOT);
+  EXPECT_EQ(table->route(slot).group, 2);
+  EXPECT_EQ(table->route(slot).output_bus, 3);
+  EXPECT_EQ(table->route(slot).channel_map[0], ClipRoute::FOLLOW_BUS);
+  EXPECT_EQ(table->route(slot).channel_map[1], 7);
+
+  // No new publish: the same table is returned
+  EXPECT_EQ(routing->acquireTable(), table);
+}
+
+TEST_F(ClipRoutingTableTest, ReassignmentKeepsSlot) {
+  ASSERT_EQ(routing->assignClipToGroup(1001, 0), SessionGraphError::OK);
+  ASSERT_EQ(routing->assignClipToGroup(1002, 1), SessionGraphError::OK);
+  uint32_t slot = routing->acquireTable()->findSlot(1001);
+
+  ASSERT_EQ(routing->assignClipToGroup(1001, 3), SessionGraphError::OK);
+  const ClipRoutingTable* table = routing->acquireTable();
+
+  EXPECT_EQ(table->findSlot(1001), slot);
+  EXPECT_EQ(table->route(slot).group, 3);
+  EXPECT_EQ(table->route(table->findSlot(1002)).group, 1);
+}
+
+TEST_F(ClipRoutingTableTest, ResolvesManyHandles) {
+  for (ClipHandle handle = 1; handle <= 1000; ++handle) {
+    ASSERT_EQ(routing->assignClipToGroup(handle, static_cast<uint8_t>(handle % 4)),
+              SessionGraphError::OK);
+  }
+
+  const ClipRoutingTable* table = routing->acquireTable();
+  ASSERT_EQ(table->num_slots, 1000u);
+  EXPECT_GE(table->index->keys.size(), 2000u);
+
+  for (ClipHandle handle = 1; handle <= 1000; ++handle) {
+    uint32_t slot = table->findSlot(handle);
+    ASSERT_NE(slot, ClipRoutingTable::INVALID_SLOT);
+    EXPECT_EQ(table->route(slot).group, handle % 4);
+  }
+  EXPECT_EQ(table->findSlot(1001), ClipRoutingTable::INVALID_SLOT);
+  EXPECT_EQ(table->findSlot(0), ClipRoutingTable::INVALID_SLOT);
+}
+
+TEST_F(ClipRoutingTableTest, DefaultRouteFreesSlotForReuse) {
+  ASSERT_EQ(routing->assignClipToGroup(1001, 2), SessionGraphError::OK);
+  ASSERT_EQ(routing->assignClipToGroup(1002, 1), SessionGraphError::OK);
+  uint32_t freed = routing->acquireTable()->findSlot(1001);
+
+  // Unassigning restores the default route, so 1001 gives its slot up
+  ASSERT_EQ(routing->assignClipToGroup(1001, ClipRoute::NO_GROUP), SessionGraphError::OK);
+  const ClipRoutingTable* table = routing->acquireTable();
+  EXPECT_EQ(table->findSlot(1001), ClipRoutingTable::INVALID_SLOT);
+  EXPECT_EQ(table->route(freed).group, ClipRoute::NO_GROUP);
+
+  ASSERT_EQ(routing->setClipOutputBus(1003, 5), SessionGraphError::OK);
+  table = routing->acquireTable();
+  EXPECT_EQ(table->findSlot(1003), freed);
+  EXPECT_EQ(table->num_slots, 2u);
+  EXPECT_EQ(table->route(freed).output_bus, 5);
+  EXPECT_EQ(table->route(freed).group, ClipRoute::NO_GROUP);
+  EXPECT_EQ(table->route(table->findSlot(1002)).group, 1);
+}
+
+TEST_F(ClipRoutingTableTest, PublishCopiesOnlyChangedPages) {
+  const ClipHandle clips = ClipRoutingTable::PAGE_SLOTS * 3;
+  for (ClipHandle handle = 1; handle <= clips; ++handle) {
+    ASSERT_EQ(routing->assignClipToGroup(handle, 0), SessionGraphError::OK);
+  }
+  const ClipRoutingTable* before = routing->acquireTable();
+  ASSERT_EQ(before->pages.size(), 3u);
+
+  // Rerouting one clip replaces its page and keeps the slot index
+  ASSERT_EQ(routing->assignClipToGroup(1, 3), SessionGraphError::OK);
+  const ClipRoutingTable* after = routing->acquireTable();
+  ASSERT_NE(after, before);
+  uint32_t slot = after->findSlot(1);
+  uint32_t page = slot >> ClipRoutingTable::PAGE_SHIFT;
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(after->pages[i] == before->pages[i], i != page) << i;
+  }
+  EXPECT_EQ(after->index, before->index);
+  EXPECT_EQ(after->route(slot).group, 3);
+  EXPECT_EQ(before->route(slot).group, 0); // Still intact for the audio thread
+}
+
+TEST_F(ClipRoutingTableTest, LastAssignmentReachesAudioThreadSwappingTables) {
+  // Routed clips make each index rebuild long enough to race the audio thread
+  for (ClipHandle handle = 2; handle <= 2000; ++handle) {
+    ASSERT_EQ(routing->assignClipToGroup(handle, 0), SessionGraphError::OK);
+  }
+
+  std::atomic<bool> running{true};
+  std::atomic<int> seen{-1};
+  std::thread audio([&]() {
+    while (running.load()) {
+      const ClipRoutingTable* table = routing->acquireTable();
+      seen.store(table->route(table->findSlot(1)).group);
+      std::this_thread::sleep_for(std::chrono::microseconds(50)); // Buffer period
+    }
+  });
+
+  // Each burst reassigns clip 1 and routes a new clip after it; nothing follows
+  // the last publish, so the audio thread must pick it up on its own
+  int stranded_burst = 0;
+  ClipHandle next = 2001;
+  for (int burst = 1; burst <= 50 && stranded_burst == 0; ++burst) {
+    const auto group = static_cast<uint8_t>(burst % 4);
+    for (int i = 0; i < 3; ++i) {
+      routing->assignClipToGroup(1, group);
+      routing->assignClipToGroup(next++, 1);
+    }
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (seen.load() != group && std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::yield();
+    }
+    if (seen.load() != group) {
+      stranded_burst = burst;
+    }
+  }
+
+  running.store(false);
+  audio.join();
+  EXPECT_EQ(stranded_burst, 0);
+}
+
+TEST_F(ClipRoutingTableTest, UnacquiredTablesAreReplaced) {
+  // Several publishes before the audio thread runs: only the last one is seen
+  for (uint8_t group = 0; group < 4; ++group) {
+    ASSERT_EQ(routing->assignClipToGroup(1001, group), SessionGraphError::OK);
+  }
+
+  const ClipRoutingTable* table = routing->acquireTable();
+  EXPECT_EQ(table->route(table->findSlot(1001)).group, 3);
+}
+
+TEST_F(ClipRoutingTableTest, RejectsClipChannelOutsideTable) {
+  EXPECT_EQ(routing->mapChannels(1001, ClipRoute::MAX_CHANNELS, 0),
+            SessionGraphError::InvalidParameter);
+  EXPECT_EQ(routing->mapChannels(1001, ClipRoute::MAX_CHANNELS - 1, 0), SessionGraphError::OK);
+}
@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: MIT
+#include "../../include/orpheus/routing_matrix.h"
+#include "../../src/core/routing/lookahead_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace orpheus;
+
+class LookaheadLimiterTest : public ::testing::Test {
+protected:
+  static constexpr uint32_t SAMPLE_RATE = 48000;
+  static constexpr size_t BLOCK = 64;
+  static constexpr float CEILING_TOLERANCE = 1e-5f;
+
+  // Sine at a given frequency/amplitude, identical on every channel unless scaled
+  static std::vector<std::vector<float>> makeSine(size_t channels, size_t frames, float freq,
+                                                  float amplitude, float phase = 0.0f) {
+    std::vector<std::vector<float>> data(channels, std::vector<float>(frames));
+    for (size_t ch = 0; ch < channels; ++ch) {
+      for (size_t i = 0; i < frames; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(SAMPLE_RATE);
+        data[ch][i] = amplitude * std::sin(2.0f * 3.14159265f * freq * t + phase);
+      }
+    }
+    return data;
+  }
+
+  // Run the limiter over the whole buffer in fixed-size blocks
+  static void runBlocks(LookaheadLimiter& limiter, std::vector<std::vector<float>>& data,
+                        size_t block) {
+    size_t frames = data[0].size();
+    std::vector<float*> ptrs(data.size());
+    for (size_t offset = 0; offset < frames; offset += block) {
+      size_t n = std::min(block, frames - offset);
+      for (size_t ch = 0; ch < data.size(); ++ch) {
+        ptrs[ch] = data[ch].data() + offset;
+      }
+      limiter.process(ptrs.data(), n);
+    }
+  }
+
+  static float peak(const std::vector<float>& buffer, size_t start = 0) {
+    float p = 0.0f;
+    for (size_t i = start; i < buffer.size(); ++i) {
+      p = std::max(p, std::abs(buffer[i]));
+    }
+    return p;
+  }
+};
+
+// ============================================================================
+// Latency
+// ============================================================================
+
+TEST_F(LookaheadLimiterTest, LatencyMatchesLookahead) {
+  LookaheadLimiter sample_peak(SAMPLE_RATE, 2, BLOCK, -1.0f, 1.0f, 50.0f, false);
+  EXPECT_EQ(sample_peak.getLatencySamples(), 48u);
+
+  LookaheadLimiter true_peak(SAMPLE_RATE, 2, BLOCK, -1.0f, 1.0f, 50.0f, true);
+  EXPECT_EQ(true_peak.getLatencySamples(), 48u + LookaheadLimiter::TRUE_PEAK_DELAY);
+
+  LookaheadLimiter no_lookahead(SAMPLE_RATE, 2, BLOCK, -1.0f, 0.0f, 50.0f, false);
+  EXPECT_EQ(no_lookahead.getLatencySamples(), 0u);
+}
+
+// ============================================================================
+// Transparency Below Threshold
+// ============================================================================
+
+TEST_F(LookaheadLimiterTest, QuietSignalIsDelayedBitExact) {
+  LookaheadLimiter limiter(SAMPLE_RATE, 2, BLOCK, -1.0f, 1.5f, 50.0f, true);
+  const size_t delay = limiter.getLatencySamples();
+
+  auto input = makeSine(2, 4096, 1000.0f, 0.5f);
+  auto output = input;
+  runBlocks(limiter, output, BLOCK);
+
+  for (size_t ch = 0; ch < 2; ++ch) {
+    for (size_t i = 0; i < delay; ++i) {
+      EXPECT_EQ(output[ch][i], 0.0f);
+    }
+    for (size_t i = delay; i < output[ch].size(); ++i) {
+      ASSERT_EQ(output[ch][i], input[ch][i - delay]) << "ch " << ch << " frame " << i;
+    }
+  }
+  EXPECT_FLOAT_EQ(limiter.getGainReductionDb(), 0.0f);
+}
+
+// ============================================================================
+// Ceiling
+// ============================================================================
+
+TEST_F(LookaheadLimiterTest, LoudSignalNeverExceedsCeiling) {
+  const float threshold_db = -1.0f;
+  const float ceiling = std::pow(10.0f, threshold_db / 20.0f);
+  LookaheadLimiter limiter(SAMPLE_RATE, 2, BLOCK, threshold_db, 1.5f, 50.0f, false);
+
+  auto data = makeSine(2, 48000, 440.0f, 4.0f); // +12 dBFS
+  runBlocks(limiter, data, BLOCK);
+
+  EXPECT_LE(peak(data[0]), ceiling + CEILING_TOLERANCE);
+  EXPECT_LE(peak(data[1]), ceiling + CEILING_TOLERANCE);
+  EXPECT_LT(limiter.getGainReductionDb(), -10.0f);
+}
+
+TEST_F(LookaheadLimiterTest, SingleSampleSpikeIsCaught) {
+  const float ceiling = std::pow(10.0f, -1.0f / 20.0f);
+  LookaheadLimiter limiter(SAMPLE_RATE, 1, BLOCK, -1.0f, 1.0f, 50.0f, false);
+
+  std::vector<std::vector<float>> data(1, std::vector<float>(1024, 0.1f));
+  data[0][500] = 8.0f;
+  runBlocks(limiter, data, BLOCK);
+
+  EXPECT_LE(peak(data[0]), ceiling + CEILING_TOLERANCE);
+}
+
+TEST_F(LookaheadLimiterTest, TruePeakModeLimitsInterSamplePeaks) {
+  // fs/4 sine at 45 degrees: samples sit at ±0.707 * A, the true peak is A
+  const float amplitude = 1.2f;
+  auto sample_peak_data = makeSine(1, 4096, SAMPLE_RATE / 4.0f, amplitude, 3.14159265f / 4.0f);
+  auto true_peak_data = sample_peak_data;
+  ASSERT_LT(peak(sample_peak_data[0]), 0.9f);
+
+  LookaheadLimiter sample_peak(SAMPLE_RATE, 1, BLOCK, -1.0f, 1.0f, 50.0f, false);
+  LookaheadLimiter true_peak(SAMPLE_RATE, 1, BLOCK, -1.0f, 1.0f, 50.0f, true);
+  runBlocks(sample_peak, sample_peak_data, BLOCK);
+  runBlocks(true_peak, true_peak_data, BLOCK);
+
+  // Sample-peak detection sees nothing to do; true-peak detection pulls the
+  // reconstructed peak (sample peak * sqrt(2)) down to the ceiling
+  EXPECT_FLOAT_EQ(sample_peak.getGainReductionDb(), 0.0f);
+  const float ceiling = std::pow(10.0f, -1.0f / 20.0f);
+  float settled = peak(true_peak_data[0], 1024);
+  EXPECT_LE(settled * std::sqrt(2.0f), ceiling * 1.02f);
+  EXPECT_LT(true_peak.getGainReductionDb(), -2.0f);
+}
+
+// ============================================================================
+// Linking, Release, Block Size
+// ============================================================================
+
+TEST_F(LookaheadLimiterTest, ChannelsAreLinked) {
+  LookaheadLimiter limiter(SAMPLE_RATE, 2, BLOCK, -1.0f, 1.5f, 50.0f, false);
+
+  auto data = makeSine(2, 8192, 440.0f, 2.0f);
+  for (auto& sample : data[1]) {
+    sample *= 0.25f; // Right channel well below threshold on its own
+  }
+  runBlocks(limiter, data, BLOCK);
+
+  // Same gain on both channels keeps the level ratio
+  for (size_t i = 4096; i < data[0].size(); ++i) {
+    if (std::abs(data[0][i]) > 0.1f) {
+      ASSERT_NEAR(data[1][i] / data[0][i], 0.25f, 1e-4f) << "frame " << i;
+    }
+  }
+}
+
+TEST_F(LookaheadLimiterTest, ReleasesBackToUnity) {
+  LookaheadLimiter limiter(SAMPLE_RATE, 1, BLOCK, -1.0f, 1.0f, 10.0f, false);
+  const size_t delay = limiter.getLatencySamples();
+
+  // Loud burst followed by a long quiet tail
+  auto data = makeSine(1, 48000, 440.0f, 0.25f);
+  for (size_t i = 0; i < 2400; ++i) {
+    data[0][i] *= 8.0f;
+  }
+  auto input = data;
+  runBlocks(limiter, data, BLOCK);
+
+  // After ~20 release time constants the tail must be untouched again
+  for (size_t i = 24000; i < data[0].size(); ++i) {
+    ASSERT_EQ(data[0][i], input[0][i - delay]) << "frame " << i;
+  }
+  EXPECT_FLOAT_EQ(limiter.getGainReductionDb(), 0.0f);
+}
+
+TEST_F(LookaheadLimiterTest, OutputIndependentOfBlockSize) {
+  auto small = makeSine(2, 8192, 220.0f, 3.0f);
+  auto large = small;
+
+  LookaheadLimiter limiter_small(SAMPLE_RATE, 2, 2048, -1.0f, 1.5f, 50.0f, true);
+  LookaheadLimiter limiter_large(SAMPLE_RATE, 2, 2048, -1.0f, 1.5f, 50.0f, true);
+  runBlocks(limiter_small, small, 32);
+  runBlocks(limiter_large, large, 1000);
+
+  for (size_t ch = 0; ch < 2; ++ch) {
+    for (size_t i = 0; i < small[ch].size(); ++i) {
+      ASSERT_FLOAT_EQ(small[ch][i], large[ch][i]) << "ch " << ch << " frame " << i;
+    }
+  }
+}
+
+// ============================================================================
+// Routing Matrix Integration
+// ============================================================================
+
+TEST_F(LookaheadLimiterTest, RoutingMatrixReportsLatency) {
+  auto matrix = createRoutingMatrix();
+
+  RoutingConfig config;
+  config.num_channels = 4;
+  config.num_groups = 2;
+  config.limiter_lookahead_ms = 2.0f;
+  config.limiter_true_peak = false;
+  ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+  EXPECT_EQ(matrix->getLatencySamples(), 96u);
+
+  config.enable_clipping_protection = false;
+  ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+  EXPECT_EQ(matrix->getLatencySamples(), 0u);
+
+  config.limiter_lookahead_ms = 50.0f;
+  EXPECT_EQ(matrix->initialize(config), SessionGraphError::InvalidParameter);
+}
+
+TEST_F(LookaheadLimiterTest, RoutingMatrixLimitsSummedChannels) {
+  auto matrix = createRoutingMatrix();
+
+  RoutingConfig config;
+  config.num_channels = 4;
+  config.num_groups = 1;
+  config.gain_smoothing_ms = 1.0f;
+  ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+
+  // Four in-phase channels at 0.8 sum to +10 dBFS on the master
+  auto inputs = makeSine(4, 512, 440.0f, 0.8f);
+  std::vector<const float*> input_ptrs;
+  for (auto& channel : inputs) {
+    input_ptrs.push_back(channel.data());
+  }
+  std::vector<std::vector<float>> outputs(2, std::vector<float>(512));
+  std::vector<float*> output_ptrs = {outputs[0].data(), outputs[1].data()};
+
+  const float ceiling = std::pow(10.0f, config.limiter_threshold_db / 20.0f);
+  for (int block = 0; block < 20; ++block) {
+    ASSERT_EQ(matrix->processRouting(input_ptrs.data(), output_ptrs.data(), 512),
+              SessionGraphError::OK);
+    EXPECT_LE(peak(outputs[0]), ceiling * 1.02f);
+  }
+  EXPECT_LT(matrix->getLimiterGainReductionDb(), -6.0f);
+}
@@ -0,0 +1,448 @@
+// SPDX-License-Identifier: MIT
+#include "../../include/orpheus/performance_monitor.h"
+#include "../../include/orpheus/routing_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Test insert: multiplies every channel by a constant
+class ScaleInsert : public IRoutingInsert {
+public:
+  explicit ScaleInsert(float scale) : m_scale(scale) {}
+
+  void prepare(uint32_t sample_rate, uint32_t max_frames, uint8_t num_channels) override {
+    (void)sample_rate;
+    (void)max_frames;
+    m_prepared_channels = num_channels;
+  }
+
+  void process(float* const* channels, uint8_t num_channels, uint32_t num_frames) override {
+    for (uint8_t ch = 0; ch < num_channels; ++ch) {
+      for (uint32_t i = 0; i < num_frames; ++i) {
+        channels[ch][i] *= m_scale;
+      }
+    }
+  }
+
+  uint8_t m_prepared_channels = 0;
+
+private:
+  float m_scale;
+};
+
+} // namespace
+
+class RoutingGraphTest : public ::testing::Test {
+protected:
+  static constexpr uint32_t BUFFER_SIZE = 64;
+  static constexpr uint8_t NUM_INPUTS = 4;
+
+  void SetUp() override {
+    graph = createRoutingGraph();
+
+    RoutingGraphConfig config;
+    config.max_frames = BUFFER_SIZE;
+    config.num_inputs = NUM_INPUTS;
+    config.num_outputs = 2;
+    ASSERT_EQ(graph->initialize(config), SessionGraphError::OK);
+
+    inputs.assign(NUM_INPUTS, std::vector<float>(BUFFER_SIZE, 0.0f));
+    outputs.assign(2, std::vector<float>(BUFFER_SIZE, 0.0f));
+    for (uint8_t ch = 0; ch < NUM_INPUTS; ++ch) {
+      std::fill(inputs[ch].begin(), inputs[ch].end(), 0.1f * static_cast<float>(ch + 1));
+    }
+  }
+
+  SessionGraphError process() {
+    std::vector<const float*> input_ptrs;
+    for (auto& buffer : inputs) {
+      input_ptrs.push_back(buffer.data());
+    }
+    std::vector<float*> output_ptrs = {outputs[0].data(), outputs[1].data()};
+    return graph->process(input_ptrs.data(), output_ptrs.data(), BUFFER_SIZE);
+  }
+
+  std::unique_ptr<IRoutingGraph> graph;
+  std::vector<std::vector<float>> inputs;
+  std::vector<std::vector<float>> outputs;
+};
+
+// ============================================================================
+// Basic Routing
+// ============================================================================
+
+TEST_F(RoutingGraphTest, ProcessBeforeCommitIsNotInitialized) {
+  EXPECT_EQ(process(), SessionGraphError::NotInitialized);
+}
+
+TEST_F(RoutingGraphTest, InputToMasterDuplicatesMono) {
+  RoutingNodeId in = graph->addInput(1);
+  ASSERT_NE(in, INVALID_ROUTING_NODE);
+  ASSERT_EQ(graph->connect(in, graph->getMasterNode()), SessionGraphError::OK);
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  for (uint32_t i = 0; i < BUFFER_SIZE; ++i) {
+    EXPECT_FLOAT_EQ(outputs[0][i], 0.2f);
+    EXPECT_FLOAT_EQ(outputs[1][i], 0.2f);
+  }
+}
+
+TEST_F(RoutingGraphTest, StereoFoldsDownToMonoBus) {
+  RoutingNodeId in = graph->addInput(0, 2); // 0.1 / 0.2
+  RoutingNodeId mono = graph->addBus("Mono", 1);
+  graph->connect(in, mono);
+  graph->connect(mono, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_NEAR(outputs[0][10], 0.15f, 1e-6f);
+  EXPECT_NEAR(outputs[1][10], 0.15f, 1e-6f);
+}
+
+TEST_F(RoutingGraphTest, NestedSubmixesApplyGains) {
+  RoutingNodeId in0 = graph->addInput(0);
+  RoutingNodeId in1 = graph->addInput(1);
+  RoutingNodeId inner = graph->addBus("Inner", 2);
+  RoutingNodeId outer = graph->addBus("Outer", 2);
+
+  graph->connect(in0, inner);
+  graph->connect(in1, inner);
+  graph->connect(inner, outer, -6.0206f); // x0.5
+  graph->connect(outer, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_NEAR(outputs[0][0], 0.15f, 1e-5f); // (0.1 + 0.2) * 0.5
+
+  RoutingGraphInfo info = graph->getInfo();
+  EXPECT_EQ(info.num_nodes, 3u);
+  EXPECT_EQ(info.num_levels, 3u);
+}
+
+// ============================================================================
+// Aux Sends and Inserts
+// ============================================================================
+
+TEST_F(RoutingGraphTest, PreAndPostInsertSends) {
+  RoutingNodeId in = graph->addInput(3); // 0.4
+  RoutingNodeId group = graph->addBus("Group", 1);
+  RoutingNodeId pre_aux = graph->addBus("Pre", 1);
+  RoutingNodeId post_aux = graph->addBus("Post", 1);
+
+  auto insert = std::make_shared<ScaleInsert>(0.5f);
+  ASSERT_EQ(graph->addInsert(group, insert), SessionGraphError::OK);
+  EXPECT_EQ(insert->m_prepared_channels, 1);
+
+  graph->connect(in, group);
+  graph->connect(group, pre_aux, 0.0f, SendTap::PreInsert);
+  graph->connect(group, post_aux, 0.0f, SendTap::PostInsert);
+  graph->connect(pre_aux, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_NEAR(outputs[0][0], 0.4f, 1e-6f); // Pre-insert tap ignores the insert
+
+  graph->disconnect(pre_aux, graph->getMasterNode());
+  graph->connect(post_aux, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_NEAR(outputs[0][0], 0.2f, 1e-6f); // Post-insert tap
+}
+
+TEST_F(RoutingGraphTest, MasterInsertRunsLast) {
+  RoutingNodeId in = graph->addInput(0);
+  graph->connect(in, graph->getMasterNode());
+  graph->addInsert(graph->getMasterNode(), std::make_shared<ScaleInsert>(2.0f));
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_FLOAT_EQ(outputs[0][5], 0.2f);
+}
+
+TEST_F(RoutingGraphTest, SendGainRampsWithoutRecompile) {
+  RoutingNodeId in = graph->addInput(0); // 0.1
+  graph->connect(in, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+  ASSERT_EQ(process(), SessionGraphError::OK);
+
+  ASSERT_EQ(graph->setSendGain(in, graph->getMasterNode(), -100.0f), SessionGraphError::OK);
+  ASSERT_EQ(process(), SessionGraphError::OK);
+
+  // Linear ramp 1 → 0 across the block, reaching the target on the last frame
+  EXPECT_GT(outputs[0][0], 0.09f);
+  EXPECT_LT(outputs[0][BUFFER_SIZE / 2], 0.06f);
+  EXPECT_FLOAT_EQ(outputs[0][BUFFER_SIZE - 1], 0.0f);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_FLOAT_EQ(outputs[0][0], 0.0f);
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+TEST_F(RoutingGraphTest, CycleIsRejected) {
+  RoutingNodeId a = graph->addBus("A", 1);
+  RoutingNodeId b = graph->addBus("B", 1);
+  graph->connect(a, b);
+  graph->connect(b, a);
+  graph->connect(b, graph->getMasterNode());
+
+  EXPECT_EQ(graph->commit(), SessionGraphError::InvalidParameter);
+}
+
+TEST_F(RoutingGraphTest, InvalidConnectionsAreRejected) {
+  RoutingNodeId in = graph->addInput(0);
+  RoutingNodeId bus = graph->addBus("Bus", 2);
+
+  EXPECT_EQ(graph->connect(bus, bus), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(graph->connect(bus, in), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(graph->connect(graph->getMasterNode(), bus), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(graph->connect(in, 9999), SessionGraphError::InvalidHandle);
+  EXPECT_EQ(graph->connect(in, bus), SessionGraphError::OK);
+  EXPECT_EQ(graph->connect(in, bus), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(graph->addInput(NUM_INPUTS - 1, 2), INVALID_ROUTING_NODE);
+  EXPECT_EQ(graph->addInsert(in, std::make_shared<ScaleInsert>(1.0f)),
+            SessionGraphError::InvalidParameter);
+}
+
+TEST_F(RoutingGraphTest, ParallelBranchesShareALevel) {
+  RoutingNodeId master = graph->addBus("Sub", 2);
+  graph->connect(master, graph->getMasterNode());
+  for (uint8_t ch = 0; ch < NUM_INPUTS; ++ch) {
+    RoutingNodeId in = graph->addInput(ch);
+    RoutingNodeId bus = graph->addBus("Branch", 2);
+    graph->connect(in, bus);
+    graph->connect(bus, master);
+  }
+  graph->addBus("Unconnected", 2);
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  RoutingGraphInfo info = graph->getInfo();
+  EXPECT_EQ(info.num_nodes, 6u); // Unconnected bus pruned
+  EXPECT_EQ(info.num_levels, 3u);
+  EXPECT_EQ(info.max_level_width, NUM_INPUTS);
+}
+
+TEST_F(RoutingGraphTest, ChainReusesBuffers) {
+  RoutingNodeId in = graph->addInput(0);
+  RoutingNodeId previous = in;
+  for (int i = 0; i < 8; ++i) {
+    RoutingNodeId bus = graph->addBus("Chain", 1);
+    graph->connect(previous, bus);
+    previous = bus;
+  }
+  graph->connect(previous, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  // Each link only needs its own buffer and its source's
+  EXPECT_EQ(graph->getInfo().num_channel_buffers, 2u);
+
+  ASSERT_EQ(process(), SessionGraphError::OK);
+  EXPECT_FLOAT_EQ(outputs[0][0], 0.1f);
+}
+
+// ============================================================================
+// Parallel Execution and Schedule Swap
+// ============================================================================
+
+TEST_F(RoutingGraphTest, WorkerPoolMatchesSingleThreaded) {
+  auto build = [&](IRoutingGraph& target) {
+    RoutingNodeId sub = target.addBus("Sub", 2);
+    target.connect(sub, target.getMasterNode());
+    for (uint8_t ch = 0; ch < NUM_INPUTS; ++ch) {
+      RoutingNodeId in = target.addInput(ch);
+      RoutingNodeId bus = target.addBus("Branch", 2);
+      target.addInsert(bus, std::make_shared<ScaleInsert>(0.5f + 0.1f * ch));
+      target.connect(in, bus);
+      target.connect(bus, sub, -3.0f);
+    }
+    return target.commit();
+  };
+
+  ASSERT_EQ(build(*graph), SessionGraphError::OK);
+
+  auto pool = createRoutingWorkerPool(2);
+  EXPECT_EQ(pool->getWorkerCount(), 2u);
+
+  auto parallel = createRoutingGraph();
+  RoutingGraphConfig config;
+  config.max_frames = BUFFER_SIZE;
+  config.num_inputs = NUM_INPUTS;
+  ASSERT_EQ(parallel->initialize(config), SessionGraphError::OK);
+  parallel->setWorkerPool(pool.get());
+  ASSERT_EQ(build(*parallel), SessionGraphError::OK);
+
+  std::vector<const float*> input_ptrs;
+  for (auto& buffer : inputs) {
+    input_ptrs.push_back(buffer.data());
+  }
+  std::vector<std::vector<float>> parallel_out(2, std::vector<float>(BUFFER_SIZE));
+  std::vector<float*> parallel_ptrs = {parallel_out[0].data(), parallel_out[1].data()};
+
+  for (int block = 0; block < 200; ++block) {
+    ASSERT_EQ(process(), SessionGraphError::OK);
+    ASSERT_EQ(parallel->process(input_ptrs.data(), parallel_ptrs.data(), BUFFER_SIZE),
+              SessionGraphError::OK);
+    for (uint32_t i = 0; i < BUFFER_SIZE; ++i) {
+      ASSERT_FLOAT_EQ(outputs[0][i], parallel_out[0][i]);
+      ASSERT_FLOAT_EQ(outputs[1][i], parallel_out[1][i]);
+    }
+  }
+}
+
+TEST_F(RoutingGraphTest, CommitWhileProcessing) {
+  RoutingNodeId in = graph->addInput(0);
+  graph->connect(in, graph->getMasterNode());
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  std::atomic<bool> running{true};
+  std::atomic<int> blocks{0};
+  std::atomic<bool> failed{false};
+
+  std::thread audio([&]() {
+    std::vector<const float*> input_ptrs;
+    for (auto& buffer : inputs) {
+      input_ptrs.push_back(buffer.data());
+    }
+    std::vector<std::vector<float>> out(2, std::vector<float>(BUFFER_SIZE));
+    std::vector<float*> out_ptrs = {out[0].data(), out[1].data()};
+    while (running.load()) {
+      if (graph->process(input_ptrs.data(), out_ptrs.data(), BUFFER_SIZE) !=
+          SessionGraphError::OK) {
+        failed.store(true);
+      }
+      blocks.fetch_add(1);
+    }
+  });
+
+  // Toggle a submix in and out of the path
+  for (int i = 0; i < 200; ++i) {
+    RoutingNodeId bus = graph->addBus("Temp", 2);
+    graph->connect(in, bus);
+    graph->connect(bus, graph->getMasterNode());
+    ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+    graph->removeNode(bus);
+    ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+  }
+
+  while (blocks.load() < 10) {
+    std::this_thread::yield();
+  }
+  running.store(false);
+  audio.join();
+
+  EXPECT_FALSE(failed.load());
+}
+
+TEST_F(RoutingGraphTest, LastCommitReachesAudioThreadSwappingSchedules) {
+  RoutingNodeId in = graph->addInput(0); // 0.1
+  RoutingNodeId bus = graph->addBus("Level", 1);
+  graph->connect(in, bus);
+  graph->connect(bus, graph->getMasterNode());
+  // Silent buses make each compile long enough for the audio thread to run during it
+  for (int i = 0; i < 200; ++i) {
+    graph->connect(graph->addBus("Idle", 1), graph->getMasterNode());
+  }
+  ASSERT_EQ(graph->commit(), SessionGraphError::OK);
+
+  std::atomic<bool> running{true};
+  std::atomic<float> level{0.0f};
+  std::thread audio([&]() {
+    std::vector<const float*> input_ptrs;
+    for (auto& buffer : inputs) {
+      input_ptrs.push_back(buffer.data());
+    }
+    std::vector<std::vector<float>> out(2, std::vector<float>(BUFFER_SIZE));
+    std::vector<float*> out_ptrs = {out[0].data(), out[1].data()};
+    while (running.load()) {
+      graph->process(input_ptrs.data(), out_ptrs.data(), BUFFER_SIZE);
+      level.store(out[0][BUFFER_SIZE - 1]);
+    }
+  });
+
+  // Each burst ends with a distinct insert chain; no edit follows it, so the
+  // audio thread must pick the last commit up on its own
+  int stranded_burst = 0;
+  for (int burst = 1; burst <= 50 && stranded_burst == 0; ++burst) {
+    for (int i = 0; i < 4; ++i) {
+      graph->clearInserts(bus);
+      graph->addInsert(bus, std::make_shared<ScaleInsert>(static_cast<float>(burst + i)));
+      graph->commit();
+    }
+    const float expected = 0.1f * static_cast<float>(burst + 3);
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::abs(level.load() - expected) > 1e-4f &&
+           std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::yield();
+    }
+    if (std::abs(level.load() - expected) > 1e-4f) {
+      stranded_burst = burst;
+    }
+  }
+
+  running.store(false);
+  audio.join();
+  EXPECT_EQ(stranded_burst, 0);
+}
+
+TEST_F(RoutingGraphTest, RealtimeWorkerPoolReportsEachWorker) {
+  RealtimeThreadConfig realtime;
+  realtime.name = "routing-worker";
+  realtime.policy = RealtimePolicy::None;
+  realtime.lockMemory = false;
+  auto monitor = createPerformanceMonitor(nullptr);
+  auto pool = createRoutingWorkerPool(2, realtime, monitor.get());
+  ASSERT_EQ(pool->getWorkerCount(), 2u);
+
+  // Every worker was set up before the pool was returned
+  auto threads = monitor->getRealtimeThreads();
+  ASSERT_EQ(threads.size(), 2u);
+  std::vector<std::string> names{threads[0].name, threads[1].name};
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ(names, (std::vector<std::string>{"routing-worker-0", "routing-worker-1"}));
+
+  // Workers still run tasks
+  std::atomic<int> ran{0};
+  pool->run([](void* context, size_t) { static_cast<std::atomic<int>*>(context)->fetch_add(1); },
+            &ran, 8);
+  EXPECT_EQ(ran.load(), 8);
+}
+
+TEST_F(RoutingGraphTest, WorkerPoolRunsEveryTaskExactlyOnce) {
+  auto pool = createRoutingWorkerPool(3);
+
+  // More tasks than one published batch, with uneven work so workers fall behind
+  constexpr size_t NUM_TASKS = 1000;
+  std::vector<std::atomic<int>> runs(NUM_TASKS);
+  for (int repeat = 0; repeat < 20; ++repeat) {
+    pool->run(
+        [](void* context, size_t task) {
+          auto& counts = *static_cast<std::vector<std::atomic<int>>*>(context);
+          if (task % 7 == 0) {
+            volatile float sink = 0.0f;
+            for (int i = 0; i < 2000; ++i) {
+              sink = sink + 1.0f;
+            }
+          }
+          counts[task].fetch_add(1);
+        },
+        &runs, NUM_TASKS);
+  }
+
+  for (size_t task = 0; task < NUM_TASKS; ++task) {
+    ASSERT_EQ(runs[task].load(), 20) << "task " << task;
+  }
+}
+
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: MIT
+#include "../../include/orpheus/routing_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace orpheus;
+
+class SnapshotMorphTest : public ::testing::Test {
+protected:
+  static constexpr uint32_t SAMPLE_RATE = 48000;
+  static constexpr uint32_t BLOCK = 64;
+
+  void SetUp() override {
+    matrix = createRoutingMatrix();
+    config.num_channels = 2;
+    config.num_groups = 2;
+    config.num_outputs = 2;
+    config.sample_rate = SAMPLE_RATE;
+    config.enable_clipping_protection = false;
+    ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+    input.assign(BLOCK, 0.5f);
+  }
+
+  // Process blocks with a constant 0.5 on channel 0 only, appending left output
+  void run(size_t blocks) {
+    std::vector<float> silence(BLOCK, 0.0f);
+    std::vector<float> left(BLOCK), right(BLOCK);
+    for (size_t b = 0; b < blocks; ++b) {
+      const float* inputs[2] = {input.data(), silence.data()};
+      float* outputs[2] = {left.data(), right.data()};
+      ASSERT_EQ(matrix->processRouting(inputs, outputs, BLOCK), SessionGraphError::OK);
+      output.insert(output.end(), left.begin(), left.end());
+    }
+  }
+
+  static float maxStep(const std::vector<float>& buffer) {
+    float step = 0.0f;
+    for (size_t i = 1; i < buffer.size(); ++i) {
+      step = std::max(step, std::abs(buffer[i] - buffer[i - 1]));
+    }
+    return step;
+  }
+
+  std::unique_ptr<IRoutingMatrix> matrix;
+  RoutingConfig config;
+  std::vector<float> input;
+  std::vector<float> output;
+};
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+TEST_F(SnapshotMorphTest, CompileFoldsMuteAndSoloIntoLevels) {
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Scene");
+  snapshot.channels[0].gain_db = -6.0f;
+  snapshot.channels[1].group_index = 1;
+  snapshot.channels[1].solo = true;
+  snapshot.groups[1].mute = true;
+  snapshot.master_mute = true;
+
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+
+  EXPECT_EQ(compiled.num_channels, 2);
+  EXPECT_EQ(compiled.num_groups, 2);
+  EXPECT_NEAR(compiled.channel_gains[0], 0.501f, 0.001f);
+  EXPECT_TRUE(compiled.solo_active);
+
+  // Channel 0 is not solo'd, so solo-in-place silences it
+  EXPECT_EQ(compiled.send_levels[0 * 2 + 0], 0.0f);
+  EXPECT_EQ(compiled.send_levels[1 * 2 + 0], 0.0f);
+  EXPECT_EQ(compiled.send_levels[1 * 2 + 1], 1.0f);
+  EXPECT_EQ(compiled.group_levels[1], 0.0f);
+  EXPECT_EQ(compiled.master_level, 0.0f);
+}
+
+TEST_F(SnapshotMorphTest, CompileRejectsMismatchedSnapshot) {
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Scene");
+  CompiledRoutingSnapshot compiled;
+
+  snapshot.channels.pop_back();
+  EXPECT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::InvalidParameter);
+
+  snapshot = matrix->saveSnapshot("Scene");
+  snapshot.channels[0].group_index = 5;
+  EXPECT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::InvalidParameter);
+
+  auto uninitialized = createRoutingMatrix();
+  EXPECT_EQ(uninitialized->compileSnapshot(snapshot, compiled), SessionGraphError::NotInitialized);
+}
+
+TEST_F(SnapshotMorphTest, RecallRejectsInvalidInput) {
+  CompiledRoutingSnapshot compiled;
+  EXPECT_EQ(matrix->recallSnapshot(compiled, 10.0f), SessionGraphError::InvalidParameter);
+
+  ASSERT_EQ(matrix->compileSnapshot(matrix->saveSnapshot("Scene"), compiled),
+            SessionGraphError::OK);
+  EXPECT_EQ(matrix->recallSnapshot(compiled, -1.0f), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(matrix->recallSnapshot(compiled, NAN), SessionGraphError::InvalidParameter);
+  EXPECT_EQ(matrix->recallSnapshot(compiled, 0.0f), SessionGraphError::OK);
+}
+
+// ============================================================================
+// Crossfade
+// ============================================================================
+
+TEST_F(SnapshotMorphTest, GainCrossfadesLinearlyOverRequestedTime) {
+  run(20); // Settle at unity
+  ASSERT_NEAR(output.back(), 0.5f, 1e-6f);
+
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Half");
+  snapshot.channels[0].gain_db = -6.0206f;
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 20.0f), SessionGraphError::OK); // 960 frames
+  EXPECT_TRUE(matrix->isSnapshotMorphing());
+
+  output.clear();
+  run(30);
+
+  // Linear 0.5 → 0.25 over 960 frames, then held
+  float expected_step = 0.25f / 960.0f;
+  EXPECT_LT(maxStep(output), expected_step * 1.01f);
+  EXPECT_NEAR(output[480], 0.375f, 0.001f);
+  EXPECT_NEAR(output[960], 0.25f, 1e-4f);
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+}
+
+TEST_F(SnapshotMorphTest, GroupReassignmentCrossfades) {
+  ASSERT_EQ(matrix->setGroupGain(1, -6.0206f), SessionGraphError::OK);
+  run(40);
+  ASSERT_NEAR(output.back(), 0.5f, 1e-6f);
+
+  // Move channel 0 from group 0 (unity) to group 1 (-6 dB)
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Move");
+  snapshot.channels[0].group_index = 1;
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 10.0f), SessionGraphError::OK);
+
+  output.clear();
+  run(20);
+
+  EXPECT_LT(maxStep(output), 0.25f / 480.0f * 1.01f);
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+
+  // Regular processing after the crossfade keeps the new routing
+  output.clear();
+  run(4);
+  EXPECT_NEAR(output.front(), 0.25f, 1e-4f);
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+}
+
+TEST_F(SnapshotMorphTest, ExternallyOwnedGroupsSurviveRecall) {
+  // Another component (the transport's clip routing) assigns channel groups
+  config.snapshot_channel_groups = false;
+  matrix = createRoutingMatrix();
+  ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+  ASSERT_EQ(matrix->setGroupGain(1, -6.0206f), SessionGraphError::OK);
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Scene");
+  snapshot.channels[0].group_index = 1;
+  snapshot.channels[0].gain_db = -6.0206f;
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+
+  // The level is recalled into the channel's live group (0, unity)
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 10.0f), SessionGraphError::OK);
+  run(20);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+  EXPECT_EQ(matrix->saveSnapshot("After").channels[0].group_index, 0);
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+
+  // A reassignment during the crossfade is kept when it completes
+  snapshot.channels[0].gain_db = 0.0f;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 10.0f), SessionGraphError::OK);
+  run(1);
+  ASSERT_EQ(matrix->setChannelGroup(0, 1), SessionGraphError::OK);
+  output.clear();
+  run(20);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+  output.clear();
+  run(4);
+  EXPECT_NEAR(output.front(), 0.25f, 1e-4f);
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+  EXPECT_EQ(matrix->saveSnapshot("After").channels[0].group_index, 1);
+
+  // Loading a snapshot directly keeps the live group too
+  snapshot.channels[0].group_index = 0;
+  ASSERT_EQ(matrix->loadSnapshot(snapshot), SessionGraphError::OK);
+  EXPECT_EQ(matrix->saveSnapshot("After").channels[0].group_index, 1);
+}
+
+TEST_F(SnapshotMorphTest, GroupMoveDuringCrossfadeWaitsForCompletion) {
+  config.snapshot_channel_groups = false;
+  matrix = createRoutingMatrix();
+  ASSERT_EQ(matrix->initialize(config), SessionGraphError::OK);
+  ASSERT_EQ(matrix->setGroupGain(1, -6.0206f), SessionGraphError::OK);
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Scene");
+  snapshot.channels[0].gain_db = -6.0206f;
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+
+  // 0.5 → 0.25 over 480 samples; the move must not bend the ramp in either group
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 10.0f), SessionGraphError::OK);
+  run(1);
+  ASSERT_EQ(matrix->setChannelGroup(0, 1), SessionGraphError::OK);
+  run(6);
+  EXPECT_TRUE(matrix->isSnapshotMorphing());
+  EXPECT_LT(maxStep(output), 0.25f / 480.0f * 1.01f);
+  EXPECT_NEAR(output.back(), 0.5f - 0.25f * 447.0f / 480.0f, 1e-4f);
+
+  // Completion moves the channel into its new (-6 dB) group
+  output.clear();
+  run(4);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+  EXPECT_NEAR(output.back(), 0.125f, 1e-4f);
+  EXPECT_EQ(matrix->saveSnapshot("After").channels[0].group_index, 1);
+}
+
+TEST_F(SnapshotMorphTest, MuteAndSoloTakeEffectWhenCrossfadeCompletes) {
+  RoutingSnapshot snapshot = matrix->saveSnapshot("Muted");
+  snapshot.channels[0].mute = true;
+  snapshot.groups[0].solo = true;
+  CompiledRoutingSnapshot compiled;
+  ASSERT_EQ(matrix->compileSnapshot(snapshot, compiled), SessionGraphError::OK);
+  ASSERT_EQ(matrix->recallSnapshot(compiled, 5.0f), SessionGraphError::OK);
+
+  // Live state is untouched until the audio thread finishes the crossfade
+  run(1);
+  EXPECT_TRUE(matrix->isSnapshotMorphing());
+  EXPECT_FALSE(matrix->isChannelMuted(0));
+  EXPECT_FALSE(matrix->isSoloActive());
+
+  run(10);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+  EXPECT_TRUE(matrix->isChannelMuted(0));
+  EXPECT_TRUE(matrix->isSoloActive());
+  EXPECT_FALSE(matrix->isGroupMuted(0));
+  EXPECT_TRUE(matrix->isGroupMuted(1));
+  EXPECT_LT(maxStep(output), 0.5f / 240.0f * 1.01f);
+  EXPECT_EQ(output.back(), 0.0f);
+}
+
+TEST_F(SnapshotMorphTest, InterruptedRecallContinuesFromCurrentMix) {
+  RoutingSnapshot silent = matrix->saveSnapshot("Silent");
+  silent.master_mute = true;
+  RoutingSnapshot full = matrix->saveSnapshot("Full");
+
+  CompiledRoutingSnapshot to_silent, to_full;
+  ASSERT_EQ(matrix->compileSnapshot(silent, to_silent), SessionGraphError::OK);
+  ASSERT_EQ(matrix->compileSnapshot(full, to_full), SessionGraphError::OK);
+
+  run(4);
+  ASSERT_EQ(matrix->recallSnapshot(to_silent, 100.0f), SessionGraphError::OK);
+  run(30); // Part way down
+  float level = output.back();
+  EXPECT_GT(level, 0.0f);
+  EXPECT_LT(level, 0.5f);
+
+  ASSERT_EQ(matrix->recallSnapshot(to_full, 50.0f), SessionGraphError::OK);
+  run(60);
+
+  EXPECT_LT(maxStep(output), 0.5f / 2400.0f * 1.05f);
+  EXPECT_NEAR(output.back(), 0.5f, 1e-5f);
+  EXPECT_FALSE(matrix->isSnapshotMorphing());
+}
+
+TEST_F(SnapshotMorphTest, LatestOfRapidRecallsWins) {
+  RoutingSnapshot quiet = matrix->saveSnapshot("Quiet");
+  quiet.channels[0].gain_db = -20.0f;
+  RoutingSnapshot loud = matrix->saveSnapshot("Loud");
+  loud.channels[0].gain_db = -6.0206f;
+
+  CompiledRoutingSnapshot a, b;
+  ASSERT_EQ(matrix->compileSnapshot(quiet, a), SessionGraphError::OK);
+  ASSERT_EQ(matrix->compileSnapshot(loud, b), SessionGraphError::OK);
+
+  // Both recalled before the audio thread runs: only the latest is applied
+  ASSERT_EQ(matrix->recallSnapshot(a, 1.0f), SessionGraphError::OK);
+  ASSERT_EQ(matrix->recallSnapshot(b, 1.0f), SessionGraphError::OK);
+  run(4);
+
+  EXPECT_NEAR(output.back(), 0.25f, 1e-4f);
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+#include "routing/table_handoff.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace orpheus;
+
+namespace {
+
+struct Table {
+  explicit Table(int id, std::atomic<int>* alive = nullptr) : id(id), alive(alive) {
+    if (alive) {
+      alive->fetch_add(1);
+    }
+  }
+  ~Table() {
+    if (alive) {
+      alive->fetch_sub(1);
+    }
+  }
+
+  int id;
+  std::atomic<int>* alive;
+};
+
+} // namespace
+
+TEST(TableHandoffTest, AudioThreadAdoptsNewestTable) {
+  std::atomic<int> alive{0};
+  {
+    TableHandoff<Table> handoff(new Table(0, &alive));
+    EXPECT_EQ(handoff.acquire()->id, 0);
+    EXPECT_FALSE(handoff.hasPending());
+
+    handoff.publish(std::make_unique<Table>(1, &alive));
+    handoff.publish(std::make_unique<Table>(2, &alive)); // Replaces 1 before the audio thread ran
+    EXPECT_EQ(alive.load(), 2);
+    EXPECT_TRUE(handoff.hasPending());
+    EXPECT_EQ(handoff.acquire()->id, 2);
+    EXPECT_FALSE(handoff.hasPending());
+    EXPECT_EQ(handoff.acquire()->id, 2);
+
+    // The retired table is freed by the publisher, not by acquire()
+    EXPECT_EQ(alive.load(), 2);
+    handoff.reclaim();
+    EXPECT_EQ(alive.load(), 1);
+  }
+  EXPECT_EQ(alive.load(), 0);
+}
+
+TEST(TableHandoffTest, LastPublishIsAdoptedWhileAudioThreadSwaps) {
+  TableHandoff<Table> handoff(new Table(0));
+  std::atomic<bool> running{true};
+  std::atomic<int> seen{0};
+  std::thread audio([&]() {
+    while (running.load(std::memory_order_relaxed)) {
+      seen.store(handoff.acquire()->id, std::memory_order_relaxed);
+    }
+  });
+
+  // Bursts of publishes race the audio thread's swaps; once a burst ends, its
+  // last table must be adopted without any further publish
+  int stranded_burst = 0;
+  for (int burst = 1; burst <= 200 && stranded_burst == 0; ++burst) {
+    const int last = burst * 100 + 19;
+    for (int id = burst * 100; id <= last; ++id) {
+      handoff.publish(std::make_unique<Table>(id));
+    }
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (seen.load(std::memory_order_relaxed) != last &&
+           std::chrono::steady_clock::now() < give_up) {
+      std::this_thread::yield();
+    }
+    if (seen.load(std::memory_order_relaxed) != last) {
+      stranded_burst = burst;
+    }
+  }
+
+  running.store(false);
+  audio.join();
+  EXPECT_EQ(stranded_burst, 0);
+}
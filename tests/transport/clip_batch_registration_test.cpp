@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+#include "seeded_clip_fixture.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <vector>
+
+using namespace orpheus;
+
+// Batch registration is exercised without a real decoder (see SeededClipTest)
+class ClipBatchRegistrationTest : public SeededClipTest {
+protected:
+  /// Seed a file of constant level
+  std::string seedFile(const std::string& name, int64_t frames) {
+    return SeededClipTest::seedFile(name,
+                                    std::vector<float>(static_cast<size_t>(frames) * 2, 0.25f));
+  }
+
+  int64_t registeredDuration(ClipHandle handle) {
+    auto metadata = m_transport->getClipMetadata(handle);
+    return metadata ? metadata->trimOutSamples : -1;
+  }
+};
+
+TEST_F(ClipBatchRegistrationTest, RegistersAllClipsAndReportsPerEntry) {
+  auto intro = seedFile("intro.flac", 4800);
+  auto hit = seedFile("hit.flac", 960);
+
+  std::vector<std::pair<ClipHandle, std::string>> clips = {
+      {1, intro},
+      {2, hit},
+      {3, intro}, // Shares a file with clip 1
+      {0, hit},   // Invalid handle
+      {5, ""},    // Missing path
+      {6, (m_dir / "missing.flac").string()},
+  };
+
+  std::vector<size_t> completedCalls;
+  std::vector<ClipRegistrationResult> completeResults;
+  size_t completeCalls = 0;
+  auto results = m_transport->registerClipsAudio(
+      clips,
+      [&](const ClipRegistrationResult&, size_t completed, size_t total) {
+        EXPECT_EQ(total, clips.size());
+        completedCalls.push_back(completed);
+      },
+      [&](const std::vector<ClipRegistrationResult>& all) {
+        // Runs after the batch is published: every successful clip is registered
+        EXPECT_EQ(registeredDuration(1), 4800);
+        EXPECT_EQ(registeredDuration(3), 4800);
+        completeResults = all;
+        ++completeCalls;
+      });
+
+  ASSERT_EQ(results.size(), clips.size());
+  EXPECT_EQ(results[0].error, SessionGraphError::OK);
+  EXPECT_EQ(results[1].error, SessionGraphError::OK);
+  EXPECT_EQ(results[2].error, SessionGraphError::OK);
+  EXPECT_EQ(results[3].error, SessionGraphError::InvalidHandle);
+  EXPECT_EQ(results[4].error, SessionGraphError::InvalidParameter);
+  EXPECT_NE(results[5].error, SessionGraphError::OK);
+  for (size_t i = 0; i < clips.size(); ++i) {
+    EXPECT_EQ(results[i].handle, clips[i].first);
+  }
+
+  // Progress counts every entry exactly once, ending at the total
+  ASSERT_EQ(completedCalls.size(), clips.size());
+  for (size_t i = 0; i < completedCalls.size(); ++i) {
+    EXPECT_EQ(completedCalls[i], i + 1);
+  }
+
+  // Completion reports the whole batch once
+  EXPECT_EQ(completeCalls, 1u);
+  ASSERT_EQ(completeResults.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(completeResults[i].error, results[i].error);
+  }
+
+  EXPECT_EQ(registeredDuration(1), 4800);
+  EXPECT_EQ(registeredDuration(2), 960);
+  EXPECT_EQ(registeredDuration(3), 4800);
+  EXPECT_FALSE(m_transport->getClipMetadata(6).has_value());
+}
+
+TEST_F(ClipBatchRegistrationTest, ThreadCountDoesNotChangeResults) {
+  std::vector<std::pair<ClipHandle, std::string>> clips;
+  for (ClipHandle h = 1; h <= 24; ++h) {
+    clips.emplace_back(h, seedFile("clip" + std::to_string(h) + ".flac",
+                                   static_cast<int64_t>(100 * h)));
+  }
+
+  for (size_t threads : {size_t{1}, size_t{4}}) {
+    auto results = m_transport->registerClipsAudio(clips, nullptr, nullptr, threads);
+    ASSERT_EQ(results.size(), clips.size());
+    for (size_t i = 0; i < clips.size(); ++i) {
+      EXPECT_EQ(results[i].error, SessionGraphError::OK) << "threads " << threads;
+      EXPECT_EQ(registeredDuration(clips[i].first), static_cast<int64_t>(100 * (i + 1)));
+    }
+  }
+}
+
+TEST_F(ClipBatchRegistrationTest, EmptyBatchIsANoOp) {
+  std::vector<std::pair<ClipHandle, std::string>> clips;
+  bool called = false;
+  bool completed = false;
+  auto results = m_transport->registerClipsAudio(
+      clips, [&](const ClipRegistrationResult&, size_t, size_t) { called = true; },
+      [&](const std::vector<ClipRegistrationResult>& all) { completed = all.empty(); });
+  EXPECT_TRUE(results.empty());
+  EXPECT_FALSE(called);
+  EXPECT_TRUE(completed);
+}
+
+TEST_F(ClipBatchRegistrationTest, BatchAppliesSessionDefaults) {
+  SessionDefaults defaults;
+  defaults.gainDb = -6.0f;
+  defaults.loopEnabled = true;
+  m_transport->setSessionDefaults(defaults);
+
+  std::vector<std::pair<ClipHandle, std::string>> clips = {{7, seedFile("bed.flac", 480)}};
+  ASSERT_EQ(m_transport->registerClipsAudio(clips)[0].error, SessionGraphError::OK);
+
+  auto metadata = m_transport->getClipMetadata(7);
+  ASSERT_TRUE(metadata.has_value());
+  EXPECT_FLOAT_EQ(metadata->gainDb, -6.0f);
+  EXPECT_TRUE(metadata->loopEnabled);
+}
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+#include "seeded_clip_fixture.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace orpheus;
+
+namespace {
+
+/// Records loudness notifications (other events are ignored)
+class LoudnessCallback : public ITransportCallback {
+public:
+  void onClipStarted(ClipHandle, TransportPosition) override {}
+  void onClipStopped(ClipHandle, TransportPosition) override {}
+  void onClipLooped(ClipHandle, TransportPosition) override {}
+  void onBufferUnderrun(TransportPosition) override {}
+  void onClipLoudnessAnalysed(ClipHandle handle, const ClipLoudness& loudness) override {
+    analysed.emplace_back(handle, loudness.integratedLufs);
+  }
+
+  std::vector<std::pair<ClipHandle, double>> analysed;
+};
+
+} // namespace
+
+// Clips are pre-seeded sidecars (see SeededClipTest), so analysis and
+// playback are exercised without libsndfile.
+class ClipLoudnessTest : public SeededClipTest {
+protected:
+  /// Seed a file holding a stereo 1 kHz tone at the given peak level
+  std::string seedTone(const std::string& name, double level_dbfs, int64_t frames = 48000 * 4) {
+    std::vector<float> samples(static_cast<size_t>(frames) * 2);
+    double amplitude = std::pow(10.0, level_dbfs / 20.0);
+    for (size_t i = 0; i < samples.size() / 2; ++i) {
+      double phase = 2.0 * 3.14159265358979323846 * 1000.0 * static_cast<double>(i) / 48000.0;
+      samples[i * 2] = samples[i * 2 + 1] = static_cast<float>(amplitude * std::sin(phase));
+    }
+    return seedFile(name, std::move(samples));
+  }
+
+  /// Start a clip, render a few buffers and return the output peak (then stop it)
+  float playbackPeak(ClipHandle handle) {
+    EXPECT_EQ(m_transport->startClip(handle), SessionGraphError::OK);
+    std::vector<float> left(512, 0.0f);
+    std::vector<float> right(512, 0.0f);
+    float* buffers[2] = {left.data(), right.data()};
+    float peak = 0.0f;
+    for (int b = 0; b < 20; ++b) {
+      m_transport->processAudio(buffers, 2, 512);
+      if (b >= 4) { // Past the limiter look-ahead
+        for (size_t i = 0; i < 512; ++i) {
+          peak = std::max(peak, std::abs(left[i]));
+        }
+      }
+    }
+    m_transport->stopAllClips();
+    for (int b = 0; b < 4; ++b) {
+      m_transport->processAudio(buffers, 2, 512);
+    }
+    return peak;
+  }
+};
+
+TEST_F(ClipLoudnessTest, RegistrationMeasuresLoudness) {
+  LoudnessCallback callback;
+  m_transport->setCallback(&callback);
+  auto tone = seedTone("tone.flac", -20.0);
+  ASSERT_EQ(m_transport->registerClipAudio(1, tone), SessionGraphError::OK);
+  ASSERT_EQ(m_transport->registerClipAudio(2, tone), SessionGraphError::OK); // Same file
+  m_transport->waitForLoudnessAnalysis();
+
+  for (ClipHandle handle : {1, 2}) {
+    auto metadata = m_transport->getClipMetadata(handle);
+    ASSERT_TRUE(metadata && metadata->loudness) << "clip " << handle;
+    EXPECT_NEAR(metadata->loudness->integratedLufs, -20.0, 0.1);
+    EXPECT_NEAR(metadata->loudness->loudnessRangeLu, 0.0, 0.1);
+    EXPECT_NEAR(metadata->loudness->samplePeakDbfs, -20.0, 0.01);
+    EXPECT_GE(metadata->loudness->truePeakDbtp, metadata->loudness->samplePeakDbfs);
+    EXPECT_FALSE(metadata->loudnessTargetLufs.has_value());
+  }
+
+  m_transport->processCallbacks();
+  ASSERT_EQ(callback.analysed.size(), 2u);
+  EXPECT_NEAR(callback.analysed[0].second, -20.0, 0.1);
+
+  // A clip registered later for an already measured file gets the result at once
+  ASSERT_EQ(m_transport->registerClipAudio(3, tone), SessionGraphError::OK);
+  auto metadata = m_transport->getClipMetadata(3);
+  ASSERT_TRUE(metadata && metadata->loudness);
+  EXPECT_NEAR(metadata->loudness->integratedLufs, -20.0, 0.1);
+  m_transport->setCallback(nullptr);
+}
+
+TEST_F(ClipLoudnessTest, TargetIsFoldedIntoClipGain) {
+  auto tone = seedTone("tone.flac", -20.0);
+  ASSERT_EQ(m_transport->registerClipAudio(1, tone), SessionGraphError::OK);
+  m_transport->waitForLoudnessAnalysis();
+  float unnormalised = playbackPeak(1);
+  ASSERT_GT(unnormalised, 0.0f);
+
+  // -20 LUFS clip normalised to -26 LUFS: 6 dB quieter
+  auto metadata = m_transport->getClipMetadata(1);
+  ASSERT_TRUE(metadata);
+  metadata->loudnessTargetLufs = -26.0f;
+  ASSERT_EQ(m_transport->updateClipMetadata(1, *metadata), SessionGraphError::OK);
+  EXPECT_NEAR(20.0 * std::log10(playbackPeak(1) / unnormalised), -6.0, 0.2);
+
+  // User gain still applies on top of the normalisation
+  ASSERT_EQ(m_transport->updateClipGain(1, 3.0f), SessionGraphError::OK);
+  EXPECT_NEAR(20.0 * std::log10(playbackPeak(1) / unnormalised), -3.0, 0.2);
+  EXPECT_EQ(m_transport->getClipMetadata(1)->gainDb, 3.0f);
+
+  metadata->loudnessTargetLufs = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_EQ(m_transport->updateClipMetadata(1, *metadata), SessionGraphError::InvalidParameter);
+}
+
+TEST_F(ClipLoudnessTest, SessionDefaultTargetMatchesClips) {
+  SessionDefaults defaults;
+  defaults.loudnessTargetLufs = -23.0f;
+  m_transport->setSessionDefaults(defaults);
+
+  auto loud = seedTone("loud.flac", -14.0);
+  auto quiet = seedTone("quiet.flac", -30.0);
+  std::vector<std::pair<ClipHandle, std::string>> clips = {{1, loud}, {2, quiet}};
+  m_transport->registerClipsAudio(clips);
+  m_transport->waitForLoudnessAnalysis();
+
+  EXPECT_EQ(m_transport->getClipMetadata(1)->loudnessTargetLufs, -23.0f);
+  float loudPeak = playbackPeak(1);
+  float quietPeak = playbackPeak(2);
+  EXPECT_NEAR(20.0 * std::log10(loudPeak / quietPeak), 0.0, 0.2);
+}
+
+TEST_F(ClipLoudnessTest, SilentFilesAreNotNormalised) {
+  SessionDefaults defaults;
+  defaults.loudnessTargetLufs = -23.0f;
+  m_transport->setSessionDefaults(defaults);
+
+  auto silent = seedTone("silent.flac", -200.0);
+  ASSERT_EQ(m_transport->registerClipAudio(1, silent), SessionGraphError::OK);
+  m_transport->waitForLoudnessAnalysis();
+  auto metadata = m_transport->getClipMetadata(1);
+  ASSERT_TRUE(metadata && metadata->loudness);
+  EXPECT_TRUE(std::isinf(metadata->loudness->integratedLufs));
+  EXPECT_EQ(playbackPeak(1), 0.0f); // No infinite gain
+}
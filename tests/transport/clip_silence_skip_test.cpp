@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+#include "seeded_clip_fixture.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace orpheus;
+
+// Clips are pre-seeded sidecars (see SeededClipTest), so the render path is
+// exercised without libsndfile.
+class ClipSilenceSkipTest : public SeededClipTest {
+protected:
+  static constexpr int64_t SILENT_FRAMES = 24000; // 0.5 s of digital silence
+  static constexpr size_t BUFFER_FRAMES = 512;
+
+  /// Register a stereo clip: SILENT_FRAMES of silence, then a 0.5 DC level
+  void registerSilentHeadClip(ClipHandle handle, int64_t frames) {
+    std::vector<float> samples(static_cast<size_t>(frames) * 2, 0.5f);
+    std::fill(samples.begin(), samples.begin() + SILENT_FRAMES * 2, 0.0f);
+    auto path = seedFile("silent_head.flac", std::move(samples));
+    ASSERT_EQ(m_transport->registerClipAudio(handle, path), SessionGraphError::OK);
+  }
+
+  /// Render one buffer and return the peak absolute output sample
+  float renderPeak() {
+    std::vector<float> left(BUFFER_FRAMES, 0.0f);
+    std::vector<float> right(BUFFER_FRAMES, 0.0f);
+    float* buffers[2] = {left.data(), right.data()};
+    m_transport->processAudio(buffers, 2, BUFFER_FRAMES);
+    float peak = 0.0f;
+    for (size_t i = 0; i < BUFFER_FRAMES; ++i) {
+      peak = std::max({peak, std::abs(left[i]), std::abs(right[i])});
+    }
+    return peak;
+  }
+};
+
+TEST_F(ClipSilenceSkipTest, SilentHeadAdvancesExactlyThenPlays) {
+  registerSilentHeadClip(1, 48000);
+  ASSERT_EQ(m_transport->startClip(1), SessionGraphError::OK);
+
+  // Through the silent head: no output, position advances buffer by buffer
+  size_t silentBuffers = SILENT_FRAMES / BUFFER_FRAMES; // Buffers wholly inside the head
+  for (size_t b = 0; b < silentBuffers; ++b) {
+    EXPECT_EQ(renderPeak(), 0.0f) << "buffer " << b;
+    EXPECT_EQ(m_transport->getClipPosition(1), static_cast<int64_t>((b + 1) * BUFFER_FRAMES));
+  }
+
+  // Sound starts on schedule once the head has passed
+  float peak = 0.0f;
+  for (size_t b = 0; b < 8; ++b) {
+    peak = std::max(peak, renderPeak());
+  }
+  EXPECT_GT(peak, 0.1f);
+  EXPECT_EQ(m_transport->getClipPosition(1),
+            static_cast<int64_t>((silentBuffers + 8) * BUFFER_FRAMES));
+}
+
+TEST_F(ClipSilenceSkipTest, StopInsideSilenceCompletesFadeOut) {
+  registerSilentHeadClip(1, 48000);
+  ASSERT_EQ(m_transport->startClip(1), SessionGraphError::OK);
+  renderPeak();
+  renderPeak();
+  EXPECT_EQ(m_transport->getClipState(1), PlaybackState::Playing);
+
+  // The default 10 ms fade-out (480 frames) still elapses while the voice is skipped
+  ASSERT_EQ(m_transport->stopClip(1), SessionGraphError::OK);
+  for (int b = 0; b < 4; ++b) {
+    EXPECT_EQ(renderPeak(), 0.0f);
+  }
+  EXPECT_EQ(m_transport->getClipState(1), PlaybackState::Stopped);
+}
+
+TEST_F(ClipSilenceSkipTest, LoopingThroughSilenceKeepsTiming) {
+  registerSilentHeadClip(1, SILENT_FRAMES + 1000);
+  ASSERT_EQ(m_transport->setClipLoopMode(1, true), SessionGraphError::OK);
+  ASSERT_EQ(m_transport->startClip(1), SessionGraphError::OK);
+
+  // Each pass: 47 silent buffers, then the tail of the head plus the 1000 sound frames
+  int64_t rendered = 0;
+  float peak = 0.0f;
+  while (rendered < 2 * (SILENT_FRAMES + 1000)) {
+    peak = std::max(peak, renderPeak());
+    rendered += BUFFER_FRAMES;
+  }
+  EXPECT_GT(peak, 0.1f);
+  EXPECT_EQ(m_transport->getClipState(1), PlaybackState::Playing);
+  int64_t position = m_transport->getClipPosition(1);
+  EXPECT_GE(position, 0);
+  EXPECT_LT(position, SILENT_FRAMES + 1000);
+}
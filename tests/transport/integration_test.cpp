@@ -28,6 +28,12 @@ public:
     m_callback_count.fetch_add(1, std::memory_order_relaxed);
   }
 
+  void onUnderrun(UnderrunCause /*cause*/) override {
+    if (m_transport) {
+      m_transport->reportBufferUnderrun();
+    }
+  }
+
   int getCallbackCount() const {
     return m_callback_count.load(std::memory_order_relaxed);
   }
@@ -59,7 +65,7 @@ public:
   }
 
   void onBufferUnderrun(TransportPosition position) override {
-    // Not tested yet
+    m_underrun_count.fetch_add(1, std::memory_order_relaxed);
     (void)position;
   }
 
@@ -71,6 +77,10 @@ public:
     return m_stop_count.load(std::memory_order_relaxed);
   }
 
+  int getUnderrunCount() const {
+    return m_underrun_count.load(std::memory_order_relaxed);
+  }
+
   ClipHandle getLastStartedHandle() const {
     return m_last_started_handle;
   }
@@ -81,6 +91,7 @@ public:
 private:
   std::atomic<int> m_start_count{0};
   std::atomic<int> m_stop_count{0};
+  std::atomic<int> m_underrun_count{0};
   ClipHandle m_last_started_handle{0};
   ClipHandle m_last_stopped_handle{0};
 };
@@ -99,8 +110,10 @@ protected:
     // Create adapter
     m_adapter = std::make_unique<TransportAudioAdapter>(m_transport.get());
 
-    // Create audio driver
-    m_driver = createDummyAudioDriver();
+    // Create audio driver (freewheeling: the tests advance its clock instead of sleeping)
+    DummyDriverOptions options;
+    options.freewheel = true;
+    m_driver = createDummyAudioDriver(options);
 
     // Initialize driver
     AudioDriverConfig config;
@@ -122,6 +135,11 @@ protected:
   std::unique_ptr<TestTransportCallback> m_transport_callback;
   std::unique_ptr<TransportAudioAdapter> m_adapter;
   std::unique_ptr<IAudioDriver> m_driver;
+
+  /// Render a stretch of audio on the driver's virtual clock
+  void runFor(std::chrono::milliseconds duration) {
+    m_driver->getClock()->advance(static_cast<uint64_t>(duration.count()) * 48);
+  }
 };
 
 // Integration Tests
@@ -131,7 +149,7 @@ TEST_F(TransportIntegrationTest, DriverCallsTransportProcessAudio) {
   ASSERT_EQ(m_driver->start(m_adapter.get()), SessionGraphError::OK);
 
   // Wait for a few callbacks
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
 
   // Verify transport's processAudio was called via adapter
   EXPECT_GT(m_adapter->getCallbackCount(), 0);
@@ -148,7 +166,7 @@ TEST_F(TransportIntegrationTest, StartClipTriggersCallback) {
   ASSERT_EQ(m_transport->startClip(handle), SessionGraphError::OK);
 
   // Wait for audio callbacks to process the command
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
 
   // Process UI callbacks
   m_transport->processCallbacks();
@@ -169,7 +187,7 @@ TEST_F(TransportIntegrationTest, StopClipTriggersCallback) {
   ASSERT_EQ(m_transport->startClip(handle), SessionGraphError::OK);
 
   // Wait for clip to start
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
   m_transport->processCallbacks();
   ASSERT_EQ(m_transport_callback->getStartCount(), 1);
 
@@ -177,7 +195,7 @@ TEST_F(TransportIntegrationTest, StopClipTriggersCallback) {
   ASSERT_EQ(m_transport->stopClip(handle), SessionGraphError::OK);
 
   // Wait for fade-out (10ms + margin)
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
   m_transport->processCallbacks();
 
   // Verify clip stopped callback was triggered
@@ -195,7 +213,7 @@ TEST_F(TransportIntegrationTest, TransportPositionAdvances) {
   auto pos1 = m_transport->getCurrentPosition();
 
   // Wait for audio processing
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  runFor(std::chrono::milliseconds(100));
 
   // Get new position
   auto pos2 = m_transport->getCurrentPosition();
@@ -204,6 +222,10 @@ TEST_F(TransportIntegrationTest, TransportPositionAdvances) {
   EXPECT_GT(pos2.samples, pos1.samples);
   EXPECT_GT(pos2.seconds, pos1.seconds);
 
+  // ...in lockstep with the driver's sample clock (100 ms = 9.4 blocks of 512)
+  EXPECT_EQ(pos2.samples, static_cast<int64_t>(m_driver->getClock()->getSampleTime()));
+  EXPECT_EQ(pos2.samples, 10 * 512);
+
   m_driver->stop();
 }
 
@@ -221,7 +243,7 @@ TEST_F(TransportIntegrationTest, MultipleClipsCanStart) {
   ASSERT_EQ(m_transport->startClip(h3), SessionGraphError::OK);
 
   // Wait for clips to start
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
   m_transport->processCallbacks();
 
   // Verify all clips started
@@ -243,7 +265,7 @@ TEST_F(TransportIntegrationTest, StopAllClipsWorks) {
   ASSERT_EQ(m_transport->startClip(3), SessionGraphError::OK);
 
   // Wait for clips to start
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
   m_transport->processCallbacks();
   ASSERT_EQ(m_transport_callback->getStartCount(), 3);
 
@@ -251,7 +273,7 @@ TEST_F(TransportIntegrationTest, StopAllClipsWorks) {
   ASSERT_EQ(m_transport->stopAllClips(), SessionGraphError::OK);
 
   // Wait for fade-out
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  runFor(std::chrono::milliseconds(50));
   m_transport->processCallbacks();
 
   // Verify all clips stopped
@@ -262,3 +284,23 @@ TEST_F(TransportIntegrationTest, StopAllClipsWorks) {
 
   m_driver->stop();
 }
+
+TEST_F(TransportIntegrationTest, MissedDeadlinesReachTransportCallback) {
+  // A real-time driver whose every wake-up is stalled past the period's deadline
+  DummyDriverOptions options;
+  options.jitter.stallProbability = 1.0;
+  options.jitter.stallUs = 15000; // Longer than a 512-frame period (10.7 ms)
+  auto driver = createDummyAudioDriver(options);
+  AudioDriverConfig config;
+  config.sample_rate = 48000;
+  config.buffer_size = 512;
+  ASSERT_EQ(driver->initialize(config), SessionGraphError::OK);
+
+  ASSERT_EQ(driver->start(m_adapter.get()), SessionGraphError::OK);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  driver->stop();
+  EXPECT_EQ(m_transport_callback->getUnderrunCount(), 0); // Delivered on the UI thread
+
+  m_transport->processCallbacks();
+  EXPECT_GT(m_transport_callback->getUnderrunCount(), 0);
+}
@@ -25,8 +25,10 @@ protected:
     // Create transport controller (no SessionGraph for now)
     m_transport = std::make_unique<TransportController>(nullptr, 48000);
 
-    // Create dummy audio driver
-    m_driver = createDummyAudioDriver();
+    // Create dummy audio driver (freewheeling: stress runs render on a virtual clock)
+    DummyDriverOptions options;
+    options.freewheel = true;
+    m_driver = createDummyAudioDriver(options);
 
     // Configure driver
     AudioDriverConfig config;
@@ -170,6 +172,11 @@ protected:
 
   std::unique_ptr<TransportController> m_transport;
   std::unique_ptr<IAudioDriver> m_driver;
+
+  /// Render a stretch of audio on the driver's virtual clock
+  void runFor(std::chrono::milliseconds duration) {
+    m_driver->getClock()->advance(static_cast<uint64_t>(duration.count()) * 48);
+  }
   std::unique_ptr<TestTransportCallback> m_callback;
 };
 
@@ -225,12 +232,12 @@ TEST_F(MultiClipStressTest, SixteenSimultaneousClips) {
     ASSERT_EQ(m_transport->startClip(handle), SessionGraphError::OK);
   }
 
-  // Run for 60 seconds to verify stability (ORP099 requirement)
-  std::cout << "  - Running for 60 seconds to verify stability...\n";
+  // Run for 60 seconds of audio to verify stability (ORP099 requirement)
+  std::cout << "  - Rendering 60 seconds to verify stability...\n";
   auto start_time = std::chrono::steady_clock::now();
 
   for (int second = 0; second < 60; ++second) {
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    runFor(std::chrono::seconds(1));
 
     // Process callbacks
     m_transport->processCallbacks();
@@ -300,7 +307,7 @@ TEST_F(MultiClipStressTest, SixteenSimultaneousClips) {
   std::cout << "  - Trim offsets: 0-50% distributed\n";
   std::cout << "  - Memory stable: No leaks detected (verify with ASan)\n";
 
-  // Verify callback accuracy (dummy driver uses sleep, 70% is acceptable for 60s test)
+  // Verify callback accuracy (the virtual clock delivers every block)
   EXPECT_GT(callback_accuracy, 70.0) << "Callback accuracy should be >70%";
 }
 
@@ -337,7 +344,7 @@ TEST_F(MultiClipStressTest, RapidStartStop) {
       operations++;
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    runFor(std::chrono::milliseconds(10));
 
     // Stop all clips
     for (auto handle : clips) {
@@ -345,7 +352,7 @@ TEST_F(MultiClipStressTest, RapidStartStop) {
       operations++;
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    runFor(std::chrono::milliseconds(10));
   }
 
   auto end_time = std::chrono::steady_clock::now();
@@ -399,9 +406,9 @@ TEST_F(MultiClipStressTest, CPUUsageMeasurement) {
     m_transport->startClip(handle);
   }
 
-  // Run for 2 seconds and measure callback performance
+  // Render 2 seconds and measure callback performance
   auto start_time = std::chrono::steady_clock::now();
-  std::this_thread::sleep_for(std::chrono::seconds(2));
+  runFor(std::chrono::seconds(2));
   auto end_time = std::chrono::steady_clock::now();
 
   int callback_count = adapter->getCallbackCount();
@@ -425,7 +432,7 @@ TEST_F(MultiClipStressTest, CPUUsageMeasurement) {
   std::cout
       << "  - Note: Real CPU profiling requires platform-specific tools (Instruments, perf)\n";
 
-  // Dummy driver uses sleep, not sample-accurate. 80% is acceptable for simulation.
+  // The virtual clock delivers every block; 80% kept as the floor for real-time runs
   EXPECT_GT(callback_accuracy, 80.0); // At least 80% callback accuracy for dummy driver
 }
 
@@ -467,7 +474,8 @@ TEST_F(MultiClipStressTest, MemoryUsageTracking) {
 
 TEST_F(MultiClipStressTest, DISABLED_LongDurationTest) {
   std::cout << "\n[Stress Test] Long-duration test (1 hour)...\n";
-  std::cout << "  - This test runs for 1 hour. Enable with --gtest_also_run_disabled_tests\n";
+  std::cout << "  - This test renders 1 hour of audio on the driver's virtual clock.\n";
+  std::cout << "    Enable with --gtest_also_run_disabled_tests\n";
 
   // Create 16 test audio files
   std::vector<std::string> audioFiles;
@@ -492,12 +500,14 @@ TEST_F(MultiClipStressTest, DISABLED_LongDurationTest) {
   std::mt19937 rng(std::random_device{}());
   std::uniform_int_distribution<int> clip_dist(0, clips.size() - 1);
 
-  // Run for 1 hour (3600 seconds)
+  // Run for 1 hour (3600 seconds) of audio
   auto start_time = std::chrono::steady_clock::now();
-  auto test_duration = std::chrono::hours(1);
-  auto next_report = start_time + std::chrono::minutes(5);
+  auto* clock = m_driver->getClock();
+  const uint64_t test_frames = 3600ull * 48000;
+  const uint64_t report_frames = 300ull * 48000;
+  uint64_t next_report = report_frames;
 
-  while (std::chrono::steady_clock::now() - start_time < test_duration) {
+  while (clock->getSampleTime() < test_frames) {
     // Randomly start/stop clips (rotation pattern)
     int clip_index = clip_dist(rng);
     ClipHandle handle = clips[clip_index];
@@ -508,22 +518,20 @@ TEST_F(MultiClipStressTest, DISABLED_LongDurationTest) {
       m_transport->startClip(handle);
     }
 
-    // Sleep for a bit to avoid saturating the command queue
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Render a bit between commands to avoid saturating the command queue
+    runFor(std::chrono::milliseconds(100));
 
     // Process callbacks periodically
     m_transport->processCallbacks();
 
-    // Report progress every 5 minutes
-    auto now = std::chrono::steady_clock::now();
-    if (now >= next_report) {
-      auto elapsed_minutes =
-          std::chrono::duration_cast<std::chrono::minutes>(now - start_time).count();
-      std::cout << "  - Progress: " << elapsed_minutes << " minutes elapsed\n";
+    // Report progress every 5 minutes of audio
+    if (clock->getSampleTime() >= next_report) {
+      std::cout << "  - Progress: " << clock->getSampleTime() / (60 * 48000)
+                << " minutes rendered\n";
       std::cout << "    Clips started: " << m_callback->getClipsStarted() << "\n";
       std::cout << "    Clips stopped: " << m_callback->getClipsStopped() << "\n";
       std::cout << "    Audio callbacks: " << adapter->getCallbackCount() << "\n";
-      next_report = now + std::chrono::minutes(5);
+      next_report += report_frames;
     }
   }
 
@@ -531,11 +539,12 @@ TEST_F(MultiClipStressTest, DISABLED_LongDurationTest) {
   m_driver->stop();
 
   auto end_time = std::chrono::steady_clock::now();
-  auto total_minutes =
-      std::chrono::duration_cast<std::chrono::minutes>(end_time - start_time).count();
+  auto wall_seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(end_time - start_time).count();
 
   std::cout << "[Stress Test] Long-duration test: PASSED\n";
-  std::cout << "  - Total duration: " << total_minutes << " minutes\n";
+  std::cout << "  - Rendered: " << clock->getSampleTime() / (60 * 48000) << " minutes in "
+            << wall_seconds << " seconds\n";
   std::cout << "  - Clips started: " << m_callback->getClipsStarted() << "\n";
   std::cout << "  - Clips stopped: " << m_callback->getClipsStopped() << "\n";
   std::cout << "  - Audio callbacks: " << adapter->getCallbackCount() << "\n";
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "audio_io/decoded_audio_cache.h"
+#include "audio_io/file_fingerprint.h"
+#include "audio_io/sample_source.h"
+#include "session/session_graph.h"
+#include "transport/transport_controller.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace orpheus {
+
+/// Transport fixture whose clips need no decoder
+///
+/// Test files are "compressed" files whose decoded audio is pre-seeded in a
+/// DecodedAudioCache, so they load from sidecars whether or not libsndfile is
+/// available. Each test suite gets its own scratch directory.
+class SeededClipTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    const auto* suite = ::testing::UnitTest::GetInstance()->current_test_suite();
+    m_dir = std::filesystem::temp_directory_path() / ("orpheus_" + std::string(suite->name()));
+    std::filesystem::remove_all(m_dir);
+    std::filesystem::create_directories(m_dir);
+
+    m_decoded = std::make_shared<DecodedAudioCache>(m_dir / "decoded",
+                                                    DecodedAudioCache::DEFAULT_MAX_BYTES, &m_index);
+    m_transport = std::make_unique<TransportController>(&m_session, 48000);
+    m_transport->getSampleSources().setDecodedCache(m_decoded);
+  }
+
+  void TearDown() override {
+    m_transport.reset();
+    std::filesystem::remove_all(m_dir);
+  }
+
+  /// Create a "compressed" file whose decoded audio is already cached
+  /// @param name File name (also its content, so every name hashes differently)
+  /// @param samples Interleaved stereo frames at 48 kHz
+  /// @return Path to register
+  std::string seedFile(const std::string& name, std::vector<float> samples) {
+    auto path = (m_dir / name).string();
+    std::ofstream(path) << name;
+
+    AudioFileMetadata metadata;
+    metadata.format = AudioFileFormat::FLAC;
+    metadata.sample_rate = 48000;
+    metadata.num_channels = 2;
+    metadata.bit_depth = 24;
+    metadata.codec = "FLAC";
+    SampleSource source(metadata, std::move(samples));
+    EXPECT_TRUE(m_decoded->store(m_decoded->contentKey(path), source));
+    return path;
+  }
+
+  std::filesystem::path m_dir;
+  FingerprintIndex m_index; // Memory-only
+  std::shared_ptr<DecodedAudioCache> m_decoded;
+  core::SessionGraph m_session;
+  std::unique_ptr<TransportController> m_transport;
+};
+
+} // namespace orpheus
@@ -1,7 +1,9 @@
 // SPDX-License-Identifier: MIT
 #include "session/session_graph.h"
+#include "transport/transport_controller.h"
 #include <gtest/gtest.h>
 #include <orpheus/transport_controller.h>
+#include <vector>
 
 using namespace orpheus;
 
@@ -36,6 +38,7 @@ public:
   int loopCount = 0;
   int underrunCount = 0;
   ClipHandle lastHandle = 0;
+  TransportPosition lastUnderrun{};
 
   void onClipStarted(ClipHandle handle, TransportPosition position) override {
     ++startCount;
@@ -54,6 +57,7 @@ public:
 
   void onBufferUnderrun(TransportPosition position) override {
     ++underrunCount;
+    lastUnderrun = position;
   }
 };
 
@@ -133,6 +137,60 @@ TEST_F(TransportControllerTest, StartClipTwice) {
   EXPECT_EQ(m_transport->startClip(handle), SessionGraphError::OK);
 }
 
+TEST_F(TransportControllerTest, StopAllInGroupStopsOnlyThatGroup) {
+  auto* transport = static_cast<TransportController*>(m_transport.get());
+  IClipRoutingMatrix* routing = transport->getClipRouting();
+  ASSERT_NE(routing, nullptr);
+  ASSERT_EQ(routing->assignClipToGroup(1, 0), SessionGraphError::OK);
+  ASSERT_EQ(routing->assignClipToGroup(2, 1), SessionGraphError::OK);
+
+  std::vector<float> left(512), right(512);
+  float* outputs[2] = {left.data(), right.data()};
+
+  // Unregistered clips play silence, which is enough to track voices
+  EXPECT_EQ(m_transport->startClip(1), SessionGraphError::OK);
+  EXPECT_EQ(m_transport->startClip(2), SessionGraphError::OK);
+  EXPECT_EQ(m_transport->startClip(3), SessionGraphError::OK); // Unassigned
+  transport->processAudio(outputs, 2, 512);
+  ASSERT_TRUE(m_transport->isClipPlaying(1));
+  ASSERT_TRUE(m_transport->isClipPlaying(2));
+
+  EXPECT_EQ(m_transport->stopAllInGroup(0), SessionGraphError::OK);
+  for (int i = 0; i < 4; ++i) { // Past the default 10 ms fade-out
+    transport->processAudio(outputs, 2, 512);
+  }
+  EXPECT_FALSE(m_transport->isClipPlaying(1));
+  EXPECT_TRUE(m_transport->isClipPlaying(2));
+  EXPECT_TRUE(m_transport->isClipPlaying(3));
+
+  // Reassigning a playing clip moves its voice to the new group
+  ASSERT_EQ(routing->assignClipToGroup(3, 1), SessionGraphError::OK);
+  transport->processAudio(outputs, 2, 512);
+  EXPECT_EQ(m_transport->stopAllInGroup(1), SessionGraphError::OK);
+  for (int i = 0; i < 4; ++i) {
+    transport->processAudio(outputs, 2, 512);
+  }
+  EXPECT_FALSE(m_transport->isClipPlaying(2));
+  EXPECT_FALSE(m_transport->isClipPlaying(3));
+}
+
+TEST_F(TransportControllerTest, ReportedUnderrunReachesTheCallback) {
+  auto* transport = static_cast<TransportController*>(m_transport.get());
+  TestCallback callback;
+  m_transport->setCallback(&callback);
+
+  std::vector<float> left(512), right(512);
+  float* outputs[2] = {left.data(), right.data()};
+  transport->processAudio(outputs, 2, 512);
+
+  // A driver's IAudioCallback::onUnderrun() forwards here on the audio thread
+  transport->reportBufferUnderrun();
+  EXPECT_EQ(callback.underrunCount, 0); // Queued until callbacks are processed
+  transport->processCallbacks();
+  EXPECT_EQ(callback.underrunCount, 1);
+  EXPECT_EQ(callback.lastUnderrun.samples, 512);
+}
+
 // TODO: Add more comprehensive tests:
 // - Sample-accurate timing (±1 sample)
 // - Multi-clip playback (16 simultaneous)
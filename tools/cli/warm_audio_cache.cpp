@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: MIT
+// tools/cli/warm_audio_cache.cpp
+//
+// Decoded-Audio Cache Pre-Warm Tool
+// Decode every compressed clip referenced by a session file into the
+// DecodedAudioCache so the first open at show time maps a sidecar instead.
+
+#include "audio_io/decoded_audio_cache.h"
+#include "audio_io/file_fingerprint.h"
+#include "audio_io/sample_source.h"
+
+#include <orpheus/json.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Print usage information
+void printUsage(const char* program_name) {
+  std::cout << "Orpheus Decoded-Audio Cache Pre-Warm\n\n";
+  std::cout << "Usage: " << program_name << " <session.json> [options]\n\n";
+  std::cout << "Options:\n";
+  std::cout << "  --cache-dir <dir>    Sidecar directory (default: <user cache>/decoded)\n";
+  std::cout << "  --max-size-mb <n>    Cache size limit in MB (default: 4096)\n";
+  std::cout << "  --help               Show this help message\n\n";
+  std::cout << "Every \"filePath\"/\"file_path\" string in the session is considered;\n";
+  std::cout << "relative paths are resolved against the session file's directory.\n";
+}
+
+// Collect audio file references anywhere in the session document
+void collectFilePaths(const orpheus::json::JsonValue& value, const std::filesystem::path& base,
+                      std::set<std::string>& paths) {
+  using Type = orpheus::json::JsonValue::Type;
+  if (value.type == Type::kObject) {
+    for (const auto& [key, child] : value.object) {
+      if ((key == "filePath" || key == "file_path") && child.type == Type::kString &&
+          !child.string.empty()) {
+        std::filesystem::path path(child.string);
+        paths.insert((path.is_absolute() ? path : base / path).lexically_normal().string());
+      } else {
+        collectFilePaths(child, base, paths);
+      }
+    }
+  } else if (value.type == Type::kArray) {
+    for (const auto& child : value.array) {
+      collectFilePaths(child, base, paths);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  std::string session_path = argv[1];
+  if (session_path == "--help") {
+    printUsage(argv[0]);
+    return 0;
+  }
+
+  std::filesystem::path cache_dir = orpheus::defaultCacheDirectory() / "decoded";
+  uint64_t max_bytes = orpheus::DecodedAudioCache::DEFAULT_MAX_BYTES;
+
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--help") {
+      printUsage(argv[0]);
+      return 0;
+    } else if (arg == "--cache-dir" && i + 1 < argc) {
+      cache_dir = argv[++i];
+    } else if (arg == "--max-size-mb" && i + 1 < argc) {
+      max_bytes = std::stoull(argv[++i]) * 1024 * 1024;
+    } else {
+      std::cerr << "Unknown option: " << arg << "\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::ifstream file(session_path);
+  if (!file.is_open()) {
+    std::cerr << "Error: Could not open file: " << session_path << "\n";
+    return 1;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string text = buffer.str(); // Outlives the parser's view
+
+  std::set<std::string> paths;
+  try {
+    orpheus::json::JsonParser parser(text);
+    auto base = std::filesystem::absolute(session_path).parent_path();
+    collectFilePaths(parser.Parse(), base, paths);
+  } catch (const std::exception& e) {
+    std::cerr << "Error: Invalid session JSON: " << e.what() << "\n";
+    return 1;
+  }
+
+  auto decoded_cache = std::make_shared<orpheus::DecodedAudioCache>(cache_dir, max_bytes);
+  orpheus::SampleSourceCache sources;
+  sources.setDecodedCache(decoded_cache);
+  sources.setResidentLimitBytes(max_bytes); // One file at a time, decoded whole if storable
+
+  size_t warmed = 0;
+  size_t cached = 0;
+  size_t skipped = 0;
+  size_t failed = 0;
+
+  for (const auto& path : paths) {
+    if (!orpheus::DecodedAudioCache::isCacheable(path)) {
+      std::cout << "  skip     " << path << " (uncompressed)\n";
+      ++skipped;
+      continue;
+    }
+
+    std::string key = decoded_cache->contentKey(path);
+    if (key.empty()) {
+      std::cout << "  missing  " << path << "\n";
+      ++failed;
+      continue;
+    }
+    if (decoded_cache->contains(key)) {
+      std::cout << "  cached   " << path << "\n";
+      ++cached;
+      continue;
+    }
+
+    auto result = sources.acquire(path);
+    result.value.reset();
+    sources.collect(); // Keep one decoded file in memory at a time
+    if (!result.isOk() || !decoded_cache->contains(key)) {
+      std::cout << "  failed   " << path
+                << (result.errorMessage.empty() ? "" : " (" + result.errorMessage + ")") << "\n";
+      ++failed;
+      continue;
+    }
+    std::cout << "  decoded  " << path << "\n";
+    ++warmed;
+  }
+
+  std::cout << "\n"
+            << warmed << " decoded, " << cached << " already cached, " << skipped
+            << " skipped, " << failed << " failed\n";
+  std::cout << "Cache: " << cache_dir.string() << " ("
+            << decoded_cache->totalBytes() / (1024 * 1024) << " MB of "
+            << max_bytes / (1024 * 1024) << " MB)\n";
+
+  return failed == 0 ? 0 : 2;
+}
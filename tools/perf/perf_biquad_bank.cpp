@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+#include "routing/biquad_bank.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace orpheus;
+
+// Reports group + master EQ cost as a share of one core at 48 kHz / 64-frame blocks
+int main() {
+  constexpr uint32_t SAMPLE_RATE = 48000;
+  constexpr size_t FRAMES = 64;
+  constexpr double MIN_SECONDS = 0.5;
+  constexpr double TARGET_PERCENT = 1.0; // Budget for the whole EQ stage
+  const size_t group_counts[] = {4, 8, 16};
+
+  std::vector<float> sine(FRAMES);
+  for (size_t i = 0; i < FRAMES; ++i) {
+    double t = static_cast<double>(i) / SAMPLE_RATE;
+    sine[i] = 0.5f * static_cast<float>(std::sin(2.0 * 3.14159265358979 * 440.0 * t));
+  }
+
+  std::cout << "Orpheus EQ performance (" << SAMPLE_RATE << " Hz, " << FRAMES << " frames, "
+            << BiquadBank::NUM_STAGES << " bands per lane, target " << TARGET_PERCENT
+            << "% of one core)" << std::endl;
+
+  bool within_target = true;
+  float sink = 0.0f;
+  for (size_t groups : group_counts) {
+    BiquadBank group_eq(SAMPLE_RATE, groups, FRAMES);
+    BiquadBank master_eq(SAMPLE_RATE, 2, FRAMES);
+    for (size_t stage = 0; stage < BiquadBank::NUM_STAGES; ++stage) {
+      EqBand band;
+      band.type = EqFilterType::Peak;
+      band.frequency_hz = 400.0f * static_cast<float>(stage + 1);
+      band.gain_db = 3.0f;
+      group_eq.setBandAllLanes(stage, band);
+      band.gain_db = -3.0f;
+      master_eq.setBandAllLanes(stage, band);
+    }
+
+    std::vector<std::vector<float>> group_data(groups, sine);
+    std::vector<std::vector<float>> master_data(2, sine);
+    std::vector<float*> group_ptrs, master_ptrs;
+    for (auto& lane : group_data) {
+      group_ptrs.push_back(lane.data());
+    }
+    for (auto& lane : master_data) {
+      master_ptrs.push_back(lane.data());
+    }
+
+    // Warm up (also adopts the published coefficients)
+    group_eq.process(group_ptrs.data(), FRAMES);
+    master_eq.process(master_ptrs.data(), FRAMES);
+
+    size_t blocks = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+      for (size_t i = 0; i < 1000; ++i) {
+        group_eq.process(group_ptrs.data(), FRAMES);
+        master_eq.process(master_ptrs.data(), FRAMES);
+      }
+      blocks += 1000;
+      elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < MIN_SECONDS);
+
+    double audio_seconds = static_cast<double>(blocks * FRAMES) / SAMPLE_RATE;
+    double cpu_percent = 100.0 * elapsed / audio_seconds;
+    within_target = within_target && cpu_percent < TARGET_PERCENT;
+    sink += group_data[0][0] + master_data[0][0];
+
+    std::cout << std::setw(2) << groups << " groups + stereo master " << std::fixed
+              << std::setprecision(3) << std::setw(8) << cpu_percent << "% "
+              << (cpu_percent < TARGET_PERCENT ? "(within target)" : "(OVER TARGET)")
+              << std::endl;
+  }
+
+  // Keep the output observable so the loops are not optimized away
+  volatile float observed = sink;
+  (void)observed;
+  return within_target ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/pcm_decode.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace orpheus;
+
+// Reports decode throughput (GB/s of source PCM) per format and instruction set
+int main() {
+  constexpr size_t SAMPLES = 1 << 20; // 1M samples per pass (fits in L2/L3 on most CPUs)
+  constexpr double MIN_SECONDS = 0.2;
+
+  const PcmSampleFormat formats[] = {
+      PcmSampleFormat::Int16LE,   PcmSampleFormat::Int16BE, PcmSampleFormat::Int24LE,
+      PcmSampleFormat::Int24BE,   PcmSampleFormat::Int32LE, PcmSampleFormat::Int32BE,
+      PcmSampleFormat::Float32LE, PcmSampleFormat::Float32BE,
+  };
+  const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2,
+                              SimdLevel::NEON};
+
+  std::mt19937 rng(42);
+  std::vector<uint8_t> source(SAMPLES * 4);
+  for (auto& byte : source) {
+    byte = static_cast<uint8_t>(rng() & 0x3F); // Keeps float formats finite
+  }
+  std::vector<float> output(SAMPLES);
+
+  std::cout << "Orpheus PCM decode performance (dispatch: " << simdLevelName(detectSimdLevel())
+            << ")" << std::endl;
+
+  for (auto format : formats) {
+    double source_bytes = static_cast<double>(SAMPLES * pcmBytesPerSample(format));
+    for (auto level : levels) {
+      PcmDecodeKernel kernel = pcmDecodeKernel(format, level);
+      if (!kernel) {
+        continue;
+      }
+
+      kernel(source.data(), output.data(), SAMPLES); // Warm up
+      size_t passes = 0;
+      auto start = std::chrono::steady_clock::now();
+      double elapsed = 0.0;
+      do {
+        kernel(source.data(), output.data(), SAMPLES);
+        ++passes;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      } while (elapsed < MIN_SECONDS);
+
+      double gbps = source_bytes * static_cast<double>(passes) / elapsed / 1e9;
+      std::cout << std::left << std::setw(12) << pcmFormatName(format) << std::setw(8)
+                << simdLevelName(level) << std::right << std::fixed << std::setprecision(2)
+                << std::setw(8) << gbps << " GB/s" << std::endl;
+    }
+  }
+
+  // Keep the output observable so the loops are not optimized away
+  volatile float sink = output[SAMPLES / 2];
+  (void)sink;
+  return 0;
+}
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: MIT
+#include "audio_io/block_reader.h"
+#include "audio_io/pcm_stream_set.h"
+
+#include <orpheus/audio_file_reader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace orpheus;
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 48000;
+constexpr uint16_t CHANNELS = 2;
+constexpr size_t BLOCK_FRAMES = 4096; // Per voice refill (~85 ms)
+
+void putLE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+/// 24-bit stereo WAV of noise
+void writeWave(const std::filesystem::path& path, uint32_t frames, uint32_t seed) {
+  const uint32_t data_bytes = frames * CHANNELS * 3;
+  std::vector<uint8_t> out;
+  out.insert(out.end(), {'R', 'I', 'F', 'F'});
+  putLE(out, 36 + data_bytes, 4);
+  out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+  putLE(out, 16, 4);
+  putLE(out, 1, 2);
+  putLE(out, CHANNELS, 2);
+  putLE(out, SAMPLE_RATE, 4);
+  putLE(out, SAMPLE_RATE * CHANNELS * 3, 4);
+  putLE(out, CHANNELS * 3, 2);
+  putLE(out, 24, 2);
+  out.insert(out.end(), {'d', 'a', 't', 'a'});
+  putLE(out, data_bytes, 4);
+  std::mt19937 rng(seed);
+  out.reserve(out.size() + data_bytes);
+  for (uint32_t i = 0; i < data_bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(rng()));
+  }
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+}
+
+/// Flush and evict a file from the page cache so each mode reads from the device
+void dropFromPageCache(const std::filesystem::path& path) {
+#if defined(POSIX_FADV_DONTNEED)
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+  }
+#else
+  (void)path;
+#endif
+}
+
+/// Time every refill of all voices until the files are exhausted
+/// @param refill Reads the next block of every voice; returns frames read summed over voices
+void runMode(const std::string& name, const std::vector<std::filesystem::path>& files,
+             const std::function<size_t()>& refill) {
+  for (const auto& file : files) {
+    dropFromPageCache(file);
+  }
+
+  std::vector<double> latencies;
+  size_t total_frames = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (;;) {
+    auto before = std::chrono::steady_clock::now();
+    size_t frames = refill();
+    if (frames == 0) {
+      break;
+    }
+    latencies.push_back(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - before)
+            .count());
+    total_frames += frames;
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (latencies.empty()) {
+    std::cout << std::left << std::setw(24) << name << "no data" << std::endl;
+    return;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+  };
+  double megabytes = static_cast<double>(total_frames * CHANNELS * 3) / 1e6;
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(9) << megabytes / elapsed << " MB/s"
+            << std::setprecision(2) << std::setw(9) << percentile(0.5) << std::setw(9)
+            << percentile(0.99) << std::setw(9) << latencies.back() << " ms" << std::endl;
+}
+
+void runStreamSet(const std::string& name, const std::vector<std::filesystem::path>& files,
+                  BlockReaderBackend backend, bool direct) {
+  BlockReaderOptions options;
+  options.backend = backend;
+  options.maxBatch = files.size();
+  options.directIo = direct;
+  auto reader = createBlockReader(options);
+  if (!reader) {
+    std::cout << std::left << std::setw(24) << name << "unavailable" << std::endl;
+    return;
+  }
+  PcmStreamSet streams(std::move(reader));
+  for (const auto& file : files) {
+    if (!streams.open(file.string())) {
+      std::cout << std::left << std::setw(24) << name << "cannot open " << file << std::endl;
+      return;
+    }
+  }
+
+  std::vector<std::vector<float>> buffers(files.size(),
+                                          std::vector<float>(BLOCK_FRAMES * CHANNELS));
+  std::vector<float*> outputs;
+  for (auto& buffer : buffers) {
+    outputs.push_back(buffer.data());
+  }
+  std::vector<int64_t> frames(files.size());
+  runMode(name, files, [&] {
+    streams.readNext(BLOCK_FRAMES, outputs, frames);
+    size_t total = 0;
+    for (auto count : frames) {
+      total += static_cast<size_t>(std::max<int64_t>(count, 0));
+    }
+    return total;
+  });
+}
+
+void runPerVoiceReaders(const std::vector<std::filesystem::path>& files) {
+  const std::string name = "decoder per voice";
+  std::vector<std::unique_ptr<IAudioFileReader>> readers;
+  for (const auto& file : files) {
+    auto reader = createAudioFileReader();
+    if (!reader) {
+      std::cout << std::left << std::setw(24) << name << "unavailable (built without libsndfile)"
+                << std::endl;
+      return;
+    }
+    if (!reader->open(file.string()).isOk()) {
+      std::cout << std::left << std::setw(24) << name << "cannot open " << file << std::endl;
+      return;
+    }
+    readers.push_back(std::move(reader));
+  }
+
+  std::vector<float> buffer(BLOCK_FRAMES * CHANNELS);
+  runMode(name, files, [&] {
+    size_t total = 0;
+    for (auto& reader : readers) {
+      auto result = reader->readSamples(buffer.data(), BLOCK_FRAMES);
+      total += result.isOk() ? result.value : 0;
+    }
+    return total;
+  });
+}
+
+} // namespace
+
+// Compares refilling many streaming voices from uncompressed files: one blocking
+// decoder read per voice against batched BlockReader reads (pread and io_uring,
+// through the page cache and direct). Files are evicted from the page cache
+// before each mode. Latency is per refill of every voice.
+//
+// Usage: orpheus_perf_voice_streaming [voices=64] [seconds=10] [directory]
+int main(int argc, char** argv) {
+  const size_t voices = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+  const double seconds = argc > 2 ? std::strtod(argv[2], nullptr) : 10.0;
+  const std::filesystem::path dir =
+      argc > 3 ? std::filesystem::path(argv[3])
+               : std::filesystem::temp_directory_path() / "orpheus_perf_voice_streaming";
+  if (voices == 0 || seconds <= 0.0) {
+    std::cerr << "usage: orpheus_perf_voice_streaming [voices] [seconds] [directory]" << std::endl;
+    return 1;
+  }
+
+  std::filesystem::create_directories(dir);
+  std::vector<std::filesystem::path> files;
+  const auto frames = static_cast<uint32_t>(seconds * SAMPLE_RATE);
+  for (size_t v = 0; v < voices; ++v) {
+    files.push_back(dir / ("voice" + std::to_string(v) + ".wav"));
+    writeWave(files.back(), frames, static_cast<uint32_t>(v));
+  }
+
+  std::cout << "Orpheus voice streaming performance (" << voices << " voices, " << seconds
+            << " s of 24-bit stereo each, " << BLOCK_FRAMES << "-frame refills)" << std::endl;
+  std::cout << std::left << std::setw(24) << "mode" << std::right << std::setw(14) << "throughput"
+            << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(9) << "max"
+            << std::endl;
+
+  runPerVoiceReaders(files);
+  runStreamSet("pread batch", files, BlockReaderBackend::Pread, false);
+  runStreamSet("pread batch direct", files, BlockReaderBackend::Pread, true);
+  runStreamSet("io_uring batch", files, BlockReaderBackend::IoUring, false);
+  runStreamSet("io_uring batch direct", files, BlockReaderBackend::IoUring, true);
+
+  std::filesystem::remove_all(dir);
+  return 0;
+}